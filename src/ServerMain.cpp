@@ -52,6 +52,7 @@ int main(int argc, char** argv) {
   bool noPatterns;
   bool onlyPsoAndPosPermutations;
   bool persistUpdates;
+  std::string diskResultCacheDirectory;
 
   ad_utility::MemorySize memoryMaxSize;
 
@@ -101,6 +102,16 @@ int main(int argc, char** argv) {
       "least-recently used non-pinned entries from the cache. Note that "
       "this condition and the size limit specified via --cache-max-size "
       "both have to hold (logical AND).");
+  add("disk-result-cache-dir",
+      po::value<std::string>(&diskResultCacheDirectory)->default_value(""),
+      "If set, then results that are evicted from the cache are stored in this "
+      "directory instead of being dropped, and they are reused after a restart "
+      "of the server (default: no cache on disk).");
+  add("disk-result-cache-max-size",
+      optionFactory
+          .getProgramOption<&RuntimeParameters::diskResultCacheMaxSize_>(),
+      "Maximum total size of the results that are stored in the directory "
+      "specified via --disk-result-cache-dir.");
   add("no-patterns,P", po::bool_switch(&noPatterns),
       "Disable the use of patterns. If disabled, the special predicate "
       "`ql:has-predicate` is not available.");
@@ -187,6 +198,7 @@ int main(int argc, char** argv) {
   try {
     Server server(port, numSimultaneousQueries, memoryMaxSize,
                   std::move(accessToken), !noPatterns);
+    server.setDiskResultCacheDirectory(std::move(diskResultCacheDirectory));
     server.run(indexBasename, text, !noPatterns, !onlyPsoAndPosPermutations,
                persistUpdates);
   } catch (const std::exception& e) {
@@ -8,6 +8,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/ExistsJoin.h"
+#include "engine/MorselParallelism.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
@@ -117,6 +118,12 @@ Result Bind::computeResult(bool requestLaziness) {
   std::shared_ptr<const Result> subRes = _subtree->getResult(requestLaziness);
   AD_LOG_DEBUG << "Got input to Bind operation." << std::endl;
 
+  if (size_t numThreads = qlever::morsels::getNumThreads(*subRes);
+      numThreads > 1) {
+    return computeResultInParallel(std::move(subRes), numThreads,
+                                   requestLaziness);
+  }
+
   auto applyBind = [this](IdTable idTable, LocalVocab* localVocab) {
     return computeExpressionBind(localVocab, std::move(idTable),
                                  _bind._expression.getPimpl());
@@ -170,6 +177,31 @@ Result Bind::computeResult(bool requestLaziness) {
       resultSortedOn()};
 }
 
+// _____________________________________________________________________________
+Result Bind::computeResultInParallel(std::shared_ptr<const Result> subRes,
+                                     size_t numThreads, bool requestLaziness) {
+  // The rows of a morsel are part of the result, so they are copied anyway.
+  // This happens in the tasks, not when the input is split into morsels.
+  auto bindMorsel = [this](qlever::morsels::Morsel morsel) {
+    IdTable resultTable = computeExpressionBind(
+        &morsel.localVocab_,
+        cloneSubView(*morsel.table_, {morsel.begin_, morsel.end_}),
+        _bind._expression.getPimpl());
+    return Result::IdTableVocabPair{std::move(resultTable),
+                                    std::move(morsel.localVocab_)};
+  };
+  auto result = qlever::morsels::processInParallel(
+      std::move(subRes), numThreads, std::move(bindMorsel));
+  if (requestLaziness) {
+    return {std::move(result), resultSortedOn()};
+  }
+  auto [idTable, localVocab] = qlever::morsels::materialize(
+      std::move(result), getResultWidth(),
+      getExecutionContext()->getAllocator());
+  AD_LOG_DEBUG << "BIND result computation done." << std::endl;
+  return {std::move(idTable), resultSortedOn(), std::move(localVocab)};
+}
+
 // _____________________________________________________________________________
 IdTable Bind::computeExpressionBind(
     LocalVocab* localVocab, IdTable idTable,
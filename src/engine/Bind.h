@@ -49,6 +49,11 @@ class Bind : public Operation {
  private:
   Result computeResult(bool requestLaziness) override;
 
+  // Compute the BIND on morsels of the `subRes` using `numThreads` threads, see
+  // `MorselParallelism.h`. The order of the rows is preserved.
+  Result computeResultInParallel(std::shared_ptr<const Result> subRes,
+                                 size_t numThreads, bool requestLaziness);
+
   static IdTable cloneSubView(const IdTable& idTable,
                               const std::pair<size_t, size_t>& subrange);
 
@@ -40,6 +40,12 @@ class Describe : public Operation {
   size_t getResultWidth() const override;
   size_t getCostEstimate() override;
 
+  // The variables of the result are unrelated to those of the `subtree_`, so
+  // their datatypes are unknown.
+  std::optional<Datatype> getStaticDatatype(const Variable&) const override {
+    return std::nullopt;
+  }
+
  private:
   uint64_t getSizeEstimateBeforeLimit() override;
 
@@ -0,0 +1,370 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/DiskResultCache.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include <vector>
+
+#include "CompilationInfo.h"
+#include "backports/algorithm.h"
+#include "global/Constants.h"
+#include "index/DeltaTriples.h"
+#include "index/Index.h"
+#include "index/IndexFormatVersion.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/CryptographicHashUtils.h"
+#include "util/HashSet.h"
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/TripleSerializer.h"
+
+namespace {
+// The header of each file of the cache. The version has to be increased
+// whenever the format changes, files with a different version are ignored.
+constexpr std::string_view magicBytes = "QLEVER.RESULT";
+constexpr uint16_t version = 0;
+}  // namespace
+
+// _____________________________________________________________________________
+DiskResultCache::DiskResultCache(const Index& index,
+                                 std::filesystem::path directory,
+                                 ad_utility::MemorySize maxSize)
+    : index_{index},
+      directory_{std::move(directory)},
+      indexId_{computeIndexId(index)},
+      files_{ad_utility::size_t_max, maxSize, maxSize},
+      maxSize_{maxSize} {
+  std::filesystem::create_directories(directory_);
+  // Files that are evicted from the index in RAM are deleted on disk.
+  files_.wlock()->setEvictionCallback(
+      [directory = directory_](const std::string& name, const auto&) {
+        std::error_code errorCode;
+        std::filesystem::remove(directory / name, errorCode);
+      });
+  registerExistingFiles();
+  writerThread_ = ad_utility::JThread{[this]() { writerLoop(); }};
+}
+
+// _____________________________________________________________________________
+DiskResultCache::~DiskResultCache() {
+  {
+    std::lock_guard lock{mutex_};
+    shutdown_ = true;
+  }
+  pendingWritesChanged_.notify_all();
+  // The `writerThread_` is joined by its destructor.
+}
+
+// _____________________________________________________________________________
+std::string DiskResultCache::computeIndexId(const Index& index) {
+  // The metadata file is rewritten whenever the index is built. Errors (for
+  // example, if the file does not exist) lead to a stable dummy value. The
+  // version of QLever and of the index format are also part of the ID, because
+  // the results (for example, the encoding of the IDs) may change with them.
+  std::filesystem::path base = index.getOnDiskBase();
+  std::filesystem::path metaData =
+      absl::StrCat(index.getOnDiskBase(), CONFIGURATION_FILE);
+  std::error_code errorCode;
+  auto absoluteBase = std::filesystem::absolute(base, errorCode);
+  auto lastWriteTime = std::filesystem::last_write_time(metaData, errorCode);
+  auto size = std::filesystem::file_size(metaData, errorCode);
+  return absl::StrCat(absoluteBase.string(), " ", size, " ",
+                      lastWriteTime.time_since_epoch().count(), " ",
+                      *qlever::version::gitShortHashWithoutLinking.wlock(),
+                      " ", nlohmann::json(qlever::indexFormatVersion).dump());
+}
+
+// _____________________________________________________________________________
+std::string DiskResultCache::fileName(std::string_view key) const {
+  auto hash = ad_utility::hashSha256(absl::StrCat(indexId_, "\n", key));
+  return absl::StrCat(absl::StrJoin(hash, "", ad_utility::hexFormatter),
+                      FILE_EXTENSION);
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::registerExistingFiles() {
+  std::vector<std::pair<std::filesystem::file_time_type, std::string>> files;
+  for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+    const auto& path = entry.path();
+    if (path.extension() == FILE_EXTENSION) {
+      files.emplace_back(entry.last_write_time(), path.filename().string());
+    } else if (path.extension() == ".tmp") {
+      // A file that was not completely written before the last shutdown.
+      std::filesystem::remove(path);
+    }
+  }
+  // The files are loaded in the order of their last access (see `load`), s.t.
+  // the least recently used files are evicted first.
+  ql::ranges::sort(files);
+  auto lock = files_.wlock();
+  for (const auto& [lastWriteTime, name] : files) {
+    auto size = ad_utility::MemorySize::bytes(
+        std::filesystem::file_size(directory_ / name));
+    if (lock->contains(name)) {
+      continue;
+    }
+    if (lock->insert(name, size) == nullptr) {
+      std::filesystem::remove(directory_ / name);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+bool DiskResultCache::isSuitedForCache(const Result& result) const {
+  if (!result.isFullyMaterialized()) {
+    return false;
+  }
+  auto minLocalBlankNodeIndex = index_.getBlankNodeManager()->minIndex_;
+  for (const auto& column : result.idTable().getColumns()) {
+    for (Id id : column) {
+      if (id.getDatatype() == Datatype::BlankNodeIndex &&
+          id.getBlankNodeIndex().get() >= minLocalBlankNodeIndex) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// _____________________________________________________________________________
+std::optional<CacheValue> DiskResultCache::load(
+    const QueryCacheKey& key, const LocatedTriplesSnapshot& snapshot,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  if (snapshot.hasDeltaTriples()) {
+    return std::nullopt;
+  }
+  auto name = fileName(key.key_);
+  // Also moves the file to the front of the LRU order.
+  if ((*files_.wlock())[name] == nullptr) {
+    ++numMisses_;
+    return std::nullopt;
+  }
+  auto path = directory_ / name;
+  try {
+    auto value = read(path, key.key_, allocator);
+    // The modification time is used for the LRU order after a restart.
+    std::error_code errorCode;
+    std::filesystem::last_write_time(
+        path, std::filesystem::file_time_type::clock::now(), errorCode);
+    ++numHits_;
+    return value;
+  } catch (const std::exception& e) {
+    AD_LOG_WARN << "Could not read the cached result from " << path << ": "
+                << e.what() << std::endl;
+    files_.wlock()->erase(name);
+    std::error_code errorCode;
+    std::filesystem::remove(path, errorCode);
+    ++numMisses_;
+    return std::nullopt;
+  }
+}
+
+// _____________________________________________________________________________
+CacheValue DiskResultCache::read(
+    const std::filesystem::path& path, std::string_view key,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) const {
+  using ad_utility::detail::readValue;
+  ad_utility::serialization::FileReadSerializer serializer{path.string()};
+  AD_CORRECTNESS_CHECK(readValue<std::string>(serializer) == magicBytes);
+  AD_CORRECTNESS_CHECK(readValue<uint16_t>(serializer) == version);
+  // The name of the file is only a hash, so the key has to be checked.
+  AD_CORRECTNESS_CHECK(readValue<std::string>(serializer) == indexId_);
+  AD_CORRECTNESS_CHECK(readValue<std::string>(serializer) == key);
+  auto numColumns = readValue<uint64_t>(serializer);
+  auto numRows = readValue<uint64_t>(serializer);
+  auto sortedBy = readValue<std::vector<ColumnIndex>>(serializer);
+  auto vocabAndMapping = ad_utility::detail::deserializeLocalVocab(serializer);
+  const auto& mapping = std::get<1>(vocabAndMapping);
+
+  IdTable idTable{numColumns, allocator};
+  idTable.resize(numRows);
+  for (size_t i = 0; i < numColumns; ++i) {
+    auto compressed = readValue<std::vector<char>>(serializer);
+    auto ids = ZstdWrapper::decompress<Id>(compressed.data(),
+                                           compressed.size(), numRows);
+    ql::ranges::transform(ids, idTable.getColumn(i).begin(),
+                          [&mapping](Id id) {
+                            return id.getDatatype() == Datatype::LocalVocabIndex
+                                       ? mapping.at(id.getBits())
+                                       : id;
+                          });
+  }
+
+  RuntimeInformation runtimeInfo;
+  runtimeInfo.descriptor_ = readValue<std::string>(serializer);
+  runtimeInfo.totalTime_ =
+      std::chrono::microseconds{readValue<int64_t>(serializer)};
+  runtimeInfo.columnNames_ = readValue<std::vector<std::string>>(serializer);
+  runtimeInfo.details_ =
+      nlohmann::json::parse(readValue<std::string>(serializer));
+  runtimeInfo.numRows_ = numRows;
+  runtimeInfo.numCols_ = numColumns;
+  runtimeInfo.status_ = RuntimeInformation::Status::fullyMaterialized;
+  return CacheValue{Result{std::move(idTable), std::move(sortedBy),
+                           std::move(std::get<0>(vocabAndMapping))},
+                    std::move(runtimeInfo)};
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::store(const QueryCacheKey& key,
+                            std::shared_ptr<const CacheValue> value) {
+  // NOTE: This function is called while the cache in RAM is locked, the
+  // expensive checks are therefore done by the `writerThread_`.
+  if (value == nullptr || !value->resultTable().isFullyMaterialized() ||
+      maxSize_.load() == ad_utility::MemorySize::bytes(0)) {
+    return;
+  }
+  {
+    std::lock_guard lock{mutex_};
+    if (shutdown_ || pendingWrites_.size() >= MAX_NUM_PENDING_WRITES) {
+      return;
+    }
+    pendingWrites_.emplace_back(key, std::move(value));
+  }
+  pendingWritesChanged_.notify_all();
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::write(const QueryCacheKey& key,
+                            const CacheValue& value) {
+  auto snapshot = index_.deltaTriplesManager().getCurrentSnapshot();
+  if (snapshot->index_ != key.locatedTriplesSnapshotIndex_ ||
+      snapshot->hasDeltaTriples()) {
+    return;
+  }
+  auto name = fileName(key.key_);
+  // A result that was loaded from disk is not written again.
+  if (files_.rlock()->contains(name)) {
+    return;
+  }
+  const Result& result = value.resultTable();
+  if (!isSuitedForCache(result)) {
+    return;
+  }
+  const IdTable& idTable = result.idTable();
+  auto path = directory_ / name;
+  auto temporaryPath = absl::StrCat(path.string(), ".tmp");
+  {
+    ad_utility::serialization::FileWriteSerializer serializer{temporaryPath};
+    serializer << std::string{magicBytes};
+    serializer << version;
+    serializer << indexId_;
+    serializer << key.key_;
+    serializer << uint64_t{idTable.numColumns()};
+    serializer << uint64_t{idTable.numRows()};
+    serializer << result.sortedBy();
+    // Only the entries of the local vocab that are actually used are stored.
+    ad_utility::HashSet<LocalVocabIndex> localVocabEntries;
+    for (const auto& column : idTable.getColumns()) {
+      for (Id id : column) {
+        if (id.getDatatype() == Datatype::LocalVocabIndex) {
+          localVocabEntries.insert(id.getLocalVocabIndex());
+        }
+      }
+    }
+    ad_utility::detail::serializeLocalVocabEntries(serializer,
+                                                   localVocabEntries);
+    for (const auto& column : idTable.getColumns()) {
+      serializer << ZstdWrapper::compress(column.data(),
+                                          column.size() * sizeof(Id));
+    }
+    const auto& runtimeInfo = value.runtimeInfo();
+    serializer << runtimeInfo.descriptor_;
+    serializer << static_cast<int64_t>(runtimeInfo.totalTime_.count());
+    serializer << runtimeInfo.columnNames_;
+    serializer << runtimeInfo.details_.dump();
+  }
+  // The file only becomes visible when it has been written completely.
+  std::filesystem::rename(temporaryPath, path);
+  auto size = ad_utility::MemorySize::bytes(std::filesystem::file_size(path));
+  auto files = files_.wlock();
+  if (files->contains(name)) {
+    files->erase(name);
+  }
+  if (files->insert(name, size) == nullptr) {
+    std::filesystem::remove(path);
+    return;
+  }
+  ++numWrites_;
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::writerLoop() {
+  std::unique_lock lock{mutex_};
+  while (true) {
+    pendingWritesChanged_.wait(
+        lock, [this]() { return shutdown_ || !pendingWrites_.empty(); });
+    // On shutdown, the pending writes are still completed.
+    if (pendingWrites_.empty()) {
+      return;
+    }
+    auto [key, value] = std::move(pendingWrites_.front());
+    pendingWrites_.pop_front();
+    isWriting_ = true;
+    lock.unlock();
+    try {
+      write(key, *value);
+    } catch (const std::exception& e) {
+      AD_LOG_WARN << "Could not write a result to the disk result cache: "
+                  << e.what() << std::endl;
+    }
+    // Release the result before the lock is acquired again.
+    value.reset();
+    lock.lock();
+    isWriting_ = false;
+    pendingWritesChanged_.notify_all();
+  }
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::waitUntilWritten() {
+  std::unique_lock lock{mutex_};
+  pendingWritesChanged_.wait(
+      lock, [this]() { return pendingWrites_.empty() && !isWriting_; });
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::setMaxSize(ad_utility::MemorySize maxSize) {
+  maxSize_ = maxSize;
+  auto files = files_.wlock();
+  files->setMaxSizeSingleEntry(maxSize);
+  files->setMaxSize(maxSize);
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::dropPendingWrites() {
+  {
+    std::lock_guard lock{mutex_};
+    pendingWrites_.clear();
+  }
+  pendingWritesChanged_.notify_all();
+}
+
+// _____________________________________________________________________________
+void DiskResultCache::clear() {
+  dropPendingWrites();
+  auto files = files_.wlock();
+  files->clearAll();
+  for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+    if (entry.path().extension() == FILE_EXTENSION) {
+      std::filesystem::remove(entry.path());
+    }
+  }
+}
+
+// _____________________________________________________________________________
+auto DiskResultCache::getStatistics() const -> Statistics {
+  auto files = files_.rlock();
+  return {numHits_, numMisses_, numWrites_, files->numNonPinnedEntries(),
+          files->nonPinnedSize()};
+}
@@ -0,0 +1,182 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
+#define QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "engine/QueryExecutionContext.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/Cache.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+#include "util/jthread.h"
+
+class Index;
+struct LocatedTriplesSnapshot;
+
+// A second tier of the `QueryResultCache` on local disk, which survives a
+// restart of the server. Results that are evicted from the cache in RAM are
+// "demoted" to this cache instead of being dropped (and optionally, every
+// computed result is also written here). When a result is not in the cache in
+// RAM, it is looked up here before it is computed.
+//
+// Each result is stored in its own file in the `directory`, with the columns of
+// the `IdTable` compressed separately and the entries of the `LocalVocab` that
+// are used by the result. Only a small index of the files (name and size) is
+// kept in RAM, which is rebuilt from the directory when the cache is created,
+// the results themselves are loaded lazily on lookup. The total size of the
+// files is limited, the least recently used files are deleted first.
+//
+// The snapshot indices of the `LocatedTriplesSnapshot` start at zero with each
+// start of the server, so they can not be part of a persistent key. Instead,
+// only results that were computed on a snapshot without any delta triples are
+// stored, and they are only returned for such snapshots. The key of a file
+// consists of the `QueryCacheKey::key_` and an ID of the index on disk.
+//
+// The files are written by a single background thread, s.t. the eviction from
+// the cache in RAM (which happens while the cache is locked) stays cheap. If
+// the writer can not keep up, results are dropped instead of being queued.
+// Results that are evicted to free memory for a query are not demoted at all
+// (see `FlexibleCache::makeRoomAsMuchAsPossible`), because the queued results
+// are kept alive until they are written.
+class DiskResultCache {
+ public:
+  // The statistics that are reported by the `cache-stats` command.
+  struct Statistics {
+    size_t numHits_;
+    size_t numMisses_;
+    size_t numWrites_;
+    size_t numEntries_;
+    ad_utility::MemorySize size_;
+  };
+
+  // The extension of the files of the cache.
+  static constexpr std::string_view FILE_EXTENSION = ".qlever-result";
+
+ private:
+  // The size of a file counts against the size limit of the cache.
+  struct FileSizeGetter {
+    ad_utility::MemorySize operator()(
+        const ad_utility::MemorySize& size) const {
+      return size;
+    }
+  };
+  using Files = ad_utility::HeapBasedLRUCache<std::string,
+                                              ad_utility::MemorySize,
+                                              FileSizeGetter>;
+
+  // The maximal number of results that are waiting to be written. The queued
+  // results are kept alive, so this must be small.
+  static constexpr size_t MAX_NUM_PENDING_WRITES = 4;
+
+  const Index& index_;
+  std::filesystem::path directory_;
+  std::string indexId_;
+  // The names (not paths) of the files in the `directory_` and their sizes.
+  ad_utility::Synchronized<Files> files_;
+  std::atomic<ad_utility::MemorySize> maxSize_;
+
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  std::atomic<size_t> numWrites_ = 0;
+
+  // The results that are waiting to be written by the `writerThread_`.
+  using PendingWrite =
+      std::pair<QueryCacheKey, std::shared_ptr<const CacheValue>>;
+  std::mutex mutex_;
+  std::condition_variable pendingWritesChanged_;
+  std::deque<PendingWrite> pendingWrites_;
+  bool isWriting_ = false;
+  bool shutdown_ = false;
+  ad_utility::JThread writerThread_;
+
+ public:
+  // Create a cache for the results of the `index` in the `directory`, which is
+  // created if it does not exist. The files that are already in the directory
+  // (from a previous run) are registered, but not read.
+  DiskResultCache(const Index& index, std::filesystem::path directory,
+                  ad_utility::MemorySize maxSize);
+
+  // Wait for the pending writes to be finished.
+  ~DiskResultCache();
+
+  DiskResultCache(const DiskResultCache&) = delete;
+  DiskResultCache& operator=(const DiskResultCache&) = delete;
+
+  // Return the result for the `key`, or `std::nullopt` if there is no such
+  // result or the `snapshot` (which the result would be used for) contains
+  // delta triples. The `IdTable` is allocated with the `allocator`. Also
+  // update the hit and miss counters.
+  std::optional<CacheValue> load(
+      const QueryCacheKey& key, const LocatedTriplesSnapshot& snapshot,
+      const ad_utility::AllocatorWithLimit<Id>& allocator);
+
+  // Schedule the `value` for the `key` to be written to disk. This is cheap and
+  // does not block, the value is dropped if there are too many pending writes.
+  // A result is only written if it is suited for the cache (see
+  // `isSuitedForCache`) and if the snapshot with the index of the `key` is
+  // still the current snapshot when it is written and contains no delta
+  // triples.
+  void store(const QueryCacheKey& key, std::shared_ptr<const CacheValue> value);
+
+  // Block until all the results that were passed to `store` are written (or
+  // dropped).
+  void waitUntilWritten();
+
+  // Drop the results that are waiting to be written, s.t. their memory can be
+  // freed. This is used when the memory for a query runs out.
+  void dropPendingWrites();
+
+  // Change the maximal total size of the files. Files are deleted immediately
+  // if required.
+  void setMaxSize(ad_utility::MemorySize maxSize);
+
+  // Delete all the files of the cache. The hit and miss counters are kept.
+  void clear();
+
+  Statistics getStatistics() const;
+
+  // Return true iff the `result` can be stored on disk. This is not the case
+  // for results that are not fully materialized and for results with blank
+  // nodes that were created while processing a query (their IDs are only
+  // valid within the current process).
+  bool isSuitedForCache(const Result& result) const;
+
+  // Return the ID of the `index`, which changes whenever the index is rebuilt.
+  static std::string computeIndexId(const Index& index);
+
+ private:
+  // Return the name of the file for the given `key_` of a `QueryCacheKey`.
+  std::string fileName(std::string_view key) const;
+
+  // Register the files that are already in the `directory_`, the least
+  // recently used first.
+  void registerExistingFiles();
+
+  // Write the `value` for the `key` to disk and register the file, if the
+  // snapshot of the `key` is still valid.
+  void write(const QueryCacheKey& key, const CacheValue& value);
+
+  // Read the result for the `key` from the file at the `path`. Throw if the
+  // file is corrupt or belongs to a different key or index.
+  CacheValue read(const std::filesystem::path& path, std::string_view key,
+                  const ad_utility::AllocatorWithLimit<Id>& allocator) const;
+
+  // The function that is run by the `writerThread_`.
+  void writerLoop();
+};
+
+#endif  // QLEVER_SRC_ENGINE_DISKRESULTCACHE_H
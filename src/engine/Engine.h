@@ -10,9 +10,15 @@
 #include "backports/type_traits.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Constants.h"
+#include "global/RuntimeParameters.h"
 #include "util/Log.h"
 
 class Engine {
+  // The number of threads for the parallel sorting, see `RuntimeParameters`.
+  static size_t numSortThreads() {
+    return getRuntimeParameter<&RuntimeParameters::sortNumThreads_>();
+  }
+
  public:
   template <size_t WIDTH>
   static void sort(IdTable* tab, const size_t keyColumn) {
@@ -24,7 +30,7 @@ class Engine {
           [keyColumn](const auto& a, const auto& b) {
             return a[keyColumn] < b[keyColumn];
           },
-          ad_utility::parallel_tag(NUM_SORT_THREADS));
+          ad_utility::parallel_tag(numSortThreads()));
     } else {
       std::sort(stab.begin(), stab.end(),
                 [keyColumn](const auto& a, const auto& b) {
@@ -48,7 +54,7 @@ class Engine {
     IdTableStatic<WIDTH> stab = std::move(*tab).toStatic<WIDTH>();
     if constexpr (USE_PARALLEL_SORT) {
       ad_utility::parallel_sort(stab.begin(), stab.end(), comp,
-                                ad_utility::parallel_tag(NUM_SORT_THREADS));
+                                ad_utility::parallel_tag(numSortThreads()));
     } else {
       std::sort(stab.begin(), stab.end(), comp);
     }
@@ -315,6 +315,16 @@ bool ExistsJoin::columnOriginatesFromGraphOrUndef(
   return left_->getRootOperation()->columnOriginatesFromGraphOrUndef(variable);
 }
 
+// _____________________________________________________________________________
+std::optional<Datatype> ExistsJoin::getStaticDatatype(
+    const Variable& variable) const {
+  AD_CONTRACT_CHECK(getExternallyVisibleVariableColumns().contains(variable));
+  if (variable == existsVariable_) {
+    return Datatype::Bool;
+  }
+  return left_->getRootOperation()->getStaticDatatype(variable);
+}
+
 namespace {
 
 // Implementation to add the `EXISTS` column to the result of a child operation
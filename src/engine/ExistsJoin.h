@@ -79,6 +79,11 @@ class ExistsJoin : public Operation {
   bool columnOriginatesFromGraphOrUndef(
       const Variable& variable) const override;
 
+  // The added column always contains booleans, all other columns are taken
+  // from the left child.
+  std::optional<Datatype> getStaticDatatype(
+      const Variable& variable) const override;
+
  private:
   std::unique_ptr<Operation> cloneImpl() const override;
 
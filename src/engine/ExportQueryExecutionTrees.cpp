@@ -12,12 +12,15 @@
 #include <absl/strings/str_join.h>
 #include <absl/strings/str_replace.h>
 
+#include <cmath>
 #include <ranges>
 
 #include "backports/algorithm.h"
+#include "global/RuntimeParameters.h"
 #include "index/EncodedIriManager.h"
 #include "index/IndexImpl.h"
 #include "rdfTypes/RdfEscaping.h"
+#include "util/ArrowIpc.h"
 #include "util/ConstexprUtils.h"
 #include "util/ValueIdentity.h"
 #include "util/http/MediaTypes.h"
@@ -286,7 +289,8 @@ ExportQueryExecutionTrees::constructQueryResultBindingsToQLeverJSON(
 nlohmann::json idTableToQLeverJSONRow(
     const QueryExecutionTree& qet,
     const QueryExecutionTree::ColumnIndicesAndTypes& columns,
-    const LocalVocab& localVocab, const size_t rowIndex, const IdTable& data) {
+    const LocalVocab& localVocab, const size_t rowIndex, const IdTable& data,
+    const VocabularyStringCache::Batch& vocabBatch) {
   // We need the explicit `array` constructor for the special case of zero
   // variables.
   auto row = nlohmann::json::array();
@@ -297,8 +301,9 @@ nlohmann::json idTableToQLeverJSONRow(
     }
     const auto& currentId = data(rowIndex, opt->columnIndex_);
     const auto& optionalStringAndXsdType =
-        ExportQueryExecutionTrees::idToStringAndType(qet.getQec()->getIndex(),
-                                                     currentId, localVocab);
+        ExportQueryExecutionTrees::idToStringAndType(
+            qet.getQec()->getIndex(), currentId, localVocab, std::identity{},
+            &vocabBatch);
     if (!optionalStringAndXsdType.has_value()) {
       row.emplace_back(nullptr);
       continue;
@@ -321,13 +326,18 @@ ExportQueryExecutionTrees::idTableToQLeverJSONBindings(
     std::shared_ptr<const Result> result, uint64_t& resultSize,
     CancellationHandle cancellationHandle) {
   AD_CORRECTNESS_CHECK(result != nullptr);
+  auto* vocabCache = vocabularyStringCacheForExport(qet.getQec()->getIndex());
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t rowIndex : range) {
-      co_yield idTableToQLeverJSONRow(qet, columns, pair.localVocab_, rowIndex,
-                                      pair.idTable_)
-          .dump();
-      cancellationHandle->throwIfCancelled();
+    for (auto rows : splitIntoVocabBatches(range)) {
+      auto vocabBatch = resolveVocabIndices(
+          vocabCache, qet.getQec()->getIndex(), pair.idTable_, columns, rows);
+      for (uint64_t rowIndex : rows) {
+        co_yield idTableToQLeverJSONRow(qet, columns, pair.localVocab_,
+                                        rowIndex, pair.idTable_, vocabBatch)
+            .dump();
+        cancellationHandle->throwIfCancelled();
+      }
     }
   }
 }
@@ -452,11 +462,17 @@ ExportQueryExecutionTrees::handleIriOrLiteral(
 
 // _____________________________________________________________________________
 LiteralOrIri ExportQueryExecutionTrees::getLiteralOrIriFromVocabIndex(
-    const Index& index, Id id, const LocalVocab& localVocab) {
+    const Index& index, Id id, const LocalVocab& localVocab,
+    const VocabularyStringCache::Batch* vocabBatch) {
   switch (id.getDatatype()) {
     case Datatype::LocalVocabIndex:
       return localVocab.getWord(id.getLocalVocabIndex()).asLiteralOrIri();
     case Datatype::VocabIndex: {
+      if (vocabBatch != nullptr) {
+        if (const auto* word = vocabBatch->find(id.getVocabIndex())) {
+          return LiteralOrIri::fromStringRepresentation(*word);
+        }
+      }
       auto getEntity = [&index, id]() {
         return index.indexToString(id.getVocabIndex());
       };
@@ -476,6 +492,59 @@ LiteralOrIri ExportQueryExecutionTrees::getLiteralOrIriFromVocabIndex(
   }
 }
 
+// _____________________________________________________________________________
+VocabularyStringCache*
+ExportQueryExecutionTrees::vocabularyStringCacheForExport(const Index& index) {
+  auto maxSize = getRuntimeParameter<
+      &RuntimeParameters::exportVocabularyCacheMaxSize_>();
+  if (maxSize.getBytes() == 0) {
+    return nullptr;
+  }
+  auto& cache = index.getVocabularyStringCache();
+  cache.setMaxSize(maxSize);
+  return &cache;
+}
+
+// _____________________________________________________________________________
+std::vector<ql::ranges::iota_view<uint64_t, uint64_t>>
+ExportQueryExecutionTrees::splitIntoVocabBatches(
+    ql::ranges::iota_view<uint64_t, uint64_t> rows) {
+  std::vector<ql::ranges::iota_view<uint64_t, uint64_t>> batches;
+  uint64_t end = *rows.end();
+  for (uint64_t begin = *rows.begin(); begin < end;
+       begin += VOCAB_BATCH_NUM_ROWS) {
+    batches.emplace_back(begin, std::min(end, begin + VOCAB_BATCH_NUM_ROWS));
+  }
+  return batches;
+}
+
+// _____________________________________________________________________________
+VocabularyStringCache::Batch ExportQueryExecutionTrees::resolveVocabIndices(
+    VocabularyStringCache* cache, const Index& index, const IdTable& idTable,
+    const QueryExecutionTree::ColumnIndicesAndTypes& columns,
+    ql::ranges::iota_view<uint64_t, uint64_t> rows) {
+  std::vector<VocabIndex> indices;
+  for (const auto& column : columns) {
+    if (!column.has_value()) {
+      continue;
+    }
+    for (uint64_t row : rows) {
+      Id id = idTable(row, column->columnIndex_);
+      if (id.getDatatype() == Datatype::VocabIndex) {
+        indices.push_back(id.getVocabIndex());
+      }
+    }
+  }
+  auto lookup = [&index](VocabIndex vocabIndex) {
+    return std::string(index.indexToString(vocabIndex));
+  };
+  if (cache == nullptr) {
+    return VocabularyStringCache::resolveWithoutCache(std::move(indices),
+                                                      lookup);
+  }
+  return cache->resolve(std::move(indices), lookup);
+}
+
 // _____________________________________________________________________________
 std::optional<std::string> ExportQueryExecutionTrees::blankNodeIriToString(
     const ad_utility::triple_component::Iri& iri) {
@@ -494,9 +563,10 @@ std::optional<std::string> ExportQueryExecutionTrees::blankNodeIriToString(
 template <bool removeQuotesAndAngleBrackets, bool onlyReturnLiterals,
           typename EscapeFunction>
 std::optional<std::pair<std::string, const char*>>
-ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
-                                             const LocalVocab& localVocab,
-                                             EscapeFunction&& escapeFunction) {
+ExportQueryExecutionTrees::idToStringAndType(
+    const Index& index, Id id, const LocalVocab& localVocab,
+    EscapeFunction&& escapeFunction,
+    const VocabularyStringCache::Batch* vocabBatch) {
   using enum Datatype;
   auto datatype = id.getDatatype();
   if constexpr (onlyReturnLiterals) {
@@ -533,7 +603,7 @@ ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
     case VocabIndex:
     case LocalVocabIndex:
       return handleIriOrLiteral(
-          getLiteralOrIriFromVocabIndex(index, id, localVocab));
+          getLiteralOrIriFromVocabIndex(index, id, localVocab, vocabBatch));
     case EncodedVal:
       return handleIriOrLiteral(encodedIdToLiteralOrIri(id, index));
     case TextRecordIndex:
@@ -641,22 +711,25 @@ ExportQueryExecutionTrees::idToLiteralOrIri(const Index& index, Id id,
 template std::optional<std::pair<std::string, const char*>>
 ExportQueryExecutionTrees::idToStringAndType<true, false, std::identity>(
     const Index& index, Id id, const LocalVocab& localVocab,
-    std::identity&& escapeFunction);
+    std::identity&& escapeFunction,
+    const VocabularyStringCache::Batch* vocabBatch);
 
 // ___________________________________________________________________________
 template std::optional<std::pair<std::string, const char*>>
 ExportQueryExecutionTrees::idToStringAndType<true, true, std::identity>(
     const Index& index, Id id, const LocalVocab& localVocab,
-    std::identity&& escapeFunction);
+    std::identity&& escapeFunction,
+    const VocabularyStringCache::Batch* vocabBatch);
 
 // This explicit instantiation is necessary because the `Variable` class
 // currently still uses it.
 // TODO<joka921> Refactor the CONSTRUCT export, then this is no longer
 // needed
 template std::optional<std::pair<std::string, const char*>>
-ExportQueryExecutionTrees::idToStringAndType(const Index& index, Id id,
-                                             const LocalVocab& localVocab,
-                                             std::identity&& escapeFunction);
+ExportQueryExecutionTrees::idToStringAndType(
+    const Index& index, Id id, const LocalVocab& localVocab,
+    std::identity&& escapeFunction,
+    const VocabularyStringCache::Batch* vocabBatch);
 
 // Convert a stringvalue and optional type to JSON binding.
 static nlohmann::json stringAndTypeToBinding(std::string_view entitystr,
@@ -739,6 +812,154 @@ ExportQueryExecutionTrees::selectQueryResultBindingsToQLeverJSON(
                                      std::move(cancellationHandle));
 }
 
+// Return the number of days between 1970-01-01 and the given date in the
+// proleptic Gregorian calendar (see
+// https://howardhinnant.github.io/date_algorithms.html#days_from_civil).
+static int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+  year -= month <= 2;
+  const int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+  const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) /
+                                 5 +
+                             day - 1;
+  const unsigned dayOfEra =
+      yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+// Convert the `id` to milliseconds since the epoch (UTC) if it holds a
+// complete date (which is not the case for large years and durations). Dates
+// without a time are mapped to midnight, and dates without a time zone are
+// interpreted as UTC. Missing months and days (e.g. for `xsd:gYear`) are
+// treated as January and the first day of the month.
+static std::optional<int64_t> idToArrowTimestamp(Id id) {
+  if (id.getDatatype() != Datatype::Date || !id.getDate().isDate()) {
+    return std::nullopt;
+  }
+  const Date date = id.getDate().getDate();
+  int64_t millis =
+      daysFromCivil(date.getYear(),
+                    static_cast<unsigned>(std::max(date.getMonth(), 1)),
+                    static_cast<unsigned>(std::max(date.getDay(), 1))) *
+      86'400'000;
+  if (date.hasTime()) {
+    millis += date.getHour() * int64_t{3'600'000} +
+              date.getMinute() * int64_t{60'000} +
+              std::llround(date.getSecond() * 1000);
+  }
+  auto timeZone = date.getTimeZone();
+  if (const int* hours = std::get_if<int>(&timeZone)) {
+    millis -= *hours * int64_t{3'600'000};
+  }
+  return millis;
+}
+
+// Determine the Arrow type of a column of the result from its values in the
+// given `rows` of the `idTable`, which must contain all the exported rows.
+// Columns that consist only of integers, numbers, booleans, or dates are
+// exported with the corresponding native type, all other columns (including
+// columns with only undefined values) as strings.
+static ad_utility::arrow::ColumnType arrowColumnType(
+    const IdTable& idTable, ColumnIndex column,
+    ql::ranges::iota_view<uint64_t, uint64_t> rows) {
+  using ad_utility::arrow::ColumnType;
+  bool anyDefined = false;
+  bool allInts = true;
+  bool allNumeric = true;
+  bool allBools = true;
+  bool allDates = true;
+  for (uint64_t row : rows) {
+    Id id = idTable(row, column);
+    Datatype datatype = id.getDatatype();
+    if (datatype == Datatype::Undefined) {
+      continue;
+    }
+    anyDefined = true;
+    allInts &= datatype == Datatype::Int;
+    allNumeric &= datatype == Datatype::Int || datatype == Datatype::Double;
+    allBools &= datatype == Datatype::Bool;
+    allDates &= idToArrowTimestamp(id).has_value();
+  }
+  if (!anyDefined) {
+    return ColumnType::String;
+  } else if (allInts) {
+    return ColumnType::Int64;
+  } else if (allNumeric) {
+    return ColumnType::Float64;
+  } else if (allBools) {
+    return ColumnType::Bool;
+  } else if (allDates) {
+    return ColumnType::Timestamp;
+  }
+  return ColumnType::String;
+}
+
+// Return the type of the Arrow column for values that are statically known to
+// all have the `datatype` (see `Operation::getStaticDatatype`). Values with an
+// unknown or mixed datatype, and dates (which can't all be represented as a
+// timestamp) are exported as strings.
+static ad_utility::arrow::ColumnType arrowColumnType(
+    std::optional<Datatype> datatype) {
+  using ad_utility::arrow::ColumnType;
+  if (datatype == Datatype::Int) {
+    return ColumnType::Int64;
+  } else if (datatype == Datatype::Double) {
+    return ColumnType::Float64;
+  } else if (datatype == Datatype::Bool) {
+    return ColumnType::Bool;
+  }
+  return ColumnType::String;
+}
+
+// Append the value of the `id` to the `column`. Undefined values are exported
+// as null, all other values must match the type of the column (see
+// `arrowColumnType`).
+static void appendToArrowColumn(
+    ad_utility::arrow::ColumnBuilder& column, Id id, const Index& index,
+    const LocalVocab& localVocab,
+    const VocabularyStringCache::Batch& vocabBatch) {
+  using ad_utility::arrow::ColumnType;
+  Datatype datatype = id.getDatatype();
+  if (datatype == Datatype::Undefined) {
+    column.appendNull();
+    return;
+  }
+  switch (column.type()) {
+    case ColumnType::Int64:
+      AD_CORRECTNESS_CHECK(datatype == Datatype::Int);
+      column.appendInt(id.getInt());
+      return;
+    case ColumnType::Float64:
+      AD_CORRECTNESS_CHECK(datatype == Datatype::Int ||
+                           datatype == Datatype::Double);
+      column.appendDouble(datatype == Datatype::Int
+                              ? static_cast<double>(id.getInt())
+                              : id.getDouble());
+      return;
+    case ColumnType::Bool:
+      AD_CORRECTNESS_CHECK(datatype == Datatype::Bool);
+      column.appendBool(id.getBool());
+      return;
+    case ColumnType::Timestamp: {
+      auto timestamp = idToArrowTimestamp(id);
+      AD_CORRECTNESS_CHECK(timestamp.has_value());
+      column.appendTimestamp(timestamp.value());
+      return;
+    }
+    case ColumnType::String:
+      if (auto stringAndType =
+              ExportQueryExecutionTrees::idToStringAndType<true>(
+                  index, id, localVocab, std::identity{}, &vocabBatch);
+          stringAndType.has_value()) {
+        column.appendString(stringAndType.value().first);
+      } else {
+        column.appendNull();
+      }
+      return;
+  }
+  AD_FAIL();
+}
+
 // _____________________________________________________________________________
 template <ad_utility::MediaType format>
 STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
@@ -748,7 +969,8 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
     [[maybe_unused]] STREAMABLE_YIELDER_TYPE streamableYielder) {
   static_assert(format == MediaType::octetStream || format == MediaType::csv ||
                 format == MediaType::tsv || format == MediaType::turtle ||
-                format == MediaType::qleverJson);
+                format == MediaType::qleverJson ||
+                format == MediaType::arrowStream);
 
   // TODO<joka921> Use a proper error message, or check that we get a more
   // reasonable error from upstream.
@@ -784,6 +1006,82 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
     STREAMABLE_RETURN;
   }
 
+  // special case : Arrow IPC stream with one record batch per slice of at most
+  // `VOCAB_BATCH_NUM_ROWS` rows of a block
+  if constexpr (format == MediaType::arrowStream) {
+    using namespace ad_utility::arrow;
+    const auto& index = qet.getQec()->getIndex();
+    const auto& variables = selectClause.getSelectedVariables();
+    std::vector<ColumnBuilder> columns;
+    // Determine the types of the columns and return the schema message. The
+    // schema has to be sent before the first record batch, so the types can
+    // only be derived from the values if the result is fully materialized
+    // (and thus consists of a single block). The values of a lazy result are
+    // not known in advance, so the types of its columns are derived from the
+    // datatypes that the query plan guarantees. Columns without such a
+    // guarantee are exported as strings, which can represent every value.
+    auto makeSchema = [&](const TableWithRange* firstBlock) {
+      std::vector<std::pair<std::string, ColumnType>> schema;
+      for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
+        ColumnType type = ColumnType::String;
+        const auto& columnIndex = selectedColumnIndices[j];
+        if (columnIndex.has_value() && !result->isFullyMaterialized()) {
+          type = arrowColumnType(
+              qet.getRootOperation()->getStaticDatatype(variables[j]));
+        } else if (columnIndex.has_value() && firstBlock != nullptr) {
+          type = arrowColumnType(firstBlock->tableWithVocab_.idTable_,
+                                 columnIndex.value().columnIndex_,
+                                 firstBlock->view_);
+        }
+        // The variable names don't include the question mark.
+        schema.emplace_back(variables[j].name().substr(1), type);
+        columns.emplace_back(type);
+      }
+      return schemaMessage(schema);
+    };
+    bool hasSchema = false;
+    uint64_t resultSize = 0;
+    auto* vocabCache = vocabularyStringCacheForExport(index);
+    for (const auto& block :
+         getRowIndices(limitAndOffset, *result, resultSize)) {
+      const auto& [pair, range] = block;
+      if (range.empty()) {
+        continue;
+      }
+      if (!hasSchema) {
+        STREAMABLE_YIELD(makeSchema(&block));
+        hasSchema = true;
+      }
+      for (auto rows : splitIntoVocabBatches(range)) {
+        auto vocabBatch = resolveVocabIndices(
+            vocabCache, index, pair.idTable_, selectedColumnIndices, rows);
+        for (uint64_t i : rows) {
+          for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
+            if (selectedColumnIndices[j].has_value()) {
+              appendToArrowColumn(
+                  columns[j],
+                  pair.idTable_(i,
+                                selectedColumnIndices[j].value().columnIndex_),
+                  index, pair.localVocab_, vocabBatch);
+            } else {
+              columns[j].appendNull();
+            }
+          }
+          cancellationHandle->throwIfCancelled();
+        }
+        // Emit one record batch per slice, so that the builders never hold
+        // more than `VOCAB_BATCH_NUM_ROWS` rows, even for a large block.
+        STREAMABLE_YIELD(recordBatchMessages(columns));
+        ql::ranges::for_each(columns, &ColumnBuilder::clear);
+      }
+    }
+    if (!hasSchema) {
+      STREAMABLE_YIELD(makeSchema(nullptr));
+    }
+    STREAMABLE_YIELD(endOfStreamMessage());
+    STREAMABLE_RETURN;
+  }
+
   static constexpr char separator = format == MediaType::tsv ? '\t' : ',';
   // Print header line
   std::vector<std::string> variables =
@@ -800,27 +1098,33 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
                                        ? RdfEscaping::escapeForTsv
                                        : RdfEscaping::escapeForCsv;
   uint64_t resultSize = 0;
+  auto* vocabCache = vocabularyStringCacheForExport(qet.getQec()->getIndex());
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
-        if (selectedColumnIndices[j].has_value()) {
-          const auto& val = selectedColumnIndices[j].value();
-          Id id = pair.idTable_(i, val.columnIndex_);
-          auto optionalStringAndType =
-              idToStringAndType<format == MediaType::csv>(
-                  qet.getQec()->getIndex(), id, pair.localVocab_,
-                  escapeFunction);
-          if (optionalStringAndType.has_value()) [[likely]] {
-            STREAMABLE_YIELD(optionalStringAndType.value().first);
+    for (auto rows : splitIntoVocabBatches(range)) {
+      auto vocabBatch =
+          resolveVocabIndices(vocabCache, qet.getQec()->getIndex(),
+                              pair.idTable_, selectedColumnIndices, rows);
+      for (uint64_t i : rows) {
+        for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
+          if (selectedColumnIndices[j].has_value()) {
+            const auto& val = selectedColumnIndices[j].value();
+            Id id = pair.idTable_(i, val.columnIndex_);
+            auto optionalStringAndType =
+                idToStringAndType<format == MediaType::csv>(
+                    qet.getQec()->getIndex(), id, pair.localVocab_,
+                    escapeFunction, &vocabBatch);
+            if (optionalStringAndType.has_value()) [[likely]] {
+              STREAMABLE_YIELD(optionalStringAndType.value().first);
+            }
+          }
+          if (j + 1 < selectedColumnIndices.size()) {
+            STREAMABLE_YIELD(separator);
           }
         }
-        if (j + 1 < selectedColumnIndices.size()) {
-          STREAMABLE_YIELD(separator);
-        }
+        STREAMABLE_YIELD('\n');
+        cancellationHandle->throwIfCancelled();
       }
-      STREAMABLE_YIELD('\n');
-      cancellationHandle->throwIfCancelled();
     }
   }
   AD_LOG_DEBUG << "Done creating readable result.\n";
@@ -828,13 +1132,14 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
 
 // Convert a single ID to an XML binding of the given `variable`.
 template <typename IndexType, typename LocalVocabType>
-static std::string idToXMLBinding(std::string_view variable, Id id,
-                                  const IndexType& index,
-                                  const LocalVocabType& localVocab) {
+static std::string idToXMLBinding(
+    std::string_view variable, Id id, const IndexType& index,
+    const LocalVocabType& localVocab,
+    const VocabularyStringCache::Batch* vocabBatch = nullptr) {
   using namespace std::string_view_literals;
   using namespace std::string_literals;
-  const auto& optionalValue =
-      ExportQueryExecutionTrees::idToStringAndType(index, id, localVocab);
+  const auto& optionalValue = ExportQueryExecutionTrees::idToStringAndType(
+      index, id, localVocab, std::identity{}, vocabBatch);
   if (!optionalValue.has_value()) {
     return ""s;
   }
@@ -933,20 +1238,27 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
       qet.selectedVariablesToColumnIndices(selectClause, false);
   // TODO<joka921> we could prefilter for the nonexisting variables.
   uint64_t resultSize = 0;
+  auto* vocabCache = vocabularyStringCacheForExport(qet.getQec()->getIndex());
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      STREAMABLE_YIELD("\n  <result>");
-      for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
-        if (selectedColumnIndices[j].has_value()) {
-          const auto& val = selectedColumnIndices[j].value();
-          Id id = pair.idTable_(i, val.columnIndex_);
-          STREAMABLE_YIELD(idToXMLBinding(
-              val.variable_, id, qet.getQec()->getIndex(), pair.localVocab_));
+    for (auto rows : splitIntoVocabBatches(range)) {
+      auto vocabBatch =
+          resolveVocabIndices(vocabCache, qet.getQec()->getIndex(),
+                              pair.idTable_, selectedColumnIndices, rows);
+      for (uint64_t i : rows) {
+        STREAMABLE_YIELD("\n  <result>");
+        for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
+          if (selectedColumnIndices[j].has_value()) {
+            const auto& val = selectedColumnIndices[j].value();
+            Id id = pair.idTable_(i, val.columnIndex_);
+            STREAMABLE_YIELD(idToXMLBinding(val.variable_, id,
+                                            qet.getQec()->getIndex(),
+                                            pair.localVocab_, &vocabBatch));
+          }
         }
+        STREAMABLE_YIELD("\n  </result>");
+        cancellationHandle->throwIfCancelled();
       }
-      STREAMABLE_YIELD("\n  </result>");
-      cancellationHandle->throwIfCancelled();
     }
   }
   STREAMABLE_YIELD("\n</results>");
@@ -982,12 +1294,13 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   ql::erase(columns, std::nullopt);
 
   auto getBinding = [&](const IdTable& idTable, const uint64_t& i,
-                        const LocalVocab& localVocab) {
+                        const LocalVocab& localVocab,
+                        const VocabularyStringCache::Batch& vocabBatch) {
     nlohmann::ordered_json binding = {};
     for (const auto& column : columns) {
-      auto optionalStringAndType =
-          idToStringAndType(qet.getQec()->getIndex(),
-                            idTable(i, column->columnIndex_), localVocab);
+      auto optionalStringAndType = idToStringAndType(
+          qet.getQec()->getIndex(), idTable(i, column->columnIndex_),
+          localVocab, std::identity{}, &vocabBatch);
       if (optionalStringAndType.has_value()) [[likely]] {
         const auto& [stringValue, xsdType] = optionalStringAndType.value();
         binding[column->variable_] =
@@ -1001,19 +1314,25 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   // is empty, we have to output an empty set of bindings per row.
   bool isFirstRow = true;
   uint64_t resultSize = 0;
+  auto* vocabCache = vocabularyStringCacheForExport(qet.getQec()->getIndex());
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
-    for (uint64_t i : range) {
-      if (!isFirstRow) [[likely]] {
-        STREAMABLE_YIELD(",");
-      }
-      if (columns.empty()) {
-        STREAMABLE_YIELD("{}");
-      } else {
-        STREAMABLE_YIELD(getBinding(pair.idTable_, i, pair.localVocab_));
+    for (auto rows : splitIntoVocabBatches(range)) {
+      auto vocabBatch = resolveVocabIndices(
+          vocabCache, qet.getQec()->getIndex(), pair.idTable_, columns, rows);
+      for (uint64_t i : rows) {
+        if (!isFirstRow) [[likely]] {
+          STREAMABLE_YIELD(",");
+        }
+        if (columns.empty()) {
+          STREAMABLE_YIELD("{}");
+        } else {
+          STREAMABLE_YIELD(
+              getBinding(pair.idTable_, i, pair.localVocab_, vocabBatch));
+        }
+        cancellationHandle->throwIfCancelled();
+        isFirstRow = false;
       }
-      cancellationHandle->throwIfCancelled();
-      isFirstRow = false;
     }
   }
 
@@ -1033,9 +1352,12 @@ ExportQueryExecutionTrees::constructQueryResultToStream(
   static_assert(format == MediaType::octetStream || format == MediaType::csv ||
                 format == MediaType::tsv || format == MediaType::sparqlXml ||
                 format == MediaType::sparqlJson ||
-                format == MediaType::qleverJson);
+                format == MediaType::qleverJson ||
+                format == MediaType::arrowStream);
   if constexpr (format == MediaType::octetStream) {
     AD_THROW("Binary export is not supported for CONSTRUCT queries");
+  } else if constexpr (format == MediaType::arrowStream) {
+    AD_THROW("Arrow export is not supported for CONSTRUCT queries");
   } else if constexpr (format == MediaType::sparqlXml) {
     AD_THROW("XML export is currently not supported for CONSTRUCT queries");
   } else if constexpr (format == MediaType::sparqlJson) {
@@ -1141,17 +1463,20 @@ ExportQueryExecutionTrees::computeResult(
   using enum MediaType;
 
   static constexpr std::array supportedTypes{
-      csv, tsv, octetStream, turtle, sparqlXml, sparqlJson, qleverJson};
+      csv,       tsv,        octetStream, turtle,
+      sparqlXml, sparqlJson, qleverJson,  arrowStream};
   AD_CORRECTNESS_CHECK(ad_utility::contains(supportedTypes, mediaType));
 
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
   auto inner =
       ad_utility::ConstexprSwitch<csv, tsv, octetStream, turtle, sparqlXml,
-                                  sparqlJson, qleverJson>{}(compute, mediaType);
+                                  sparqlJson, qleverJson, arrowStream>{}(
+          compute, mediaType);
   return convertStreamGeneratorForChunkedTransfer(std::move(inner));
 #else
   ad_utility::ConstexprSwitch<csv, tsv, octetStream, turtle, sparqlXml,
-                              sparqlJson, qleverJson>{}(compute, mediaType);
+                              sparqlJson, qleverJson, arrowStream>{}(compute,
+                                                                     mediaType);
 #endif
 }
 
@@ -8,6 +8,7 @@
 #define QLEVER_SRC_ENGINE_EXPORTQUERYEXECUTIONTREES_H
 
 #include "engine/QueryExecutionTree.h"
+#include "index/VocabularyStringCache.h"
 #include "parser/data/LimitOffsetClause.h"
 #include "util/CancellationHandle.h"
 #include "util/http/MediaTypes.h"
@@ -30,9 +31,9 @@ class ExportQueryExecutionTrees {
   // created by the `QueryPlanner`. The result is converted into a sequence of
   // bytes that represents the result of the computed query in the format
   // specified by the `mediaType`. Supported formats for this function are CSV,
-  // TSV, Turtle, Binary, SparqlJSON, QLeverJSON. Note that the Binary format
-  // can only be used with SELECT queries and the Turtle format can only be used
-  // with CONSTRUCT queries. Invalid `mediaType`s and invalid combinations of
+  // TSV, Turtle, Binary, Arrow, SparqlJSON, QLeverJSON. Note that the Binary
+  // and Arrow formats can only be used with SELECT queries and the Turtle
+  // format can only be used with CONSTRUCT queries. Invalid `mediaType`s and invalid combinations of
   // `mediaType` and the query type will throw. The result is returned as a
   // `generator` that lazily computes the serialized result in large chunks of
   // bytes.
@@ -63,7 +64,9 @@ class ExportQueryExecutionTrees {
   // contain the corresponding XSD-datatype as an URI. For all other values and
   // datatypes, the second element of the pair will be empty and the first
   // element will have the format `"stringContent"^^datatypeUri`. If the `id`
-  // holds the `Undefined` value, then `std::nullopt` is returned.
+  // holds the `Undefined` value, then `std::nullopt` is returned. If a
+  // `vocabBatch` is given, words from the vocabulary are taken from it if
+  // possible (see `resolveVocabIndices` below).
   //
   // Note: This function currently has to be public because the
   // `Variable::evaluate` function calls it for evaluating CONSTRUCT queries.
@@ -75,7 +78,8 @@ class ExportQueryExecutionTrees {
             typename EscapeFunction = std::identity>
   static std::optional<std::pair<std::string, const char*>> idToStringAndType(
       const Index& index, Id id, const LocalVocab& localVocab,
-      EscapeFunction&& escapeFunction = EscapeFunction{});
+      EscapeFunction&& escapeFunction = EscapeFunction{},
+      const VocabularyStringCache::Batch* vocabBatch = nullptr);
 
   // Same as the previous function, but only handles the datatypes for which the
   // value is encoded directly in the ID. For other datatypes an exception is
@@ -147,9 +151,36 @@ class ExportQueryExecutionTrees {
   // Acts as a helper to retrieve an LiteralOrIri object
   // from an Id, where the Id is of type `VocabIndex` or `LocalVocabIndex`.
   // This function should only be called with suitable `Datatype` Id's,
-  // otherwise `AD_FAIL()` is called.
+  // otherwise `AD_FAIL()` is called. If the word of a `VocabIndex` is contained
+  // in the `vocabBatch`, it is not looked up in the vocabulary.
   static LiteralOrIri getLiteralOrIriFromVocabIndex(
-      const Index& index, Id id, const LocalVocab& localVocab);
+      const Index& index, Id id, const LocalVocab& localVocab,
+      const VocabularyStringCache::Batch* vocabBatch = nullptr);
+
+  // The maximal number of rows whose words are resolved in one batch by
+  // `resolveVocabIndices`, which bounds the memory of a batch.
+  static constexpr uint64_t VOCAB_BATCH_NUM_ROWS = 16'384;
+
+  // Return the `VocabularyStringCache` of the `index` with the size from the
+  // runtime parameter `export-vocabulary-cache-max-size`, or `nullptr` if the
+  // parameter is zero. This is called once per export.
+  static VocabularyStringCache* vocabularyStringCacheForExport(
+      const Index& index);
+
+  // Split the `rows` into consecutive batches of at most
+  // `VOCAB_BATCH_NUM_ROWS` rows.
+  static std::vector<ql::ranges::iota_view<uint64_t, uint64_t>>
+  splitIntoVocabBatches(ql::ranges::iota_view<uint64_t, uint64_t> rows);
+
+  // Look up the words of all the `VocabIndex` IDs in the given `columns` and
+  // `rows` of the `idTable` in one batch, using the `cache` (see
+  // `vocabularyStringCacheForExport`) unless it is `nullptr`. The words are
+  // read in the order in which they are stored in the vocabulary, and each
+  // distinct word is read at most once per batch.
+  static VocabularyStringCache::Batch resolveVocabIndices(
+      VocabularyStringCache* cache, const Index& index, const IdTable& idTable,
+      const QueryExecutionTree::ColumnIndicesAndTypes& columns,
+      ql::ranges::iota_view<uint64_t, uint64_t> rows);
 
   // Convert a `stream_generator` to an "ordinary" `generator<string>` that
   // yields exactly the same chunks as the `stream_generator`. Exceptions that
@@ -0,0 +1,134 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_EXTERNALSORT_H
+#define QLEVER_SRC_ENGINE_EXTERNALSORT_H
+
+#include <absl/strings/str_cat.h>
+
+#include <atomic>
+#include <filesystem>
+#include <optional>
+
+#include "engine/QueryExecutionTree.h"
+#include "engine/Result.h"
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "global/RuntimeParameters.h"
+#include "util/CancellationHandle.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Random.h"
+
+// Helpers for the `Sort` and `OrderBy` operations to sort inputs that are too
+// large to be sorted in RAM. The input is consumed lazily and split into runs,
+// each of which is sorted in RAM and then written to disk in compressed form.
+// The sorted runs are then lazily merged. This reuses the external merge sort
+// of the index builder, see `CompressedExternalIdTableSorter`.
+namespace qlever::externalSort {
+
+// The minimal number of rows of a single sorted run. Is only relevant if the
+// memory for the external sort is very small (e.g. in tests), otherwise the
+// runs are much larger.
+inline constexpr size_t MIN_NUM_ROWS_PER_RUN = 1'000;
+
+// Decide whether the result of `tree` has to be sorted externally. This is the
+// case if its estimated size is larger than the fraction
+// `external-sort-memory-fraction` (a runtime parameter) of the memory that is
+// still available according to the `allocator`. If so, return the amount of
+// memory that the external sort may use, else return `std::nullopt`. The
+// external sort is only used if the consumer can handle a lazy result
+// (`requestLaziness`), because a fully materialized sorted result would need
+// as much memory as the in-memory sort.
+inline std::optional<ad_utility::MemorySize> getMemoryForExternalSort(
+    QueryExecutionTree& tree,
+    const ad_utility::AllocatorWithLimit<Id>& allocator,
+    bool requestLaziness) {
+  using ad_utility::MemorySize;
+  if (!requestLaziness) {
+    return std::nullopt;
+  }
+  double fraction =
+      getRuntimeParameter<&RuntimeParameters::externalSortMemoryFraction_>();
+  auto memoryLeft = allocator.amountMemoryLeft();
+  auto threshold = MemorySize::bytes(static_cast<size_t>(
+      fraction * static_cast<double>(memoryLeft.getBytes())));
+  size_t bytesPerRow = tree.getResultWidth() * sizeof(Id);
+  auto estimatedSize = MemorySize::bytes(tree.getSizeEstimate() * bytesPerRow);
+  if (bytesPerRow == 0 || estimatedSize <= threshold) {
+    return std::nullopt;
+  }
+  // The sorter keeps two runs in RAM at the same time, one that is currently
+  // being filled, and one that is sorted and written in the background. The
+  // other half of the remaining memory is left for the blocks of the input.
+  return std::max(std::min(threshold, memoryLeft / 2),
+                  MemorySize::bytes(2 * MIN_NUM_ROWS_PER_RUN * bytesPerRow));
+}
+
+// Return a unique filename for the temporary file of an external sort. The
+// file is placed in the temporary directory of the system (and not next to the
+// index files, which might be on a read-only or small file system). The random
+// part avoids clashes between several servers on the same machine.
+inline std::string makeFilenameForExternalSort() {
+  static std::atomic<size_t> counter = 0;
+  static const std::string prefix = absl::StrCat(
+      (std::filesystem::temp_directory_path() / "qlever.external-sort.")
+          .string(),
+      ad_utility::UuidGenerator{}(), ".");
+  return absl::StrCat(prefix, counter++, ".tmp");
+}
+
+// Sort the rows of the `input` (which may be lazy or fully materialized) with
+// `numColumns` columns according to the `comparator`, using at most `memory`
+// for the sorted runs. The temporary file is created at `filename` and deleted
+// as soon as the returned result has been consumed or destroyed. The sorted
+// rows are yielded lazily in blocks. The local vocabs of all input blocks are
+// merged into a single local vocab, which is shared by all the blocks.
+template <typename Comparator>
+Result sortExternally(std::shared_ptr<const Result> input, size_t numColumns,
+                      Comparator comparator, std::vector<ColumnIndex> sortedOn,
+                      std::string filename, ad_utility::MemorySize memory,
+                      const ad_utility::AllocatorWithLimit<Id>& allocator,
+                      const ad_utility::SharedCancellationHandle& handle) {
+  using Sorter = ad_utility::CompressedExternalIdTableSorter<Comparator, 0>;
+  auto sorter = std::make_shared<Sorter>(
+      std::move(filename), numColumns, memory, allocator,
+      ad_utility::DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE, std::move(comparator));
+
+  LocalVocab localVocab;
+  if (input->isFullyMaterialized()) {
+    sorter->pushBlock(input->idTable());
+    localVocab = input->getCopyOfLocalVocab();
+  } else {
+    for (auto& [block, blockVocab] : input->idTables()) {
+      sorter->pushBlock(block);
+      // Only merge the word sets that are not empty, so that the merged vocab
+      // consists of as few sets as possible.
+      if (!blockVocab.empty()) {
+        localVocab.mergeWith(blockVocab);
+      }
+      handle->throwIfCancelled();
+    }
+  }
+  // The input is not needed anymore, so we can already free its memory.
+  input.reset();
+
+  // Note: The `sorter` is owned by the generator, s.t. the temporary file is
+  // deleted as soon as the generator is destroyed. Each block has to own its
+  // local vocab, but the blocks only get a logical copy of the shared word
+  // sets (and no copy at all if there are no local words).
+  auto generator = [](std::shared_ptr<Sorter> sorter, LocalVocab localVocab,
+                      ad_utility::SharedCancellationHandle handle)
+      -> Result::Generator {
+    for (auto& block : sorter->template getSortedBlocks<0>()) {
+      handle->throwIfCancelled();
+      co_yield {IdTable{std::move(block)},
+                localVocab.empty() ? LocalVocab{} : localVocab.clone()};
+    }
+  }(std::move(sorter), std::move(localVocab), handle);
+  return {std::move(generator), std::move(sortedOn)};
+}
+
+}  // namespace qlever::externalSort
+
+#endif  // QLEVER_SRC_ENGINE_EXTERNALSORT_H
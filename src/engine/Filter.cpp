@@ -11,6 +11,7 @@
 #include "backports/algorithm.h"
 #include "engine/CallFixedSize.h"
 #include "engine/ExistsJoin.h"
+#include "engine/MorselParallelism.h"
 #include "engine/QueryExecutionTree.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
@@ -68,6 +69,12 @@ Result Filter::computeResult(bool requestLaziness) {
   AD_LOG_DEBUG << "Filter result computation..." << endl;
   checkCancellation();
 
+  if (size_t numThreads = qlever::morsels::getNumThreads(*subRes);
+      numThreads > 1) {
+    return computeResultInParallel(std::move(subRes), numThreads,
+                                   requestLaziness);
+  }
+
   if (subRes->isFullyMaterialized()) {
     IdTable result = filterIdTable(subRes->sortedBy(), subRes->idTable());
     AD_LOG_DEBUG << "Filter result computation done." << endl;
@@ -101,8 +108,9 @@ Result Filter::computeResult(bool requestLaziness) {
   ad_utility::callFixedSizeVi(
       width, [this, &subRes, &result, &resultLocalVocab](auto WIDTH) {
         for (Result::IdTableVocabPair& pair : subRes->idTables()) {
+          size_t numRows = pair.idTable_.size();
           computeFilterImpl<WIDTH>(result, std::move(pair.idTable_),
-                                   subRes->sortedBy());
+                                   subRes->sortedBy(), 0, numRows);
           resultLocalVocab.mergeWith(pair.localVocab_);
         }
       });
@@ -112,6 +120,29 @@ Result Filter::computeResult(bool requestLaziness) {
   return {std::move(result), resultSortedOn(), std::move(resultLocalVocab)};
 }
 
+// _____________________________________________________________________________
+Result Filter::computeResultInParallel(std::shared_ptr<const Result> subRes,
+                                       size_t numThreads,
+                                       bool requestLaziness) {
+  auto filterMorsel = [this, sortedBy = subRes->sortedBy()](
+                          qlever::morsels::Morsel morsel) {
+    IdTable filteredTable =
+        filterRows(sortedBy, *morsel.table_, morsel.begin_, morsel.end_);
+    return Result::IdTableVocabPair{std::move(filteredTable),
+                                    std::move(morsel.localVocab_)};
+  };
+  auto filtered = qlever::morsels::processInParallel(
+      std::move(subRes), numThreads, std::move(filterMorsel));
+  if (requestLaziness) {
+    return {std::move(filtered), resultSortedOn()};
+  }
+  auto [result, localVocab] = qlever::morsels::materialize(
+      std::move(filtered), getResultWidth(),
+      getExecutionContext()->getAllocator());
+  AD_LOG_DEBUG << "Filter result computation done." << endl;
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
+
 // _____________________________________________________________________________
 CPP_template_def(typename Table)(requires ad_utility::SimilarTo<Table, IdTable>)
     IdTable Filter::filterIdTable(std::vector<ColumnIndex> sortedBy,
@@ -119,21 +150,38 @@ CPP_template_def(typename Table)(requires ad_utility::SimilarTo<Table, IdTable>)
   size_t width = idTable.numColumns();
   IdTable result{width, getExecutionContext()->getAllocator()};
 
-  auto impl = [this, &result, &idTable, &sortedBy](auto WIDTH) {
+  size_t numRows = idTable.size();
+  auto impl = [this, &result, &idTable, &sortedBy, numRows](auto WIDTH) {
     return this->computeFilterImpl<WIDTH>(result, AD_FWD(idTable),
-                                          std::move(sortedBy));
+                                          std::move(sortedBy), 0, numRows);
   };
   ad_utility::callFixedSizeVi(width, impl);
   return result;
 }
 
+// _____________________________________________________________________________
+IdTable Filter::filterRows(std::vector<ColumnIndex> sortedBy,
+                           const IdTable& idTable, size_t beginIndex,
+                           size_t endIndex) const {
+  size_t width = idTable.numColumns();
+  IdTable result{width, getExecutionContext()->getAllocator()};
+  ad_utility::callFixedSizeVi(width, [&](auto WIDTH) {
+    this->computeFilterImpl<WIDTH>(result, idTable, std::move(sortedBy),
+                                   beginIndex, endIndex);
+  });
+  return result;
+}
+
 // _____________________________________________________________________________
 CPP_template_def(int WIDTH, typename Table)(
     requires ad_utility::SimilarTo<Table, IdTable>) void Filter::
     computeFilterImpl(IdTable& dynamicResultTable, Table&& inputTable,
-                      std::vector<ColumnIndex> sortedBy) const {
+                      std::vector<ColumnIndex> sortedBy, size_t beginIndex,
+                      size_t endIndex) const {
   LocalVocab dummyLocalVocab{};
   AD_CONTRACT_CHECK(inputTable.numColumns() == WIDTH || WIDTH == 0);
+  AD_CONTRACT_CHECK(beginIndex <= endIndex && endIndex <= inputTable.size());
+  size_t numRows = endIndex - beginIndex;
   IdTableStatic<WIDTH> resultTable =
       std::move(dynamicResultTable).toStatic<static_cast<size_t>(WIDTH)>();
   sparqlExpression::EvaluationContext evaluationContext(
@@ -144,6 +192,8 @@ CPP_template_def(int WIDTH, typename Table)(
   // TODO<joka921> This should be a mandatory argument to the
   // EvaluationContext constructor.
   evaluationContext._columnsByWhichResultIsSorted = std::move(sortedBy);
+  evaluationContext._beginIndex = beginIndex;
+  evaluationContext._endIndex = endIndex;
   const auto input =
       evaluationContext._inputTable.asStaticView<static_cast<size_t>(WIDTH)>();
   sparqlExpression::ExpressionResult expressionResult =
@@ -155,22 +205,25 @@ CPP_template_def(int WIDTH, typename Table)(
   // NOTE: the explicit (seemingly redundant) capture of `resultTable` is
   // required to work around a bug in Clang 17, see
   // https://github.com/llvm/llvm-project/issues/61267
+  //
+  // NOTE: The results of the expression are relative to the `beginIndex`.
   auto computeResult = CPP_template_lambda(
       this, &resultTable = resultTable, &input, &inputTable,
-      &dynamicResultTable, &evaluationContext)(typename T)(T && singleResult)(
+      &dynamicResultTable, &evaluationContext, beginIndex,
+      numRows)(typename T)(T && singleResult)(
       requires sparqlExpression::SingleExpressionResult<T>) {
     if constexpr (std::is_same_v<T, ad_utility::SetOfIntervals>) {
-      AD_CONTRACT_CHECK(input.size() == evaluationContext.size());
+      AD_CONTRACT_CHECK(numRows == evaluationContext.size());
       // If the expression result is given as a set of intervals, we copy
       // the corresponding parts of `input` to `resultTable`.
       //
-      // NOTE: One of the interval ends may be larger than `input.size()`
-      // (as the result of a negation).
+      // NOTE: One of the interval ends may be larger than `numRows` (as the
+      // result of a negation).
       auto totalSize = std::accumulate(
           singleResult._intervals.begin(), singleResult._intervals.end(),
-          resultTable.size(), [&input](const auto& sum, const auto& interval) {
+          resultTable.size(), [numRows](const auto& sum, const auto& interval) {
             size_t intervalBegin = interval.first;
-            size_t intervalEnd = std::min(interval.second, input.size());
+            size_t intervalEnd = std::min(interval.second, numRows);
             return sum + (intervalEnd - intervalBegin);
           });
       if (resultTable.empty() && totalSize == inputTable.size()) {
@@ -182,8 +235,9 @@ CPP_template_def(int WIDTH, typename Table)(
       }
       checkCancellation();
       for (auto [intervalBegin, intervalEnd] : singleResult._intervals) {
-        intervalEnd = std::min(intervalEnd, input.size());
-        resultTable.insertAtEnd(inputTable, intervalBegin, intervalEnd);
+        intervalEnd = std::min(intervalEnd, numRows);
+        resultTable.insertAtEnd(inputTable, beginIndex + intervalBegin,
+                                beginIndex + intervalEnd);
         checkCancellation();
       }
       AD_CORRECTNESS_CHECK(resultTable.size() == totalSize);
@@ -201,8 +255,8 @@ CPP_template_def(int WIDTH, typename Table)(
       // intervals above. This depends on how expensive the evaluation with
       // the `EffectiveBooleanValueGetter` is.
       auto resultGenerator = sparqlExpression::detail::makeGenerator(
-          AD_FWD(singleResult), input.size(), &evaluationContext);
-      size_t i = 0;
+          AD_FWD(singleResult), numRows, &evaluationContext);
+      size_t i = beginIndex;
 
       using ValueGetter = sparqlExpression::detail::EffectiveBooleanValueGetter;
       ValueGetter valueGetter{};
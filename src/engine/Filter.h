@@ -72,18 +72,31 @@ class Filter : public Operation {
 
   Result computeResult(bool requestLaziness) override;
 
-  // Perform the actual filter operation of the data provided.
+  // Evaluate the filter on morsels of the `subRes` using `numThreads` threads,
+  // see `MorselParallelism.h`. The order of the rows is preserved.
+  Result computeResultInParallel(std::shared_ptr<const Result> subRes,
+                                 size_t numThreads, bool requestLaziness);
+
+  // Perform the actual filter operation on the rows `[beginIndex, endIndex)`
+  // of the `input`.
   CPP_template(int WIDTH, typename Table)(
       requires ad_utility::SimilarTo<
           Table, IdTable>) void computeFilterImpl(IdTable& dynamicResultTable,
                                                   Table&& input,
                                                   std::vector<ColumnIndex>
-                                                      sortedBy) const;
+                                                      sortedBy,
+                                                  size_t beginIndex,
+                                                  size_t endIndex) const;
 
   // Run `computeFilterImpl` on the provided IdTable
   CPP_template(typename Table)(
       requires ad_utility::SimilarTo<Table, IdTable>) IdTable
       filterIdTable(std::vector<ColumnIndex> sortedBy, Table&& idTable) const;
+
+  // Run `computeFilterImpl` on the rows `[beginIndex, endIndex)` of the
+  // `idTable`, only the rows that pass the filter are copied.
+  IdTable filterRows(std::vector<ColumnIndex> sortedBy, const IdTable& idTable,
+                     size_t beginIndex, size_t endIndex) const;
 };
 
 #endif  // QLEVER_SRC_ENGINE_FILTER_H
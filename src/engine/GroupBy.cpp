@@ -81,6 +81,12 @@ const std::vector<Variable>& GroupBy::groupByVariables() const {
 // _____________________________________________________________________________
 const std::vector<Alias>& GroupBy::aliases() const { return _impl->aliases(); }
 
+// _____________________________________________________________________________
+std::optional<Datatype> GroupBy::getStaticDatatype(
+    const Variable& variable) const {
+  return _impl->getStaticDatatype(variable);
+}
+
 // _____________________________________________________________________________
 std::unique_ptr<Operation> GroupBy::cloneImpl() const {
   // We need to return a `unique_ptr<GroupBy>` to let the unit tests for `clone`
@@ -44,6 +44,8 @@ class GroupBy : public Operation {
   VariableToColumnMap computeVariableToColumnMap() const override;
   Result computeResult(bool requestLaziness) override;
   std::unique_ptr<Operation> cloneImpl() const override;
+  std::optional<Datatype> getStaticDatatype(
+      const Variable& variable) const override;
 
   // Getters for testing.
   const std::vector<Variable>& groupByVariables() const;
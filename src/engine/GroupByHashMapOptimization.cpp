@@ -77,6 +77,29 @@ void GroupConcatAggregationData::addValueImpl(
   return ValueId::makeFromLocalVocabIndex(localVocabIndex);
 }
 
+// _____________________________________________________________________________
+void GroupConcatAggregationData::merge(
+    const GroupConcatAggregationData& other,
+    [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+  if (other.first_ || undefined_) {
+    return;
+  }
+  if (first_) {
+    first_ = false;
+    undefined_ = other.undefined_;
+    currentValue_ = other.currentValue_;
+    langTag_ = other.langTag_;
+    return;
+  }
+  undefined_ = other.undefined_;
+  currentValue_.append(separator_);
+  currentValue_.append(other.currentValue_);
+  // The result only has a language tag if all the values have the same one.
+  if (langTag_ != other.langTag_) {
+    langTag_.reset();
+  }
+}
+
 // _____________________________________________________________________________
 GroupConcatAggregationData::GroupConcatAggregationData(
     std::string_view separator)
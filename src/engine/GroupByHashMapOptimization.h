@@ -48,6 +48,15 @@ struct AvgAggregationData {
   [[nodiscard]] ValueId calculateResult(
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // Merge the partial aggregate `other` (e.g. from another thread) into this
+  // one.
+  void merge(const AvgAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    error_ = error_ || other.error_;
+    sum_ += other.sum_;
+    count_ += other.count_;
+  }
+
   void reset() { *this = AvgAggregationData{}; }
 };
 
@@ -66,6 +75,12 @@ struct CountAggregationData {
   [[nodiscard]] ValueId calculateResult(
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void merge(const CountAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    count_ += other.count_;
+  }
+
   void reset() { *this = CountAggregationData{}; }
 };
 
@@ -91,6 +106,14 @@ struct ExtremumAggregationData {
   // _____________________________________________________________________________
   [[nodiscard]] ValueId calculateResult(LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void merge(const ExtremumAggregationData& other,
+             const sparqlExpression::EvaluationContext* ctx) {
+    if (other.firstValueSet_) {
+      addValue(other.currentValue_, ctx);
+    }
+  }
+
   void reset() { *this = ExtremumAggregationData{}; }
 };
 
@@ -133,6 +156,15 @@ struct SumAggregationData {
   [[nodiscard]] ValueId calculateResult(
       [[maybe_unused]] const LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void merge(const SumAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    error_ = error_ || other.error_;
+    intSumValid_ = intSumValid_ && other.intSumValid_;
+    sum_ += other.sum_;
+    intSum_ += other.intSum_;
+  }
+
   void reset() { *this = SumAggregationData{}; }
 };
 
@@ -163,6 +195,11 @@ struct GroupConcatAggregationData {
 
   [[nodiscard]] ValueId calculateResult(LocalVocab* localVocab) const;
 
+  // Append the values of `other` (which must use the same separator) to the
+  // values of this aggregate.
+  void merge(const GroupConcatAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*);
+
   explicit GroupConcatAggregationData(std::string_view separator);
 
   void reset();
@@ -183,6 +220,14 @@ struct SampleAggregationData {
   // _____________________________________________________________________________
   [[nodiscard]] ValueId calculateResult(LocalVocab* localVocab) const;
 
+  // _____________________________________________________________________________
+  void merge(const SampleAggregationData& other,
+             [[maybe_unused]] const sparqlExpression::EvaluationContext*) {
+    if (!value_.has_value()) {
+      value_ = other.value_;
+    }
+  }
+
   void reset() { *this = SampleAggregationData{}; }
 };
 
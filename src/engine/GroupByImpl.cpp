@@ -9,12 +9,15 @@
 
 #include <absl/strings/str_join.h>
 
+#include <iterator>
+
 #include "backports/algorithm.h"
 #include "engine/CallFixedSize.h"
 #include "engine/ExistsJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/LazyGroupBy.h"
+#include "engine/MorselParallelism.h"
 #include "engine/Sort.h"
 #include "engine/StripColumns.h"
 #include "engine/sparqlExpressions/AggregateExpression.h"
@@ -31,6 +34,7 @@
 #include "parser/Alias.h"
 #include "util/HashSet.h"
 #include "util/Timer.h"
+#include "util/WorkerPool.h"
 
 namespace groupBy::detail {
 template <size_t IN_WIDTH, size_t OUT_WIDTH>
@@ -377,6 +381,23 @@ VariableToColumnMap GroupByImpl::computeVariableToColumnMap() const {
   return result;
 }
 
+// _____________________________________________________________________________
+std::optional<Datatype> GroupByImpl::getStaticDatatype(
+    const Variable& variable) const {
+  AD_CONTRACT_CHECK(getExternallyVisibleVariableColumns().contains(variable));
+  auto alias = ql::ranges::find(_aliases, variable, &Alias::_target);
+  if (alias == _aliases.end()) {
+    return _subtree->getRootOperation()->getStaticDatatype(variable);
+  }
+  using namespace sparqlExpression;
+  const auto* expr = alias->_expression.getPimpl();
+  if (dynamic_cast<const CountExpression*>(expr) ||
+      dynamic_cast<const CountStarExpression*>(expr)) {
+    return Datatype::Int;
+  }
+  return std::nullopt;
+}
+
 float GroupByImpl::getMultiplicity([[maybe_unused]] size_t col) {
   // Group by should currently not be used in the optimizer, unless
   // it is part of a subquery. In that case multiplicities may only be
@@ -591,6 +612,20 @@ Result GroupByImpl::computeResult(bool requestLaziness) {
   }
 
   if (useHashMapOptimization) {
+    // For large inputs, aggregate the input using several threads.
+    size_t numThreads =
+        getRuntimeParameter<&RuntimeParameters::groupByHashMapNumThreads_>();
+    if (numThreads > 1 &&
+        (!subresult->isFullyMaterialized() ||
+         subresult->idTable().size() > qlever::morsels::MORSEL_SIZE)) {
+      auto doCompute = [&](auto numCols) {
+        return computeGroupByForHashMapOptimizationInParallel<numCols>(
+            metadataForUnsequentialData->aggregateAliases_,
+            std::move(subresult), groupByCols, numThreads);
+      };
+      return ad_utility::callFixedSizeVi(groupByCols.size(), doCompute);
+    }
+
     // Helper lambda that calls `computeGroupByForHashMapOptimization` for the
     // given `subresults`.
     auto computeWithHashMap = [this, &metadataForUnsequentialData,
@@ -1104,7 +1139,11 @@ GroupByImpl::computeUnsequentialProcessingMetadata(
 std::optional<GroupByImpl::HashMapOptimizationData>
 GroupByImpl::checkIfHashMapOptimizationPossible(
     std::vector<Aggregate>& aliases) const {
-  if (!getRuntimeParameter<&RuntimeParameters::groupByHashMapEnabled_>()) {
+  // Setting more than one thread for the hash map optimization implicitly
+  // enables it.
+  if (!getRuntimeParameter<&RuntimeParameters::groupByHashMapEnabled_>() &&
+      getRuntimeParameter<&RuntimeParameters::groupByHashMapNumThreads_>() <=
+          1) {
     return std::nullopt;
   }
 
@@ -1393,6 +1432,14 @@ GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::getHashEntries(
     hashEntries.push_back(iterator->second);
   }
 
+  resizeAggregationDataVectors();
+  return hashEntries;
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::HashMapAggregationData<
+    NUM_GROUP_COLUMNS>::resizeAggregationDataVectors() {
   // CPP_template_lambda(capture)(typenames...)(arg)(requires ...)`
   auto resizeVectors = CPP_template_lambda()(typename T)(
       T & arg, size_t numberOfGroups,
@@ -1420,8 +1467,52 @@ GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::getHashEntries(
         aggregation);
     ++idx;
   }
+}
 
-  return hashEntries;
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::mergeFrom(
+    const HashMapAggregationData& other,
+    const sparqlExpression::EvaluationContext* evaluationContext,
+    const ArrayOrVector<Id>* lowerBound, const ArrayOrVector<Id>* upperBound) {
+  AD_CONTRACT_CHECK(aggregationData_.size() == other.aggregationData_.size());
+  for (const auto& [groupValues, otherIndexInMap] : other.map_) {
+    if ((lowerBound != nullptr && groupValues < *lowerBound) ||
+        (upperBound != nullptr && !(groupValues < *upperBound))) {
+      continue;
+    }
+    size_t otherIndex = otherIndexInMap;
+    auto [iterator, wasAdded] =
+        map_.try_emplace(groupValues, getNumberOfGroups());
+    if (wasAdded) {
+      resizeAggregationDataVectors();
+    }
+    size_t index = iterator->second;
+    for (size_t i = 0; i < aggregationData_.size(); ++i) {
+      std::visit(
+          [&](auto& target) {
+            using Vector = std::decay_t<decltype(target)>;
+            const auto& source = std::get<Vector>(other.aggregationData_.at(i));
+            target.at(index).merge(source.at(otherIndex), evaluationContext);
+          },
+          aggregationData_.at(i));
+    }
+  }
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+auto GroupByImpl::HashMapAggregationData<NUM_GROUP_COLUMNS>::sampleGroups(
+    size_t maxNumGroups) const -> std::vector<ArrayOrVector<Id>> {
+  std::vector<ArrayOrVector<Id>> sample;
+  sample.reserve(std::min(maxNumGroups, map_.size()));
+  for (const auto& entry : map_) {
+    if (sample.size() == maxNumGroups) {
+      break;
+    }
+    sample.push_back(entry.first);
+  }
+  return sample;
 }
 
 // _____________________________________________________________________________
@@ -1616,22 +1707,37 @@ GroupByImpl::evaluateChildExpressionOfAggregateFunction(
 // _____________________________________________________________________________
 template <size_t NUM_GROUP_COLUMNS>
 IdTable GroupByImpl::createResultFromHashMap(
-    const HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+    const std::vector<const HashMapAggregationData<NUM_GROUP_COLUMNS>*>&
+        partitions,
     std::vector<HashMapAliasInformation>& aggregateAliases,
     LocalVocab* localVocab) const {
   // Create result table, filling in the group values, since they might be
-  // required in evaluation
+  // required in evaluation. The partitions are sorted concurrently.
   ad_utility::Timer sortingTimer{ad_utility::Timer::Started};
-  auto sortedKeys = aggregationData.getSortedGroupColumns();
+  using SortedKeys = typename HashMapAggregationData<
+      NUM_GROUP_COLUMNS>::template ArrayOrVector<std::vector<Id>>;
+  std::vector<SortedKeys> sortedKeys(partitions.size());
+  ad_utility::WorkerPool::global().runInParallel(
+      partitions.size(), [&sortedKeys, &partitions](size_t i) {
+        sortedKeys.at(i) = partitions.at(i)->getSortedGroupColumns();
+      });
   runtimeInfo().addDetail("timeResultSorting", sortingTimer.msecs());
 
-  size_t numberOfGroups = aggregationData.getNumberOfGroups();
+  size_t numberOfGroups = 0;
+  for (const auto* aggregationData : partitions) {
+    numberOfGroups += aggregationData->getNumberOfGroups();
+  }
   IdTable result{getResultWidth(), getExecutionContext()->getAllocator()};
   result.resize(numberOfGroups);
 
   // Copy grouped by values
-  for (size_t idx = 0; idx < aggregationData.numOfGroupedColumns_; ++idx) {
-    ql::ranges::copy(sortedKeys.at(idx), result.getColumn(idx).begin());
+  size_t offset = 0;
+  for (size_t i = 0; i < partitions.size(); ++i) {
+    for (size_t idx = 0; idx < partitions.at(i)->numOfGroupedColumns_; ++idx) {
+      ql::ranges::copy(sortedKeys.at(i).at(idx),
+                       result.getColumn(idx).begin() + offset);
+    }
+    offset += partitions.at(i)->getNumberOfGroups();
   }
 
   // Initialize evaluation context
@@ -1639,17 +1745,22 @@ IdTable GroupByImpl::createResultFromHashMap(
       createEvaluationContext(*localVocab, result);
 
   ad_utility::Timer evaluationAndResultsTimer{ad_utility::Timer::Started};
-  for (size_t i = 0; i < numberOfGroups; i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
-    checkCancellation();
+  size_t begin = 0;
+  for (const auto* aggregationData : partitions) {
+    size_t end = begin + aggregationData->getNumberOfGroups();
+    for (size_t i = begin; i < end; i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
+      checkCancellation();
 
-    evaluationContext._beginIndex = i;
-    evaluationContext._endIndex =
-        std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, numberOfGroups);
+      evaluationContext._beginIndex = i;
+      evaluationContext._endIndex =
+          std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, end);
 
-    for (auto& alias : aggregateAliases) {
-      evaluateAlias(alias, &result, evaluationContext, aggregationData,
-                    localVocab, allocator());
+      for (auto& alias : aggregateAliases) {
+        evaluateAlias(alias, &result, evaluationContext, *aggregationData,
+                      localVocab, allocator());
+      }
     }
+    begin = end;
   }
   runtimeInfo().addDetail("timeEvaluationAndResults",
                           evaluationAndResultsTimer.msecs());
@@ -1684,6 +1795,79 @@ static constexpr auto makeProcessGroupsVisitor =
       };
     };
 
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+void GroupByImpl::aggregateBlockWithHashMap(
+    HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+    const std::vector<HashMapAliasInformation>& aggregateAliases,
+    const IdTable& inputTable, size_t beginIndex, size_t endIndex,
+    const LocalVocab& inputLocalVocab, LocalVocab& localVocab,
+    const std::vector<size_t>& columnIndices, ad_utility::Timer& lookupTimer,
+    ad_utility::Timer& aggregationTimer) const {
+  // Merge the local vocab of each input block.
+  //
+  // NOTE: If the input blocks have very similar or even identical non-empty
+  // local vocabs, no deduplication is performed.
+  localVocab.mergeWith(inputLocalVocab);
+  // Setup the `EvaluationContext` for this input block.
+  sparqlExpression::EvaluationContext evaluationContext(
+      *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
+      getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
+      deadline_);
+  evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
+      _groupByVariables.begin(), _groupByVariables.end()};
+  evaluationContext._isPartOfGroupBy = true;
+
+  // Iterate of the rows of this input block. Process (up to)
+  // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
+  AD_CONTRACT_CHECK(beginIndex <= endIndex && endIndex <= inputTable.size());
+  for (size_t i = beginIndex; i < endIndex;
+       i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
+    checkCancellation();
+
+    evaluationContext._beginIndex = i;
+    evaluationContext._endIndex =
+        std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, endIndex);
+
+    auto currentBlockSize = evaluationContext.size();
+
+    // Perform HashMap lookup once for all groups in current block
+    using U = HashMapAggregationData<
+        NUM_GROUP_COLUMNS>::template ArrayOrVector<ql::span<const Id>>;
+    U groupValues;
+    resizeIfVector(groupValues, columnIndices.size());
+
+    // TODO<C++23> use views::enumerate
+    size_t j = 0;
+    for (auto& idx : columnIndices) {
+      groupValues[j] = inputTable.getColumn(idx).subspan(
+          evaluationContext._beginIndex, currentBlockSize);
+      ++j;
+    }
+    lookupTimer.cont();
+    auto hashEntries = aggregationData.getHashEntries(groupValues);
+    lookupTimer.stop();
+
+    aggregationTimer.cont();
+    for (auto& aggregateAlias : aggregateAliases) {
+      for (auto& aggregate : aggregateAlias.aggregateInfo_) {
+        sparqlExpression::ExpressionResult expressionResult =
+            GroupByImpl::evaluateChildExpressionOfAggregateFunction(
+                aggregate, evaluationContext);
+
+        auto& aggregationDataVariant =
+            aggregationData.getAggregationDataVariant(
+                aggregate.aggregateDataIndex_);
+
+        std::visit(makeProcessGroupsVisitor(currentBlockSize,
+                                            &evaluationContext, hashEntries),
+                   std::move(expressionResult), aggregationDataVariant);
+      }
+    }
+    aggregationTimer.stop();
+  }
+}
+
 // _____________________________________________________________________________
 template <size_t NUM_GROUP_COLUMNS, typename SubResults>
 Result GroupByImpl::computeGroupByForHashMapOptimization(
@@ -1705,74 +1889,106 @@ Result GroupByImpl::computeGroupByForHashMapOptimization(
   for (const auto& [inputTableRef, inputLocalVocabRef] : subresults) {
     const IdTable& inputTable = inputTableRef;
     const LocalVocab& inputLocalVocab = inputLocalVocabRef;
-
-    // Merge the local vocab of each input block.
-    //
-    // NOTE: If the input blocks have very similar or even identical non-empty
-    // local vocabs, no deduplication is performed.
-    localVocab.mergeWith(inputLocalVocab);
-    // Setup the `EvaluationContext` for this input block.
-    sparqlExpression::EvaluationContext evaluationContext(
-        *getExecutionContext(), _subtree->getVariableColumns(), inputTable,
-        getExecutionContext()->getAllocator(), localVocab, cancellationHandle_,
-        deadline_);
-    evaluationContext._groupedVariables = ad_utility::HashSet<Variable>{
-        _groupByVariables.begin(), _groupByVariables.end()};
-    evaluationContext._isPartOfGroupBy = true;
-
-    // Iterate of the rows of this input block. Process (up to)
-    // `GROUP_BY_HASH_MAP_BLOCK_SIZE` rows at a time.
-    for (size_t i = 0; i < inputTable.size();
-         i += GROUP_BY_HASH_MAP_BLOCK_SIZE) {
-      checkCancellation();
-
-      evaluationContext._beginIndex = i;
-      evaluationContext._endIndex =
-          std::min(i + GROUP_BY_HASH_MAP_BLOCK_SIZE, inputTable.size());
-
-      auto currentBlockSize = evaluationContext.size();
-
-      // Perform HashMap lookup once for all groups in current block
-      using U = HashMapAggregationData<
-          NUM_GROUP_COLUMNS>::template ArrayOrVector<ql::span<const Id>>;
-      U groupValues;
-      resizeIfVector(groupValues, columnIndices.size());
-
-      // TODO<C++23> use views::enumerate
-      size_t j = 0;
-      for (auto& idx : columnIndices) {
-        groupValues[j] = inputTable.getColumn(idx).subspan(
-            evaluationContext._beginIndex, currentBlockSize);
-        ++j;
-      }
-      lookupTimer.cont();
-      auto hashEntries = aggregationData.getHashEntries(groupValues);
-      lookupTimer.stop();
-
-      aggregationTimer.cont();
-      for (auto& aggregateAlias : aggregateAliases) {
-        for (auto& aggregate : aggregateAlias.aggregateInfo_) {
-          sparqlExpression::ExpressionResult expressionResult =
-              GroupByImpl::evaluateChildExpressionOfAggregateFunction(
-                  aggregate, evaluationContext);
-
-          auto& aggregationDataVariant =
-              aggregationData.getAggregationDataVariant(
-                  aggregate.aggregateDataIndex_);
-
-          std::visit(makeProcessGroupsVisitor(currentBlockSize,
-                                              &evaluationContext, hashEntries),
-                     std::move(expressionResult), aggregationDataVariant);
-        }
-      }
-      aggregationTimer.stop();
-    }
+    aggregateBlockWithHashMap(aggregationData, aggregateAliases, inputTable, 0,
+                              inputTable.size(), inputLocalVocab, localVocab,
+                              columnIndices, lookupTimer, aggregationTimer);
   }
 
   runtimeInfo().addDetail("timeMapLookup", lookupTimer.msecs());
   runtimeInfo().addDetail("timeAggregation", aggregationTimer.msecs());
   IdTable resultTable =
-      createResultFromHashMap(aggregationData, aggregateAliases, &localVocab);
+      createResultFromHashMap<NUM_GROUP_COLUMNS>(
+          {&aggregationData}, aggregateAliases, &localVocab);
+  return {std::move(resultTable), resultSortedOn(), std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+template <size_t NUM_GROUP_COLUMNS>
+Result GroupByImpl::computeGroupByForHashMapOptimizationInParallel(
+    std::vector<HashMapAliasInformation>& aggregateAliases,
+    std::shared_ptr<const Result> subresult,
+    const std::vector<size_t>& columnIndices, size_t numThreads) const {
+  AD_CORRECTNESS_CHECK(columnIndices.size() == NUM_GROUP_COLUMNS ||
+                       NUM_GROUP_COLUMNS == 0);
+  AD_CONTRACT_CHECK(numThreads > 0);
+  using Data = HashMapAggregationData<NUM_GROUP_COLUMNS>;
+  using GroupValues = typename Data::template ArrayOrVector<Id>;
+  const auto& allocator = getExecutionContext()->getAllocator();
+  auto& workerPool = ad_utility::WorkerPool::global();
+
+  // Phase 1: Each task aggregates morsels of the input into its own
+  // `HashMapAggregationData` and `LocalVocab`.
+  qlever::morsels::MorselSource morsels{std::move(subresult)};
+  std::vector<std::optional<Data>> partialData(numThreads);
+  std::vector<LocalVocab> localVocabs(numThreads);
+  ad_utility::Timer aggregationPhaseTimer{ad_utility::Timer::Started};
+  workerPool.runInParallel(numThreads, [&](size_t threadIndex) {
+    auto& aggregationData = partialData.at(threadIndex)
+                                .emplace(allocator, aggregateAliases,
+                                         columnIndices.size());
+    ad_utility::Timer lookupTimer{ad_utility::Timer::Stopped};
+    ad_utility::Timer aggregationTimer{ad_utility::Timer::Stopped};
+    while (auto morsel = morsels.next()) {
+      const auto& [table, begin, end, localVocab] = morsel.value().second;
+      aggregateBlockWithHashMap(aggregationData, aggregateAliases, *table,
+                                begin, end, localVocab,
+                                localVocabs.at(threadIndex), columnIndices,
+                                lookupTimer, aggregationTimer);
+    }
+  });
+  runtimeInfo().addDetail("timeParallelAggregation",
+                          aggregationPhaseTimer.msecs());
+
+  // Phase 2: Split the groups into `numThreads` ranges of about the same size,
+  // using the quantiles of a sample of the groups as the boundaries. Then
+  // merge the partial aggregates, each task being responsible for the groups
+  // of one range, so the tasks don't share any groups.
+  ad_utility::Timer mergeTimer{ad_utility::Timer::Started};
+  std::vector<GroupValues> sample;
+  for (const auto& data : partialData) {
+    ql::ranges::move(data.value().sampleGroups(NUM_SAMPLED_GROUPS_PER_THREAD),
+                     std::back_inserter(sample));
+  }
+  ql::ranges::sort(sample);
+  std::vector<GroupValues> boundaries;
+  for (size_t i = 1; i < numThreads && !sample.empty(); ++i) {
+    boundaries.push_back(sample.at(i * sample.size() / numThreads));
+  }
+  size_t numPartitions = boundaries.size() + 1;
+  std::vector<std::optional<Data>> partitions(numPartitions);
+  IdTable emptyTable{_subtree->getResultWidth(), allocator};
+  workerPool.runInParallel(numPartitions, [&](size_t partition) {
+    auto& merged = partitions.at(partition).emplace(
+        allocator, aggregateAliases, columnIndices.size());
+    // The context is only needed for comparisons, which never add words to
+    // the local vocab.
+    LocalVocab dummyLocalVocab;
+    auto evaluationContext =
+        createEvaluationContext(dummyLocalVocab, emptyTable);
+    const GroupValues* lowerBound =
+        partition == 0 ? nullptr : &boundaries.at(partition - 1);
+    const GroupValues* upperBound =
+        partition + 1 == numPartitions ? nullptr : &boundaries.at(partition);
+    for (const auto& data : partialData) {
+      checkCancellation();
+      merged.mergeFrom(data.value(), &evaluationContext, lowerBound,
+                       upperBound);
+    }
+  });
+  partialData.clear();
+  runtimeInfo().addDetail("timeMerge", mergeTimer.msecs());
+  runtimeInfo().addDetail("numThreads", numThreads);
+
+  // The ranges are disjoint and sorted, so the result is created from them
+  // directly, without merging them into a single hash map first.
+  LocalVocab localVocab;
+  localVocab.mergeWith(localVocabs);
+  std::vector<const Data*> sortedPartitions;
+  for (const auto& partition : partitions) {
+    sortedPartitions.push_back(&partition.value());
+  }
+  IdTable resultTable =
+      createResultFromHashMap(sortedPartitions, aggregateAliases, &localVocab);
   return {std::move(resultTable), resultSortedOn(), std::move(localVocab)};
 }
 
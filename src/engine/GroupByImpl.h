@@ -23,11 +23,16 @@
 #include "engine/sparqlExpressions/SparqlExpressionPimpl.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "parser/Alias.h"
+#include "util/Timer.h"
 #include "util/TypeIdentity.h"
 
 // Block size for when using the hash map optimization
 static constexpr size_t GROUP_BY_HASH_MAP_BLOCK_SIZE = 262144;
 
+// The number of groups per thread that are sampled to split the groups into
+// ranges when the hash map optimization runs in parallel.
+static constexpr size_t NUM_SAMPLED_GROUPS_PER_THREAD = 1024;
+
 namespace groupBy::detail {
 template <size_t IN_WIDTH, size_t OUT_WIDTH>
 class LazyGroupByRange;
@@ -104,6 +109,11 @@ class GroupByImpl : public Operation {
 
   Result computeResult(bool requestLaziness) override;
 
+  // The result of a `COUNT` is always an integer, the datatypes of the other
+  // aggregates depend on the values of the aggregated groups.
+  std::optional<Datatype> getStaticDatatype(
+      const Variable& variable) const override;
+
  private:
   // Helper function to create evaluation contexts in various places for the
   // GROUP BY operation.
@@ -418,6 +428,21 @@ class GroupByImpl : public Operation {
     // Get the values of the grouped column in ascending order.
     [[nodiscard]] ArrayOrVector<std::vector<Id>> getSortedGroupColumns() const;
 
+    // Merge the groups of `other` (which must have been created for the same
+    // aggregates) into this object. The partial aggregates of groups that are
+    // contained in both are combined. If `lowerBound` (`upperBound`) is not
+    // null, then only the groups with values that are not less than
+    // `*lowerBound` (less than `*upperBound`) are merged, s.t. disjoint ranges
+    // of groups can be merged concurrently. The `evaluationContext` is needed
+    // to compare values for `MIN` and `MAX`.
+    void mergeFrom(const HashMapAggregationData& other,
+                   const sparqlExpression::EvaluationContext* evaluationContext,
+                   const ArrayOrVector<Id>* lowerBound = nullptr,
+                   const ArrayOrVector<Id>* upperBound = nullptr);
+
+    // Return up to `maxNumGroups` arbitrary group values.
+    std::vector<ArrayOrVector<Id>> sampleGroups(size_t maxNumGroups) const;
+
     // Returns the number of groups.
     [[nodiscard]] size_t getNumberOfGroups() const { return map_.size(); }
 
@@ -434,6 +459,10 @@ class GroupByImpl : public Operation {
     std::vector<AggregationDataVectors> aggregationData_;
     // For `GROUP_CONCAT`, we require the type information.
     std::vector<HashMapAggregateTypeWithData> aggregateTypeWithData_;
+
+    // Resize all the vectors in `aggregationData_` to the current number of
+    // groups.
+    void resizeAggregationDataVectors();
   };
 
   // Returns the aggregation results between `beginIndex` and `endIndex`
@@ -486,13 +515,44 @@ class GroupByImpl : public Operation {
       const HashMapAggregateInformation& aggregate,
       sparqlExpression::EvaluationContext& evaluationContext);
 
-  // Sort the HashMap by key and create result table.
+  // Sort the HashMaps by key and create result table. The `partitions` must
+  // contain disjoint groups, s.t. all the groups of a partition are less than
+  // those of the next partition.
   template <size_t NUM_GROUP_COLUMNS>
   IdTable createResultFromHashMap(
-      const HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+      const std::vector<const HashMapAggregationData<NUM_GROUP_COLUMNS>*>&
+          partitions,
       std::vector<HashMapAliasInformation>& aggregateAliases,
       LocalVocab* localVocab) const;
 
+  // Process a single block of the input for the hash map optimization: Look up
+  // (or insert) the groups of the rows `[beginIndex, endIndex)` of `inputTable`
+  // in the `aggregationData` and add the values of all the aggregates to the
+  // corresponding groups. The `inputLocalVocab` is merged into the
+  // `localVocab`, which is also used for the evaluation.
+  template <size_t NUM_GROUP_COLUMNS>
+  void aggregateBlockWithHashMap(
+      HashMapAggregationData<NUM_GROUP_COLUMNS>& aggregationData,
+      const std::vector<HashMapAliasInformation>& aggregateAliases,
+      const IdTable& inputTable, size_t beginIndex, size_t endIndex,
+      const LocalVocab& inputLocalVocab, LocalVocab& localVocab,
+      const std::vector<size_t>& columnIndices, ad_utility::Timer& lookupTimer,
+      ad_utility::Timer& aggregationTimer) const;
+
+  // Parallel version of `computeGroupByForHashMapOptimization`. The input is
+  // split into morsels (see `MorselParallelism.h`) which are aggregated by
+  // `numThreads` tasks on the `ad_utility::WorkerPool` into task-local hash
+  // maps. These partial aggregates are then merged concurrently, each task
+  // being responsible for one range of the groups, and the ranges are
+  // concatenated for the result. Note that the order of the values of a
+  // `GROUP_CONCAT` depends on the order in which the morsels were processed,
+  // so it is not deterministic.
+  template <size_t NUM_GROUP_COLUMNS>
+  Result computeGroupByForHashMapOptimizationInParallel(
+      std::vector<HashMapAliasInformation>& aggregateAliases,
+      std::shared_ptr<const Result> subresult,
+      const std::vector<size_t>& columnIndices, size_t numThreads) const;
+
   // Reusable implementation of `checkIfHashMapOptimizationPossible`.
   static std::optional<HashMapOptimizationData>
   computeUnsequentialProcessingMetadata(
@@ -501,7 +561,8 @@ class GroupByImpl : public Operation {
 
   // Check if hash map optimization is applicable. This is the case when
   // the following conditions hold true:
-  // - Runtime parameter is set
+  // - Runtime parameter `group-by-hash-map-enabled` is set, or
+  //   `group-by-hash-map-num-threads` is larger than 1
   // - Child operation is SORT
   std::optional<HashMapOptimizationData> checkIfHashMapOptimizationPossible(
       std::vector<Aggregate>& aggregates) const;
@@ -0,0 +1,304 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/HashJoin.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <cmath>
+
+#include "engine/JoinHelpers.h"
+#include "engine/QueryPlanningCostFactors.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/HashMap.h"
+#include "util/Timer.h"
+#include "util/Views.h"
+
+using namespace qlever::joinHelpers;
+
+namespace {
+
+// The rows of the build side of a `HashJoin`, grouped by the value of their
+// join column. The indices of all rows with the same value are stored
+// contiguously in `rowIndices_`, and `ranges_` maps each value to the
+// corresponding `[begin, end)` range in `rowIndices_`. This is much more
+// compact than a hash map with a `std::vector` per value. All the memory is
+// allocated with the `allocator`, s.t. it counts towards the memory limit of
+// the query.
+class BuildSideHashTable {
+  ad_utility::HashMapWithMemoryLimit<Id, std::pair<size_t, size_t>> ranges_;
+  std::vector<size_t, ad_utility::AllocatorWithLimit<size_t>> rowIndices_;
+
+ public:
+  BuildSideHashTable(ql::span<const Id> joinColumn,
+                     const ad_utility::AllocatorWithLimit<Id>& allocator)
+      : ranges_{allocator}, rowIndices_{allocator} {
+    // First pass: count the number of occurrences of each value.
+    for (Id id : joinColumn) {
+      ++ranges_[id].second;
+    }
+    // Turn the counts into (initially empty) ranges.
+    size_t offset = 0;
+    for (auto& [id, range] : ranges_) {
+      size_t count = range.second;
+      range = {offset, offset};
+      offset += count;
+    }
+    // Second pass: Fill the ranges.
+    rowIndices_.resize(joinColumn.size());
+    for (size_t i = 0; i < joinColumn.size(); ++i) {
+      auto& range = ranges_.find(joinColumn[i])->second;
+      rowIndices_[range.second] = i;
+      ++range.second;
+    }
+  }
+
+  // Return the indices of all rows of the build side, the join column of
+  // which is equal to `id`.
+  ql::span<const size_t> find(Id id) const {
+    auto it = ranges_.find(id);
+    if (it == ranges_.end()) {
+      return {};
+    }
+    auto [begin, end] = it->second;
+    return ql::span<const size_t>{rowIndices_}.subspan(begin, end - begin);
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+HashJoin::HashJoin(QueryExecutionContext* qec,
+                   std::shared_ptr<QueryExecutionTree> left,
+                   std::shared_ptr<QueryExecutionTree> right,
+                   ColumnIndex leftJoinCol, ColumnIndex rightJoinCol,
+                   std::optional<bool> leftIsBuildSide)
+    : Operation{qec},
+      left_{std::move(left)},
+      right_{std::move(right)},
+      leftJoinCol_{leftJoinCol},
+      rightJoinCol_{rightJoinCol},
+      joinVar_{left_->getVariableAndInfoByColumnIndex(leftJoinCol_).first} {
+  AD_CONTRACT_CHECK(
+      joinVar_ ==
+      right_->getVariableAndInfoByColumnIndex(rightJoinCol_).first);
+  // The hash join doesn't implement the special semantics of UNDEF values in
+  // the join column.
+  AD_CONTRACT_CHECK(joinColumnsAreAlwaysDefined(
+      {{leftJoinCol_, rightJoinCol_}}, left_, right_));
+  leftIsBuildSide_ = leftIsBuildSide.value_or(left_->getSizeEstimate() <=
+                                              right_->getSizeEstimate());
+}
+
+// _____________________________________________________________________________
+std::string HashJoin::getCacheKeyImpl() const {
+  return absl::StrCat("HASH JOIN\n", left_->getCacheKey(), " join-column: [",
+                      leftJoinCol_, "]\n|X|\n", right_->getCacheKey(),
+                      " join-column: [", rightJoinCol_, "] build side: ",
+                      leftIsBuildSide_ ? "left" : "right");
+}
+
+// _____________________________________________________________________________
+std::string HashJoin::getDescriptor() const {
+  return "HashJoin on " + joinVar_.name();
+}
+
+// _____________________________________________________________________________
+size_t HashJoin::getResultWidth() const {
+  return left_->getResultWidth() + right_->getResultWidth() - 1;
+}
+
+// _____________________________________________________________________________
+void HashJoin::computeSizeEstimateAndMultiplicities() {
+  if (sizeEstimate_.has_value()) {
+    return;
+  }
+  double corrFactor = _executionContext
+                          ? _executionContext->getCostFactor(
+                                "JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR")
+                          : 1.0;
+  auto estimate = estimateSizeAndMultiplicitiesOfJoin(
+      *left_, *right_, leftJoinCol_, rightJoinCol_, true, corrFactor);
+  if (estimate.has_value()) {
+    sizeEstimate_ = estimate->sizeEstimate_;
+    multiplicities_ = std::move(estimate->multiplicities_);
+  } else {
+    sizeEstimate_ = 0;
+    multiplicities_.assign(getResultWidth(), 1.0f);
+  }
+}
+
+// _____________________________________________________________________________
+uint64_t HashJoin::getSizeEstimateBeforeLimit() {
+  computeSizeEstimateAndMultiplicities();
+  return sizeEstimate_.value();
+}
+
+// _____________________________________________________________________________
+float HashJoin::getMultiplicity(size_t col) {
+  computeSizeEstimateAndMultiplicities();
+  return multiplicities_.at(col);
+}
+
+// _____________________________________________________________________________
+size_t HashJoin::getCostEstimate() {
+  // Use the default cost factors if there is no execution context (which only
+  // happens in unit tests of the `QueryPlanner`).
+  static const QueryPlanningCostFactors defaultCostFactors;
+  auto getCostFactor = [this](const std::string& key) {
+    return _executionContext ? _executionContext->getCostFactor(key)
+                             : defaultCostFactors.getCostFactor(key);
+  };
+  auto& buildSide = leftIsBuildSide_ ? left_ : right_;
+  auto& probeSide = leftIsBuildSide_ ? right_ : left_;
+  auto buildSize = static_cast<double>(buildSide->getSizeEstimate());
+  auto probeSize = static_cast<double>(probeSide->getSizeEstimate());
+  // Once the hash map doesn't fit into the CPU cache anymore, most accesses
+  // to it are cache misses, which become more expensive the larger it is.
+  double cacheMissCost =
+      getCostFactor("HASH_JOIN_CACHE_MISS_COST") *
+      std::max(0.0, std::log2(buildSize / NUM_BUILD_ROWS_IN_CPU_CACHE));
+  auto costOfBuilding = static_cast<size_t>(
+      (getCostFactor("HASH_JOIN_BUILD_COST") + cacheMissCost) * buildSize);
+  auto costOfProbing = static_cast<size_t>(
+      (getCostFactor("HASH_JOIN_PROBE_COST") + cacheMissCost) * probeSize);
+  auto fixedCost = static_cast<size_t>(getCostFactor("HASH_JOIN_FIXED_COST"));
+  return getSizeEstimateBeforeLimit() + fixedCost + costOfBuilding +
+         costOfProbing + left_->getCostEstimate() + right_->getCostEstimate();
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap HashJoin::computeVariableToColumnMap() const {
+  return makeVarToColMapForJoinOperation(
+      left_->getVariableColumns(), right_->getVariableColumns(),
+      {{leftJoinCol_, rightJoinCol_}}, BinOpType::Join,
+      left_->getResultWidth());
+}
+
+// _____________________________________________________________________________
+bool HashJoin::columnOriginatesFromGraphOrUndef(
+    const Variable& variable) const {
+  AD_CONTRACT_CHECK(getExternallyVisibleVariableColumns().contains(variable));
+  if (variable == joinVar_) {
+    return doesJoinProduceGuaranteedGraphValuesOrUndef(left_, right_, variable);
+  }
+  return Operation::columnOriginatesFromGraphOrUndef(variable);
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> HashJoin::cloneImpl() const {
+  auto copy = std::make_unique<HashJoin>(*this);
+  copy->left_ = left_->clone();
+  copy->right_ = right_->clone();
+  return copy;
+}
+
+// _____________________________________________________________________________
+Result HashJoin::computeResult(bool requestLaziness) {
+  auto createEmptyResult = [this]() -> Result {
+    return {IdTable{getResultWidth(), allocator()}, resultSortedOn(),
+            LocalVocab{}};
+  };
+  if (knownEmptyResult()) {
+    left_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    right_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return createEmptyResult();
+  }
+
+  const auto& buildTree = leftIsBuildSide_ ? left_ : right_;
+  const auto& probeTree = leftIsBuildSide_ ? right_ : left_;
+  ColumnIndex buildJoinCol = leftIsBuildSide_ ? leftJoinCol_ : rightJoinCol_;
+  ColumnIndex probeJoinCol = leftIsBuildSide_ ? rightJoinCol_ : leftJoinCol_;
+
+  // Materialize the build side and put it into the hash table.
+  std::shared_ptr<const Result> buildRes = buildTree->getResult();
+  checkCancellation();
+  if (buildRes->idTable().empty()) {
+    probeTree->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return createEmptyResult();
+  }
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  auto hashTable = std::make_shared<const BuildSideHashTable>(
+      buildRes->idTable().getColumn(buildJoinCol), allocator());
+  runtimeInfo().addDetail("time-for-building-hash-table", timer.msecs());
+  checkCancellation();
+
+  // For each column of the result, store whether it comes from the build side
+  // and the corresponding column index in the respective input.
+  std::vector<std::pair<bool, ColumnIndex>> sourceOfColumn;
+  for (auto col : ad_utility::integerRange(left_->getResultWidth())) {
+    sourceOfColumn.emplace_back(leftIsBuildSide_, col);
+  }
+  for (auto col : ad_utility::integerRange(right_->getResultWidth())) {
+    if (col != rightJoinCol_) {
+      sourceOfColumn.emplace_back(!leftIsBuildSide_, col);
+    }
+  }
+
+  // Join a single block of the probe side with the hash table. The result
+  // preserves the order of the rows of the block.
+  auto joinBlock = [this, buildRes, hashTable, probeJoinCol,
+                    sourceOfColumn = std::move(sourceOfColumn)](
+                       const IdTable& probe) {
+    const IdTable& build = buildRes->idTable();
+    using Indices = std::vector<size_t, ad_utility::AllocatorWithLimit<size_t>>;
+    Indices buildRows{allocator()};
+    Indices probeRows{allocator()};
+    decltype(auto) probeCol = probe.getColumn(probeJoinCol);
+    for (size_t i = 0; i < probeCol.size(); ++i) {
+      for (size_t buildRow : hashTable->find(probeCol[i])) {
+        buildRows.push_back(buildRow);
+        probeRows.push_back(i);
+      }
+    }
+    checkCancellation();
+
+    IdTable result{getResultWidth(), allocator()};
+    result.resize(buildRows.size());
+    for (auto [i, source] : ::ranges::views::enumerate(sourceOfColumn)) {
+      auto [fromBuild, col] = source;
+      const auto& rowIndices = fromBuild ? buildRows : probeRows;
+      decltype(auto) input = (fromBuild ? build : probe).getColumn(col);
+      ql::ranges::transform(rowIndices, result.getColumn(i).begin(),
+                            [&input](size_t row) { return input[row]; });
+    }
+    checkCancellation();
+    return result;
+  };
+
+  std::shared_ptr<const Result> probeRes = probeTree->getResult(true);
+  checkCancellation();
+  if (probeRes->isFullyMaterialized()) {
+    IdTable result = joinBlock(probeRes->idTable());
+    return {std::move(result), resultSortedOn(),
+            Result::getMergedLocalVocab(*buildRes, *probeRes)};
+  }
+
+  // The probe side is lazy, so we can yield one result block per input block.
+  auto lazyResult = Result::LazyResult{
+      ad_utility::CachingContinuableTransformInputRange(
+          probeRes->idTables(),
+          [joinBlock = std::move(joinBlock),
+           buildRes](Result::IdTableVocabPair& pair) {
+            IdTable result = joinBlock(pair.idTable_);
+            if (result.empty()) {
+              return Result::IdTableLoopControl::makeContinue();
+            }
+            LocalVocab localVocab = std::move(pair.localVocab_);
+            localVocab.mergeWith(buildRes->localVocab());
+            return Result::IdTableLoopControl::yieldValue(
+                Result::IdTableVocabPair{std::move(result),
+                                         std::move(localVocab)});
+          })};
+  if (requestLaziness) {
+    return {std::move(lazyResult), resultSortedOn()};
+  }
+  IdTable result{getResultWidth(), allocator()};
+  LocalVocab localVocab;
+  for (auto& [idTable, blockVocab] : lazyResult) {
+    result.insertAtEnd(idTable);
+    localVocab.mergeWith(blockVocab);
+  }
+  return {std::move(result), resultSortedOn(), std::move(localVocab)};
+}
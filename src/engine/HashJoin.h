@@ -0,0 +1,110 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_HASHJOIN_H
+#define QLEVER_SRC_ENGINE_HASHJOIN_H
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// A join of two subtrees on a single column that doesn't require its inputs to
+// be sorted. The smaller input (according to the size estimates) is the
+// "build side": it is fully materialized and its rows are grouped by the value
+// of the join column in a hash map. The other input is the "probe side": it is
+// requested lazily and each of its blocks is joined with the hash map
+// separately, so the probe side never has to be materialized as a whole.
+//
+// The `QueryPlanner` only uses this operation as an alternative to a `Join`
+// for which both inputs would have to be sorted first, and only if the join
+// columns of both inputs are guaranteed to contain no UNDEF values.
+//
+// The columns of the result are the columns of the left input followed by the
+// non-join columns of the right input (as for `Join`). The result is not
+// sorted.
+class HashJoin : public Operation {
+ public:
+  // The number of rows of the build side, up to which the hash map is assumed
+  // to fit into the CPU cache, see `getCostEstimate`.
+  static constexpr size_t NUM_BUILD_ROWS_IN_CPU_CACHE = 30'000;
+
+ private:
+  std::shared_ptr<QueryExecutionTree> left_;
+  std::shared_ptr<QueryExecutionTree> right_;
+
+  ColumnIndex leftJoinCol_;
+  ColumnIndex rightJoinCol_;
+
+  Variable joinVar_;
+
+  // If true, the left child is the build side and the right child is the
+  // probe side, else the other way around.
+  bool leftIsBuildSide_;
+
+  std::optional<size_t> sizeEstimate_;
+  std::vector<float> multiplicities_;
+
+ public:
+  // Create a hash join of `left` and `right` on the columns `leftJoinCol` and
+  // `rightJoinCol`. Both of these columns must be guaranteed to always be
+  // defined. Which of the two inputs becomes the build side is determined via
+  // the size estimates, unless `leftIsBuildSide` is explicitly specified (this
+  // is mostly useful for testing).
+  HashJoin(QueryExecutionContext* qec, std::shared_ptr<QueryExecutionTree> left,
+           std::shared_ptr<QueryExecutionTree> right, ColumnIndex leftJoinCol,
+           ColumnIndex rightJoinCol,
+           std::optional<bool> leftIsBuildSide = std::nullopt);
+
+  // All following functions are inherited from `Operation`, see there for
+  // comments.
+ protected:
+  std::string getCacheKeyImpl() const override;
+
+ public:
+  std::string getDescriptor() const override;
+
+  size_t getResultWidth() const override;
+
+  std::vector<ColumnIndex> resultSortedOn() const override { return {}; }
+
+  bool knownEmptyResult() override {
+    return left_->knownEmptyResult() || right_->knownEmptyResult();
+  }
+
+  float getMultiplicity(size_t col) override;
+
+ private:
+  uint64_t getSizeEstimateBeforeLimit() override;
+
+ public:
+  // The cost of a hash join is linear in the size of both inputs, but
+  // inserting a row into the hash map is much more expensive than probing
+  // it, and both become more expensive when the hash map doesn't fit into the
+  // CPU cache, see the `HASH_JOIN_...` cost factors in
+  // `QueryPlanningCostFactors.cpp`.
+  size_t getCostEstimate() override;
+
+  std::vector<QueryExecutionTree*> getChildren() override {
+    return {left_.get(), right_.get()};
+  }
+
+  bool columnOriginatesFromGraphOrUndef(
+      const Variable& variable) const override;
+
+  // Return true iff the left child is the build side of the hash join.
+  bool leftIsBuildSide() const { return leftIsBuildSide_; }
+
+ private:
+  std::unique_ptr<Operation> cloneImpl() const override;
+
+  Result computeResult(bool requestLaziness) override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  // Compute the size estimate and the multiplicities if they haven't been
+  // computed yet.
+  void computeSizeEstimateAndMultiplicities();
+};
+
+#endif  // QLEVER_SRC_ENGINE_HASHJOIN_H
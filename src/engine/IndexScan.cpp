@@ -179,24 +179,44 @@ IndexScan::setPrefilterGetUpdatedQueryExecutionTree(
   }
 
   const auto& [sortedVar, colIdx] = optSortedVarColIdxPair.value();
+  const auto& vocab = getIndex().getVocab();
+  auto blockMetadataRanges = scanSpecAndBlocks_.blockMetadata_;
+  bool isPrefiltered = false;
   auto it =
       ql::ranges::find(prefilterVariablePairs, sortedVar, ad_utility::second);
   if (it != prefilterVariablePairs.end()) {
-    const auto& vocab = getIndex().getVocab();
     // If the `BlockMetadataRanges` were previously prefiltered, AND-merge
     // the previous `BlockMetadataRanges` with the `BlockMetadataRanges`
     // retrieved via the newly passed prefilter. This corresponds logically to a
     // conjunction over the prefilters applied for this `IndexScan`.
-    const auto& blockMetadataRanges =
+    blockMetadataRanges =
         prefilterExpressions::detail::logicalOps::getIntersectionOfBlockRanges(
             it->first->evaluate(
                 vocab, getScanSpecAndBlocks().getBlockMetadataSpan(), colIdx),
-            scanSpecAndBlocks_.blockMetadata_);
+            blockMetadataRanges);
+    isPrefiltered = true;
+  }
 
-    return makeCopyWithPrefilteredScanSpecAndBlocks(
-        {scanSpecAndBlocks_.scanSpec_, blockMetadataRanges});
+  // The prefilters on all the variable columns (including the sorted one) can
+  // additionally be evaluated on the column summaries of the blocks, which
+  // also works for the columns that are not sorted.
+  const auto& permutedTriple = getPermutedTriple();
+  for (const auto& [expression, variable] : prefilterVariablePairs) {
+    for (size_t col = colIdx; col < permutedTriple.size(); ++col) {
+      const auto& tripleComp = *permutedTriple.at(col);
+      if (tripleComp.isVariable() && tripleComp.getVariable() == variable) {
+        blockMetadataRanges = expression->evaluateOnColumnSummaries(
+            vocab, blockMetadataRanges, col);
+        isPrefiltered = true;
+      }
+    }
+  }
+
+  if (!isPrefiltered) {
+    return std::nullopt;
   }
-  return std::nullopt;
+  return makeCopyWithPrefilteredScanSpecAndBlocks(
+      {scanSpecAndBlocks_.scanSpec_, std::move(blockMetadataRanges)});
 }
 
 // _____________________________________________________________________________
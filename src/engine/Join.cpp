@@ -224,73 +224,20 @@ size_t Join::getCostEstimate() {
 
 // _____________________________________________________________________________
 void Join::computeSizeEstimateAndMultiplicities() {
-  _multiplicities.clear();
-  if (_left->getSizeEstimate() == 0 || _right->getSizeEstimate() == 0) {
-    for (size_t i = 0; i < getResultWidth(); ++i) {
-      _multiplicities.emplace_back(1);
-    }
-    return;
-  }
-
-  size_t nofDistinctLeft = std::max(
-      size_t(1), static_cast<size_t>(_left->getSizeEstimate() /
-                                     _left->getMultiplicity(_leftJoinCol)));
-  size_t nofDistinctRight = std::max(
-      size_t(1), static_cast<size_t>(_right->getSizeEstimate() /
-                                     _right->getMultiplicity(_rightJoinCol)));
-
-  size_t nofDistinctInResult = std::min(nofDistinctLeft, nofDistinctRight);
-
-  double adaptSizeLeft =
-      _left->getSizeEstimate() *
-      (static_cast<double>(nofDistinctInResult) / nofDistinctLeft);
-  double adaptSizeRight =
-      _right->getSizeEstimate() *
-      (static_cast<double>(nofDistinctInResult) / nofDistinctRight);
-
   double corrFactor = _executionContext
                           ? _executionContext->getCostFactor(
                                 "JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR")
                           : 1.0;
-
-  double jcMultiplicityInResult = _left->getMultiplicity(_leftJoinCol) *
-                                  _right->getMultiplicity(_rightJoinCol);
-  _sizeEstimate = std::max(
-      size_t(1), static_cast<size_t>(corrFactor * jcMultiplicityInResult *
-                                     nofDistinctInResult));
-
-  AD_LOG_TRACE << "Estimated size as: " << _sizeEstimate << " := " << corrFactor
-               << " * " << jcMultiplicityInResult << " * "
-               << nofDistinctInResult << std::endl;
-
-  for (auto i = ColumnIndex{0}; i < _left->getResultWidth(); ++i) {
-    double oldMult = _left->getMultiplicity(i);
-    double m = std::max(
-        1.0, oldMult * _right->getMultiplicity(_rightJoinCol) * corrFactor);
-    if (i != _leftJoinCol && nofDistinctLeft != nofDistinctInResult) {
-      double oldDist = _left->getSizeEstimate() / oldMult;
-      double newDist = std::min(oldDist, adaptSizeLeft);
-      m = (_sizeEstimate / corrFactor) / newDist;
-    }
-    if (i != _leftJoinCol || keepJoinColumn_) {
-      _multiplicities.emplace_back(m);
-    }
-  }
-  for (auto i = ColumnIndex{0}; i < _right->getResultWidth(); ++i) {
-    if (i == _rightJoinCol) {
-      continue;
-    }
-    double oldMult = _right->getMultiplicity(i);
-    double m = std::max(
-        1.0, oldMult * _left->getMultiplicity(_leftJoinCol) * corrFactor);
-    if (i != _rightJoinCol && nofDistinctRight != nofDistinctInResult) {
-      double oldDist = _right->getSizeEstimate() / oldMult;
-      double newDist = std::min(oldDist, adaptSizeRight);
-      m = (_sizeEstimate / corrFactor) / newDist;
-    }
-    _multiplicities.emplace_back(m);
+  auto estimate = estimateSizeAndMultiplicitiesOfJoin(
+      *_left, *_right, _leftJoinCol, _rightJoinCol, keepJoinColumn_,
+      corrFactor);
+  if (estimate.has_value()) {
+    _sizeEstimate = estimate->sizeEstimate_;
+    _multiplicities = std::move(estimate->multiplicities_);
+  } else {
+    _multiplicities.assign(getResultWidth(), 1.0f);
   }
-  assert(_multiplicities.size() == getResultWidth());
+  AD_CORRECTNESS_CHECK(_multiplicities.size() == getResultWidth());
 }
 
 // ______________________________________________________________________________
@@ -189,6 +189,85 @@ inline bool joinColumnsAreAlwaysDefined(
       });
 }
 
+// The estimated size and the estimated multiplicities of the result columns of
+// a join on a single column, see `estimateSizeAndMultiplicitiesOfJoin` below.
+struct JoinSizeEstimate {
+  size_t sizeEstimate_;
+  std::vector<float> multiplicities_;
+};
+
+// Estimate the size and the multiplicities of the result columns of the join of
+// `left` and `right` on the columns `leftJoinCol` and `rightJoinCol`. The
+// result columns are expected to be the columns of `left` followed by the
+// non-join columns of `right`. If `keepJoinColumn` is false, the join column is
+// not part of the result. The `corrFactor` is the cost factor
+// `JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR`. Return `std::nullopt` if one of the
+// inputs has a size estimate of zero, in which case the multiplicities are
+// meaningless. This is used by all join operations on a single column (`Join`
+// and `HashJoin`), so that their estimates are consistent.
+inline std::optional<JoinSizeEstimate> estimateSizeAndMultiplicitiesOfJoin(
+    QueryExecutionTree& left, QueryExecutionTree& right,
+    ColumnIndex leftJoinCol, ColumnIndex rightJoinCol, bool keepJoinColumn,
+    double corrFactor) {
+  if (left.getSizeEstimate() == 0 || right.getSizeEstimate() == 0) {
+    return std::nullopt;
+  }
+
+  size_t nofDistinctLeft = std::max(
+      size_t(1), static_cast<size_t>(left.getSizeEstimate() /
+                                     left.getMultiplicity(leftJoinCol)));
+  size_t nofDistinctRight = std::max(
+      size_t(1), static_cast<size_t>(right.getSizeEstimate() /
+                                     right.getMultiplicity(rightJoinCol)));
+
+  size_t nofDistinctInResult = std::min(nofDistinctLeft, nofDistinctRight);
+
+  double adaptSizeLeft =
+      left.getSizeEstimate() *
+      (static_cast<double>(nofDistinctInResult) / nofDistinctLeft);
+  double adaptSizeRight =
+      right.getSizeEstimate() *
+      (static_cast<double>(nofDistinctInResult) / nofDistinctRight);
+
+  double jcMultiplicityInResult =
+      left.getMultiplicity(leftJoinCol) * right.getMultiplicity(rightJoinCol);
+  JoinSizeEstimate result;
+  result.sizeEstimate_ = std::max(
+      size_t(1), static_cast<size_t>(corrFactor * jcMultiplicityInResult *
+                                     nofDistinctInResult));
+  size_t sizeEstimate = result.sizeEstimate_;
+  auto& multiplicities = result.multiplicities_;
+
+  for (auto i = ColumnIndex{0}; i < left.getResultWidth(); ++i) {
+    double oldMult = left.getMultiplicity(i);
+    double m = std::max(
+        1.0, oldMult * right.getMultiplicity(rightJoinCol) * corrFactor);
+    if (i != leftJoinCol && nofDistinctLeft != nofDistinctInResult) {
+      double oldDist = left.getSizeEstimate() / oldMult;
+      double newDist = std::min(oldDist, adaptSizeLeft);
+      m = (sizeEstimate / corrFactor) / newDist;
+    }
+    if (i != leftJoinCol || keepJoinColumn) {
+      multiplicities.emplace_back(m);
+    }
+  }
+  for (auto i = ColumnIndex{0}; i < right.getResultWidth(); ++i) {
+    if (i == rightJoinCol) {
+      continue;
+    }
+    double oldMult = right.getMultiplicity(i);
+    double m = std::max(
+        1.0, oldMult * left.getMultiplicity(leftJoinCol) * corrFactor);
+    if (nofDistinctRight != nofDistinctInResult) {
+      double oldDist = right.getSizeEstimate() / oldMult;
+      double newDist = std::min(oldDist, adaptSizeRight);
+      m = (sizeEstimate / corrFactor) / newDist;
+    }
+    multiplicities.emplace_back(m);
+  }
+  return result;
+}
+
 // Helper function that is commonly used to skip sort operations and use an
 // alternative algorithm that doesn't require sorting instead.
 inline std::shared_ptr<const Result> computeResultSkipChild(
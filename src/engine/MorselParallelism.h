@@ -0,0 +1,214 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_MORSELPARALLELISM_H
+#define QLEVER_SRC_ENGINE_MORSELPARALLELISM_H
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "engine/Result.h"
+#include "global/RuntimeParameters.h"
+#include "util/Iterators.h"
+#include "util/WorkerPool.h"
+
+// Helpers for operations that evaluate an expression independently for each
+// row of their input (`Filter` and `Bind`). The input (no matter if it is
+// fully materialized or lazy) is split into "morsels" of at most
+// `MORSEL_SIZE` rows which are then processed concurrently on the shared
+// `ad_utility::WorkerPool`. Each morsel has its own `LocalVocab`, so the tasks
+// never share mutable state. The results are yielded in the order of the
+// input, so the sortedness of the input is preserved.
+namespace qlever::morsels {
+
+// The maximal number of rows of a single morsel. Large enough to amortize the
+// overhead of the expression evaluation per morsel, small enough to keep all
+// the workers busy for inputs of moderate size.
+inline constexpr size_t MORSEL_SIZE = 16'384;
+
+// Return the number of threads that should be used for the evaluation of
+// `input`, as determined by the runtime parameter
+// `expression-evaluation-num-threads`. A return value of 1 means that the
+// input should be processed sequentially (this is also the case for
+// materialized inputs that consist of a single morsel).
+inline size_t getNumThreads(const Result& input,
+                            size_t morselSize = MORSEL_SIZE) {
+  size_t numThreads = getRuntimeParameter<
+      &RuntimeParameters::expressionEvaluationNumThreads_>();
+  if (input.isFullyMaterialized() && input.idTable().size() <= morselSize) {
+    return 1;
+  }
+  return std::max(numThreads, size_t{1});
+}
+
+// A contiguous range of rows of either the materialized input or of one of the
+// blocks of a lazy input. The rows are not copied, the `table_` is shared by
+// all the morsels of the same table and kept alive by them.
+struct Morsel {
+  std::shared_ptr<const IdTable> table_;
+  size_t begin_;
+  size_t end_;
+  // A (cheap) clone of the `LocalVocab` of the `table_`, which allows each
+  // morsel to add new words without interfering with the other morsels.
+  LocalVocab localVocab_;
+
+  size_t size() const { return end_ - begin_; }
+};
+
+// Split a `Result` into morsels. The `next` function is thread-safe, the
+// morsels are consecutively numbered.
+class MorselSource {
+ private:
+  std::mutex mutex_;
+  std::shared_ptr<const Result> input_;
+  std::optional<Result::LazyResult> blocks_;
+  std::shared_ptr<const Result::IdTableVocabPair> currentBlock_;
+  size_t nextRow_ = 0;
+  size_t nextIndex_ = 0;
+  size_t morselSize_;
+
+ public:
+  explicit MorselSource(std::shared_ptr<const Result> input,
+                        size_t morselSize = MORSEL_SIZE)
+      : input_{std::move(input)}, morselSize_{morselSize} {
+    AD_CONTRACT_CHECK(morselSize_ > 0);
+    if (!input_->isFullyMaterialized()) {
+      blocks_.emplace(input_->idTables());
+    }
+  }
+
+  // Return the next morsel together with its index, or `std::nullopt` if the
+  // input is exhausted.
+  std::optional<std::pair<size_t, Morsel>> next() {
+    std::unique_lock lock{mutex_};
+    std::shared_ptr<const IdTable> table;
+    const LocalVocab* localVocab = nullptr;
+    if (!blocks_.has_value()) {
+      // The aliasing constructor keeps the complete `input_` alive.
+      table = std::shared_ptr<const IdTable>{input_, &input_->idTable()};
+      localVocab = &input_->localVocab();
+    } else {
+      // Skip over exhausted (and empty) blocks.
+      while (currentBlock_ == nullptr ||
+             nextRow_ >= currentBlock_->idTable_.size()) {
+        auto block = blocks_->get();
+        nextRow_ = 0;
+        if (!block.has_value()) {
+          currentBlock_.reset();
+          return std::nullopt;
+        }
+        currentBlock_ = std::make_shared<const Result::IdTableVocabPair>(
+            std::move(block.value()));
+      }
+      table = std::shared_ptr<const IdTable>{currentBlock_,
+                                             &currentBlock_->idTable_};
+      localVocab = &currentBlock_->localVocab_;
+    }
+    if (nextRow_ >= table->size()) {
+      return std::nullopt;
+    }
+    size_t begin = nextRow_;
+    size_t end = std::min(begin + morselSize_, table->size());
+    nextRow_ = end;
+    return std::pair{nextIndex_++,
+                     Morsel{std::move(table), begin, end, localVocab->clone()}};
+  }
+};
+
+// Split the `input` into morsels and apply `processMorsel` (a callable
+// `Morsel -> IdTableVocabPair`) to each of them, using at most `numThreads`
+// threads of the shared `ad_utility::WorkerPool`. The processed morsels are
+// yielded lazily and in the order of the `input`; morsels that are empty after
+// processing are skipped. The `processMorsel` callable must be safe to be
+// called concurrently.
+//
+// NOTE: The morsels are processed in rounds of `2 * numThreads` morsels, each
+// of which is run via `WorkerPool::runInParallel` (the consuming thread also
+// works on the morsels). This bounds the number of processed morsels that
+// are not yet consumed, and the pool threads are never blocked by a slow
+// consumer.
+template <typename ProcessMorsel>
+Result::LazyResult processInParallel(std::shared_ptr<const Result> input,
+                                     size_t numThreads,
+                                     ProcessMorsel processMorsel,
+                                     size_t morselSize = MORSEL_SIZE) {
+  AD_CONTRACT_CHECK(numThreads > 0);
+  struct State {
+    MorselSource source_;
+    ProcessMorsel processMorsel_;
+    size_t numThreads_;
+    std::deque<Result::IdTableVocabPair> processed_;
+    State(std::shared_ptr<const Result> input, size_t morselSize,
+          ProcessMorsel processMorsel, size_t numThreads)
+        : source_{std::move(input), morselSize},
+          processMorsel_{std::move(processMorsel)},
+          numThreads_{numThreads} {}
+  };
+  auto state = std::make_shared<State>(std::move(input), morselSize,
+                                       std::move(processMorsel), numThreads);
+  auto get = [state]() -> std::optional<Result::IdTableVocabPair> {
+    while (state->processed_.empty()) {
+      // Take the morsels of the next round in the order of the input.
+      std::vector<Morsel> morsels;
+      while (morsels.size() < 2 * state->numThreads_) {
+        auto morsel = state->source_.next();
+        if (!morsel.has_value()) {
+          break;
+        }
+        morsels.push_back(std::move(morsel.value().second));
+      }
+      if (morsels.empty()) {
+        return std::nullopt;
+      }
+      std::vector<std::optional<Result::IdTableVocabPair>> results(
+          morsels.size());
+      std::atomic<size_t> nextMorsel = 0;
+      ad_utility::WorkerPool::global().runInParallel(
+          std::min(state->numThreads_, morsels.size()), [&](size_t) {
+            for (size_t i = nextMorsel++; i < morsels.size();
+                 i = nextMorsel++) {
+              results[i] = state->processMorsel_(std::move(morsels[i]));
+            }
+          });
+      for (auto& result : results) {
+        if (!result.value().idTable_.empty()) {
+          state->processed_.push_back(std::move(result.value()));
+        }
+      }
+    }
+    auto result = std::move(state->processed_.front());
+    state->processed_.pop_front();
+    return result;
+  };
+  return Result::LazyResult{
+      ad_utility::InputRangeFromGetCallable{std::move(get)}};
+}
+
+// Concatenate all the blocks of `lazyResult` into a single `IdTable` with
+// `numColumns` columns and merge their `LocalVocab`s.
+inline std::pair<IdTable, LocalVocab> materialize(
+    Result::LazyResult lazyResult, size_t numColumns,
+    const ad_utility::AllocatorWithLimit<Id>& allocator) {
+  IdTable result{numColumns, allocator};
+  LocalVocab localVocab;
+  for (Result::IdTableVocabPair& pair : lazyResult) {
+    if (result.empty()) {
+      result = std::move(pair.idTable_);
+    } else {
+      result.insertAtEnd(pair.idTable_);
+    }
+    localVocab.mergeWith(pair.localVocab_);
+  }
+  return {std::move(result), std::move(localVocab)};
+}
+
+}  // namespace qlever::morsels
+
+#endif  // QLEVER_SRC_ENGINE_MORSELPARALLELISM_H
@@ -7,6 +7,7 @@
 #include <absl/cleanup/cleanup.h>
 #include <absl/container/inlined_vector.h>
 
+#include "engine/DiskResultCache.h"
 #include "engine/NamedResultCache.h"
 #include "engine/QueryExecutionTree.h"
 #include "global/RuntimeParameters.h"
@@ -101,6 +102,17 @@ void Operation::recursivelySetCancellationHandle(
   cancellationHandle_ = std::move(cancellationHandle);
 }
 
+// _____________________________________________________________________________
+void Operation::setExecutionContext(QueryExecutionContext* executionContext) {
+  _executionContext = executionContext;
+  // Operations that were copied via their copy constructor (see the
+  // implementations of `cloneImpl`) share the `RuntimeInformation` with the
+  // original operation.
+  _runtimeInfo = std::make_shared<RuntimeInformation>();
+  _rootRuntimeInfo = _runtimeInfo;
+  _runtimeInfoWholeQuery = {};
+}
+
 // ________________________________________________________________________
 
 void Operation::recursivelySetTimeConstraint(
@@ -338,8 +350,24 @@ std::shared_ptr<const Result> Operation::getResult(
                 updateRuntimeInformationOnFailure(timer.msecs());
               }
             });
+    // Before a result is computed, it is looked up in the (optional) second
+    // tier of the cache on disk.
+    auto* diskResultCache = canResultBeCached()
+                                ? _executionContext->diskResultCache()
+                                : nullptr;
+    bool loadedFromDisk = false;
     auto cacheSetup = [this, &timer, computationMode, &cacheKey, pinResult,
-                       isRoot]() {
+                       isRoot, diskResultCache, &loadedFromDisk]() {
+      if (diskResultCache != nullptr) {
+        auto value = diskResultCache->load(
+            cacheKey, _executionContext->locatedTriplesSnapshot(),
+            _executionContext->getAllocator());
+        if (value.has_value()) {
+          loadedFromDisk = true;
+          runtimeInfo().addDetail("loaded-from-disk-result-cache", true);
+          return std::move(value).value();
+        }
+      }
       return runComputationAndPrepareForCache(timer, computationMode, cacheKey,
                                               pinResult, isRoot);
     };
@@ -379,6 +407,12 @@ std::shared_ptr<const Result> Operation::getResult(
       updateRuntimeInformationOnSuccess(result, timer.msecs());
     }
 
+    if (diskResultCache != nullptr && !loadedFromDisk &&
+        result._cacheStatus == ad_utility::CacheStatus::computed &&
+        getRuntimeParameter<&RuntimeParameters::diskResultCacheWriteAll_>()) {
+      diskResultCache->store(cacheKey, result._resultPointer);
+    }
+
     // Pin result to the named result cache if so requested.
     if (pinResultWithName) {
       const auto& name = _executionContext->pinResultWithName().value();
@@ -777,3 +811,21 @@ bool Operation::columnOriginatesFromGraphOrUndef(
                variable);
   });
 }
+
+// _____________________________________________________________________________
+std::optional<Datatype> Operation::getStaticDatatype(
+    const Variable& variable) const {
+  AD_CONTRACT_CHECK(getExternallyVisibleVariableColumns().contains(variable));
+  std::optional<Datatype> result;
+  for (const auto* child : getChildren()) {
+    if (!child->getVariableColumnOrNullopt(variable).has_value()) {
+      continue;
+    }
+    auto datatype = child->getRootOperation()->getStaticDatatype(variable);
+    if (!datatype.has_value() || (result.has_value() && result != datatype)) {
+      return std::nullopt;
+    }
+    result = datatype;
+  }
+  return result;
+}
@@ -16,6 +16,7 @@
 #include "engine/RuntimeInformation.h"
 #include "engine/VariableToColumnMap.h"
 #include "engine/sparqlExpressions/SparqlExpressionPimpl.h"
+#include "global/ValueId.h"
 #include "parser/data/LimitOffsetClause.h"
 #include "rdfTypes/Variable.h"
 #include "util/CancellationHandle.h"
@@ -270,6 +271,12 @@ class Operation {
   void recursivelySetCancellationHandle(
       SharedCancellationHandle cancellationHandle);
 
+  // Let this operation (but not its children) use the `executionContext` and
+  // start with a fresh `RuntimeInformation`, see
+  // `QueryExecutionTree::cloneForExecutionContext`. The `executionContext` is
+  // `nullptr` for the plans in the `QueryPlanCache`, which are never executed.
+  void setExecutionContext(QueryExecutionContext* executionContext);
+
   template <typename Rep, typename Period>
   void recursivelySetTimeConstraint(
       std::chrono::duration<Rep, Period> duration) {
@@ -499,6 +506,18 @@ class Operation {
   // of the result).
   virtual bool columnOriginatesFromGraphOrUndef(const Variable& variable) const;
 
+  // Return the datatype that all the defined values of the `variable` in the
+  // result are guaranteed to have (e.g. `Int` for the result of a `COUNT`), or
+  // `std::nullopt` if the values might have different datatypes or nothing is
+  // known about them. This is used to export lazy results with typed columns,
+  // the values of which are not known in advance. The default implementation
+  // makes the same assumptions as `columnOriginatesFromGraphOrUndef` above: a
+  // variable that is not contained in any of the children has an unknown
+  // datatype, other variables have the datatype of the same variable in all
+  // the children that define it.
+  virtual std::optional<Datatype> getStaticDatatype(
+      const Variable& variable) const;
+
  private:
   // Create the runtime information in case the evaluation of this operation has
   // failed.
@@ -5,14 +5,17 @@
 
 #include "engine/OrderBy.h"
 
+#include <numeric>
 #include <sstream>
 
 #include "engine/CallFixedSize.h"
 #include "engine/Engine.h"
+#include "engine/ExternalSort.h"
 #include "engine/QueryExecutionTree.h"
 #include "global/RuntimeParameters.h"
 #include "global/ValueIdComparators.h"
 #include "util/TransparentFunctors.h"
+#include "util/Views.h"
 
 // _____________________________________________________________________________
 size_t OrderBy::getResultWidth() const { return subtree_->getResultWidth(); }
@@ -62,9 +65,52 @@ std::string OrderBy::getDescriptor() const {
   return "OrderBy on" + orderByVars;
 }
 
+namespace {
+// Return true iff `row1` comes before `row2` in the semantic sort order
+// specified by the `sortIndices_`. The rows may come from different
+// `IdTable`s.
+struct CompareBySortIndices {
+  OrderBy::SortIndices sortIndices_;
+  template <typename Row1, typename Row2>
+  bool operator()(const Row1& row1, const Row2& row2) const {
+    for (auto& [column, isDescending] : sortIndices_) {
+      if (row1[column] == row2[column]) {
+        continue;
+      }
+      using namespace valueIdComparators;
+      bool isLessThan = toBoolNotUndef(
+          compareIds<ComparisonForIncompatibleTypes::CompareByType>(
+              row1[column], row2[column], Comparison::LT));
+      return isLessThan != isDescending;
+    }
+    return false;
+  }
+};
+}  // namespace
+
 // _____________________________________________________________________________
-Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
+Result OrderBy::computeResult(bool requestLaziness) {
   using std::endl;
+  if (getLimitOffset()._limit.has_value()) {
+    return computeTopKResult(
+        getLimitOffset().upperBound(std::numeric_limits<uint64_t>::max()));
+  }
+  if (auto memory = qlever::externalSort::getMemoryForExternalSort(
+          *subtree_, allocator(), requestLaziness)) {
+    AD_LOG_DEBUG << "OrderBy result computation using an external sort..."
+                 << endl;
+    runtimeInfo().addDetail("external-sort-memory", memory.value().asString());
+    auto result = qlever::externalSort::sortExternally(
+        subtree_->getResult(true), getResultWidth(),
+        CompareBySortIndices{sortIndices_}, resultSortedOn(),
+        qlever::externalSort::makeFilenameForExternalSort(), memory.value(),
+        allocator(), cancellationHandle_);
+    // Without a `LIMIT` there still might be an `OFFSET`.
+    if (getLimitOffset()._offset != 0) {
+      result.applyLimitOffset(getLimitOffset(), [](auto, const auto&) {});
+    }
+    return result;
+  }
   AD_LOG_DEBUG << "Getting sub-result for OrderBy result computation..."
                << endl;
   std::shared_ptr<const Result> subRes = subtree_->getResult();
@@ -100,22 +146,7 @@ Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
   // only contains a single datatype, then we can use more efficient
   // implementations here.
 
-  // Return true iff `rowA` comes before `rowB` in the sort order specified by
-  // `sortIndices_`.
-  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
-    for (auto& [column, isDescending] : sortIndices_) {
-      if (row1[column] == row2[column]) {
-        continue;
-      }
-      bool isLessThan =
-          toBoolNotUndef(valueIdComparators::compareIds<
-                         valueIdComparators::ComparisonForIncompatibleTypes::
-                             CompareByType>(
-              row1[column], row2[column], valueIdComparators::Comparison::LT));
-      return isLessThan != isDescending;
-    }
-    return false;
-  };
+  CompareBySortIndices comparison{sortIndices_};
 
   // We cannot use the `CALL_FIXED_SIZE` macro here because the `sort` function
   // is templated not only on the integer `I` (which the `callFixedSize`
@@ -126,10 +157,110 @@ Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
   // We can't check during sort, so reset status here
   cancellationHandle_->resetWatchDogState();
   checkCancellation();
+
+  // Without a `LIMIT` there still might be an `OFFSET`.
+  idTable.erase(idTable.begin(),
+                idTable.begin() + getLimitOffset().actualOffset(idTable.size()));
   AD_LOG_DEBUG << "OrderBy result computation done." << endl;
   return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
 }
 
+// _____________________________________________________________________________
+Result OrderBy::computeTopKResult(uint64_t k) {
+  size_t width = getResultWidth();
+  IdTable buffer{width, allocator()};
+  if (k == 0) {
+    subtree_->getRootOperation()->updateRuntimeInformationWhenOptimizedOut();
+    return {std::move(buffer), resultSortedOn(), LocalVocab{}};
+  }
+  std::shared_ptr<const Result> subRes = subtree_->getResult(true);
+
+  // Sort the buffer and only keep its first `k` rows. Afterward, the last row
+  // of the buffer is the worst row that currently is part of the result.
+  auto shrinkBuffer = [this, &buffer, width, k]() {
+    ad_utility::callFixedSizeVi(width, [this, &buffer, k](auto I) {
+      auto table = std::move(buffer).toStatic<I>();
+      auto middle = table.begin() + std::min(k, uint64_t{table.size()});
+      std::partial_sort(table.begin(), middle, table.end(),
+                        CompareBySortIndices{sortIndices_});
+      table.erase(middle, table.end());
+      buffer = std::move(table).toDynamic();
+    });
+    cancellationHandle_->resetWatchDogState();
+    checkCancellation();
+  };
+
+  // Append all rows of `block` to the buffer that can still be part of the
+  // result. The block is consumed in slices, s.t. the buffer never contains
+  // more than `2 * k` rows. The buffer is shrunk as soon as it is full, which
+  // amortizes the cost of the sorting. This also holds for a large (or a fully
+  // materialized) input, so the memory is O(k) and not O(n).
+  bool bufferIsFull = false;
+  uint64_t maxBufferSize =
+      k + std::min(k, std::numeric_limits<uint64_t>::max() - k);
+  CompareBySortIndices compareRows{sortIndices_};
+  std::vector<size_t, ad_utility::AllocatorWithLimit<size_t>> candidates{
+      allocator()};
+  auto consumeSlice = [this, &buffer, &bufferIsFull, &candidates, k,
+                       &compareRows](const IdTable& block, size_t begin,
+                                     size_t end) {
+    candidates.clear();
+    if (bufferIsFull) {
+      // Only rows that are better than the currently worst row of the result
+      // can become part of the result.
+      auto worstRow = buffer[k - 1];
+      for (size_t i = begin; i < end; ++i) {
+        if (compareRows(block[i], worstRow)) {
+          candidates.push_back(i);
+        }
+      }
+    } else {
+      candidates.resize(end - begin);
+      std::iota(candidates.begin(), candidates.end(), begin);
+    }
+    size_t oldSize = buffer.numRows();
+    buffer.resize(oldSize + candidates.size());
+    for (auto col : ad_utility::integerRange(buffer.numColumns())) {
+      decltype(auto) input = block.getColumn(col);
+      ql::ranges::transform(candidates,
+                            buffer.getColumn(col).begin() + oldSize,
+                            [&input](size_t row) { return input[row]; });
+    }
+    checkCancellation();
+  };
+  auto consumeBlock = [&buffer, &bufferIsFull, &shrinkBuffer, &consumeSlice,
+                       maxBufferSize](const IdTable& block) {
+    size_t begin = 0;
+    while (begin < block.numRows()) {
+      uint64_t room =
+          std::max(maxBufferSize - buffer.numRows(), uint64_t{1});
+      size_t end = static_cast<size_t>(
+          std::min(uint64_t{block.numRows()}, uint64_t{begin} + room));
+      consumeSlice(block, begin, end);
+      begin = end;
+      if (buffer.numRows() >= maxBufferSize) {
+        shrinkBuffer();
+        bufferIsFull = true;
+      }
+    }
+  };
+
+  LocalVocab localVocab;
+  if (subRes->isFullyMaterialized()) {
+    consumeBlock(subRes->idTable());
+    localVocab = subRes->getCopyOfLocalVocab();
+  } else {
+    for (auto& [idTable, blockVocab] : subRes->idTables()) {
+      consumeBlock(idTable);
+      localVocab.mergeWith(blockVocab);
+    }
+  }
+  shrinkBuffer();
+  buffer.erase(buffer.begin(),
+               buffer.begin() + getLimitOffset().actualOffset(buffer.size()));
+  return {std::move(buffer), resultSortedOn(), std::move(localVocab)};
+}
+
 // ___________________________________________________________________
 OrderBy::SortedVariables OrderBy::getSortedVariables() const {
   SortedVariables result;
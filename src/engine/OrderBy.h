@@ -61,16 +61,24 @@ class OrderBy : public Operation {
     return subtree_->getMultiplicity(col);
   }
 
+  // If a `LIMIT` is set, only the first `LIMIT + OFFSET` rows are kept while
+  // sorting (see `computeTopKResult`), so the logarithmic factor only depends
+  // on this number and not on the size of the input.
   size_t getCostEstimate() override {
     size_t size = getSizeEstimateBeforeLimit();
-    size_t logSize = std::max(
-        size_t(1), static_cast<size_t>(logb(
-                       static_cast<double>(getSizeEstimateBeforeLimit()))));
+    size_t numKeptRows = getLimitOffset()._limit.has_value()
+                             ? getLimitOffset().upperBound(size)
+                             : size;
+    size_t logSize = static_cast<size_t>(
+        logb(static_cast<double>(std::max(numKeptRows, size_t{2}))));
     size_t nlogn = size * logSize;
     size_t subcost = subtree_->getCostEstimate();
     return nlogn + subcost;
   }
 
+  // The `LIMIT` and `OFFSET` are applied directly when sorting.
+  bool supportsLimitOffset() const override { return true; }
+
   bool knownEmptyResult() override { return subtree_->knownEmptyResult(); }
 
   size_t getResultWidth() const override;
@@ -82,7 +90,14 @@ class OrderBy : public Operation {
  private:
   std::unique_ptr<Operation> cloneImpl() const override;
 
-  Result computeResult([[maybe_unused]] bool requestLaziness) override;
+  Result computeResult(bool requestLaziness) override;
+
+  // Compute the result if a `LIMIT` is set. The input is consumed lazily, and
+  // only the best `k = LIMIT + OFFSET` rows (according to the `sortIndices_`)
+  // that have been seen so far are kept in a buffer of bounded size. This
+  // requires only O(k) memory (plus the size of a single input block) instead
+  // of materializing and sorting the complete input.
+  Result computeTopKResult(uint64_t k);
 
   VariableToColumnMap computeVariableToColumnMap() const override {
     return subtree_->getVariableColumns();
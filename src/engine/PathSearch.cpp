@@ -4,8 +4,10 @@
 
 #include "PathSearch.h"
 
+#include <cmath>
 #include <functional>
 #include <optional>
+#include <queue>
 #include <ranges>
 #include <unordered_map>
 #include <variant>
@@ -17,16 +19,19 @@
 #include "engine/QueryExecutionTree.h"
 #include "engine/VariableToColumnMap.h"
 #include "util/AllocatorWithLimit.h"
+#include "util/Exception.h"
 
 using namespace pathSearch;
 
 // _____________________________________________________________________________
 BinSearchWrapper::BinSearchWrapper(const IdTable& table, size_t startCol,
-                                   size_t endCol, std::vector<size_t> edgeCols)
+                                   size_t endCol, std::vector<size_t> edgeCols,
+                                   std::optional<size_t> weightCol)
     : table_(table),
       startCol_(startCol),
       endCol_(endCol),
-      edgeCols_(std::move(edgeCols)) {}
+      edgeCols_(std::move(edgeCols)),
+      weightCol_(weightCol) {}
 
 // _____________________________________________________________________________
 std::vector<Edge> BinSearchWrapper::outgoingEdes(const Id node) const {
@@ -61,6 +66,26 @@ std::vector<Id> BinSearchWrapper::getEdgeProperties(const Edge& edge) const {
   return edgeProperties;
 }
 
+// _____________________________________________________________________________
+double BinSearchWrapper::getEdgeWeight(const Edge& edge) const {
+  if (!weightCol_.has_value()) {
+    return 1;
+  }
+  Id weight = table_(edge.edgeRow_, weightCol_.value());
+  double result;
+  if (weight.getDatatype() == Datatype::Int) {
+    result = static_cast<double>(weight.getInt());
+  } else if (weight.getDatatype() == Datatype::Double) {
+    result = weight.getDouble();
+  } else {
+    AD_THROW("The edge weights of a path search have to be numeric.");
+  }
+  if (std::isnan(result) || result < 0) {
+    AD_THROW("The edge weights of a path search must not be negative.");
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 Edge BinSearchWrapper::makeEdgeFromRow(size_t row) const {
   Edge edge;
@@ -71,12 +96,29 @@ Edge BinSearchWrapper::makeEdgeFromRow(size_t row) const {
   return edge;
 }
 
+// _____________________________________________________________________________
+Path ShortestPathTree::pathTo(Id node, Path path) const {
+  uint64_t current = node.getBits();
+  for (auto it = predecessors_.find(current); it != predecessors_.end();
+       it = predecessors_.find(current)) {
+    path.push_back(it->second);
+    current = it->second.start_.getBits();
+  }
+  ql::ranges::reverse(path.edges_);
+  return path;
+}
+
 // _____________________________________________________________________________
 PathSearch::PathSearch(QueryExecutionContext* qec,
                        std::shared_ptr<QueryExecutionTree> subtree,
                        PathSearchConfiguration config)
     : Operation(qec), subtree_(std::move(subtree)), config_(std::move(config)) {
   AD_CORRECTNESS_CHECK(qec != nullptr);
+  AD_CONTRACT_CHECK(
+      config_.algorithm_ != PathSearchAlgorithm::K_SHORTEST_PATHS ||
+          config_.numPathsPerTarget_.value_or(1) > 0,
+      "The number of paths per target must be positive for the k shortest "
+      "paths");
 
   auto startCol = subtree_->getVariableColumn(config_.start_);
   auto endCol = subtree_->getVariableColumn(config_.end_);
@@ -229,64 +271,101 @@ void PathSearch::bindSourceAndTargetSide(
 }
 
 // _____________________________________________________________________________
-Result PathSearch::computeResult([[maybe_unused]] bool requestLaziness) {
+Result PathSearch::computeResult(bool requestLaziness) {
   std::shared_ptr<const Result> subRes = subtree_->getResult();
-  IdTable idTable{allocator()};
-  idTable.setNumColumns(getResultWidth());
+  if (subRes->idTable().empty()) {
+    IdTable idTable{allocator()};
+    idTable.setNumColumns(getResultWidth());
+    return {std::move(idTable), resultSortedOn(),
+            subRes->getSharedLocalVocab()};
+  }
 
-  const IdTable& dynSub = subRes->idTable();
-  if (!dynSub.empty()) {
-    auto timer = ad_utility::Timer(ad_utility::Timer::Started);
-
-    auto subStartColumn = subtree_->getVariableColumn(config_.start_);
-    auto subEndColumn = subtree_->getVariableColumn(config_.end_);
-    std::vector<size_t> edgeColumns;
-    for (const auto& edgeProp : config_.edgeProperties_) {
-      edgeColumns.push_back(subtree_->getVariableColumn(edgeProp));
-    }
-    BinSearchWrapper binSearch{dynSub, subStartColumn, subEndColumn,
-                               std::move(edgeColumns)};
+  auto timer = ad_utility::Timer(ad_utility::Timer::Started);
+  auto [sources, targets] = handleSearchSides();
+  runtimeInfo().addDetail("Time to prepare search sides",
+                          timer.msecs().count());
+
+  auto gen = searchPaths(std::move(subRes),
+                         std::vector<Id>(sources.begin(), sources.end()),
+                         std::vector<Id>(targets.begin(), targets.end()),
+                         !requestLaziness);
+  return requestLaziness ? Result{std::move(gen), resultSortedOn()}
+                         : Result{cppcoro::getSingleElement(std::move(gen)),
+                                  resultSortedOn()};
+};
 
-    timer.stop();
-    auto buildingTime = timer.msecs();
-    timer.start();
+// _____________________________________________________________________________
+Result::Generator PathSearch::searchPaths(std::shared_ptr<const Result> subRes,
+                                          std::vector<Id> sources,
+                                          std::vector<Id> targets,
+                                          bool yieldOnce) const {
+  auto timer = ad_utility::Timer(ad_utility::Timer::Started);
 
-    auto [sources, targets] = handleSearchSides();
+  const IdTable& dynSub = subRes->idTable();
+  auto subStartColumn = subtree_->getVariableColumn(config_.start_);
+  auto subEndColumn = subtree_->getVariableColumn(config_.end_);
+  std::vector<size_t> edgeColumns;
+  for (const auto& edgeProp : config_.edgeProperties_) {
+    edgeColumns.push_back(subtree_->getVariableColumn(edgeProp));
+  }
+  std::optional<size_t> weightColumn;
+  if (config_.edgeWeight_.has_value()) {
+    weightColumn = subtree_->getVariableColumn(config_.edgeWeight_.value());
+  }
+  BinSearchWrapper binSearch{dynSub, subStartColumn, subEndColumn,
+                             std::move(edgeColumns), weightColumn};
+  if (sources.empty()) {
+    sources = binSearch.getSources();
+  }
+  runtimeInfo().addDetail("Time to build graph & mapping",
+                          timer.msecs().count());
 
-    timer.stop();
-    auto sideTime = timer.msecs();
-    timer.start();
+  std::chrono::milliseconds searchTime{0};
+  std::chrono::milliseconds fillTime{0};
+  IdTable idTable{getResultWidth(), allocator()};
+  size_t numPaths = 0;
 
-    PathsLimited paths{allocator()};
-    std::vector<Id> allSources;
-    if (sources.empty()) {
-      allSources = binSearch.getSources();
-      sources = allSources;
+  bool cartesian = config_.cartesian_ || sources.size() != targets.size();
+  std::unordered_set<uint64_t> targetSet;
+  if (cartesian) {
+    for (auto target : targets) {
+      targetSet.insert(target.getBits());
     }
-    paths = allPaths(sources, targets, binSearch, config_.cartesian_,
-                     config_.numPathsPerTarget_);
-
-    timer.stop();
-    auto searchTime = timer.msecs();
+  }
+  for (size_t i = 0; i < sources.size(); i++) {
     timer.start();
+    auto paths =
+        findPaths(sources[i],
+                  cartesian ? targetSet
+                            : std::unordered_set{targets[i].getBits()},
+                  binSearch);
+    searchTime += timer.msecs();
 
+    timer.start();
     CALL_FIXED_SIZE(std::array{getResultWidth()},
                     &PathSearch::pathsToResultTable, this, idTable, paths,
-                    binSearch);
-
-    timer.stop();
-    auto fillTime = timer.msecs();
-    timer.start();
-
-    auto& info = runtimeInfo();
-    info.addDetail("Time to build graph & mapping", buildingTime.count());
-    info.addDetail("Time to prepare search sides", sideTime.count());
-    info.addDetail("Time to search paths", searchTime.count());
-    info.addDetail("Time to fill result table", fillTime.count());
+                    binSearch, numPaths);
+    numPaths += paths.size();
+    fillTime += timer.msecs();
+
+    // Yield the paths of each source as soon as they are found, so that the
+    // first results are available without searching from all sources.
+    if (!yieldOnce && !idTable.empty()) {
+      co_yield Result::IdTableVocabPair{std::move(idTable),
+                                      subRes->getCopyOfLocalVocab()};
+      idTable = IdTable{getResultWidth(), allocator()};
+    }
   }
 
-  return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
-};
+  auto& info = runtimeInfo();
+  info.addDetail("Time to search paths", searchTime.count());
+  info.addDetail("Time to fill result table", fillTime.count());
+  info.addDetail("Number of paths", numPaths);
+  if (yieldOnce) {
+    co_yield Result::IdTableVocabPair{std::move(idTable),
+                                      subRes->getCopyOfLocalVocab()};
+  }
+}
 
 // _____________________________________________________________________________
 VariableToColumnMap PathSearch::computeVariableToColumnMap() const {
@@ -329,6 +408,22 @@ PathSearch::handleSearchSides() const {
 
 // _____________________________________________________________________________
 PathsLimited PathSearch::findPaths(
+    const Id& source, const std::unordered_set<uint64_t>& targets,
+    const BinSearchWrapper& binSearch) const {
+  switch (config_.algorithm_) {
+    case PathSearchAlgorithm::ALL_PATHS:
+      return allPaths(source, targets, binSearch, config_.numPathsPerTarget_);
+    case PathSearchAlgorithm::SHORTEST_PATH:
+      return shortestPaths(source, targets, binSearch);
+    case PathSearchAlgorithm::K_SHORTEST_PATHS:
+      return kShortestPaths(source, targets, binSearch,
+                            config_.numPathsPerTarget_.value_or(1));
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+PathsLimited PathSearch::allPaths(
     const Id& source, const std::unordered_set<uint64_t>& targets,
     const BinSearchWrapper& binSearch,
     std::optional<uint64_t> numPathsPerTarget) const {
@@ -386,39 +481,200 @@ PathsLimited PathSearch::findPaths(
 }
 
 // _____________________________________________________________________________
-PathsLimited PathSearch::allPaths(
-    ql::span<const Id> sources, ql::span<const Id> targets,
-    const BinSearchWrapper& binSearch, bool cartesian,
-    std::optional<uint64_t> numPathsPerTarget) const {
-  PathsLimited paths{allocator()};
-  Path path{EdgesLimited(allocator())};
+ShortestPathTree PathSearch::shortestPathTree(
+    const Id& source, const std::unordered_set<uint64_t>& targets,
+    const BinSearchWrapper& binSearch, const ExcludedRows& excludedRows,
+    const ExcludedNodes& excludedNodes) const {
+  ShortestPathTree tree{ShortestPathTree::Predecessors{allocator()},
+                        ShortestPathTree::Nodes{allocator()}};
+  // Paths have at least one edge, so the source only counts as a target if
+  // it is reached again, which never happens in a shortest path search.
+  size_t numTargetsLeft = targets.size() - targets.count(source.getBits());
+  if (!targets.empty() && numTargetsLeft == 0) {
+    return tree;
+  }
+  auto isExcluded = [&](const Edge& edge) {
+    return excludedRows.contains(edge.edgeRow_) ||
+           excludedNodes.contains(edge.end_.getBits()) ||
+           edge.end_ == source;
+  };
+  // Record that the shortest path to `node` is known. Return false if all the
+  // targets have been reached.
+  auto settle = [&](Id node) {
+    tree.nodesByDistance_.push_back(node);
+    return !(targets.contains(node.getBits()) && --numTargetsLeft == 0);
+  };
 
-  if (cartesian || sources.size() != targets.size()) {
-    std::unordered_set<uint64_t> targetSet;
-    for (auto target : targets) {
-      targetSet.insert(target.getBits());
+  if (!binSearch.hasEdgeWeights()) {
+    ShortestPathTree::Nodes queue{allocator()};
+    queue.push_back(source);
+    for (size_t i = 0; i < queue.size(); i++) {
+      checkCancellation();
+      for (const auto& edge : binSearch.outgoingEdes(queue[i])) {
+        if (isExcluded(edge) ||
+            !tree.predecessors_.emplace(edge.end_.getBits(), edge).second) {
+          continue;
+        }
+        queue.push_back(edge.end_);
+        if (!settle(edge.end_)) {
+          return tree;
+        }
+      }
     }
-    for (auto source : sources) {
-      for (const auto& path :
-           findPaths(source, targetSet, binSearch, numPathsPerTarget)) {
-        paths.push_back(path);
+    return tree;
+  }
+
+  // Dijkstra's algorithm, the queue contains the tentative distances and the
+  // bits of the nodes.
+  using QueueEntry = std::pair<double, uint64_t>;
+  using QueueEntries =
+      std::vector<QueueEntry, ad_utility::AllocatorWithLimit<QueueEntry>>;
+  std::priority_queue<QueueEntry, QueueEntries, std::greater<>> queue{
+      std::greater<>{}, QueueEntries{allocator()}};
+  ad_utility::HashMapWithMemoryLimit<uint64_t, double> distances{allocator()};
+  ad_utility::HashSetWithMemoryLimit<uint64_t> settled{allocator()};
+  queue.emplace(0, source.getBits());
+  while (!queue.empty()) {
+    checkCancellation();
+    auto [distance, nodeBits] = queue.top();
+    queue.pop();
+    if (!settled.insert(nodeBits).second) {
+      continue;
+    }
+    Id node = Id::fromBits(nodeBits);
+    if (node != source && !settle(node)) {
+      return tree;
+    }
+    for (const auto& edge : binSearch.outgoingEdes(node)) {
+      uint64_t end = edge.end_.getBits();
+      if (isExcluded(edge) || settled.contains(end)) {
+        continue;
+      }
+      double newDistance = distance + binSearch.getEdgeWeight(edge);
+      auto it = distances.find(end);
+      if (it == distances.end() || newDistance < it->second) {
+        distances[end] = newDistance;
+        tree.predecessors_.insert_or_assign(end, edge);
+        queue.emplace(newDistance, end);
       }
     }
-  } else {
-    for (size_t i = 0; i < sources.size(); i++) {
-      for (const auto& path : findPaths(sources[i], {targets[i].getBits()},
-                                        binSearch, numPathsPerTarget)) {
-        paths.push_back(path);
+  }
+  return tree;
+}
+
+// _____________________________________________________________________________
+PathsLimited PathSearch::shortestPaths(
+    const Id& source, const std::unordered_set<uint64_t>& targets,
+    const BinSearchWrapper& binSearch) const {
+  auto tree = shortestPathTree(source, targets, binSearch,
+                               ExcludedRows{allocator()},
+                               ExcludedNodes{allocator()});
+  PathsLimited result{allocator()};
+  for (Id node : tree.nodesByDistance_) {
+    if (targets.empty() || targets.contains(node.getBits())) {
+      result.push_back(tree.pathTo(node, Path{EdgesLimited(allocator())}));
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+PathsLimited PathSearch::kShortestPaths(
+    const Id& source, const std::unordered_set<uint64_t>& targets,
+    const BinSearchWrapper& binSearch, uint64_t k) const {
+  auto tree = shortestPathTree(source, targets, binSearch,
+                               ExcludedRows{allocator()},
+                               ExcludedNodes{allocator()});
+  auto cost = [&binSearch](const Path& path) {
+    double result = 0;
+    for (const auto& edge : path.edges_) {
+      result += binSearch.getEdgeWeight(edge);
+    }
+    return result;
+  };
+  // Return true iff the first `n` edges of the paths are the same.
+  auto haveSamePrefix = [](const Path& a, const Path& b, size_t n) {
+    return a.size() >= n && b.size() >= n &&
+           std::equal(a.edges_.begin(), a.edges_.begin() + n,
+                      b.edges_.begin(), [](const Edge& x, const Edge& y) {
+                        return x.edgeRow_ == y.edgeRow_;
+                      });
+  };
+  auto isSamePath = [&haveSamePrefix](const Path& a, const Path& b) {
+    return a.size() == b.size() && haveSamePrefix(a, b, a.size());
+  };
+
+  PathsLimited result{allocator()};
+  for (Id target : tree.nodesByDistance_) {
+    if (!targets.empty() && !targets.contains(target.getBits())) {
+      continue;
+    }
+    std::unordered_set<uint64_t> spurTargets{target.getBits()};
+    PathsLimited found{allocator()};
+    found.push_back(tree.pathTo(target, Path{EdgesLimited(allocator())}));
+    using Candidate = std::pair<double, Path>;
+    std::vector<Candidate, ad_utility::AllocatorWithLimit<Candidate>>
+        candidates{allocator()};
+    while (found.size() < k) {
+      // Each candidate deviates from the last found path at one of its
+      // nodes (the spur node): it shares the edges before that node (the
+      // root path), and continues with a shortest path to the target that
+      // avoids the nodes of the root path and the edges that continue the
+      // same root path in the paths found so far.
+      const Path previous = found.back();
+      for (size_t i = 0; i < previous.size(); i++) {
+        Id spurNode = i == 0 ? source : previous.edges_[i - 1].end_;
+        ExcludedRows excludedRows{allocator()};
+        for (const auto& path : found) {
+          if (path.size() > i && haveSamePrefix(path, previous, i)) {
+            excludedRows.insert(path.edges_[i].edgeRow_);
+          }
+        }
+        ExcludedNodes excludedNodes{allocator()};
+        if (i > 0) {
+          excludedNodes.insert(source.getBits());
+        }
+        for (size_t j = 0; j + 1 < i; j++) {
+          excludedNodes.insert(previous.edges_[j].end_.getBits());
+        }
+        auto spurTree = shortestPathTree(spurNode, spurTargets, binSearch,
+                                         excludedRows, excludedNodes);
+        if (!spurTree.predecessors_.contains(target.getBits())) {
+          continue;
+        }
+        Path candidate{EdgesLimited(allocator())};
+        for (size_t j = 0; j < i; j++) {
+          candidate.push_back(previous.edges_[j]);
+        }
+        candidate = spurTree.pathTo(target, std::move(candidate));
+        auto isCandidate = [&](const auto& entry) {
+          return isSamePath(entry.second, candidate);
+        };
+        if (ql::ranges::none_of(candidates, isCandidate)) {
+          double candidateCost = cost(candidate);
+          candidates.emplace_back(candidateCost, std::move(candidate));
+        }
+      }
+      if (candidates.empty()) {
+        break;
       }
+      auto best = ql::ranges::min_element(
+          candidates, {}, [](const auto& entry) { return entry.first; });
+      found.push_back(std::move(best->second));
+      candidates.erase(best);
+    }
+    for (auto& path : found) {
+      result.push_back(std::move(path));
     }
   }
-  return paths;
+  return result;
 }
 
 // _____________________________________________________________________________
 template <size_t WIDTH>
 void PathSearch::pathsToResultTable(IdTable& tableDyn, PathsLimited& paths,
-                                    const BinSearchWrapper& binSearch) const {
+                                    const BinSearchWrapper& binSearch,
+                                    size_t firstPathIndex) const {
   IdTableStatic<WIDTH> table = std::move(tableDyn).toStatic<WIDTH>();
 
   std::vector<size_t> edgePropertyCols;
@@ -427,7 +683,7 @@ void PathSearch::pathsToResultTable(IdTable& tableDyn, PathsLimited& paths,
     edgePropertyCols.push_back(edgePropertyCol);
   }
 
-  size_t rowIndex = 0;
+  size_t rowIndex = table.size();
   for (size_t pathIndex = 0; pathIndex < paths.size(); pathIndex++) {
     auto path = paths[pathIndex];
 
@@ -447,7 +703,8 @@ void PathSearch::pathsToResultTable(IdTable& tableDyn, PathsLimited& paths,
       table.emplace_back();
       table(rowIndex, getStartIndex()) = edge.start_;
       table(rowIndex, getEndIndex()) = edge.end_;
-      table(rowIndex, getPathIndex()) = Id::makeFromInt(pathIndex);
+      table(rowIndex, getPathIndex()) =
+          Id::makeFromInt(firstPathIndex + pathIndex);
       table(rowIndex, getEdgeIndex()) = Id::makeFromInt(edgeIndex);
 
       if (sourceId) {
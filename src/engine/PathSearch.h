@@ -14,8 +14,15 @@
 #include "engine/Operation.h"
 #include "global/Id.h"
 #include "util/AllocatorWithLimit.h"
+#include "util/HashMap.h"
+#include "util/HashSet.h"
 
-enum class PathSearchAlgorithm { ALL_PATHS };
+// The algorithms of the path search. `ALL_PATHS` enumerates all paths without
+// repeated nodes, `SHORTEST_PATH` finds a single shortest path to each target
+// (via a breadth-first search, or Dijkstra's algorithm if an edge weight is
+// given), and `K_SHORTEST_PATHS` finds the `numPathsPerTarget` shortest paths
+// without repeated nodes to each target (via Yen's algorithm).
+enum class PathSearchAlgorithm { ALL_PATHS, SHORTEST_PATH, K_SHORTEST_PATHS };
 
 /**
  * @brief Represents the source or target side of a PathSearch.
@@ -62,10 +69,12 @@ class BinSearchWrapper {
   size_t startCol_;
   size_t endCol_;
   std::vector<size_t> edgeCols_;
+  std::optional<size_t> weightCol_;
 
  public:
   BinSearchWrapper(const IdTable& table, size_t startCol, size_t endCol,
-                   std::vector<size_t> edgeCols);
+                   std::vector<size_t> edgeCols,
+                   std::optional<size_t> weightCol = std::nullopt);
 
   /**
    * @brief Return all outgoing edges of a node
@@ -84,9 +93,40 @@ class BinSearchWrapper {
 
   std::vector<Id> getEdgeProperties(const Edge& edge) const;
 
+  bool hasEdgeWeights() const { return weightCol_.has_value(); }
+
+  /**
+   * @brief Return the weight of the edge, which is 1 if no weight column
+   * is given. Throws if the weight is not a non-negative number.
+   */
+  double getEdgeWeight(const Edge& edge) const;
+
  private:
   Edge makeEdgeFromRow(size_t row) const;
 };
+
+// The rows of the edges and the nodes that are ignored by a shortest path
+// search.
+using ExcludedRows = ad_utility::HashSetWithMemoryLimit<size_t>;
+using ExcludedNodes = ad_utility::HashSetWithMemoryLimit<uint64_t>;
+
+/**
+ * @brief The result of a single-source shortest path search: the edge
+ * via which each reached node was reached on a shortest path, and the
+ * reached nodes (without the source) in the order of their distance.
+ */
+struct ShortestPathTree {
+  using Predecessors = ad_utility::HashMapWithMemoryLimit<uint64_t, Edge>;
+  using Nodes = std::vector<Id, ad_utility::AllocatorWithLimit<Id>>;
+  Predecessors predecessors_;
+  Nodes nodesByDistance_;
+
+  /**
+   * @brief Return the path from the source to the reached `node`.
+   * @param path An empty path, to which the edges are added.
+   */
+  Path pathTo(Id node, Path path) const;
+};
 }  // namespace pathSearch
 
 struct PathSearchConfiguration {
@@ -99,7 +139,12 @@ struct PathSearchConfiguration {
   Variable edgeColumn_;
   std::vector<Variable> edgeProperties_;
   bool cartesian_ = true;
+  // The maximal number of paths per target. For `K_SHORTEST_PATHS`, it must be
+  // positive if set, for `ALL_PATHS`, zero yields no paths at all.
   std::optional<uint64_t> numPathsPerTarget_ = std::nullopt;
+  // The weights of the edges for the shortest path algorithms, has to be one
+  // of the `edgeProperties_`. Without it, all edges have the weight 1.
+  std::optional<Variable> edgeWeight_ = std::nullopt;
 
   bool sourceIsVariable() const {
     return std::holds_alternative<Variable>(sources_);
@@ -123,6 +168,10 @@ struct PathSearchConfiguration {
     std::ostringstream os;
     if (algorithm_ == PathSearchAlgorithm::ALL_PATHS) {
       os << "Algorithm: All paths" << '\n';
+    } else if (algorithm_ == PathSearchAlgorithm::SHORTEST_PATH) {
+      os << "Algorithm: Shortest path" << '\n';
+    } else if (algorithm_ == PathSearchAlgorithm::K_SHORTEST_PATHS) {
+      os << "Algorithm: K shortest paths" << '\n';
     }
 
     os << "Source: " << searchSideToString(sources_) << '\n';
@@ -137,6 +186,13 @@ struct PathSearchConfiguration {
     for (const auto& edgeProperty : edgeProperties_) {
       os << "  " << edgeProperty.toSparql() << '\n';
     }
+    if (edgeWeight_.has_value()) {
+      os << "EdgeWeight: " << edgeWeight_.value().toSparql() << '\n';
+    }
+    os << "Cartesian: " << cartesian_ << '\n';
+    if (numPathsPerTarget_.has_value()) {
+      os << "NumPathsPerTarget: " << numPathsPerTarget_.value() << '\n';
+    }
 
     return std::move(os).str();
   }
@@ -250,7 +306,7 @@ class PathSearch : public Operation {
         .columnIndex_;
   }
 
-  Result computeResult([[maybe_unused]] bool requestLaziness) override;
+  Result computeResult(bool requestLaziness) override;
   VariableToColumnMap computeVariableToColumnMap() const override;
 
  private:
@@ -258,33 +314,76 @@ class PathSearch : public Operation {
 
   std::pair<ql::span<const Id>, ql::span<const Id>> handleSearchSides() const;
 
+  /**
+   * @brief Searches the paths from the sources to the targets (from all
+   * start nodes of the edges if `sources` is empty) one source at a time.
+   * @param subRes The result of the subtree, which contains the edges.
+   * @param yieldOnce If true, a single table with all paths is yielded at the
+   * end, else a table with the paths of each source as soon as they are found.
+   */
+  Result::Generator searchPaths(std::shared_ptr<const Result> subRes,
+                                std::vector<Id> sources,
+                                std::vector<Id> targets, bool yieldOnce) const;
+
   /**
    * @brief Finds paths based on the configured algorithm.
    * @return A vector of paths.
    */
   pathSearch::PathsLimited findPaths(
       const Id& source, const std::unordered_set<uint64_t>& targets,
-      const pathSearch::BinSearchWrapper& binSearch,
-      std::optional<uint64_t> numPathsPerTarget) const;
+      const pathSearch::BinSearchWrapper& binSearch) const;
 
   /**
-   * @brief Finds all paths in the graph.
+   * @brief Finds all paths from the source in the graph.
    * @return A vector of all paths.
    */
   pathSearch::PathsLimited allPaths(
-      ql::span<const Id> sources, ql::span<const Id> targets,
-      const pathSearch::BinSearchWrapper& binSearch, bool cartesian,
+      const Id& source, const std::unordered_set<uint64_t>& targets,
+      const pathSearch::BinSearchWrapper& binSearch,
       std::optional<uint64_t> numPathsPerTarget) const;
 
+  /**
+   * @brief Finds a shortest path from the source to each target (to each
+   * reachable node if `targets` is empty).
+   * @return The paths, ordered by their length.
+   */
+  pathSearch::PathsLimited shortestPaths(
+      const Id& source, const std::unordered_set<uint64_t>& targets,
+      const pathSearch::BinSearchWrapper& binSearch) const;
+
+  /**
+   * @brief Finds the `k` shortest paths without repeated nodes from the
+   * source to each target (to each reachable node if `targets` is empty)
+   * using Yen's algorithm.
+   * @return The paths, grouped by target and ordered by their length.
+   */
+  pathSearch::PathsLimited kShortestPaths(
+      const Id& source, const std::unordered_set<uint64_t>& targets,
+      const pathSearch::BinSearchWrapper& binSearch, uint64_t k) const;
+
+  /**
+   * @brief Runs a breadth-first search (Dijkstra's algorithm if the edges
+   * have weights) from the source, which stops as soon as all the targets
+   * have been reached. The edges in the rows `excludedRows` and the
+   * `excludedNodes` are ignored.
+   */
+  pathSearch::ShortestPathTree shortestPathTree(
+      const Id& source, const std::unordered_set<uint64_t>& targets,
+      const pathSearch::BinSearchWrapper& binSearch,
+      const pathSearch::ExcludedRows& excludedRows,
+      const pathSearch::ExcludedNodes& excludedNodes) const;
+
   /**
    * @brief Converts paths to a result table with a specified width.
    * @tparam WIDTH The width of the result table.
-   * @param tableDyn The dynamic table to store the results.
+   * @param tableDyn The dynamic table to which the results are appended.
    * @param paths The vector of paths to convert.
+   * @param firstPathIndex The index of the first of the `paths`.
    */
   template <size_t WIDTH>
   void pathsToResultTable(IdTable& tableDyn, pathSearch::PathsLimited& paths,
-                          const pathSearch::BinSearchWrapper& binSearch) const;
+                          const pathSearch::BinSearchWrapper& binSearch,
+                          size_t firstPathIndex) const;
 };
 
 #endif  // QLEVER_SRC_ENGINE_PATHSEARCH_H
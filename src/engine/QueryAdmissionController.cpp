@@ -0,0 +1,171 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryAdmissionController.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "backports/algorithm.h"
+#include "global/Id.h"
+#include "util/Exception.h"
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::laneFromString(std::string_view priority)
+    -> Lane {
+  if (priority == "interactive") {
+    return Lane::Interactive;
+  } else if (priority == "batch") {
+    return Lane::Batch;
+  }
+  throw std::runtime_error{
+      absl::StrCat("The value of the parameter \"priority\" must be either "
+                   "\"interactive\" or \"batch\", but was \"",
+                   priority, "\"")};
+}
+
+// _____________________________________________________________________________
+QueryAdmissionController::Ticket::Ticket(Ticket&& other) noexcept
+    : controller_{std::exchange(other.controller_, nullptr)},
+      numBytes_{std::exchange(other.numBytes_, 0)} {}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::Ticket::operator=(Ticket&& other) noexcept
+    -> Ticket& {
+  if (this != &other) {
+    if (controller_ != nullptr) {
+      controller_->release(numBytes_);
+    }
+    controller_ = std::exchange(other.controller_, nullptr);
+    numBytes_ = std::exchange(other.numBytes_, 0);
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________
+QueryAdmissionController::Ticket::~Ticket() {
+  if (controller_ != nullptr) {
+    controller_->release(numBytes_);
+  }
+}
+
+// _____________________________________________________________________________
+QueryAdmissionController::QueueEntry::QueueEntry(QueueEntry&& other) noexcept
+    : controller_{other.controller_},
+      lane_{other.lane_},
+      id_{other.id_},
+      numBytes_{other.numBytes_},
+      isQueued_{std::exchange(other.isQueued_, false)} {}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::QueueEntry::operator=(
+    QueueEntry&& other) noexcept -> QueueEntry& {
+  if (this != &other) {
+    if (isQueued_) {
+      controller_->removeFromQueue(*this);
+    }
+    controller_ = other.controller_;
+    lane_ = other.lane_;
+    id_ = other.id_;
+    numBytes_ = other.numBytes_;
+    isQueued_ = std::exchange(other.isQueued_, false);
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________
+QueryAdmissionController::QueueEntry::~QueueEntry() {
+  if (isQueued_) {
+    controller_->removeFromQueue(*this);
+  }
+}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::enqueue(Lane lane,
+                                       ad_utility::MemorySize memoryEstimate,
+                                       size_t maxQueueSize) -> QueueEntry {
+  auto state = state_.wlock();
+  size_t numWaiting = state->queues_[0].size() + state->queues_[1].size();
+  if (numWaiting >= maxQueueSize) {
+    throw std::runtime_error{absl::StrCat(
+        "The query was rejected because ", numWaiting,
+        " queries are already waiting for execution, please try again later")};
+  }
+  QueueEntry entry;
+  entry.controller_ = this;
+  entry.lane_ = lane;
+  entry.id_ = state->nextId_++;
+  entry.numBytes_ = std::min(memoryEstimate.getBytes(), memoryBudgetInBytes_);
+  entry.isQueued_ = true;
+  state->queues_[static_cast<size_t>(lane)].push_back(
+      {entry.id_, entry.numBytes_});
+  return entry;
+}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::tryAdmit(QueueEntry& entry)
+    -> std::optional<Ticket> {
+  AD_CONTRACT_CHECK(entry.isQueued_ && entry.controller_ == this);
+  auto state = state_.wlock();
+  // Only the first query of the first non-empty lane may be admitted.
+  auto& interactive = state->queues_[static_cast<size_t>(Lane::Interactive)];
+  auto& next = interactive.empty()
+                   ? state->queues_[static_cast<size_t>(Lane::Batch)]
+                   : interactive;
+  AD_CORRECTNESS_CHECK(!next.empty());
+  if (next.front().id_ != entry.id_) {
+    return std::nullopt;
+  }
+  bool fitsIntoBudget =
+      state->reservedBytes_ + entry.numBytes_ <= memoryBudgetInBytes_;
+  if (!fitsIntoBudget && state->numRunning_ > 0) {
+    return std::nullopt;
+  }
+  next.pop_front();
+  entry.isQueued_ = false;
+  state->reservedBytes_ += entry.numBytes_;
+  ++state->numRunning_;
+  return Ticket{this, entry.numBytes_};
+}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::getStatistics() const -> Statistics {
+  auto state = state_.rlock();
+  return {ad_utility::MemorySize::bytes(state->reservedBytes_),
+          state->numRunning_,
+          state->queues_[static_cast<size_t>(Lane::Interactive)].size(),
+          state->queues_[static_cast<size_t>(Lane::Batch)].size()};
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize QueryAdmissionController::estimateMemory(
+    size_t numRows, size_t numColumns) {
+  size_t rowSize = std::max(numColumns, size_t{1}) * sizeof(Id);
+  if (numRows > std::numeric_limits<size_t>::max() / rowSize) {
+    return ad_utility::MemorySize::max();
+  }
+  return ad_utility::MemorySize::bytes(numRows * rowSize);
+}
+
+// _____________________________________________________________________________
+void QueryAdmissionController::release(size_t numBytes) {
+  auto state = state_.wlock();
+  AD_CORRECTNESS_CHECK(state->numRunning_ > 0 &&
+                       state->reservedBytes_ >= numBytes);
+  state->reservedBytes_ -= numBytes;
+  --state->numRunning_;
+}
+
+// _____________________________________________________________________________
+void QueryAdmissionController::removeFromQueue(const QueueEntry& entry) {
+  auto state = state_.wlock();
+  auto& queue = state->queues_[static_cast<size_t>(entry.lane_)];
+  auto it = ql::ranges::find(queue, entry.id_, &QueuedQuery::id_);
+  AD_CORRECTNESS_CHECK(it != queue.end());
+  queue.erase(it);
+}
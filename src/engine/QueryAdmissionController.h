@@ -0,0 +1,136 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYADMISSIONCONTROLLER_H
+#define QLEVER_SRC_ENGINE_QUERYADMISSIONCONTROLLER_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string_view>
+
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// Decides when a (planned) query may start its execution. Each query reserves
+// an estimate of the memory it requires from a common budget before it is
+// executed, and releases it when it is done. If the budget is exhausted, the
+// query has to wait in a queue. There is one queue per `Lane`, where waiting
+// interactive queries are always admitted before waiting batch queries.
+// Within a lane, the queries are admitted in the order of their arrival.
+//
+// To guarantee progress, a query is always admitted when no other query is
+// running, even if its estimate exceeds the budget. The estimate of a single
+// query is capped by the budget.
+//
+// The class itself never blocks. The waiting (with a timeout) is done by the
+// caller, which repeatedly calls `tryAdmit` (see `Server::waitForAdmission`).
+class QueryAdmissionController {
+ public:
+  enum class Lane { Interactive = 0, Batch = 1 };
+
+  // Parse a lane from the value of the `priority` parameter of a request.
+  // Throws if the value is neither "interactive" nor "batch".
+  static Lane laneFromString(std::string_view priority);
+
+  // The memory reserved by an admitted query. The memory is released when the
+  // ticket is destroyed. A default-constructed ticket doesn't reserve anything.
+  class Ticket {
+   private:
+    QueryAdmissionController* controller_ = nullptr;
+    size_t numBytes_ = 0;
+
+   public:
+    Ticket() = default;
+    Ticket(QueryAdmissionController* controller, size_t numBytes)
+        : controller_{controller}, numBytes_{numBytes} {}
+    Ticket(Ticket&& other) noexcept;
+    Ticket& operator=(Ticket&& other) noexcept;
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket();
+
+    ad_utility::MemorySize reservedMemory() const {
+      return ad_utility::MemorySize::bytes(numBytes_);
+    }
+  };
+
+  // A query that waits for admission. When it is destroyed before it was
+  // admitted (e.g. because of a timeout), it is removed from its queue.
+  class QueueEntry {
+   private:
+    QueryAdmissionController* controller_ = nullptr;
+    Lane lane_ = Lane::Interactive;
+    uint64_t id_ = 0;
+    size_t numBytes_ = 0;
+    bool isQueued_ = false;
+    friend class QueryAdmissionController;
+
+   public:
+    QueueEntry() = default;
+    QueueEntry(QueueEntry&& other) noexcept;
+    QueueEntry& operator=(QueueEntry&& other) noexcept;
+    QueueEntry(const QueueEntry&) = delete;
+    QueueEntry& operator=(const QueueEntry&) = delete;
+    ~QueueEntry();
+  };
+
+  // The state of the controller, see `getStatistics()`.
+  struct Statistics {
+    ad_utility::MemorySize reservedMemory_;
+    size_t numRunning_;
+    size_t numInteractiveWaiting_;
+    size_t numBatchWaiting_;
+  };
+
+ private:
+  struct QueuedQuery {
+    uint64_t id_;
+    size_t numBytes_;
+  };
+  struct State {
+    size_t reservedBytes_ = 0;
+    size_t numRunning_ = 0;
+    uint64_t nextId_ = 0;
+    // One queue per lane, indexed by the value of the `Lane`.
+    std::array<std::deque<QueuedQuery>, 2> queues_;
+  };
+  size_t memoryBudgetInBytes_;
+  ad_utility::Synchronized<State> state_;
+
+ public:
+  explicit QueryAdmissionController(ad_utility::MemorySize memoryBudget)
+      : memoryBudgetInBytes_{memoryBudget.getBytes()} {}
+
+  // The controller is referenced by the tickets and queue entries.
+  QueryAdmissionController(const QueryAdmissionController&) = delete;
+  QueryAdmissionController& operator=(const QueryAdmissionController&) =
+      delete;
+
+  // Append a query with the given `memoryEstimate` to the queue of the given
+  // `lane`. Throws if there are already `maxQueueSize` waiting queries (in
+  // both lanes together).
+  QueueEntry enqueue(Lane lane, ad_utility::MemorySize memoryEstimate,
+                     size_t maxQueueSize);
+
+  // Admit the query of the `entry` if it is next in line and its memory
+  // estimate fits into the remaining budget. Return `std::nullopt` if the
+  // query has to keep waiting.
+  std::optional<Ticket> tryAdmit(QueueEntry& entry);
+
+  Statistics getStatistics() const;
+
+  // Estimate the memory that is required for a result with the given number
+  // of rows and columns (saturating instead of overflowing).
+  static ad_utility::MemorySize estimateMemory(size_t numRows,
+                                               size_t numColumns);
+
+ private:
+  void release(size_t numBytes);
+  void removeFromQueue(const QueueEntry& entry);
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYADMISSIONCONTROLLER_H
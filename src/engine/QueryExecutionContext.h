@@ -89,6 +89,7 @@ using QueryResultCache = ad_utility::ConcurrentCache<
 
 // Forward declaration because of cyclic dependency
 class NamedResultCache;
+class DiskResultCache;
 
 // Execution context for queries.
 // Holds references to index and engine, implements caching.
@@ -112,6 +113,12 @@ class QueryExecutionContext {
     return *sharedLocatedTriplesSnapshot_;
   }
 
+  // Return the shared pointer to the snapshot from above, which can be used to
+  // keep the snapshot alive independently of this context.
+  const SharedLocatedTriplesSnapshot& sharedLocatedTriplesSnapshot() const {
+    return sharedLocatedTriplesSnapshot_;
+  }
+
   // This function retrieves the most recent `LocatedTriplesSnapshot` and stores
   // it in the `QueryExecutionContext`. The new snapshot will be used for
   // evaluating queries after this call.
@@ -166,6 +173,13 @@ class QueryExecutionContext {
     return *namedResultCache_;
   }
 
+  // Access the cache for results on disk, which is `nullptr` if there is no
+  // such cache.
+  DiskResultCache* diskResultCache() const { return diskResultCache_; }
+  void setDiskResultCache(DiskResultCache* diskResultCache) {
+    diskResultCache_ = diskResultCache;
+  }
+
   // Accessors; see `pinResultWithName_` for an explanation.
   auto& pinResultWithName() { return pinResultWithName_; }
   const auto& pinResultWithName() const { return pinResultWithName_; }
@@ -193,6 +207,9 @@ class QueryExecutionContext {
   // The cache for named results.
   NamedResultCache* namedResultCache_ = nullptr;
 
+  // The (optional) second tier of the `_subtreeCache` on disk.
+  DiskResultCache* diskResultCache_ = nullptr;
+
   // Name under which the result of the query that is executed using this
   // context should be cached. When `std::nullopt`, the result is not cached.
   std::optional<std::string> pinResultWithName_ = std::nullopt;
@@ -284,3 +284,34 @@ QueryExecutionTree::getVariableAndInfoByColumnIndex(ColumnIndex colIdx) const {
   AD_CONTRACT_CHECK(it != varColMap.end());
   return *it;
 }
+
+// _____________________________________________________________________________
+std::shared_ptr<QueryExecutionTree>
+QueryExecutionTree::cloneForExecutionContext(QueryExecutionContext* qec,
+                                             bool pinCachedResults) const {
+  AD_CONTRACT_CHECK(qec != nullptr || !pinCachedResults);
+  auto result = clone();
+  result->strippedVariables_ = strippedVariables_;
+  result->recursivelySetExecutionContext(qec, pinCachedResults);
+  return result;
+}
+
+// _____________________________________________________________________________
+void QueryExecutionTree::recursivelySetExecutionContext(
+    QueryExecutionContext* qec, bool pinCachedResults) {
+  qec_ = qec;
+  // The `clone` has already pinned the results that are currently cached.
+  cachedResult_ = nullptr;
+  if (!rootOperation_) {
+    return;
+  }
+  if (pinCachedResults) {
+    readFromCache();
+  }
+  rootOperation_->setExecutionContext(qec);
+  for (auto* child : rootOperation_->getChildren()) {
+    if (child) {
+      child->recursivelySetExecutionContext(qec, pinCachedResults);
+    }
+  }
+}
@@ -286,6 +286,29 @@ class QueryExecutionTree {
                                 qec_, rootOperation_->clone())
                           : std::make_shared<QueryExecutionTree>(qec_);
   }
+
+  // Return a clone of this tree, the operations of which use the `qec` and
+  // have a fresh `RuntimeInformation`. This is used to store a plan in the
+  // `QueryPlanCache` and to execute it for a new request. If
+  // `pinCachedResults` is false, the clone keeps none of the results from the
+  // cache of the `qec` alive (see `readFromCache`), which is required for the
+  // stored plans, as they would otherwise hold the results indefinitely. The
+  // `qec` may only be `nullptr` if `pinCachedResults` is false, then the clone
+  // is detached from any context and can't be executed or cloned until it is
+  // attached again via `setExecutionContext`.
+  std::shared_ptr<QueryExecutionTree> cloneForExecutionContext(
+      QueryExecutionContext* qec, bool pinCachedResults) const;
+
+  // Let all the operations of this tree use the `qec` (which may be `nullptr`
+  // to detach the tree, see above) without pinning any cached results.
+  void setExecutionContext(QueryExecutionContext* qec) {
+    recursivelySetExecutionContext(qec, false);
+  }
+
+ private:
+  // Let all the operations of this tree use the `qec`, see above.
+  void recursivelySetExecutionContext(QueryExecutionContext* qec,
+                                      bool pinCachedResults);
 };
 
 namespace ad_utility {
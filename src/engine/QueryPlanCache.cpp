@@ -0,0 +1,216 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryPlanCache.h"
+
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/ascii.h>
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include <vector>
+
+#include "backports/algorithm.h"
+#include "engine/ExplicitIdTableOperation.h"
+#include "global/RuntimeParameters.h"
+
+// _____________________________________________________________________________
+QueryPlanCache::QueryPlanCache(size_t maxNumEntries)
+    : cache_{maxNumEntries}, maxNumEntries_{maxNumEntries} {}
+
+// _____________________________________________________________________________
+std::string QueryPlanCache::normalizeQueryString(std::string_view query) {
+  std::string result;
+  result.reserve(query.size());
+  // Whitespace (and comments) are only written when the next token follows,
+  // s.t. there is no whitespace at the beginning and the end of the result.
+  bool pendingSpace = false;
+  auto append = [&result, &pendingSpace](std::string_view token) {
+    if (pendingSpace && !result.empty()) {
+      result.push_back(' ');
+    }
+    pendingSpace = false;
+    result.append(token);
+  };
+  // Return the length of the IRI starting at `query[i]`, or 0 if there is
+  // no IRI (then the `<` is the less-than operator).
+  auto lengthOfIri = [&query](size_t i) -> size_t {
+    for (size_t j = i + 1; j < query.size(); ++j) {
+      char c = query[j];
+      if (c == '>') {
+        return j - i + 1;
+      }
+      if (static_cast<unsigned char>(c) <= ' ' || c == '<' || c == '"' ||
+          c == '{' || c == '}' || c == '|' || c == '^' || c == '`' ||
+          c == '\\') {
+        return 0;
+      }
+    }
+    return 0;
+  };
+  // Return the length of the string literal starting at `query[i]`, which
+  // might be a long literal with three quotes.
+  auto lengthOfLiteral = [&query](size_t i) -> size_t {
+    char quote = query[i];
+    bool isLong = query.substr(i, 3) == std::string(3, quote);
+    size_t j = i + (isLong ? 3 : 1);
+    while (j < query.size()) {
+      if (query[j] == '\\') {
+        j += 2;
+      } else if (!isLong && query[j] == quote) {
+        return j - i + 1;
+      } else if (isLong && query.substr(j, 3) == std::string(3, quote)) {
+        return j - i + 3;
+      } else {
+        ++j;
+      }
+    }
+    // An unterminated literal, the parser has already rejected this query.
+    return query.size() - i;
+  };
+
+  size_t i = 0;
+  while (i < query.size()) {
+    char c = query[i];
+    if (absl::ascii_isspace(static_cast<unsigned char>(c))) {
+      pendingSpace = true;
+      ++i;
+    } else if (c == '#') {
+      pendingSpace = true;
+      while (i < query.size() && query[i] != '\n') {
+        ++i;
+      }
+    } else if (c == '"' || c == '\'') {
+      size_t length = lengthOfLiteral(i);
+      append(query.substr(i, length));
+      i += length;
+    } else if (size_t length = c == '<' ? lengthOfIri(i) : 0; length > 0) {
+      append(query.substr(i, length));
+      i += length;
+    } else {
+      append(query.substr(i, 1));
+      ++i;
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string QueryPlanCache::makeKey(const ParsedQuery& query) {
+  std::string key = normalizeQueryString(query._originalString);
+  // The dataset might also be specified via the parameters of the request, so
+  // it is not necessarily part of the query string.
+  using Graphs = parsedQuery::DatasetClauses::Graphs;
+  auto appendGraphs = [&key](std::string_view name, const Graphs& graphs) {
+    if (!graphs.has_value()) {
+      return;
+    }
+    std::vector<std::string> strings;
+    for (const auto& graph : graphs.value()) {
+      strings.push_back(graph.toString());
+    }
+    ql::ranges::sort(strings);
+    absl::StrAppend(&key, "\n", name, ":", absl::StrJoin(strings, " "));
+  };
+  appendGraphs("default-graphs", query.datasetClauses_.activeDefaultGraphs());
+  appendGraphs("named-graphs", query.datasetClauses_.namedGraphs());
+  return key;
+}
+
+// _____________________________________________________________________________
+bool QueryPlanCache::isCacheable(const ParsedQuery& query,
+                                 const QueryExecutionTree& tree) {
+  if (query.hasUpdateClause()) {
+    return false;
+  }
+  // With this parameter, the plan depends on which results are currently
+  // cached, so it must not be reused once these results are evicted.
+  if (getRuntimeParameter<
+          &RuntimeParameters::zeroCostEstimateForCachedSubtree_>()) {
+    return false;
+  }
+  // The result of a named query can change at any time, so it must not be
+  // part of a cached plan.
+  auto isNamedResult = [](const QueryExecutionTree* subtree) {
+    return dynamic_cast<const ExplicitIdTableOperation*>(
+               subtree->getRootOperation().get()) != nullptr;
+  };
+  bool containsNamedResult = isNamedResult(&tree);
+  tree.forAllDescendants(
+      [&containsNamedResult, &isNamedResult](const QueryExecutionTree* child) {
+        containsNamedResult = containsNamedResult || isNamedResult(child);
+      });
+  return !containsNamedResult;
+}
+
+// _____________________________________________________________________________
+auto QueryPlanCache::get(const std::string& key, QueryExecutionContext& qec)
+    -> std::optional<CachedPlan> {
+  if (maxNumEntries_ == 0) {
+    return std::nullopt;
+  }
+  auto cache = cache_.wlock();
+  auto plan = (*cache)[key];
+  if (plan == nullptr ||
+      plan->snapshot_->index_ != qec.locatedTriplesSnapshot().index_) {
+    ++numMisses_;
+    return std::nullopt;
+  }
+  ++numHits_;
+  // The clone is made while holding the lock, as the stored tree is attached
+  // to the `qec` for the cloning (which needs a context to construct the
+  // operations) and detached again afterwards.
+  auto& storedTree = *plan->queryExecutionTree_;
+  storedTree.setExecutionContext(&qec);
+  absl::Cleanup detach{
+      [&storedTree]() { storedTree.setExecutionContext(nullptr); }};
+  return CachedPlan{
+      plan->parsedQuery_,
+      std::move(*storedTree.cloneForExecutionContext(&qec, true))};
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::insert(const std::string& key,
+                            const ParsedQuery& parsedQuery,
+                            const QueryExecutionTree& tree,
+                            const QueryExecutionContext& qec) {
+  if (maxNumEntries_ == 0 || !isCacheable(parsedQuery, tree)) {
+    return;
+  }
+  // The stored plan is detached from the `qec` and must not keep any results
+  // from the cache alive.
+  auto planTree = tree.cloneForExecutionContext(nullptr, false);
+  const auto& snapshot = qec.sharedLocatedTriplesSnapshot();
+  size_t snapshotIndex = snapshot->index_;
+  auto cache = cache_.wlock();
+  // A plan for an older snapshot is replaced, a plan for the same snapshot
+  // might have been inserted by a concurrent request for the same query.
+  if (cache->contains(key)) {
+    if ((*cache)[key]->snapshot_->index_ == snapshotIndex) {
+      return;
+    }
+    cache->erase(key);
+  }
+  cache->insert(key, Plan{snapshot, parsedQuery, std::move(planTree)});
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::setMaxNumEntries(size_t maxNumEntries) {
+  maxNumEntries_ = maxNumEntries;
+  auto cache = cache_.wlock();
+  if (maxNumEntries == 0) {
+    cache->clearAll();
+  } else {
+    cache->setMaxNumEntries(maxNumEntries);
+  }
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::clear() { cache_.wlock()->clearAll(); }
+
+// _____________________________________________________________________________
+auto QueryPlanCache::getStatistics() const -> Statistics {
+  return {numHits_, numMisses_, cache_.rlock()->numNonPinnedEntries()};
+}
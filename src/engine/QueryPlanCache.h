@@ -0,0 +1,121 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
+#define QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "engine/QueryExecutionContext.h"
+#include "engine/QueryExecutionTree.h"
+#include "parser/ParsedQuery.h"
+#include "util/Cache.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// A thread-safe LRU cache for the execution trees of SPARQL queries, s.t. the
+// (potentially expensive) query planning can be skipped for queries that are
+// sent again and again, typically from the same template. The key is the query
+// string with insignificant whitespace and comments removed, together with the
+// dataset of the query.
+//
+// A cached plan is only valid for the snapshot of the delta triples it was
+// planned for: the operations contain the metadata of the blocks that have to
+// be scanned (including the located triples) and the size estimates. A plan
+// is therefore never returned for a query with a different snapshot.
+//
+// NOTE: The cache can not be used for queries whose plan depends on anything
+// besides the query and the index, in particular the results from the
+// `NamedResultCache` or (with `zero-cost-estimate-for-cached-subtree`) the
+// contents of the result cache, see `isCacheable`. It also has to be cleared
+// when the runtime parameters that influence the query planning change. The
+// stored plans don't keep any results of the result cache alive.
+class QueryPlanCache {
+ public:
+  // A plan that was cloned from the cache for a particular query.
+  struct CachedPlan {
+    ParsedQuery parsedQuery_;
+    QueryExecutionTree queryExecutionTree_;
+  };
+
+  // The statistics that are reported by the `cache-stats` command.
+  struct Statistics {
+    size_t numHits_;
+    size_t numMisses_;
+    size_t numEntries_;
+  };
+
+ private:
+  // A plan in the cache. The `queryExecutionTree_` is detached from any
+  // `QueryExecutionContext` (which belongs to a single request) and is only
+  // attached to the context of the current request while it is cloned in
+  // `get`. The plan itself is never executed. The `snapshot_` of the delta
+  // triples is kept alive, as the operations refer to its block metadata.
+  struct Plan {
+    SharedLocatedTriplesSnapshot snapshot_;
+    ParsedQuery parsedQuery_;
+    std::shared_ptr<QueryExecutionTree> queryExecutionTree_;
+  };
+
+  // Each plan counts as a single byte, the size of the cache is only limited
+  // by the number of entries.
+  struct PlanSizeGetter {
+    ad_utility::MemorySize operator()(const Plan&) const {
+      return ad_utility::MemorySize::bytes(1);
+    }
+  };
+
+  using Cache =
+      ad_utility::HeapBasedLRUCache<std::string, Plan, PlanSizeGetter>;
+  ad_utility::Synchronized<Cache> cache_;
+  std::atomic<size_t> maxNumEntries_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+
+ public:
+  // Create a cache that holds at most `maxNumEntries` plans. A `maxNumEntries`
+  // of zero disables the cache.
+  explicit QueryPlanCache(size_t maxNumEntries);
+
+  // Return the key for the (not yet planned) `query`.
+  static std::string makeKey(const ParsedQuery& query);
+
+  // Return the `query` with all comments removed and each sequence of
+  // whitespace outside of string literals and IRIs replaced by a single space.
+  static std::string normalizeQueryString(std::string_view query);
+
+  // Return true iff the plan `tree` of the `query` may be stored in the cache.
+  static bool isCacheable(const ParsedQuery& query,
+                          const QueryExecutionTree& tree);
+
+  // Return a clone of the plan for the `key`, the operations of which use the
+  // `qec`, or `std::nullopt` if there is no plan for the snapshot of the `qec`.
+  // Also update the hit and miss counters.
+  std::optional<CachedPlan> get(const std::string& key,
+                                QueryExecutionContext& qec);
+
+  // Store a clone of the plan (the `parsedQuery` after the planning and the
+  // `tree`) of the query with the `key` that was planned with the `qec`. The
+  // `qec` is not stored. Do nothing if the cache is disabled or the plan is
+  // not cacheable.
+  void insert(const std::string& key, const ParsedQuery& parsedQuery,
+              const QueryExecutionTree& tree,
+              const QueryExecutionContext& qec);
+
+  // Change the maximal number of plans. Entries are evicted immediately if
+  // required.
+  void setMaxNumEntries(size_t maxNumEntries);
+
+  // Remove all entries. The hit and miss counters are kept.
+  void clear();
+
+  Statistics getStatistics() const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
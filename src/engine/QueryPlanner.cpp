@@ -28,8 +28,10 @@
 #include "engine/Filter.h"
 #include "engine/GroupBy.h"
 #include "engine/HasPredicateScan.h"
+#include "engine/HashJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
+#include "engine/JoinHelpers.h"
 #include "engine/Load.h"
 #include "engine/Minus.h"
 #include "engine/MultiColumnJoin.h"
@@ -43,6 +45,7 @@
 #include "engine/QueryRewriteUtils.h"
 #include "engine/Service.h"
 #include "engine/Sort.h"
+#include "engine/SpatialIndexScan.h"
 #include "engine/SpatialJoin.h"
 #include "engine/TextIndexScanForEntity.h"
 #include "engine/TextIndexScanForWord.h"
@@ -2239,11 +2242,55 @@ std::vector<SubtreePlan> QueryPlanner::createJoinCandidates(
   SubtreePlan plan =
       makeSubtreePlan<Join>(_qec, a._qet, b._qet, jcs[0][0], jcs[0][1]);
   mergeSubtreePlanIds(plan, a, b);
+
+  // If the `Join` has to sort both of its inputs, a `HashJoin` might be
+  // cheaper, the decision is made based on the cost estimates.
+  if (auto opt = createHashJoinIfSuitable(a, b, jcs, plan)) {
+    candidates.push_back(std::move(opt.value()));
+  }
   candidates.push_back(std::move(plan));
 
   return candidates;
 }
 
+// _____________________________________________________________________________
+std::optional<SubtreePlan> QueryPlanner::createHashJoinIfSuitable(
+    const SubtreePlan& a, const SubtreePlan& b, const JoinColumns& jcs,
+    const SubtreePlan& mergeJoin) const {
+  AD_CORRECTNESS_CHECK(jcs.size() == 1);
+  if (!getRuntimeParameter<&RuntimeParameters::hashJoinEnabled_>()) {
+    return std::nullopt;
+  }
+  // The `HashJoin` doesn't support UNDEF values in the join column.
+  if (!qlever::joinHelpers::joinColumnsAreAlwaysDefined(jcs, a._qet, b._qet)) {
+    return std::nullopt;
+  }
+  // Only consider the `HashJoin` if neither of the inputs is sorted on the join
+  // column and both inputs would have to be sorted by an explicit `Sort` for
+  // the `mergeJoin` (some operations, like `IndexScan`s or `Union`s, can
+  // provide a sorted result much more cheaply).
+  auto isSortedOnJoinColumn = [](const SubtreePlan& plan, ColumnIndex col) {
+    return plan._qet->getRootOperation()->isSortedBy({col});
+  };
+  if (isSortedOnJoinColumn(a, jcs[0][0]) ||
+      isSortedOnJoinColumn(b, jcs[0][1])) {
+    return std::nullopt;
+  }
+  auto inputsOfMergeJoin = mergeJoin._qet->getRootOperation()->getChildren();
+  bool bothInputsNeedSort = ql::ranges::all_of(
+      inputsOfMergeJoin, [](const QueryExecutionTree* child) {
+        return dynamic_cast<const Sort*>(child->getRootOperation().get()) !=
+               nullptr;
+      });
+  if (!bothInputsNeedSort) {
+    return std::nullopt;
+  }
+  SubtreePlan plan =
+      makeSubtreePlan<HashJoin>(_qec, a._qet, b._qet, jcs[0][0], jcs[0][1]);
+  mergeSubtreePlanIds(plan, a, b);
+  return plan;
+}
+
 // _____________________________________________________________________________
 std::pair<bool, bool> QueryPlanner::checkSpatialJoin(const SubtreePlan& a,
                                                      const SubtreePlan& b) {
@@ -3138,6 +3185,13 @@ void QueryPlanner::GraphPatternPlanner::visitPathSearch(
 // _______________________________________________________________
 void QueryPlanner::GraphPatternPlanner::visitSpatialSearch(
     parsedQuery::SpatialQuery& spatialQuery) {
+  if (spatialQuery.isSpatialIndexScan()) {
+    visitGroupOptionalOrMinus({makeSubtreePlan<SpatialIndexScan>(
+        qec_, spatialQuery.left_.value(),
+        SpatialIndex::Box::fromBoundingBox(
+            spatialQuery.boundingBox_.value()))});
+    return;
+  }
   auto config = spatialQuery.toSpatialJoinConfiguration();
 
   // If there is no child graph pattern, we need to construct a neutral element
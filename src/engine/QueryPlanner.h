@@ -437,6 +437,15 @@ class QueryPlanner {
   static std::optional<SubtreePlan> createJoinWithPathSearch(
       const SubtreePlan& a, const SubtreePlan& b, const JoinColumns& jcs);
 
+  // Used internally by `createJoinCandidates`. The `mergeJoin` has to be the
+  // regular `Join` of `a` and `b` on the single join column `jcs`. If this
+  // `mergeJoin` has to explicitly sort both of its inputs, and the join columns
+  // are guaranteed to not contain UNDEF values, then return a `HashJoin` of `a`
+  // and `b`, which doesn't require sorted inputs. Else return `std::nullopt`.
+  std::optional<SubtreePlan> createHashJoinIfSuitable(
+      const SubtreePlan& a, const SubtreePlan& b, const JoinColumns& jcs,
+      const SubtreePlan& mergeJoin) const;
+
   // Helper that returns `true` for each of the subtree plans `a` and `b` iff
   // the subtree plan is a spatial join and it is not yet fully constructed
   // (it does not have both children set)
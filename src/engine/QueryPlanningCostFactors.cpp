@@ -26,6 +26,33 @@ QueryPlanningCostFactors::QueryPlanningCostFactors() : _factors() {
   // Assume that a random disk seek is 100 times more expensive than an
   // average `O(1)` access to a single ID.
   _factors["DISK_RANDOM_ACCESS_COST"] = 100;
+
+  // The cost of inserting a single row into the hash map of a `HashJoin`, and
+  // of probing the hash map with a single row of the other input, relative to
+  // the cost of a single step of a merge join (about 7ns, like a single step
+  // of a `Sort`). If the build side has more than
+  // `HashJoin::NUM_BUILD_ROWS_IN_CPU_CACHE` rows, the hash map doesn't fit
+  // into the CPU cache anymore, and each insertion and lookup additionally
+  // costs `HASH_JOIN_CACHE_MISS_COST` times the binary logarithm of the excess
+  // factor. The `HASH_JOIN_FIXED_COST` makes sure that the `HashJoin` (the
+  // result of which is not sorted) is not chosen for small inputs, for which
+  // the sort is cheap anyway.
+  //
+  // With these values the `HashJoin` is chosen for inputs of very different
+  // sizes (where sorting the larger input dominates) and for medium-sized
+  // inputs, but not when both inputs have millions of rows (where the sort and
+  // merge join is expected to be faster because of the cache misses of the
+  // hash map).
+  _factors["HASH_JOIN_BUILD_COST"] = 15.0;
+  _factors["HASH_JOIN_PROBE_COST"] = 2.0;
+  _factors["HASH_JOIN_CACHE_MISS_COST"] = 3.0;
+  _factors["HASH_JOIN_FIXED_COST"] = 10'000;
+
+  // The cost of parsing a geometry for a spatial join and inserting it into an
+  // r-tree, relative to the cost of looking up a candidate from the prebuilt
+  // `SpatialIndex` in the joined table (see `usePrebuiltSpatialIndex` in
+  // `SpatialJoinAlgorithms`).
+  _factors["SPATIAL_INDEX_ROW_COST"] = 100.0;
 }
 
 // _____________________________________________________________________________
@@ -221,7 +221,8 @@ void to_json(nlohmann::ordered_json& j, const RuntimeInformation& rti) {
 void to_json(nlohmann::ordered_json& j,
              const RuntimeInformationWholeQuery& rti) {
   j = nlohmann::ordered_json{
-      {"time_query_planning", rti.timeQueryPlanning.count()}};
+      {"time_query_planning", rti.timeQueryPlanning.count()},
+      {"time_admission_queue", rti.timeAdmissionQueue.count()}};
 }
 
 // __________________________________________________________________________
@@ -148,6 +148,9 @@ struct RuntimeInformationWholeQuery {
   // The time spent during query planning (this does not include the time spent
   // on `IndexScan`s that were executed during the query planning).
   std::chrono::milliseconds timeQueryPlanning = RuntimeInformation::ZERO;
+  // The time the query waited for its admission after the query planning, see
+  // `QueryAdmissionController`.
+  std::chrono::milliseconds timeAdmissionQueue = RuntimeInformation::ZERO;
   /// Output as json. The signature of this function is mandated by the json
   /// library to allow for implicit conversion.
   friend void to_json(nlohmann::ordered_json& j,
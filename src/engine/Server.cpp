@@ -24,6 +24,7 @@
 #include "engine/QueryPlanner.h"
 #include "engine/SparqlProtocol.h"
 #include "global/RuntimeParameters.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/IndexImpl.h"
 #include "parser/SparqlParser.h"
 #include "util/AsioHelpers.h"
@@ -52,9 +53,15 @@ Server::Server(unsigned short port, size_t numThreads,
       accessToken_(std::move(accessToken)),
       allocator_{ad_utility::makeAllocationMemoryLeftThreadsafeObject(maxMem),
                  [this](ad_utility::MemorySize numMemoryToAllocate) {
+                   // The results that wait to be written to disk are dropped,
+                   // s.t. their memory is freed.
+                   if (diskResultCache_ != nullptr) {
+                     diskResultCache_->dropPendingWrites();
+                   }
                    cache_.makeRoomAsMuchAsPossible(MAKE_ROOM_SLACK_FACTOR *
                                                    numMemoryToAllocate);
                  }},
+      admissionController_{maxMem},
       index_{allocator_},
       enablePatternTrick_(usePatternTrick),
       // The number of server threads currently also is the number of queries
@@ -70,6 +77,17 @@ Server::Server(unsigned short port, size_t numThreads,
       [this](ad_utility::MemorySize newValue) {
         cache_.setMaxSizeSingleEntry(newValue);
       });
+  globalRuntimeParameters.wlock()
+      ->queryPlanCacheMaxNumEntries_.setOnUpdateAction(
+          [this](size_t newValue) {
+            queryPlanCache_.setMaxNumEntries(newValue);
+          });
+  globalRuntimeParameters.wlock()->diskResultCacheMaxSize_.setOnUpdateAction(
+      [this](ad_utility::MemorySize newValue) {
+        if (diskResultCache_ != nullptr) {
+          diskResultCache_->setMaxSize(newValue);
+        }
+      });
 }
 
 // __________________________________________________________________________
@@ -87,6 +105,23 @@ void Server::initialize(const std::string& indexBaseName, bool useText,
     index_.addTextFromOnDiskIndex();
   }
 
+  if (!diskResultCacheDirectory_.empty()) {
+    diskResultCache_ = std::make_unique<DiskResultCache>(
+        index_, diskResultCacheDirectory_,
+        getRuntimeParameter<&RuntimeParameters::diskResultCacheMaxSize_>());
+    // Results that are evicted from the cache in RAM are demoted to disk.
+    cache_.setEvictionCallback(
+        [diskResultCache = diskResultCache_.get()](
+            const QueryCacheKey& key,
+            const std::shared_ptr<const CacheValue>& value) {
+          diskResultCache->store(key, value);
+        });
+    AD_LOG_INFO << "Using the disk result cache in \""
+                << diskResultCacheDirectory_ << "\" with "
+                << diskResultCache_->getStatistics().numEntries_
+                << " results from previous runs" << std::endl;
+  }
+
   sortPerformanceEstimator_.computeEstimatesExpensively(
       allocator_, index_.numTriples().normalAndInternal_() *
                       PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100);
@@ -292,6 +327,7 @@ auto Server::prepareOperation(
   QueryExecutionContext qec(index_, &cache_, allocator_,
                             sortPerformanceEstimator_, &namedResultCache_,
                             std::ref(messageSender), pinSubtrees, pinResult);
+  qec.setDiskResultCache(diskResultCache_.get());
 
   configurePinnedResultWithName(pinResultWithName, accessTokenOk, qec);
   return std::tuple{std::move(qec), std::move(cancellationHandle),
@@ -380,11 +416,19 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   } else if (auto cmd = checkParameter("cmd", "clear-cache")) {
     logCommand(cmd, "clear the cache (unpinned elements only)");
     cache_.clearUnpinnedOnly();
+    // The cached plans are also state from previous queries, which a client
+    // that clears the cache (e.g. for benchmarking) expects to be gone.
+    queryPlanCache_.clear();
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "clear-cache-complete")) {
     requireValidAccessToken("clear-cache-complete");
     logCommand(cmd, "clear cache completely (including unpinned elements)");
     cache_.clearAll();
+    DecompressedBlockCache::global().clear();
+    queryPlanCache_.clear();
+    if (diskResultCache_ != nullptr) {
+      diskResultCache_->clear();
+    }
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "clear-named-cache")) {
     requireValidAccessToken("clear-named-cache");
@@ -471,6 +515,8 @@ CPP_template_def(typename RequestT, typename ResponseT)(
                   << " to value \"" << value.value() << "\"" << std::endl;
       globalRuntimeParameters.wlock()->setFromString(
           key, std::string{value.value()});
+      // The plans might depend on the parameter (e.g. the planning budget).
+      queryPlanCache_.clear();
       response = createJsonResponse(
           json(globalRuntimeParameters.rlock()->toMap()), request);
     }
@@ -609,9 +655,27 @@ Server::PlannedQuery Server::planQuery(
     ParsedQuery&& operation, const ad_utility::Timer& requestTimer,
     TimeLimit timeLimit, QueryExecutionContext& qec,
     ad_utility::SharedCancellationHandle handle) const {
-  QueryPlanner qp(&qec, handle);
-  auto executionTree = qp.createExecutionTree(operation);
-  PlannedQuery plannedQuery{std::move(operation), std::move(executionTree)};
+  // Updates are never cached, as they are only planned once anyway.
+  std::optional<std::string> planCacheKey;
+  std::optional<QueryPlanCache::CachedPlan> cachedPlan;
+  if (!operation.hasUpdateClause()) {
+    planCacheKey = QueryPlanCache::makeKey(operation);
+    cachedPlan = queryPlanCache_.get(planCacheKey.value(), qec);
+  }
+  auto plannedQuery = [&]() -> PlannedQuery {
+    if (cachedPlan.has_value()) {
+      AD_LOG_DEBUG << "Using the cached plan for the query" << std::endl;
+      return {std::move(cachedPlan->parsedQuery_),
+              std::move(cachedPlan->queryExecutionTree_)};
+    }
+    QueryPlanner qp(&qec, handle);
+    auto executionTree = qp.createExecutionTree(operation);
+    if (planCacheKey.has_value()) {
+      queryPlanCache_.insert(planCacheKey.value(), operation, executionTree,
+                             qec);
+    }
+    return {std::move(operation), std::move(executionTree)};
+  }();
   handle->throwIfCancelled();
   // Set some additional attributes on the `PlannedQuery`.
   plannedQuery.queryExecutionTree_.getRootOperation()
@@ -695,6 +759,29 @@ nlohmann::json Server::composeCacheStatsJson() const {
   // converter.
   result["cache-size-unpinned"] = cache_.nonPinnedSize().getBytes();
   result["cache-size-pinned"] = cache_.pinnedSize().getBytes();
+
+  // Statistics of the cache for the decompressed blocks of the permutations.
+  auto blockCacheStats = DecompressedBlockCache::global().getStatistics();
+  result["num-decompressed-blocks-cached"] = blockCacheStats.numEntries_;
+  result["decompressed-block-cache-size"] = blockCacheStats.size_.getBytes();
+  result["decompressed-block-cache-hits"] = blockCacheStats.numHits_;
+  result["decompressed-block-cache-misses"] = blockCacheStats.numMisses_;
+
+  // Statistics of the cache for the query plans.
+  auto planCacheStats = queryPlanCache_.getStatistics();
+  result["num-query-plans-cached"] = planCacheStats.numEntries_;
+  result["query-plan-cache-hits"] = planCacheStats.numHits_;
+  result["query-plan-cache-misses"] = planCacheStats.numMisses_;
+
+  // Statistics of the second tier of the result cache on disk.
+  if (diskResultCache_ != nullptr) {
+    auto diskCacheStats = diskResultCache_->getStatistics();
+    result["num-results-on-disk"] = diskCacheStats.numEntries_;
+    result["disk-result-cache-size"] = diskCacheStats.size_.getBytes();
+    result["disk-result-cache-hits"] = diskCacheStats.numHits_;
+    result["disk-result-cache-misses"] = diskCacheStats.numMisses_;
+    result["disk-result-cache-writes"] = diskCacheStats.numWrites_;
+  }
   return result;
 }
 
@@ -831,7 +918,8 @@ ad_utility::MediaType Server::chooseBestFittingMediaType(
         std::array supportedMediaTypes{
             MediaType::octetStream, MediaType::csv,
             MediaType::tsv,         MediaType::qleverJson,
-            MediaType::sparqlXml,   MediaType::sparqlJson};
+            MediaType::sparqlXml,   MediaType::sparqlJson,
+            MediaType::arrowStream};
         return ad_utility::contains(supportedMediaTypes, mediaType);
       }
       std::array supportedMediaTypes{MediaType::csv, MediaType::tsv,
@@ -894,6 +982,24 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   // offset is not applied twice when exporting the query.
   adjustParsedQueryLimitOffset(plannedQuery.value(), mediaType, params);
 
+  // Reserve the estimated memory of the query before it is executed. The
+  // reservation is released when the complete result has been sent.
+  QueryAdmissionController::Ticket admissionTicket;
+  if (getRuntimeParameter<
+          &RuntimeParameters::queryAdmissionControlEnabled_>()) {
+    auto lane = QueryAdmissionController::laneFromString(
+        ad_utility::url_parser::checkParameter(params, "priority", std::nullopt)
+            .value_or("interactive"));
+    ad_utility::Timer queueTimer{ad_utility::Timer::Started};
+    auto memoryEstimate = QueryAdmissionController::estimateMemory(
+        qet.getSizeEstimate(), qet.getResultWidth());
+    auto admission =
+        waitForAdmission(lane, memoryEstimate, cancellationHandle);
+    admissionTicket = co_await std::move(admission);
+    qet.getRootOperation()->getRuntimeInfoWholeQuery().timeAdmissionQueue =
+        queueTimer.msecs();
+  }
+
   // This actually processes the query and sends the result in the
   // requested format.
   co_await sendStreamableResponse(request, AD_FWD(send), mediaType,
@@ -986,6 +1092,9 @@ UpdateMetadata Server::processUpdateImpl(
   // part of the cache key).
   cache_.clearAll();
   namedResultCache_.clear();
+  // The cached plans are only valid for the previous snapshot, but would keep
+  // it alive.
+  queryPlanCache_.clear();
   tracer.endTrace("clearCache");
 
   return updateMetadata;
@@ -1206,6 +1315,36 @@ Awaitable<T> Server::computeInNewThread(net::static_thread_pool& threadPool,
       std::move(handle), std::move(cancelTimerPromise));
 }
 
+// _____________________________________________________________________________
+Awaitable<QueryAdmissionController::Ticket> Server::waitForAdmission(
+    QueryAdmissionController::Lane lane, ad_utility::MemorySize memoryEstimate,
+    SharedCancellationHandle handle) {
+  size_t maxQueueSize =
+      getRuntimeParameter<&RuntimeParameters::queryAdmissionMaxQueueSize_>();
+  std::chrono::seconds maxWaitTime =
+      getRuntimeParameter<&RuntimeParameters::queryAdmissionMaxWaitTime_>();
+  auto entry = admissionController_.enqueue(lane, memoryEstimate, maxQueueSize);
+  // The controller never blocks, so we poll it with a timer. This doesn't
+  // block a thread while the query is waiting.
+  static constexpr auto pollInterval = std::chrono::milliseconds{10};
+  net::steady_timer timer{co_await net::this_coro::executor};
+  ad_utility::Timer waitTimer{ad_utility::Timer::Started};
+  while (true) {
+    if (auto ticket = admissionController_.tryAdmit(entry)) {
+      co_return std::move(ticket.value());
+    }
+    handle->throwIfCancelled();
+    if (waitTimer.msecs() > maxWaitTime) {
+      throw std::runtime_error{absl::StrCat(
+          "The query could not be executed within ", maxWaitTime.count(),
+          " seconds, because too many other queries are currently executed. "
+          "Please try again later")};
+    }
+    timer.expires_after(pollInterval);
+    co_await timer.async_wait(net::use_awaitable);
+  }
+}
+
 // _____________________________________________________________________________
 bool Server::checkAccessToken(
     std::optional<std::string_view> accessToken) const {
@@ -13,10 +13,13 @@
 #include <vector>
 
 #include "ExecuteUpdate.h"
+#include "engine/DiskResultCache.h"
 #include "engine/Engine.h"
 #include "engine/NamedResultCache.h"
+#include "engine/QueryAdmissionController.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanCache.h"
 #include "engine/SortPerformanceEstimator.h"
 #include "index/Index.h"
 #include "util/AllocatorWithLimit.h"
@@ -63,6 +66,13 @@ class Server {
            bool usePatterns = true, bool loadAllPermutations = true,
            bool persistUpdates = false);
 
+  // Use the `directory` for the second tier of the result cache on disk (see
+  // `DiskResultCache.h`). Has to be called before `run`. By default, there is
+  // no such tier.
+  void setDiskResultCacheDirectory(std::string directory) {
+    diskResultCacheDirectory_ = std::move(directory);
+  }
+
   Index& index() { return index_; }
   const Index& index() const { return index_; }
 
@@ -82,9 +92,20 @@ class Server {
   std::string accessToken_;
   QueryResultCache cache_;
   NamedResultCache namedResultCache_;
+  // The plans of recently planned queries. The size is set from the runtime
+  // parameter `query-plan-cache-max-num-entries` in the constructor.
+  mutable QueryPlanCache queryPlanCache_{0};
   ad_utility::AllocatorWithLimit<Id> allocator_;
+  // Decides when a planned query may be executed, based on the estimated
+  // memory of all the queries that are currently executed.
+  QueryAdmissionController admissionController_;
   SortPerformanceEstimator sortPerformanceEstimator_;
   Index index_;
+  // The second tier of the `cache_` on disk, which is created in `initialize`
+  // if the `diskResultCacheDirectory_` is not empty. It is declared after the
+  // `index_` because it refers to it.
+  std::string diskResultCacheDirectory_;
+  std::unique_ptr<DiskResultCache> diskResultCache_;
   ad_utility::websocket::QueryRegistry queryRegistry_{};
 
   bool enablePatternTrick_;
@@ -251,6 +272,14 @@ class Server {
                                   Function function,
                                   SharedCancellationHandle handle);
 
+  // Wait until the `admissionController_` admits the execution of a query with
+  // the given `memoryEstimate` in the given `lane`. Throws if the `handle` is
+  // cancelled, if too many queries are already waiting, or if the wait time
+  // exceeds the runtime parameter `query-admission-max-wait-time`.
+  Awaitable<QueryAdmissionController::Ticket> waitForAdmission(
+      QueryAdmissionController::Lane lane,
+      ad_utility::MemorySize memoryEstimate, SharedCancellationHandle handle);
+
   /// This method extracts a client-defined query id from the passed HTTP
   /// request if it is present. If it is not present or empty, a new
   /// pseudo-random id will be chosen by the server. Note that this id is not
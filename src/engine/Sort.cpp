@@ -9,9 +9,27 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/Engine.h"
+#include "engine/ExternalSort.h"
 #include "engine/QueryExecutionTree.h"
 #include "global/RuntimeParameters.h"
 
+namespace {
+// Compare rows by the internal order of the IDs in the `sortColumns_`. Used
+// for the external sort.
+struct CompareByColumns {
+  std::vector<ColumnIndex> sortColumns_;
+  template <typename Row1, typename Row2>
+  bool operator()(const Row1& row1, const Row2& row2) const {
+    for (auto col : sortColumns_) {
+      if (row1[col] != row2[col]) {
+        return row1[col] < row2[col];
+      }
+    }
+    return false;
+  }
+};
+}  // namespace
+
 // _____________________________________________________________________________
 size_t Sort::getResultWidth() const { return subtree_->getResultWidth(); }
 
@@ -51,8 +69,12 @@ std::string Sort::getDescriptor() const {
 }
 
 // _____________________________________________________________________________
-Result Sort::computeResult([[maybe_unused]] bool requestLaziness) {
+Result Sort::computeResult(bool requestLaziness) {
   using std::endl;
+  if (auto memory = qlever::externalSort::getMemoryForExternalSort(
+          *subtree_, allocator(), requestLaziness)) {
+    return computeResultExternally(memory.value());
+  }
   AD_LOG_DEBUG << "Getting sub-result for Sort result computation..." << endl;
   std::shared_ptr<const Result> subRes = subtree_->getResult();
 
@@ -75,6 +97,18 @@ Result Sort::computeResult([[maybe_unused]] bool requestLaziness) {
   return {std::move(idTable), resultSortedOn(), subRes->getSharedLocalVocab()};
 }
 
+// _____________________________________________________________________________
+Result Sort::computeResultExternally(ad_utility::MemorySize memory) {
+  AD_LOG_DEBUG << "Sort result computation using an external sort..."
+               << std::endl;
+  runtimeInfo().addDetail("external-sort-memory", memory.asString());
+  return qlever::externalSort::sortExternally(
+      subtree_->getResult(true), getResultWidth(),
+      CompareByColumns{sortColumnIndices_}, resultSortedOn(),
+      qlever::externalSort::makeFilenameForExternalSort(), memory, allocator(),
+      cancellationHandle_);
+}
+
 // _____________________________________________________________________________
 std::optional<std::shared_ptr<QueryExecutionTree>> Sort::makeSortedTree(
     const std::vector<ColumnIndex>& sortColumns) const {
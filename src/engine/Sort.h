@@ -75,7 +75,12 @@ class Sort : public Operation {
  private:
   std::unique_ptr<Operation> cloneImpl() const override;
 
-  virtual Result computeResult([[maybe_unused]] bool requestLaziness) override;
+  virtual Result computeResult(bool requestLaziness) override;
+
+  // Compute the result using an external merge sort that may use at most
+  // `memory`. This is used if the input is too large to be sorted in RAM, see
+  // `ExternalSort.h`. The result is always lazy.
+  Result computeResultExternally(ad_utility::MemorySize memory);
 
   [[nodiscard]] VariableToColumnMap computeVariableToColumnMap()
       const override {
@@ -0,0 +1,97 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/SpatialIndexScan.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_format.h>
+
+#include <algorithm>
+
+#include "backports/algorithm.h"
+
+// _____________________________________________________________________________
+SpatialIndexScan::SpatialIndexScan(QueryExecutionContext* qec,
+                                   Variable variable, SpatialIndex::Box box)
+    : Operation(qec), variable_{std::move(variable)}, box_{box} {}
+
+// _____________________________________________________________________________
+Result SpatialIndexScan::computeResult([[maybe_unused]] bool requestLaziness) {
+  const auto* spatialIndex = getIndex().getSpatialIndex();
+  if (spatialIndex == nullptr) {
+    throw std::runtime_error(
+        "A spatial index scan requires an index that was built with the "
+        "option `--spatial-index`");
+  }
+  auto geometries = spatialIndex->getIntersecting(box_);
+  checkCancellation();
+  IdTable idTable{1, getExecutionContext()->getAllocator()};
+  idTable.resize(geometries.size());
+  ql::ranges::transform(geometries, idTable.getColumn(0).begin(),
+                        &Id::makeFromVocabIndex);
+  runtimeInfo().addDetail("num-geometries-in-index",
+                          spatialIndex->numGeometries());
+  return {std::move(idTable), resultSortedOn(), LocalVocab{}};
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap SpatialIndexScan::computeVariableToColumnMap() const {
+  return {{variable_, makeAlwaysDefinedColumn(0)}};
+}
+
+// _____________________________________________________________________________
+size_t SpatialIndexScan::getCostEstimate() {
+  return getSizeEstimateBeforeLimit();
+}
+
+// _____________________________________________________________________________
+uint64_t SpatialIndexScan::getSizeEstimateBeforeLimit() {
+  const auto* spatialIndex = getIndex().getSpatialIndex();
+  if (spatialIndex == nullptr || spatialIndex->numGeometries() == 0) {
+    return 0;
+  }
+  // Assume that the geometries are uniformly distributed over the world. The
+  // estimate is at least one, because the result is only known to be empty
+  // if there are no geometries at all.
+  double fraction = (box_.maxLng_ - box_.minLng_) *
+                    (box_.maxLat_ - box_.minLat_) / (360.0 * 180.0);
+  auto estimate = static_cast<uint64_t>(
+      std::clamp(fraction, 0.0, 1.0) *
+      static_cast<double>(spatialIndex->numGeometries()));
+  return std::max(estimate, uint64_t{1});
+}
+
+// _____________________________________________________________________________
+bool SpatialIndexScan::knownEmptyResult() {
+  // Without a spatial index, the result is not known to be empty, because
+  // `computeResult` has to report the missing index.
+  const auto* spatialIndex = getIndex().getSpatialIndex();
+  return spatialIndex != nullptr && spatialIndex->numGeometries() == 0;
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> SpatialIndexScan::resultSortedOn() const {
+  return {ColumnIndex{0}};
+}
+
+// _____________________________________________________________________________
+std::string SpatialIndexScan::getDescriptor() const {
+  return absl::StrCat("SpatialIndexScan on ", variable_.name());
+}
+
+// _____________________________________________________________________________
+std::string SpatialIndexScan::getCacheKeyImpl() const {
+  // `absl::StrCat` only keeps six significant digits of a `double`, so boxes
+  // that differ in later digits would get the same cache key. With 17
+  // significant digits, the coordinates are represented exactly.
+  return absl::StrFormat("SPATIAL INDEX SCAN: %.17g %.17g %.17g %.17g",
+                         box_.minLng_, box_.minLat_, box_.maxLng_,
+                         box_.maxLat_);
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> SpatialIndexScan::cloneImpl() const {
+  return std::make_unique<SpatialIndexScan>(*this);
+}
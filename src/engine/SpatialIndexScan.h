@@ -0,0 +1,56 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_SPATIALINDEXSCAN_H
+#define QLEVER_SRC_ENGINE_SPATIALINDEXSCAN_H
+
+#include "engine/Operation.h"
+#include "index/SpatialIndex.h"
+
+// This operation retrieves all geometries (WKT literals from the vocabulary)
+// whose bounding box intersects a given box from the prebuilt `SpatialIndex`.
+// The result has a single column, which is sorted. It is created by the query
+// planner for a spatial search with the `<boundingBox>` parameter, see
+// `parsedQuery::SpatialQuery`. Note that points which are folded into the `Id`
+// are not contained in the `SpatialIndex` and thus never part of the result.
+class SpatialIndexScan : public Operation {
+ private:
+  Variable variable_;
+  SpatialIndex::Box box_;
+
+ public:
+  SpatialIndexScan(QueryExecutionContext* qec, Variable variable,
+                   SpatialIndex::Box box);
+
+  const Variable& variable() const { return variable_; }
+  const SpatialIndex::Box& box() const { return box_; }
+
+  std::string getCacheKeyImpl() const override;
+
+  std::string getDescriptor() const override;
+
+  size_t getResultWidth() const override { return 1; }
+
+  size_t getCostEstimate() override;
+
+  uint64_t getSizeEstimateBeforeLimit() override;
+
+  float getMultiplicity(size_t) override { return 1; }
+
+  bool knownEmptyResult() override;
+
+  std::vector<ColumnIndex> resultSortedOn() const override;
+
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+ private:
+  std::unique_ptr<Operation> cloneImpl() const override;
+
+  Result computeResult([[maybe_unused]] bool requestLaziness) override;
+
+  std::vector<QueryExecutionTree*> getChildren() override { return {}; }
+};
+
+#endif  // QLEVER_SRC_ENGINE_SPATIALINDEXSCAN_H
@@ -10,6 +10,7 @@
 
 #include <absl/container/flat_hash_set.h>
 #include <absl/strings/charconv.h>
+#include <absl/strings/str_format.h>
 
 #include <cstdint>
 #include <limits>
@@ -133,7 +134,9 @@ std::string SpatialJoin::getCacheKeyImpl() const {
     // Task
     auto maxDist = getMaxDist();
     if (maxDist.has_value()) {
-      os << "maxDist: " << maxDist.value() << "\n";
+      // Write the distance exactly (by default, an `std::ostream` only writes
+      // six significant digits, so close distances would share a cache key).
+      os << "maxDist: " << absl::StrFormat("%.17g", maxDist.value()) << "\n";
     }
     auto maxResults = getMaxResults();
     if (maxResults.has_value()) {
@@ -22,9 +22,11 @@
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/SpatialJoin.h"
 #include "global/RuntimeParameters.h"
+#include "index/SpatialIndex.h"
 #include "rdfTypes/GeometryInfoHelpersImpl.h"
 #include "util/Exception.h"
 #include "util/GeoSparqlHelpers.h"
+#include "util/HashMap.h"
 
 using namespace BoostGeometryNamespace;
 
@@ -91,6 +93,18 @@ std::pair<util::geo::I32Box, size_t> SpatialJoinAlgorithms::libspatialjoinParse(
         "prefilter-disabled-by-bounding-box-area", true);
   }
 
+  // If there is a prebuilt `SpatialIndex`, the geometries that intersect the
+  // prefilter box are retrieved at once, instead of reading the bounding box
+  // of each geometry separately.
+  std::optional<std::vector<VocabIndex>> geometriesInPrefilterBox;
+  const auto* spatialIndex = qec_->getIndex().getSpatialIndex();
+  if (usePrefiltering && spatialIndex != nullptr) {
+    const auto& box = prefilterLatLngBox.value();
+    geometriesInPrefilterBox = spatialIndex->getIntersecting(
+        {box.getLowerLeft().getX(), box.getLowerLeft().getY(),
+         box.getUpperRight().getX(), box.getUpperRight().getY()});
+  }
+
   // Iterate over all rows in `idTable` and parse the geometries from `column`.
   for (size_t row = 0; row < idTable->size(); row++) {
     throwIfCancelled();
@@ -100,8 +114,12 @@ std::pair<util::geo::I32Box, size_t> SpatialJoinAlgorithms::libspatialjoinParse(
       // If we have a prefilter box, check if we also have a precomputed
       // bounding box for the geometry this `VocabIndex` is referring to.
       if (usePrefiltering &&
-          prefilterGeoByBoundingBox(prefilterLatLngBox, qec_->getIndex(),
-                                    id.getVocabIndex())) {
+          (geometriesInPrefilterBox.has_value()
+               ? !ql::ranges::binary_search(geometriesInPrefilterBox.value(),
+                                            id.getVocabIndex())
+               : prefilterGeoByBoundingBox(prefilterLatLngBox,
+                                           qec_->getIndex(),
+                                           id.getVocabIndex()))) {
         prefilterCounter++;
         continue;
       }
@@ -168,6 +186,29 @@ std::optional<GeoPoint> SpatialJoinAlgorithms::getPoint(const IdTable* restable,
              : std::nullopt;
 };
 
+// ____________________________________________________________________________
+bool SpatialJoinAlgorithms::containsNonPointGeometry(
+    const IdTable* idTable, ColumnIndex col,
+    const LocalVocab& localVocab) const {
+  const auto& index = qec_->getIndex();
+  bool hasGeoInfo = index.getVocab().isGeoInfoAvailable();
+  return ql::ranges::any_of(idTable->getColumn(col), [&](Id id) {
+    auto datatype = id.getDatatype();
+    if (datatype == Datatype::VocabIndex && hasGeoInfo) {
+      return index.getVocab().getGeoInfo(id.getVocabIndex()).has_value();
+    }
+    if (datatype != Datatype::VocabIndex &&
+        datatype != Datatype::LocalVocabIndex) {
+      return false;
+    }
+    auto word =
+        ExportQueryExecutionTrees::idToLiteralOrIri(index, id, localVocab);
+    return word.has_value() && word.value().isLiteral() &&
+           word.value().hasDatatype() &&
+           asStringViewUnsafe(word.value().getDatatype()) == GEO_WKT_LITERAL;
+  });
+}
+
 // ____________________________________________________________________________
 std::string_view SpatialJoinAlgorithms::betweenQuotes(
     std::string_view extractFrom) const {
@@ -543,6 +584,23 @@ Result SpatialJoinAlgorithms::S2geometryAlgorithm() {
   const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
               rightJoinCol, rightSelectedCols, numColumns, maxDist, maxResults,
               joinType] = params_;
+
+  // The S2 algorithm only supports points, all the other geometries are
+  // skipped. A maximum distance join with other geometries is thus computed by
+  // the bounding box algorithm, using the exact distance of the geometries.
+  if (!maxResults.has_value() && maxDist.has_value() &&
+      (containsNonPointGeometry(idTableLeft, leftJoinCol,
+                                resultLeft->localVocab()) ||
+       containsNonPointGeometry(idTableRight, rightJoinCol,
+                                resultRight->localVocab()))) {
+    if (spatialJoin_.has_value()) {
+      spatialJoin_.value()->runtimeInfo().addDetail("algorithm",
+                                                    "bounding box");
+    }
+    setUseMidpointForAreas_(false);
+    return BoundingBoxAlgorithm();
+  }
+
   IdTable result{numColumns, qec_->getAllocator()};
 
   // Helper function to convert `GeoPoint` to `S2Point`
@@ -871,8 +929,43 @@ std::vector<Box> SpatialJoinAlgorithms::getQueryBox(
   }
 }
 
+// ____________________________________________________________________________
+bool SpatialJoinAlgorithms::usePrebuiltSpatialIndex(
+    size_t numGeometriesInIndex, size_t numIndexedRows, size_t numOtherRows,
+    double costOfIndexingOneRow) {
+  if (numIndexedRows == 0) {
+    return false;
+  }
+  // A query box of the prebuilt index returns about `numGeometriesInIndex /
+  // numIndexedRows` times as many candidates as a query box of an r-tree that
+  // only contains the rows of the table. Each of these candidates is looked up
+  // via a binary search, which is much cheaper than parsing a geometry and
+  // inserting it into an r-tree.
+  double costOfCandidates = static_cast<double>(numOtherRows) *
+                            static_cast<double>(numGeometriesInIndex) /
+                            static_cast<double>(numIndexedRows);
+  return costOfCandidates <=
+         costOfIndexingOneRow * static_cast<double>(numIndexedRows);
+}
+
 // ____________________________________________________________________________
 Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
+  if (const auto* spatialIndex = qec_->getIndex().getSpatialIndex()) {
+    size_t numRowsLeft = params_.idTableLeft_->numRows();
+    size_t numRowsRight = params_.idTableRight_->numRows();
+    if (usePrebuiltSpatialIndex(spatialIndex->numGeometries(),
+                                std::max(numRowsLeft, numRowsRight),
+                                std::min(numRowsLeft, numRowsRight),
+                                qec_->getCostFactor(
+                                    "SPATIAL_INDEX_ROW_COST"))) {
+      return BoundingBoxAlgorithmWithSpatialIndex(*spatialIndex);
+    }
+    if (spatialJoin_.has_value()) {
+      spatialJoin_.value()->runtimeInfo().addDetail("spatial-index",
+                                                    "per-query");
+    }
+  }
+
   // helper struct to avoid duplicate entries for areas
   struct AddedPair {
     size_t rowLeft_;
@@ -973,6 +1066,121 @@ Result SpatialJoinAlgorithms::BoundingBoxAlgorithm() {
   return resTable;
 }
 
+// ____________________________________________________________________________
+Result SpatialJoinAlgorithms::BoundingBoxAlgorithmWithSpatialIndex(
+    const SpatialIndex& spatialIndex) {
+  const auto [idTableLeft, resultLeft, idTableRight, resultRight, leftJoinCol,
+              rightJoinCol, rightSelectedCols, numColumns, maxDist, maxResults,
+              joinType] = params_;
+  IdTable result{numColumns, qec_->getAllocator()};
+  if (spatialJoin_.has_value()) {
+    spatialJoin_.value()->runtimeInfo().addDetail("spatial-index", "prebuilt");
+  }
+
+  // In contrast to `BoundingBoxAlgorithm`, the larger table is the indexed
+  // one, because the geometries from the vocabulary are already contained in
+  // the prebuilt index.
+  bool leftIsIndexed = idTableLeft->numRows() > idTableRight->numRows();
+  auto indexedResult = leftIsIndexed ? idTableLeft : idTableRight;
+  auto indexedResJoinCol = leftIsIndexed ? leftJoinCol : rightJoinCol;
+  auto otherResult = leftIsIndexed ? idTableRight : idTableLeft;
+  auto otherResJoinCol = leftIsIndexed ? rightJoinCol : leftJoinCol;
+
+  // The rows of the indexed table sorted by the `VocabIndex` of their
+  // geometry. The other geometries (in particular, points that are folded into
+  // the `Id`) are not part of the prebuilt index, so they are added to an
+  // r-tree like in `BoundingBoxAlgorithm`.
+  using RowOfGeometry = std::pair<VocabIndex, size_t>;
+  std::vector<RowOfGeometry, ad_utility::AllocatorWithLimit<RowOfGeometry>>
+      rowsByGeometry{qec_->getAllocator()};
+  bgi::rtree<Value, bgi::quadratic<16>, bgi::indexable<Value>,
+             bgi::equal_to<Value>, ad_utility::AllocatorWithLimit<Value>>
+      rtree(bgi::quadratic<16>{}, bgi::indexable<Value>{},
+            bgi::equal_to<Value>{}, qec_->getAllocator());
+  for (size_t i = 0; i < indexedResult->numRows(); i++) {
+    throwIfCancelled();
+    Id id = indexedResult->at(i, indexedResJoinCol);
+    if (id.getDatatype() == Datatype::VocabIndex) {
+      rowsByGeometry.emplace_back(id.getVocabIndex(), i);
+      continue;
+    }
+    std::optional<RtreeEntry> entry =
+        getRtreeEntry(indexedResult, i, indexedResJoinCol);
+    if (entry) {
+      rtree.insert(std::pair(entry.value().boundingBox_.value(),
+                             std::move(entry.value())));
+    }
+  }
+  ql::ranges::sort(rowsByGeometry);
+
+  // The geometries of the indexed table are only parsed when they are a
+  // candidate for the first time.
+  ad_utility::HashMap<size_t, std::optional<RtreeEntry>> indexedEntries;
+  auto getIndexedEntry = [&](size_t row) -> std::optional<RtreeEntry>& {
+    auto it = indexedEntries.find(row);
+    if (it == indexedEntries.end()) {
+      it = indexedEntries
+               .emplace(row,
+                        getRtreeEntry(indexedResult, row, indexedResJoinCol))
+               .first;
+    }
+    return it->second;
+  };
+
+  std::vector<size_t> candidateRows;
+  std::vector<Value, ad_utility::AllocatorWithLimit<Value>> rtreeResults{
+      qec_->getAllocator()};
+  for (size_t i = 0; i < otherResult->numRows(); i++) {
+    throwIfCancelled();
+
+    std::optional<RtreeEntry> entry =
+        getRtreeEntry(otherResult, i, otherResJoinCol);
+    if (!entry) {
+      continue;
+    }
+    candidateRows.clear();
+    rtreeResults.clear();
+    for (const Box& bbox : getQueryBox(entry)) {
+      auto geometries = spatialIndex.getIntersecting(
+          {bbox.min_corner().get<0>(), bbox.min_corner().get<1>(),
+           bbox.max_corner().get<0>(), bbox.max_corner().get<1>()});
+      for (VocabIndex geometry : geometries) {
+        auto rows = ql::ranges::equal_range(rowsByGeometry, geometry,
+                                            std::less{}, &RowOfGeometry::first);
+        for (const RowOfGeometry& rowOfGeometry : rows) {
+          candidateRows.push_back(rowOfGeometry.second);
+        }
+      }
+      rtree.query(bgi::intersects(bbox), std::back_inserter(rtreeResults));
+    }
+    for (const Value& value : rtreeResults) {
+      candidateRows.push_back(value.second.row_);
+    }
+    // The query boxes are disjoint, but the bounding box of an area can
+    // intersect more than one of them.
+    ql::ranges::sort(candidateRows);
+    candidateRows.erase(std::unique(candidateRows.begin(), candidateRows.end()),
+                        candidateRows.end());
+
+    for (size_t row : candidateRows) {
+      auto& indexedEntry = getIndexedEntry(row);
+      if (!indexedEntry) {
+        continue;
+      }
+      auto distance = computeDist(indexedEntry.value(), entry.value());
+      AD_CORRECTNESS_CHECK(distance.getDatatype() == Datatype::Double);
+      if (distance.getDouble() * 1000 <= maxDist.value()) {
+        size_t rowLeft = leftIsIndexed ? row : i;
+        size_t rowRight = leftIsIndexed ? i : row;
+        addResultTableEntry(&result, idTableLeft, idTableRight, rowLeft,
+                            rowRight, distance);
+      }
+    }
+  }
+  return Result(std::move(result), std::vector<ColumnIndex>{},
+                Result::getMergedLocalVocab(*resultLeft, *resultRight));
+}
+
 // ____________________________________________________________________________
 void SpatialJoinAlgorithms::throwIfCancelled() const {
   if (spatialJoin_.has_value()) {
@@ -21,6 +21,8 @@
 #include "engine/SpatialJoin.h"
 #include "util/GeoSparqlHelpers.h"
 
+class SpatialIndex;
+
 namespace BoostGeometryNamespace {
 namespace bg = boost::geometry;
 namespace bgi = boost::geometry::index;
@@ -92,6 +94,26 @@ class SpatialJoinAlgorithms {
   Result BoundingBoxAlgorithm();
   Result LibspatialjoinAlgorithm();
 
+  // Same as `BoundingBoxAlgorithm`, but instead of building an r-tree for one
+  // of the tables, the prebuilt `SpatialIndex` of all geometries of the
+  // vocabulary is probed. This is used by `BoundingBoxAlgorithm` if the index
+  // has a `SpatialIndex` and `usePrebuiltSpatialIndex` returns true, and is
+  // only public for testing.
+  Result BoundingBoxAlgorithmWithSpatialIndex(const SpatialIndex& spatialIndex);
+
+  // Decide whether `BoundingBoxAlgorithm` should probe the prebuilt
+  // `SpatialIndex` with `numGeometriesInIndex` geometries instead of building
+  // an r-tree for the `numIndexedRows` rows of the larger table. Each query box
+  // of the other `numOtherRows` rows also finds the geometries of the index
+  // that are not in the table, so the prebuilt index only pays off if the
+  // table contains a large enough part of them (or if there are only few query
+  // boxes). The `costOfIndexingOneRow` (the cost factor
+  // `SPATIAL_INDEX_ROW_COST`) is relative to the cost of a single candidate.
+  static bool usePrebuiltSpatialIndex(size_t numGeometriesInIndex,
+                                      size_t numIndexedRows,
+                                      size_t numOtherRows,
+                                      double costOfIndexingOneRow);
+
   // This function computes the bounding box(es) which represent all points,
   // which are in reach of the starting point with a distance of at most
   // 'maxDistanceInMeters'. In theory there is always only one bounding box, but
@@ -180,6 +202,12 @@ class SpatialJoinAlgorithms {
   std::optional<GeoPoint> getPoint(const IdTable* restable, size_t row,
                                    ColumnIndex col) const;
 
+  // Return true iff the `col` of the `idTable` contains a WKT literal that is
+  // not stored as a `GeoPoint`. Such geometries are not supported by the S2
+  // algorithm.
+  bool containsNonPointGeometry(const IdTable* idTable, ColumnIndex col,
+                                const LocalVocab& localVocab) const;
+
   // returns everything between the first two quotes. If the string does not
   // contain two quotes, the string is returned as a whole
   std::string_view betweenQuotes(std::string_view extractFrom) const;
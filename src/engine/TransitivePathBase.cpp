@@ -20,6 +20,7 @@
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/MultiColumnJoin.h"
+#include "engine/Sort.h"
 #include "engine/TransitivePathBinSearch.h"
 #include "engine/TransitivePathHashMap.h"
 #include "engine/Union.h"
@@ -194,6 +195,49 @@ TransitivePathBase::decideDirection() {
   return {lhs_, rhs_};
 }
 
+// _____________________________________________________________________________
+std::optional<TransitivePathBase::ReachabilityIndexPredicate>
+TransitivePathBase::getReachabilityIndexPredicate(
+    const TransitivePathSide& startSide) const {
+  // The `ReachabilityIndex` only knows if there is a path, but not how long it
+  // is, and it contains the triples of all graphs.
+  if (minDist_ > 1 || maxDist_ != std::numeric_limits<size_t>::max() ||
+      graphVariable_.has_value()) {
+    return std::nullopt;
+  }
+  // The `TransitivePathBinSearch` sorts the result of the scan.
+  const QueryExecutionTree* tree = subtree_.get();
+  if (dynamic_cast<const Sort*>(tree->getRootOperation().get()) != nullptr) {
+    tree = tree->getRootOperation()->getChildren().at(0);
+  }
+  const auto* scan =
+      dynamic_cast<const IndexScan*>(tree->getRootOperation().get());
+  if (scan == nullptr || scan->numVariables() != 2 ||
+      !scan->additionalColumns().empty() || !scan->subject().isVariable() ||
+      !scan->object().isVariable() || scan->subject() == scan->object() ||
+      !scan->graphsToFilter().areAllGraphsAllowed()) {
+    return std::nullopt;
+  }
+  LocalVocab helperVocab;
+  Id predicate = TripleComponent{scan->predicate()}.toValueId(
+      getIndex().getVocab(), helperVocab, getIndex().encodedIriManager());
+  if (predicate.getDatatype() == Datatype::LocalVocabIndex) {
+    return std::nullopt;
+  }
+  // The index was built for the triples without any updates, so it can't be
+  // used if the triples of the `predicate` have been updated.
+  for (auto permutation : {Permutation::Enum::PSO, Permutation::Enum::POS}) {
+    if (locatedTriplesSnapshot()
+            .getLocatedTriplesForPermutation(permutation)
+            .hasUpdatesForCol0(predicate)) {
+      return std::nullopt;
+    }
+  }
+  bool forward = subtree_->getVariableColumn(scan->subject().getVariable()) ==
+                 startSide.subCol_;
+  return ReachabilityIndexPredicate{predicate, forward};
+}
+
 // _____________________________________________________________________________
 Result::Generator TransitivePathBase::fillTableWithHull(
     NodeGenerator hull, size_t startSideCol, size_t targetSideCol,
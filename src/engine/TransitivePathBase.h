@@ -247,6 +247,21 @@ class TransitivePathBase : public Operation {
   size_t numJoinColumnsWith(const std::shared_ptr<QueryExecutionTree>& tree,
                             ColumnIndex joinColumn) const;
 
+  // The predicate of the triples that form the edges of the paths, and
+  // whether the paths follow these triples from the subject to the object.
+  struct ReachabilityIndexPredicate {
+    Id predicate_;
+    bool forward_;
+  };
+
+  // Return the predicate if the paths from the `startSide` can be computed
+  // via the `ReachabilityIndex` of the index, else `std::nullopt`. This
+  // requires that the subtree is a scan of all the triples with a fixed
+  // predicate, that there are no updates, that there is no graph variable,
+  // and that there is no upper bound for the length of the paths.
+  std::optional<ReachabilityIndexPredicate> getReachabilityIndexPredicate(
+      const TransitivePathSide& startSide) const;
+
  public:
   std::string getDescriptor() const override;
 
@@ -9,14 +9,72 @@
 #ifndef QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 #define QLEVER_SRC_ENGINE_TRANSITIVEPATHIMPL_H
 
+#include <atomic>
+#include <functional>
+#include <limits>
 #include <utility>
 
 #include "engine/TransitivePathBase.h"
+#include "global/RuntimeParameters.h"
+#include "index/ReachabilityIndex.h"
 #include "util/Iterators.h"
 #include "util/Timer.h"
+#include "util/WorkerPool.h"
 
 using IdWithGraphs = absl::InlinedVector<std::pair<Id, Id>, 1>;
 
+// The edges of a transitive path over all the triples of a single predicate,
+// for which the index has a `ReachabilityIndex::Graph`. Instead of the
+// successors of a node, this directly yields all the nodes that are reachable
+// from it. There is no graph variable in this case.
+class ReachabilityIndexEdges {
+  std::shared_ptr<const ReachabilityIndex::Graph> graph_;
+  // True iff the paths follow the triples from the subject to the object.
+  bool forward_;
+
+ public:
+  ReachabilityIndexEdges(std::shared_ptr<const ReachabilityIndex::Graph> graph,
+                         bool forward)
+      : graph_{std::move(graph)}, forward_{forward} {
+    AD_CONTRACT_CHECK(graph_ != nullptr);
+  }
+
+  // Return the nodes that can be reached from the `node` via a path with at
+  // least `minDist` (0 or 1) edges, only the `target` if specified.
+  Set getReachableNodes(
+      Id node, const std::optional<Id>& target, size_t minDist,
+      const ad_utility::AllocatorWithLimit<Id>& allocator) const {
+    Set result{allocator};
+    if (target.has_value()) {
+      if (graph_->isReachable(node, target.value(), minDist, forward_)) {
+        result.insert(target.value());
+      }
+    } else {
+      graph_->forEachReachableNode(node, minDist, forward_,
+                                   [&result](Id id) { result.insert(id); });
+    }
+    return result;
+  }
+
+  // The same as `BinSearchMap::getEquivalentIdAndMatchingGraphs` without
+  // graphs, that is, all the nodes with an outgoing edge if `node` is
+  // undefined, and else `node` if it has an outgoing edge.
+  IdWithGraphs getEquivalentIdAndMatchingGraphs(Id node) const {
+    IdWithGraphs result;
+    if (node.isUndefined()) {
+      for (Id id : graph_->nodesWithSuccessors(forward_)) {
+        result.emplace_back(id, Id::makeUndefined());
+      }
+    } else if (graph_->hasSuccessor(node, forward_)) {
+      result.emplace_back(node, Id::makeUndefined());
+    }
+    return result;
+  }
+
+  // There are no graphs, so there is nothing to do.
+  void setGraphId([[maybe_unused]] Id graphId) {}
+};
+
 namespace detail {
 
 // Helper struct that allows to group a read-only view of a column of a table
@@ -75,6 +133,27 @@ class TransitivePathImpl : public TransitivePathBase {
       ::ranges::zip_view<ql::span<const Id>, ::ranges::repeat_view<Id>>>;
   using TableColumnWithVocab = detail::TableColumnWithVocab<
       ad_utility::InputRangeTypeErased<ZippedType>>;
+  // Maps each node to the nodes with an edge to it, used for the backward part
+  // of the bidirectional search.
+  using PredecessorMap = std::unordered_map<
+      Id, Set, absl::Hash<Id>, std::equal_to<Id>,
+      ad_utility::AllocatorWithLimit<std::pair<const Id, Set>>>;
+  // Builds the `PredecessorMap`, see `getPredecessorMapBuilder`.
+  using PredecessorMapBuilder = std::function<PredecessorMap()>;
+
+  // A node for which the transitive hull is computed, together with its graph,
+  // the target of the paths (if it is known in advance), and its row in the
+  // input.
+  struct StartNode {
+    Id node_;
+    Id graph_;
+    std::optional<Id> target_;
+    size_t row_;
+  };
+
+  // When the hulls are computed by several threads, each thread processes this
+  // many start nodes per batch on average.
+  static constexpr size_t START_NODES_PER_THREAD_AND_BATCH = 64;
 
  public:
   using TransitivePathBase::TransitivePathBase;
@@ -85,20 +164,26 @@ class TransitivePathImpl : public TransitivePathBase {
    * it is a variable. The other IdTable contains the result
    * of the start side and will be used to get the start nodes.
    *
-   * @param sub A shared pointer to the sub result. Needs to be kept alive for
-   * the lifetime of this generator.
+   * @param sub A shared pointer to the sub result (`nullptr` if the `edges`
+   * don't depend on it). Needs to be kept alive for the lifetime of this
+   * generator.
+   * @param edges The edges of the graph, see `transitiveHull`.
+   * @param buildPredecessors Builds the reversed edges, see `transitiveHull`.
    * @param startSide The start side for the transitive hull
    * @param targetSide The target side for the transitive hull
    * @param startSideResult The Result of the startSide
    * @param yieldOnce If true, the generator will yield only a single time.
+   * @param timer The (stopped) timer for the initialization, which already
+   * includes the setup of the `edges`.
    */
+  template <typename Edges>
   Result::Generator computeTransitivePathBound(
-      std::shared_ptr<const Result> sub, const TransitivePathSide& startSide,
-      const TransitivePathSide& targetSide,
-      std::shared_ptr<const Result> startSideResult, bool yieldOnce) const {
-    ad_utility::Timer timer{ad_utility::Timer::Started};
-
-    auto edges = setupEdgesMap(sub->idTable(), startSide, targetSide);
+      std::shared_ptr<const Result> sub, Edges edges,
+      std::optional<PredecessorMapBuilder> buildPredecessors,
+      const TransitivePathSide& startSide, const TransitivePathSide& targetSide,
+      std::shared_ptr<const Result> startSideResult, bool yieldOnce,
+      ad_utility::Timer timer) const {
+    timer.cont();
     auto nodes = setupNodes(startSide, std::move(startSideResult));
     // Setup nodes returns a generator, so this time measurement won't include
     // the time for each iteration, but every iteration step should have
@@ -106,8 +191,9 @@ class TransitivePathImpl : public TransitivePathBase {
     runtimeInfo().addDetail("Initialization time", timer.msecs());
 
     NodeGenerator hull = transitiveHull(
-        std::move(edges), sub->getCopyOfLocalVocab(), std::move(nodes),
-        startSide.value_, targetSide.value_, yieldOnce);
+        std::move(edges), sub ? sub->getCopyOfLocalVocab() : LocalVocab{},
+        std::move(nodes), startSide.value_, targetSide.value_, yieldOnce,
+        std::move(buildPredecessors));
 
     const auto& [tree, joinColumn] = startSide.treeAndCol_.value();
     size_t numberOfPayloadColumns =
@@ -126,21 +212,31 @@ class TransitivePathImpl : public TransitivePathBase {
    * @brief Compute the transitive hull.
    * This function is called when no side is bound (or an id).
    *
-   * @param sub A shared pointer to the sub result. Needs to be kept alive for
-   * the lifetime of this generator.
+   * @param sub A shared pointer to the sub result (`nullptr` if the `edges`
+   * don't depend on it). Needs to be kept alive for the lifetime of this
+   * generator.
+   * @param edges The edges of the graph, see `transitiveHull`.
+   * @param buildPredecessors Builds the reversed edges, see `transitiveHull`.
    * @param startSide The start side for the transitive hull
    * @param targetSide The target side for the transitive hull
    * @param yieldOnce If true, the generator will yield only a single time.
+   * @param timer The (stopped) timer for the initialization, which already
+   * includes the setup of the `edges`.
    */
-
-  Result::Generator computeTransitivePath(std::shared_ptr<const Result> sub,
-                                          const TransitivePathSide& startSide,
-                                          const TransitivePathSide& targetSide,
-                                          bool yieldOnce) const {
-    ad_utility::Timer timer{ad_utility::Timer::Started};
-
-    auto edges = setupEdgesMap(sub->idTable(), startSide, targetSide);
-    auto nodes = setupNodes(sub->idTable(), startSide, edges);
+  template <typename Edges>
+  Result::Generator computeTransitivePath(
+      std::shared_ptr<const Result> sub, Edges edges,
+      std::optional<PredecessorMapBuilder> buildPredecessors,
+      const TransitivePathSide& startSide, const TransitivePathSide& targetSide,
+      bool yieldOnce, ad_utility::Timer timer) const {
+    timer.cont();
+    auto nodes = [&]() {
+      if constexpr (std::is_same_v<Edges, ReachabilityIndexEdges>) {
+        return setupNodes(startSide, edges);
+      } else {
+        return setupNodes(sub->idTable(), startSide, edges);
+      }
+    }();
 
     runtimeInfo().addDetail("Initialization time", timer.msecs());
 
@@ -150,8 +246,9 @@ class TransitivePathImpl : public TransitivePathBase {
         std::nullopt, nodes, LocalVocab{}};
 
     NodeGenerator hull = transitiveHull(
-        std::move(edges), sub->getCopyOfLocalVocab(), ql::span{&tableInfo, 1},
-        startSide.value_, targetSide.value_, yieldOnce);
+        std::move(edges), sub ? sub->getCopyOfLocalVocab() : LocalVocab{},
+        ql::span{&tableInfo, 1}, startSide.value_, targetSide.value_,
+        yieldOnce, std::move(buildPredecessors));
 
     // We don't pass a payload table, so our `inputWidth` is 0.
     auto result = fillTableWithHull(std::move(hull), startSide.outputCol_,
@@ -175,25 +272,83 @@ class TransitivePathImpl : public TransitivePathBase {
    */
   Result computeResult(bool requestLaziness) override {
     auto [startSide, targetSide] = decideDirection();
+    // If possible, use the precomputed `ReachabilityIndex`, then the result of
+    // the subtree is not needed at all.
+    auto reachabilityIndexPredicate = getReachabilityIndexPredicate(startSide);
+    const auto& reachabilityIndex = getIndex().getReachabilityIndex();
+    if (reachabilityIndexPredicate.has_value()) {
+      const auto& [predicate, forward] = reachabilityIndexPredicate.value();
+      if (auto graph = reachabilityIndex.getGraph(predicate)) {
+        runtimeInfo().addDetail("Reachability index", true);
+        return computeResultWithEdges(
+            nullptr, ReachabilityIndexEdges{std::move(graph), forward},
+            std::nullopt, startSide, targetSide, requestLaziness,
+            ad_utility::Timer{ad_utility::Timer::Stopped});
+      }
+    }
+
     // In order to traverse the graph represented by this result, we need random
     // access across the whole table, so it doesn't make sense to lazily compute
     // the result.
     std::shared_ptr<const Result> subRes = subtree_->getResult(false);
+    ad_utility::Timer timer{ad_utility::Timer::Started};
+    const IdTable& sub = subRes->idTable();
+
+    if (reachabilityIndexPredicate.has_value() &&
+        getRuntimeParameter<
+            &RuntimeParameters::transitivePathReachabilityIndexOnDemand_>()) {
+      const auto& [predicate, forward] = reachabilityIndexPredicate.value();
+      decltype(auto) startCol = sub.getColumn(startSide.subCol_);
+      decltype(auto) targetCol = sub.getColumn(targetSide.subCol_);
+      auto maxSize = getRuntimeParameter<
+          &RuntimeParameters::
+              transitivePathReachabilityIndexOnDemandMaxSize_>();
+      auto graph = reachabilityIndex.addGraph(
+          predicate,
+          std::make_shared<ReachabilityIndex::Graph>(
+              forward ? ReachabilityIndex::Graph::build(startCol, targetCol)
+                      : ReachabilityIndex::Graph::build(targetCol, startCol)),
+          maxSize);
+      runtimeInfo().addDetail("Reachability index built on demand", true);
+      timer.stop();
+      return computeResultWithEdges(
+          std::move(subRes), ReachabilityIndexEdges{std::move(graph), forward},
+          std::nullopt, startSide, targetSide, requestLaziness, timer);
+    }
 
+    auto edges = setupEdgesMap(sub, startSide, targetSide);
+    auto buildPredecessors =
+        getPredecessorMapBuilder(sub, startSide, targetSide);
+    timer.stop();
+    return computeResultWithEdges(std::move(subRes), std::move(edges),
+                                  std::move(buildPredecessors), startSide,
+                                  targetSide, requestLaziness, timer);
+  }
+
+  // Compute the result with the given `edges` (see `computeResult`).
+  template <typename Edges>
+  Result computeResultWithEdges(std::shared_ptr<const Result> subRes,
+                                Edges edges,
+                                std::optional<PredecessorMapBuilder>
+                                    buildPredecessors,
+                                const TransitivePathSide& startSide,
+                                const TransitivePathSide& targetSide,
+                                bool requestLaziness, ad_utility::Timer timer) {
     if (startSide.isBoundVariable()) {
       std::shared_ptr<const Result> sideRes =
           startSide.treeAndCol_.value().first->getResult(true);
 
-      auto gen =
-          computeTransitivePathBound(std::move(subRes), startSide, targetSide,
-                                     std::move(sideRes), !requestLaziness);
+      auto gen = computeTransitivePathBound(
+          std::move(subRes), std::move(edges), std::move(buildPredecessors),
+          startSide, targetSide, std::move(sideRes), !requestLaziness, timer);
 
       return requestLaziness ? Result{std::move(gen), resultSortedOn()}
                              : Result{cppcoro::getSingleElement(std::move(gen)),
                                       resultSortedOn()};
     }
-    auto gen = computeTransitivePath(std::move(subRes), startSide, targetSide,
-                                     !requestLaziness);
+    auto gen = computeTransitivePath(std::move(subRes), std::move(edges),
+                                     std::move(buildPredecessors), startSide,
+                                     targetSide, !requestLaziness, timer);
     return requestLaziness ? Result{std::move(gen), resultSortedOn()}
                            : Result{cppcoro::getSingleElement(std::move(gen)),
                                     resultSortedOn()};
@@ -237,12 +392,179 @@ class TransitivePathImpl : public TransitivePathBase {
     return connectedNodes;
   }
 
+  /**
+   * @brief Bidirectional breadth-first search to check if there is a path of
+   * length at least `minDist_` (which must be at most 1) from `startNode` to
+   * `target`. The search alternately expands the smaller of the two frontiers
+   * (forwards from `startNode` and backwards from `target`) and terminates as
+   * soon as they meet.
+   * @param edges The adjacency lists, mapping Ids (nodes) to their connected
+   * Ids.
+   * @param predecessors The reversed adjacency lists.
+   * @param startNode The node to start the search from.
+   * @param target The node where the paths have to end.
+   * @return True if such a path exists.
+   */
+  bool isReachable(const T& edges, const PredecessorMap& predecessors,
+                   Id startNode, Id target) const {
+    AD_CORRECTNESS_CHECK(minDist_ <= 1);
+    if (minDist_ == 0 && startNode == target) {
+      return true;
+    }
+    ad_utility::HashSetWithMemoryLimit<Id> forwardMarks{allocator()};
+    ad_utility::HashSetWithMemoryLimit<Id> backwardMarks{allocator()};
+    std::vector<Id> forwardFrontier;
+    std::vector<Id> backwardFrontier{target};
+    backwardMarks.insert(target);
+    // The forward search starts at the successors of the `startNode`, so that
+    // only paths of length at least one are found.
+    for (auto successor : edges.successors(startNode)) {
+      if (successor == target) {
+        return true;
+      }
+      if (forwardMarks.insert(successor).second) {
+        forwardFrontier.push_back(successor);
+      }
+    }
+
+    while (!forwardFrontier.empty() && !backwardFrontier.empty()) {
+      checkCancellation();
+      bool forward = forwardFrontier.size() <= backwardFrontier.size();
+      auto& frontier = forward ? forwardFrontier : backwardFrontier;
+      auto& marks = forward ? forwardMarks : backwardMarks;
+      const auto& otherMarks = forward ? backwardMarks : forwardMarks;
+      std::vector<Id> nextFrontier;
+      // Add the unmarked `neighbors` to the next frontier. Return true if one
+      // of them was already reached by the search from the other side.
+      auto expand = [&](const auto& neighbors) {
+        for (auto neighbor : neighbors) {
+          if (otherMarks.contains(neighbor)) {
+            return true;
+          }
+          if (marks.insert(neighbor).second) {
+            nextFrontier.push_back(neighbor);
+          }
+        }
+        return false;
+      };
+      for (Id node : frontier) {
+        if (forward) {
+          if (expand(edges.successors(node))) {
+            return true;
+          }
+        } else if (auto it = predecessors.find(node);
+                   it != predecessors.end() && expand(it->second)) {
+          return true;
+        }
+      }
+      frontier = std::move(nextFrontier);
+    }
+    return false;
+  }
+
+  // Return the set of all nodes from which there is a path of length at least
+  // `minDist_` (which must be at most 1) to the `target`. This is a single
+  // search over the reversed edges, which answers the question for all the
+  // start nodes with the same target at once.
+  Set findNodesReachingTarget(const PredecessorMap& predecessors,
+                              Id target) const {
+    AD_CORRECTNESS_CHECK(minDist_ <= 1);
+    Set nodes{allocator()};
+    if (minDist_ == 0) {
+      nodes.insert(target);
+    }
+    std::vector<Id> stack{target};
+    while (!stack.empty()) {
+      checkCancellation();
+      Id node = stack.back();
+      stack.pop_back();
+      auto it = predecessors.find(node);
+      if (it == predecessors.end()) {
+        continue;
+      }
+      for (Id predecessor : it->second) {
+        if (nodes.insert(predecessor).second) {
+          stack.push_back(predecessor);
+        }
+      }
+    }
+    return nodes;
+  }
+
+  // The reversed edges for the searches from the target side, see
+  // `transitiveHull`. At most one of the members is set.
+  struct BackwardSearch {
+    // For the bidirectional search when the target depends on the start node.
+    std::optional<PredecessorMap> predecessors_;
+    // The result of `findNodesReachingTarget` when the target is fixed.
+    std::optional<Set> nodesReachingTarget_;
+  };
+
+  // Return the set of nodes that can be reached from the `startNode` (only
+  // the `target` if specified). Uses the lookups in the `ReachabilityIndex`
+  // if possible, the result of the single backward search or the
+  // bidirectional search if the `backwardSearch` was prepared and the target
+  // is known, and the depth-first search otherwise.
+  template <typename Edges>
+  Set computeTargets(const Edges& edges, const BackwardSearch& backwardSearch,
+                     Id startNode, const std::optional<Id>& target) const {
+    if constexpr (std::is_same_v<Edges, ReachabilityIndexEdges>) {
+      return edges.getReachableNodes(startNode, target, minDist_, allocator());
+    } else {
+      const auto& [predecessors, nodesReachingTarget] = backwardSearch;
+      if (!target.has_value() ||
+          (!predecessors.has_value() && !nodesReachingTarget.has_value())) {
+        return findConnectedNodes(edges, startNode, target);
+      }
+      Set connectedNodes{allocator()};
+      if (nodesReachingTarget.has_value()
+              ? nodesReachingTarget.value().contains(startNode)
+              : isReachable(edges, predecessors.value(), startNode,
+                            target.value())) {
+        connectedNodes.insert(target.value());
+      }
+      return connectedNodes;
+    }
+  }
+
+  // Compute the targets of all the start nodes of the `batch` (in the same
+  // order). For more than one thread, the threads process one start node at a
+  // time, each with its own marks. In this case, the `edges` are shared by all
+  // threads, so they must not depend on the graph of the start node (there
+  // must be no graph variable).
+  template <typename Edges>
+  std::vector<Set> computeTargetsForBatch(Edges& edges,
+                                          const BackwardSearch& backwardSearch,
+                                          const std::vector<StartNode>& batch,
+                                          size_t numThreads) const {
+    std::vector<Set> result;
+    if (numThreads <= 1) {
+      result.reserve(batch.size());
+      for (const auto& startNode : batch) {
+        edges.setGraphId(startNode.graph_);
+        result.push_back(computeTargets(edges, backwardSearch, startNode.node_,
+                                        startNode.target_));
+      }
+      return result;
+    }
+    AD_CORRECTNESS_CHECK(!graphVariable_.has_value());
+    result.resize(batch.size(), Set{allocator()});
+    std::atomic<size_t> nextIndex = 0;
+    ad_utility::WorkerPool::global().runInParallel(numThreads, [&](size_t) {
+      for (size_t i = nextIndex++; i < batch.size(); i = nextIndex++) {
+        result[i] = computeTargets(edges, backwardSearch, batch[i].node_,
+                                   batch[i].target_);
+      }
+    });
+    return result;
+  }
+
   /**
    * @brief Compute the transitive hull starting at the given nodes,
    * using the given Map.
    *
    * @param edges Adjacency lists, mapping Ids (nodes) to their connected
-   * Ids.
+   * Ids, or the `ReachabilityIndexEdges`.
    * @param edgesVocab The `LocalVocab` holding the vocabulary of the edges.
    * @param startNodes A range that yields an instantiation of
    * `TableColumnWithVocab` that can be consumed to create a transitive hull.
@@ -255,12 +577,20 @@ class TransitivePathImpl : public TransitivePathBase {
    * code. When set to true, this will prevent yielding the same LocalVocab over
    * and over again to make merging faster (because merging with an empty
    * LocalVocab is a no-op).
+   * @param buildPredecessors Builds the reversed edges if the target is known
+   * in advance (see `getPredecessorMapBuilder`). They are only built when the
+   * first start node is processed. If the target is fixed, a single search
+   * from the target finds all the start nodes from which it can be reached,
+   * else the bidirectional search is used for each start node.
    * @return Map Maps each Id to its connected Ids in the transitive hull
    */
-  CPP_template(typename Node)(requires ql::ranges::range<Node>) NodeGenerator
-      transitiveHull(T edges, LocalVocab edgesVocab, Node startNodes,
+  CPP_template(typename Edges, typename Node)(
+      requires ql::ranges::range<Node>) NodeGenerator
+      transitiveHull(Edges edges, LocalVocab edgesVocab, Node startNodes,
                      TripleComponent start, TripleComponent target,
-                     bool yieldOnce) const {
+                     bool yieldOnce,
+                     std::optional<PredecessorMapBuilder> buildPredecessors)
+          const {
     ad_utility::Timer timer{ad_utility::Timer::Stopped};
     // `targetId` is only ever used for comparisons, and never stored in the
     // result, so we use a separate local vocabulary.
@@ -271,47 +601,94 @@ class TransitivePathImpl : public TransitivePathBase {
             ? std::nullopt
             : std::optional{std::move(target).toValueId(
                   index.getVocab(), targetHelper, index.encodedIriManager())};
+    bool targetIsFixed = targetId.has_value();
     bool sameVariableOnBothSides =
         !targetId.has_value() && lhs_.value_ == rhs_.value_;
     bool endsWithGraphVariable =
         !targetId.has_value() && graphVariable_ == target.getVariable();
     bool startsWithGraphVariable =
         start.isVariable() && graphVariable_ == start.getVariable();
+    // With a graph variable, the edges depend on the graph of the start node,
+    // so the hulls are always computed by a single thread. A single thread
+    // processes one start node at a time to keep the generator lazy.
+    size_t numThreads =
+        graphVariable_.has_value()
+            ? 1
+            : std::max(getRuntimeParameter<
+                           &RuntimeParameters::transitivePathNumThreads_>(),
+                       size_t{1});
+    size_t batchSize =
+        numThreads == 1 ? 1 : numThreads * START_NODES_PER_THREAD_AND_BATCH;
+    if (numThreads > 1) {
+      runtimeInfo().addDetail("Num threads", numThreads);
+    }
+    if (buildPredecessors.has_value()) {
+      runtimeInfo().addDetail(
+          targetIsFixed ? "Backward search" : "Bidirectional search", true);
+    }
+    BackwardSearch backwardSearch;
+    auto prepareBackwardSearch = [&]() {
+      if (!buildPredecessors.has_value()) {
+        return;
+      }
+      PredecessorMap predecessors = buildPredecessors.value()();
+      buildPredecessors.reset();
+      if (targetIsFixed) {
+        backwardSearch.nodesReachingTarget_ =
+            findNodesReachingTarget(predecessors, targetId.value());
+      } else {
+        backwardSearch.predecessors_ = std::move(predecessors);
+      }
+    };
+    std::vector<StartNode> batch;
     for (auto&& tableColumn : startNodes) {
       timer.cont();
       LocalVocab mergedVocab = std::move(tableColumn.vocab_);
       mergedVocab.mergeWith(edgesVocab);
-      for (const auto& [currentRow, pair] :
-           ::ranges::views::enumerate(tableColumn.startNodes_)) {
-        for (const auto& [startNode, graphId] :
-             tableColumn.expandUndef(pair, edges, graphVariable_.has_value())) {
-          // Skip generation of values for `SELECT * { GRAPH ?g { ?g a* ?x } }`
-          // where both `?g` variables are not the same.
-          if (startsWithGraphVariable && startNode != graphId) {
-            continue;
+      auto rows = ::ranges::views::enumerate(tableColumn.startNodes_);
+      auto it = rows.begin();
+      while (it != rows.end()) {
+        batch.clear();
+        for (; it != rows.end() && batch.size() < batchSize; ++it) {
+          const auto& [currentRow, pair] = *it;
+          for (const auto& [startNode, graphId] : tableColumn.expandUndef(
+                   pair, edges, graphVariable_.has_value())) {
+            // Skip generation of values for `GRAPH ?g { ?g a* ?x }` where
+            // both `?g` variables are not the same.
+            if (startsWithGraphVariable && startNode != graphId) {
+              continue;
+            }
+            if (sameVariableOnBothSides) {
+              targetId = startNode;
+            } else if (endsWithGraphVariable) {
+              targetId = graphId;
+            }
+            batch.push_back(StartNode{startNode, graphId, targetId,
+                                      static_cast<size_t>(currentRow)});
           }
-          if (sameVariableOnBothSides) {
-            targetId = startNode;
-          } else if (endsWithGraphVariable) {
-            targetId = graphId;
+        }
+        if (!batch.empty()) {
+          prepareBackwardSearch();
+        }
+        std::vector<Set> targets =
+            computeTargetsForBatch(edges, backwardSearch, batch, numThreads);
+        for (size_t i = 0; i < batch.size(); ++i) {
+          if (targets[i].empty()) {
+            continue;
           }
-          edges.setGraphId(graphId);
-          Set connectedNodes = findConnectedNodes(edges, startNode, targetId);
-          if (!connectedNodes.empty()) {
-            runtimeInfo().addDetail("Hull time", timer.msecs());
-            timer.stop();
-            co_yield NodeWithTargets{startNode,
-                                     graphId,
-                                     std::move(connectedNodes),
-                                     mergedVocab.clone(),
-                                     tableColumn.payload_,
-                                     static_cast<size_t>(currentRow)};
-            timer.cont();
-            // Reset vocab to prevent merging the same vocab over and over
-            // again.
-            if (yieldOnce) {
-              mergedVocab = LocalVocab{};
-            }
+          runtimeInfo().addDetail("Hull time", timer.msecs());
+          timer.stop();
+          co_yield NodeWithTargets{batch[i].node_,
+                                   batch[i].graph_,
+                                   std::move(targets[i]),
+                                   mergedVocab.clone(),
+                                   tableColumn.payload_,
+                                   batch[i].row_};
+          timer.cont();
+          // Reset vocab to prevent merging the same vocab over and over
+          // again.
+          if (yieldOnce) {
+            mergedVocab = LocalVocab{};
           }
         }
       }
@@ -319,6 +696,37 @@ class TransitivePathImpl : public TransitivePathBase {
     }
   }
 
+  // If the search from the target side can be used, return a function that
+  // builds the reversed edges of the `sub` table (which has to outlive the
+  // function), else `std::nullopt`. The search from the target side only
+  // checks if there is a path to a target that is known in advance, so it can
+  // be used if the target is fixed or the same variable as the start, if there
+  // is no upper bound for the length of the paths, and if the lower bound is
+  // at most one. For simplicity, it is not used with a graph variable.
+  std::optional<PredecessorMapBuilder> getPredecessorMapBuilder(
+      const IdTable& sub, const TransitivePathSide& startSide,
+      const TransitivePathSide& targetSide) const {
+    bool targetIsKnown =
+        !targetSide.isVariable() ||
+        (lhs_.isVariable() && lhs_.value_ == rhs_.value_);
+    if (!getRuntimeParameter<
+            &RuntimeParameters::transitivePathBidirectionalSearch_>() ||
+        !targetIsKnown || graphVariable_.has_value() || minDist_ > 1 ||
+        maxDist_ != std::numeric_limits<size_t>::max()) {
+      return std::nullopt;
+    }
+    return [this, &sub, startCol = startSide.subCol_,
+            targetCol = targetSide.subCol_]() {
+      PredecessorMap predecessors{allocator()};
+      for (size_t i = 0; i < sub.size(); i++) {
+        checkCancellation();
+        auto [it, _] = predecessors.try_emplace(sub(i, targetCol), allocator());
+        it->second.insert(sub(i, startCol));
+      }
+      return predecessors;
+    };
+  }
+
   /**
    * @brief Prepare a Map and a nodes vector for the transitive hull
    * computation.
@@ -363,6 +771,28 @@ class TransitivePathImpl : public TransitivePathBase {
     return result;
   }
 
+  // The same as the overload above, but with the `ReachabilityIndexEdges`,
+  // for which the result of the subtree is not available. Without a graph
+  // variable, the start nodes of `var -> var` are all the nodes with an
+  // outgoing edge.
+  SetWithGraph setupNodes(const TransitivePathSide& startSide,
+                          const ReachabilityIndexEdges& edges) const {
+    AD_CORRECTNESS_CHECK(minDist_ != 0,
+                         "If minDist_ is 0 with a hardcoded side, we should "
+                         "call the overload for a bound transitive path.");
+    AD_CORRECTNESS_CHECK(!graphVariable_.has_value());
+    Id startId = Id::makeUndefined();
+    LocalVocab helperVocab;
+    if (!startSide.isVariable()) {
+      startId = TripleComponent{startSide.value_}.toValueId(
+          getIndex().getVocab(), helperVocab, getIndex().encodedIriManager());
+    }
+    auto idAndGraphs = edges.getEquivalentIdAndMatchingGraphs(startId);
+    SetWithGraph result{allocator()};
+    result.insert(idAndGraphs.begin(), idAndGraphs.end());
+    return result;
+  }
+
   /**
    * @brief Prepare a Map and a nodes vector for the transitive hull
    * computation.
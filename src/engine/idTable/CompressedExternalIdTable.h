@@ -21,6 +21,8 @@
 #include "util/InputRangeUtils.h"
 #include "util/Iterators.h"
 #include "util/MemorySize/MemorySize.h"
+#include "util/Serializer/FileSerializer.h"
+#include "util/Serializer/SerializeVector.h"
 #include "util/TransparentFunctors.h"
 #include "util/Views.h"
 
@@ -39,6 +41,11 @@ using namespace ad_utility::memory_literals;
 // The default size for compressed blocks in the following classes.
 static constexpr ad_utility::MemorySize DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE =
     500_kB;
+
+// Tag for the constructors of the following classes that open a file which
+// was previously written and then persisted (see `persist` below).
+struct ReopenPersistedTag {};
+
 // A class that stores a sequence of `IdTable`s in a file. Each `IdTable` is
 // compressed blockwise. Typically, the blocksize is much smaller than the size
 // of a single IdTable, such that there are multiple blocks per IdTable. This is
@@ -56,6 +63,12 @@ class CompressedExternalIdTableWriter {
     size_t compressedSize_;
     size_t uncompressedSize_;
     size_t offsetInFile_;
+
+    AD_SERIALIZE_FRIEND_FUNCTION(CompressedBlockMetadata) {
+      serializer | arg.compressedSize_;
+      serializer | arg.uncompressedSize_;
+      serializer | arg.offsetInFile_;
+    }
   };
 
   // The filename and actual file to which the `IdTable` is written .
@@ -85,7 +98,13 @@ class CompressedExternalIdTableWriter {
   // contents.
   size_t numActiveGenerators_ = 0;
 
+  // If true, the file is not deleted by the destructor, see `persist`.
+  bool isPersisted_ = false;
+
  public:
+  // The suffix of the file to which `persist` writes the metadata.
+  static constexpr std::string_view METADATA_SUFFIX = ".metadata";
+
   // Constructor. The file at `filename` will be overwritten. Each of the
   // `IdTables` that will be passed in has to have exactly `numCols` columns.
   explicit CompressedExternalIdTableWriter(
@@ -98,10 +117,36 @@ class CompressedExternalIdTableWriter {
         allocator_{std::move(allocator)},
         blockSizeUncompressed_(blockSizeUncompressed) {}
 
-  // Destructor. Deletes the stored file.
+  // Constructor that opens the file at `filename`, which was written by
+  // another writer with the same `numCols` and `blockSizeUncompressed` on which
+  // `persist` was called. The stored `IdTable`s can then be read again. The
+  // file is kept until `clear` is called.
+  CompressedExternalIdTableWriter(
+      ReopenPersistedTag, std::string filename, size_t numCols,
+      ad_utility::AllocatorWithLimit<Id> allocator,
+      ad_utility::MemorySize blockSizeUncompressed =
+          DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE)
+      : filename_{std::move(filename)},
+        file_{filename_, "r"},
+        allocator_{std::move(allocator)},
+        blockSizeUncompressed_(blockSizeUncompressed),
+        isPersisted_{true} {
+    ad_utility::serialization::FileReadSerializer serializer{
+        absl::StrCat(filename_, METADATA_SUFFIX)};
+    size_t blockSizeBytes;
+    serializer >> blockSizeBytes;
+    serializer >> blocksPerColumn_;
+    serializer >> startOfSingleIdTables_;
+    AD_CORRECTNESS_CHECK(blocksPerColumn_.size() == numCols);
+    AD_CORRECTNESS_CHECK(blockSizeBytes == blockSizeUncompressed_.getBytes());
+  }
+
+  // Destructor. Deletes the stored file unless it was persisted.
   ~CompressedExternalIdTableWriter() {
     file_.wlock()->close();
-    ad_utility::deleteFile(filename_);
+    if (!isPersisted_) {
+      ad_utility::deleteFile(filename_);
+    }
   }
 
   // Simple getters for the stored allocator and the number of columns;
@@ -111,6 +156,31 @@ class CompressedExternalIdTableWriter {
     return blockSizeUncompressed_;
   }
 
+  // The number of stored `IdTable`s and the total number of their rows.
+  size_t numIdTables() const { return startOfSingleIdTables_.size(); }
+  size_t numRows() const {
+    size_t numBytes = 0;
+    for (const auto& block : blocksPerColumn_.at(0)) {
+      numBytes += block.uncompressedSize_;
+    }
+    return numBytes / sizeof(Id);
+  }
+
+  // Flush the file and write the metadata of the stored `IdTable`s to the file
+  // `filename_ + METADATA_SUFFIX`. The two files are then kept after the
+  // destruction of this object (until `clear` is called), s.t. they can be
+  // opened again with the `ReopenPersistedTag` constructor, also by a later
+  // run of the program. No `IdTable`s may be added after this call.
+  void persist() {
+    file_.wlock()->flush();
+    ad_utility::serialization::FileWriteSerializer serializer{
+        absl::StrCat(filename_, METADATA_SUFFIX)};
+    serializer << blockSizeUncompressed_.getBytes();
+    serializer << blocksPerColumn_;
+    serializer << startOfSingleIdTables_;
+    isPersisted_ = true;
+  }
+
   // Store an `idTable`.
   void writeIdTable(const IdTable& table) {
     if (numActiveGenerators_ != 0) {
@@ -119,6 +189,7 @@ class CompressedExternalIdTableWriter {
           "`CompressedExternalIdTableWriter` that is currently being iterated "
           "over");
     }
+    AD_CONTRACT_CHECK(!isPersisted_);
     AD_CONTRACT_CHECK(table.numColumns() == numColumns());
     size_t blockSize = blockSizeUncompressed_.getBytes() / sizeof(Id);
     AD_CONTRACT_CHECK(blockSize > 0);
@@ -201,6 +272,10 @@ class CompressedExternalIdTableWriter {
     }
     file_.wlock()->close();
     ad_utility::deleteFile(filename_);
+    if (isPersisted_) {
+      ad_utility::deleteFile(absl::StrCat(filename_, METADATA_SUFFIX));
+      isPersisted_ = false;
+    }
     file_.wlock()->open(filename_, "w+");
     ql::ranges::for_each(blocksPerColumn_, [](auto& block) { block.clear(); });
     startOfSingleIdTables_.clear();
@@ -323,6 +398,25 @@ class CompressedExternalIdTableBase {
     this->currentBlock_.reserve(blocksize_);
     AD_CONTRACT_CHECK(NumStaticCols == 0 || NumStaticCols == numCols);
   }
+
+  // Open the file at `filename` that was persisted by another object with the
+  // same arguments (see `persist` below). No rows may be pushed to the result.
+  CompressedExternalIdTableBase(
+      ReopenPersistedTag tag, std::string filename, size_t numCols,
+      ad_utility::MemorySize memory,
+      ad_utility::AllocatorWithLimit<Id> allocator,
+      MemorySize blocksizeCompression = DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE,
+      BlockTransformation blockTransformation = {})
+      : currentBlock_{numCols, allocator},
+        numColumns_{numCols},
+        memory_{memory},
+        writer_{tag, std::move(filename), numCols, allocator,
+                blocksizeCompression},
+        blockTransformation_{blockTransformation} {
+    AD_CONTRACT_CHECK(NumStaticCols == 0 || NumStaticCols == numCols);
+    numElementsPushed_ = writer_.numRows();
+    numBlocksPushed_ = writer_.numIdTables();
+  }
   // Add a single row to the input. The type of `row` needs to be something that
   // can be `push_back`ed to a `IdTable`.
   CPP_template(typename R)(
@@ -344,6 +438,21 @@ class CompressedExternalIdTableBase {
     return [self = this](auto&& value) { self->push(AD_FWD(value)); };
   }
 
+  // Write all the rows that were pushed so far to the underlying file and keep
+  // it after the destruction of this object, s.t. another object (also in a
+  // later run of the program) can be opened on the same file with the
+  // `ReopenPersistedTag` constructor and then yields the same rows. No rows
+  // may be pushed after this call. The file is deleted by `clear`.
+  void persist() {
+    AD_CONTRACT_CHECK(isFirstIteration_);
+    pushBlock(std::move(currentBlock_));
+    resetCurrentBlock(false);
+    if (compressAndWriteFuture_.valid()) {
+      compressAndWriteFuture_.get();
+    }
+    writer_.persist();
+  }
+
   // Delete the underlying file and reset the sorter. May only be called if no
   // active `getBlocks()` generator that has not been fully iterated over is
   // currently active, else an exception is thrown by the underlying
@@ -398,10 +507,11 @@ class CompressedExternalIdTableBase {
       return numBlocksPushed_ != 0;
     }
     // If we have pushed at least one (complete) block, then the last future
-    // from pushing a block is still in flight. If we have never pushed a block,
-    // then also the future cannot be valid.
-    AD_CORRECTNESS_CHECK((numBlocksPushed_ == 0) !=
-                         compressAndWriteFuture_.valid());
+    // from pushing a block is still in flight (unless the blocks were written
+    // by `persist`). If we have never pushed a block, then also the future
+    // cannot be valid.
+    AD_CORRECTNESS_CHECK(numBlocksPushed_ != 0 ||
+                         !compressAndWriteFuture_.valid());
     // Optimization for inputs that are smaller than the blocksize, do not use
     // the external file, but simply sort and return the single block.
     if (numBlocksPushed_ == 0) {
@@ -452,6 +562,17 @@ class CompressedExternalIdTable
       : CompressedExternalIdTable(std::move(filename), NumStaticCols, memory,
                                   std::move(allocator), blocksizeCompression) {}
 
+  // Open a file that was persisted by another `CompressedExternalIdTable` with
+  // the same arguments (see `persist`).
+  CPP_member CPP_ctor(CompressedExternalIdTable)(
+      ReopenPersistedTag tag, std::string filename,
+      ad_utility::MemorySize memory,
+      ad_utility::AllocatorWithLimit<Id> allocator,
+      MemorySize blocksizeCompression = DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE)(
+      requires(NumStaticCols > 0))
+      : Base{tag,    std::move(filename),  NumStaticCols,
+             memory, std::move(allocator), blocksizeCompression} {}
+
   // Transition from the input phase, where `push()` may be called, to the
   // output phase and return a generator that yields the elements of the
   // `IdTable in the order that they were `push`ed. This function may be called
@@ -501,6 +622,10 @@ class CompressedExternalIdTableSorterTypeErased {
   // because of name collisions in the multiple inheritance of the
   // implementation.
   virtual void clearUnderlying() = 0;
+  // Make the underlying file durable, s.t. the pushed rows can be sorted by a
+  // sorter that is reopened with the `ReopenPersistedTag`. Same note as for
+  // `clearUnderlying` regarding the name.
+  virtual void persistUnderlying() = 0;
   virtual ~CompressedExternalIdTableSorterTypeErased() = default;
 };
 
@@ -583,6 +708,24 @@ class CompressedExternalIdTableSorter
                                         memory, std::move(allocator),
                                         blocksizeCompression, comp) {}
 
+  // Open a file that was persisted by another sorter with the same arguments
+  // (see `persist`). The blocks in the file are already sorted, so the sorted
+  // output can be read directly.
+  CPP_member CPP_ctor(CompressedExternalIdTableSorter)(
+      ReopenPersistedTag tag, std::string filename,
+      ad_utility::MemorySize memory,
+      ad_utility::AllocatorWithLimit<Id> allocator,
+      MemorySize blocksizeCompression = DEFAULT_BLOCKSIZE_EXTERNAL_ID_TABLE,
+      Comparator comp = {})(requires(NumStaticCols > 0))
+      : Base{tag,
+             std::move(filename),
+             NumStaticCols,
+             memory,
+             std::move(allocator),
+             blocksizeCompression,
+             BlockSorter{comp}},
+        comparator_{comp} {}
+
   // Explicitly inherit the `push` function, such that we can use it unqualified
   // within this class.
   using Base::push;
@@ -722,6 +865,7 @@ class CompressedExternalIdTableSorter
   };
 
   void clearUnderlying() override { this->clear(); }
+  void persistUnderlying() override { this->persist(); }
   // Transition from the input phase, where `push()` may be called, to the
   // output phase and return an input range that yields the sorted elements.
   // This function may be called exactly once.
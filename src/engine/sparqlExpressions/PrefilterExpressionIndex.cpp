@@ -405,6 +405,88 @@ BlockMetadataRanges PrefilterExpression::evaluate(
   return result;
 }
 
+//______________________________________________________________________________
+BlockMetadataRanges PrefilterExpression::evaluateOnColumnSummaries(
+    const Vocab& vocab, const BlockMetadataRanges& blocks,
+    size_t columnIndex) const {
+  auto mayContainMatches = [&](const CompressedBlockMetadata& block) {
+    const auto* summary = block.getColumnSummary(columnIndex);
+    return summary == nullptr || mayBeTrueForColumnSummary(vocab, *summary);
+  };
+  // Split the `blocks` into maximal ranges of blocks that are kept.
+  BlockMetadataRanges result;
+  for (const auto& range : blocks) {
+    std::optional<BlockMetadataIt> begin;
+    for (auto it = range.begin(); it != range.end(); ++it) {
+      if (mayContainMatches(*it)) {
+        begin = begin.value_or(it);
+      } else if (begin.has_value()) {
+        result.emplace_back(begin.value(), it);
+        begin.reset();
+      }
+    }
+    if (begin.has_value()) {
+      result.emplace_back(begin.value(), range.end());
+    }
+  }
+  return result;
+}
+
+//______________________________________________________________________________
+bool PrefilterExpression::mayBeTrueForColumnSummary(
+    const Vocab& vocab,
+    const CompressedBlockMetadata::ColumnSummary& summary) const {
+  using enum Datatype;
+  // Evaluate the expression on a single artificial block, the first and last
+  // triple of which contain the `lower` and `upper` bound in column 0.
+  auto mayBeTrueInRange = [&](Id lower, Id upper) {
+    CompressedBlockMetadata block{{{},
+                                   0,
+                                   {lower, lower, lower, lower},
+                                   {upper, upper, upper, upper},
+                                   std::nullopt,
+                                   false},
+                                  0};
+    BlockMetadataSpan blockRange{&block, 1};
+    AccessValueIdFromBlockMetadata accessValueIdOp(0);
+    ValueIdSubrange idRange{ValueIdIt{&blockRange, 0, accessValueIdOp},
+                            ValueIdIt{&blockRange, 2, accessValueIdOp}};
+    return !detail::logicalOps::getUnionOfBlockRanges(
+                evaluateImpl(vocab, idRange, blockRange, false),
+                getRangesMixedDatatypeBlocks(idRange, blockRange))
+                .empty();
+  };
+
+  auto minType = summary.min_.getDatatype();
+  auto maxType = summary.max_.getDatatype();
+  // If the column contains `Id`s of several datatypes, a block with these
+  // bounds would be considered as "mixed" and never be skipped. Instead, the
+  // range of each contained datatype is checked separately. This requires that
+  // the `Id`s are ordered by their bits, which is not the case for
+  // `LocalVocabIndex`s (see `ValueId::operator<=>`).
+  if (minType == maxType || summary.containsDatatype(LocalVocabIndex)) {
+    return mayBeTrueInRange(summary.min_, summary.max_);
+  }
+  using T = decltype(summary.min_.getBits());
+  for (auto type = static_cast<T>(minType); type <= static_cast<T>(maxType);
+       ++type) {
+    auto datatype = static_cast<Datatype>(type);
+    if (!summary.containsDatatype(datatype)) {
+      continue;
+    }
+    Id lower = datatype == minType
+                   ? summary.min_
+                   : Id::fromBits(type << ValueId::numDataBits);
+    Id upper = datatype == maxType
+                   ? summary.max_
+                   : Id::fromBits(((type + 1) << ValueId::numDataBits) - 1);
+    if (mayBeTrueInRange(lower, upper)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 //______________________________________________________________________________
 ValueId PrefilterExpression::getValueIdFromIdOrLocalVocabEntry(
     const IdOrLocalVocabEntry& referenceValue, LocalVocab& vocab) {
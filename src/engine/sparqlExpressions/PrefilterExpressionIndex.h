@@ -133,6 +133,21 @@ class PrefilterExpression {
   BlockMetadataRanges evaluate(const Vocab& vocab, BlockMetadataSpan blockRange,
                                size_t evaluationColumn) const;
 
+  // Return the subset of the `blocks` for which the expression might be true
+  // for some value in the column `columnIndex`, judging only by the
+  // `ColumnSummary` of that column (see `CompressedBlockMetadata`). Unlike
+  // `evaluate`, this also works for columns that are not sorted. Blocks without
+  // a summary for the column are always kept.
+  BlockMetadataRanges evaluateOnColumnSummaries(
+      const Vocab& vocab, const BlockMetadataRanges& blocks,
+      size_t columnIndex) const;
+
+  // Return false if the expression is false for all the values of a column
+  // with the given `summary`.
+  bool mayBeTrueForColumnSummary(
+      const Vocab& vocab,
+      const CompressedBlockMetadata::ColumnSummary& summary) const;
+
   // `evaluateImpl` is internally used for the actual pre-filter procedure.
   // `ValueIdSubrange idRange` enables indirect access to all `ValueId`s at
   // column index `evaluationColumn` over the containerized `ql::span<const
@@ -14,6 +14,7 @@
 #include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
 #include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
 #include "engine/sparqlExpressions/StringExpressionsHelper.h"
+#include "engine/sparqlExpressions/VocabularyStringFilter.h"
 #include "global/ValueIdComparators.h"
 
 using namespace std::literals;
@@ -78,9 +79,10 @@ void ensureIsValidFlagIfConstant(const SparqlExpression& expression) {
   return Id::makeFromBool(RE2::PartialMatch(input.value(), *pattern));
 };
 
-using RegexExpression =
+using RegexExpression = ExpressionWithVocabularyFilter<
     string_expressions::StringExpressionImpl<2, decltype(regexImpl),
-                                             RegexValueGetter>;
+                                             RegexValueGetter>,
+    VocabularyStringFilter::Kind::Regex>;
 
 }  // namespace sparqlExpression::detail
 
@@ -328,6 +330,9 @@ PrefixRegexExpression::makePrefixRegexExpressionIfPossible(
 SparqlExpression::Ptr makeRegexExpression(SparqlExpression::Ptr string,
                                           SparqlExpression::Ptr regex,
                                           SparqlExpression::Ptr flags) {
+  // The constant value of the (merged) regex, which is needed for the
+  // evaluation via the `VocabularyStringFilter`.
+  auto constantRegex = VocabularyStringFilter::getConstantString(*regex);
   if (flags) {
     if (auto* stringLiteralExpression =
             dynamic_cast<const StringLiteralExpression*>(flags.get())) {
@@ -335,6 +340,14 @@ SparqlExpression::Ptr makeRegexExpression(SparqlExpression::Ptr string,
     }
     detail::ensureIsValidRegexIfConstant(*regex);
     detail::ensureIsValidFlagIfConstant(*flags);
+    auto constantFlags = VocabularyStringFilter::getConstantString(*flags);
+    if (constantRegex.has_value() && constantFlags.has_value() &&
+        !constantFlags.value().empty()) {
+      constantRegex = absl::StrCat("(?", constantFlags.value(), ":",
+                                   constantRegex.value(), ")");
+    } else if (!constantFlags.has_value()) {
+      constantRegex.reset();
+    }
     regex = makeMergeRegexPatternAndFlagsExpression(std::move(regex),
                                                     std::move(flags));
   } else if (auto prefixExpression =
@@ -345,8 +358,8 @@ SparqlExpression::Ptr makeRegexExpression(SparqlExpression::Ptr string,
   } else {
     detail::ensureIsValidRegexIfConstant(*regex);
   }
-  return std::make_unique<detail::RegexExpression>(std::move(string),
-                                                   std::move(regex));
+  return std::make_unique<detail::RegexExpression>(
+      std::move(string), std::move(regex), std::move(constantRegex));
 }
 
 }  // namespace sparqlExpression
@@ -10,6 +10,7 @@
 #include "engine/sparqlExpressions/NaryExpressionImpl.h"
 #include "engine/sparqlExpressions/StringExpressionsHelper.h"
 #include "engine/sparqlExpressions/VariadicExpression.h"
+#include "engine/sparqlExpressions/VocabularyStringFilter.h"
 
 namespace sparqlExpression {
 namespace detail::string_expressions {
@@ -288,8 +289,10 @@ CPP_template(typename NaryOperation)(
 
 }  // namespace
 
-using StrStartsExpression = StrStartsExpressionImpl<Operation<
-    2, FV<LiftStringFunction<decltype(strStartsImpl)>, StringValueGetter>>>;
+using StrStartsExpression = ExpressionWithVocabularyFilter<
+    StrStartsExpressionImpl<Operation<
+        2, FV<LiftStringFunction<decltype(strStartsImpl)>, StringValueGetter>>>,
+    VocabularyStringFilter::Kind::StrStarts>;
 
 // STRENDS
 [[maybe_unused]] auto strEndsImpl = [](std::string_view text,
@@ -307,9 +310,10 @@ using StrEndsExpression =
   return Id::makeFromBool(text.find(pattern) != std::string::npos);
 };
 
-using ContainsExpression =
+using ContainsExpression = ExpressionWithVocabularyFilter<
     StringExpressionImpl<2, LiftStringFunction<decltype(containsImpl)>,
-                         StringValueGetter>;
+                         StringValueGetter>,
+    VocabularyStringFilter::Kind::Contains>;
 
 // STRAFTER / STRBEFORE
 template <bool isStrAfter>
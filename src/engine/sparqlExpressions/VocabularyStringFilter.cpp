@@ -0,0 +1,174 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/sparqlExpressions/VocabularyStringFilter.h"
+
+#include <algorithm>
+
+#include "backports/algorithm.h"
+#include "engine/sparqlExpressions/LiteralExpression.h"
+#include "engine/sparqlExpressions/SparqlExpressionGenerators.h"
+#include "engine/sparqlExpressions/SparqlExpressionValueGetters.h"
+#include "index/Index.h"
+#include "index/VocabularyNgramIndex.h"
+
+namespace sparqlExpression {
+
+// _____________________________________________________________________________
+VocabularyStringFilter::VocabularyStringFilter(Kind kind, Variable variable,
+                                               bool literalsOnly,
+                                               std::string pattern)
+    : kind_{kind},
+      variable_{std::move(variable)},
+      literalsOnly_{literalsOnly},
+      pattern_{std::move(pattern)} {
+  if (kind_ == Kind::Regex) {
+    regex_ = std::make_shared<const RE2>(pattern_, RE2::Quiet);
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<std::string> VocabularyStringFilter::getConstantString(
+    const SparqlExpression& expression) {
+  auto literal = detail::getLiteralFromLiteralExpression(&expression);
+  if (!literal.has_value()) {
+    return std::nullopt;
+  }
+  return std::string{asStringViewUnsafe(literal.value().getContent())};
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<VocabularyStringFilter> VocabularyStringFilter::make(
+    Kind kind, const SparqlExpression& string,
+    const SparqlExpression& pattern) {
+  return make(kind, string, getConstantString(pattern));
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<VocabularyStringFilter> VocabularyStringFilter::make(
+    Kind kind, const SparqlExpression& string,
+    std::optional<std::string> pattern) {
+  if (!pattern.has_value()) {
+    return nullptr;
+  }
+  // `STRSTARTS` always uses the `StringValueGetter`, the other functions only
+  // if the argument is wrapped in `STR()`.
+  const SparqlExpression* variableExpression = &string;
+  bool literalsOnly = kind != Kind::StrStarts;
+  if (kind != Kind::StrStarts && string.isStrExpression()) {
+    AD_CORRECTNESS_CHECK(string.children().size() == 1);
+    variableExpression = string.children()[0].get();
+    literalsOnly = false;
+  }
+  auto variable = variableExpression->getVariableOrNullopt();
+  if (!variable.has_value()) {
+    return nullptr;
+  }
+  auto filter = std::make_unique<VocabularyStringFilter>(
+      kind, std::move(variable.value()), literalsOnly,
+      std::move(pattern.value()));
+  if (filter->regex_ != nullptr && !filter->regex_->ok()) {
+    return nullptr;
+  }
+  return filter;
+}
+
+// _____________________________________________________________________________
+bool VocabularyStringFilter::matchesString(std::string_view string) const {
+  switch (kind_) {
+    case Kind::Contains:
+      return string.find(pattern_) != std::string_view::npos;
+    case Kind::StrStarts:
+      return string.starts_with(pattern_);
+    case Kind::Regex:
+      return RE2::PartialMatch(string, *regex_);
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+Id VocabularyStringFilter::evaluateOnId(
+    Id id, const EvaluationContext* context) const {
+  auto string = literalsOnly_ ? LiteralFromIdGetter{}(id, context)
+                              : StringValueGetter{}(id, context);
+  if (!string.has_value()) {
+    return Id::makeUndefined();
+  }
+  return Id::makeFromBool(matchesString(string.value()));
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const std::vector<VocabIndex>>
+VocabularyStringFilter::getMatches(const VocabularyNgramIndex& ngramIndex,
+                                   const EvaluationContext* context) const {
+  auto state = state_.wlock();
+  if (state->matches_ != nullptr) {
+    return state->matches_;
+  }
+  // Checking a candidate is about as expensive as evaluating the filter on a
+  // single row, so we only use the index if there are not (much) more
+  // candidates than there are rows. This is checked by the index before any
+  // posting list is read. Otherwise, we try again for the next (possibly
+  // larger) input.
+  static constexpr size_t minNumCandidatesToCheck = 10'000;
+  size_t maxNumCandidates = std::max(context->size(), minNumCandidatesToCheck);
+  if (state->rejectedMaxNumCandidates_.has_value() &&
+      maxNumCandidates <= state->rejectedMaxNumCandidates_.value()) {
+    return nullptr;
+  }
+  auto candidates =
+      kind_ == Kind::Regex
+          ? ngramIndex.getCandidatesForRegex(pattern_, maxNumCandidates)
+          : ngramIndex.getCandidatesForSubstring(pattern_, maxNumCandidates);
+  if (!candidates.has_value()) {
+    state->rejectedMaxNumCandidates_ = maxNumCandidates;
+    return nullptr;
+  }
+  std::vector<VocabIndex> matches;
+  for (VocabIndex candidate : candidates.value()) {
+    auto result = evaluateOnId(Id::makeFromVocabIndex(candidate), context);
+    if (result.getDatatype() == Datatype::Bool && result.getBool()) {
+      matches.push_back(candidate);
+    }
+    context->cancellationHandle_->throwIfCancelled();
+  }
+  state->matches_ =
+      std::make_shared<const std::vector<VocabIndex>>(std::move(matches));
+  return state->matches_;
+}
+
+// _____________________________________________________________________________
+std::optional<ExpressionResult> VocabularyStringFilter::evaluate(
+    EvaluationContext* context) const {
+  const auto& index = context->_qec.getIndex();
+  const auto* ngramIndex = index.getVocabularyNgramIndex();
+  if (ngramIndex == nullptr ||
+      !context->getColumnIndexForVariable(variable_).has_value()) {
+    return std::nullopt;
+  }
+  auto matches = getMatches(*ngramIndex, context);
+  if (matches == nullptr) {
+    return std::nullopt;
+  }
+
+  const auto& vocab = index.getVocab();
+  auto resultSize = context->size();
+  VectorWithMemoryLimit<Id> result{context->_allocator};
+  result.reserve(resultSize);
+  for (Id id : detail::makeGenerator(variable_, resultSize, context)) {
+    if (id.getDatatype() != Datatype::VocabIndex) {
+      result.push_back(evaluateOnId(id, context));
+    } else if (literalsOnly_ && !vocab.isLiteral(id.getVocabIndex())) {
+      result.push_back(Id::makeUndefined());
+    } else {
+      result.push_back(Id::makeFromBool(
+          ql::ranges::binary_search(*matches, id.getVocabIndex())));
+    }
+    context->cancellationHandle_->throwIfCancelled();
+  }
+  return result;
+}
+
+}  // namespace sparqlExpression
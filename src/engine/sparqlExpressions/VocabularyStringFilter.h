@@ -0,0 +1,136 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VOCABULARYSTRINGFILTER_H
+#define QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VOCABULARYSTRINGFILTER_H
+
+#include <re2/re2.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "engine/sparqlExpressions/SparqlExpression.h"
+#include "global/VocabIndex.h"
+#include "util/Synchronized.h"
+
+class VocabularyNgramIndex;
+
+namespace sparqlExpression {
+
+// The evaluation of a string filter (`CONTAINS`, `STRSTARTS`, or `REGEX`) of a
+// single variable with a constant pattern via the `VocabularyNgramIndex`. The
+// candidates for the matching words are looked up in the trigram index, and
+// are checked once against the pattern. The resulting set of matching
+// `VocabIndex`es is then used for all the rows of the input, so the strings
+// of the vocabulary entries don't have to be read for each row.
+class VocabularyStringFilter {
+ public:
+  enum struct Kind { Contains, StrStarts, Regex };
+
+ private:
+  Kind kind_;
+  Variable variable_;
+  // If set, the string of an `Id` is obtained via the `LiteralFromIdGetter`
+  // (which yields `std::nullopt` for IRIs), else via the `StringValueGetter`.
+  // This corresponds to the string functions with and without `STR()`.
+  bool literalsOnly_;
+  std::string pattern_;
+  // Only used for `Kind::Regex`.
+  std::shared_ptr<const RE2> regex_;
+
+  struct State {
+    // The largest number of candidates for which the trigram index yielded
+    // no candidates (because there might be more of them, or because the
+    // index can't be used for the pattern), see `getMatches`.
+    std::optional<size_t> rejectedMaxNumCandidates_;
+    // The candidates that actually match, sorted.
+    std::shared_ptr<const std::vector<VocabIndex>> matches_;
+  };
+  mutable ad_utility::Synchronized<State, std::mutex> state_;
+
+ public:
+  VocabularyStringFilter(Kind kind, Variable variable, bool literalsOnly,
+                         std::string pattern);
+
+  // Return a filter if the `string` argument of the filter is a variable
+  // (possibly wrapped in `STR()`, except for `STRSTARTS`) and the `pattern` is
+  // a constant string, else `nullptr`.
+  static std::unique_ptr<VocabularyStringFilter> make(
+      Kind kind, const SparqlExpression& string,
+      std::optional<std::string> pattern);
+  static std::unique_ptr<VocabularyStringFilter> make(
+      Kind kind, const SparqlExpression& string,
+      const SparqlExpression& pattern);
+
+  // Return the content of the `expression` if it is a string literal.
+  static std::optional<std::string> getConstantString(
+      const SparqlExpression& expression);
+
+  // Evaluate the filter on the `context`. Return `std::nullopt` if the index
+  // has no `VocabularyNgramIndex` or if using it is not worthwhile (because
+  // there are many more candidates than rows of the input), in which case the
+  // expression has to be evaluated in the usual way.
+  std::optional<ExpressionResult> evaluate(EvaluationContext* context) const;
+
+ private:
+  // Return the matching `VocabIndex`es or `nullptr` (see `evaluate`).
+  std::shared_ptr<const std::vector<VocabIndex>> getMatches(
+      const VocabularyNgramIndex& ngramIndex,
+      const EvaluationContext* context) const;
+
+  // Check the pattern against the string of the `id`.
+  Id evaluateOnId(Id id, const EvaluationContext* context) const;
+  bool matchesString(std::string_view string) const;
+};
+
+// An expression for a string filter of the given `Kind`, which is evaluated
+// via the `VocabularyStringFilter` if possible, and else like the `Base`
+// expression (which is constructed from the string and the pattern argument).
+template <typename Base, VocabularyStringFilter::Kind kind>
+class ExpressionWithVocabularyFilter : public Base {
+ private:
+  std::unique_ptr<VocabularyStringFilter> vocabularyFilter_;
+
+  ExpressionWithVocabularyFilter(
+      std::unique_ptr<VocabularyStringFilter> vocabularyFilter,
+      SparqlExpression::Ptr&& string, SparqlExpression::Ptr&& pattern)
+      : Base{std::move(string), std::move(pattern)},
+        vocabularyFilter_{std::move(vocabularyFilter)} {}
+
+ public:
+  ExpressionWithVocabularyFilter(SparqlExpression::Ptr string,
+                                 SparqlExpression::Ptr pattern)
+      : ExpressionWithVocabularyFilter{
+            VocabularyStringFilter::make(kind, *string, *pattern),
+            std::move(string), std::move(pattern)} {}
+
+  // Constructor for the case that the constant value of the `pattern` is
+  // known, but the `pattern` is not a string literal (this is the case for a
+  // `REGEX` with flags).
+  ExpressionWithVocabularyFilter(SparqlExpression::Ptr string,
+                                 SparqlExpression::Ptr pattern,
+                                 std::optional<std::string> constantPattern)
+      : ExpressionWithVocabularyFilter{
+            VocabularyStringFilter::make(kind, *string,
+                                         std::move(constantPattern)),
+            std::move(string), std::move(pattern)} {}
+
+  // ___________________________________________________________________________
+  ExpressionResult evaluate(EvaluationContext* context) const override {
+    if (vocabularyFilter_ != nullptr) {
+      if (auto result = vocabularyFilter_->evaluate(context)) {
+        return std::move(result).value();
+      }
+    }
+    return Base::evaluate(context);
+  }
+};
+
+}  // namespace sparqlExpression
+
+#endif  // QLEVER_SRC_ENGINE_SPARQLEXPRESSIONS_VOCABULARYSTRINGFILTER_H
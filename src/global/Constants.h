@@ -233,6 +233,11 @@ constexpr inline std::string_view UNIT_MILE_IRI =
 constexpr std::string_view SF_PREFIX = "http://www.opengis.net/ont/sf#";
 
 constexpr inline std::string_view VOCAB_SUFFIX = ".vocabulary";
+constexpr inline std::string_view VOCABULARY_NGRAM_INDEX_SUFFIX =
+    ".vocabulary.trigrams";
+constexpr inline std::string_view SPATIAL_INDEX_SUFFIX = ".spatial-index";
+constexpr inline std::string_view REACHABILITY_INDEX_SUFFIX =
+    ".reachability-index";
 constexpr inline std::string_view MMAP_FILE_SUFFIX = ".meta";
 constexpr inline std::string_view CONFIGURATION_FILE = ".meta-data.json";
 
@@ -328,7 +333,6 @@ auto parallel_sort([[maybe_unused]] Args&&... args) {
 using parallel_tag = int;
 }  // namespace ad_utility
 #endif
-constexpr inline size_t NUM_SORT_THREADS = 4;
 /// ANSI escape sequence for bold text in the console
 constexpr inline std::string_view EMPH_ON = "\033[1m";
 /// ANSI escape sequence to print "normal" text again in the console.
@@ -21,20 +21,43 @@ RuntimeParameters::RuntimeParameters() {
 
   add(stripColumns_);
   add(sortEstimateCancellationFactor_);
+  add(externalSortMemoryFraction_);
   add(cacheMaxNumEntries_);
   add(cacheMaxSize_);
   add(cacheMaxSizeSingleEntry_);
+  add(decompressedBlockCacheMaxSize_);
+  add(exportVocabularyCacheMaxSize_);
   add(lazyIndexScanQueueSize_);
   add(lazyIndexScanNumThreads_);
+  add(lazyIndexScanNumBlocksPerRead_);
+  add(indexScanUseIoUring_);
+  add(indexScanDirectIo_);
+  add(expressionEvaluationNumThreads_);
   add(lazyIndexScanMaxSizeMaterialization_);
+  add(sortNumThreads_);
   add(useBinsearchTransitivePath_);
+  add(transitivePathNumThreads_);
+  add(transitivePathBidirectionalSearch_);
+  add(transitivePathReachabilityIndexOnDemand_);
+  add(transitivePathReachabilityIndexOnDemandMaxSize_);
   add(groupByHashMapEnabled_);
+  add(groupByHashMapNumThreads_);
+  add(hashJoinEnabled_);
   add(groupByDisableIndexScanOptimizations_);
   add(serviceMaxValueRows_);
   add(queryPlanningBudget_);
+  add(queryPlanCacheMaxNumEntries_);
+  add(diskResultCacheMaxSize_);
+  add(diskResultCacheWriteAll_);
   add(throwOnUnboundVariables_);
   add(cacheMaxSizeLazyResult_);
   add(websocketUpdatesEnabled_);
+  add(queryAdmissionControlEnabled_);
+  add(queryAdmissionMaxQueueSize_);
+  add(queryAdmissionMaxWaitTime_);
+  add(deltaTriplesCompactionMinTriplesPerBlock_);
+  add(persistUpdatesSyncInterval_);
+  add(persistUpdatesCheckpointThreshold_);
   add(smallIndexScanSizeEstimateDivisor_);
   add(zeroCostEstimateForCachedSubtree_);
   add(requestBodyLimit_);
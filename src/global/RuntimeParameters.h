@@ -37,24 +37,106 @@ struct RuntimeParameters {
   // timeout exception.
   Double sortEstimateCancellationFactor_{3.0,
                                          "sort-estimate-cancellation-factor"};
+  // If the estimated size of the input of a `Sort` or `OrderBy` operation is
+  // larger than this fraction of the memory that is currently left for query
+  // processing and the result is consumed lazily, then the sort is performed
+  // externally (in the temporary directory), see `ExternalSort.h`. By default,
+  // only inputs that don't fit into the remaining memory at all are sorted
+  // externally.
+  Double externalSortMemoryFraction_{1.0, "external-sort-memory-fraction"};
   SizeT cacheMaxNumEntries_{1000, "cache-max-num-entries"};
 
   MemorySizeParameter cacheMaxSize_{ad_utility::MemorySize::gigabytes(30),
                                     "cache-max-size"};
   MemorySizeParameter cacheMaxSizeSingleEntry_{
       ad_utility::MemorySize::gigabytes(5), "cache-max-size-single-entry"};
+  // The maximal total size of the decompressed blocks of the permutations that
+  // are kept in RAM, see `DecompressedBlockCache.h`. Zero disables the cache.
+  // This memory is not part of the memory limit for query processing, so the
+  // cache is disabled by default.
+  MemorySizeParameter decompressedBlockCacheMaxSize_{
+      ad_utility::MemorySize::bytes(0), "decompressed-block-cache-max-size"};
+  // The maximal total size of the words of the vocabulary that are kept in RAM
+  // when exporting query results, see `VocabularyStringCache.h`. Zero (the
+  // default) disables the cache, the words of a batch of rows are then still
+  // read once each and in the order of the vocabulary. The cache only pays off
+  // for vocabularies on disk, for a vocabulary in RAM it is just a copy.
+  MemorySizeParameter exportVocabularyCacheMaxSize_{
+      ad_utility::MemorySize::bytes(0), "export-vocabulary-cache-max-size"};
   SizeT lazyIndexScanQueueSize_{20, "lazy-index-scan-queue-size"};
   SizeT lazyIndexScanNumThreads_{10, "lazy-index-scan-num-threads"};
+  // The number of consecutive blocks that a lazy index scan reads from disk
+  // with a single batch of reads (see `BatchedFileReader.h`).
+  SizeT lazyIndexScanNumBlocksPerRead_{8,
+                                       "lazy-index-scan-num-blocks-per-read"};
+  // If set, the blocks of the permutations are read via `io_uring` (if the
+  // system supports it) instead of with one `pread` per compressed column.
+  Bool indexScanUseIoUring_{true, "index-scan-use-io-uring"};
+  // If set, the blocks of the permutations are read with `O_DIRECT`, s.t.
+  // large scans do not evict other data from the page cache of the operating
+  // system (the `DecompressedBlockCache` is unaffected).
+  Bool indexScanDirectIo_{false, "index-scan-direct-io"};
+  // The number of threads that are used to evaluate the expressions of
+  // `FILTER` and `BIND` on large inputs, see `MorselParallelism.h`. A value of
+  // 1 disables the parallel evaluation.
+  SizeT expressionEvaluationNumThreads_{1,
+                                        "expression-evaluation-num-threads"};
   Duration<std::chrono::seconds> defaultQueryTimeout_{std::chrono::seconds(30),
                                                       "default-query-timeout"};
   SizeT lazyIndexScanMaxSizeMaterialization_{
       1'000'000, "lazy-index-scan-max-size-materialization"};
+  // The number of threads that are used for sorting an `IdTable` in RAM. A
+  // value of 0 means that all available threads are used.
+  SizeT sortNumThreads_{4, "sort-num-threads"};
   Bool useBinsearchTransitivePath_{true, "use-binsearch-transitive-path"};
+  // The number of threads that compute the transitive hulls of the start nodes
+  // of a transitive path without a graph variable. A value of 1 disables the
+  // parallel computation.
+  SizeT transitivePathNumThreads_{1, "transitive-path-num-threads"};
+  // If set, a transitive path with a fixed target and no upper bound on the
+  // length is evaluated by a single search from the target over the reversed
+  // edges, which finds all the start nodes at once. With the same variable on
+  // both sides, a bidirectional breadth-first search from the start and the
+  // target node is used instead.
+  Bool transitivePathBidirectionalSearch_{
+      true, "transitive-path-bidirectional-search"};
+  // If set, a transitive path over the triples of a single predicate, for
+  // which the index has no precomputed `ReachabilityIndex`, builds one for
+  // that predicate, which is then reused by all later transitive paths over
+  // the same predicate.
+  Bool transitivePathReachabilityIndexOnDemand_{
+      false, "transitive-path-reachability-index-on-demand"};
+  // The maximal total size of the reachability indices that are built on
+  // demand (see above). The least recently used ones are evicted when this
+  // size is exceeded.
+  MemorySizeParameter transitivePathReachabilityIndexOnDemandMaxSize_{
+      ad_utility::MemorySize::gigabytes(1),
+      "transitive-path-reachability-index-on-demand-max-size"};
   Bool groupByHashMapEnabled_{false, "group-by-hash-map-enabled"};
+  // The number of threads that aggregate the input of a `GROUP BY` with the
+  // hash map optimization. A value larger than 1 also enables the hash map
+  // optimization, see `GroupByImpl::checkIfHashMapOptimizationPossible`. The
+  // order of the values of a `GROUP_CONCAT` is then not deterministic.
+  SizeT groupByHashMapNumThreads_{1, "group-by-hash-map-num-threads"};
+  // If set, the query planner also considers a `HashJoin` for joins where
+  // both inputs would otherwise have to be sorted first. It is only chosen if
+  // it is cheaper according to the cost estimates.
+  Bool hashJoinEnabled_{false, "hash-join-enabled"};
   Bool groupByDisableIndexScanOptimizations_{
       false, "group-by-disable-index-scan-optimizations"};
   SizeT serviceMaxValueRows_{10'000, "service-max-value-rows"};
   SizeT queryPlanningBudget_{1500, "query-planning-budget"};
+  // The maximal number of query plans that are kept for repeated queries, see
+  // `QueryPlanCache.h`. Zero disables the cache.
+  SizeT queryPlanCacheMaxNumEntries_{1000, "query-plan-cache-max-num-entries"};
+  // The maximal total size of the results in the second tier of the cache on
+  // disk, see `DiskResultCache.h`. The tier only exists if the server was
+  // started with `--disk-result-cache-dir`. With `disk-result-cache-write-all`,
+  // every computed result is written to that tier, and not only the results
+  // that are evicted from the cache in RAM.
+  MemorySizeParameter diskResultCacheMaxSize_{
+      ad_utility::MemorySize::gigabytes(10), "disk-result-cache-max-size"};
+  Bool diskResultCacheWriteAll_{false, "disk-result-cache-write-all"};
   Bool throwOnUnboundVariables_{false, "throw-on-unbound-variables"};
 
   // Control up until which size lazy results should be cached. Caching
@@ -62,6 +144,31 @@ struct RuntimeParameters {
   MemorySizeParameter cacheMaxSizeLazyResult_{
       ad_utility::MemorySize::megabytes(5), "cache-max-size-lazy-result"};
   Bool websocketUpdatesEnabled_{true, "websocket-updates-enabled"};
+  // If enabled, each query reserves the estimated size of its result from the
+  // memory limit of the server before it is executed, and waits in a queue if
+  // not enough memory is left, see `QueryAdmissionController`. Queries that
+  // wait longer than the max wait time or that arrive when the queue is full
+  // fail.
+  Bool queryAdmissionControlEnabled_{false, "query-admission-control-enabled"};
+  SizeT queryAdmissionMaxQueueSize_{64, "query-admission-max-queue-size"};
+  Duration<std::chrono::seconds> queryAdmissionMaxWaitTime_{
+      std::chrono::seconds(10), "query-admission-max-wait-time"};
+  // If larger than zero, then after each update all the blocks of the
+  // permutations with at least this many delta triples are rewritten with the
+  // delta triples merged in (in the background), see `DeltaTriples::compact`.
+  // The rewritten blocks are not persisted, so after a restart the delta
+  // triples are merged during the scans again until the next update.
+  SizeT deltaTriplesCompactionMinTriplesPerBlock_{
+      0, "delta-triples-compaction-min-triples-per-block"};
+  // With `--persist-updates`, each update request is appended to a write-ahead
+  // log. The log is synced to disk (`fsync`) after every n-th update request
+  // (0 means never, in which case the OS decides when the data is written).
+  // When the log becomes larger than the threshold, the complete delta triples
+  // are written to disk and the log is truncated.
+  SizeT persistUpdatesSyncInterval_{1, "persist-updates-sync-interval"};
+  MemorySizeParameter persistUpdatesCheckpointThreshold_{
+      ad_utility::MemorySize::megabytes(256),
+      "persist-updates-checkpoint-threshold"};
   // When the result of an index scan is smaller than a single block, then
   // its size estimate will be the size of the block divided by this
   // value.
@@ -6,12 +6,21 @@
 
 #include "CompressedRelation.h"
 
+#include <absl/strings/str_cat.h>
+
+#include <atomic>
+#include <deque>
+#include <filesystem>
+#include <numeric>
+#include <shared_mutex>
+
 #include "engine/Engine.h"
 #include "engine/idTable/CompressedExternalIdTable.h"
 #include "engine/idTable/IdTable.h"
 #include "global/RuntimeParameters.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "index/LocatedTriples.h"
+#include "util/BitPacking.h"
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/Iterators.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
@@ -82,6 +91,18 @@ bool CompressedBlockMetadataNoBlockIndex::isConsistentWith(
          getMaskedTriple(other.firstTriple_, columnIndex);
 }
 
+// _____________________________________________________________________________
+auto CompressedBlockMetadataNoBlockIndex::computeColumnSummaries(
+    const IdTable& block) -> std::vector<ColumnSummary> {
+  std::vector<ColumnSummary> summaries(block.numColumns());
+  for (size_t i = 0; i < block.numColumns(); ++i) {
+    for (Id id : block.getColumn(i)) {
+      summaries[i].add(id);
+    }
+  }
+  return summaries;
+}
+
 // Return true iff the `triple` is contained in the `scanSpec`. For example, the
 // triple ` 42 0 3 ` is contained in the specs `U U U`, `42 U U` and `42 0 U` ,
 // but not in `42 2 U` where `U` means "scan for all possible values".
@@ -157,6 +178,16 @@ CompressedRelationReader::asyncParallelBlockGenerator(
     ad_utility::Timer popTimer_{
         ad_utility::timer::Timer::InitialStatus::Stopped};
     std::mutex blockIteratorMutex_;
+    // A block that has been read from disk (see `prefetchBlocks`), but not yet
+    // decompressed. The `compressedBlock_` is `std::nullopt` if the block can
+    // be skipped because of the graph filter.
+    struct PrefetchedBlock {
+      size_t index_;
+      CompressedBlockMetadata metadata_;
+      CachedColumns cachedColumns_;
+      std::optional<CompressedBlock> compressedBlock_;
+    };
+    std::deque<PrefetchedBlock> prefetchedBlocks_;
     ad_utility::InputRangeTypeErased<
         std::optional<DecompressedBlockAndMetadata>>
         queue_;
@@ -189,41 +220,72 @@ CompressedRelationReader::asyncParallelBlockGenerator(
           queueSize, numThreads, producer);
     }
 
+    // Read the next (at most) `lazyIndexScanNumBlocksPerRead_` blocks with a
+    // single batch of reads and append them to the `prefetchedBlocks_`. Must
+    // be called while holding the `blockIteratorMutex_`.
+    void prefetchBlocks() {
+      auto numBlocks = std::max<size_t>(
+          1, getRuntimeParameter<
+                 &RuntimeParameters::lazyIndexScanNumBlocksPerRead_>());
+      std::vector<CompressedBlockMetadata> blocksToRead;
+      std::vector<CachedColumns> cachedColumns;
+      size_t firstNewBlock = prefetchedBlocks_.size();
+      for (size_t i = 0; i < numBlocks && blockMetadataIterator_ != endBlock_;
+           ++i, ++blockMetadataIterator_) {
+        // Note: taking a copy here is probably not necessary (the lifetime of
+        // all the blocks is long enough, so a `const&` would suffice), but the
+        // copy is cheap and makes the code more robust.
+        auto blockMetadata = *blockMetadataIterator_;
+        auto index = static_cast<size_t>(blockMetadataIterator_ - beginBlock_);
+        if (scanConfig_.graphFilter_.canBlockBeSkipped(blockMetadata)) {
+          prefetchedBlocks_.push_back({index, blockMetadata, {}, std::nullopt});
+          continue;
+        }
+        cachedColumns.push_back(
+            reader_->getCachedColumns(blockMetadata, scanConfig_.scanColumns_));
+        blocksToRead.push_back(blockMetadata);
+        prefetchedBlocks_.push_back(
+            {index, blockMetadata, cachedColumns.back(), CompressedBlock{}});
+      }
+      // Note: the reading of the blocks could also happen without holding the
+      // lock. We still perform it inside the lock to avoid contention of the
+      // file. The reads of one batch are processed concurrently by the
+      // operating system anyway.
+      auto compressedBlocks = reader_->readCompressedBlocksFromFile(
+          blocksToRead, scanConfig_.scanColumns_, cachedColumns);
+      auto compressedBlockIt = compressedBlocks.begin();
+      for (size_t i = firstNewBlock; i < prefetchedBlocks_.size(); ++i) {
+        auto& compressedBlock = prefetchedBlocks_[i].compressedBlock_;
+        if (compressedBlock.has_value()) {
+          compressedBlock = std::move(*compressedBlockIt);
+          ++compressedBlockIt;
+        }
+      }
+    }
+
     std::optional<
         std::pair<size_t, std::optional<DecompressedBlockAndMetadata>>>
     readAndDecompressBlock() {
       cancellationHandle_->throwIfCancelled();
       std::unique_lock lock{blockIteratorMutex_};
-      if (blockMetadataIterator_ == endBlock_) {
+      if (prefetchedBlocks_.empty()) {
+        prefetchBlocks();
+      }
+      if (prefetchedBlocks_.empty()) {
         return std::nullopt;
       }
+      auto block = std::move(prefetchedBlocks_.front());
+      prefetchedBlocks_.pop_front();
+      lock.unlock();
 
-      // Note: taking a copy here is probably not necessary (the lifetime of
-      // all the blocks is long enough, so a `const&` would suffice), but the
-      // copy is cheap and makes the code more robust.
-      auto blockMetadata = *blockMetadataIterator_;
-      // Note: The order of the following two lines is important: The index
-      // of the current blockMetadata depends on the current value of
-      // `blockMetadataIterator`, so we have to compute it before incrementing
-      // the iterator.
-      auto myIndex = static_cast<size_t>(blockMetadataIterator_ - beginBlock_);
-      ++blockMetadataIterator_;
-      if (scanConfig_.graphFilter_.canBlockBeSkipped(blockMetadata)) {
-        return std::pair{myIndex, std::nullopt};
+      if (!block.compressedBlock_.has_value()) {
+        return std::pair{block.index_, std::nullopt};
       }
-      // Note: the reading of the blockMetadata could also happen without
-      // holding the lock. We still perform it inside the lock to avoid
-      // contention of the file. On a fast SSD we could possibly change this,
-      // but this has to be investigated.
-      auto compressedBlock = reader_->readCompressedBlockFromFile(
-          blockMetadata, scanConfig_.scanColumns_);
-
-      lock.unlock();
       auto decompressedBlockAndMetadata =
-          reader_->decompressAndPostprocessBlock(compressedBlock,
-                                                 blockMetadata.numRows_,
-                                                 scanConfig_, blockMetadata);
-      return std::pair{myIndex,
+          reader_->decompressAndPostprocessBlock(
+              block.compressedBlock_.value(), block.cachedColumns_, scanConfig_,
+              block.metadata_);
+      return std::pair{block.index_,
                        std::optional{std::move(decompressedBlockAndMetadata)}};
     };
 
@@ -995,7 +1057,8 @@ CPP_template_def(typename IdGetter)(
 
   // TODO<joka921> We have to read the other columns for the merging of the
   // located triples. We could skip this for blocks with no updates, but that
-  // would require more arguments to the `decompressBlock` function.
+  // would require more arguments to the `decompressBlockAndUpdateCache`
+  // function.
   auto scanConfig = getScanConfig(scanSpec, {}, locatedTriplesPerBlock);
   // Iterate over the blocks and only read (and decompress) those which
   // contain more than one different `colId`. For the others, we can determine
@@ -1091,31 +1154,280 @@ void CompressedRelationWriter::writeBufferedRelationsToSingleBlock() {
   smallRelationsBuffer_.reserve(2 * blocksize());
 }
 
+// _____________________________________________________________________________
+auto CompressedRelationReader::getCachedColumns(
+    const CompressedBlockMetadata& blockMetaData,
+    ColumnIndicesRef columnIndices) const -> CachedColumns {
+  auto& cache = DecompressedBlockCache::global();
+  CachedColumns cachedColumns;
+  // If the cache is disabled (the default), an empty `CachedColumns` means
+  // that all the columns are read from disk.
+  if (!cache.isEnabled()) {
+    return cachedColumns;
+  }
+  cachedColumns.reserve(columnIndices.size());
+  for (ColumnIndex col : columnIndices) {
+    const auto& offset = blockMetaData.offsetsAndCompressedSize_.at(col);
+    cachedColumns.push_back(cache.get({cacheId_, offset.offsetInFile_}));
+  }
+  return cachedColumns;
+}
+
 // _____________________________________________________________________________
 CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
     const CompressedBlockMetadata& blockMetaData,
-    ColumnIndicesRef columnIndices) const {
-  CompressedBlock compressedBuffer;
-  compressedBuffer.resize(columnIndices.size());
+    ColumnIndicesRef columnIndices, const CachedColumns& cachedColumns) const {
+  auto compressedBlocks =
+      readCompressedBlocksFromFile({&blockMetaData, 1}, columnIndices,
+                                   {&cachedColumns, 1});
+  return std::move(compressedBlocks.front());
+}
+
+// _____________________________________________________________________________
+std::vector<CompressedBlock>
+CompressedRelationReader::readCompressedBlocksFromFile(
+    ql::span<const CompressedBlockMetadata> blockMetadata,
+    ColumnIndicesRef columnIndices,
+    ql::span<const CachedColumns> cachedColumns) const {
+  AD_CONTRACT_CHECK(cachedColumns.size() == blockMetadata.size());
+  std::vector<CompressedBlock> compressedBlocks(blockMetadata.size());
+  // The reads from the `file_`, which are performed at once at the end. The
+  // target buffers are not resized after they have been added here.
+  std::vector<ad_utility::BatchedFileReader::ReadRequest> requests;
   // TODO<C++23> Use `ql::views::zip`
-  for (size_t i = 0; i < compressedBuffer.size(); ++i) {
-    const auto& offset =
-        blockMetaData.offsetsAndCompressedSize_.at(columnIndices[i]);
-    auto& currentCol = compressedBuffer[i];
-    currentCol.resize(offset.compressedSize_);
-    file_.read(currentCol.data(), offset.compressedSize_, offset.offsetInFile_);
+  for (size_t blockIdx = 0; blockIdx < blockMetadata.size(); ++blockIdx) {
+    const auto& cached = cachedColumns[blockIdx];
+    auto& compressedBuffer = compressedBlocks[blockIdx];
+    compressedBuffer.resize(columnIndices.size());
+    for (size_t i = 0; i < compressedBuffer.size(); ++i) {
+      if (i < cached.size() && cached[i] != nullptr) {
+        continue;
+      }
+      const auto& offset = blockMetadata[blockIdx].offsetsAndCompressedSize_.at(
+          columnIndices[i]);
+      auto& currentCol = compressedBuffer[i];
+      currentCol.resize(offset.compressedSize_);
+      if (offset.offsetInFile_ >= CompactedBlocksFile::OFFSET) {
+        auto [file, offsetInFile] =
+            CompactedBlocksFile::getFileAndOffset(offset.offsetInFile_);
+        file->file().read(currentCol.data(), offset.compressedSize_,
+                          offsetInFile);
+      } else if (batchedFileReader_ != nullptr) {
+        requests.push_back(
+            {currentCol.data(), offset.compressedSize_, offset.offsetInFile_});
+      } else {
+        file_.read(currentCol.data(), offset.compressedSize_,
+                   offset.offsetInFile_);
+      }
+    }
+  }
+  if (!requests.empty()) {
+    batchedFileReader_->read(
+        requests,
+        {getRuntimeParameter<&RuntimeParameters::indexScanUseIoUring_>(),
+         getRuntimeParameter<&RuntimeParameters::indexScanDirectIo_>()});
+  }
+  return compressedBlocks;
+}
+
+// ____________________________________________________________________________
+DecompressedBlock CompressedRelationReader::readBlock(
+    const CompressedBlockMetadata& blockMetadata) const {
+  ColumnIndices columns(blockMetadata.offsetsAndCompressedSize_.size());
+  std::iota(columns.begin(), columns.end(), ColumnIndex{0});
+  auto cachedColumns = getCachedColumns(blockMetadata, columns);
+  auto compressedBlock =
+      readCompressedBlockFromFile(blockMetadata, columns, cachedColumns);
+  return decompressBlockAndUpdateCache(compressedBlock, cachedColumns,
+                                       blockMetadata, columns);
+}
+
+namespace {
+// All the `CompactedBlocksFile`s that might still be in use, by their
+// generation, see `CompactedBlocksFile::getFileAndOffset`. The files remove
+// themselves when they are destroyed.
+auto& compactedBlocksFiles() {
+  static ad_utility::Synchronized<
+      ad_utility::HashMap<size_t, std::weak_ptr<const CompactedBlocksFile>>,
+      std::shared_mutex>
+      files;
+  return files;
+}
+}  // namespace
+
+// ____________________________________________________________________________
+std::shared_ptr<const CompactedBlocksFile> CompactedBlocksFile::create(
+    const std::string& filenamePrefix) {
+  AD_CONTRACT_CHECK(!filenamePrefix.empty(),
+                    "No file for compacted blocks was specified for this "
+                    "permutation");
+  static std::atomic<size_t> nextGeneration = 0;
+  size_t generation = nextGeneration++;
+  AD_CORRECTNESS_CHECK(generation < MAX_NUM_GENERATIONS);
+  auto file = std::make_shared<const CompactedBlocksFile>(
+      absl::StrCat(filenamePrefix, ".", generation), generation);
+  compactedBlocksFiles().wlock()->emplace(generation, file);
+  return file;
+}
+
+// ____________________________________________________________________________
+void CompactedBlocksFile::removeAll(const std::string& filenamePrefix) {
+  std::filesystem::path prefix{filenamePrefix};
+  auto directory = prefix.parent_path().empty() ? std::filesystem::path{"."}
+                                                : prefix.parent_path();
+  std::string namePrefix = absl::StrCat(prefix.filename().string(), ".");
+  std::error_code errorCode;
+  for (const auto& entry :
+       std::filesystem::directory_iterator{directory, errorCode}) {
+    if (entry.path().filename().string().starts_with(namePrefix)) {
+      std::filesystem::remove(entry.path(), errorCode);
+    }
+  }
+}
+
+// ____________________________________________________________________________
+CompactedBlocksFile::CompactedBlocksFile(const std::string& filename,
+                                         size_t generation)
+    : generation_{generation} {
+  // Create (or truncate) the file before opening it for reading.
+  ad_utility::File{filename, "w"};
+  file_.open(filename, "r");
+}
+
+// ____________________________________________________________________________
+CompactedBlocksFile::~CompactedBlocksFile() {
+  compactedBlocksFiles().wlock()->erase(generation_);
+  std::string filename = file_.name();
+  file_.close();
+  std::error_code errorCode;
+  std::filesystem::remove(filename, errorCode);
+}
+
+// ____________________________________________________________________________
+size_t CompactedBlocksFile::size() const {
+  return std::filesystem::file_size(file_.name());
+}
+
+// ____________________________________________________________________________
+bool CompactedBlocksFile::isCompactedBlock(
+    const CompressedBlockMetadata& blockMetadata) {
+  const auto& offsets = blockMetadata.offsetsAndCompressedSize_;
+  return !offsets.empty() && offsets.front().offsetInFile_ >= OFFSET;
+}
+
+// ____________________________________________________________________________
+void CompactedBlocksFile::shiftOffsets(
+    CompressedBlockMetadata& blockMetadata) const {
+  off_t shift = OFFSET + (static_cast<off_t>(generation_) << GENERATION_SHIFT);
+  for (auto& offset : blockMetadata.offsetsAndCompressedSize_) {
+    AD_CORRECTNESS_CHECK(
+        offset.offsetInFile_ + static_cast<off_t>(offset.compressedSize_) <=
+        off_t{1} << GENERATION_SHIFT);
+    offset.offsetInFile_ += shift;
+  }
+}
+
+// ____________________________________________________________________________
+std::pair<std::shared_ptr<const CompactedBlocksFile>, off_t>
+CompactedBlocksFile::getFileAndOffset(off_t offsetInFile) {
+  AD_CORRECTNESS_CHECK(offsetInFile >= OFFSET);
+  offsetInFile -= OFFSET;
+  size_t generation = static_cast<size_t>(offsetInFile) >> GENERATION_SHIFT;
+  auto file = compactedBlocksFiles().withReadLock(
+      [generation](const auto& files) {
+        auto it = files.find(generation);
+        return it == files.end() ? std::shared_ptr<const CompactedBlocksFile>{}
+                                 : it->second.lock();
+      });
+  AD_CORRECTNESS_CHECK(file != nullptr);
+  return {std::move(file),
+          offsetInFile & ((off_t{1} << GENERATION_SHIFT) - 1)};
+}
+
+// ____________________________________________________________________________
+CompressedBlockMetadata CompactedBlocksFile::append(const IdTable& block,
+                                                    size_t blockIndex) const {
+  ad_utility::File outfile{file_.name(), "a"};
+  outfile.seek(0, SEEK_END);
+  auto metadata = [&]() {
+    // The destructor of the writer closes (and thus flushes) the file.
+    CompressedRelationWriter writer{
+        block.numColumns(), std::move(outfile),
+        ad_utility::MemorySize::bytes(block.numRows() * sizeof(Id))};
+    return writer.writeSingleBlock(block, blockIndex);
+  }();
+  shiftOffsets(metadata);
+  return metadata;
+}
+
+// ____________________________________________________________________________
+std::vector<CompressedBlockMetadata> CompactedBlocksFile::appendCopies(
+    const std::vector<CompressedBlockMetadata>& blocks) const {
+  ad_utility::File outfile{file_.name(), "a"};
+  auto offsetInNewFile = static_cast<off_t>(size());
+  std::vector<CompressedBlockMetadata> result;
+  std::vector<char> buffer;
+  for (auto blockMetadata : blocks) {
+    AD_CONTRACT_CHECK(isCompactedBlock(blockMetadata));
+    for (auto& offset : blockMetadata.offsetsAndCompressedSize_) {
+      auto [file, offsetInFile] = getFileAndOffset(offset.offsetInFile_);
+      buffer.resize(offset.compressedSize_);
+      AD_CORRECTNESS_CHECK(file->file().read(buffer.data(), buffer.size(),
+                                             offsetInFile) ==
+                           static_cast<ssize_t>(buffer.size()));
+      AD_CORRECTNESS_CHECK(outfile.write(buffer.data(), buffer.size()) ==
+                           buffer.size());
+      offset.offsetInFile_ = offsetInNewFile;
+      offsetInNewFile += static_cast<off_t>(buffer.size());
+    }
+    shiftOffsets(blockMetadata);
+    result.push_back(std::move(blockMetadata));
   }
-  return compressedBuffer;
+  return result;
 }
 
 // ____________________________________________________________________________
-DecompressedBlock CompressedRelationReader::decompressBlock(
-    const CompressedBlock& compressedBlock, size_t numRowsToRead) const {
+bool CompactedBlocksFile::shouldBeReclaimed(
+    const std::vector<CompressedBlockMetadata>& usedBlocks) const {
+  size_t numUsedBytes = 0;
+  for (const auto& block : usedBlocks) {
+    for (const auto& offset : block.offsetsAndCompressedSize_) {
+      // Blocks in older files keep these files alive, so copy them as well.
+      if (getFileAndOffset(offset.offsetInFile_).first.get() != this) {
+        return true;
+      }
+      numUsedBytes += offset.compressedSize_;
+    }
+  }
+  return size() > 2 * numUsedBytes;
+}
+
+// ____________________________________________________________________________
+DecompressedBlock CompressedRelationReader::decompressBlockAndUpdateCache(
+    const CompressedBlock& compressedBlock, const CachedColumns& cachedColumns,
+    const CompressedBlockMetadata& metadata,
+    ColumnIndicesRef columnIndices) const {
+  AD_CORRECTNESS_CHECK(compressedBlock.size() == columnIndices.size());
+  auto& cache = DecompressedBlockCache::global();
+  size_t numRowsToRead = metadata.numRows_;
   DecompressedBlock decompressedBlock{compressedBlock.size(), allocator_};
   decompressedBlock.resize(numRowsToRead);
   for (size_t i = 0; i < compressedBlock.size(); ++i) {
     auto col = decompressedBlock.getColumn(i);
-    decompressColumn(compressedBlock[i], numRowsToRead, col.data());
+    if (i < cachedColumns.size() && cachedColumns[i] != nullptr) {
+      AD_CORRECTNESS_CHECK(cachedColumns[i]->size() == numRowsToRead);
+      ql::ranges::copy(*cachedColumns[i], col.begin());
+      continue;
+    }
+    const auto& offset =
+        metadata.offsetsAndCompressedSize_.at(columnIndices[i]);
+    decompressColumn(compressedBlock[i], offset.codec_, numRowsToRead,
+                     col.data());
+    // Only copy the column if the cache can actually store it.
+    if (cache.canStoreColumn(col.size())) {
+      cache.insert({cacheId_, offset.offsetInFile_},
+                   DecompressedBlockCache::Column(col.begin(), col.end()));
+    }
   }
   return decompressedBlock;
 }
@@ -1123,10 +1435,13 @@ DecompressedBlock CompressedRelationReader::decompressBlock(
 // ____________________________________________________________________________
 DecompressedBlockAndMetadata
 CompressedRelationReader::decompressAndPostprocessBlock(
-    const CompressedBlock& compressedBlock, size_t numRowsToRead,
+    const CompressedBlock& compressedBlock, const CachedColumns& cachedColumns,
     const CompressedRelationReader::ScanImplConfig& scanConfig,
     const CompressedBlockMetadata& metadata) const {
-  auto decompressedBlock = decompressBlock(compressedBlock, numRowsToRead);
+  // Note: The located triples are merged only after taking the columns from
+  // the cache, so the cached columns never contain any updates.
+  auto decompressedBlock = decompressBlockAndUpdateCache(
+      compressedBlock, cachedColumns, metadata, scanConfig.scanColumns_);
   auto [numIndexColumns, includeGraphColumn] =
       prepareLocatedTriples(scanConfig.scanColumns_);
   bool hasUpdates = false;
@@ -1144,8 +1459,16 @@ CompressedRelationReader::decompressAndPostprocessBlock(
 // ____________________________________________________________________________
 template <typename Iterator>
 void CompressedRelationReader::decompressColumn(
-    const std::vector<char>& compressedBlock, size_t numRowsToRead,
-    Iterator iterator) {
+    const std::vector<char>& compressedBlock,
+    CompressedBlockMetadata::OffsetAndCompressedSize::Codec codec,
+    size_t numRowsToRead, Iterator iterator) {
+  using Codec = CompressedBlockMetadata::OffsetAndCompressedSize::Codec;
+  if (codec == Codec::BitPacking) {
+    ad_utility::BitPacking::decode(compressedBlock, numRowsToRead, iterator,
+                                   &Id::fromBits);
+    return;
+  }
+  AD_CORRECTNESS_CHECK(codec == Codec::Zstd);
   auto numBytesActuallyRead = ZstdWrapper::decompressToBuffer(
       compressedBlock.data(), compressedBlock.size(), iterator,
       numRowsToRead * sizeof(*iterator));
@@ -1161,23 +1484,43 @@ CompressedRelationReader::readAndDecompressBlock(
   if (scanConfig.graphFilter_.canBlockBeSkipped(blockMetaData)) {
     return std::nullopt;
   }
-  CompressedBlock compressedColumns =
-      readCompressedBlockFromFile(blockMetaData, scanConfig.scanColumns_);
-  const auto numRowsToRead = blockMetaData.numRows_;
-  return decompressAndPostprocessBlock(compressedColumns, numRowsToRead,
+  auto cachedColumns =
+      getCachedColumns(blockMetaData, scanConfig.scanColumns_);
+  CompressedBlock compressedColumns = readCompressedBlockFromFile(
+      blockMetaData, scanConfig.scanColumns_, cachedColumns);
+  return decompressAndPostprocessBlock(compressedColumns, cachedColumns,
                                        scanConfig, blockMetaData);
 }
 
+// ____________________________________________________________________________
+auto CompressedRelationWriter::chooseCodecAndCompress(
+    ql::span<const Id> column)
+    -> std::pair<CompressedBlockMetadata::OffsetAndCompressedSize::Codec,
+                 std::vector<char>> {
+  using Codec = CompressedBlockMetadata::OffsetAndCompressedSize::Codec;
+  std::vector<char> zstdResult = ZstdWrapper::compress(
+      (void*)(column.data()), column.size() * sizeof(column[0]));
+  std::vector<uint64_t> bits;
+  bits.reserve(column.size());
+  ql::ranges::transform(column, std::back_inserter(bits),
+                        [](Id id) { return id.getBits(); });
+  std::vector<char> bitPackingResult = ad_utility::BitPacking::encode(bits);
+  if (static_cast<double>(bitPackingResult.size()) <=
+      MAX_BIT_PACKING_OVERHEAD * static_cast<double>(zstdResult.size())) {
+    return {Codec::BitPacking, std::move(bitPackingResult)};
+  }
+  return {Codec::Zstd, std::move(zstdResult)};
+}
+
 // ____________________________________________________________________________
 CompressedBlockMetadata::OffsetAndCompressedSize
 CompressedRelationWriter::compressAndWriteColumn(ql::span<const Id> column) {
-  std::vector<char> compressedBlock = ZstdWrapper::compress(
-      (void*)(column.data()), column.size() * sizeof(column[0]));
+  auto [codec, compressedBlock] = chooseCodecAndCompress(column);
   auto compressedSize = compressedBlock.size();
   auto file = outfile_.wlock();
   auto offsetInFile = file->tell();
   file->write(compressedBlock.data(), compressedBlock.size());
-  return {offsetInFile, compressedSize};
+  return {offsetInFile, compressedSize, codec};
 };
 
 // Find out whether the sorted `block` contains duplicates and whether it
@@ -1245,7 +1588,8 @@ void CompressedRelationWriter::compressAndWriteBlock(Id firstCol0Id,
         {first[0], first[1], first[2], first[3]},
         {last[0], last[1], last[2], last[3]},
         std::move(graphInfo),
-        hasDuplicates});
+        hasDuplicates,
+        CompressedBlockMetadataNoBlockIndex::computeColumnSummaries(block)});
     if (invokeCallback && smallBlocksCallback_) {
       std::invoke(smallBlocksCallback_, std::move(block));
     }
@@ -1253,6 +1597,28 @@ void CompressedRelationWriter::compressAndWriteBlock(Id firstCol0Id,
   timer.stop();
 }
 
+// _____________________________________________________________________________
+CompressedBlockMetadata CompressedRelationWriter::writeSingleBlock(
+    const IdTable& block, size_t blockIndex) {
+  AD_CONTRACT_CHECK(!block.empty());
+  AD_CONTRACT_CHECK(block.numColumns() == numColumns());
+  std::vector<CompressedBlockMetadata::OffsetAndCompressedSize> offsets;
+  for (const auto& column : block.getColumns()) {
+    offsets.push_back(compressAndWriteColumn(column));
+  }
+  const auto& first = block[0];
+  const auto& last = block[block.numRows() - 1];
+  auto [hasDuplicates, graphInfo] = getGraphInfo(block);
+  return {{std::move(offsets),
+           block.numRows(),
+           {first[0], first[1], first[2], first[3]},
+           {last[0], last[1], last[2], last[3]},
+           std::move(graphInfo),
+           hasDuplicates,
+           CompressedBlockMetadataNoBlockIndex::computeColumnSummaries(block)},
+          blockIndex};
+}
+
 // _____________________________________________________________________________
 size_t CompressedRelationReader::getNumberOfBlockMetadataValues(
     const BlockMetadataRanges& blockMetadata) {
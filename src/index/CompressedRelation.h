@@ -11,17 +11,21 @@
 #include "backports/type_traits.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "index/DecompressedBlockCache.h"
 #include "index/KeyOrder.h"
 #include "index/ScanSpecification.h"
 #include "parser/data/LimitOffsetClause.h"
+#include "util/BatchedFileReader.h"
 #include "util/CancellationHandle.h"
 #include "util/File.h"
 #include "util/Generator.h"
+#include "util/HashMap.h"
 #include "util/MemorySize/MemorySize.h"
 #include "util/Serializer/SerializeArrayOrTuple.h"
 #include "util/Serializer/SerializeOptional.h"
 #include "util/Serializer/SerializeVector.h"
 #include "util/Serializer/Serializer.h"
+#include "util/Synchronized.h"
 #include "util/TaskQueue.h"
 
 // Forward declarations
@@ -57,9 +61,19 @@ struct CompressedBlockMetadataNoBlockIndex {
   // Since we have column-based indices, the two columns of each block are
   // stored separately (but adjacently).
   struct OffsetAndCompressedSize {
+    // The compression scheme of a single column. `BitPacking` is a
+    // lightweight integer encoding (frame of reference with optional delta
+    // encoding, see `util/BitPacking.h`) that is much faster to decode than
+    // zstd. The codec is chosen per column when the index is built.
+    enum struct Codec : uint8_t { Zstd = 0, BitPacking = 1 };
+
     off_t offsetInFile_;
     size_t compressedSize_;
+    Codec codec_ = Codec::Zstd;
     bool operator==(const OffsetAndCompressedSize&) const = default;
+
+    template <typename T>
+    friend std::true_type allowTrivialSerialization(Codec, T);
   };
 
   using GraphInfo = std::optional<std::vector<Id>>;
@@ -116,6 +130,48 @@ struct CompressedBlockMetadataNoBlockIndex {
   // blocks.
   bool containsDuplicatesWithDifferentGraphs_;
 
+  // A summary ("zone map") of the values of a single column of the block: the
+  // smallest and the largest `Id` and the set of the contained `Datatype`s.
+  // Unlike the `firstTriple_` and `lastTriple_`, the summaries also bound the
+  // columns which are not sorted within the block, such that blocks can be
+  // skipped for filters and joins on those columns.
+  struct ColumnSummary {
+    Id min_ = Id::max();
+    Id max_ = Id::min();
+    // Bit `i` is set iff the column contains an `Id` with the `Datatype` `i`.
+    uint16_t datatypes_ = 0;
+    static_assert(static_cast<size_t>(Datatype::MaxValue) < 16);
+
+    // Add the `id` to the summary.
+    void add(Id id) {
+      min_ = std::min(min_, id);
+      max_ = std::max(max_, id);
+      datatypes_ |= uint16_t{1} << static_cast<unsigned>(id.getDatatype());
+    }
+
+    bool containsDatatype(Datatype datatype) const {
+      return (datatypes_ >> static_cast<unsigned>(datatype)) & 1;
+    }
+
+    bool operator==(const ColumnSummary&) const = default;
+  };
+  // The summaries of the columns of the block, in the same order as the
+  // `offsetsAndCompressedSize_`. Nothing is known about the columns that have
+  // no summary (for example, because the vector is empty).
+  std::vector<ColumnSummary> columnSummaries_{};
+
+  // Return the summary of the column with the given index, or `nullptr` if
+  // there is none.
+  const ColumnSummary* getColumnSummary(size_t columnIndex) const {
+    return columnIndex < columnSummaries_.size()
+               ? &columnSummaries_[columnIndex]
+               : nullptr;
+  }
+
+  // Compute the `columnSummaries_` for all the columns of the `block`.
+  static std::vector<ColumnSummary> computeColumnSummaries(
+      const IdTable& block);
+
   // Check for constant values in `firstTriple_` and `lastTriple` over all
   // columns `< columnIndex`.
   // Returns `true` if the respective column values of `firstTriple_` and
@@ -186,6 +242,14 @@ struct CompressedBlockMetadata : CompressedBlockMetadataNoBlockIndex {
 AD_SERIALIZE_FUNCTION(CompressedBlockMetadata::OffsetAndCompressedSize) {
   serializer | arg.offsetInFile_;
   serializer | arg.compressedSize_;
+  serializer | arg.codec_;
+}
+
+// Serialization of the `ColumnSummary` subclass.
+AD_SERIALIZE_FUNCTION(CompressedBlockMetadata::ColumnSummary) {
+  serializer | arg.min_;
+  serializer | arg.max_;
+  serializer | arg.datatypes_;
 }
 
 // Serialization of the block metadata.
@@ -196,6 +260,7 @@ AD_SERIALIZE_FUNCTION(CompressedBlockMetadata) {
   serializer | arg.lastTriple_;
   serializer | arg.graphInfo_;
   serializer | arg.containsDuplicatesWithDifferentGraphs_;
+  serializer | arg.columnSummaries_;
   serializer | arg.blockIndex_;
 }
 
@@ -276,7 +341,8 @@ class CompressedRelationWriter {
   Id currentCol0Id_ = Id::makeUndefined();
   size_t currentRelationPreviousSize_ = 0;
 
-  ad_utility::TaskQueue<false> blockWriteQueue_{20, 10};
+  // The queue for compressing and writing the blocks in parallel.
+  ad_utility::TaskQueue<false> blockWriteQueue_;
   ad_utility::timer::ThreadSafeTimer blockWriteQueueTimer_;
 
   // This callback is invoked for each block of small relations (which share the
@@ -290,13 +356,20 @@ class CompressedRelationWriter {
   static constexpr float multiplicityDummy = 42.4242f;
 
  public:
+  // The default number of threads that compress and write the blocks.
+  static constexpr size_t DEFAULT_NUM_THREADS = 10;
+
   /// Create using a filename, to which the relation data will be written.
+  /// The blocks are compressed and written by `numThreads` threads.
   explicit CompressedRelationWriter(
       size_t numColumns, ad_utility::File f,
-      ad_utility::MemorySize uncompressedBlocksizePerColumn)
+      ad_utility::MemorySize uncompressedBlocksizePerColumn,
+      size_t numThreads = DEFAULT_NUM_THREADS)
       : outfile_{std::move(f)},
         numColumns_{numColumns},
-        uncompressedBlocksizePerColumn_{uncompressedBlocksizePerColumn} {}
+        uncompressedBlocksizePerColumn_{uncompressedBlocksizePerColumn},
+        blockWriteQueue_{2 * std::max(numThreads, size_t{1}),
+                         std::max(numThreads, size_t{1})} {}
   // Two helper types used to make the interface of the function
   // `createPermutationPair` below safer and more explicit.
   using MetadataCallback =
@@ -374,6 +447,24 @@ class CompressedRelationWriter {
         size_t{uncompressedBlocksizePerColumn_.getBytes() / sizeof(Id)});
   }
 
+  // Compress the `column` with both zstd and `BitPacking` and return the
+  // codec and the result of the better alternative. As decoding the
+  // `BitPacking` is much faster, it is preferred unless its result is more than
+  // `MAX_BIT_PACKING_OVERHEAD` times larger than the result of zstd.
+  static constexpr double MAX_BIT_PACKING_OVERHEAD = 1.1;
+  static std::pair<CompressedBlockMetadata::OffsetAndCompressedSize::Codec,
+                   std::vector<char>>
+  chooseCodecAndCompress(ql::span<const Id> column);
+
+  // Compress the given `block` (which must be sorted and non-empty) and
+  // synchronously write it to the `outfile_`. Return the metadata of the
+  // written block, which gets the given `blockIndex`. Unlike the functions
+  // above, this doesn't know about relations. It is used to rewrite single
+  // blocks of an existing permutation, see
+  // `CompactedBlocksFile::append`.
+  CompressedBlockMetadata writeSingleBlock(const IdTable& block,
+                                           size_t blockIndex);
+
  private:
   /// Finish writing all relations which have previously been added, but might
   /// still be in some internal buffer.
@@ -392,7 +483,8 @@ class CompressedRelationWriter {
   void writeBufferedRelationsToSingleBlock();
 
   // Compress the `column` and write it to the `outfile_`. Return the offset and
-  // size of the compressed column in the `outfile_`.
+  // size of the compressed column in the `outfile_`, and the codec that was
+  // used (see `chooseCodecAndCompress`).
   CompressedBlockMetadata::OffsetAndCompressedSize compressAndWriteColumn(
       ql::span<const Id> column);
 
@@ -450,6 +542,96 @@ class CompressedRelationWriter {
 
 using namespace std::string_view_literals;
 
+// A file for the blocks of a permutation into which the located triples of the
+// `DeltaTriples` have been merged, see `DeltaTriples::prepareCompaction`. The
+// file is owned by the `LocatedTriplesPerBlock` whose metadata refers to its
+// blocks (and thus by the `DeltaTriples` and their snapshots), and removed when
+// it is no longer used, in particular when the server is shut down. The
+// compacted blocks are not persisted between restarts (the delta triples
+// themselves are).
+//
+// Each file has a unique `generation` (for the lifetime of the process), which
+// is stored in the offsets of its blocks, s.t. the `CompressedRelationReader`
+// can find the file of a block via `getFileAndOffset`. To reclaim the space of
+// the compacted blocks that are no longer used, the blocks that are still used
+// are regularly copied to a new file.
+class CompactedBlocksFile {
+ private:
+  ad_utility::File file_;
+  size_t generation_;
+
+ public:
+  // The offsets of the compacted blocks are shifted by this value, to
+  // distinguish them from the offsets in the file of the permutation (which
+  // also keeps the keys in the `DecompressedBlockCache` unique). The bits from
+  // `GENERATION_SHIFT` upwards store the generation of the file, the bits
+  // below store the offset in that file.
+  static constexpr off_t OFFSET = off_t{1} << 62;
+  static constexpr size_t GENERATION_SHIFT = 40;
+  static constexpr size_t MAX_NUM_GENERATIONS = size_t{1} << 22;
+
+  // Create a new (empty) file with the next generation, the name of which is
+  // `filenamePrefix` followed by the generation.
+  static std::shared_ptr<const CompactedBlocksFile> create(
+      const std::string& filenamePrefix);
+
+  // Remove all the files that were created with the `filenamePrefix`, also by
+  // previous processes that were not shut down properly. Must not be called
+  // while any of these files is used.
+  static void removeAll(const std::string& filenamePrefix);
+
+  // Use `create`.
+  CompactedBlocksFile(const std::string& filename, size_t generation);
+  ~CompactedBlocksFile();
+
+  CompactedBlocksFile(const CompactedBlocksFile&) = delete;
+  CompactedBlocksFile& operator=(const CompactedBlocksFile&) = delete;
+
+  // The file, opened for reading. The blocks are appended via separate file
+  // handles.
+  const ad_utility::File& file() const { return file_; }
+  size_t generation() const { return generation_; }
+
+  // The current size of the file in bytes.
+  size_t size() const;
+
+  // Write the `block` (which must be sorted, non-empty, and have all the
+  // columns of the blocks of its permutation) to the end of the file and
+  // return its metadata with the given `blockIndex`. The existing blocks are
+  // never modified, so concurrent scans are not affected.
+  //
+  // NOTE: This function and `appendCopies` must not be called concurrently for
+  // the same file, but blocks may be read concurrently.
+  CompressedBlockMetadata append(const IdTable& block, size_t blockIndex) const;
+
+  // Copy the (compressed) columns of the `blocks`, which must be compacted
+  // blocks (from any file), to the end of this file and return the metadata of
+  // the copies.
+  std::vector<CompressedBlockMetadata> appendCopies(
+      const std::vector<CompressedBlockMetadata>& blocks) const;
+
+  // Return true iff the space of the compacted blocks that are no longer used
+  // should be reclaimed (by copying the `usedBlocks` to a new file), which is
+  // the case if more than half of this file is no longer used or if some of the
+  // `usedBlocks` are still contained in older files.
+  bool shouldBeReclaimed(
+      const std::vector<CompressedBlockMetadata>& usedBlocks) const;
+
+  // Return true iff the block is contained in a `CompactedBlocksFile`.
+  static bool isCompactedBlock(const CompressedBlockMetadata& blockMetadata);
+
+  // Return the file and the offset in that file for the (shifted)
+  // `offsetInFile` of a column of a compacted block. The file is kept alive by
+  // the metadata that refers to the block.
+  static std::pair<std::shared_ptr<const CompactedBlocksFile>, off_t>
+  getFileAndOffset(off_t offsetInFile);
+
+ private:
+  // Shift the offsets of the `blockMetadata`, which was written to the end of
+  // this file, see `OFFSET`.
+  void shiftOffsets(CompressedBlockMetadata& blockMetadata) const;
+};
+
 /// Manage the reading of relations from disk that have been previously written
 /// using the `CompressedRelationWriter`.
 class CompressedRelationReader {
@@ -627,10 +809,28 @@ class CompressedRelationReader {
 
   // The file that stores the actual permutations.
   ad_utility::File file_;
+  // Reads the blocks of several columns and blocks from the `file_` at once,
+  // see `readCompressedBlocksFromFile`. Only set if the `file_` is open.
+  std::unique_ptr<ad_utility::BatchedFileReader> batchedFileReader_;
+
+  // Identifies the columns of this reader in the `DecompressedBlockCache`.
+  size_t cacheId_ = DecompressedBlockCache::makeUniqueReaderId();
+
+  // The prefix of the names of the `CompactedBlocksFile`s for this
+  // permutation.
+  std::string compactedBlocksFilename_;
 
  public:
-  explicit CompressedRelationReader(Allocator allocator, ad_utility::File file)
-      : allocator_{std::move(allocator)}, file_{std::move(file)} {}
+  explicit CompressedRelationReader(Allocator allocator, ad_utility::File file,
+                                    std::string compactedBlocksFilename = "")
+      : allocator_{std::move(allocator)},
+        file_{std::move(file)},
+        compactedBlocksFilename_{std::move(compactedBlocksFilename)} {
+    if (file_.isOpen()) {
+      batchedFileReader_ = std::make_unique<ad_utility::BatchedFileReader>(
+          file_.getFileDescriptor(), file_.name());
+    }
+  }
 
   // Helper function that enables a comparison of a triple with an `Id` in the
   // function `getBlocksForJoin` below.  If the given triple matches `col0Id` of
@@ -779,27 +979,53 @@ class CompressedRelationReader {
   // Get access to the underlying allocator
   const Allocator& allocator() const { return allocator_; }
 
+  // Read and decompress all the columns of the block with the given
+  // `blockMetadata`. The located triples are not merged.
+  DecompressedBlock readBlock(
+      const CompressedBlockMetadata& blockMetadata) const;
+
+  // The prefix of the names of the `CompactedBlocksFile`s for this
+  // permutation, see `CompactedBlocksFile::create`.
+  const std::string& compactedBlocksFilename() const {
+    return compactedBlocksFilename_;
+  }
+
  private:
+  // For each of the `columnIndices` of the block that is identified by the
+  // `blockMetaData`, the decompressed column from the global
+  // `DecompressedBlockCache`, or `nullptr` if the column is not cached.
+  using CachedColumns = std::vector<DecompressedBlockCache::ColumnPtr>;
+  CachedColumns getCachedColumns(const CompressedBlockMetadata& blockMetaData,
+                                 ColumnIndicesRef columnIndices) const;
+
   // Read the block that is identified by the `blockMetaData` from the `file`.
-  // Only the columns specified by `columnIndices` are read.
+  // Only the columns specified by `columnIndices` are read. Columns for which
+  // the `cachedColumns` contain a value are skipped (their compressed column
+  // remains empty).
   CompressedBlock readCompressedBlockFromFile(
       const CompressedBlockMetadata& blockMetaData,
-      ColumnIndicesRef columnIndices) const;
-
-  // Decompress the `compressedBlock`. The number of rows that the block will
-  // have after decompression must be passed in via the `numRowsToRead`
-  // argument. It is typically obtained from the corresponding
-  // `CompressedBlockMetaData`.
-  DecompressedBlock decompressBlock(const CompressedBlock& compressedBlock,
-                                    size_t numRowsToRead) const;
-
-  // Helper function used by `decompressBlock` and
-  // `decompressBlockToExistingIdTable`. Decompress the `compressedColumn` and
-  // store the result at the `iterator`. For the `numRowsToRead` argument, see
-  // the documentation of `decompressBlock`.
+      ColumnIndicesRef columnIndices,
+      const CachedColumns& cachedColumns = {}) const;
+
+  // Like `readCompressedBlockFromFile`, but for several blocks (the
+  // `cachedColumns` are given per block). All the reads are submitted to the
+  // operating system at once (see `BatchedFileReader.h`), which is much faster
+  // than reading the columns one after the other, in particular on SSDs.
+  std::vector<CompressedBlock> readCompressedBlocksFromFile(
+      ql::span<const CompressedBlockMetadata> blockMetadata,
+      ColumnIndicesRef columnIndices,
+      ql::span<const CachedColumns> cachedColumns) const;
+
+  // Helper function used by `decompressBlockAndUpdateCache`. Decompress the
+  // `compressedColumn` that was compressed with the given `codec` and store
+  // the result at the `iterator`. The number of rows that the column will have
+  // after decompression must be passed in via the `numRowsToRead` argument.
+  // It is typically obtained from the corresponding `CompressedBlockMetaData`.
   template <typename Iterator>
-  static void decompressColumn(const std::vector<char>& compressedColumn,
-                               size_t numRowsToRead, Iterator iterator);
+  static void decompressColumn(
+      const std::vector<char>& compressedColumn,
+      CompressedBlockMetadata::OffsetAndCompressedSize::Codec codec,
+      size_t numRowsToRead, Iterator iterator);
 
   // Read and decompress the parts of the block given by `blockMetaData` (which
   // identifies the block) and `scanConfig` (which specifies the part of that
@@ -808,11 +1034,23 @@ class CompressedRelationReader {
       const CompressedBlockMetadata& blockMetaData,
       const ScanImplConfig& scanConfig) const;
 
+  // Assemble the decompressed block from the `cachedColumns` and the
+  // `compressedBlock` (which contains the columns that are not cached, see
+  // `readCompressedBlockFromFile`). The newly decompressed columns are added
+  // to the `DecompressedBlockCache`.
+  DecompressedBlock decompressBlockAndUpdateCache(
+      const CompressedBlock& compressedBlock,
+      const CachedColumns& cachedColumns,
+      const CompressedBlockMetadata& metadata,
+      ColumnIndicesRef columnIndices) const;
+
   // Like `readAndDecompressBlock`, and postprocess by merging the located
   // triples (if any) and applying the graph filters (if any), both specified
-  // as part of the `scanConfig`.
+  // as part of the `scanConfig`. For the `cachedColumns` see
+  // `decompressBlockAndUpdateCache`.
   DecompressedBlockAndMetadata decompressAndPostprocessBlock(
-      const CompressedBlock& compressedBlock, size_t numRowsToRead,
+      const CompressedBlock& compressedBlock,
+      const CachedColumns& cachedColumns,
       const CompressedRelationReader::ScanImplConfig& scanConfig,
       const CompressedBlockMetadata& metadata) const;
 
@@ -56,6 +56,10 @@ constexpr inline std::string_view PARTIAL_VOCAB_WORDS_INFIX =
     ".partial-vocab.words.tmp.";
 constexpr inline std::string_view PARTIAL_VOCAB_IDMAP_INFIX =
     ".partial-vocab.idmap.tmp.";
+// The file with the new IDs of the vocabulary of the existing index during an
+// incremental index build.
+constexpr inline std::string_view EXISTING_VOCAB_NEW_IDS_SUFFIX =
+    ".existing-vocab.new-ids.tmp";
 
 // ________________________________________________________________
 constexpr inline std::string_view TMP_BASENAME_COMPRESSION =
@@ -64,6 +68,11 @@ constexpr inline std::string_view TMP_BASENAME_COMPRESSION =
 // _________________________________________________________________
 constexpr inline std::string_view QLEVER_INTERNAL_INDEX_INFIX = ".internal";
 
+// _________________________________________________________________
+// The suffix of the files that store the blocks of a permutation that were
+// rewritten to merge the delta triples, see `DeltaTriples::compact`.
+constexpr inline std::string_view COMPACTED_BLOCKS_FILE_SUFFIX = ".compacted";
+
 // _________________________________________________________________
 // The degree of parallelism that is used for the index building step, where the
 // unique elements of the vocabulary are identified via hash maps. Typically, 6
@@ -107,6 +116,10 @@ constexpr inline ad_utility::MemorySize
 
 constexpr inline size_t NumColumnsIndexBuilding = 4;
 
+// The number of triples per block when the permutations of an existing index
+// are merged with the new triples during an incremental index build.
+constexpr inline size_t BLOCKSIZE_MERGE_WITH_EXISTING_INDEX = 100'000;
+
 // The maximal number of distinct graphs in a block such that this information
 // is stored in the metadata of the block.
 constexpr inline size_t MAX_NUM_GRAPHS_STORED_IN_BLOCK_METADATA = 20;
@@ -0,0 +1,102 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/DecompressedBlockCache.h"
+
+#include <absl/hash/hash.h>
+
+#include <limits>
+
+#include "global/RuntimeParameters.h"
+
+// _____________________________________________________________________________
+DecompressedBlockCache::DecompressedBlockCache(ad_utility::MemorySize maxSize,
+                                               size_t numShards) {
+  AD_CONTRACT_CHECK(numShards > 0);
+  shards_.reserve(numShards);
+  for (size_t i = 0; i < numShards; ++i) {
+    shards_.push_back(std::make_unique<ad_utility::Synchronized<Cache>>(
+        std::numeric_limits<size_t>::max(), maxSize / numShards));
+  }
+  maxColumnSizeInBytes_ = (maxSize / numShards).getBytes();
+}
+
+// _____________________________________________________________________________
+auto DecompressedBlockCache::getShard(const Key& key)
+    -> ad_utility::Synchronized<Cache>& {
+  return *shards_[absl::HashOf(key) % shards_.size()];
+}
+
+// _____________________________________________________________________________
+auto DecompressedBlockCache::get(const Key& key) -> ColumnPtr {
+  if (!isEnabled()) {
+    return nullptr;
+  }
+  auto result = (*getShard(key).wlock())[key];
+  ++(result ? numHits_ : numMisses_);
+  return result;
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::insert(const Key& key, Column column) {
+  if (!canStoreColumn(column.size())) {
+    return;
+  }
+  auto cache = getShard(key).wlock();
+  if (!cache->contains(key)) {
+    cache->insert(key, std::move(column));
+  }
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::setMaxSize(ad_utility::MemorySize maxSize) {
+  for (auto& shard : shards_) {
+    shard->wlock()->setMaxSize(maxSize / shards_.size());
+  }
+  maxColumnSizeInBytes_ = (maxSize / shards_.size()).getBytes();
+}
+
+// _____________________________________________________________________________
+void DecompressedBlockCache::clear() {
+  for (auto& shard : shards_) {
+    shard->wlock()->clearAll();
+  }
+  numHits_ = 0;
+  numMisses_ = 0;
+}
+
+// _____________________________________________________________________________
+auto DecompressedBlockCache::getStatistics() const -> Statistics {
+  Statistics statistics{numHits_, numMisses_, 0, ad_utility::MemorySize{}};
+  for (const auto& shard : shards_) {
+    auto cache = shard->rlock();
+    statistics.numEntries_ += cache->numNonPinnedEntries();
+    statistics.size_ += cache->nonPinnedSize();
+  }
+  return statistics;
+}
+
+// _____________________________________________________________________________
+size_t DecompressedBlockCache::makeUniqueReaderId() {
+  static std::atomic<size_t> nextId = 0;
+  return nextId++;
+}
+
+// _____________________________________________________________________________
+DecompressedBlockCache& DecompressedBlockCache::global() {
+  static DecompressedBlockCache cache{ad_utility::MemorySize::bytes(0),
+                                      NUM_SHARDS_OF_GLOBAL_CACHE};
+  // Keep the size of the cache in sync with the runtime parameter. Setting the
+  // action directly applies the current value of the parameter.
+  [[maybe_unused]] static const bool isRegistered = []() {
+    globalRuntimeParameters.wlock()
+        ->decompressedBlockCacheMaxSize_.setOnUpdateAction(
+            [](ad_utility::MemorySize newValue) {
+              cache.setMaxSize(newValue);
+            });
+    return true;
+  }();
+  return cache;
+}
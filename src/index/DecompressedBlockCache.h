@@ -0,0 +1,131 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_DECOMPRESSEDBLOCKCACHE_H
+#define QLEVER_SRC_INDEX_DECOMPRESSEDBLOCKCACHE_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "global/Id.h"
+#include "util/Cache.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// A thread-safe LRU cache for the decompressed columns of the blocks of the
+// permutations, that is shared between all the `CompressedRelationReader`s.
+// Blocks of frequently scanned relations (e.g. popular predicates) then don't
+// have to be read from disk and decompressed again for each query.
+//
+// The cache is split into shards (by the hash of the key), each with its own
+// lock and an equal share of the total size, s.t. concurrent scans don't
+// contend for a single lock (a lookup has to update the LRU order, so it needs
+// exclusive access to its shard).
+//
+// NOTE: The cache stores the columns exactly as they are stored on disk, that
+// is, BEFORE the located triples from the `DeltaTriples` (SPARQL UPDATE) are
+// merged into them. A cached column thus stays valid when the located triples
+// of its block change, and every scan merges the located triples of its own
+// snapshot after taking the column from the cache.
+class DecompressedBlockCache {
+ public:
+  // A column of a block is uniquely identified by the reader (= the file of the
+  // permutation) and the offset of the compressed column in that file.
+  struct Key {
+    size_t readerId_;
+    size_t offsetInFile_;
+
+    bool operator==(const Key&) const = default;
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Key& key) {
+      return H::combine(std::move(h), key.readerId_, key.offsetInFile_);
+    }
+  };
+
+  using Column = std::vector<Id>;
+  using ColumnPtr = std::shared_ptr<const Column>;
+
+  struct ColumnSizeGetter {
+    ad_utility::MemorySize operator()(const Column& column) const {
+      return ad_utility::MemorySize::bytes(column.size() * sizeof(Id));
+    }
+  };
+
+  // The statistics that are reported by the `cache-stats` command.
+  struct Statistics {
+    size_t numHits_;
+    size_t numMisses_;
+    size_t numEntries_;
+    ad_utility::MemorySize size_;
+  };
+
+  // The number of shards of the `global()` cache.
+  static constexpr size_t NUM_SHARDS_OF_GLOBAL_CACHE = 16;
+
+ private:
+  using Cache = ad_utility::HeapBasedLRUCache<Key, Column, ColumnSizeGetter>;
+  std::vector<std::unique_ptr<ad_utility::Synchronized<Cache>>> shards_;
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+  // The maximal size of a single column that can be cached (the share of a
+  // single shard) in bytes. Zero iff the cache is disabled. Can be read
+  // without locking any of the shards.
+  std::atomic<size_t> maxColumnSizeInBytes_ = 0;
+
+  // Return the shard that is responsible for the `key`.
+  ad_utility::Synchronized<Cache>& getShard(const Key& key);
+
+ public:
+  // Create a cache that holds columns with a total size of at most `maxSize`,
+  // split into `numShards` shards. A `maxSize` of zero disables the cache.
+  // Note that a column that is larger than the share of a single shard is
+  // never cached.
+  explicit DecompressedBlockCache(ad_utility::MemorySize maxSize,
+                                  size_t numShards = 1);
+
+  // Return true iff the cache is enabled, that is its maximal size is not
+  // zero. This is cheap and doesn't lock, so callers can skip the lookups and
+  // the copies for the `insert` if the cache is disabled (the default).
+  bool isEnabled() const { return maxColumnSizeInBytes_ > 0; }
+
+  // Return true iff a column with `numIds` entries is small enough to be
+  // stored in the cache. Also doesn't lock.
+  bool canStoreColumn(size_t numIds) const {
+    return isEnabled() && numIds * sizeof(Id) <= maxColumnSizeInBytes_;
+  }
+
+  // Return the column for the `key`, or `nullptr` if it is not contained in
+  // the cache. Also update the hit and miss counters (unless the cache is
+  // disabled, in which case `nullptr` is returned without any locking).
+  ColumnPtr get(const Key& key);
+
+  // Insert the `column` for the `key`. Do nothing if the `key` is already
+  // contained (another thread may have read the same column concurrently) or
+  // if the `column` doesn't fit into the cache.
+  void insert(const Key& key, Column column);
+
+  // Change the maximal total size of the cache. Entries are evicted
+  // immediately if required.
+  void setMaxSize(ad_utility::MemorySize maxSize);
+
+  // Remove all entries and reset the hit and miss counters.
+  void clear();
+
+  Statistics getStatistics() const;
+
+  // Return a new id for a `CompressedRelationReader` that is used as part of
+  // the `Key`. Each reader gets a different id, so entries of an index that
+  // has been replaced (e.g. in tests) are never returned for a new index.
+  static size_t makeUniqueReaderId();
+
+  // The global cache that is used by all `CompressedRelationReader`s. Its
+  // size is the runtime parameter `decompressed-block-cache-max-size`, which
+  // is zero (that is, the cache is disabled) by default.
+  static DecompressedBlockCache& global();
+};
+
+#endif  // QLEVER_SRC_INDEX_DECOMPRESSEDBLOCKCACHE_H
@@ -12,23 +12,29 @@
 
 #include "index/DeltaTriples.h"
 
+#include <absl/cleanup/cleanup.h>
 #include <absl/strings/str_cat.h>
 
 #include "backports/algorithm.h"
 #include "engine/ExecuteUpdate.h"
+#include "global/RuntimeParameters.h"
 #include "index/Index.h"
 #include "index/IndexImpl.h"
 #include "index/LocatedTriples.h"
+#include "util/HashSet.h"
 #include "util/Serializer/TripleSerializer.h"
 
 // ____________________________________________________________________________
-LocatedTriples::iterator& DeltaTriples::LocatedTripleHandles::forPermutation(
+size_t& DeltaTriples::LocatedTripleHandles::forPermutation(
     Permutation::Enum permutation) {
-  return handles_[static_cast<size_t>(permutation)];
+  return blockIndices_[static_cast<size_t>(permutation)];
 }
 
 // ____________________________________________________________________________
 void DeltaTriples::clear() {
+  if (writeAheadLog_.has_value()) {
+    writeAheadLog_->append(DeltaTriplesWriteAheadLog::Operation::Clear, {});
+  }
   triplesInserted_.clear();
   triplesDeleted_.clear();
   ql::ranges::for_each(locatedTriples(), &LocatedTriplesPerBlock::clear);
@@ -40,8 +46,7 @@ DeltaTriples::locateAndAddTriples(CancellationHandle cancellationHandle,
                                   ql::span<const IdTriple<0>> triples,
                                   bool insertOrDelete,
                                   ad_utility::timer::TimeTracer& tracer) {
-  std::array<std::vector<LocatedTriples::iterator>, Permutation::ALL.size()>
-      intermediateHandles;
+  std::vector<DeltaTriples::LocatedTripleHandles> handles{triples.size()};
   for (auto permutation : Permutation::ALL) {
     tracer.beginTrace(std::string{Permutation::toString(permutation)});
     tracer.beginTrace("locateTriples");
@@ -54,33 +59,158 @@ DeltaTriples::locateAndAddTriples(CancellationHandle cancellationHandle,
     cancellationHandle->throwIfCancelled();
     tracer.endTrace("locateTriples");
     tracer.beginTrace("addToLocatedTriples");
-    intermediateHandles[static_cast<size_t>(permutation)] =
-        this->locatedTriples()[static_cast<size_t>(permutation)].add(
-            locatedTriples, tracer);
+    this->locatedTriples()[static_cast<size_t>(permutation)].add(
+        locatedTriples, tracer);
     cancellationHandle->throwIfCancelled();
     tracer.endTrace("addToLocatedTriples");
+    AD_CORRECTNESS_CHECK(locatedTriples.size() == triples.size());
+    for (size_t i = 0; i < triples.size(); i++) {
+      handles[i].forPermutation(permutation) = locatedTriples[i].blockIndex_;
+    }
     tracer.endTrace(Permutation::toString(permutation));
   }
-  tracer.beginTrace("transformHandles");
-  std::vector<DeltaTriples::LocatedTripleHandles> handles{triples.size()};
+  return handles;
+}
+
+// ____________________________________________________________________________
+void DeltaTriples::eraseTripleInAllPermutations(
+    const IdTriple<0>& triple, const LocatedTripleHandles& handles) {
+  // Erase for all permutations. The `insertOrDelete_` flag of the
+  // `LocatedTriple` is irrelevant for the lookup.
   for (auto permutation : Permutation::ALL) {
-    for (size_t i = 0; i < triples.size(); i++) {
-      handles[i].forPermutation(permutation) =
-          intermediateHandles[static_cast<size_t>(permutation)][i];
+    auto blockIndex = handles.blockIndices_[static_cast<size_t>(permutation)];
+    // The triple has been merged into the blocks of the permutation, so there
+    // is no located triple to erase.
+    if (blockIndex == LocatedTripleHandles::COMPACTED) {
+      continue;
     }
+    LocatedTriple locatedTriple{
+        blockIndex,
+        triple.permute(index_.getPermutation(permutation).keyOrder()), false};
+    locatedTriples()[static_cast<int>(permutation)].erase(blockIndex,
+                                                          locatedTriple);
   }
-  tracer.endTrace("transformHandles");
-  return handles;
 }
 
 // ____________________________________________________________________________
-void DeltaTriples::eraseTripleInAllPermutations(LocatedTripleHandles& handles) {
-  // Erase for all permutations.
+DeltaTriples::Compaction DeltaTriples::prepareCompaction(
+    const IndexImpl& index, SharedLocatedTriplesSnapshot snapshot,
+    size_t minNumTriplesPerBlock, CancellationHandle cancellationHandle) {
+  AD_CONTRACT_CHECK(minNumTriplesPerBlock > 0);
+  Compaction compaction;
+  for (auto permutation : Permutation::ALL) {
+    const auto& locatedTriplesPerBlock =
+        snapshot->getLocatedTriplesForPermutation(permutation);
+    auto blockIndices =
+        locatedTriplesPerBlock.getBlocksWithAtLeast(minNumTriplesPerBlock);
+    if (blockIndices.empty()) {
+      continue;
+    }
+    auto& result = compaction.permutations_[static_cast<size_t>(permutation)];
+    const auto& reader = index.getPermutation(permutation).reader();
+    const auto& baseMetadata = locatedTriplesPerBlock.getBaseMetadata();
+
+    // Reclaim the space of the previously compacted blocks that are no longer
+    // used by copying the ones that are still used to a new file. The blocks
+    // that are compacted again below are also copied, in case their located
+    // triples change before the compaction is applied.
+    std::vector<CompressedBlockMetadata> previouslyCompactedBlocks;
+    ql::ranges::copy_if(baseMetadata,
+                        std::back_inserter(previouslyCompactedBlocks),
+                        &CompactedBlocksFile::isCompactedBlock);
+    // The blocks are appended to the file that the current located triples
+    // refer to. A new file is only started when there is none yet or when the
+    // space of the current one is reclaimed.
+    auto file = locatedTriplesPerBlock.getCompactedBlocksFile();
+    if (file != nullptr && file->shouldBeReclaimed(previouslyCompactedBlocks)) {
+      file = CompactedBlocksFile::create(reader.compactedBlocksFilename());
+      result.relocatedBlocks_ = file->appendCopies(previouslyCompactedBlocks);
+    }
+
+    size_t numColumns =
+        baseMetadata.empty()
+            ? size_t{4}
+            : baseMetadata.front().offsetsAndCompressedSize_.size();
+    for (size_t blockIndex : blockIndices) {
+      // The located triples that are larger than all the triples of the
+      // permutation belong to a block one past the last block, which doesn't
+      // exist yet.
+      IdTable block =
+          blockIndex < baseMetadata.size()
+              ? reader.readBlock(baseMetadata.at(blockIndex))
+              : IdTable{numColumns, ad_utility::makeUnlimitedAllocator<Id>()};
+      IdTable merged =
+          locatedTriplesPerBlock.mergeTriples(blockIndex, block, 3, true);
+      cancellationHandle->throwIfCancelled();
+      // Empty blocks are not allowed, so we keep the located triples of blocks
+      // in which all triples are deleted.
+      if (merged.empty()) {
+        continue;
+      }
+      if (file == nullptr) {
+        file = CompactedBlocksFile::create(reader.compactedBlocksFilename());
+      }
+      result.compactedBlocks_.push_back(file->append(merged, blockIndex));
+    }
+    result.file_ = std::move(file);
+  }
+  compaction.snapshot_ = std::move(snapshot);
+  return compaction;
+}
+
+// ____________________________________________________________________________
+size_t DeltaTriples::applyCompaction(const Compaction& compaction) {
+  size_t numCompactedBlocks = 0;
   for (auto permutation : Permutation::ALL) {
-    auto ltIter = handles.forPermutation(permutation);
-    locatedTriples()[static_cast<int>(permutation)].erase(ltIter->blockIndex_,
-                                                          ltIter);
+    const auto& [compactedBlocks, relocatedBlocks, file] =
+        compaction.permutations_[static_cast<size_t>(permutation)];
+    if (file == nullptr) {
+      continue;
+    }
+    auto& locatedTriplesPerBlock =
+        locatedTriples()[static_cast<size_t>(permutation)];
+    const auto& previous =
+        compaction.snapshot_->getLocatedTriplesForPermutation(permutation);
+    // The base metadata is only changed by a compaction (which is not done
+    // concurrently) and by `clear`, after which the blocks are obsolete.
+    if (&locatedTriplesPerBlock.getBaseMetadata() !=
+        &previous.getBaseMetadata()) {
+      continue;
+    }
+    // Skip the blocks that were modified in the meantime.
+    std::vector<CompressedBlockMetadata> unmodifiedBlocks;
+    ql::ranges::copy_if(compactedBlocks, std::back_inserter(unmodifiedBlocks),
+                        [&](const CompressedBlockMetadata& block) {
+                          return locatedTriplesPerBlock.hasSameLocatedTriples(
+                              block.blockIndex_, previous);
+                        });
+
+    // Mark the handles of the triples in the compacted blocks.
+    ad_utility::HashSet<size_t> compactedBlockIndices;
+    for (const auto& block : unmodifiedBlocks) {
+      compactedBlockIndices.insert(block.blockIndex_);
+    }
+    for (auto* triplesToHandles : {&triplesInserted_, &triplesDeleted_}) {
+      for (auto& handles : ql::views::values(*triplesToHandles)) {
+        auto& blockIndex = handles.forPermutation(permutation);
+        if (compactedBlockIndices.contains(blockIndex)) {
+          blockIndex = LocatedTripleHandles::COMPACTED;
+        }
+      }
+    }
+    locatedTriplesPerBlock.replaceCompactedBlocks(unmodifiedBlocks,
+                                                  relocatedBlocks, file);
+    numCompactedBlocks += unmodifiedBlocks.size();
   }
+  return numCompactedBlocks;
+}
+
+// ____________________________________________________________________________
+size_t DeltaTriples::compact(CancellationHandle cancellationHandle,
+                             size_t minNumTriplesPerBlock) {
+  return applyCompaction(prepareCompaction(index_, getSnapshot(),
+                                           minNumTriplesPerBlock,
+                                           std::move(cancellationHandle)));
 }
 
 // ____________________________________________________________________________
@@ -182,21 +312,23 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
     return targetMap.contains(triple);
   });
   tracer.endTrace("removeExistingTriples");
+  if (writeAheadLog_.has_value() && !triples.empty()) {
+    tracer.beginTrace("appendToWriteAheadLog");
+    writeAheadLog_->append(
+        insertOrDelete ? DeltaTriplesWriteAheadLog::Operation::Insert
+                       : DeltaTriplesWriteAheadLog::Operation::Delete,
+        triples);
+    tracer.endTrace("appendToWriteAheadLog");
+  }
   tracer.beginTrace("removeInverseTriples");
   ql::ranges::for_each(triples, [this, &inverseMap](const IdTriple<0>& triple) {
     auto handle = inverseMap.find(triple);
     if (handle != inverseMap.end()) {
-      eraseTripleInAllPermutations(handle->second);
+      eraseTripleInAllPermutations(triple, handle->second);
       inverseMap.erase(triple);
     }
   });
   tracer.endTrace("removeInverseTriples");
-  tracer.beginTrace("updateMetadata");
-  // Manually update the block metadata, because `eraseTripleInAllPermutations`
-  // does not update them for performance reason.
-  ql::ranges::for_each(locatedTriples(),
-                       &LocatedTriplesPerBlock::updateAugmentedMetadata);
-  tracer.endTrace("updateMetadata");
   tracer.beginTrace("locatedAndAdd");
 
   std::vector<LocatedTripleHandles> handles = locateAndAddTriples(
@@ -219,11 +351,20 @@ LocatedTriplesSnapshot::getLocatedTriplesForPermutation(
   return locatedTriplesPerBlock_[static_cast<int>(permutation)];
 }
 
+// ____________________________________________________________________________
+bool LocatedTriplesSnapshot::hasDeltaTriples() const {
+  return ql::ranges::any_of(
+      locatedTriplesPerBlock_, [](const LocatedTriplesPerBlock& located) {
+        return located.numTriples() > 0 || located.hasCompactedBlocks();
+      });
+}
+
 // ____________________________________________________________________________
 SharedLocatedTriplesSnapshot DeltaTriples::getSnapshot() {
-  // NOTE: Both members of the `LocatedTriplesSnapshot` are copied, but the
-  // `localVocab_` has no copy constructor (in order to avoid accidental
-  // copies), hence the explicit `clone`.
+  // NOTE: Copying the `LocatedTriplesPerBlock` only copies the pointers to the
+  // located triples of each block, which are shared until the next
+  // modification of the respective block (see `LocatedTriplesPerBlock`). The
+  // `localVocab_` is kept alive via its `LifetimeExtender`.
   auto snapshotIndex = nextSnapshotIndex_;
   ++nextSnapshotIndex_;
   return SharedLocatedTriplesSnapshot{std::make_shared<LocatedTriplesSnapshot>(
@@ -250,9 +391,103 @@ DeltaTriples::DeltaTriples(const Index& index)
 
 // ____________________________________________________________________________
 DeltaTriplesManager::DeltaTriplesManager(const IndexImpl& index)
-    : deltaTriples_{index},
+    : index_{index},
+      deltaTriples_{index},
       currentLocatedTriplesSnapshot_{deltaTriples_.wlock()->getSnapshot()} {}
 
+// _____________________________________________________________________________
+DeltaTriplesManager::~DeltaTriplesManager() {
+  {
+    std::lock_guard lock{compactionMutex_};
+    shutdown_ = true;
+  }
+  compactionStateChanged_.notify_all();
+  // The `compactionThread_` (if it was started) is joined by its destructor.
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesManager::updateSnapshot(DeltaTriples& deltaTriples) {
+  auto newSnapshot = deltaTriples.getSnapshot();
+  currentLocatedTriplesSnapshot_.withWriteLock(
+      [&newSnapshot](auto& currentSnapshot) {
+        currentSnapshot = std::move(newSnapshot);
+      });
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesManager::requestCompaction() {
+  if (getRuntimeParameter<
+          &RuntimeParameters::deltaTriplesCompactionMinTriplesPerBlock_>() ==
+      0) {
+    return;
+  }
+  {
+    std::lock_guard lock{compactionMutex_};
+    compactionRequested_ = true;
+    // The thread is only started when the first compaction is requested, s.t.
+    // no thread is running while the compaction is disabled.
+    if (!compactionThread_.joinable()) {
+      compactionThread_ = ad_utility::JThread{[this]() { compactionLoop(); }};
+    }
+  }
+  compactionStateChanged_.notify_all();
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesManager::compactionLoop() {
+  std::unique_lock lock{compactionMutex_};
+  while (true) {
+    compactionStateChanged_.wait(
+        lock, [this]() { return shutdown_ || compactionRequested_; });
+    if (shutdown_) {
+      return;
+    }
+    compactionRequested_ = false;
+    isCompacting_ = true;
+    lock.unlock();
+    // The update has already been applied, so if the compacted blocks can't
+    // be written (e.g. because the disk is full), the scans only have to merge
+    // more located triples. Other errors indicate a bug and are not caught.
+    try {
+      compactBlocks();
+    } catch (const std::runtime_error& e) {
+      AD_LOG_ERROR << "Compacting the blocks with many delta triples failed: "
+                   << e.what() << std::endl;
+    }
+    lock.lock();
+    isCompacting_ = false;
+    compactionStateChanged_.notify_all();
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesManager::waitUntilCompacted() {
+  std::unique_lock lock{compactionMutex_};
+  compactionStateChanged_.wait(lock, [this]() {
+    return shutdown_ || (!compactionRequested_ && !isCompacting_);
+  });
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesManager::compactBlocks() {
+  size_t minNumTriplesPerBlock = getRuntimeParameter<
+      &RuntimeParameters::deltaTriplesCompactionMinTriplesPerBlock_>();
+  if (minNumTriplesPerBlock == 0) {
+    return;
+  }
+  // Read, merge, and write the blocks without holding the lock, s.t.
+  // concurrent updates are not blocked. Queries continue to use the current
+  // snapshot.
+  auto compaction = DeltaTriples::prepareCompaction(
+      index_, getCurrentSnapshot(), minNumTriplesPerBlock,
+      std::make_shared<CancellationHandle::element_type>());
+  deltaTriples_.withWriteLock([this, &compaction](DeltaTriples& deltaTriples) {
+    if (deltaTriples.applyCompaction(compaction) > 0) {
+      updateSnapshot(deltaTriples);
+    }
+  });
+}
+
 // _____________________________________________________________________________
 template <typename ReturnType>
 ReturnType DeltaTriplesManager::modify(
@@ -262,29 +497,20 @@ ReturnType DeltaTriplesManager::modify(
   // actual `function` (typically some combination of insert and delete
   // operations) and (while still holding the lock) update the
   // `currentLocatedTriplesSnapshot_`.
-  tracer.beginTrace("acquiringDeltaTriplesWriteLock");
-  return deltaTriples_.withWriteLock([this, &function, writeToDiskAfterRequest,
-                                      &tracer](DeltaTriples& deltaTriples) {
-    auto updateSnapshot = [this, &deltaTriples] {
-      auto newSnapshot = deltaTriples.getSnapshot();
-      currentLocatedTriplesSnapshot_.withWriteLock(
-          [&newSnapshot](auto& currentSnapshot) {
-            currentSnapshot = std::move(newSnapshot);
-          });
-    };
-    auto writeAndUpdateSnapshot = [&updateSnapshot, &deltaTriples, &tracer,
+  auto modifyAndUpdateSnapshot = [this, &function, writeToDiskAfterRequest,
+                                  &tracer](DeltaTriples& deltaTriples) {
+    tracer.endTrace("acquiringDeltaTriplesWriteLock");
+    auto writeAndUpdateSnapshot = [this, &deltaTriples, &tracer,
                                    writeToDiskAfterRequest]() {
       if (writeToDiskAfterRequest) {
         tracer.beginTrace("diskWriteback");
-        deltaTriples.writeToDisk();
+        deltaTriples.commitToDisk();
         tracer.endTrace("diskWriteback");
       }
       tracer.beginTrace("snapshotCreation");
-      updateSnapshot();
+      updateSnapshot(deltaTriples);
       tracer.endTrace("snapshotCreation");
     };
-
-    tracer.endTrace("acquiringDeltaTriplesWriteLock");
     if constexpr (std::is_void_v<ReturnType>) {
       function(deltaTriples);
       writeAndUpdateSnapshot();
@@ -293,7 +519,20 @@ ReturnType DeltaTriplesManager::modify(
       writeAndUpdateSnapshot();
       return returnValue;
     }
-  });
+  };
+
+  // After releasing the lock, merge the located triples of the blocks with
+  // many updates into the permutations (in the background).
+  tracer.beginTrace("acquiringDeltaTriplesWriteLock");
+  if constexpr (std::is_void_v<ReturnType>) {
+    deltaTriples_.withWriteLock(modifyAndUpdateSnapshot);
+    requestCompaction();
+  } else {
+    ReturnType returnValue =
+        deltaTriples_.withWriteLock(modifyAndUpdateSnapshot);
+    requestCompaction();
+    return returnValue;
+  }
 }
 // Explicit instantiations
 template void DeltaTriplesManager::modify<void>(
@@ -324,7 +563,7 @@ void DeltaTriples::setOriginalMetadata(
 }
 
 // _____________________________________________________________________________
-void DeltaTriples::writeToDisk() const {
+void DeltaTriples::writeToDisk() {
   if (!filenameForPersisting_.has_value()) {
     return;
   }
@@ -342,6 +581,26 @@ void DeltaTriples::writeToDisk() const {
       tempPath, localVocab_,
       std::array{toRange(triplesDeleted_), toRange(triplesInserted_)});
   std::filesystem::rename(tempPath, filenameForPersisting_.value());
+  // All the modifications in the log are now contained in the file that was
+  // just written. If we crash before the log is deleted, replaying it again
+  // is harmless, because the final state of each triple is determined by the
+  // last operation on it.
+  AD_CORRECTNESS_CHECK(writeAheadLog_.has_value());
+  writeAheadLog_->remove();
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::commitToDisk() {
+  if (!writeAheadLog_.has_value()) {
+    return;
+  }
+  writeAheadLog_->commit(
+      getRuntimeParameter<&RuntimeParameters::persistUpdatesSyncInterval_>());
+  auto threshold = getRuntimeParameter<
+      &RuntimeParameters::persistUpdatesCheckpointThreshold_>();
+  if (writeAheadLog_->sizeInBytes() > threshold.getBytes()) {
+    writeToDisk();
+  }
 }
 
 // _____________________________________________________________________________
@@ -350,11 +609,61 @@ void DeltaTriples::readFromDisk() {
     return;
   }
   AD_CONTRACT_CHECK(localVocab_.empty());
+  // The modifications that are replayed must not be logged again.
+  AD_CORRECTNESS_CHECK(writeAheadLog_.has_value());
+  auto writeAheadLog = std::move(writeAheadLog_.value());
+  writeAheadLog_.reset();
+  absl::Cleanup restoreLog{[this, &writeAheadLog]() {
+    writeAheadLog_.emplace(std::move(writeAheadLog));
+  }};
+
+  // The blank nodes of the file and of the log were created by the same
+  // process, so they have to be mapped consistently. They are directly created
+  // in the `localVocab_`, s.t. `insertTriples` and `deleteTriples` keep them.
+  ad_utility::BlankNodeMapping blankNodeMapping;
+  auto newBlankNodeIndex = [this]() {
+    return localVocab_.getBlankNodeIndex(index_.getBlankNodeManager());
+  };
+  auto cancellationHandle =
+      std::make_shared<CancellationHandle::element_type>();
   auto [vocab, idRanges] = ad_utility::deserializeIds(
-      filenameForPersisting_.value(), index_.getBlankNodeManager());
-  if (idRanges.empty()) {
-    return;
+      filenameForPersisting_.value(), blankNodeMapping, newBlankNodeIndex);
+  bool fileExists = !idRanges.empty();
+  if (fileExists) {
+    readFromIdRanges(cancellationHandle, idRanges);
+  }
+
+  using Operation = DeltaTriplesWriteAheadLog::Operation;
+  size_t numRecords = DeltaTriplesWriteAheadLog::replay(
+      writeAheadLog.filename(), blankNodeMapping, newBlankNodeIndex,
+      [this, &cancellationHandle](Operation operation, Triples triples) {
+        ql::ranges::sort(triples);
+        if (operation == Operation::Insert) {
+          insertTriples(cancellationHandle, std::move(triples));
+        } else if (operation == Operation::Delete) {
+          deleteTriples(cancellationHandle, std::move(triples));
+        } else {
+          AD_CORRECTNESS_CHECK(operation == Operation::Clear);
+          clear();
+        }
+      });
+  if (numRecords > 0) {
+    AD_LOG_INFO << "Done, #inserted triples = " << numInserted()
+                << ", #deleted triples = " << numDeleted() << std::endl;
   }
+
+  // Write a new checkpoint (which also deletes the log), s.t. the blank nodes
+  // in the log are always consistent with those in the checkpoint.
+  if (fileExists || numRecords > 0) {
+    std::move(restoreLog).Invoke();
+    writeToDisk();
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::readFromIdRanges(
+    const CancellationHandle& cancellationHandle,
+    const std::vector<std::vector<Id>>& idRanges) {
   AD_CORRECTNESS_CHECK(idRanges.size() == 2);
   auto toTriples = [](const std::vector<Id>& ids) {
     Triples triples;
@@ -368,16 +677,20 @@ void DeltaTriples::readFromDisk() {
     }
     return triples;
   };
-  auto cancellationHandle =
-      std::make_shared<CancellationHandle::element_type>();
   insertTriples(cancellationHandle, toTriples(idRanges.at(1)));
   deleteTriples(cancellationHandle, toTriples(idRanges.at(0)));
   AD_LOG_INFO << "Done, #inserted triples = " << idRanges.at(1).size()
               << ", #deleted triples = " << idRanges.at(0).size() << std::endl;
 }
+
 // _____________________________________________________________________________
 void DeltaTriples::setPersists(std::optional<std::string> filename) {
   filenameForPersisting_ = std::move(filename);
+  writeAheadLog_.reset();
+  if (filenameForPersisting_.has_value()) {
+    writeAheadLog_.emplace(
+        absl::StrCat(filenameForPersisting_.value(), ".wal"));
+  }
 }
 
 // _____________________________________________________________________________
@@ -12,14 +12,19 @@
 #ifndef QLEVER_SRC_INDEX_DELTATRIPLES_H
 #define QLEVER_SRC_INDEX_DELTATRIPLES_H
 
+#include <condition_variable>
+#include <mutex>
+
 #include "engine/LocalVocab.h"
 #include "global/IdTriple.h"
+#include "index/DeltaTriplesWriteAheadLog.h"
 #include "index/Index.h"
 #include "index/IndexBuilderTypes.h"
 #include "index/LocatedTriples.h"
 #include "index/Permutation.h"
 #include "util/Synchronized.h"
 #include "util/TimeTracer.h"
+#include "util/jthread.h"
 
 // Typedef for one `LocatedTriplesPerBlock` object for each of the six
 // permutations.
@@ -41,6 +46,9 @@ struct LocatedTriplesSnapshot {
   // Get `TripleWithPosition` objects for given permutation.
   const LocatedTriplesPerBlock& getLocatedTriplesForPermutation(
       Permutation::Enum permutation) const;
+  // Return true iff the snapshot differs from the index on disk, that is, if
+  // there are located triples or compacted blocks in any permutation.
+  bool hasDeltaTriples() const;
 };
 
 // A shared pointer to a constant `LocatedTriplesSnapshot`, but as an explicit
@@ -83,6 +91,7 @@ class DeltaTriples {
   FRIEND_TEST(DeltaTriplesTest, clear);
   FRIEND_TEST(DeltaTriplesTest, addTriplesToLocalVocab);
   FRIEND_TEST(DeltaTriplesTest, storeAndRestoreData);
+  FRIEND_TEST(DeltaTriplesTest, storeAndRestoreViaWriteAheadLog);
 
  public:
   using Triples = std::vector<IdTriple<0>>;
@@ -103,6 +112,10 @@ class DeltaTriples {
   // See the documentation of `setPersist()` below.
   std::optional<std::string> filenameForPersisting_;
 
+  // The log of all the modifications since the last call to `writeToDisk()`.
+  // It is set iff `filenameForPersisting_` is set.
+  std::optional<DeltaTriplesWriteAheadLog> writeAheadLog_;
+
   // Assert that the Permutation Enum values have the expected int values.
   // This is used to store and lookup items that exist for permutation in an
   // array.
@@ -115,12 +128,17 @@ class DeltaTriples {
   static_assert(Permutation::ALL.size() == 6);
 
   // Each delta triple needs to know where it is stored in each of the six
-  // `LocatedTriplesPerBlock` above.
+  // `LocatedTriplesPerBlock` above. We store the index of the block and not an
+  // iterator into the set of that block, because the sets are copied on
+  // modification when they are shared with a snapshot (see
+  // `LocatedTriplesPerBlock`), which invalidates all iterators. The block
+  // index is `COMPACTED` if the triple has already been merged into the
+  // blocks of the permutation by `compact()`.
   struct LocatedTripleHandles {
-    using It = LocatedTriples::iterator;
-    std::array<It, Permutation::ALL.size()> handles_;
+    static constexpr size_t COMPACTED = std::numeric_limits<size_t>::max();
+    std::array<size_t, Permutation::ALL.size()> blockIndices_;
 
-    LocatedTriples::iterator& forPermutation(Permutation::Enum permutation);
+    size_t& forPermutation(Permutation::Enum permutation);
   };
   using TriplesToHandlesMap =
       ad_utility::HashMap<IdTriple<0>, LocatedTripleHandles>;
@@ -178,20 +196,80 @@ class DeltaTriples {
                      ad_utility::timer::TimeTracer& tracer =
                          ad_utility::timer::DEFAULT_TIME_TRACER);
 
+  // The blocks that were written by `prepareCompaction` (see below), for each
+  // permutation.
+  struct Compaction {
+    struct ForPermutation {
+      // The blocks with the located triples merged in.
+      std::vector<CompressedBlockMetadata> compactedBlocks_;
+      // The previously compacted blocks, which were copied to a new file to
+      // reclaim the space of the compacted blocks that are no longer used.
+      std::vector<CompressedBlockMetadata> relocatedBlocks_;
+      // The file that contains all the blocks, `nullptr` if nothing was
+      // written for this permutation.
+      std::shared_ptr<const CompactedBlocksFile> file_;
+    };
+    // The snapshot from which the blocks were computed.
+    SharedLocatedTriplesSnapshot snapshot_;
+    std::array<ForPermutation, Permutation::ALL.size()> permutations_;
+  };
+
+  // Merge the located triples of the `snapshot` into the blocks of the
+  // permutations for all blocks that have at least `minNumTriplesPerBlock`
+  // located triples. Each such block is read, merged with its located triples,
+  // and appended to the `CompactedBlocksFile` of the `snapshot` (see
+  // `CompactedBlocksFile::append`). This only reads the (immutable)
+  // `snapshot`, so it doesn't need the lock for the `DeltaTriples`, but it
+  // must not be called concurrently for the same `index`. The result has to be
+  // installed via `applyCompaction`.
+  static Compaction prepareCompaction(const IndexImpl& index,
+                                      SharedLocatedTriplesSnapshot snapshot,
+                                      size_t minNumTriplesPerBlock,
+                                      CancellationHandle cancellationHandle);
+
+  // Replace the blocks of the permutations by the blocks of the `compaction`
+  // and remove their located triples, s.t. scans don't have to merge them
+  // anymore. Blocks whose located triples were modified after the snapshot of
+  // the `compaction` was taken are skipped. Existing snapshots are not
+  // affected. Return the total number of blocks that were compacted.
+  //
+  // NOTE: The sets of inserted and deleted triples (and thus the counts and
+  // the persisted delta triples) don't change, so the compaction is not
+  // visible in the results of any query.
+  size_t applyCompaction(const Compaction& compaction);
+
+  // Prepare and apply a compaction for the current state.
+  size_t compact(CancellationHandle cancellationHandle,
+                 size_t minNumTriplesPerBlock);
+
   // If the `filename` is set, then `writeToDisk()` will write these
-  // `DeltaTriples` to `filename.value()`. If `filename` is `nullopt`, then
-  // `writeToDisk` will be a nullop.
+  // `DeltaTriples` to `filename.value()`, and all modifications are logged to
+  // `filename.value() + ".wal"` (see `DeltaTriplesWriteAheadLog`). If
+  // `filename` is `nullopt`, then `writeToDisk` and `commitToDisk` will be
+  // nullops.
   void setPersists(std::optional<std::string> filename);
 
-  // Write the delta triples to disk to persist them between restarts.
-  void writeToDisk() const;
+  // Write the complete delta triples to disk to persist them between restarts
+  // (checkpoint). The write-ahead log is deleted afterwards.
+  void writeToDisk();
 
-  // Read the delta triples from disk to restore them after a restart.
+  // Append the modifications since the last call to the write-ahead log, which
+  // is much cheaper than `writeToDisk` if the number of modifications is
+  // small. If the log becomes larger than the runtime parameter
+  // `persist-updates-checkpoint-threshold`, call `writeToDisk` instead.
+  void commitToDisk();
+
+  // Read the delta triples from disk to restore them after a restart. This
+  // reads the file written by `writeToDisk` and then replays the write-ahead
+  // log. If anything was read, a new checkpoint is written, s.t. the
+  // write-ahead log only contains modifications of the current process.
   void readFromDisk();
 
-  // Return a deep copy of the `LocatedTriples` and the corresponding
-  // `LocalVocab` which form a snapshot of the current status of this
-  // `DeltaTriples` object.
+  // Return a copy of the `LocatedTriples` and the corresponding `LocalVocab`
+  // which form a snapshot of the current status of this `DeltaTriples` object.
+  // The located triples of the individual blocks are shared between the
+  // snapshot and this object until they are modified (copy-on-write), so the
+  // cost of a snapshot does not depend on the total number of delta triples.
   SharedLocatedTriplesSnapshot getSnapshot();
 
   // Register the original `metadata` for the given `permutation`. This has to
@@ -201,11 +279,16 @@ class DeltaTriples {
       std::shared_ptr<const std::vector<CompressedBlockMetadata>> metadata);
 
  private:
+  // Insert and delete the triples from the `idRanges` that were read from the
+  // file written by `writeToDisk`.
+  void readFromIdRanges(const CancellationHandle& cancellationHandle,
+                        const std::vector<std::vector<Id>>& idRanges);
+
   // Find the position of the given triple in the given permutation and add it
   // to each of the six `LocatedTriplesPerBlock` maps (one per permutation).
   // When `insertOrDelete` is `true`, the triples are inserted, otherwise
-  // deleted. Return the iterators of where it was added (so that we can easily
-  // delete it again from these maps later).
+  // deleted. Return the block indices of where it was added (so that we can
+  // easily delete it again from these maps later).
   std::vector<LocatedTripleHandles> locateAndAddTriples(
       CancellationHandle cancellationHandle,
       ql::span<const IdTriple<0>> triples, bool insertOrDelete,
@@ -234,14 +317,14 @@ class DeltaTriples {
   void rewriteLocalVocabEntriesAndBlankNodes(Triples& triples);
   FRIEND_TEST(DeltaTriplesTest, rewriteLocalVocabEntriesAndBlankNodes);
 
-  // Erase `LocatedTriple` object from each `LocatedTriplesPerBlock` list. The
-  // argument are iterators for each list, as returned by the method
-  // `locateTripleInAllPermutations` above.
+  // Erase the `LocatedTriple` object for `triple` from each
+  // `LocatedTriplesPerBlock` list. The `handles` contain the block index for
+  // each list, as returned by the method `locateAndAddTriples` above.
   //
-  // NOTE: The iterators are invalid afterward. That is OK, as long as we also
-  // delete the respective entry in `triplesInserted_` or `triplesDeleted_`,
-  // which stores these iterators.
-  void eraseTripleInAllPermutations(LocatedTripleHandles& handles);
+  // NOTE: The respective entry in `triplesInserted_` or `triplesDeleted_`,
+  // which stores these handles, also has to be deleted.
+  void eraseTripleInAllPermutations(const IdTriple<0>& triple,
+                                    const LocatedTripleHandles& handles);
 
   friend class DeltaTriplesManager;
 };
@@ -249,9 +332,47 @@ class DeltaTriples {
 // This class synchronizes the access to a `DeltaTriples` object, thus avoiding
 // race conditions between concurrent updates and queries.
 class DeltaTriplesManager {
+  const IndexImpl& index_;
   ad_utility::Synchronized<DeltaTriples> deltaTriples_;
   ad_utility::Synchronized<SharedLocatedTriplesSnapshot, std::shared_mutex>
       currentLocatedTriplesSnapshot_;
+  // The state of the `compactionThread_`, which compacts the blocks after an
+  // update, see `compactBlocks`. The thread is started by the first call to
+  // `requestCompaction` while the compaction is enabled.
+  std::mutex compactionMutex_;
+  std::condition_variable compactionStateChanged_;
+  bool compactionRequested_ = false;
+  bool isCompacting_ = false;
+  bool shutdown_ = false;
+  // Declared last, s.t. the thread is joined before the other members are
+  // destroyed.
+  ad_utility::JThread compactionThread_;
+
+  // Replace the `currentLocatedTriplesSnapshot_` by a snapshot of the
+  // `deltaTriples`. Must be called while holding the lock for the
+  // `deltaTriples_`.
+  void updateSnapshot(DeltaTriples& deltaTriples);
+
+  // If enabled, wake up (or start) the `compactionThread_` to compact the
+  // blocks. Does not block.
+  void requestCompaction();
+
+  // The loop of the `compactionThread_`. Several requests that arrive during a
+  // compaction are handled by a single subsequent compaction.
+  void compactionLoop();
+
+  // Merge the located triples of the blocks with many updates into the
+  // permutations, see `DeltaTriples::prepareCompaction`. The blocks are
+  // written without holding the lock for the `deltaTriples_`, which is only
+  // acquired to install the result.
+  //
+  // NOTE: The compacted blocks are not persisted. Their files are removed as
+  // soon as no snapshot refers to them anymore (in particular at shutdown),
+  // and leftovers of a process that was not shut down properly are removed
+  // when the permutations are loaded. After a restart, the (persisted) delta
+  // triples are located in the original blocks again, and the blocks are only
+  // compacted again after the next update.
+  void compactBlocks();
 
  public:
   using CancellationHandle = DeltaTriples::CancellationHandle;
@@ -260,11 +381,15 @@ class DeltaTriplesManager {
   explicit DeltaTriplesManager(const IndexImpl& index);
   FRIEND_TEST(DeltaTriplesTest, DeltaTriplesManager);
 
+  // Stop the `compactionThread_`. A pending compaction is dropped.
+  ~DeltaTriplesManager();
+
   // Modify the underlying `DeltaTriples` by applying `function` and then update
   // the current snapshot. Concurrent calls to `modify` and `clear` will be
   // serialized, and each call to `getCurrentSnapshot` will either return the
   // snapshot before or after a modification, but never one of an ongoing
-  // modification.
+  // modification. Afterwards, the blocks with many located triples are
+  // compacted in the background, see `compactBlocks`.
   template <typename ReturnType>
   ReturnType modify(const std::function<ReturnType(DeltaTriples&)>& function,
                     bool writeToDiskAfterRequest = true,
@@ -277,9 +402,12 @@ class DeltaTriplesManager {
   // update the current snapshot.
   void clear();
 
-  // Return a shared pointer to a deep copy of the current snapshot. This can
-  // be safely used to execute a query without interfering with future updates.
+  // Return a shared pointer to the current snapshot. This can be safely used to
+  // execute a query without interfering with future updates.
   SharedLocatedTriplesSnapshot getCurrentSnapshot() const;
+
+  // Block until the requested compactions have been completed.
+  void waitUntilCompacted();
 };
 
 #endif  // QLEVER_SRC_INDEX_DELTATRIPLES_H
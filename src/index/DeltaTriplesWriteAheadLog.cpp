@@ -0,0 +1,279 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/DeltaTriplesWriteAheadLog.h"
+
+#include <absl/strings/str_cat.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <utility>
+
+#include "backports/span.h"
+#include "util/File.h"
+#include "util/HashSet.h"
+#include "util/Log.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeVector.h"
+
+namespace {
+constexpr std::array<char, 13> magicBytes{'Q', 'L', 'E', 'V', 'E', 'R', '.',
+                                          'U', 'P', 'D', 'L', 'O', 'G'};
+constexpr uint16_t version = 0;
+static_assert(DeltaTriplesWriteAheadLog::FILE_HEADER_SIZE ==
+              magicBytes.size() + sizeof(version));
+
+// The 64-bit FNV-1a hash of the `bytes`, which is used to detect incomplete
+// or corrupt records. Note that we cannot use `absl::Hash` here because its
+// values are not stable between different runs of the program.
+uint64_t computeChecksum(ql::span<const char> bytes) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : bytes) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Throw an exception that contains the given `message`, the `filename`, and
+// the description of the current `errno`.
+[[noreturn]] void throwIoError(std::string_view message,
+                               const std::string& filename) {
+  throw std::runtime_error{absl::StrCat(message, " '", filename,
+                                        "': ", std::strerror(errno))};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+DeltaTriplesWriteAheadLog::DeltaTriplesWriteAheadLog(std::string filename)
+    : filename_{std::move(filename)} {}
+
+// _____________________________________________________________________________
+DeltaTriplesWriteAheadLog::~DeltaTriplesWriteAheadLog() { close(); }
+
+// _____________________________________________________________________________
+DeltaTriplesWriteAheadLog::DeltaTriplesWriteAheadLog(
+    DeltaTriplesWriteAheadLog&& other) noexcept
+    : filename_{std::move(other.filename_)},
+      fileDescriptor_{std::exchange(other.fileDescriptor_, -1)},
+      pendingRecords_{std::move(other.pendingRecords_)},
+      numCommitsSinceSync_{other.numCommitsSinceSync_},
+      sizeInBytes_{other.sizeInBytes_} {}
+
+// _____________________________________________________________________________
+DeltaTriplesWriteAheadLog& DeltaTriplesWriteAheadLog::operator=(
+    DeltaTriplesWriteAheadLog&& other) noexcept {
+  if (this != &other) {
+    close();
+    filename_ = std::move(other.filename_);
+    fileDescriptor_ = std::exchange(other.fileDescriptor_, -1);
+    pendingRecords_ = std::move(other.pendingRecords_);
+    numCommitsSinceSync_ = other.numCommitsSinceSync_;
+    sizeInBytes_ = other.sizeInBytes_;
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::append(Operation operation,
+                                       const Triples& triples) {
+  ad_utility::serialization::ByteBufferWriteSerializer payload;
+  payload << static_cast<uint8_t>(operation);
+  // Only the `LocalVocab` entries that are referenced by the `triples` are
+  // stored, so the size of the record is proportional to the size of the
+  // update.
+  ad_utility::HashSet<LocalVocabIndex> localVocabEntries;
+  std::vector<Id> ids;
+  ids.reserve(triples.size() * IdTriple<0>::NumCols);
+  for (const auto& triple : triples) {
+    for (Id id : triple.ids()) {
+      if (id.getDatatype() == Datatype::LocalVocabIndex) {
+        localVocabEntries.insert(id.getLocalVocabIndex());
+      }
+      ids.push_back(id);
+    }
+  }
+  ad_utility::detail::serializeLocalVocabEntries(payload, localVocabEntries);
+  payload << ids;
+
+  const auto& data = payload.data();
+  std::array<uint64_t, 2> header{data.size(), computeChecksum(data)};
+  auto headerBytes = reinterpret_cast<const char*>(header.data());
+  pendingRecords_.insert(pendingRecords_.end(), headerBytes,
+                         headerBytes + RECORD_HEADER_SIZE);
+  pendingRecords_.insert(pendingRecords_.end(), data.begin(), data.end());
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::commit(size_t syncInterval) {
+  if (pendingRecords_.empty()) {
+    return;
+  }
+  if (fileDescriptor_ < 0) {
+    open();
+  }
+  // Write all the pending records with as few system calls as possible.
+  const char* data = pendingRecords_.data();
+  size_t numBytesRemaining = pendingRecords_.size();
+  while (numBytesRemaining > 0) {
+    ssize_t numBytesWritten = ::write(fileDescriptor_, data, numBytesRemaining);
+    if (numBytesWritten < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // Remove the partially written records, s.t. the records that are
+      // appended later are not hidden behind an incomplete record.
+      int writeError = errno;
+      [[maybe_unused]] int result = ::ftruncate(fileDescriptor_, sizeInBytes_);
+      errno = writeError;
+      throwIoError("Could not write to the update log", filename_);
+    }
+    data += numBytesWritten;
+    numBytesRemaining -= numBytesWritten;
+  }
+  sizeInBytes_ += pendingRecords_.size();
+  pendingRecords_.clear();
+
+  ++numCommitsSinceSync_;
+  if (syncInterval > 0 && numCommitsSinceSync_ >= syncInterval) {
+    if (::fsync(fileDescriptor_) != 0) {
+      throwIoError("Could not sync the update log", filename_);
+    }
+    numCommitsSinceSync_ = 0;
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::remove() {
+  close();
+  std::filesystem::remove(filename_);
+  pendingRecords_.clear();
+  numCommitsSinceSync_ = 0;
+  sizeInBytes_ = 0;
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::open() {
+  AD_CORRECTNESS_CHECK(fileDescriptor_ < 0);
+  fileDescriptor_ = ::open(filename_.c_str(),
+                           O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (fileDescriptor_ < 0) {
+    throwIoError("Could not open the update log", filename_);
+  }
+  struct stat fileStatus;
+  if (::fstat(fileDescriptor_, &fileStatus) != 0) {
+    throwIoError("Could not determine the size of the update log", filename_);
+  }
+  sizeInBytes_ = static_cast<size_t>(fileStatus.st_size);
+  if (sizeInBytes_ == 0) {
+    std::vector<char> header(magicBytes.begin(), magicBytes.end());
+    auto versionBytes = reinterpret_cast<const char*>(&version);
+    header.insert(header.end(), versionBytes, versionBytes + sizeof(version));
+    pendingRecords_.insert(pendingRecords_.begin(), header.begin(),
+                           header.end());
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::close() {
+  if (fileDescriptor_ >= 0) {
+    ::close(fileDescriptor_);
+    fileDescriptor_ = -1;
+  }
+}
+
+// _____________________________________________________________________________
+size_t DeltaTriplesWriteAheadLog::replay(
+    const std::string& filename, ad_utility::BlankNodeMapping& blankNodeMapping,
+    const std::function<BlankNodeIndex()>& newBlankNodeIndex,
+    const std::function<void(Operation, Triples)>& processRecord) {
+  using namespace ad_utility::serialization;
+  if (!std::filesystem::exists(filename)) {
+    return 0;
+  }
+  ad_utility::File file{filename, "r"};
+  auto fileSize = static_cast<size_t>(file.sizeOfFile());
+  auto read = [&file](void* target, size_t numBytes, size_t offset) {
+    AD_CORRECTNESS_CHECK(file.read(target, numBytes, offset) ==
+                         static_cast<ssize_t>(numBytes));
+  };
+
+  // A file that is shorter than the header was created by a process that
+  // crashed before its first commit was complete. It is truncated, s.t. the
+  // header is written again by `open` (otherwise, the records would be
+  // appended behind the incomplete header and the log could not be read).
+  if (fileSize < FILE_HEADER_SIZE) {
+    if (fileSize > 0) {
+      AD_LOG_WARN << "Ignoring the update log " << filename
+                  << ", which has an incomplete header" << std::endl;
+      file.close();
+      std::filesystem::resize_file(filename, 0);
+    }
+    return 0;
+  }
+  std::array<char, magicBytes.size()> magicByteBuffer{};
+  uint16_t fileVersion;
+  read(magicByteBuffer.data(), magicBytes.size(), 0);
+  read(&fileVersion, sizeof(fileVersion), magicBytes.size());
+  if (magicByteBuffer != magicBytes || fileVersion != version) {
+    throw std::runtime_error{absl::StrCat(
+        "The file '", filename,
+        "' is not a valid update log of this version of QLever")};
+  }
+  size_t offset = FILE_HEADER_SIZE;
+
+  AD_LOG_INFO << "Replaying the update log " << filename << " ..."
+              << std::endl;
+  size_t numRecords = 0;
+  while (offset + RECORD_HEADER_SIZE <= fileSize) {
+    std::array<uint64_t, 2> header;
+    read(header.data(), RECORD_HEADER_SIZE, offset);
+    auto [payloadSize, checksum] = header;
+    if (payloadSize > fileSize - offset - RECORD_HEADER_SIZE) {
+      break;
+    }
+    std::vector<char> payload(payloadSize);
+    read(payload.data(), payloadSize, offset + RECORD_HEADER_SIZE);
+    if (computeChecksum(payload) != checksum) {
+      break;
+    }
+    ByteBufferReadSerializer serializer{std::move(payload)};
+    auto operation = static_cast<Operation>(
+        ad_utility::detail::readValue<uint8_t>(serializer));
+    // The `vocab` owns the `LocalVocabEntry`s of the `triples`.
+    auto [vocab, mapping] =
+        ad_utility::detail::deserializeLocalVocab(serializer);
+    auto ids = ad_utility::detail::deserializeIds(
+        serializer, mapping, blankNodeMapping, newBlankNodeIndex);
+    constexpr size_t cols = IdTriple<0>::NumCols;
+    AD_CORRECTNESS_CHECK(ids.size() % cols == 0);
+    Triples triples;
+    triples.reserve(ids.size() / cols);
+    for (size_t i = 0; i < ids.size(); i += cols) {
+      triples.emplace_back(
+          std::array{ids[i], ids[i + 1], ids[i + 2], ids[i + 3]});
+    }
+    processRecord(operation, std::move(triples));
+    offset += RECORD_HEADER_SIZE + payloadSize;
+    ++numRecords;
+  }
+
+  // Remove an incomplete or corrupt tail (which can only be the result of a
+  // crash while writing), s.t. later records are not appended behind it.
+  if (offset < fileSize) {
+    AD_LOG_WARN << "Ignoring the last " << fileSize - offset
+                << " bytes of the update log " << filename
+                << ", which do not form a complete record" << std::endl;
+    file.close();
+    std::filesystem::resize_file(filename, offset);
+  }
+  AD_LOG_INFO << "Done, #records replayed = " << numRecords << std::endl;
+  return numRecords;
+}
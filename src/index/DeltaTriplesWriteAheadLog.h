@@ -0,0 +1,100 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
+#define QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "global/IdTriple.h"
+#include "util/Serializer/TripleSerializer.h"
+
+// An append-only log of the modifications of the `DeltaTriples`, which allows
+// persisting updates with a cost that is proportional to the size of the
+// update (and not to the total number of delta triples).
+//
+// The log consists of a header (magic bytes and version), followed by a
+// sequence of records. Each record consists of the size of its payload, a
+// checksum of the payload, and the payload itself. The payload contains the
+// operation (insert, delete, or clear), the `LocalVocab` entries that are
+// referenced by the triples, and the triples.
+//
+// Records are first buffered by `append` and then written with a single
+// system call by `commit` (group commit). When the process crashes while
+// writing a record, the incomplete or corrupt record and all the records after
+// it are ignored by `replay`.
+class DeltaTriplesWriteAheadLog {
+ public:
+  using Triples = std::vector<IdTriple<0>>;
+  enum class Operation : uint8_t { Delete = 0, Insert = 1, Clear = 2 };
+
+  // The size of the header of the log file and of each record.
+  static constexpr size_t FILE_HEADER_SIZE = 15;
+  static constexpr size_t RECORD_HEADER_SIZE = 2 * sizeof(uint64_t);
+
+ private:
+  std::string filename_;
+  // The file descriptor of the log file, which is opened on the first
+  // `commit`. A value of -1 means that the file is not open.
+  int fileDescriptor_ = -1;
+  // The records that were appended, but not yet committed.
+  std::vector<char> pendingRecords_;
+  // The number of commits since the last `fsync`.
+  size_t numCommitsSinceSync_ = 0;
+  // The size of the log file (including the committed records).
+  size_t sizeInBytes_ = 0;
+
+ public:
+  explicit DeltaTriplesWriteAheadLog(std::string filename);
+  ~DeltaTriplesWriteAheadLog();
+
+  // The log owns a file descriptor, so it can be moved but not copied.
+  DeltaTriplesWriteAheadLog(DeltaTriplesWriteAheadLog&& other) noexcept;
+  DeltaTriplesWriteAheadLog& operator=(
+      DeltaTriplesWriteAheadLog&& other) noexcept;
+  DeltaTriplesWriteAheadLog(const DeltaTriplesWriteAheadLog&) = delete;
+  DeltaTriplesWriteAheadLog& operator=(const DeltaTriplesWriteAheadLog&) =
+      delete;
+
+  // Buffer a record for the given `operation` on the given `triples`. The
+  // `LocalVocabEntry`s the triples refer to must not be destroyed before the
+  // next call to `commit`.
+  void append(Operation operation, const Triples& triples);
+
+  // Write all the buffered records to the log file. If `syncInterval` is
+  // larger than zero, the file is synced to disk on every `syncInterval`-th
+  // call. Calls without buffered records do nothing.
+  void commit(size_t syncInterval);
+
+  // Delete the log file and discard all buffered records. This is called after
+  // the complete state has been written to disk (checkpoint).
+  void remove();
+
+  // The size of the log file in bytes, including the committed records.
+  size_t sizeInBytes() const { return sizeInBytes_; }
+
+  const std::string& filename() const { return filename_; }
+
+  // Read all the valid records from the log file with the given `filename` and
+  // call `processRecord` for each of them (in the order in which they were
+  // appended). The `LocalVocab` entries of the triples are only valid during
+  // the call. Blank nodes are mapped via the `blankNodeMapping` and new blank
+  // nodes are created via `newBlankNodeIndex`. Returns the number of records.
+  // If the file does not exist, nothing happens.
+  static size_t replay(
+      const std::string& filename,
+      ad_utility::BlankNodeMapping& blankNodeMapping,
+      const std::function<BlankNodeIndex()>& newBlankNodeIndex,
+      const std::function<void(Operation, Triples)>& processRecord);
+
+ private:
+  // Open the log file, and write the header if it is newly created.
+  void open();
+  void close();
+};
+
+#endif  // QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
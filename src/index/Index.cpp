@@ -41,6 +41,26 @@ auto Index::getNonConstVocabForTesting() -> Vocab& {
   return pimpl_->getNonConstVocabForTesting();
 }
 
+// ____________________________________________________________________________
+VocabularyStringCache& Index::getVocabularyStringCache() const {
+  return pimpl_->getVocabularyStringCache();
+}
+
+// ____________________________________________________________________________
+const VocabularyNgramIndex* Index::getVocabularyNgramIndex() const {
+  return pimpl_->getVocabularyNgramIndex();
+}
+
+// ____________________________________________________________________________
+const SpatialIndex* Index::getSpatialIndex() const {
+  return pimpl_->getSpatialIndex();
+}
+
+// ____________________________________________________________________________
+const ReachabilityIndex& Index::getReachabilityIndex() const {
+  return pimpl_->getReachabilityIndex();
+}
+
 // ____________________________________________________________________________
 auto Index::getTextVocab() const -> const TextVocab& {
   return pimpl_->getTextVocab();
@@ -17,6 +17,7 @@
 #include "index/TextScanMode.h"
 #include "index/TextScoringEnum.h"
 #include "index/Vocabulary.h"
+#include "index/VocabularyStringCache.h"
 #include "parser/TripleComponent.h"
 #include "util/CancellationHandle.h"
 #include "util/json.h"
@@ -25,6 +26,9 @@
 class IdTable;
 class TextBlockMetaData;
 class IndexImpl;
+class VocabularyNgramIndex;
+class SpatialIndex;
+class ReachabilityIndex;
 struct LocatedTriplesSnapshot;
 class DeltaTriplesManager;
 
@@ -106,6 +110,22 @@ class Index {
   const EncodedIriManager& encodedIriManager() const;
   Vocab& getNonConstVocabForTesting();
 
+  // The cache for the words of the vocabulary that is used when exporting
+  // query results, see `VocabularyStringCache.h`.
+  VocabularyStringCache& getVocabularyStringCache() const;
+
+  // The trigram index of the vocabulary, or `nullptr` if the index was built
+  // without it, see `VocabularyNgramIndex.h`.
+  const VocabularyNgramIndex* getVocabularyNgramIndex() const;
+
+  // The R-tree of the bounding boxes of all geometries in the vocabulary, or
+  // `nullptr` if the index was built without it, see `SpatialIndex.h`.
+  const SpatialIndex* getSpatialIndex() const;
+
+  // The reachability index of the graphs of the configured predicates (which
+  // can also be extended at query time), see `ReachabilityIndex.h`.
+  const ReachabilityIndex& getReachabilityIndex() const;
+
   using TextVocab = TextVocabulary;
   [[nodiscard]] const TextVocab& getTextVocab() const;
 
@@ -0,0 +1,183 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/IndexBuildCheckpoint.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <filesystem>
+#include <system_error>
+
+#include "util/Exception.h"
+#include "util/File.h"
+#include "util/Log.h"
+
+namespace {
+// Return true iff all the files of a finished stage (given as an object that
+// maps the filenames to their sizes) exist and have the recorded size.
+bool filesAreComplete(const nlohmann::json& files) {
+  for (const auto& [filename, size] : files.items()) {
+    std::error_code error;
+    auto actualSize = std::filesystem::file_size(filename, error);
+    if (error || actualSize != size.get<uint64_t>()) {
+      AD_LOG_WARN << "The file \"" << filename
+                  << "\" is missing or has changed" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+IndexBuildCheckpoint::IndexBuildCheckpoint(const std::string& onDiskBase,
+                                           nlohmann::json settings,
+                                           bool resume)
+    : filename_{absl::StrCat(onDiskBase, FILE_SUFFIX)},
+      settings_{std::move(settings)} {
+  std::lock_guard lock{mutex_};
+  if (resume && !std::filesystem::exists(filename_)) {
+    AD_LOG_WARN << "There is no checkpoint of a previous index build (\""
+                << filename_ << "\"), the index is built from the beginning"
+                << std::endl;
+  } else if (resume) {
+    auto previous = ad_utility::fileToJson<nlohmann::json>(filename_);
+    if (previous.value("version", uint64_t{0}) != VERSION) {
+      AD_LOG_WARN << "The checkpoint of the previous index build has an "
+                     "outdated or unknown format, the index is built from the "
+                     "beginning"
+                  << std::endl;
+    } else if (previous.at("settings") != settings_) {
+      AD_LOG_WARN << "The checkpoint of the previous index build was created "
+                     "with different input files or settings, the index is "
+                     "built from the beginning"
+                  << std::endl;
+    } else {
+      for (const auto& [name, stage] :
+           previous.at("finished-stages").items()) {
+        if (filesAreComplete(stage.at("files"))) {
+          AD_LOG_INFO << "The stage \"" << name
+                      << "\" was finished by the previous index build"
+                      << std::endl;
+          finishedStages_[name] = stage;
+        } else {
+          AD_LOG_WARN << "The output of the stage \"" << name
+                      << "\" of the previous index build is incomplete, the "
+                         "stage is repeated"
+                      << std::endl;
+        }
+      }
+    }
+  }
+  write();
+}
+
+// _____________________________________________________________________________
+bool IndexBuildCheckpoint::isFinished(Stage stage) const {
+  std::lock_guard lock{mutex_};
+  return finishedStages_.contains(std::string{toString(stage)});
+}
+
+// _____________________________________________________________________________
+bool IndexBuildCheckpoint::isEmpty() const {
+  std::lock_guard lock{mutex_};
+  return finishedStages_.empty();
+}
+
+// _____________________________________________________________________________
+void IndexBuildCheckpoint::markFinished(Stage stage,
+                                        const std::vector<std::string>& files,
+                                        nlohmann::json data) {
+  nlohmann::json finishedStage;
+  finishedStage["files"] = nlohmann::json::object();
+  for (const auto& filename : files) {
+    finishedStage["files"][filename] = std::filesystem::file_size(filename);
+  }
+  finishedStage["data"] = std::move(data);
+  std::lock_guard lock{mutex_};
+  finishedStages_[std::string{toString(stage)}] = std::move(finishedStage);
+  write();
+  AD_LOG_DEBUG << "Finished the stage \"" << toString(stage)
+               << "\" of the index build" << std::endl;
+}
+
+// _____________________________________________________________________________
+nlohmann::json IndexBuildCheckpoint::getData(Stage stage) const {
+  std::lock_guard lock{mutex_};
+  auto it = finishedStages_.find(std::string{toString(stage)});
+  AD_CONTRACT_CHECK(it != finishedStages_.end(), [stage]() {
+    return absl::StrCat("The stage \"", toString(stage),
+                        "\" of the index build is not finished");
+  });
+  return it->at("data");
+}
+
+// _____________________________________________________________________________
+void IndexBuildCheckpoint::forget(Stage stage) {
+  std::lock_guard lock{mutex_};
+  finishedStages_.erase(std::string{toString(stage)});
+  write();
+}
+
+// _____________________________________________________________________________
+void IndexBuildCheckpoint::clear() {
+  std::lock_guard lock{mutex_};
+  finishedStages_ = nlohmann::json::object();
+  write();
+}
+
+// _____________________________________________________________________________
+void IndexBuildCheckpoint::remove() {
+  std::lock_guard lock{mutex_};
+  ad_utility::deleteFile(filename_);
+}
+
+// _____________________________________________________________________________
+std::string_view IndexBuildCheckpoint::toString(Stage stage) {
+  using enum Stage;
+  switch (stage) {
+    case ParsingAndPartialVocabularies:
+      return "parsing-and-partial-vocabularies";
+    case VocabularyMerge:
+      return "vocabulary-merge";
+    case IdConversion:
+      return "id-conversion";
+    case FirstPermutationPair:
+      return "first-permutation-pair";
+    case SecondPermutationPair:
+      return "second-permutation-pair";
+    case ThirdPermutationPair:
+      return "third-permutation-pair";
+    case Patterns:
+      return "patterns";
+    case InternalPermutations:
+      return "internal-permutations";
+    case TextIndex:
+      return "text-index";
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+void IndexBuildCheckpoint::write() const {
+  nlohmann::json checkpoint;
+  checkpoint["version"] = VERSION;
+  checkpoint["settings"] = settings_;
+  checkpoint["finished-stages"] = finishedStages_;
+  // Write to a temporary file first and then rename it, which replaces the
+  // previous checkpoint atomically.
+  std::string temporaryFilename = absl::StrCat(filename_, ".tmp");
+  {
+    auto file = ad_utility::makeOfstream(temporaryFilename);
+    file << checkpoint.dump(2) << std::endl;
+    file.close();
+    if (!file) {
+      throw std::runtime_error{absl::StrCat(
+          "Could not write the checkpoint of the index build to \"",
+          temporaryFilename, "\"")};
+    }
+  }
+  std::filesystem::rename(temporaryFilename, filename_);
+}
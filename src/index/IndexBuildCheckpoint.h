@@ -0,0 +1,128 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_INDEXBUILDCHECKPOINT_H
+#define QLEVER_SRC_INDEX_INDEXBUILDCHECKPOINT_H
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/json.h"
+
+// The stages of an index build that can be skipped when it is resumed, see
+// `IndexBuildCheckpoint` below.
+enum class IndexBuildStage {
+  // Parsing the input and writing the partial vocabularies and the triples
+  // with the partial IDs, see `IndexImpl::passFileForVocabulary`.
+  ParsingAndPartialVocabularies,
+  // Merging the partial vocabularies into the vocabulary of the index and
+  // writing the mappings from the partial to the global IDs, see
+  // `IndexImpl::mergeVocabularyAndIdMaps`.
+  VocabularyMerge,
+  // Converting the triples to the global IDs and sorting them for the first
+  // pair of permutations, see `IndexImpl::convertPartialToGlobalIds`.
+  IdConversion,
+  // The pairs of permutations, see `IndexImpl::createFirstPermutationPair`
+  // etc. If only the PSO and POS permutations are built, they are the first
+  // pair. The first pair also includes the vocabulary of the index.
+  FirstPermutationPair,
+  SecondPermutationPair,
+  ThirdPermutationPair,
+  // The patterns, which are computed while building the first pair.
+  Patterns,
+  // The PSO and POS permutations of the QLever-internal triples.
+  InternalPermutations,
+  // The text index, which is built after all the permutations, see
+  // `qlever::Qlever::buildIndex`.
+  TextIndex
+};
+
+// A file that records the finished stages of an index build, s.t. a build
+// that failed (for example, because it ran out of memory or disk space, or
+// because the process was killed) can be resumed without repeating them. For
+// each finished stage, the file contains the names and sizes of its output
+// files, which are checked before a stage is skipped, and additional data
+// that the later stages need. The file also contains the settings of the
+// build (input files and options) and the `VERSION` of its format. The
+// finished stages are only used by a build with the same settings and the same
+// version.
+//
+// The file is replaced atomically whenever a stage is finished, so it stays
+// consistent even if the build is killed while it is written.
+class IndexBuildCheckpoint {
+ public:
+  using Stage = IndexBuildStage;
+
+  // The suffix of the checkpoint file, which is appended to the basename of
+  // the index.
+  static constexpr std::string_view FILE_SUFFIX =
+      ".index-build-checkpoint.json";
+
+  // The version of the format of the checkpoint file. It has to be increased
+  // whenever the stages or the data that is recorded for them change, s.t.
+  // the checkpoints of older builds are not used.
+  static constexpr uint64_t VERSION = 1;
+
+ private:
+  std::string filename_;
+  nlohmann::json settings_;
+  // The finished stages, the keys are their names (see `toString`).
+  nlohmann::json finishedStages_ = nlohmann::json::object();
+  // The permutation pairs can be built concurrently.
+  mutable std::mutex mutex_;
+
+ public:
+  // Create the checkpoint for building the index with the given `onDiskBase`
+  // and `settings`, and write it to disk. If `resume` is true and the
+  // checkpoint file of a previous build with the same `settings` exists, the
+  // stages that were finished by that build and whose output files are still
+  // complete are also finished for this checkpoint.
+  IndexBuildCheckpoint(const std::string& onDiskBase, nlohmann::json settings,
+                       bool resume);
+
+  IndexBuildCheckpoint(const IndexBuildCheckpoint&) = delete;
+  IndexBuildCheckpoint& operator=(const IndexBuildCheckpoint&) = delete;
+
+  // Return true iff the `stage` is finished.
+  bool isFinished(Stage stage) const;
+
+  // Return true iff no stage is finished.
+  bool isEmpty() const;
+
+  // Record that the `stage` is finished with the given output `files` and the
+  // `data` for the later stages, and write the checkpoint file. The `files`
+  // must exist.
+  void markFinished(Stage stage, const std::vector<std::string>& files,
+                    nlohmann::json data = nlohmann::json::object());
+
+  // Return the data that was recorded for the finished `stage`.
+  nlohmann::json getData(Stage stage) const;
+
+  // Forget that the `stage` is finished and write the checkpoint file. This
+  // is used when the output files of a stage are deleted, because the later
+  // stages no longer need them.
+  void forget(Stage stage);
+
+  // Forget all the finished stages and write the checkpoint file. This is
+  // used when the index build has to start from the beginning.
+  void clear();
+
+  // Delete the checkpoint file. This is called when the index (including the
+  // text index, if one is built) is complete.
+  void remove();
+
+  const std::string& filename() const { return filename_; }
+
+  // Return the name of the `stage`, for example "first-permutation-pair".
+  static std::string_view toString(Stage stage);
+
+ private:
+  // Write the checkpoint file. The `mutex_` must be locked by the caller.
+  void write() const;
+};
+
+#endif  // QLEVER_SRC_INDEX_INDEXBUILDCHECKPOINT_H
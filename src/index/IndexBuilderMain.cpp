@@ -231,6 +231,22 @@ int main(int argc, char** argv) {
       "The vocabulary implementation for strings in qlever, can be any of ",
       ad_utility::VocabularyType::getListOfSupportedValues());
   add("vocabulary-type", po::value(&config.vocabType_), msg.c_str());
+  add("vocabulary-ngram-index",
+      po::bool_switch(&config.buildVocabularyNgramIndex_),
+      "Build a trigram index of the vocabulary, which speeds up the filters "
+      "`CONTAINS`, `STRSTARTS`, and `REGEX` with a constant pattern.");
+  add("spatial-index", po::bool_switch(&config.buildSpatialIndex_),
+      "Build an R-tree of the bounding boxes of all WKT literals, which is "
+      "used by the spatial search. Requires the vocabulary type "
+      "`on-disk-compressed-geo-split`.");
+  add("reachability-index",
+      po::value(&config.reachabilityIndexPredicates_)
+          ->composing()
+          ->multitoken(),
+      "Space-separated list of predicates (IRIs in angle brackets), for "
+      "which the reachability in the graph of the triples with that "
+      "predicate is precomputed. This speeds up transitive paths like "
+      "`?x <subClassOf>* ?y` with these predicates.");
 
   add("encode-as-id",
       po::value(&config.prefixesForIdEncodedIris_)->composing()->multitoken(),
@@ -250,6 +266,28 @@ int main(int argc, char** argv) {
       "large enough to hold a single input triple. Default: 10 MB.");
   add("keep-temporary-files,k", po::bool_switch(&config.keepTemporaryFiles_),
       "Do not delete temporary files from index creation for debugging.");
+  add("num-threads", po::value(&config.numThreadsIndexBuilding_),
+      "The number of threads that compress and write the blocks of each "
+      "permutation. Default: 10.");
+  add("parallel-permutations",
+      po::bool_switch(&config.buildPermutationPairsInParallel_),
+      "Build the OSP/OPS and the PSO/POS permutations at the same time, the "
+      "memory for sorting is then split between the two. This requires "
+      "`--no-patterns`, because with patterns (the default), the PSO/POS "
+      "permutations need the pattern columns from the OSP/OPS permutations.");
+  add("existing-index-basename", po::value(&config.existingIndexBaseName_),
+      "Merge the input into the existing index with this basename, which is "
+      "not modified. Only the input is parsed and sorted, the result is a "
+      "complete new index with the basename given by `--index-basename`. The "
+      "existing index must have all six permutations. This requires "
+      "`--no-patterns`, because the patterns of the subjects change with the "
+      "new triples. The text index of the existing index is not carried "
+      "over and has to be built again with the text index options.");
+  add("resume", po::bool_switch(&config.resume_),
+      "Resume a previous index build with the same basename, input files, and "
+      "settings that failed or was killed. Its finished stages (parsing, "
+      "vocabulary merge, ID conversion, the permutations, and the text "
+      "index) are validated and skipped.");
 
   // Process command line arguments.
   po::variables_map optionsMap;
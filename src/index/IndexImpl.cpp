@@ -8,6 +8,7 @@
 #include <absl/strings/str_join.h>
 
 #include <cstdio>
+#include <filesystem>
 #include <future>
 #include <numeric>
 #include <optional>
@@ -24,6 +25,7 @@
 #include "util/CachingMemoryResource.h"
 #include "util/Generator.h"
 #include "util/HashMap.h"
+#include "util/HashSet.h"
 #include "util/InputRangeUtils.h"
 #include "util/Iterators.h"
 #include "util/JoinAlgorithms/JoinAlgorithms.h"
@@ -36,12 +38,6 @@
 using std::array;
 using namespace ad_utility::memory_literals;
 
-// During the index building we typically have two permutations present at the
-// same time, as we directly push the triples from the first sorting to the
-// second sorting. We therefore have to adjust the amount of memory per external
-// sorter.
-static constexpr size_t NUM_EXTERNAL_SORTERS_AT_SAME_TIME = 2u;
-
 // _____________________________________________________________________________
 IndexImpl::IndexImpl(ad_utility::AllocatorWithLimit<Id> allocator)
     : allocator_{std::move(allocator)} {
@@ -51,10 +47,83 @@ IndexImpl::IndexImpl(ad_utility::AllocatorWithLimit<Id> allocator)
 
 // _____________________________________________________________________________
 IndexBuilderDataAsFirstPermutationSorter IndexImpl::createIdTriplesAndVocab(
-    std::shared_ptr<RdfParserBase> parser) {
-  auto indexBuilderData =
-      passFileForVocabulary(std::move(parser), numTriplesPerBatch_);
+    const std::vector<Index::InputFileSpecification>& files) {
+  using enum IndexBuildStage;
+  using VocabularyMetaData = ad_utility::vocabulary_merger::VocabularyMetaData;
+  const auto& checkpoint = indexBuildCheckpoint_.value();
+  if (hasSpatialIndex_ && !vocab_.isGeoInfoAvailable()) {
+    AD_LOG_WARN << "The spatial index can only be built for a vocabulary "
+                   "type with precomputed geometry information, it is "
+                   "therefore skipped"
+                << std::endl;
+    setBuildSpatialIndex(false);
+  }
+  // The mapping of the existing vocabulary to the new vocabulary was written
+  // by the vocabulary merge of the interrupted index build.
+  auto reopenNewIdsOfExistingVocabulary = [this]() {
+    if (existingIndex_.has_value()) {
+      existingIndex_.value().newIdsOfVocabulary_.open(
+          absl::StrCat(onDiskBase_, EXISTING_VOCAB_NEW_IDS_SUFFIX),
+          ad_utility::ReuseTag{}, ad_utility::AccessPattern::Random);
+    }
+  };
 
+  // If the previous index build was interrupted right after a stage was
+  // finished, the output of the stage before might not be deleted yet.
+  auto removeOutputIfFinished = [this, &checkpoint](IndexBuildStage stage) {
+    if (checkpoint.isFinished(stage)) {
+      removeOutputOfIndexBuildStage(stage);
+    }
+  };
+
+  if (checkpoint.isFinished(IdConversion)) {
+    AD_LOG_INFO << "Resuming the previous index build with the triples that "
+                   "were already converted to global IDs ..."
+                << std::endl;
+    removeOutputIfFinished(ParsingAndPartialVocabularies);
+    removeOutputIfFinished(VocabularyMerge);
+    auto data = checkpoint.getData(IdConversion);
+    setIdsOfVocabularyMergeFromIndexBuildCheckpoint(data);
+    reopenNewIdsOfExistingVocabulary();
+    FirstPermutationSorterAndInternalTriplesAsPso sorters;
+    if (loadAllPermutations()) {
+      sorters.firstPermutationSorter_ =
+          reopenSorterPtr<FirstPermutation>("first");
+    } else {
+      sorters.firstPermutationSorter_ = reopenSorterPtr<SortByPSO>("first");
+    }
+    sorters.internalTriplesPso_ =
+        reopenSorterPtr<SortByPSO, NumColumnsIndexBuilding>("internalTriples");
+    return {IndexBuilderDataBase{
+                data.at("vocabulary-metadata").get<VocabularyMetaData>()},
+            std::move(sorters)};
+  }
+
+  IndexBuilderDataAsExternalVector indexBuilderData;
+  if (checkpoint.isFinished(VocabularyMerge)) {
+    AD_LOG_INFO << "Resuming the previous index build with the vocabulary "
+                   "that was already merged ..."
+                << std::endl;
+    removeOutputIfFinished(ParsingAndPartialVocabularies);
+    auto data = checkpoint.getData(VocabularyMerge);
+    indexBuilderData = reopenPartialIdTriples(data);
+    indexBuilderData.vocabularyMetaData_ =
+        data.at("vocabulary-metadata").get<VocabularyMetaData>();
+    setIdsOfVocabularyMergeFromIndexBuildCheckpoint(data);
+    reopenNewIdsOfExistingVocabulary();
+  } else {
+    if (checkpoint.isFinished(ParsingAndPartialVocabularies)) {
+      AD_LOG_INFO << "Resuming the previous index build with the partial "
+                     "vocabularies that were already written ..."
+                  << std::endl;
+      indexBuilderData = reopenPartialIdTriples(
+          checkpoint.getData(ParsingAndPartialVocabularies));
+    } else {
+      indexBuilderData =
+          passFileForVocabulary(makeRdfParser(files), numTriplesPerBatch_);
+    }
+    mergeVocabularyAndIdMaps(indexBuilderData);
+  }
   auto isQleverInternalTriple = [&indexBuilderData](const auto& triple) {
     auto internal = [&indexBuilderData](Id id) {
       return indexBuilderData.vocabularyMetaData_.isQleverInternalId(id);
@@ -62,11 +131,35 @@ IndexBuilderDataAsFirstPermutationSorter IndexImpl::createIdTriplesAndVocab(
     return internal(triple[0]) || internal(triple[1]) || internal(triple[2]);
   };
 
-  auto firstSorter = convertPartialToGlobalIds(
+  auto sorters = convertPartialToGlobalIds(
       *indexBuilderData.idTriples, indexBuilderData.actualPartialSizes,
       NUM_TRIPLES_PER_PARTIAL_VOCAB, isQleverInternalTriple);
+  if (existingIndex_.has_value()) {
+    addInternalTriplesOfExistingIndex(*sorters.internalTriplesPso_);
+  }
+
+  // Make the converted triples durable, after that the triples with the
+  // partial IDs and the ID maps are no longer needed.
+  sorters.firstPermutationSorter_->persistUnderlying();
+  sorters.internalTriplesPso_->persist();
+  markIndexBuildStageFinished(
+      IdConversion,
+      {{"vocabulary-metadata", indexBuilderData.vocabularyMetaData_}});
+  removeOutputOfIndexBuildStage(VocabularyMerge);
 
-  return {indexBuilderData, std::move(firstSorter)};
+  return {indexBuilderData, std::move(sorters)};
+}
+
+// _____________________________________________________________________________
+IndexBuilderDataAsExternalVector IndexImpl::reopenPartialIdTriples(
+    const nlohmann::json& stageData) const {
+  IndexBuilderDataAsExternalVector result;
+  result.idTriples = std::make_unique<TripleVec>(
+      ad_utility::ReopenPersistedTag{}, filenameOfPartialIdTriples(), 1_GB,
+      allocator_);
+  result.actualPartialSizes =
+      stageData.at("actual-partial-sizes").get<std::vector<size_t>>();
+  return result;
 }
 
 // _____________________________________________________________________________
@@ -169,16 +262,39 @@ static auto fixBlockAfterPatternJoin(T block) {
 }  // namespace
 
 // ____________________________________________________________________________
-template <typename InternalTripleSorter>
+void IndexImpl::addHasPatternTriplesToInternalTriples(
+    PatternCreator::TripleSorter& sortersFromPatternCreator,
+    ExternalSorter<SortByPSO>& internalTriplesPsoSorter) const {
+  auto& hasPatternPredicateSortedByPSO =
+      sortersFromPatternCreator.hasPatternPredicateSortedByPSO_;
+  // We need the patterns twice: once for the internal permutations, and once
+  // for the additional column of the OSP and OPS permutations.
+  hasPatternPredicateSortedByPSO->moveResultOnMerge() = false;
+  // Add the `ql:has-pattern` predicate to the sorter such that it will become
+  // part of the PSO and POS permutation.
+  AD_LOG_INFO << "Adding " << hasPatternPredicateSortedByPSO->size()
+              << " triples to the POS and PSO permutation for "
+                 "the internal `ql:has-pattern` ..."
+              << std::endl;
+  static_assert(NumColumnsIndexBuilding == 4,
+                "When adding additional payload columns, the following code "
+                "has to be changed");
+  Id internalGraph = idOfInternalGraphDuringIndexBuilding_.value();
+  // Note: We are getting the patterns sorted by PSO and then sorting them again
+  // by PSO.
+  // TODO<joka921> Simply get the output unsorted (should be cheaper).
+  for (const auto& row : hasPatternPredicateSortedByPSO->sortedView()) {
+    internalTriplesPsoSorter.push(
+        std::array{row[0], row[1], row[2], internalGraph});
+  }
+}
+
+// ____________________________________________________________________________
 std::unique_ptr<ExternalSorter<SortByPSO, NumColumnsIndexBuilding + 2>>
 IndexImpl::buildOspWithPatterns(
-    PatternCreator::TripleSorter sortersFromPatternCreator,
-    InternalTripleSorter& internalTripleSorter) {
+    PatternCreator::TripleSorter sortersFromPatternCreator) {
   auto&& [hasPatternPredicateSortedByPSO, secondSorter] =
       sortersFromPatternCreator;
-  // We need the patterns twice: once for the additional column, and once for
-  // the additional permutation.
-  hasPatternPredicateSortedByPSO->moveResultOnMerge() = false;
   // The column with index 1 always is `has-predicate` and is not needed here.
   // Note that the order of the columns during index building  is always `SPO`,
   // but the sorting might be different (PSO in this case).
@@ -256,52 +372,24 @@ IndexImpl::buildOspWithPatterns(
   createSecondPermutationPair(NumColumnsIndexBuilding + 2,
                               std::move(blockGenerator), *thirdSorter);
   secondSorter->clear();
-  // Add the `ql:has-pattern` predicate to the sorter such that it will become
-  // part of the PSO and POS permutation.
-  AD_LOG_INFO << "Adding " << hasPatternPredicateSortedByPSO->size()
-              << " triples to the POS and PSO permutation for "
-                 "the internal `ql:has-pattern` ..."
-              << std::endl;
-  static_assert(NumColumnsIndexBuilding == 4,
-                "When adding additional payload columns, the following code "
-                "has to be changed");
-  Id internalGraph = idOfInternalGraphDuringIndexBuilding_.value();
-  // Note: We are getting the patterns sorted by PSO and then sorting them again
-  // by PSO.
-  // TODO<joka921> Simply get the output unsorted (should be cheaper).
-  for (const auto& row : hasPatternPredicateSortedByPSO->sortedView()) {
-    internalTripleSorter.push(
-        std::array{row[0], row[1], row[2], internalGraph});
-  }
   hasPatternPredicateSortedByPSO->clear();
   return thirdSorter;
 }
 
 // _____________________________________________________________________________
-template <typename InternalTriplePsoSorter>
 std::pair<size_t, size_t> IndexImpl::createInternalPSOandPOS(
-    InternalTriplePsoSorter&& internalTriplesPsoSorter) {
-  auto onDiskBaseBackup = onDiskBase_;
-  auto configurationJsonBackup = configurationJson_;
-  onDiskBase_.append(QLEVER_INTERNAL_INDEX_INFIX);
-
+    BlocksOfTriples sortedInternalTriples) {
   // TODO<joka921> As soon as `uniqueBlockView` is no longer a `generator` the
   // explicit `BlocksOfTriples` constructor can be removed again.
-  auto internalTriplesUnique = BlocksOfTriples{ad_utility::uniqueBlockView(
-      internalTriplesPsoSorter.template getSortedBlocks<0>())};
-  createPSOAndPOSImpl(NumColumnsIndexBuilding, std::move(internalTriplesUnique),
-                      false);
-  onDiskBase_ = std::move(onDiskBaseBackup);
+  auto internalTriplesUnique = BlocksOfTriples{
+      ad_utility::uniqueBlockView(std::move(sortedInternalTriples))};
   // The "normal" triples from the "internal" index builder are actually
-  // internal.
-  size_t numTriplesInternal =
-      static_cast<NumNormalAndInternal>(configurationJson_["num-triples"])
-          .normal;
-  size_t numPredicatesInternal =
-      static_cast<NumNormalAndInternal>(configurationJson_["num-predicates"])
-          .normal;
-  configurationJson_ = std::move(configurationJsonBackup);
-  return {numTriplesInternal, numPredicatesInternal};
+  // internal. This neither modifies the `onDiskBase_` nor the
+  // `configurationJson_`, so it can run concurrently with another pair.
+  return createPSOAndPOSImpl(
+      NumColumnsIndexBuilding,
+      absl::StrCat(onDiskBase_, QLEVER_INTERNAL_INDEX_INFIX),
+      std::move(internalTriplesUnique), false);
 }
 
 // _____________________________________________________________________________
@@ -349,6 +437,92 @@ void IndexImpl::updateInputFileSpecificationsAndLog(
   }
 }
 
+namespace {
+// Merge the `blocks1` and `blocks2` of triples (with `NumColumnsIndexBuilding`
+// columns), which both have to be sorted by the `comparator`, into a single
+// sorted range of blocks. Duplicates are not removed.
+template <typename Comparator>
+IndexImpl::BlocksOfTriples mergeSortedBlocks(
+    IndexImpl::BlocksOfTriples blocks1, IndexImpl::BlocksOfTriples blocks2,
+    Comparator comparator) {
+  // One of the two inputs, with its current block and the current row in that
+  // block.
+  struct Input {
+    IndexImpl::BlocksOfTriples blocks_;
+    std::optional<IdTableStatic<0>> block_ = std::nullopt;
+    size_t row_ = 0;
+    bool isExhausted_ = false;
+
+    // Return false iff there are no more rows.
+    bool hasRow() {
+      while (!isExhausted_ &&
+             (!block_.has_value() || row_ == block_->numRows())) {
+        block_ = blocks_.get();
+        row_ = 0;
+        isExhausted_ = !block_.has_value();
+      }
+      return !isExhausted_;
+    }
+
+    // Append the rows of the current block up to `endRow` to the `result`.
+    void moveRowsTo(IdTableStatic<0>& result, size_t endRow) {
+      result.insertAtEnd(block_.value(), row_, endRow);
+      row_ = endRow;
+    }
+  };
+
+  struct Merger : ad_utility::InputRangeFromGet<IdTableStatic<0>> {
+    std::array<Input, 2> inputs_;
+    Comparator comparator_;
+
+    Merger(IndexImpl::BlocksOfTriples blocks1,
+           IndexImpl::BlocksOfTriples blocks2, Comparator comparator)
+        : inputs_{Input{std::move(blocks1)}, Input{std::move(blocks2)}},
+          comparator_{std::move(comparator)} {}
+
+    std::optional<IdTableStatic<0>> get() override {
+      IdTableStatic<0> result{NumColumnsIndexBuilding,
+                              ad_utility::makeUnlimitedAllocator<Id>()};
+      auto& [first, second] = inputs_;
+      while (result.numRows() < BLOCKSIZE_MERGE_WITH_EXISTING_INDEX) {
+        bool firstHasRow = first.hasRow();
+        bool secondHasRow = second.hasRow();
+        if (!firstHasRow || !secondHasRow) {
+          if (!firstHasRow && !secondHasRow) {
+            break;
+          }
+          auto& input = firstHasRow ? first : second;
+          input.moveRowsTo(result, input.block_->numRows());
+          continue;
+        }
+        // Take the rows of the first block that are not greater than the
+        // current row of the second block. If there are none, take the rows
+        // of the second block that are less than the current row of the first
+        // block (there is at least one).
+        const auto& block1 = first.block_.value();
+        const auto& block2 = second.block_.value();
+        auto end1 = std::upper_bound(block1.begin() + first.row_, block1.end(),
+                                     block2[second.row_], comparator_);
+        if (end1 != block1.begin() + first.row_) {
+          first.moveRowsTo(result, end1 - block1.begin());
+          continue;
+        }
+        auto end2 = std::lower_bound(block2.begin() + second.row_,
+                                     block2.end(), block1[first.row_],
+                                     comparator_);
+        second.moveRowsTo(result, end2 - block2.begin());
+      }
+      if (result.empty()) {
+        return std::nullopt;
+      }
+      return result;
+    }
+  };
+  return IndexImpl::BlocksOfTriples{std::make_unique<Merger>(
+      std::move(blocks1), std::move(blocks2), std::move(comparator))};
+}
+}  // namespace
+
 // _____________________________________________________________________________
 void IndexImpl::createFromFiles(
     std::vector<Index::InputFileSpecification> files) {
@@ -356,6 +530,19 @@ void IndexImpl::createFromFiles(
     throw std::runtime_error{
         "The patterns can only be built when all 6 permutations are created"};
   }
+  if (existingIndexBaseName_.has_value() && usePatterns_) {
+    throw std::runtime_error{
+        "An incremental index build is only possible without patterns, "
+        "because the OSP/OPS and PSO/POS permutations store the pattern of "
+        "each subject, which changes with the new triples. Build the index "
+        "with `--no-patterns` or without `--existing-index-basename`"};
+  }
+  if (buildPermutationPairsInParallel_ && usePatterns_) {
+    throw std::runtime_error{
+        "The permutations can only be built in parallel without patterns, "
+        "because the PSO and POS permutations need the pattern columns that "
+        "are computed when building the OSP and OPS permutations"};
+  }
 
   configurationJson_["encoded-iri-prefixes"] = encodedIriManager();
 
@@ -363,12 +550,56 @@ void IndexImpl::createFromFiles(
 
   readIndexBuilderSettingsFromFile();
 
+  // Check which stages of a previous index build can be skipped.
+  using enum IndexBuildStage;
+  indexBuildCheckpoint_.reset();
+  indexBuildCheckpoint_.emplace(onDiskBase_,
+                                settingsForIndexBuildCheckpoint(files),
+                                resumeIndexBuild_);
+  if (canResumeIndexBuild()) {
+    resumeIndexBuild();
+    if (!keepIndexBuildCheckpoint_) {
+      indexBuildCheckpoint_->remove();
+    }
+    AD_LOG_INFO << "Index build completed" << std::endl;
+    return;
+  }
+  // Without the first pair and the internal permutations, the previous index
+  // build is resumed from the last of its stages before the permutations (see
+  // `createIdTriplesAndVocab`), and all the permutations are built again.
+  auto isFinished = [this](IndexBuildStage stage) {
+    return indexBuildCheckpoint_->isFinished(stage);
+  };
+  if (ql::ranges::any_of(
+          std::array{ParsingAndPartialVocabularies, VocabularyMerge,
+                     IdConversion},
+          isFinished)) {
+    for (auto stage : {FirstPermutationPair, SecondPermutationPair,
+                       ThirdPermutationPair, Patterns, InternalPermutations}) {
+      indexBuildCheckpoint_->forget(stage);
+    }
+  } else if (!indexBuildCheckpoint_->isEmpty()) {
+    AD_LOG_WARN << "The previous index build can only be resumed from its "
+                   "permutations if its first pair of permutations and its "
+                   "internal permutations were built, the output of the "
+                   "stages before is missing. The index is built from the "
+                   "beginning"
+                << std::endl;
+    indexBuildCheckpoint_->clear();
+  }
+
+  if (existingIndexBaseName_.has_value()) {
+    loadExistingIndex();
+  }
+
   updateInputFileSpecificationsAndLog(files, useParallelParser_);
   IndexBuilderDataAsFirstPermutationSorter indexBuilderData =
-      createIdTriplesAndVocab(makeRdfParser(files));
+      createIdTriplesAndVocab(files);
 
   // Write the configuration already at this point, so we have it available in
-  // case any of the permutations fail.
+  // case any of the permutations fail (and for resuming the index build).
+  configurationJson_["num-blank-nodes-total"] =
+      indexBuilderData.vocabularyMetaData_.getNextBlankNodeIndex();
   writeConfiguration();
 
   auto& firstSorter = *indexBuilderData.sorter_.firstPermutationSorter_;
@@ -376,14 +607,40 @@ void IndexImpl::createFromFiles(
   size_t numTriplesInternal = 0;
   size_t numPredicatesInternal = 0;
 
+  // The `ql:has-pattern` triples, which are added to the internal triples
+  // after the first pair. They are sorted separately, because the sorter of
+  // the other internal triples was already persisted.
+  std::unique_ptr<ExternalSorter<SortByPSO>> hasPatternTriplesPso;
+
   // Create the internal PSO and POS permutations. This has to be called AFTER
   // all triples have been added to the `internalTriplesPso_` sorter, in
   // particular, after the patterns have been created.
   auto createInternalPsoAndPosAndSetMetadata = [this, &numTriplesInternal,
                                                 &numPredicatesInternal,
-                                                &indexBuilderData]() {
+                                                &indexBuilderData,
+                                                &hasPatternTriplesPso]() {
+    BlocksOfTriples internalTriples{indexBuilderData.sorter_.internalTriplesPso_
+                                        ->template getSortedBlocks<0>()};
+    if (hasPatternTriplesPso) {
+      internalTriples = mergeSortedBlocks(
+          std::move(internalTriples),
+          hasPatternTriplesPso->template getSortedBlocks<0>(), SortByPSO{});
+    }
     std::tie(numTriplesInternal, numPredicatesInternal) =
-        createInternalPSOandPOS(*indexBuilderData.sorter_.internalTriplesPso_);
+        createInternalPSOandPOS(std::move(internalTriples));
+    markIndexBuildStageFinished(
+        InternalPermutations,
+        {{"num-triples-internal", numTriplesInternal},
+         {"num-predicates-internal", numPredicatesInternal}});
+  };
+
+  // The triples that were converted to global IDs are no longer needed when
+  // the first pair and the internal permutations are finished.
+  auto clearConvertedTriples = [this, &hasPatternTriplesPso]() {
+    removeOutputOfIndexBuildStage(IdConversion);
+    if (hasPatternTriplesPso) {
+      hasPatternTriplesPso->clear();
+    }
   };
 
   // TODO: this will become ad_utility::InputRangeErased so no conversion
@@ -398,7 +655,83 @@ void IndexImpl::createFromFiles(
     // PSO sorter, and `createPermutationPair` creates PSO/POS permutations.
     createFirstPermutationPair(NumColumnsIndexBuilding,
                                std::move(firstSorterWithUnique));
+    markIndexBuildStageFinished(FirstPermutationPair);
+    clearConvertedTriples();
     configurationJson_["has-all-permutations"] = false;
+  } else if (existingIndex_.has_value()) {
+    // For an incremental index build (which is only possible without
+    // patterns, see above), the triples of the existing index are merged into
+    // each pair of permutations.
+    AD_CORRECTNESS_CHECK(!usePatterns_);
+    createInternalPsoAndPosAndSetMetadata();
+    // Only the new triples have to be sorted for the second and third pair,
+    // the triples of the existing index are already sorted in its
+    // permutations. The new triples are therefore pushed to the two sorters
+    // before they are merged with the existing triples for the first pair.
+    auto secondSorter = makeSorter<SecondPermutation>(
+        "second", 2 * NUM_EXTERNAL_SORTERS_AT_SAME_TIME);
+    auto thirdSorter = makeSorter<ThirdPermutation>(
+        "third", 2 * NUM_EXTERNAL_SORTERS_AT_SAME_TIME);
+    auto pushToNextSorters = [&secondSorter, &thirdSorter](auto& block) {
+      secondSorter.pushBlock(block);
+      thirdSorter.pushBlock(block);
+      return std::move(block);
+    };
+    BlocksOfTriples newTriples{ad_utility::CachingTransformInputRange{
+        ad_utility::OwningView{std::move(firstSorterWithUnique)},
+        pushToNextSorters}};
+    createFirstPermutationPair(
+        NumColumnsIndexBuilding,
+        mergeWithExistingPermutation(std::move(newTriples),
+                                     Permutation::Enum::SPO,
+                                     FirstPermutation{}));
+    markIndexBuildStageFinished(FirstPermutationPair);
+    clearConvertedTriples();
+    createSecondPermutationPair(
+        NumColumnsIndexBuilding,
+        mergeWithExistingPermutation(secondSorter.getSortedBlocks<0>(),
+                                     Permutation::Enum::OSP,
+                                     SecondPermutation{}));
+    secondSorter.clear();
+    markIndexBuildStageFinished(SecondPermutationPair);
+    createThirdPermutationPair(
+        NumColumnsIndexBuilding,
+        mergeWithExistingPermutation(thirdSorter.getSortedBlocks<0>(),
+                                     Permutation::Enum::PSO,
+                                     ThirdPermutation{}));
+    markIndexBuildStageFinished(ThirdPermutationPair);
+    configurationJson_["has-all-permutations"] = true;
+  } else if (!usePatterns_ && buildPermutationPairsInParallel_) {
+    createInternalPsoAndPosAndSetMetadata();
+    // Without patterns, the OSP/OPS and PSO/POS permutations both only depend
+    // on the set of triples. Both of their sorters are therefore filled while
+    // building the SPO/SOP permutations, and the two remaining pairs are then
+    // built at the same time. The first sorter is still needed while the two
+    // other sorters are filled, so the two other sorters share the memory of
+    // one sorter.
+    auto secondSorter = makeSorter<SecondPermutation>(
+        "second", 2 * NUM_EXTERNAL_SORTERS_AT_SAME_TIME);
+    auto thirdSorter = makeSorter<ThirdPermutation>(
+        "third", 2 * NUM_EXTERNAL_SORTERS_AT_SAME_TIME);
+    static_assert(std::is_same_v<FirstPermutation, SortBySPO>);
+    createSPOAndSOP(NumColumnsIndexBuilding, std::move(firstSorterWithUnique),
+                    secondSorter, thirdSorter);
+    markIndexBuildStageFinished(FirstPermutationPair);
+    clearConvertedTriples();
+
+    // Note: If building the third pair throws, the destructor of the future
+    // waits until the second pair is finished.
+    auto secondPair = std::async(std::launch::async, [this, &secondSorter]() {
+      createSecondPermutationPair(NumColumnsIndexBuilding,
+                                  secondSorter.getSortedBlocks<0>());
+      secondSorter.clear();
+      markIndexBuildStageFinished(SecondPermutationPair);
+    });
+    createThirdPermutationPair(NumColumnsIndexBuilding,
+                               thirdSorter.getSortedBlocks<0>());
+    markIndexBuildStageFinished(ThirdPermutationPair);
+    secondPair.get();
+    configurationJson_["has-all-permutations"] = true;
   } else if (!usePatterns_) {
     createInternalPsoAndPosAndSetMetadata();
     // Without patterns, we explicitly have to pass in the next sorters to all
@@ -406,14 +739,17 @@ void IndexImpl::createFromFiles(
     auto secondSorter = makeSorter<SecondPermutation>("second");
     createFirstPermutationPair(NumColumnsIndexBuilding,
                                std::move(firstSorterWithUnique), secondSorter);
-    firstSorter.clearUnderlying();
+    markIndexBuildStageFinished(FirstPermutationPair);
+    clearConvertedTriples();
 
     auto thirdSorter = makeSorter<ThirdPermutation>("third");
     createSecondPermutationPair(NumColumnsIndexBuilding,
                                 secondSorter.getSortedBlocks<0>(), thirdSorter);
     secondSorter.clear();
+    markIndexBuildStageFinished(SecondPermutationPair);
     createThirdPermutationPair(NumColumnsIndexBuilding,
                                thirdSorter.getSortedBlocks<0>());
+    markIndexBuildStageFinished(ThirdPermutationPair);
     configurationJson_["has-all-permutations"] = true;
   } else {
     // Load all permutations and also load the patterns. In this case the
@@ -421,24 +757,577 @@ void IndexImpl::createFromFiles(
     // enriched with the patterns of the subjects in the triple.
     auto patternOutput = createFirstPermutationPair(
         NumColumnsIndexBuilding, std::move(firstSorterWithUnique));
-    firstSorter.clearUnderlying();
-    auto thirdSorterPtr =
-        buildOspWithPatterns(std::move(patternOutput.value()),
-                             *indexBuilderData.sorter_.internalTriplesPso_);
+    markIndexBuildStageFinished(FirstPermutationPair);
+    markIndexBuildStageFinished(Patterns);
+    // The internal permutations are built before the OSP and OPS permutations,
+    // s.t. an interrupted index build can be resumed after the first pair.
+    hasPatternTriplesPso = makeSorterPtr<SortByPSO>("internalHasPattern");
+    addHasPatternTriplesToInternalTriples(patternOutput.value(),
+                                          *hasPatternTriplesPso);
     createInternalPsoAndPosAndSetMetadata();
+    clearConvertedTriples();
+    auto thirdSorterPtr =
+        buildOspWithPatterns(std::move(patternOutput.value()));
+    markIndexBuildStageFinished(SecondPermutationPair);
     createThirdPermutationPair(NumColumnsIndexBuilding + 2,
                                thirdSorterPtr->template getSortedBlocks<0>());
+    markIndexBuildStageFinished(ThirdPermutationPair);
     configurationJson_["has-all-permutations"] = true;
   }
 
-  configurationJson_["num-blank-nodes-total"] =
-      indexBuilderData.vocabularyMetaData_.getNextBlankNodeIndex();
-
   addInternalStatisticsToConfiguration(numTriplesInternal,
                                        numPredicatesInternal);
+  if (existingIndex_.has_value()) {
+    existingIndex_.reset();
+    deleteTemporaryFile(
+        absl::StrCat(onDiskBase_, EXISTING_VOCAB_NEW_IDS_SUFFIX));
+  }
+  // All the permutations are complete, so there is nothing left to resume
+  // (unless the text index is built afterwards).
+  if (!keepIndexBuildCheckpoint_) {
+    indexBuildCheckpoint_->remove();
+  }
   AD_LOG_INFO << "Index build completed" << std::endl;
 }
 
+// _____________________________________________________________________________
+nlohmann::json IndexImpl::settingsForIndexBuildCheckpoint(
+    const std::vector<Index::InputFileSpecification>& files) const {
+  nlohmann::json settings;
+  settings["input-files"] = nlohmann::json::array();
+  for (const auto& file : files) {
+    nlohmann::json input;
+    input["filename"] = file.filename_;
+    input["filetype"] = static_cast<int>(file.filetype_);
+    input["default-graph"] = file.defaultGraph_;
+    // Detect (as far as possible) whether an input file has changed since the
+    // interrupted index build. This is not possible for streams.
+    std::error_code error;
+    if (std::filesystem::is_regular_file(file.filename_, error)) {
+      input["size"] = std::filesystem::file_size(file.filename_);
+      auto lastWriteTime = std::filesystem::last_write_time(file.filename_);
+      input["last-write-time"] = lastWriteTime.time_since_epoch().count();
+    }
+    settings["input-files"].push_back(std::move(input));
+  }
+  if (!settingsFileName_.empty()) {
+    auto f = ad_utility::makeIfstream(settingsFileName_);
+    f >> settings["settings-file"];
+  }
+  // The settings that were passed via setters and the settings file.
+  settings["configuration"] = configurationJson_;
+  settings["use-patterns"] = usePatterns_;
+  settings["load-all-permutations"] = loadAllPermutations_;
+  settings["kb-name"] = getKbName();
+  settings["blocksize-permutations-per-column"] =
+      blocksizePermutationPerColumn_.getBytes();
+  settings["existing-index"] = existingIndexBaseName_;
+  return settings;
+}
+
+// _____________________________________________________________________________
+std::vector<std::string> IndexImpl::outputFilesOfIndexBuildStage(
+    IndexBuildStage stage) const {
+  std::vector<std::string> files;
+  auto addPermutations = [this, &files](std::string_view infix,
+                                        const Permutation& permutation1,
+                                        const Permutation& permutation2) {
+    for (const auto* permutation : {&permutation1, &permutation2}) {
+      auto filename =
+          absl::StrCat(onDiskBase_, infix, ".index", permutation->fileSuffix());
+      files.push_back(absl::StrCat(filename, MMAP_FILE_SUFFIX));
+      files.push_back(std::move(filename));
+    }
+  };
+  auto addReachabilityIndex = [this, &files]() {
+    if (!reachabilityIndexPredicates_.empty()) {
+      files.push_back(absl::StrCat(onDiskBase_, REACHABILITY_INDEX_SUFFIX));
+    }
+  };
+  // Add all the files whose name starts with `onDiskBase_ + suffix` (the
+  // vocabulary consists of several files, depending on its type).
+  auto addFilesWithPrefix = [this, &files](std::string_view suffix) {
+    std::filesystem::path prefix{absl::StrCat(onDiskBase_, suffix)};
+    auto directory = prefix.parent_path();
+    std::string filenamePrefix = prefix.filename().string();
+    for (const auto& entry : std::filesystem::directory_iterator(
+             directory.empty() ? std::filesystem::path{"."} : directory)) {
+      std::string filename = entry.path().filename().string();
+      if (entry.is_regular_file() && filename.starts_with(filenamePrefix)) {
+        files.push_back((directory / filename).string());
+      }
+    }
+  };
+  // The persisted files of an external sorter or table, see
+  // `CompressedExternalIdTable::persist`.
+  auto addPersisted = [&files](std::string filename) {
+    files.push_back(absl::StrCat(
+        filename,
+        ad_utility::CompressedExternalIdTableWriter::METADATA_SUFFIX));
+    files.push_back(std::move(filename));
+  };
+  auto addNewIdsOfExistingVocabulary = [this, &files]() {
+    if (existingIndex_.has_value()) {
+      files.push_back(absl::StrCat(onDiskBase_, EXISTING_VOCAB_NEW_IDS_SUFFIX));
+    }
+  };
+  using enum IndexBuildStage;
+  switch (stage) {
+    case ParsingAndPartialVocabularies:
+      addFilesWithPrefix(PARTIAL_VOCAB_WORDS_INFIX);
+      addPersisted(filenameOfPartialIdTriples());
+      break;
+    case VocabularyMerge:
+      // The vocabulary (including the trigrams of the `VocabularyNgramIndex`)
+      // and the `SpatialIndex` are written by the merge.
+      addFilesWithPrefix(VOCAB_SUFFIX);
+      addFilesWithPrefix(SPATIAL_INDEX_SUFFIX);
+      addFilesWithPrefix(PARTIAL_VOCAB_IDMAP_INFIX);
+      addPersisted(filenameOfPartialIdTriples());
+      addNewIdsOfExistingVocabulary();
+      break;
+    case IdConversion:
+      addFilesWithPrefix(VOCAB_SUFFIX);
+      addFilesWithPrefix(SPATIAL_INDEX_SUFFIX);
+      addPersisted(filenameOfSorter("first"));
+      addPersisted(filenameOfSorter("internalTriples"));
+      addNewIdsOfExistingVocabulary();
+      break;
+    case FirstPermutationPair:
+      // The first pair can only be used with the vocabulary it was built with.
+      addFilesWithPrefix(VOCAB_SUFFIX);
+      addFilesWithPrefix(SPATIAL_INDEX_SUFFIX);
+      if (loadAllPermutations_) {
+        addPermutations("", spo_, sop_);
+      } else {
+        addPermutations("", pso_, pos_);
+        addReachabilityIndex();
+      }
+      break;
+    case SecondPermutationPair:
+      addPermutations("", osp_, ops_);
+      break;
+    case ThirdPermutationPair:
+      addPermutations("", pso_, pos_);
+      addReachabilityIndex();
+      break;
+    case Patterns:
+      files.push_back(absl::StrCat(onDiskBase_, ".index.patterns"));
+      break;
+    case InternalPermutations:
+      addPermutations(QLEVER_INTERNAL_INDEX_INFIX, pso_, pos_);
+      break;
+    case TextIndex:
+      // The text index is recorded by `qlever::Qlever::buildIndex`.
+      AD_FAIL();
+  }
+  return files;
+}
+
+// _____________________________________________________________________________
+void IndexImpl::markIndexBuildStageFinished(IndexBuildStage stage,
+                                            nlohmann::json data) {
+  using enum IndexBuildStage;
+  if (stage == VocabularyMerge || stage == IdConversion ||
+      stage == FirstPermutationPair) {
+    // The IDs from the vocabulary merge are needed when the index build is
+    // resumed after one of these stages.
+    std::vector<Id::T> reachabilityIndexPredicateIds;
+    for (Id id : reachabilityIndexPredicateIdsDuringIndexBuilding_) {
+      reachabilityIndexPredicateIds.push_back(id.getBits());
+    }
+    data["id-of-has-pattern"] = idOfHasPatternDuringIndexBuilding_->getBits();
+    data["id-of-internal-graph"] =
+        idOfInternalGraphDuringIndexBuilding_->getBits();
+    data["reachability-index-predicate-ids"] = reachabilityIndexPredicateIds;
+  }
+  indexBuildCheckpoint_.value().markFinished(
+      stage, outputFilesOfIndexBuildStage(stage), std::move(data));
+  if (interruptIndexBuildAfterStage_ == stage) {
+    throw std::runtime_error{
+        absl::StrCat("The index build was interrupted after the stage \"",
+                     IndexBuildCheckpoint::toString(stage), "\"")};
+  }
+}
+
+// _____________________________________________________________________________
+void IndexImpl::removeOutputOfIndexBuildStage(IndexBuildStage stage) {
+  auto& checkpoint = indexBuildCheckpoint_.value();
+  auto data = checkpoint.getData(stage);
+  // The stage is forgotten first, s.t. the checkpoint never refers to files
+  // that are already deleted.
+  checkpoint.forget(stage);
+  AD_LOG_DEBUG << "Removing the temporary files of the stage \""
+               << IndexBuildCheckpoint::toString(stage)
+               << "\" of the index build ..." << std::endl;
+  auto deletePersisted = [this](const std::string& filename) {
+    deleteTemporaryFile(absl::StrCat(
+        filename,
+        ad_utility::CompressedExternalIdTableWriter::METADATA_SUFFIX));
+    deleteTemporaryFile(filename);
+  };
+  auto deletePartialFiles = [this, &data](std::string_view infix,
+                                          size_t numAdditionalFiles) {
+    size_t numFiles =
+        data.at("actual-partial-sizes").size() + numAdditionalFiles;
+    for (size_t i = 0; i < numFiles; ++i) {
+      deleteTemporaryFile(absl::StrCat(onDiskBase_, infix, i));
+    }
+  };
+  using enum IndexBuildStage;
+  switch (stage) {
+    case ParsingAndPartialVocabularies:
+      // For an incremental index build, the vocabulary of the existing index
+      // was written as an additional partial vocabulary for the merge. The
+      // triples with the partial IDs are still needed for the ID conversion.
+      deletePartialFiles(PARTIAL_VOCAB_WORDS_INFIX,
+                         existingIndex_.has_value() ? 1 : 0);
+      break;
+    case VocabularyMerge:
+      deletePartialFiles(PARTIAL_VOCAB_IDMAP_INFIX, 0);
+      deletePersisted(filenameOfPartialIdTriples());
+      break;
+    case IdConversion:
+      deletePersisted(filenameOfSorter("first"));
+      deletePersisted(filenameOfSorter("internalTriples"));
+      break;
+    default:
+      AD_FAIL();
+  }
+}
+
+// _____________________________________________________________________________
+void IndexImpl::setIdsOfVocabularyMergeFromIndexBuildCheckpoint(
+    const nlohmann::json& data) {
+  idOfHasPatternDuringIndexBuilding_ =
+      Id::fromBits(data.at("id-of-has-pattern").get<Id::T>());
+  idOfInternalGraphDuringIndexBuilding_ =
+      Id::fromBits(data.at("id-of-internal-graph").get<Id::T>());
+  reachabilityIndexPredicateIdsDuringIndexBuilding_.clear();
+  for (const auto& bits : data.at("reachability-index-predicate-ids")) {
+    reachabilityIndexPredicateIdsDuringIndexBuilding_.push_back(
+        Id::fromBits(bits.get<Id::T>()));
+  }
+}
+
+// _____________________________________________________________________________
+bool IndexImpl::canResumeIndexBuild() const {
+  using enum IndexBuildStage;
+  std::vector stages{FirstPermutationPair, InternalPermutations};
+  if (usePatterns_) {
+    stages.push_back(Patterns);
+  }
+  return ql::ranges::all_of(stages, [this](IndexBuildStage stage) {
+    return indexBuildCheckpoint_.value().isFinished(stage);
+  });
+}
+
+// _____________________________________________________________________________
+void IndexImpl::resumeIndexBuild() {
+  using enum IndexBuildStage;
+  const auto& checkpoint = indexBuildCheckpoint_.value();
+  AD_LOG_INFO << "Resuming the previous index build, the finished stages are "
+                 "skipped ..."
+              << std::endl;
+  // The configuration was written by the previous index build after each of
+  // its pairs of permutations.
+  configurationJson_ = ad_utility::fileToJson<nlohmann::json>(
+      absl::StrCat(onDiskBase_, CONFIGURATION_FILE));
+  setIdsOfVocabularyMergeFromIndexBuildCheckpoint(
+      checkpoint.getData(FirstPermutationPair));
+  // The previous index build might have been interrupted right before it
+  // deleted the triples that were converted to global IDs.
+  if (checkpoint.isFinished(IdConversion)) {
+    removeOutputOfIndexBuildStage(IdConversion);
+  }
+
+  bool buildSecondPair =
+      loadAllPermutations_ && !checkpoint.isFinished(SecondPermutationPair);
+  bool buildThirdPair =
+      loadAllPermutations_ && !checkpoint.isFinished(ThirdPermutationPair);
+  if (!usePatterns_ && (buildSecondPair || buildThirdPair)) {
+    // Without patterns, the two other pairs are built from the triples of the
+    // first pair, like for `buildPermutationPairsInParallel_`.
+    auto secondSorter = makeSorter<SecondPermutation>(
+        "second", 2 * NUM_EXTERNAL_SORTERS_AT_SAME_TIME);
+    auto thirdSorter = makeSorter<ThirdPermutation>(
+        "third", 2 * NUM_EXTERNAL_SORTERS_AT_SAME_TIME);
+    for (const auto& block : scanPermutationOfInterruptedIndexBuild(
+             Permutation::Enum::SPO, NumColumnsIndexBuilding)) {
+      if (buildSecondPair) {
+        secondSorter.pushBlock(block);
+      }
+      if (buildThirdPair) {
+        thirdSorter.pushBlock(block);
+      }
+    }
+    if (buildSecondPair) {
+      createSecondPermutationPair(NumColumnsIndexBuilding,
+                                  secondSorter.getSortedBlocks<0>());
+      secondSorter.clear();
+      markIndexBuildStageFinished(SecondPermutationPair);
+    }
+    if (buildThirdPair) {
+      createThirdPermutationPair(NumColumnsIndexBuilding,
+                                 thirdSorter.getSortedBlocks<0>());
+      markIndexBuildStageFinished(ThirdPermutationPair);
+    }
+  } else if (usePatterns_ && (buildSecondPair || buildThirdPair)) {
+    // With patterns, the OSP and OPS permutations need the output of the
+    // `PatternCreator` (which is computed again from the SPO permutation, and
+    // rewrites the same patterns), and the PSO and POS permutations need the
+    // pattern columns of the OSP permutation.
+    std::unique_ptr<ExternalSorter<SortByPSO, NumColumnsIndexBuilding + 2>>
+        thirdSorter;
+    if (buildSecondPair) {
+      PatternCreator patternCreator{
+          onDiskBase_ + ".index.patterns",
+          idOfHasPatternDuringIndexBuilding_.value(),
+          memoryLimitIndexBuilding() / NUM_EXTERNAL_SORTERS_AT_SAME_TIME};
+      for (const auto& block : scanPermutationOfInterruptedIndexBuild(
+               Permutation::Enum::SPO, NumColumnsIndexBuilding)) {
+        for (const auto& triple : block) {
+          patternCreator.processTriple(
+              std::array{triple[0], triple[1], triple[2], triple[3]}, false);
+        }
+      }
+      patternCreator.finish();
+      markIndexBuildStageFinished(Patterns);
+      thirdSorter =
+          buildOspWithPatterns(std::move(patternCreator).getTripleSorter());
+      markIndexBuildStageFinished(SecondPermutationPair);
+    } else {
+      thirdSorter =
+          makeSorterPtr<ThirdPermutation, NumColumnsIndexBuilding + 2>("third");
+      for (const auto& block : scanPermutationOfInterruptedIndexBuild(
+               Permutation::Enum::OSP, NumColumnsIndexBuilding + 2)) {
+        thirdSorter->pushBlock(block);
+      }
+    }
+    if (buildThirdPair) {
+      createThirdPermutationPair(NumColumnsIndexBuilding + 2,
+                                 thirdSorter->template getSortedBlocks<0>());
+      markIndexBuildStageFinished(ThirdPermutationPair);
+    }
+  }
+  configurationJson_["has-all-permutations"] = loadAllPermutations_;
+
+  auto internalPermutations = checkpoint.getData(InternalPermutations);
+  addInternalStatisticsToConfiguration(
+      internalPermutations.at("num-triples-internal").get<size_t>(),
+      internalPermutations.at("num-predicates-internal").get<size_t>());
+}
+
+// _____________________________________________________________________________
+auto IndexImpl::scanPermutationOfInterruptedIndexBuild(
+    Permutation::Enum permutation, size_t numColumns) const
+    -> BlocksOfTriples {
+  // The permutation is not part of a complete index yet, so its blocks are
+  // read directly (without a `LocatedTriplesSnapshot`).
+  auto p = std::make_shared<Permutation>(permutation, allocator_);
+  p->loadFromDisk(onDiskBase_, [](Id) { return false; });
+  std::vector<ColumnIndex> columns(numColumns);
+  std::iota(columns.begin(), columns.end(), ColumnIndex{0});
+  const auto& keys = p->keyOrder().keys();
+  for (size_t i = 0; i < keys.size(); ++i) {
+    columns.at(keys.at(i)) = i;
+  }
+  auto get = [p = std::move(p), columns = std::move(columns),
+              blockIndex = size_t{0}]() mutable
+      -> std::optional<IdTableStatic<0>> {
+    const auto& blocks = p->metaData().blockData();
+    if (blockIndex == blocks.size()) {
+      return std::nullopt;
+    }
+    IdTable block = p->reader().readBlock(blocks.at(blockIndex++));
+    AD_CORRECTNESS_CHECK(block.numColumns() == columns.size());
+    block.setColumnSubset(columns);
+    return std::move(block).toStatic<0>();
+  };
+  return BlocksOfTriples{
+      ad_utility::InputRangeFromGetCallable{std::move(get)}};
+}
+
+// _____________________________________________________________________________
+void IndexImpl::loadExistingIndex() {
+  const std::string& baseName = existingIndexBaseName_.value();
+  AD_LOG_INFO << "Loading the existing index \"" << baseName
+              << "\", into which the input is merged ..." << std::endl;
+  using enum ad_utility::VocabularyType::Enum;
+  if (!loadAllPermutations_ ||
+      vocabularyTypeForIndexBuilding_.value() == OnDiskCompressedGeoSplit) {
+    throw std::runtime_error{
+        "An incremental index build requires all 6 permutations and a "
+        "vocabulary type without the split for geometries"};
+  }
+  if (std::filesystem::exists(baseName + ".update-triples") ||
+      std::filesystem::exists(baseName + ".update-triples.wal")) {
+    AD_LOG_WARN << "The updates of the existing index are not part of the "
+                   "incremental index build"
+                << std::endl;
+  }
+
+  // Loading another index changes the global index and comparator, which are
+  // restored afterwards.
+  auto globalIndex = globalSingletonIndex_;
+  auto globalComparator = globalSingletonComparator_;
+  auto index = std::make_unique<IndexImpl>(allocator_);
+  index->usePatterns_ = false;
+  index->createFromOnDiskIndex(baseName, false);
+  globalSingletonIndex_ = globalIndex;
+  globalSingletonComparator_ = globalComparator;
+  if (!index->hasAllPermutations() || index->vocab_.isGeoInfoAvailable()) {
+    throw std::runtime_error{absl::StrCat(
+        "The existing index \"", baseName,
+        "\" does not have all 6 permutations or has a vocabulary type with "
+        "the split for geometries, which is not supported for an incremental "
+        "index build")};
+  }
+
+  // The IDs of the encoded IRIs and the order of the vocabulary have to be
+  // the same as in the existing index.
+  encodedIriManager_ = index->encodedIriManager_;
+  configurationJson_["encoded-iri-prefixes"] = encodedIriManager_;
+  const auto& locale = index->configurationJson_.at("locale");
+  if (configurationJson_["locale"] != locale) {
+    AD_LOG_WARN << "The locale of the existing index is used instead of the "
+                   "one from the settings file"
+                << std::endl;
+  }
+  configurationJson_["locale"] = locale;
+  std::string lang{locale["language"]};
+  std::string country{locale["country"]};
+  bool ignorePunctuation{locale["ignore-punctuation"]};
+  vocab_.setLocale(lang, country, ignorePunctuation);
+  textVocab_.setLocale(lang, country, ignorePunctuation);
+
+  auto snapshot = index->deltaTriplesManager().getCurrentSnapshot();
+  AD_CORRECTNESS_CHECK(!snapshot->hasDeltaTriples());
+  existingIndex_ = ExistingIndexDuringIndexBuilding{
+      std::move(index), std::move(snapshot), {}};
+}
+
+// _____________________________________________________________________________
+void IndexImpl::writeVocabularyOfExistingIndex(
+    size_t partialVocabularyIndex) const {
+  const auto& vocab = existingIndex_.value().index_->vocab_;
+  ad_utility::serialization::FileWriteSerializer serializer{absl::StrCat(
+      onDiskBase_, PARTIAL_VOCAB_WORDS_INFIX, partialVocabularyIndex)};
+  uint64_t numWords = vocab.size();
+  serializer << numWords;
+  // The words are already sorted and unique, and their partial IDs are their
+  // indices in the existing vocabulary.
+  for (uint64_t i = 0; i < numWords; ++i) {
+    std::string word{vocab[VocabIndex::make(i)]};
+    bool isExternal = vocab.shouldBeExternalized(word);
+    serializer << TripleComponentWithIndex{std::move(word), isExternal, i};
+  }
+}
+
+// _____________________________________________________________________________
+void IndexImpl::readNewIdsOfExistingVocabulary(size_t partialVocabularyIndex) {
+  auto& existing = existingIndex_.value();
+  std::string filename = absl::StrCat(onDiskBase_, PARTIAL_VOCAB_IDMAP_INFIX,
+                                      partialVocabularyIndex);
+  // The ID map is read one pair at a time, as the existing vocabulary might
+  // be too large for it to fit into memory. The words of the existing
+  // vocabulary are merged in sorted order, so the pairs are sorted by the
+  // existing IDs.
+  {
+    ad_utility::serialization::FileReadSerializer serializer{filename};
+    uint64_t size;
+    serializer >> size;
+    AD_CORRECTNESS_CHECK(size == existing.index_->vocab_.size());
+    auto& newIds = existing.newIdsOfVocabulary_;
+    newIds.open(absl::StrCat(onDiskBase_, EXISTING_VOCAB_NEW_IDS_SUFFIX),
+                ad_utility::CreateTag{});
+    newIds.reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      std::pair<Id, Id> oldAndNewId;
+      serializer >> oldAndNewId;
+      AD_CORRECTNESS_CHECK(oldAndNewId.first.getVocabIndex().get() == i);
+      newIds.push_back(oldAndNewId.second);
+    }
+    // Close and reopen the vector to write its size to the file, s.t. it can
+    // also be reopened when an interrupted index build is resumed. The IDs
+    // are looked up in the order of the triples of the permutations, which is
+    // random for all but the first column.
+    std::string newIdsFilename = newIds.getFilename();
+    newIds.close();
+    newIds.open(std::move(newIdsFilename), ad_utility::ReuseTag{},
+                ad_utility::AccessPattern::Random);
+  }
+  // The ID map of the existing vocabulary is not read by
+  // `convertPartialToGlobalIds`.
+  deleteTemporaryFile(filename);
+}
+
+// _____________________________________________________________________________
+auto IndexImpl::scanExistingPermutation(const Permutation& permutation) const
+    -> BlocksOfTriples {
+  const auto& existing = existingIndex_.value();
+  const auto& snapshot = *existing.snapshot_;
+  auto scanSpecAndBlocks = permutation.getScanSpecAndBlocks(
+      ScanSpecification{std::nullopt, std::nullopt, std::nullopt}, snapshot);
+  std::array<ColumnIndex, 1> additionalColumns{ADDITIONAL_COLUMN_GRAPH_ID};
+  auto blocks = permutation.lazyScan(
+      scanSpecAndBlocks, std::nullopt, additionalColumns,
+      std::make_shared<ad_utility::CancellationHandle<>>(), snapshot);
+
+  // The scan yields the columns in the order of the permutation, followed by
+  // the graph column.
+  std::vector<ColumnIndex> columns(NumColumnsIndexBuilding);
+  const auto& keys = permutation.keyOrder().keys();
+  for (size_t i = 0; i < columns.size(); ++i) {
+    columns.at(keys.at(i)) = i;
+  }
+  auto toNewIds = [columns = std::move(columns),
+                   &newIds = existing.newIdsOfVocabulary_](IdTable& block) {
+    block.setColumnSubset(columns);
+    for (auto column : block.getColumns()) {
+      for (Id& id : column) {
+        if (id.getDatatype() == Datatype::VocabIndex) {
+          id = newIds[id.getVocabIndex().get()];
+        }
+      }
+    }
+    return std::move(block).toStatic<0>();
+  };
+  return BlocksOfTriples{ad_utility::CachingTransformInputRange{
+      ad_utility::OwningView{std::move(blocks)}, std::move(toNewIds)}};
+}
+
+// _____________________________________________________________________________
+void IndexImpl::addInternalTriplesOfExistingIndex(
+    ExternalSorter<SortByPSO>& internalTriplesPsoSorter) const {
+  const auto& existing = existingIndex_.value();
+  Id hasPattern = idOfHasPatternDuringIndexBuilding_.value();
+  for (auto& block : scanExistingPermutation(
+           existing.index_->PSO().internalPermutation())) {
+    block.erase(std::remove_if(block.begin(), block.end(),
+                               [hasPattern](const auto& row) {
+                                 return row[1] == hasPattern;
+                               }),
+                block.end());
+    internalTriplesPsoSorter.pushBlock(block);
+  }
+}
+
+// _____________________________________________________________________________
+template <typename Comparator>
+auto IndexImpl::mergeWithExistingPermutation(BlocksOfTriples newTriples,
+                                             Permutation::Enum permutation,
+                                             Comparator comparator) const
+    -> BlocksOfTriples {
+  const auto& existing = existingIndex_.value();
+  AD_LOG_INFO << "Merging the new triples with the "
+              << Permutation::toString(permutation)
+              << " permutation of the existing index ..." << std::endl;
+  return ad_utility::uniqueBlockView(mergeSortedBlocks(
+      scanExistingPermutation(existing.index_->getPermutation(permutation)),
+      std::move(newTriples), std::move(comparator)));
+}
+
 // _____________________________________________________________________________
 void IndexImpl::addInternalStatisticsToConfiguration(
     size_t numTriplesInternal, size_t numPredicatesInternal) {
@@ -455,13 +1344,35 @@ void IndexImpl::addInternalStatisticsToConfiguration(
   writeConfiguration();
 }
 
+// _____________________________________________________________________________
+void IndexImpl::buildSpatialIndex(uint64_t firstGeometryIndex,
+                                  uint64_t numGeometries) {
+  // The bounding boxes were already computed when writing the
+  // `GeoVocabulary`, so we only have to read them from the vocabulary.
+  PolymorphicVocabulary vocabulary;
+  vocabulary.open(onDiskBase_ + VOCAB_SUFFIX, vocabularyTypeForIndexBuilding_);
+  SpatialIndex::Builder builder{
+      absl::StrCat(onDiskBase_, SPATIAL_INDEX_SUFFIX),
+      memoryLimitIndexBuilding(), allocator_};
+  for (uint64_t i = 0; i < numGeometries; ++i) {
+    uint64_t index = firstGeometryIndex + i;
+    auto geometryInfo = vocabulary.getGeoInfo(index);
+    if (geometryInfo.has_value()) {
+      builder.addGeometry(VocabIndex::make(index),
+                          geometryInfo.value().getBoundingBox());
+    }
+  }
+  vocabulary.close();
+  builder.finish();
+}
+
 // _____________________________________________________________________________
 IndexBuilderDataAsExternalVector IndexImpl::passFileForVocabulary(
     std::shared_ptr<RdfParserBase> parser, size_t linesPerPartial) {
   parser->integerOverflowBehavior() = turtleParserIntegerOverflowBehavior_;
   parser->invalidLiteralsAreSkipped() = turtleParserSkipIllegalLiterals_;
   ad_utility::Synchronized<std::unique_ptr<TripleVec>> idTriples(
-      std::make_unique<TripleVec>(onDiskBase_ + ".unsorted-triples.dat", 1_GB,
+      std::make_unique<TripleVec>(filenameOfPartialIdTriples(), 1_GB,
                                   allocator_));
   AD_LOG_INFO << "Parsing input triples and creating partial vocabularies, one "
                  "per batch ..."
@@ -587,8 +1498,35 @@ IndexBuilderDataAsExternalVector IndexImpl::passFileForVocabulary(
   AD_LOG_INFO << "Number of partial vocabularies created: " << numFiles
               << std::endl;
 
+  IndexBuilderDataAsExternalVector res;
+  res.idTriples = std::move(*idTriples.wlock());
+  res.actualPartialSizes = std::move(actualPartialSizes);
+  res.idTriples->persist();
+  markIndexBuildStageFinished(
+      IndexBuildStage::ParsingAndPartialVocabularies,
+      {{"actual-partial-sizes", res.actualPartialSizes}});
+  return res;
+}
+
+// _____________________________________________________________________________
+void IndexImpl::mergeVocabularyAndIdMaps(
+    IndexBuilderDataAsExternalVector& indexBuilderData) {
+  size_t numFiles = indexBuilderData.actualPartialSizes.size();
   size_t sizeInternalVocabulary = 0;
-  std::vector<std::string> prefixes;
+
+  // For an incremental index build, the vocabulary of the existing index is
+  // merged as an additional partial vocabulary, and the new blank nodes are
+  // numbered after the blank nodes of the existing index.
+  size_t numFilesToMerge = numFiles;
+  size_t firstBlankNodeIndex = 0;
+  if (existingIndex_.has_value()) {
+    writeVocabularyOfExistingIndex(numFiles);
+    ++numFilesToMerge;
+    firstBlankNodeIndex = existingIndex_.value()
+                              .index_->configurationJson_.at(
+                                  "num-blank-nodes-total")
+                              .get<size_t>();
+  }
 
   AD_LOG_INFO << "Merging partial vocabularies ..." << std::endl;
   const ad_utility::vocabulary_merger::VocabularyMetaData mergeRes = [&]() {
@@ -599,34 +1537,87 @@ IndexBuilderDataAsExternalVector IndexImpl::passFileForVocabulary(
     auto wordCallbackPtr = vocab_.makeWordWriterPtr(onDiskBase_ + VOCAB_SUFFIX);
     auto& wordCallback = *wordCallbackPtr;
     wordCallback.readableName() = "internal vocabulary";
+    // If requested, also collect the trigrams of all the words for the
+    // `VocabularyNgramIndex`.
+    std::optional<VocabularyNgramIndex::Builder> ngramIndexBuilder;
+    if (hasVocabularyNgramIndex_) {
+      ngramIndexBuilder.emplace(
+          absl::StrCat(onDiskBase_, VOCABULARY_NGRAM_INDEX_SUFFIX),
+          memoryLimitIndexBuilding() / 2, allocator_);
+    }
+    // If requested, also remember the range of the indices of the WKT
+    // literals, for which the `SpatialIndex` is built after the merge. The
+    // `GeoVocabulary` assigns consecutive indices to them (the spatial index
+    // was already disabled by `createIdTriplesAndVocab` if it can't be
+    // built).
+    std::optional<uint64_t> firstGeometryIndex;
+    uint64_t numGeometries = 0;
+    // Find the IDs of the predicates for the `ReachabilityIndex`, which are
+    // either encoded directly or part of the vocabulary.
+    ad_utility::HashSet<std::string> reachabilityIndexPredicates;
+    reachabilityIndexPredicateIdsDuringIndexBuilding_.clear();
+    for (const auto& predicate : reachabilityIndexPredicates_) {
+      if (auto id = encodedIriManager_.encode(predicate); id.has_value()) {
+        reachabilityIndexPredicateIdsDuringIndexBuilding_.push_back(id.value());
+      } else {
+        reachabilityIndexPredicates.insert(predicate);
+      }
+    }
+    auto callback = [this, &wordCallback, &ngramIndexBuilder,
+                     &firstGeometryIndex, &numGeometries,
+                     &reachabilityIndexPredicates](
+                        std::string_view word, bool isExternal) -> uint64_t {
+      uint64_t index = wordCallback(word, isExternal);
+      if (ngramIndexBuilder.has_value()) {
+        ngramIndexBuilder->addWord(word, index);
+      }
+      if (!reachabilityIndexPredicates.empty() &&
+          reachabilityIndexPredicates.contains(word)) {
+        reachabilityIndexPredicateIdsDuringIndexBuilding_.push_back(
+            Id::makeFromVocabIndex(VocabIndex::make(index)));
+      }
+      if (hasSpatialIndex_ && detail::splitVocabulary::geoSplitFunc(word)) {
+        if (!firstGeometryIndex.has_value()) {
+          firstGeometryIndex = index;
+        }
+        AD_CORRECTNESS_CHECK(index ==
+                             firstGeometryIndex.value() + numGeometries);
+        ++numGeometries;
+      }
+      return index;
+    };
     auto mergedVocabMeta = ad_utility::vocabulary_merger::mergeVocabulary(
-        onDiskBase_, numFiles, sortPred, wordCallback,
-        memoryLimitIndexBuilding());
+        onDiskBase_, numFilesToMerge, sortPred, callback,
+        memoryLimitIndexBuilding(), firstBlankNodeIndex);
     wordCallback.finish();
+    if (ngramIndexBuilder.has_value()) {
+      ngramIndexBuilder->finish();
+    }
+    if (hasSpatialIndex_) {
+      buildSpatialIndex(firstGeometryIndex.value_or(0), numGeometries);
+    }
     return mergedVocabMeta;
   }();
   AD_LOG_DEBUG << "Finished merging partial vocabularies" << std::endl;
-  IndexBuilderDataAsExternalVector res;
-  res.vocabularyMetaData_ = mergeRes;
+  indexBuilderData.vocabularyMetaData_ = mergeRes;
   idOfHasPatternDuringIndexBuilding_ =
       mergeRes.specialIdMapping().at(HAS_PATTERN_PREDICATE);
   idOfInternalGraphDuringIndexBuilding_ =
       mergeRes.specialIdMapping().at(QLEVER_INTERNAL_GRAPH_IRI);
   AD_LOG_INFO << "Number of words in external vocabulary: "
-              << res.vocabularyMetaData_.numWordsTotal() -
-                     sizeInternalVocabulary
+              << mergeRes.numWordsTotal() - sizeInternalVocabulary
               << std::endl;
 
-  res.idTriples = std::move(*idTriples.wlock());
-  res.actualPartialSizes = std::move(actualPartialSizes);
-
-  AD_LOG_DEBUG << "Removing temporary files ..." << std::endl;
-  for (size_t n = 0; n < numFiles; ++n) {
-    deleteTemporaryFile(
-        absl::StrCat(onDiskBase_, PARTIAL_VOCAB_WORDS_INFIX, n));
+  if (existingIndex_.has_value()) {
+    readNewIdsOfExistingVocabulary(numFiles);
   }
 
-  return res;
+  // After the merge, the partial vocabularies are no longer needed.
+  markIndexBuildStageFinished(
+      IndexBuildStage::VocabularyMerge,
+      {{"actual-partial-sizes", indexBuilderData.actualPartialSizes},
+       {"vocabulary-metadata", mergeRes}});
+  removeOutputOfIndexBuildStage(IndexBuildStage::ParsingAndPartialVocabularies);
 }
 
 // _____________________________________________________________________________
@@ -759,10 +1750,10 @@ auto IndexImpl::convertPartialToGlobalIds(
     }
     std::string filename =
         absl::StrCat(onDiskBase_, PARTIAL_VOCAB_IDMAP_INFIX, idx);
+    // The file is only deleted when the converted triples are persisted, see
+    // `createIdTriplesAndVocab`.
     auto map =
         ad_utility::vocabulary_merger::IdMapFromPartialIdMapFile(filename);
-    // Delete the temporary file in which we stored this map
-    deleteTemporaryFile(filename);
     return std::pair{idx, std::move(map)};
   };
 
@@ -823,9 +1814,11 @@ IndexImpl::createPermutationPairImpl(size_t numColumns,
   metaData2.setup(fileName2 + MMAP_FILE_SUFFIX, ad_utility::CreateTag{});
 
   CompressedRelationWriter writer1{numColumns, ad_utility::File(fileName1, "w"),
-                                   blocksizePermutationPerColumn_};
+                                   blocksizePermutationPerColumn_,
+                                   numThreadsIndexBuilding_};
   CompressedRelationWriter writer2{numColumns, ad_utility::File(fileName2, "w"),
-                                   blocksizePermutationPerColumn_};
+                                   blocksizePermutationPerColumn_,
+                                   numThreadsIndexBuilding_};
 
   // Lift a callback that works on single elements to a callback that works on
   // blocks.
@@ -856,14 +1849,16 @@ IndexImpl::createPermutationPairImpl(size_t numColumns,
 template <typename T, typename... Callbacks>
 std::tuple<size_t, IndexImpl::IndexMetaDataMmapDispatcher::WriteType,
            IndexImpl::IndexMetaDataMmapDispatcher::WriteType>
-IndexImpl::createPermutations(size_t numColumns, T&& sortedTriples,
+IndexImpl::createPermutations(size_t numColumns,
+                              const std::string& onDiskBase, T&& sortedTriples,
                               const Permutation& p1, const Permutation& p2,
                               Callbacks&&... perTripleCallbacks) {
   AD_LOG_INFO << "Creating permutations " << p1.readableName() << " and "
               << p2.readableName() << " ..." << std::endl;
+  ad_utility::Timer timer{ad_utility::Timer::Started};
   auto metaData = createPermutationPairImpl(
-      numColumns, onDiskBase_ + ".index" + p1.fileSuffix(),
-      onDiskBase_ + ".index" + p2.fileSuffix(), AD_FWD(sortedTriples),
+      numColumns, onDiskBase + ".index" + p1.fileSuffix(),
+      onDiskBase + ".index" + p2.fileSuffix(), AD_FWD(sortedTriples),
       p1.keyOrder(), AD_FWD(perTripleCallbacks)...);
 
   auto& [numDistinctCol0, meta1, meta2] = metaData;
@@ -873,6 +1868,14 @@ IndexImpl::createPermutations(size_t numColumns, T&& sortedTriples,
               << meta1.statistics() << std::endl;
   AD_LOG_INFO << "Statistics for " << p2.readableName() << ": "
               << meta2.statistics() << std::endl;
+  // Report the throughput, which is also relevant when several pairs of
+  // permutations are built at the same time.
+  double seconds = ad_utility::Timer::toSeconds(timer.msecs());
+  auto triplesPerSecond = static_cast<size_t>(
+      static_cast<double>(meta1.getNumTriples()) / std::max(seconds, 0.001));
+  AD_LOG_INFO << "Permutations " << p1.readableName() << " and "
+              << p2.readableName() << " created in " << seconds << "s ("
+              << triplesPerSecond << " triples/s)" << std::endl;
 
   return metaData;
 }
@@ -880,20 +1883,23 @@ IndexImpl::createPermutations(size_t numColumns, T&& sortedTriples,
 // ________________________________________________________________________
 template <typename SortedTriplesType, typename... CallbackTypes>
 size_t IndexImpl::createPermutationPair(size_t numColumns,
+                                        const std::string& onDiskBase,
                                         SortedTriplesType&& sortedTriples,
                                         const Permutation& p1,
                                         const Permutation& p2,
                                         CallbackTypes&&... perTripleCallbacks) {
-  auto [numDistinctC0, metaData1, metaData2] = createPermutations(
-      numColumns, AD_FWD(sortedTriples), p1, p2, AD_FWD(perTripleCallbacks)...);
+  auto [numDistinctC0, metaData1, metaData2] =
+      createPermutations(numColumns, onDiskBase, AD_FWD(sortedTriples), p1, p2,
+                         AD_FWD(perTripleCallbacks)...);
   // Set the name of this newly created pair of `IndexMetaData` objects.
   // NOTE: When `setKbName` was called, it set the name of pso_.meta_,
   // pso_.meta_, ... which however are not used during index building.
   // `getKbName` simple reads one of these names.
-  auto writeMetadata = [this](auto& metaData, const auto& permutation) {
+  auto writeMetadata = [this, &onDiskBase](auto& metaData,
+                                           const auto& permutation) {
     metaData.setName(getKbName());
     ad_utility::File f(
-        absl::StrCat(onDiskBase_, ".index", permutation.fileSuffix()), "r+");
+        absl::StrCat(onDiskBase, ".index", permutation.fileSuffix()), "r+");
     metaData.appendToFile(&f);
   };
   AD_LOG_DEBUG << "Writing meta data for " << p1.readableName() << " and "
@@ -909,6 +1915,17 @@ void IndexImpl::createFromOnDiskIndex(const std::string& onDiskBase,
   setOnDiskBase(onDiskBase);
   readConfiguration();
   vocab_.readFromFile(onDiskBase_ + VOCAB_SUFFIX);
+  if (hasVocabularyNgramIndex_) {
+    vocabularyNgramIndex_.readFromFile(
+        absl::StrCat(onDiskBase_, VOCABULARY_NGRAM_INDEX_SUFFIX));
+  }
+  if (hasSpatialIndex_) {
+    spatialIndex_.readFromFile(absl::StrCat(onDiskBase_, SPATIAL_INDEX_SUFFIX));
+  }
+  if (!reachabilityIndexPredicates_.empty()) {
+    reachabilityIndex_.readFromFile(
+        absl::StrCat(onDiskBase_, REACHABILITY_INDEX_SUFFIX));
+  }
   globalSingletonComparator_ = &vocab_.getCaseComparator();
 
   AD_LOG_DEBUG << "Number of words in internal and external vocabulary: "
@@ -1192,6 +2209,11 @@ void IndexImpl::readConfiguration() {
       ad_utility::VocabularyType::Enum::OnDiskCompressed);
   loadDataMember("vocabulary-type", vocabType, vocabType);
   vocab_.resetToType(vocabType);
+  loadDataMember("has-vocabulary-ngram-index", hasVocabularyNgramIndex_,
+                 false);
+  loadDataMember("has-spatial-index", hasSpatialIndex_, false);
+  loadDataMember("reachability-index-predicates",
+                 reachabilityIndexPredicates_, std::vector<std::string>{});
 
   // Initialize BlankNodeManager
   uint64_t numBlankNodesTotal;
@@ -1700,12 +2722,11 @@ constexpr auto makeNumDistinctIdsCounter = [](size_t& numDistinctIds) {
 // _____________________________________________________________________________
 CPP_template_def(typename... NextSorter)(requires(
     sizeof...(NextSorter) <=
-    1)) void IndexImpl::createPSOAndPOSImpl(size_t numColumns,
-                                            BlocksOfTriples sortedTriples,
-                                            bool doWriteConfiguration,
-                                            NextSorter&&... nextSorter)
-
-{
+    1)) std::pair<size_t, size_t> IndexImpl::
+    createPSOAndPOSImpl(size_t numColumns, const std::string& onDiskBase,
+                        BlocksOfTriples sortedTriples,
+                        bool doWriteConfiguration,
+                        NextSorter&&... nextSorter) {
   size_t numTriplesNormal = 0;
   size_t numTriplesTotal = 0;
   auto countTriplesNormal = [&numTriplesNormal, &numTriplesTotal](
@@ -1715,19 +2736,39 @@ CPP_template_def(typename... NextSorter)(requires(
   };
   size_t numPredicatesNormal = 0;
   auto predicateCounter = makeNumDistinctIdsCounter<1>(numPredicatesNormal);
-  size_t numPredicatesTotal =
-      createPermutationPair(numColumns, AD_FWD(sortedTriples), pso_, pos_,
-                            nextSorter.makePushCallback()...,
-                            std::ref(predicateCounter), countTriplesNormal);
-  configurationJson_["num-predicates"] =
-      NumNormalAndInternal::fromNormalAndTotal(numPredicatesNormal,
-                                               numPredicatesTotal);
-  configurationJson_["num-triples"] = NumNormalAndInternal::fromNormalAndTotal(
-      numTriplesNormal, numTriplesTotal);
+  // Collect the edges for the `ReachabilityIndex` (only for the normal
+  // triples, not for the internal ones).
+  std::optional<ReachabilityIndex::Builder> reachabilityIndexBuilder;
+  if (doWriteConfiguration && !reachabilityIndexPredicates_.empty()) {
+    reachabilityIndexBuilder.emplace(
+        absl::StrCat(onDiskBase_, REACHABILITY_INDEX_SUFFIX),
+        reachabilityIndexPredicateIdsDuringIndexBuilding_);
+  }
+  auto addToReachabilityIndex = [&reachabilityIndexBuilder](
+                                    const auto& triple) {
+    if (reachabilityIndexBuilder.has_value()) {
+      reachabilityIndexBuilder->addTriple(triple[0], triple[1], triple[2]);
+    }
+  };
+  size_t numPredicatesTotal = createPermutationPair(
+      numColumns, onDiskBase, AD_FWD(sortedTriples), pso_, pos_,
+      nextSorter.makePushCallback()..., std::ref(predicateCounter),
+      countTriplesNormal, addToReachabilityIndex);
+  if (reachabilityIndexBuilder.has_value()) {
+    reachabilityIndexBuilder->finish();
+  }
   if (doWriteConfiguration) {
+    std::lock_guard lock{configurationJsonMutex_};
+    configurationJson_["num-predicates"] =
+        NumNormalAndInternal::fromNormalAndTotal(numPredicatesNormal,
+                                                 numPredicatesTotal);
+    configurationJson_["num-triples"] =
+        NumNormalAndInternal::fromNormalAndTotal(numTriplesNormal,
+                                                 numTriplesTotal);
     writeConfiguration();
   }
-};
+  return {numTriplesNormal, numPredicatesNormal};
+}
 
 // _____________________________________________________________________________
 CPP_template_def(typename... NextSorter)(
@@ -1735,12 +2776,12 @@ CPP_template_def(typename... NextSorter)(
              1)) void IndexImpl::createPSOAndPOS(size_t numColumns,
                                                  BlocksOfTriples sortedTriples,
                                                  NextSorter&&... nextSorter) {
-  createPSOAndPOSImpl(numColumns, std::move(sortedTriples), true,
+  createPSOAndPOSImpl(numColumns, onDiskBase_, std::move(sortedTriples), true,
                       AD_FWD(nextSorter)...);
 }
 
 // _____________________________________________________________________________
-CPP_template_def(typename... NextSorter)(requires(sizeof...(NextSorter) <= 1))
+CPP_template_def(typename... NextSorter)(requires(sizeof...(NextSorter) <= 2))
     std::optional<PatternCreator::TripleSorter> IndexImpl::createSPOAndSOP(
         size_t numColumns, BlocksOfTriples sortedTriples,
         NextSorter&&... nextSorter) {
@@ -1766,7 +2807,7 @@ CPP_template_def(typename... NextSorter)(requires(sizeof...(NextSorter) <= 1))
       patternCreator.processTriple(tripleArr, ignoreForPatterns);
     };
     numSubjectsTotal = createPermutationPair(
-        numColumns, AD_FWD(sortedTriples), spo_, sop_,
+        numColumns, onDiskBase_, AD_FWD(sortedTriples), spo_, sop_,
         nextSorter.makePushCallback()..., pushTripleToPatterns,
         std::ref(numSubjectCounter));
     patternCreator.finish();
@@ -1776,9 +2817,8 @@ CPP_template_def(typename... NextSorter)(requires(sizeof...(NextSorter) <= 1))
     writeConfiguration();
     result = std::move(patternCreator).getTripleSorter();
   } else {
-    AD_CORRECTNESS_CHECK(sizeof...(nextSorter) == 1);
     numSubjectsTotal = createPermutationPair(
-        numColumns, AD_FWD(sortedTriples), spo_, sop_,
+        numColumns, onDiskBase_, AD_FWD(sortedTriples), spo_, sop_,
         nextSorter.makePushCallback()..., std::ref(numSubjectCounter));
     configurationJson_["num-subjects"] =
         NumNormalAndInternal::fromNormalAndTotal(numSubjectsNormal,
@@ -1801,8 +2841,9 @@ CPP_template_def(typename... NextSorter)(
   size_t numObjectsNormal = 0;
   auto objectCounter = makeNumDistinctIdsCounter<2>(numObjectsNormal);
   size_t numObjectsTotal = createPermutationPair(
-      numColumns, AD_FWD(sortedTriples), osp_, ops_,
+      numColumns, onDiskBase_, AD_FWD(sortedTriples), osp_, ops_,
       nextSorter.makePushCallback()..., std::ref(objectCounter));
+  std::lock_guard lock{configurationJsonMutex_};
   configurationJson_["num-objects"] = NumNormalAndInternal::fromNormalAndTotal(
       numObjectsNormal, numObjectsTotal);
   configurationJson_["has-all-permutations"] = true;
@@ -1811,7 +2852,8 @@ CPP_template_def(typename... NextSorter)(
 
 // _____________________________________________________________________________
 template <typename Comparator, size_t I, bool returnPtr>
-auto IndexImpl::makeSorterImpl(std::string_view permutationName) const {
+auto IndexImpl::makeSorterImpl(std::string_view permutationName,
+                               size_t numSortersAtSameTime) const {
   using Sorter = ExternalSorter<Comparator, I>;
   auto apply = [](auto&&... args) {
     if constexpr (returnPtr) {
@@ -1820,22 +2862,43 @@ auto IndexImpl::makeSorterImpl(std::string_view permutationName) const {
       return Sorter{AD_FWD(args)...};
     }
   };
-  return apply(absl::StrCat(onDiskBase_, ".", permutationName, "-sorter.dat"),
-               memoryLimitIndexBuilding() / NUM_EXTERNAL_SORTERS_AT_SAME_TIME,
-               allocator_);
+  return apply(filenameOfSorter(permutationName),
+               memoryLimitIndexBuilding() / numSortersAtSameTime, allocator_);
 }
 
 // _____________________________________________________________________________
 template <typename Comparator, size_t I>
-ExternalSorter<Comparator, I> IndexImpl::makeSorter(
+std::unique_ptr<ExternalSorter<Comparator, I>> IndexImpl::reopenSorterPtr(
+    std::string_view permutationName, size_t numSortersAtSameTime) const {
+  return std::make_unique<ExternalSorter<Comparator, I>>(
+      ad_utility::ReopenPersistedTag{}, filenameOfSorter(permutationName),
+      memoryLimitIndexBuilding() / numSortersAtSameTime, allocator_);
+}
+
+// _____________________________________________________________________________
+std::string IndexImpl::filenameOfSorter(
     std::string_view permutationName) const {
-  return makeSorterImpl<Comparator, I, false>(permutationName);
+  return absl::StrCat(onDiskBase_, ".", permutationName, "-sorter.dat");
+}
+
+// _____________________________________________________________________________
+std::string IndexImpl::filenameOfPartialIdTriples() const {
+  return absl::StrCat(onDiskBase_, ".unsorted-triples.dat");
+}
+
+// _____________________________________________________________________________
+template <typename Comparator, size_t I>
+ExternalSorter<Comparator, I> IndexImpl::makeSorter(
+    std::string_view permutationName, size_t numSortersAtSameTime) const {
+  return makeSorterImpl<Comparator, I, false>(permutationName,
+                                              numSortersAtSameTime);
 }
 // _____________________________________________________________________________
 template <typename Comparator, size_t I>
 std::unique_ptr<ExternalSorter<Comparator, I>> IndexImpl::makeSorterPtr(
-    std::string_view permutationName) const {
-  return makeSorterImpl<Comparator, I, true>(permutationName);
+    std::string_view permutationName, size_t numSortersAtSameTime) const {
+  return makeSorterImpl<Comparator, I, true>(permutationName,
+                                             numSortersAtSameTime);
 }
 
 // _____________________________________________________________________________
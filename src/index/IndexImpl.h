@@ -8,6 +8,7 @@
 #define QLEVER_SRC_INDEX_INDEXIMPL_H
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <vector>
@@ -24,14 +25,19 @@
 #include "index/EncodedIriManager.h"
 #include "index/ExternalSortFunctors.h"
 #include "index/Index.h"
+#include "index/IndexBuildCheckpoint.h"
 #include "index/IndexBuilderTypes.h"
 #include "index/IndexMetaData.h"
 #include "index/PatternCreator.h"
 #include "index/Permutation.h"
+#include "index/ReachabilityIndex.h"
+#include "index/SpatialIndex.h"
 #include "index/TextMetaData.h"
 #include "index/TextScoring.h"
 #include "index/Vocabulary.h"
 #include "index/VocabularyMerger.h"
+#include "index/VocabularyNgramIndex.h"
+#include "index/VocabularyStringCache.h"
 #include "parser/RdfParser.h"
 #include "parser/TripleComponent.h"
 #include "util/BufferedVector.h"
@@ -119,8 +125,35 @@ class IndexImpl {
   ad_utility::MemorySize parserBufferSize_ = DEFAULT_PARSER_BUFFER_SIZE;
   ad_utility::MemorySize blocksizePermutationPerColumn_ =
       UNCOMPRESSED_BLOCKSIZE_COMPRESSED_METADATA_PER_COLUMN;
+  // The number of threads that compress and write the blocks of each
+  // permutation during the index build.
+  size_t numThreadsIndexBuilding_ =
+      CompressedRelationWriter::DEFAULT_NUM_THREADS;
+  // If set, the OSP/OPS and the PSO/POS permutations are built at the same
+  // time if possible (see `createFromFiles`).
+  bool buildPermutationPairsInParallel_ = false;
   nlohmann::json configurationJson_;
+  // Protects the `configurationJson_` while several pairs of permutations are
+  // built at the same time.
+  std::mutex configurationJsonMutex_;
   Index::Vocab vocab_;
+  // The words of `vocab_` that were recently needed for exporting results.
+  // Its size is set by each export (see `ExportQueryExecutionTrees`).
+  mutable VocabularyStringCache vocabularyStringCache_{
+      ad_utility::MemorySize::bytes(0)};
+  // The trigram index of `vocab_` for the evaluation of string filters. It is
+  // only built and loaded if `hasVocabularyNgramIndex_` is set.
+  bool hasVocabularyNgramIndex_ = false;
+  VocabularyNgramIndex vocabularyNgramIndex_;
+  // The R-tree of the bounding boxes of all geometries in `vocab_`. It is
+  // only built and loaded if `hasSpatialIndex_` is set.
+  bool hasSpatialIndex_ = false;
+  SpatialIndex spatialIndex_;
+  // The reachability index of the graphs of the configured predicates (IRIs
+  // in angle brackets). It is only built and loaded if there are such
+  // predicates, but graphs can always be added on demand at query time.
+  std::vector<std::string> reachabilityIndexPredicates_;
+  ReachabilityIndex reachabilityIndex_;
   Index::TextVocab textVocab_;
   EncodedIriManager encodedIriManager_;
   ScoreData scoreData_;
@@ -180,11 +213,19 @@ class IndexImpl {
   Permutation ops_{Permutation::Enum::OPS, allocator_};
   Permutation osp_{Permutation::Enum::OSP, allocator_};
 
+  // During the index building we typically have two permutations present at
+  // the same time, as we directly push the triples from the first sorting to
+  // the second sorting. We therefore have to adjust the amount of memory per
+  // external sorter.
+  static constexpr size_t NUM_EXTERNAL_SORTERS_AT_SAME_TIME = 2u;
+
   // During the index building, store the IDs of the `ql:has-pattern` predicate
   // and of `ql:default-graph` as they are required to add additional triples
   // after the creation of the vocabulary is finished.
   std::optional<Id> idOfHasPatternDuringIndexBuilding_;
   std::optional<Id> idOfInternalGraphDuringIndexBuilding_;
+  // The IDs of the `reachabilityIndexPredicates_` that occur in the input.
+  std::vector<Id> reachabilityIndexPredicateIdsDuringIndexBuilding_;
 
   // The vocabulary type that is used (only relevant during index building).
   ad_utility::VocabularyType vocabularyTypeForIndexBuilding_{
@@ -195,6 +236,36 @@ class IndexImpl {
 
   std::optional<DeltaTriplesManager> deltaTriples_;
 
+  // The basename of the existing index for an incremental index build, see
+  // `setExistingIndexForIncrementalBuild`.
+  std::optional<std::string> existingIndexBaseName_;
+
+  // The existing index while it is merged with the input during an
+  // incremental index build.
+  struct ExistingIndexDuringIndexBuilding {
+    std::unique_ptr<IndexImpl> index_;
+    SharedLocatedTriplesSnapshot snapshot_;
+    // The ID in the new vocabulary for each `VocabIndex` of the existing
+    // vocabulary. The mapping is monotonic, so the permutations of the
+    // existing index are still sorted after the mapping. The vocabulary of
+    // the existing index might be very large, so the mapping is stored in a
+    // temporary file, which is memory-mapped.
+    ad_utility::MmapVector<Id> newIdsOfVocabulary_;
+  };
+  std::optional<ExistingIndexDuringIndexBuilding> existingIndex_;
+
+  // If true, `createFromFiles` resumes an interrupted index build, see
+  // `setResumeIndexBuild`.
+  bool resumeIndexBuild_ = false;
+  // The finished stages of the current index build, set by `createFromFiles`.
+  // The checkpoint file is removed as soon as all permutations are complete,
+  // unless `keepIndexBuildCheckpoint_` is set.
+  std::optional<IndexBuildCheckpoint> indexBuildCheckpoint_;
+  bool keepIndexBuildCheckpoint_ = false;
+  // If set, the index build throws right after this stage was finished. This
+  // simulates an interrupted index build in the tests.
+  std::optional<IndexBuildStage> interruptIndexBuildAfterStage_;
+
  public:
   explicit IndexImpl(ad_utility::AllocatorWithLimit<Id> allocator);
 
@@ -256,6 +327,16 @@ class IndexImpl {
 
   const auto& getVocab() const { return vocab_; };
   auto& getNonConstVocabForTesting() { return vocab_; }
+  auto& getVocabularyStringCache() const { return vocabularyStringCache_; }
+  const VocabularyNgramIndex* getVocabularyNgramIndex() const {
+    return vocabularyNgramIndex_.isLoaded() ? &vocabularyNgramIndex_ : nullptr;
+  }
+  const SpatialIndex* getSpatialIndex() const {
+    return spatialIndex_.isLoaded() ? &spatialIndex_ : nullptr;
+  }
+  const ReachabilityIndex& getReachabilityIndex() const {
+    return reachabilityIndex_;
+  }
 
   const auto& getTextVocab() const { return textVocab_; };
 
@@ -281,6 +362,80 @@ class IndexImpl {
     configurationJson_["vocabulary-type"] = type;
   }
 
+  // Build a trigram index of the vocabulary; see `VocabularyNgramIndex` for
+  // details.
+  void setBuildVocabularyNgramIndex(bool buildNgramIndex) {
+    hasVocabularyNgramIndex_ = buildNgramIndex;
+    configurationJson_["has-vocabulary-ngram-index"] = buildNgramIndex;
+  }
+
+  // Build a persistent R-tree of the bounding boxes of all geometries; see
+  // `SpatialIndex` for details. This requires a vocabulary type with an
+  // underlying `GeoVocabulary`.
+  void setBuildSpatialIndex(bool buildSpatialIndex) {
+    hasSpatialIndex_ = buildSpatialIndex;
+    configurationJson_["has-spatial-index"] = buildSpatialIndex;
+  }
+
+  // Build a reachability index for the graphs of the given predicates (IRIs
+  // in angle brackets); see `ReachabilityIndex` for details.
+  void setReachabilityIndexPredicates(std::vector<std::string> predicates) {
+    reachabilityIndexPredicates_ = std::move(predicates);
+    configurationJson_["reachability-index-predicates"] =
+        reachabilityIndexPredicates_;
+  }
+
+  // Set the number of threads that compress and write the blocks of each
+  // permutation during the index build.
+  void setNumThreadsIndexBuilding(size_t numThreads) {
+    numThreadsIndexBuilding_ = numThreads;
+  }
+
+  // Build the OSP/OPS and the PSO/POS permutations at the same time, the
+  // memory for the sorting is then split between the two pairs. With patterns,
+  // the PSO/POS permutations need the pattern columns from the OSP/OPS pass,
+  // so `createFromFiles` throws if this is combined with patterns.
+  void setBuildPermutationPairsInParallel(bool buildInParallel) {
+    buildPermutationPairsInParallel_ = buildInParallel;
+  }
+
+  // Merge the input of `createFromFiles` into the existing index with the
+  // given basename (if set). Only the input is parsed and sorted, the
+  // vocabulary of the existing index is merged like an additional partial
+  // vocabulary, and its permutations are merged with the sorted input. The
+  // result is a complete new index at `onDiskBase_`. This is only possible
+  // without patterns, otherwise `createFromFiles` throws.
+  void setExistingIndexForIncrementalBuild(
+      std::optional<std::string> existingIndexBaseName) {
+    existingIndexBaseName_ = std::move(existingIndexBaseName);
+  }
+
+  // If set to true, `createFromFiles` resumes a previous index build with the
+  // same basename, input files, and settings that was interrupted. The stages
+  // of that build whose output is complete are not repeated, see
+  // `IndexBuildCheckpoint`.
+  void setResumeIndexBuild(bool resume) { resumeIndexBuild_ = resume; }
+
+  // If set to true, `createFromFiles` doesn't remove the checkpoint file when
+  // all the permutations are complete, s.t. the text index, which is built
+  // afterwards, can be recorded in the same checkpoint. The caller then has to
+  // remove the checkpoint.
+  void setKeepIndexBuildCheckpoint(bool keep) {
+    keepIndexBuildCheckpoint_ = keep;
+  }
+
+  // The checkpoint of the last call to `createFromFiles`.
+  IndexBuildCheckpoint& indexBuildCheckpoint() {
+    return indexBuildCheckpoint_.value();
+  }
+
+  // Make `createFromFiles` throw after the `stage`, see
+  // `interruptIndexBuildAfterStage_`.
+  void interruptIndexBuildAfterStageOnlyForTesting(
+      std::optional<IndexBuildStage> stage) {
+    interruptIndexBuildAfterStage_ = stage;
+  }
+
   // __________________________________________________________________________
   NumNormalAndInternal numDistinctSubjects() const;
 
@@ -508,14 +663,42 @@ class IndexImpl {
   // the triples converted to id space. This Vec can be used for creating
   // permutations. Member vocab_ will be empty after this because it is not
   // needed for index creation once the TripleVec is set up and it would be a
-  // waste of RAM.
+  // waste of RAM. The stages that were finished by an interrupted index build
+  // (see `IndexBuildCheckpoint`) are not repeated.
   IndexBuilderDataAsFirstPermutationSorter createIdTriplesAndVocab(
-      std::shared_ptr<RdfParserBase> parser);
+      const std::vector<Index::InputFileSpecification>& files);
 
-  // ___________________________________________________________________
+  // Parse the input and write the partial vocabularies and the triples with
+  // the partial IDs. The `idTriples` of the result are persisted.
   IndexBuilderDataAsExternalVector passFileForVocabulary(
       std::shared_ptr<RdfParserBase> parser, size_t linesPerPartial);
 
+  // Merge the partial vocabularies that were written by `passFileForVocabulary`
+  // (and the vocabulary of the existing index for an incremental build) into
+  // the vocabulary of the index, and set the `vocabularyMetaData_` of the
+  // `indexBuilderData`. The mappings from the partial to the global IDs are
+  // written to the ID map files, which are read by
+  // `convertPartialToGlobalIds`.
+  void mergeVocabularyAndIdMaps(
+      IndexBuilderDataAsExternalVector& indexBuilderData);
+
+  // Reopen the triples with the partial IDs that were persisted by
+  // `passFileForVocabulary` of an interrupted index build. The number of
+  // triples per partial vocabulary is read from the `stageData`.
+  IndexBuilderDataAsExternalVector reopenPartialIdTriples(
+      const nlohmann::json& stageData) const;
+
+  // The names of the files of the sorters that are returned by
+  // `convertPartialToGlobalIds`, and of the unsorted triples of
+  // `passFileForVocabulary`.
+  std::string filenameOfSorter(std::string_view permutationName) const;
+  std::string filenameOfPartialIdTriples() const;
+
+  // Build the `SpatialIndex` for the `numGeometries` WKT literals of the
+  // vocabulary (which has to be written already) that have consecutive indices
+  // starting at `firstGeometryIndex`.
+  void buildSpatialIndex(uint64_t firstGeometryIndex, uint64_t numGeometries);
+
   /**
    * @brief Everything that has to be done when we have seen all the triples
    * that belong to one partial vocabulary, including Log output used inside
@@ -570,12 +753,16 @@ class IndexImpl {
   // createPatternsAfterFirst is only valid when  the pair is SPO-SOP because
   // the SPO permutation is also needed for patterns (see usage in
   // IndexImpl::createFromFile function)
+  //
+  // The files are written with the given `onDiskBase` (instead of reading the
+  // `onDiskBase_` member), s.t. the internal permutations can be built while
+  // another pair is built.
 
   template <typename SortedTriplesType, typename... CallbackTypes>
   [[nodiscard]] size_t createPermutationPair(
-      size_t numColumns, SortedTriplesType&& sortedTriples,
-      const Permutation& p1, const Permutation& p2,
-      CallbackTypes&&... perTripleCallbacks);
+      size_t numColumns, const std::string& onDiskBase,
+      SortedTriplesType&& sortedTriples, const Permutation& p1,
+      const Permutation& p2, CallbackTypes&&... perTripleCallbacks);
 
   // wrapper for createPermutation that saves a lot of code duplications
   // Writes the permutation that is specified by argument permutation
@@ -589,9 +776,9 @@ class IndexImpl {
   template <typename T, typename... Callbacks>
   std::tuple<size_t, IndexMetaDataMmapDispatcher::WriteType,
              IndexMetaDataMmapDispatcher::WriteType>
-  createPermutations(size_t numColumns, T&& sortedTriples,
-                     const Permutation& p1, const Permutation& p2,
-                     Callbacks&&... perTripleCallbacks);
+  createPermutations(size_t numColumns, const std::string& onDiskBase,
+                     T&& sortedTriples, const Permutation& p1,
+                     const Permutation& p2, Callbacks&&... perTripleCallbacks);
 
   void openTextFileHandle();
 
@@ -695,7 +882,7 @@ class IndexImpl {
   // Create the SPO and SOP permutations. Additionally, count the number of
   // distinct actual (not internal) subjects in the input and write it to the
   // metadata. Also builds the patterns if specified.
-  CPP_template(typename... NextSorter)(requires(sizeof...(NextSorter) <= 1))
+  CPP_template(typename... NextSorter)(requires(sizeof...(NextSorter) <= 2))
       std::optional<PatternCreator::TripleSorter> createSPOAndSOP(
           size_t numColumns, BlocksOfTriples sortedTriples,
           NextSorter&&... nextSorter);
@@ -707,16 +894,18 @@ class IndexImpl {
                                NextSorter&&... nextSorter);
 
   // Create the PSO and POS permutations. Additionally, count the number of
-  // distinct predicates and the number of actual triples and write them to the
-  // metadata. The meta-data JSON file for the index statistics will only be
-  // written iff `doWriteConfiguration` is true. That parameter is set to
-  // `false` when building the additional permutations for the internal triples.
+  // distinct predicates and the number of actual triples and return them (in
+  // this order). They are also written to the metadata and the meta-data JSON
+  // file for the index statistics iff `doWriteConfiguration` is true. That
+  // parameter is set to `false` when building the additional permutations for
+  // the internal triples (with the `onDiskBase` of the internal index), which
+  // then don't access the `configurationJson_` at all.
   CPP_template(typename... NextSorter)(
-      requires(sizeof...(NextSorter) <=
-               1)) void createPSOAndPOSImpl(size_t numColumns,
-                                            BlocksOfTriples sortedTriples,
-                                            bool doWriteConfiguration,
-                                            NextSorter&&... nextSorter);
+      requires(sizeof...(NextSorter) <= 1)) std::pair<size_t, size_t>
+      createPSOAndPOSImpl(size_t numColumns, const std::string& onDiskBase,
+                          BlocksOfTriples sortedTriples,
+                          bool doWriteConfiguration,
+                          NextSorter&&... nextSorter);
   // Call `createPSOAndPOSImpl` with the given arguments and with
   // `doWriteConfiguration` set to `true` (see above).
   CPP_template(typename... NextSorter)(requires(
@@ -724,25 +913,62 @@ class IndexImpl {
       1)) void createPSOAndPOS(size_t numColumns, BlocksOfTriples sortedTriples,
                                NextSorter&&... nextSorter);
 
-  // Create the internal PSO and POS permutations from the sorted internal
-  // triples. Return `(numInternalTriples, numInternalPredicates)`.
-  template <typename InternalTriplePsoSorter>
+  // Functions for an incremental index build (see
+  // `setExistingIndexForIncrementalBuild`). Load the existing index and adopt
+  // the settings that determine its IDs.
+  void loadExistingIndex();
+  // Write the vocabulary of the existing index to the partial vocabulary file
+  // with the given index, s.t. it is merged with the partial vocabularies of
+  // the input.
+  void writeVocabularyOfExistingIndex(size_t partialVocabularyIndex) const;
+  // Read the mapping of the existing vocabulary to the new vocabulary from the
+  // ID map of the partial vocabulary with the given index.
+  void readNewIdsOfExistingVocabulary(size_t partialVocabularyIndex);
+  // Return all the triples of the `permutation` of the existing index with
+  // their new IDs. The columns are in the order S, P, O, G.
+  BlocksOfTriples scanExistingPermutation(const Permutation& permutation) const;
+  // Add the internal triples of the existing index (except for the patterns,
+  // which are recomputed) to the `internalTriplesPsoSorter`.
+  void addInternalTriplesOfExistingIndex(
+      ExternalSorter<SortByPSO>& internalTriplesPsoSorter) const;
+  // Merge the `newTriples`, which have to be sorted by the `comparator`, with
+  // the triples of the `permutation` of the existing index. Duplicates are
+  // removed.
+  template <typename Comparator>
+  BlocksOfTriples mergeWithExistingPermutation(BlocksOfTriples newTriples,
+                                               Permutation::Enum permutation,
+                                               Comparator comparator) const;
+
+  // Create the internal PSO and POS permutations from the internal triples,
+  // which have to be sorted by PSO. Return
+  // `(numInternalTriples, numInternalPredicates)`.
   std::pair<size_t, size_t> createInternalPSOandPOS(
-      InternalTriplePsoSorter&& internalTriplesPsoSorter);
+      BlocksOfTriples sortedInternalTriples);
+
+  // Reopen a sorter that was created by `makeSorterPtr` with the same
+  // arguments and then persisted (see `CompressedExternalIdTable::persist`).
+  template <typename Comparator, size_t N = NumColumnsIndexBuilding>
+  std::unique_ptr<ExternalSorter<Comparator, N>> reopenSorterPtr(
+      std::string_view permutationName,
+      size_t numSortersAtSameTime = NUM_EXTERNAL_SORTERS_AT_SAME_TIME) const;
 
   // Set up one of the permutation sorters with the appropriate memory limit.
   // The `permutationName` is used to determine the filename and must be unique
-  // for each call during one index build.
+  // for each call during one index build. The memory limit is split between
+  // `numSortersAtSameTime` sorters.
   template <typename Comparator, size_t N = NumColumnsIndexBuilding>
   ExternalSorter<Comparator, N> makeSorter(
-      std::string_view permutationName) const;
+      std::string_view permutationName,
+      size_t numSortersAtSameTime = NUM_EXTERNAL_SORTERS_AT_SAME_TIME) const;
   // Same as the same function, but return a `unique_ptr`.
   template <typename Comparator, size_t N = NumColumnsIndexBuilding>
   std::unique_ptr<ExternalSorter<Comparator, N>> makeSorterPtr(
-      std::string_view permutationName) const;
+      std::string_view permutationName,
+      size_t numSortersAtSameTime = NUM_EXTERNAL_SORTERS_AT_SAME_TIME) const;
   // The common implementation of the above two functions.
   template <typename Comparator, size_t N, bool returnPtr>
-  auto makeSorterImpl(std::string_view permutationName) const;
+  auto makeSorterImpl(std::string_view permutationName,
+                      size_t numSortersAtSameTime) const;
 
   // Aliases for the three functions above that should be consistently used.
   // They assert that the order of the permutations as communicated by the
@@ -783,10 +1009,49 @@ class IndexImpl {
   // subject pattern of the object (which is created by this function). Return
   // these five columns sorted by PSO, to be used as an input for building the
   // PSO and POS permutations.
-  template <typename InternalTripleSorter>
   std::unique_ptr<ExternalSorter<SortByPSO, NumColumnsIndexBuilding + 2>>
-  buildOspWithPatterns(PatternCreator::TripleSorter sortersFromPatternCreator,
-                       InternalTripleSorter& internalTripleSorter);
+  buildOspWithPatterns(PatternCreator::TripleSorter sortersFromPatternCreator);
+
+  // Add the `ql:has-pattern` triples from the output of the `PatternCreator`
+  // to the `internalTriplesPsoSorter`, s.t. they become part of the internal
+  // PSO and POS permutations. The triples can still be used by
+  // `buildOspWithPatterns` afterwards. Note: The sorter must not be the
+  // persisted sorter of the other internal triples.
+  void addHasPatternTriplesToInternalTriples(
+      PatternCreator::TripleSorter& sortersFromPatternCreator,
+      ExternalSorter<SortByPSO>& internalTriplesPsoSorter) const;
+
+  // Functions for resuming an interrupted index build (see
+  // `IndexBuildCheckpoint`). Return the input files and settings of the index
+  // build, which have to be the same for the build that is resumed.
+  nlohmann::json settingsForIndexBuildCheckpoint(
+      const std::vector<Index::InputFileSpecification>& files) const;
+  // Return the files that are written by the given `stage`.
+  std::vector<std::string> outputFilesOfIndexBuildStage(
+      IndexBuildStage stage) const;
+  // Record in the `indexBuildCheckpoint_` that the `stage` is finished.
+  void markIndexBuildStageFinished(
+      IndexBuildStage stage, nlohmann::json data = nlohmann::json::object());
+  // Forget the `stage` (one of the stages before the permutations) and delete
+  // its output files, which are no longer needed by the later stages.
+  void removeOutputOfIndexBuildStage(IndexBuildStage stage);
+  // Set the IDs that are determined by the vocabulary merge from the `data`
+  // of a finished stage, see `markIndexBuildStageFinished`.
+  void setIdsOfVocabularyMergeFromIndexBuildCheckpoint(
+      const nlohmann::json& data);
+  // Return true iff the previous index build can be resumed from its
+  // permutations. This requires the first pair of permutations and the
+  // internal permutations (and the patterns if they are built). The stages
+  // before are resumed by `createIdTriplesAndVocab`.
+  bool canResumeIndexBuild() const;
+  // Build the missing permutations of the previous index build from its first
+  // pair of permutations and finish the configuration.
+  void resumeIndexBuild();
+  // Return all the triples of the `permutation` that was written by the
+  // previous index build, including the `numColumns - 3` additional columns.
+  // The first three columns are in the order S, P, O.
+  BlocksOfTriples scanPermutationOfInterruptedIndexBuild(
+      Permutation::Enum permutation, size_t numColumns) const;
 
   // During the index, building add the number of internal triples and internal
   // predicates to the configuration. Note: the number of internal objects and
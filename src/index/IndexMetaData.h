@@ -158,6 +158,9 @@ class IndexMetaData {
   // be computed.
   std::string statistics() const;
 
+  // The total number of triples, as computed by `calculateStatistics`.
+  size_t getNumTriples() const { return totalElements_; }
+
   void setName(const std::string& name) { name_ = name; }
 
   const std::string& getName() const { return name_; }
@@ -61,7 +61,7 @@ NumAddedAndDeleted LocatedTriplesPerBlock::numTriples(size_t blockIndex) const {
   if (!hasUpdates(blockIndex)) {
     return {0, 0};
   } else {
-    const auto& blockUpdateTriples = map_.at(blockIndex);
+    const auto& blockUpdateTriples = *map_.at(blockIndex);
     // Simply return the number of located triples twice. See the comment in the
     // header file for the reasons and potential improvements.
     return {blockUpdateTriples.size(), blockUpdateTriples.size()};
@@ -132,7 +132,7 @@ IdTable LocatedTriplesPerBlock::mergeTriplesImpl(size_t blockIndex,
   IdTable result{block.numColumns(), block.getAllocator()};
   result.resize(block.numRows() + numInsertsAndDeletes.numAdded_);
 
-  const auto& locatedTriples = map_.at(blockIndex);
+  const auto& locatedTriples = *map_.at(blockIndex);
 
   auto lessThan = [](const auto& lt, const auto& row) {
     return tieLocatedTriple<numIndexColumns, includeGraphColumn>(lt) <
@@ -231,47 +231,58 @@ IdTable LocatedTriplesPerBlock::mergeTriples(size_t blockIndex,
 }
 
 // ____________________________________________________________________________
-std::vector<LocatedTriples::iterator> LocatedTriplesPerBlock::add(
-    ql::span<const LocatedTriple> locatedTriples,
-    ad_utility::timer::TimeTracer& tracer) {
+LocatedTriples& LocatedTriplesPerBlock::getBlockForModification(
+    size_t blockIndex) {
+  auto& block = map_[blockIndex];
+  if (block == nullptr) {
+    block = std::make_shared<LocatedTriples>();
+  } else if (block.use_count() > 1) {
+    // The set is shared with a copy (typically a snapshot that is used by a
+    // running query). Note that copies are only ever created from this object
+    // (under the same lock that protects the modifications), so a use count of
+    // one can not concurrently increase.
+    block = std::make_shared<LocatedTriples>(*block);
+  }
+  return *block;
+}
+
+// ____________________________________________________________________________
+void LocatedTriplesPerBlock::add(ql::span<const LocatedTriple> locatedTriples,
+                                 ad_utility::timer::TimeTracer& tracer) {
   tracer.beginTrace("adding");
-  std::vector<LocatedTriples::iterator> handles;
-  handles.reserve(locatedTriples.size());
   for (auto triple : locatedTriples) {
-    LocatedTriples& locatedTriplesInBlock = map_[triple.blockIndex_];
+    LocatedTriples& locatedTriplesInBlock =
+        getBlockForModification(triple.blockIndex_);
     auto [handle, wasInserted] = locatedTriplesInBlock.emplace(triple);
     AD_CORRECTNESS_CHECK(wasInserted == true);
     AD_CORRECTNESS_CHECK(handle != locatedTriplesInBlock.end());
     ++numTriples_;
-    handles.emplace_back(handle);
   }
 
   tracer.endTrace("adding");
-  tracer.beginTrace("updateMetadata");
   updateAugmentedMetadata();
-  tracer.endTrace("updateMetadata");
-
-  return handles;
 }
 
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::erase(size_t blockIndex,
-                                   LocatedTriples::iterator iter) {
-  auto blockIter = map_.find(blockIndex);
-  AD_CONTRACT_CHECK(blockIter != map_.end(), "Block ", blockIndex,
+                                   const LocatedTriple& locatedTriple) {
+  AD_CONTRACT_CHECK(map_.contains(blockIndex), "Block ", blockIndex,
                     " is not contained.");
-  auto& block = blockIter->second;
-  block.erase(iter);
+  auto& block = getBlockForModification(blockIndex);
+  auto numErased = block.erase(locatedTriple);
+  AD_CORRECTNESS_CHECK(numErased == 1);
   numTriples_--;
   if (block.empty()) {
     map_.erase(blockIndex);
   }
+  updateAugmentedMetadata();
 }
 
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::setOriginalMetadata(
     std::shared_ptr<const std::vector<CompressedBlockMetadata>> metadata) {
   originalMetadata_ = std::move(metadata);
+  updateAugmentedMetadata();
 }
 
 // Update the `blockMetadata`, such that its graph info is consistent with the
@@ -316,21 +327,58 @@ static auto updateGraphMetadata(CompressedBlockMetadata& blockMetadata,
   ql::ranges::sort(graphs.value());
 }
 
+// Update the `columnSummaries_` of the `blockMetadata`, such that they also
+// bound the triples that are inserted via the `locatedTriples`. The values of
+// the additional columns (for example, the patterns) of the inserted triples
+// are not known here, so the summaries of these columns are removed.
+static void updateColumnSummaries(CompressedBlockMetadata& blockMetadata,
+                                  const LocatedTriples& locatedTriples) {
+  auto& summaries = blockMetadata.columnSummaries_;
+  summaries.resize(
+      std::min(summaries.size(), size_t{ADDITIONAL_COLUMN_GRAPH_ID + 1}));
+  for (auto& lt : locatedTriples) {
+    if (!lt.insertOrDelete_) {
+      // The summaries stay valid (but maybe less tight) for deleted triples.
+      continue;
+    }
+    const auto& ids = lt.triple_.ids();
+    for (size_t i = 0; i < summaries.size(); ++i) {
+      summaries[i].add(ids.at(i));
+    }
+  }
+}
+
+// ____________________________________________________________________________
+const std::vector<CompressedBlockMetadata>&
+LocatedTriplesPerBlock::getAugmentedMetadata() const {
+  if (map_.empty()) {
+    return getBaseMetadata();
+  }
+  // `call_once` also blocks concurrent callers until the metadata is computed.
+  // If the computation throws, the next call tries again.
+  auto& augmentedMetadata = *augmentedMetadata_;
+  std::call_once(augmentedMetadata.isComputed_, [this, &augmentedMetadata]() {
+    augmentedMetadata.metadata_ = computeAugmentedMetadata();
+  });
+  return augmentedMetadata.metadata_;
+}
+
 // ____________________________________________________________________________
-void LocatedTriplesPerBlock::updateAugmentedMetadata() {
+std::vector<CompressedBlockMetadata>
+LocatedTriplesPerBlock::computeAugmentedMetadata() const {
   // TODO<C++23> use view::enumerate
   size_t blockIndex = 0;
-  // Copy to preserve originalMetadata_.
-  if (!originalMetadata_.has_value()) {
+  // Copy to preserve the base metadata.
+  std::vector<CompressedBlockMetadata> augmentedMetadata;
+  if (!originalMetadata_.has_value() && compactedMetadata_ == nullptr) {
     AD_LOG_WARN << "The original metadata has not been set, but updates are "
                    "being performed. This should only happen in unit tests\n";
-    augmentedMetadata_.emplace();
   } else {
-    augmentedMetadata_ = *originalMetadata_.value();
+    augmentedMetadata = getBaseMetadata();
   }
-  for (auto& blockMetadata : augmentedMetadata_.value()) {
+  for (auto& blockMetadata : augmentedMetadata) {
     if (hasUpdates(blockIndex)) {
-      const auto& blockUpdates = map_.at(blockIndex);
+      const auto& blockUpdates = *map_.at(blockIndex);
       blockMetadata.firstTriple_ =
           std::min(blockMetadata.firstTriple_,
                    blockUpdates.begin()->triple_.toPermutedTriple());
@@ -338,13 +386,14 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
           std::max(blockMetadata.lastTriple_,
                    blockUpdates.rbegin()->triple_.toPermutedTriple());
       updateGraphMetadata(blockMetadata, blockUpdates);
+      updateColumnSummaries(blockMetadata, blockUpdates);
     }
     blockIndex++;
   }
   // Also account for the last block that contains the triples that are larger
   // than all the inserted triples.
   if (hasUpdates(blockIndex)) {
-    const auto& blockUpdates = map_.at(blockIndex);
+    const auto& blockUpdates = *map_.at(blockIndex);
     auto firstTriple = blockUpdates.begin()->triple_.toPermutedTriple();
     auto lastTriple = blockUpdates.rbegin()->triple_.toPermutedTriple();
 
@@ -363,12 +412,118 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
     lastBlockN.graphInfo_.emplace();
     CompressedBlockMetadata lastBlock{lastBlockN, blockIndex};
     updateGraphMetadata(lastBlock, blockUpdates);
-    augmentedMetadata_->push_back(lastBlock);
+    augmentedMetadata.push_back(lastBlock);
 
     AD_CORRECTNESS_CHECK(
         CompressedBlockMetadata::checkInvariantsForSortedBlocks(
-            *augmentedMetadata_));
+            augmentedMetadata));
   }
+  return augmentedMetadata;
+}
+
+// ____________________________________________________________________________
+std::vector<size_t> LocatedTriplesPerBlock::getBlocksWithAtLeast(
+    size_t minNumTriples) const {
+  std::vector<size_t> result;
+  for (const auto& [blockIndex, block] : map_) {
+    if (block->size() >= minNumTriples) {
+      result.push_back(blockIndex);
+    }
+  }
+  ql::ranges::sort(result);
+  return result;
+}
+
+// ____________________________________________________________________________
+bool LocatedTriplesPerBlock::hasUpdatesForCol0(Id col0Id) const {
+  if (numTriples_ == 0 && !hasCompactedBlocks()) {
+    return false;
+  }
+  const auto& blocks = getBaseMetadata();
+  // A located triple belongs to the first block whose last triple is not
+  // smaller (or to the block one past the last block). The triples with the
+  // `col0Id` can therefore only be located in the blocks from the first one
+  // that ends with or after the `col0Id` to the first one that ends after it.
+  auto beginIndex = static_cast<size_t>(
+      ql::ranges::partition_point(blocks,
+                                  [col0Id](const auto& block) {
+                                    return block.lastTriple_.col0Id_ < col0Id;
+                                  }) -
+      blocks.begin());
+  for (size_t blockIndex = beginIndex; blockIndex <= blocks.size();
+       ++blockIndex) {
+    if (auto it = map_.find(blockIndex); it != map_.end()) {
+      if (ql::ranges::any_of(*it->second, [col0Id](const LocatedTriple& lt) {
+            return lt.triple_.ids()[0] == col0Id;
+          })) {
+        return true;
+      }
+    }
+    if (blockIndex == blocks.size()) {
+      break;
+    }
+    const auto& block = blocks[blockIndex];
+    // A compacted (or relocated) block differs from the original one.
+    if (hasCompactedBlocks() && block.firstTriple_.col0Id_ <= col0Id &&
+        (!originalMetadata_.has_value() ||
+         blockIndex >= originalMetadata_.value()->size() ||
+         block != originalMetadata_.value()->at(blockIndex))) {
+      return true;
+    }
+    if (block.lastTriple_.col0Id_ > col0Id) {
+      break;
+    }
+  }
+  return false;
+}
+
+// ____________________________________________________________________________
+bool LocatedTriplesPerBlock::hasSameLocatedTriples(
+    size_t blockIndex, const LocatedTriplesPerBlock& other) const {
+  auto it = map_.find(blockIndex);
+  auto otherIt = other.map_.find(blockIndex);
+  if (it == map_.end() || otherIt == other.map_.end()) {
+    return it == map_.end() && otherIt == other.map_.end();
+  }
+  // The sets are copied on modification, see `getBlockForModification`.
+  return it->second == otherIt->second;
+}
+
+// ____________________________________________________________________________
+void LocatedTriplesPerBlock::replaceCompactedBlocks(
+    const std::vector<CompressedBlockMetadata>& compactedBlocks,
+    const std::vector<CompressedBlockMetadata>& relocatedBlocks,
+    std::shared_ptr<const CompactedBlocksFile> compactedBlocksFile) {
+  if (compactedBlocks.empty() && relocatedBlocks.empty()) {
+    return;
+  }
+  // Copy the metadata because the previous version might still be used by a
+  // copy of this object.
+  auto metadata = std::make_shared<std::vector<CompressedBlockMetadata>>(
+      getBaseMetadata());
+  for (const auto& block : relocatedBlocks) {
+    AD_CONTRACT_CHECK(block.blockIndex_ < metadata->size());
+    metadata->at(block.blockIndex_) = block;
+  }
+  for (const auto& block : compactedBlocks) {
+    auto blockIndex = block.blockIndex_;
+    if (blockIndex == metadata->size()) {
+      metadata->push_back(block);
+    } else {
+      AD_CONTRACT_CHECK(blockIndex < metadata->size());
+      metadata->at(blockIndex) = block;
+    }
+    auto it = map_.find(blockIndex);
+    if (it != map_.end()) {
+      numTriples_ -= it->second->size();
+      map_.erase(it);
+    }
+  }
+  AD_CORRECTNESS_CHECK(
+      CompressedBlockMetadata::checkInvariantsForSortedBlocks(*metadata));
+  compactedMetadata_ = std::move(metadata);
+  compactedBlocksFile_ = std::move(compactedBlocksFile);
+  updateAugmentedMetadata();
 }
 
 // ____________________________________________________________________________
@@ -397,6 +552,6 @@ bool LocatedTriplesPerBlock::isLocatedTriple(const IdTriple<0>& triple,
 
   return ql::ranges::any_of(map_, [&blockContains](auto& indexAndBlock) {
     const auto& [index, block] = indexAndBlock;
-    return blockContains(block, index);
+    return blockContains(*block, index);
   });
 }
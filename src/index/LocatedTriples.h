@@ -12,6 +12,8 @@
 #define QLEVER_SRC_INDEX_LOCATEDTRIPLES_H
 
 #include <boost/optional.hpp>
+#include <memory>
+#include <mutex>
 
 #include "engine/idTable/IdTable.h"
 #include "global/IdTriple.h"
@@ -83,30 +85,71 @@ std::ostream& operator<<(std::ostream& os, const LocatedTriples& lts);
 
 // Sorted sets of located triples, grouped by block. We use this to store all
 // located triples for a permutation.
+//
+// NOTE: The sets of the individual blocks and the augmented metadata are
+// shared between copies of this class (copy-on-write). Copying a
+// `LocatedTriplesPerBlock` (which happens for each snapshot of the
+// `DeltaTriples`) therefore only copies one pointer per block with updates,
+// and a subsequent modification only copies the sets of the blocks that are
+// actually modified. The augmented metadata is only computed when it is first
+// used after a modification, so an update doesn't cost time proportional to the
+// number of blocks.
 class LocatedTriplesPerBlock {
  private:
   // The total number of `LocatedTriple` objects stored (for all blocks).
   size_t numTriples_ = 0;
 
   // For each block with a non-empty set of located triples, the located triples
-  // in that block.
-  ad_utility::HashMap<size_t, LocatedTriples> map_;
+  // in that block. The sets might be shared with copies of this object, see
+  // `getBlockForModification` below.
+  ad_utility::HashMap<size_t, std::shared_ptr<LocatedTriples>> map_;
 
   FRIEND_TEST(LocatedTriplesTest, numTriplesInBlock);
+  FRIEND_TEST(LocatedTriplesTest, copyOnWrite);
 
   // Implementation of the `mergeTriples` function (which has `numIndexColumns`
   // as a normal argument, and translates it into a template argument).
   template <size_t numIndexColumns, bool includeGraphColumn>
   IdTable mergeTriplesImpl(size_t blockIndex, const IdTable& block) const;
 
-  // Stores the block metadata where the block borders have been adjusted for
-  // the updated triples.
-  std::optional<std::vector<CompressedBlockMetadata>> augmentedMetadata_;
+  // Return the located triples of the block with the given index for
+  // modification (the set is created if it doesn't exist yet). If the set is
+  // shared with a copy of this object, it is copied first, s.t. the copy
+  // remains unchanged.
+  LocatedTriples& getBlockForModification(size_t blockIndex);
+
+  // The block metadata where the block borders have been adjusted for the
+  // updated triples. It is computed by the first call to
+  // `getAugmentedMetadata` and replaced by an empty one on each modification,
+  // so it can be shared between copies of this object (which might be used by
+  // several queries concurrently).
+  struct AugmentedMetadata {
+    std::once_flag isComputed_;
+    std::vector<CompressedBlockMetadata> metadata_;
+  };
+  std::shared_ptr<AugmentedMetadata> augmentedMetadata_ =
+      std::make_shared<AugmentedMetadata>();
   std::optional<std::shared_ptr<const std::vector<CompressedBlockMetadata>>>
       originalMetadata_;
+  // The `originalMetadata_`, where the blocks that were rewritten by
+  // `replaceCompactedBlocks` (see below) are replaced by their compacted
+  // version. `nullptr` if no blocks have been compacted.
+  std::shared_ptr<const std::vector<CompressedBlockMetadata>>
+      compactedMetadata_;
+  // The file that contains the compacted blocks of the `compactedMetadata_`,
+  // which is kept alive as long as the metadata is used.
+  std::shared_ptr<const CompactedBlocksFile> compactedBlocksFile_;
+
+  // Compute the augmented metadata from the base metadata and the located
+  // triples. This costs time proportional to the number of blocks.
+  std::vector<CompressedBlockMetadata> computeAugmentedMetadata() const;
 
  public:
-  void updateAugmentedMetadata();
+  // Mark the augmented metadata as outdated, it is recomputed when it is used
+  // next. This is done by all the modifying functions of this class.
+  void updateAugmentedMetadata() {
+    augmentedMetadata_ = std::make_shared<AugmentedMetadata>();
+  }
 
  public:
   // Get upper limits for the number of inserted and deleted located triples
@@ -159,23 +202,20 @@ class LocatedTriplesPerBlock {
     return map_.contains(blockIndex);
   }
 
-  // Add `locatedTriples` to the `LocatedTriplesPerBlock` and return handles to
-  // where they were added (`LocatedTriples` is a sorted set, see above). Using
-  // these handles, we can easily remove the `locatedTriples` from the set again
-  // when we need to.
+  // Add `locatedTriples` to the `LocatedTriplesPerBlock`. They can later be
+  // removed again via `erase` below using their `blockIndex_`.
   //
   // PRECONDITION: The `locatedTriples` must not already exist in
   // `LocatedTriplesPerBlock`.
-  std::vector<LocatedTriples::iterator> add(
-      ql::span<const LocatedTriple> locatedTriples,
-      ad_utility::timer::TimeTracer& tracer =
-          ad_utility::timer::DEFAULT_TIME_TRACER);
+  void add(ql::span<const LocatedTriple> locatedTriples,
+           ad_utility::timer::TimeTracer& tracer =
+               ad_utility::timer::DEFAULT_TIME_TRACER);
 
-  // Removes the given `LocatedTriple` from the `LocatedTriplesPerBlock`.
-  //
-  // NOTE: `updateAugmentedMetadata()` must be called to update the block
-  // metadata.
-  void erase(size_t blockIndex, LocatedTriples::iterator iter);
+  // Removes the `LocatedTriple` with the same `triple_` as `locatedTriple`
+  // from the block with the given index. Note that we don't store iterators
+  // into the sets as handles, because they are invalidated when a shared set
+  // is copied on modification.
+  void erase(size_t blockIndex, const LocatedTriple& locatedTriple);
 
   // Get the total number of `LocatedTriple`s (for all blocks).
   size_t numTriples() const { return numTriples_; }
@@ -183,6 +223,22 @@ class LocatedTriplesPerBlock {
   // Get the number of blocks with a non-empty set of located triples.
   size_t numBlocks() const { return map_.size(); }
 
+  // Return true iff some blocks have been replaced by their compacted version,
+  // see `replaceCompactedBlocks`.
+  bool hasCompactedBlocks() const { return compactedMetadata_ != nullptr; }
+
+  // The file that contains the compacted blocks, `nullptr` if there are none.
+  const std::shared_ptr<const CompactedBlocksFile>& getCompactedBlocksFile()
+      const {
+    return compactedBlocksFile_;
+  }
+
+  // Return true iff there are located triples with the given first `Id` (for
+  // example, the predicate in the PSO permutation), or if a block that might
+  // contain such triples has been compacted. Only the blocks of the relation
+  // and the block after it are inspected.
+  bool hasUpdatesForCol0(Id col0Id) const;
+
   // Must be called initially before using the `LocatedTriplesPerBlock` to
   // initialize the original block metadata that is augmented for updated
   // triples. This is currently done in `Permutation::loadFromDisk`.
@@ -196,20 +252,53 @@ class LocatedTriplesPerBlock {
 
   // Returns the block metadata where the block borders have been updated to
   // account for the update triples. All triples (both insert and delete) will
-  // enlarge the block borders.
-  const std::vector<CompressedBlockMetadata>& getAugmentedMetadata() const {
-    if (augmentedMetadata_.has_value()) {
-      return augmentedMetadata_.value();
+  // enlarge the block borders. This is thread-safe for concurrent calls on the
+  // same object (or on copies that share the metadata).
+  const std::vector<CompressedBlockMetadata>& getAugmentedMetadata() const;
+
+  // Returns the block metadata before the block borders are updated for the
+  // located triples. This is the original metadata, unless some blocks have
+  // been compacted.
+  const std::vector<CompressedBlockMetadata>& getBaseMetadata() const {
+    if (compactedMetadata_ != nullptr) {
+      return *compactedMetadata_;
     }
     AD_CONTRACT_CHECK(originalMetadata_.has_value());
     return *originalMetadata_.value();
-  };
+  }
 
-  // Remove all located triples.
+  // Return the (sorted) indices of the blocks that contain at least
+  // `minNumTriples` located triples.
+  std::vector<size_t> getBlocksWithAtLeast(size_t minNumTriples) const;
+
+  // Return true iff this object and `other` (typically a copy of an earlier
+  // version of this object) share the same located triples for the block with
+  // the given index, that is, if that block has not been modified since the
+  // copy was made.
+  bool hasSameLocatedTriples(size_t blockIndex,
+                             const LocatedTriplesPerBlock& other) const;
+
+  // Replace the base metadata of the blocks with the indices of the
+  // `compactedBlocks` by the `compactedBlocks` and remove all the located
+  // triples of these blocks. The `compactedBlocks` must contain the merged
+  // located triples, see `DeltaTriples::prepareCompaction`. A block with an
+  // index one past the last block (which contains the triples that are larger
+  // than all the triples of the permutation) is appended. The
+  // `relocatedBlocks` are blocks that were already compacted and have only
+  // been copied to a new file, their located triples are kept. All the
+  // compacted blocks must be contained in the `compactedBlocksFile`.
+  void replaceCompactedBlocks(
+      const std::vector<CompressedBlockMetadata>& compactedBlocks,
+      const std::vector<CompressedBlockMetadata>& relocatedBlocks,
+      std::shared_ptr<const CompactedBlocksFile> compactedBlocksFile);
+
+  // Remove all located triples. This also undoes all the compactions.
   void clear() {
     map_.clear();
     numTriples_ = 0;
-    augmentedMetadata_.reset();
+    updateAugmentedMetadata();
+    compactedMetadata_.reset();
+    compactedBlocksFile_.reset();
   }
 
   // Return `true` iff one of the blocks contains `triple` with the given
@@ -229,8 +318,8 @@ class LocatedTriplesPerBlock {
                      std::back_inserter(blockIndices));
     ql::ranges::sort(blockIndices);
     for (auto blockIndex : blockIndices) {
-      os << "LTs in Block #" << blockIndex << ": " << ltpb.map_.at(blockIndex)
-         << std::endl;
+      os << "LTs in Block #" << blockIndex << ": "
+         << *ltpb.map_.at(blockIndex) << std::endl;
     }
     return os;
   };
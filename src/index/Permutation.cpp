@@ -58,7 +58,12 @@ void Permutation::loadFromDisk(const std::string& onDiskBase,
              e.what());
   }
   meta_.readFromFile(&file);
-  reader_.emplace(allocator_, std::move(file));
+  // The compacted blocks are not persisted (see `DeltaTriplesManager`), so
+  // the files of a previous process that was not shut down properly are stale.
+  CompactedBlocksFile::removeAll(
+      absl::StrCat(filename, COMPACTED_BLOCKS_FILE_SUFFIX));
+  reader_.emplace(allocator_, std::move(file),
+                  absl::StrCat(filename, COMPACTED_BLOCKS_FILE_SUFFIX));
   AD_LOG_INFO << "Registered " << readableName_
               << " permutation: " << meta_.statistics() << std::endl;
   isLoaded_ = true;
@@ -230,6 +235,11 @@ const Permutation& Permutation::getActualPermutation(
   if (!isInternalScan) {
     return *this;
   }
+  return internalPermutation();
+}
+
+// ______________________________________________________________________
+const Permutation& Permutation::internalPermutation() const {
   AD_CORRECTNESS_CHECK(internalPermutation_ != nullptr, [this]() {
     return absl::StrCat("No internal triples were loaded for the permutation ",
                         readableName_);
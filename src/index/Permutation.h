@@ -172,6 +172,10 @@ class Permutation {
   const Permutation& getActualPermutation(const ScanSpecification& spec) const;
   const Permutation& getActualPermutation(Id id) const;
 
+  // Return the permutation with the QLever-internal triples. Throw if no
+  // internal triples were loaded for this permutation.
+  const Permutation& internalPermutation() const;
+
   // From the given snapshot, get the located triples for this permutation.
   const LocatedTriplesPerBlock& getLocatedTriplesForPermutation(
       const LocatedTriplesSnapshot& locatedTriplesSnapshot) const;
@@ -0,0 +1,442 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/ReachabilityIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "backports/algorithm.h"
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
+
+namespace {
+// Convert a list of `(source, target)` pairs, which must be sorted, to the
+// adjacency lists of the `numNodes` nodes (see `IntervalLabels::build`).
+std::pair<std::vector<uint64_t>, std::vector<uint32_t>> toAdjacencyLists(
+    size_t numNodes, const std::vector<std::array<uint32_t, 2>>& edges) {
+  std::vector<uint64_t> offsets(numNodes + 1, 0);
+  std::vector<uint32_t> targets;
+  targets.reserve(edges.size());
+  for (const auto& [source, target] : edges) {
+    ++offsets[source + 1];
+    targets.push_back(target);
+  }
+  for (size_t i = 0; i < numNodes; ++i) {
+    offsets[i + 1] += offsets[i];
+  }
+  return {std::move(offsets), std::move(targets)};
+}
+
+// Sort the `edges` and remove the duplicates.
+void sortAndUnique(std::vector<std::array<uint32_t, 2>>& edges) {
+  ql::ranges::sort(edges);
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+}
+
+// Compute the strongly connected components of the graph with the given
+// adjacency lists using (an iterative version of) Tarjan's algorithm. Return
+// the component of each node and the number of components.
+std::pair<std::vector<uint32_t>, uint32_t> computeComponents(
+    const std::vector<uint64_t>& offsets,
+    const std::vector<uint32_t>& targets) {
+  static constexpr uint32_t unvisited = std::numeric_limits<uint32_t>::max();
+  size_t numNodes = offsets.size() - 1;
+  std::vector<uint32_t> component(numNodes, unvisited);
+  std::vector<uint32_t> index(numNodes, unvisited);
+  std::vector<uint32_t> lowLink(numNodes, 0);
+  std::vector<uint8_t> isOnStack(numNodes, false);
+  std::vector<uint32_t> componentStack;
+  // The nodes of the current DFS path with the position of the next edge.
+  std::vector<std::pair<uint32_t, uint64_t>> callStack;
+  uint32_t nextIndex = 0;
+  uint32_t numComponents = 0;
+
+  auto visit = [&](uint32_t node) {
+    index[node] = nextIndex;
+    lowLink[node] = nextIndex;
+    ++nextIndex;
+    componentStack.push_back(node);
+    isOnStack[node] = true;
+    callStack.emplace_back(node, offsets[node]);
+  };
+  for (uint32_t root = 0; root < numNodes; ++root) {
+    if (index[root] != unvisited) {
+      continue;
+    }
+    visit(root);
+    while (!callStack.empty()) {
+      auto [node, edge] = callStack.back();
+      if (edge < offsets[node + 1]) {
+        ++callStack.back().second;
+        uint32_t target = targets[edge];
+        if (index[target] == unvisited) {
+          visit(target);
+        } else if (isOnStack[target]) {
+          lowLink[node] = std::min(lowLink[node], index[target]);
+        }
+        continue;
+      }
+      callStack.pop_back();
+      if (!callStack.empty()) {
+        uint32_t parent = callStack.back().first;
+        lowLink[parent] = std::min(lowLink[parent], lowLink[node]);
+      }
+      if (lowLink[node] == index[node]) {
+        uint32_t member;
+        do {
+          member = componentStack.back();
+          componentStack.pop_back();
+          isOnStack[member] = false;
+          component[member] = numComponents;
+        } while (member != node);
+        ++numComponents;
+      }
+    }
+  }
+  return {std::move(component), numComponents};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+ReachabilityIndex::IntervalLabels ReachabilityIndex::IntervalLabels::build(
+    size_t numComponents, const std::vector<uint64_t>& offsets,
+    const std::vector<uint32_t>& targets) {
+  IntervalLabels result;
+  result.numberOfComponent_.resize(numComponents);
+  result.componentOfNumber_.resize(numComponents);
+
+  // Number the components in DFS post order. `firstNumber[c]` is the first
+  // number in the DFS subtree of `c`.
+  std::vector<uint32_t> firstNumber(numComponents);
+  std::vector<uint8_t> isVisited(numComponents, false);
+  std::vector<std::pair<uint32_t, uint64_t>> callStack;
+  uint32_t nextNumber = 0;
+  auto visit = [&](uint32_t component) {
+    isVisited[component] = true;
+    firstNumber[component] = nextNumber;
+    callStack.emplace_back(component, offsets[component]);
+  };
+  for (uint32_t root = 0; root < numComponents; ++root) {
+    if (isVisited[root]) {
+      continue;
+    }
+    visit(root);
+    while (!callStack.empty()) {
+      auto [component, edge] = callStack.back();
+      if (edge < offsets[component + 1]) {
+        ++callStack.back().second;
+        if (!isVisited[targets[edge]]) {
+          visit(targets[edge]);
+        }
+        continue;
+      }
+      callStack.pop_back();
+      result.numberOfComponent_[component] = nextNumber;
+      result.componentOfNumber_[nextNumber] = component;
+      ++nextNumber;
+    }
+  }
+
+  // In a DAG, the successors of a component have smaller numbers, so the
+  // labels can be computed in the order of the numbers.
+  result.offsets_.reserve(numComponents + 1);
+  result.offsets_.push_back(0);
+  std::vector<Interval> label;
+  for (uint32_t number = 0; number < numComponents; ++number) {
+    uint32_t component = result.componentOfNumber_[number];
+    label.clear();
+    label.push_back({firstNumber[component], number});
+    for (uint64_t edge = offsets[component]; edge < offsets[component + 1];
+         ++edge) {
+      auto successorLabel = result.intervals(targets[edge]);
+      label.insert(label.end(), successorLabel.begin(), successorLabel.end());
+    }
+    ql::ranges::sort(label);
+    // Merge the overlapping and adjacent intervals.
+    size_t numMerged = 0;
+    for (const auto& interval : label) {
+      if (numMerged > 0 &&
+          interval[0] <= uint64_t{label[numMerged - 1][1]} + 1) {
+        label[numMerged - 1][1] =
+            std::max(label[numMerged - 1][1], interval[1]);
+      } else {
+        label[numMerged++] = interval;
+      }
+    }
+    result.intervals_.insert(result.intervals_.end(), label.begin(),
+                             label.begin() + numMerged);
+    result.offsets_.push_back(result.intervals_.size());
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+ql::span<const ReachabilityIndex::Interval>
+ReachabilityIndex::IntervalLabels::intervals(uint32_t component) const {
+  uint32_t number = numberOfComponent_[component];
+  return ql::span<const Interval>{intervals_}.subspan(
+      offsets_[number], offsets_[number + 1] - offsets_[number]);
+}
+
+// _____________________________________________________________________________
+bool ReachabilityIndex::IntervalLabels::isReachable(uint32_t from,
+                                                    uint32_t to) const {
+  uint32_t number = numberOfComponent_[to];
+  auto label = intervals(from);
+  // Find the last interval that starts at or before `number`.
+  auto it = ql::ranges::upper_bound(label, number, {},
+                                    [](const Interval& interval) {
+                                      return interval[0];
+                                    });
+  return it != label.begin() && (it - 1)->at(1) >= number;
+}
+
+// _____________________________________________________________________________
+ReachabilityIndex::Graph ReachabilityIndex::Graph::build(
+    ql::span<const Id> sources, ql::span<const Id> targets) {
+  AD_CONTRACT_CHECK(sources.size() == targets.size());
+  Graph graph;
+  graph.nodes_.reserve(sources.size() + targets.size());
+  graph.nodes_.insert(graph.nodes_.end(), sources.begin(), sources.end());
+  graph.nodes_.insert(graph.nodes_.end(), targets.begin(), targets.end());
+  ql::ranges::sort(graph.nodes_);
+  graph.nodes_.erase(std::unique(graph.nodes_.begin(), graph.nodes_.end()),
+                     graph.nodes_.end());
+  AD_CONTRACT_CHECK(graph.nodes_.size() < std::numeric_limits<uint32_t>::max(),
+                    "Too many nodes for the reachability index");
+  size_t numNodes = graph.nodes_.size();
+
+  std::vector<std::array<uint32_t, 2>> edges;
+  edges.reserve(sources.size());
+  for (size_t i = 0; i < sources.size(); ++i) {
+    edges.push_back({graph.findNode(sources[i]).value(),
+                     graph.findNode(targets[i]).value()});
+  }
+  sortAndUnique(edges);
+  graph.numEdges_ = edges.size();
+
+  // Compute the strongly connected components and their nodes.
+  auto [offsets, adjacentNodes] = toAdjacencyLists(numNodes, edges);
+  uint32_t numComponents;
+  std::tie(graph.componentOfNode_, numComponents) =
+      computeComponents(offsets, adjacentNodes);
+  graph.componentOffsets_.assign(numComponents + 1, 0);
+  for (uint32_t component : graph.componentOfNode_) {
+    ++graph.componentOffsets_[component + 1];
+  }
+  for (size_t i = 0; i < numComponents; ++i) {
+    graph.componentOffsets_[i + 1] += graph.componentOffsets_[i];
+  }
+  graph.nodesOfComponent_.resize(numNodes);
+  std::vector<uint64_t> nextPosition(graph.componentOffsets_.begin(),
+                                     graph.componentOffsets_.end() - 1);
+  for (uint32_t node = 0; node < numNodes; ++node) {
+    graph.nodesOfComponent_[nextPosition[graph.componentOfNode_[node]]++] =
+        node;
+  }
+  graph.isCyclic_.resize(numComponents);
+  for (size_t i = 0; i < numComponents; ++i) {
+    graph.isCyclic_[i] =
+        graph.componentOffsets_[i + 1] - graph.componentOffsets_[i] > 1;
+  }
+
+  // Contract the components to get the DAG and its reverse.
+  std::vector<std::array<uint32_t, 2>> dagEdges;
+  for (const auto& [source, target] : edges) {
+    uint32_t sourceComponent = graph.componentOfNode_[source];
+    uint32_t targetComponent = graph.componentOfNode_[target];
+    if (sourceComponent == targetComponent) {
+      graph.isCyclic_[sourceComponent] |= source == target;
+    } else {
+      dagEdges.push_back({sourceComponent, targetComponent});
+    }
+  }
+  edges.clear();
+  edges.shrink_to_fit();
+  sortAndUnique(dagEdges);
+  auto [dagOffsets, dagTargets] = toAdjacencyLists(numComponents, dagEdges);
+  graph.forward_ = IntervalLabels::build(numComponents, dagOffsets, dagTargets);
+  for (auto& edge : dagEdges) {
+    std::swap(edge[0], edge[1]);
+  }
+  ql::ranges::sort(dagEdges);
+  std::tie(dagOffsets, dagTargets) = toAdjacencyLists(numComponents, dagEdges);
+  graph.backward_ =
+      IntervalLabels::build(numComponents, dagOffsets, dagTargets);
+  return graph;
+}
+
+// _____________________________________________________________________________
+std::optional<uint32_t> ReachabilityIndex::Graph::findNode(Id id) const {
+  auto it = ql::ranges::lower_bound(nodes_, id);
+  if (it == nodes_.end() || *it != id) {
+    return std::nullopt;
+  }
+  return static_cast<uint32_t>(it - nodes_.begin());
+}
+
+// _____________________________________________________________________________
+ad_utility::MemorySize ReachabilityIndex::Graph::sizeInMemory() const {
+  auto bytes = [](const auto& vec) {
+    using T = typename std::decay_t<decltype(vec)>::value_type;
+    return vec.size() * sizeof(T);
+  };
+  auto labelBytes = [&bytes](const IntervalLabels& labels) {
+    return bytes(labels.numberOfComponent_) + bytes(labels.componentOfNumber_) +
+           bytes(labels.offsets_) + bytes(labels.intervals_);
+  };
+  return ad_utility::MemorySize::bytes(
+      sizeof(Graph) + bytes(nodes_) + bytes(componentOfNode_) +
+      bytes(componentOffsets_) + bytes(nodesOfComponent_) + bytes(isCyclic_) +
+      labelBytes(forward_) + labelBytes(backward_));
+}
+
+// _____________________________________________________________________________
+bool ReachabilityIndex::Graph::isReachable(Id from, Id to, size_t minDist,
+                                           bool forward) const {
+  AD_CONTRACT_CHECK(minDist <= 1);
+  if (minDist == 0 && from == to) {
+    return true;
+  }
+  auto fromNode = findNode(from);
+  auto toNode = findNode(to);
+  if (!fromNode.has_value() || !toNode.has_value()) {
+    return false;
+  }
+  uint32_t fromComponent = componentOfNode_[fromNode.value()];
+  uint32_t toComponent = componentOfNode_[toNode.value()];
+  if (fromComponent == toComponent) {
+    return isCyclic_[fromComponent];
+  }
+  return (forward ? forward_ : backward_)
+      .isReachable(fromComponent, toComponent);
+}
+
+// _____________________________________________________________________________
+bool ReachabilityIndex::Graph::hasSuccessor(uint32_t component,
+                                            bool forward) const {
+  if (isCyclic_[component]) {
+    return true;
+  }
+  // The label of a component without successors only consists of the number
+  // of the component itself.
+  auto label = (forward ? forward_ : backward_).intervals(component);
+  return label.size() > 1 || label[0][0] != label[0][1];
+}
+
+// _____________________________________________________________________________
+bool ReachabilityIndex::Graph::hasSuccessor(Id node, bool forward) const {
+  auto index = findNode(node);
+  return index.has_value() &&
+         hasSuccessor(componentOfNode_[index.value()], forward);
+}
+
+// _____________________________________________________________________________
+std::vector<Id> ReachabilityIndex::Graph::nodesWithSuccessors(
+    bool forward) const {
+  std::vector<Id> result;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    if (hasSuccessor(componentOfNode_[i], forward)) {
+      result.push_back(nodes_[i]);
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+ReachabilityIndex::Builder::Builder(std::string filename,
+                                    std::vector<Id> predicates)
+    : filename_{std::move(filename)},
+      predicates_{std::move(predicates)},
+      edges_(predicates_.size()) {}
+
+// _____________________________________________________________________________
+void ReachabilityIndex::Builder::addTriple(Id subject, Id predicate,
+                                           Id object) {
+  if (predicate != lastPredicate_) {
+    lastPredicate_ = predicate;
+    auto it = ql::ranges::find(predicates_, predicate);
+    lastEdges_ = it == predicates_.end()
+                     ? nullptr
+                     : &edges_.at(it - predicates_.begin());
+  }
+  if (lastEdges_ != nullptr) {
+    lastEdges_->push_back({subject, object});
+  }
+}
+
+// _____________________________________________________________________________
+void ReachabilityIndex::Builder::finish() {
+  AD_LOG_INFO << "Building the reachability index for " << predicates_.size()
+              << " predicate(s) ..." << std::endl;
+  std::vector<Graph> graphs;
+  for (size_t i = 0; i < predicates_.size(); ++i) {
+    auto& edges = edges_[i];
+    std::vector<Id> sources;
+    std::vector<Id> targets;
+    sources.reserve(edges.size());
+    targets.reserve(edges.size());
+    for (const auto& [source, target] : edges) {
+      sources.push_back(source);
+      targets.push_back(target);
+    }
+    edges.clear();
+    edges.shrink_to_fit();
+    graphs.push_back(Graph::build(sources, targets));
+    const auto& graph = graphs.back();
+    AD_LOG_INFO << "Reachability index for predicate " << predicates_[i]
+                << ": " << graph.numNodes() << " nodes, "
+                << graph.numEdges() << " edges, " << graph.numComponents()
+                << " strongly connected components, "
+                << graph.numIntervals() << " intervals" << std::endl;
+  }
+  ad_utility::serialization::FileWriteSerializer serializer{filename_};
+  serializer << predicates_;
+  serializer << graphs;
+}
+
+// _____________________________________________________________________________
+void ReachabilityIndex::readFromFile(const std::string& filename) {
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  std::vector<Id> predicates;
+  std::vector<Graph> graphs;
+  serializer >> predicates;
+  serializer >> graphs;
+  AD_CORRECTNESS_CHECK(predicates.size() == graphs.size());
+  graphs_.clear();
+  for (size_t i = 0; i < predicates.size(); ++i) {
+    graphs_[predicates[i]] =
+        std::make_shared<const Graph>(std::move(graphs[i]));
+  }
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const ReachabilityIndex::Graph> ReachabilityIndex::getGraph(
+    Id predicate) const {
+  if (auto it = graphs_.find(predicate); it != graphs_.end()) {
+    return it->second;
+  }
+  return (*graphsOnDemand_.wlock())[predicate];
+}
+
+// _____________________________________________________________________________
+std::shared_ptr<const ReachabilityIndex::Graph> ReachabilityIndex::addGraph(
+    Id predicate, std::shared_ptr<Graph> graph,
+    ad_utility::MemorySize maxSize) const {
+  AD_CONTRACT_CHECK(graph != nullptr);
+  if (auto it = graphs_.find(predicate); it != graphs_.end()) {
+    return it->second;
+  }
+  auto graphs = graphsOnDemand_.wlock();
+  if (auto existingGraph = (*graphs)[predicate]) {
+    return existingGraph;
+  }
+  graphs->setMaxSize(maxSize);
+  graphs->insert(predicate, graph);
+  return graph;
+}
@@ -0,0 +1,240 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_REACHABILITYINDEX_H
+#define QLEVER_SRC_INDEX_REACHABILITYINDEX_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "backports/span.h"
+#include "global/Id.h"
+#include "util/Cache.h"
+#include "util/Exception.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Serializer/SerializeArrayOrTuple.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+#include "util/Synchronized.h"
+
+// A precomputed reachability structure for the graphs that are formed by the
+// triples of a few configured predicates (typically class hierarchies like
+// `rdfs:subClassOf` or `wdt:P279`). It is used by the `TransitivePath`
+// operation to answer paths like `?x wdt:P279* wd:Q5` by lookups instead of
+// a traversal of the graph.
+//
+// For each predicate, the strongly connected components of the graph are
+// contracted, which yields a DAG. Each component of this DAG gets a number
+// from a depth-first search (in post order), s.t. the components in the DFS
+// subtree of a component form a contiguous range of numbers that ends with
+// the number of the component itself. The label of a component is the
+// (sorted, disjoint) set of intervals of the numbers of all the components
+// that are reachable from it: the range of its DFS subtree plus the
+// "exceptions" that are only reachable via non-tree edges, see Agrawal et al.,
+// "Efficient management of transitive relationships in large data and
+// knowledge bases", SIGMOD 1989. For the typical hierarchies, which are
+// almost trees, the labels consist of very few intervals. The same labels are
+// also computed for the reversed DAG, so that paths can be followed in both
+// directions.
+//
+// The index is built for the configured predicates during the index build
+// (see `IndexImpl::setReachabilityIndexPredicates`) and kept in memory. The
+// graphs of other predicates can be added on demand at query time, they are
+// kept in an LRU cache of bounded size.
+class ReachabilityIndex {
+ public:
+  using Interval = std::array<uint32_t, 2>;
+
+  // The interval labels of the components of a DAG (see above).
+  struct IntervalLabels {
+    // The DFS post-order number of each component and the inverse mapping.
+    std::vector<uint32_t> numberOfComponent_;
+    std::vector<uint32_t> componentOfNumber_;
+    // The intervals of the component with the number `i` are
+    // `intervals_[offsets_[i]]` to `intervals_[offsets_[i + 1] - 1]`. The
+    // bounds of each interval are inclusive.
+    std::vector<uint64_t> offsets_;
+    std::vector<Interval> intervals_;
+
+    // Compute the labels for the DAG with `numComponents` components, the
+    // successors of component `c` are `targets[offsets[c]]` to
+    // `targets[offsets[c + 1] - 1]`.
+    static IntervalLabels build(size_t numComponents,
+                                const std::vector<uint64_t>& offsets,
+                                const std::vector<uint32_t>& targets);
+
+    // The intervals of the given component (not number).
+    ql::span<const Interval> intervals(uint32_t component) const;
+
+    // Return true iff `to` is reachable from `from` (both are components).
+    // Every component is reachable from itself.
+    bool isReachable(uint32_t from, uint32_t to) const;
+
+    AD_SERIALIZE_FRIEND_FUNCTION(IntervalLabels) {
+      serializer | arg.numberOfComponent_;
+      serializer | arg.componentOfNumber_;
+      serializer | arg.offsets_;
+      serializer | arg.intervals_;
+    }
+  };
+
+  // The reachability structure for the graph of a single predicate.
+  class Graph {
+   private:
+    // All nodes of the graph (the subjects and objects of the triples with
+    // the predicate), sorted.
+    std::vector<Id> nodes_;
+    // The strongly connected component of each node, and the (indices of
+    // the) nodes of each component in the order of `nodes_`.
+    std::vector<uint32_t> componentOfNode_;
+    std::vector<uint64_t> componentOffsets_;
+    std::vector<uint32_t> nodesOfComponent_;
+    // True for the components with a cycle, that is, with more than one node
+    // or with an edge from the only node to itself.
+    std::vector<uint8_t> isCyclic_;
+    IntervalLabels forward_;
+    IntervalLabels backward_;
+    size_t numEdges_ = 0;
+
+   public:
+    // Build the structure for the graph with the edges
+    // `sources[i] -> targets[i]`. The edges may contain duplicates.
+    static Graph build(ql::span<const Id> sources, ql::span<const Id> targets);
+
+    size_t numNodes() const { return nodes_.size(); }
+    size_t numEdges() const { return numEdges_; }
+    size_t numComponents() const { return isCyclic_.size(); }
+    size_t numIntervals() const {
+      return forward_.intervals_.size() + backward_.intervals_.size();
+    }
+
+    // The memory that is used by the structure.
+    ad_utility::MemorySize sizeInMemory() const;
+
+    // Return true iff there is a path from `from` to `to` with at least
+    // `minDist` edges, where `minDist` must be 0 or 1. If `forward` is false,
+    // the edges are followed in the reverse direction.
+    bool isReachable(Id from, Id to, size_t minDist, bool forward) const;
+
+    // Call `callback` for each node that can be reached from `from` via a
+    // path with at least `minDist` edges (which must be 0 or 1). For
+    // `minDist == 0`, this includes `from` itself, even if it is not a node
+    // of the graph.
+    template <typename F>
+    void forEachReachableNode(Id from, size_t minDist, bool forward,
+                              const F& callback) const {
+      AD_CONTRACT_CHECK(minDist <= 1);
+      auto node = findNode(from);
+      if (!node.has_value()) {
+        if (minDist == 0) {
+          callback(from);
+        }
+        return;
+      }
+      uint32_t component = componentOfNode_[node.value()];
+      const auto& labels = forward ? forward_ : backward_;
+      for (const auto& [first, last] : labels.intervals(component)) {
+        for (uint64_t number = first; number <= last; ++number) {
+          uint32_t other = labels.componentOfNumber_[number];
+          if (other == component && minDist > 0 && !isCyclic_[component]) {
+            continue;
+          }
+          for (uint64_t i = componentOffsets_[other];
+               i < componentOffsets_[other + 1]; ++i) {
+            callback(nodes_[nodesOfComponent_[i]]);
+          }
+        }
+      }
+    }
+
+    // Return true iff the `node` has at least one outgoing edge (incoming
+    // edge if `forward` is false).
+    bool hasSuccessor(Id node, bool forward) const;
+
+    // Return all nodes with at least one outgoing (incoming if `forward` is
+    // false) edge, sorted.
+    std::vector<Id> nodesWithSuccessors(bool forward) const;
+
+    AD_SERIALIZE_FRIEND_FUNCTION(Graph) {
+      serializer | arg.nodes_;
+      serializer | arg.componentOfNode_;
+      serializer | arg.componentOffsets_;
+      serializer | arg.nodesOfComponent_;
+      serializer | arg.isCyclic_;
+      serializer | arg.forward_;
+      serializer | arg.backward_;
+      serializer | arg.numEdges_;
+    }
+
+   private:
+    std::optional<uint32_t> findNode(Id id) const;
+    bool hasSuccessor(uint32_t component, bool forward) const;
+  };
+
+  // Collect the edges of the configured predicates from the triples, which
+  // are added one by one (preferably sorted by predicate) via `addTriple`,
+  // and write the index to `filename` when `finish` is called. The edges are
+  // kept in memory until then.
+  class Builder {
+   private:
+    std::string filename_;
+    std::vector<Id> predicates_;
+    std::vector<std::vector<std::array<Id, 2>>> edges_;
+    // The predicate of the last triple and its edges (`nullptr` if the
+    // predicate is not one of the `predicates_`).
+    std::optional<Id> lastPredicate_;
+    std::vector<std::array<Id, 2>>* lastEdges_ = nullptr;
+
+   public:
+    Builder(std::string filename, std::vector<Id> predicates);
+
+    void addTriple(Id subject, Id predicate, Id object);
+
+    // Build the structures for all the predicates and write them to the file.
+    void finish();
+  };
+
+ private:
+  using Graphs = ad_utility::HashMap<Id, std::shared_ptr<const Graph>>;
+  // The graphs that were built during the index build.
+  Graphs graphs_;
+  // The graphs that were built at query time, see `addGraph`.
+  struct GraphSizeGetter {
+    ad_utility::MemorySize operator()(const Graph& graph) const {
+      return graph.sizeInMemory();
+    }
+  };
+  using GraphCache = ad_utility::HeapBasedLRUCache<Id, Graph, GraphSizeGetter>;
+  mutable ad_utility::Synchronized<GraphCache> graphsOnDemand_{
+      std::numeric_limits<size_t>::max(), ad_utility::MemorySize::bytes(0)};
+
+ public:
+  // Read the index that was written by a `Builder` to `filename`.
+  void readFromFile(const std::string& filename);
+
+  size_t numPredicates() const { return graphs_.size(); }
+
+  // Return the graph of the `predicate`, or `nullptr` if there is none.
+  std::shared_ptr<const Graph> getGraph(Id predicate) const;
+
+  // Add a graph for the `predicate` that was built at query time. This has to
+  // be the graph of all the triples with the `predicate` in the index without
+  // any updates. If there already is a graph for the `predicate`, it is kept.
+  // The graphs that are added this way are kept in an LRU cache with the
+  // `maxSize` (the least recently used graphs are evicted to make room, a
+  // graph that is larger than `maxSize` is not stored at all). Return the
+  // graph for the `predicate` that is to be used by the caller.
+  std::shared_ptr<const Graph> addGraph(Id predicate,
+                                        std::shared_ptr<Graph> graph,
+                                        ad_utility::MemorySize maxSize) const;
+};
+
+#endif  // QLEVER_SRC_INDEX_REACHABILITYINDEX_H
@@ -0,0 +1,216 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/SpatialIndex.h"
+
+#include <absl/base/casts.h>
+
+#include <algorithm>
+#include <array>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+#include "util/Log.h"
+
+// _____________________________________________________________________________
+SpatialIndex::Box SpatialIndex::Box::fromBoundingBox(
+    const ad_utility::BoundingBox& boundingBox) {
+  return {boundingBox.lowerLeft().getLng(), boundingBox.lowerLeft().getLat(),
+          boundingBox.upperRight().getLng(), boundingBox.upperRight().getLat()};
+}
+
+// _____________________________________________________________________________
+SpatialIndex::Box SpatialIndex::Box::extend(const Box& other) const {
+  return {std::min(minLng_, other.minLng_), std::min(minLat_, other.minLat_),
+          std::max(maxLng_, other.maxLng_), std::max(maxLat_, other.maxLat_)};
+}
+
+// _____________________________________________________________________________
+uint64_t SpatialIndex::hilbertValue(const Box& box) {
+  static constexpr uint32_t gridSize = 1u << 16;
+  // Map a coordinate from `[min, max]` to a cell of the grid.
+  auto toCell = [](double coordinate, double min, double max) {
+    double relative = std::clamp((coordinate - min) / (max - min), 0.0, 1.0);
+    return std::min(static_cast<uint32_t>(relative * gridSize), gridSize - 1);
+  };
+  uint32_t x = toCell((box.minLng_ + box.maxLng_) / 2, -180, 180);
+  uint32_t y = toCell((box.minLat_ + box.maxLat_) / 2, -90, 90);
+
+  // The classic iterative conversion from cell coordinates to the distance
+  // along the Hilbert curve.
+  uint64_t result = 0;
+  for (uint32_t s = gridSize / 2; s > 0; s /= 2) {
+    uint32_t rx = (x & s) > 0;
+    uint32_t ry = (y & s) > 0;
+    result += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+    if (ry == 0) {
+      if (rx == 1) {
+        x = gridSize - 1 - x;
+        y = gridSize - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+SpatialIndex::Builder::Builder(std::string filename,
+                               ad_utility::MemorySize memory,
+                               ad_utility::AllocatorWithLimit<Id> allocator)
+    : filename_{std::move(filename)},
+      allocator_{std::move(allocator)},
+      sorter_{std::make_unique<Sorter>(filename_ + ".sort.tmp", memory,
+                                       allocator_)} {}
+
+// _____________________________________________________________________________
+void SpatialIndex::Builder::addGeometry(
+    VocabIndex index, const ad_utility::BoundingBox& boundingBox) {
+  auto box = Box::fromBoundingBox(boundingBox);
+  auto toId = [](double coordinate) {
+    return Id::fromBits(absl::bit_cast<uint64_t>(coordinate));
+  };
+  sorter_->push(std::array{Id::fromBits(hilbertValue(box)),
+                           Id::fromBits(index.get()), toId(box.minLng_),
+                           toId(box.minLat_), toId(box.maxLng_),
+                           toId(box.maxLat_)});
+}
+
+// _____________________________________________________________________________
+void SpatialIndex::Builder::finish() {
+  AD_LOG_INFO << "Writing the spatial index of the geometries ..."
+              << std::endl;
+  ad_utility::File file{filename_, "w"};
+  MetaData metaData;
+
+  // Write the leaves (level 0) and collect the bounding boxes of the leaves,
+  // which form level 1.
+  using Level = std::vector<Box, ad_utility::AllocatorWithLimit<Box>>;
+  Level level{allocator_};
+  std::vector<Entry> node;
+  node.reserve(NODE_SIZE);
+  size_t numGeometries = 0;
+  auto writeNode = [&file, &node, &level]() {
+    Box nodeBox = node.front().box_;
+    for (const auto& entry : node) {
+      nodeBox = nodeBox.extend(entry.box_);
+    }
+    level.push_back(nodeBox);
+    size_t numBytes = node.size() * sizeof(Entry);
+    AD_CORRECTNESS_CHECK(file.write(node.data(), numBytes) == numBytes);
+    node.clear();
+  };
+  for (const auto& row : sorter_->sortedView()) {
+    auto coordinate = [&row](size_t column) {
+      return absl::bit_cast<double>(row[column].getBits());
+    };
+    node.push_back(Entry{
+        Box{coordinate(2), coordinate(3), coordinate(4), coordinate(5)},
+        row[1].getBits()});
+    ++numGeometries;
+    if (node.size() == NODE_SIZE) {
+      writeNode();
+    }
+  }
+  if (!node.empty()) {
+    writeNode();
+  }
+  sorter_.reset();
+  metaData.levelOffsets_.push_back(0);
+  metaData.levelSizes_.push_back(numGeometries);
+  off_t offset = static_cast<off_t>(numGeometries * sizeof(Entry));
+
+  // Write the inner levels bottom-up until the level with the single root.
+  while (!level.empty()) {
+    size_t numBytes = level.size() * sizeof(Box);
+    AD_CORRECTNESS_CHECK(file.write(level.data(), numBytes) == numBytes);
+    metaData.levelOffsets_.push_back(offset);
+    metaData.levelSizes_.push_back(level.size());
+    offset += static_cast<off_t>(numBytes);
+    if (level.size() == 1) {
+      break;
+    }
+    Level nextLevel{allocator_};
+    for (size_t i = 0; i < level.size(); i += NODE_SIZE) {
+      Box nodeBox = level[i];
+      for (size_t j = i + 1; j < std::min(i + NODE_SIZE, level.size()); ++j) {
+        nodeBox = nodeBox.extend(level[j]);
+      }
+      nextLevel.push_back(nodeBox);
+    }
+    level = std::move(nextLevel);
+  }
+
+  ad_utility::serialization::FileWriteSerializer serializer{std::move(file)};
+  serializer << metaData;
+  file = std::move(serializer).file();
+  off_t startOfMeta = offset;
+  AD_CORRECTNESS_CHECK(file.write(&startOfMeta, sizeof(startOfMeta)) ==
+                       sizeof(startOfMeta));
+  file.close();
+  AD_LOG_INFO << "Number of geometries in the spatial index: "
+              << numGeometries << std::endl;
+}
+
+// _____________________________________________________________________________
+void SpatialIndex::readFromFile(const std::string& filename) {
+  file_.open(filename, "r");
+  off_t metaFrom;
+  [[maybe_unused]] off_t metaTo = file_.getLastOffset(&metaFrom);
+  ad_utility::serialization::FileReadSerializer serializer{std::move(file_)};
+  serializer.setSerializationPosition(metaFrom);
+  serializer >> metaData_;
+  file_ = std::move(serializer).file();
+  AD_CORRECTNESS_CHECK(metaData_.levelOffsets_.size() ==
+                       metaData_.levelSizes_.size());
+}
+
+// _____________________________________________________________________________
+void SpatialIndex::search(size_t level, size_t begin, size_t end,
+                          const Box& box,
+                          std::vector<VocabIndex>& result) const {
+  // Read the consecutive nodes `[begin, end)` of the `level` from disk.
+  auto readNodes = [this, level, begin, end](auto& nodes) {
+    using T = typename std::decay_t<decltype(nodes)>::value_type;
+    nodes.resize(end - begin);
+    size_t numBytes = nodes.size() * sizeof(T);
+    AD_CORRECTNESS_CHECK(
+        file_.read(nodes.data(), numBytes,
+                   metaData_.levelOffsets_.at(level) + begin * sizeof(T)) ==
+        static_cast<ssize_t>(numBytes));
+  };
+  if (level == 0) {
+    std::vector<Entry> entries;
+    readNodes(entries);
+    for (const auto& entry : entries) {
+      if (entry.box_.intersects(box)) {
+        result.push_back(VocabIndex::make(entry.vocabIndex_));
+      }
+    }
+    return;
+  }
+  std::vector<Box> boxes;
+  readNodes(boxes);
+  size_t numChildren = metaData_.levelSizes_.at(level - 1);
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    if (boxes[i].intersects(box)) {
+      size_t firstChild = (begin + i) * NODE_SIZE;
+      search(level - 1, firstChild,
+             std::min(firstChild + NODE_SIZE, numChildren), box, result);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+std::vector<VocabIndex> SpatialIndex::getIntersecting(const Box& box) const {
+  std::vector<VocabIndex> result;
+  if (numGeometries() == 0) {
+    return result;
+  }
+  size_t root = metaData_.levelSizes_.size() - 1;
+  search(root, 0, metaData_.levelSizes_.at(root), box, result);
+  ql::ranges::sort(result);
+  return result;
+}
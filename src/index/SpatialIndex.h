@@ -0,0 +1,141 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_SPATIALINDEX_H
+#define QLEVER_SRC_INDEX_SPATIALINDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "global/VocabIndex.h"
+#include "rdfTypes/GeometryInfo.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/File.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Serializer/Serializer.h"
+
+// A persistent, packed R-tree over the bounding boxes of all the geometries
+// (WKT literals) of a vocabulary with an underlying `GeoVocabulary`. It is
+// built once during the index build from the precomputed `GeometryInfo`s and
+// is then used to find all geometries whose bounding box intersects a given
+// box, without having to build a spatial index for each query.
+//
+// The tree is static: the geometries are sorted by the Hilbert value of the
+// centers of their bounding boxes and then packed into the leaves, each of
+// which holds `NODE_SIZE` geometries. Each level above consists of the
+// bounding boxes of `NODE_SIZE` consecutive nodes of the level below, until
+// a single root remains. The children of the `i`-th node of a level are thus
+// the nodes `[i * NODE_SIZE, (i + 1) * NODE_SIZE)` of the level below, and no
+// pointers have to be stored. All the levels are read from disk on demand.
+class SpatialIndex {
+ public:
+  static constexpr size_t NODE_SIZE = 16;
+
+  // An axis-aligned box in degrees (longitude and latitude).
+  struct Box {
+    double minLng_ = 0;
+    double minLat_ = 0;
+    double maxLng_ = 0;
+    double maxLat_ = 0;
+
+    static Box fromBoundingBox(const ad_utility::BoundingBox& boundingBox);
+
+    // Return the smallest box that contains `this` and `other`.
+    Box extend(const Box& other) const;
+
+    bool intersects(const Box& other) const {
+      return minLng_ <= other.maxLng_ && other.minLng_ <= maxLng_ &&
+             minLat_ <= other.maxLat_ && other.minLat_ <= maxLat_;
+    }
+
+    bool operator==(const Box&) const = default;
+  };
+
+  // A single geometry in the leaves of the tree.
+  struct Entry {
+    Box box_;
+    uint64_t vocabIndex_;
+  };
+  static_assert(std::is_trivially_copyable_v<Entry>);
+
+  // The layout of the levels of the tree in the file, level 0 are the
+  // `Entry`s, all the other levels consist of `Box`es.
+  struct MetaData {
+    std::vector<off_t> levelOffsets_;
+    std::vector<size_t> levelSizes_;
+
+    AD_SERIALIZE_FRIEND_FUNCTION(MetaData) {
+      serializer | arg.levelOffsets_;
+      serializer | arg.levelSizes_;
+    }
+  };
+
+  // Build the index from the geometries, which are added one by one (in any
+  // order) via `addGeometry`. The index is written to `filename` when `finish`
+  // is called.
+  class Builder {
+   private:
+    struct CompareByBits {
+      bool operator()(const auto& a, const auto& b) const {
+        return std::pair{a[0].getBits(), a[1].getBits()} <
+               std::pair{b[0].getBits(), b[1].getBits()};
+      }
+    };
+    // The columns are the Hilbert value, the `VocabIndex`, and the four
+    // coordinates of the bounding box (as the bits of the `double`s).
+    using Sorter =
+        ad_utility::CompressedExternalIdTableSorter<CompareByBits, 6>;
+
+    std::string filename_;
+    // Also used for the inner levels of the tree while they are written.
+    ad_utility::AllocatorWithLimit<Id> allocator_;
+    std::unique_ptr<Sorter> sorter_;
+
+   public:
+    Builder(std::string filename, ad_utility::MemorySize memory,
+            ad_utility::AllocatorWithLimit<Id> allocator);
+
+    void addGeometry(VocabIndex index,
+                     const ad_utility::BoundingBox& boundingBox);
+
+    // Sort the geometries, and write all the levels of the tree and the
+    // metadata to the file.
+    void finish();
+  };
+
+ private:
+  ad_utility::File file_;
+  MetaData metaData_;
+
+ public:
+  // Open the index that was written by a `Builder` to `filename`.
+  void readFromFile(const std::string& filename);
+
+  bool isLoaded() const { return file_.isOpen(); }
+
+  size_t numGeometries() const {
+    return metaData_.levelSizes_.empty() ? 0 : metaData_.levelSizes_.front();
+  }
+
+  // Return the sorted indices of all geometries whose bounding box intersects
+  // the `box`.
+  std::vector<VocabIndex> getIntersecting(const Box& box) const;
+
+  // Return the position of the center of the `box` on a Hilbert curve through
+  // a 2^16 x 2^16 grid over the whole world. Geometries that are close to
+  // each other typically have close Hilbert values.
+  static uint64_t hilbertValue(const Box& box);
+
+ private:
+  // Add the geometries in the subtrees of the nodes `[begin, end)` of the
+  // given `level` that intersect the `box` to the `result`.
+  void search(size_t level, size_t begin, size_t end, const Box& box,
+              std::vector<VocabIndex>& result) const;
+};
+
+#endif  // QLEVER_SRC_INDEX_SPATIALINDEX_H
@@ -22,6 +22,7 @@
 #include "util/Serializer/SerializePair.h"
 #include "util/Serializer/SerializeVector.h"
 #include "util/TypeTraits.h"
+#include "util/json.h"
 
 // Writes pairs of (partial ID, global ID) incrementally to a file.
 class IdMapWriter {
@@ -98,6 +99,20 @@ struct VocabularyMetaData {
     // Return true if the `id` belongs to this range.
     bool contains(Id id) const { return begin_ <= id && id < end_; }
 
+    // Conversion to and from JSON.
+    friend void to_json(nlohmann::json& j, const IdRangeForPrefix& range) {
+      j = nlohmann::json{{"prefix", range.prefix_},
+                         {"begin", range.begin_.getBits()},
+                         {"end", range.end_.getBits()},
+                         {"begin-was-seen", range.beginWasSeen_}};
+    }
+    friend void from_json(const nlohmann::json& j, IdRangeForPrefix& range) {
+      range.prefix_ = j.at("prefix").get<std::string>();
+      range.begin_ = Id::fromBits(j.at("begin").get<Id::T>());
+      range.end_ = Id::fromBits(j.at("end").get<Id::T>());
+      range.beginWasSeen_ = j.at("begin-was-seen").get<bool>();
+    }
+
    private:
     Id begin_ = Id::makeUndefined();
     Id end_ = Id::makeUndefined();
@@ -132,6 +147,10 @@ struct VocabularyMetaData {
     return res;
   }
 
+  // Let the indices of the blank nodes start at `index` instead of zero (for
+  // example, because there already are blank nodes with smaller indices).
+  void setNextBlankNodeIndex(size_t index) { numBlankNodesTotal_ = index; }
+
   // The mapping from the `qlever::specialIds` to their actual IDs.
   // This is created on the fly by the calls to `addWord`.
   const auto& specialIdMapping() const { return specialIdMapping_; }
@@ -150,6 +169,31 @@ struct VocabularyMetaData {
     return internalEntities_.contains(id) || langTaggedPredicates_.contains(id);
   }
 
+  // Conversion to and from JSON, which is used to resume an interrupted index
+  // build after the merge of the vocabulary.
+  friend void to_json(nlohmann::json& j, const VocabularyMetaData& metaData) {
+    j["num-words-total"] = metaData.numWordsTotal_;
+    j["num-blank-nodes-total"] = metaData.numBlankNodesTotal_;
+    j["lang-tagged-predicates"] = metaData.langTaggedPredicates_;
+    j["internal-entities"] = metaData.internalEntities_;
+    nlohmann::json specialIds = nlohmann::json::object();
+    for (const auto& [word, id] : metaData.specialIdMapping_) {
+      specialIds[word] = id.getBits();
+    }
+    j["special-id-mapping"] = std::move(specialIds);
+  }
+  friend void from_json(const nlohmann::json& j,
+                        VocabularyMetaData& metaData) {
+    metaData.numWordsTotal_ = j.at("num-words-total").get<size_t>();
+    metaData.numBlankNodesTotal_ = j.at("num-blank-nodes-total").get<size_t>();
+    j.at("lang-tagged-predicates").get_to(metaData.langTaggedPredicates_);
+    j.at("internal-entities").get_to(metaData.internalEntities_);
+    metaData.specialIdMapping_.clear();
+    for (const auto& [word, bits] : j.at("special-id-mapping").items()) {
+      metaData.specialIdMapping_[word] = Id::fromBits(bits.get<Id::T>());
+    }
+  }
+
  private:
   // The number of distinct words (size of the created vocabulary).
   size_t numWordsTotal_ = 0;
@@ -173,10 +217,11 @@ struct VocabularyMetaData {
 // language tagged predicates. Argument `comparator` gives the way to order
 // strings (case-sensitive or not). Argument `wordCallback`
 // is called for each merged word in the vocabulary in the order of their
-// appearance.
+// appearance. The indices of the blank nodes start at `firstBlankNodeIndex`.
 template <typename W, typename C>
 auto mergeVocabulary(const std::string& basename, size_t numFiles, W comparator,
-                     C& wordCallback, ad_utility::MemorySize memoryToUse)
+                     C& wordCallback, ad_utility::MemorySize memoryToUse,
+                     size_t firstBlankNodeIndex = 0)
     -> CPP_ret(VocabularyMetaData)(
         requires WordComparator<W>&& WordCallback<C>);
 
@@ -199,7 +244,8 @@ class VocabularyMerger {
   template <typename W, typename C>
   friend auto mergeVocabulary(const std::string& basename, size_t numFiles,
                               W comparator, C& wordCallback,
-                              ad_utility::MemorySize memoryToUse)
+                              ad_utility::MemorySize memoryToUse,
+                              size_t firstBlankNodeIndex)
       -> CPP_ret(VocabularyMetaData)(
           requires WordComparator<W>&& WordCallback<C>);
   VocabularyMerger() = default;
@@ -210,7 +256,8 @@ class VocabularyMerger {
   template <typename W, typename C>
   auto mergeVocabulary(const std::string& basename, size_t numFiles,
                        W comparator, C& wordCallback,
-                       ad_utility::MemorySize memoryToUse)
+                       ad_utility::MemorySize memoryToUse,
+                       size_t firstBlankNodeIndex)
       -> CPP_ret(VocabularyMetaData)(
           requires WordComparator<W>&& WordCallback<C>);
 
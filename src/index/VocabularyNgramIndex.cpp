@@ -0,0 +1,297 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/VocabularyNgramIndex.h"
+
+#include <re2/filtered_re2.h>
+#include <re2/re2.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+#include "util/Log.h"
+#include "util/Simple8bCode.h"
+
+namespace {
+// A posting list is only intersected with the candidates if it has at most
+// this many elements per candidate. Decoding a longer posting list is more
+// expensive than checking the additional candidates, which the caller has to
+// do anyway, and would require memory that is not bounded by the number of
+// candidates.
+constexpr size_t maxPostingListSizePerCandidate = 32;
+
+// Lowercase ASCII letters and keep all other bytes (in particular the bytes
+// of multi-byte UTF-8 characters) as they are.
+constexpr uint8_t toLowerAscii(char c) {
+  auto byte = static_cast<uint8_t>(c);
+  return byte >= 'A' && byte <= 'Z' ? byte + ('a' - 'A') : byte;
+}
+
+// Write the gap-encoded and Simple8b-compressed `postingList` to the `file`
+// at the `offset` and return its metadata.
+VocabularyNgramIndex::PostingListMetaData writePostingList(
+    VocabularyNgramIndex::Trigram trigram, std::vector<uint64_t>& postingList,
+    ad_utility::File& file, off_t& offset) {
+  VocabularyNgramIndex::PostingListMetaData metaData{
+      trigram, postingList.size(), offset, 0};
+  for (size_t i = postingList.size() - 1; i > 0; --i) {
+    postingList[i] -= postingList[i - 1];
+  }
+  std::vector<uint64_t> encoded(postingList.size());
+  metaData.numBytes_ = ad_utility::Simple8bCode::encode(
+      postingList.data(), postingList.size(), encoded.data());
+  AD_CORRECTNESS_CHECK(file.write(encoded.data(), metaData.numBytes_) ==
+                       metaData.numBytes_);
+  offset += metaData.numBytes_;
+  postingList.clear();
+  return metaData;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+VocabularyNgramIndex::Builder::Builder(
+    std::string filename, ad_utility::MemorySize memory,
+    ad_utility::AllocatorWithLimit<Id> allocator)
+    : filename_{std::move(filename)},
+      sorter_{std::make_unique<Sorter>(filename_ + ".sort.tmp", memory,
+                                       std::move(allocator))} {}
+
+// _____________________________________________________________________________
+void VocabularyNgramIndex::Builder::addWord(std::string_view word,
+                                            uint64_t index) {
+  trigramBuffer_ = getTrigrams(word);
+  for (Trigram trigram : trigramBuffer_) {
+    sorter_->push(std::array{Id::fromBits(trigram), Id::fromBits(index)});
+  }
+}
+
+// _____________________________________________________________________________
+void VocabularyNgramIndex::Builder::finish() {
+  AD_LOG_INFO << "Writing the trigram index of the vocabulary ..."
+              << std::endl;
+  ad_utility::File file{filename_, "w"};
+  off_t offset = 0;
+  std::vector<PostingListMetaData> postingLists;
+  std::vector<uint64_t> postingList;
+  Trigram currentTrigram = 0;
+  for (const auto& row : sorter_->sortedView()) {
+    auto trigram = static_cast<Trigram>(row[0].getBits());
+    if (trigram != currentTrigram && !postingList.empty()) {
+      postingLists.push_back(
+          writePostingList(currentTrigram, postingList, file, offset));
+    }
+    currentTrigram = trigram;
+    postingList.push_back(row[1].getBits());
+  }
+  if (!postingList.empty()) {
+    postingLists.push_back(
+        writePostingList(currentTrigram, postingList, file, offset));
+  }
+  sorter_.reset();
+
+  ad_utility::serialization::FileWriteSerializer serializer{std::move(file)};
+  serializer << postingLists;
+  file = std::move(serializer).file();
+  off_t startOfMeta = offset;
+  file.write(&startOfMeta, sizeof(startOfMeta));
+  file.close();
+  AD_LOG_INFO << "Number of distinct trigrams in the vocabulary: "
+              << postingLists.size() << std::endl;
+}
+
+// _____________________________________________________________________________
+void VocabularyNgramIndex::readFromFile(const std::string& filename) {
+  file_.open(filename, "r");
+  off_t metaFrom;
+  [[maybe_unused]] off_t metaTo = file_.getLastOffset(&metaFrom);
+  ad_utility::serialization::FileReadSerializer serializer{std::move(file_)};
+  serializer.setSerializationPosition(metaFrom);
+  serializer >> postingLists_;
+  file_ = std::move(serializer).file();
+  AD_CORRECTNESS_CHECK(ql::ranges::is_sorted(
+      postingLists_, std::less{}, &PostingListMetaData::trigram_));
+}
+
+// _____________________________________________________________________________
+std::vector<VocabularyNgramIndex::Trigram> VocabularyNgramIndex::getTrigrams(
+    std::string_view word) {
+  std::vector<Trigram> trigrams;
+  if (word.size() < NGRAM_LENGTH) {
+    return trigrams;
+  }
+  trigrams.reserve(word.size() - NGRAM_LENGTH + 1);
+  for (size_t i = 0; i + NGRAM_LENGTH <= word.size(); ++i) {
+    trigrams.push_back(static_cast<Trigram>(toLowerAscii(word[i])) << 16 |
+                       static_cast<Trigram>(toLowerAscii(word[i + 1])) << 8 |
+                       static_cast<Trigram>(toLowerAscii(word[i + 2])));
+  }
+  ql::ranges::sort(trigrams);
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()),
+                 trigrams.end());
+  return trigrams;
+}
+
+// _____________________________________________________________________________
+std::vector<uint64_t> VocabularyNgramIndex::readPostingList(
+    const PostingListMetaData& metaData) const {
+  std::vector<uint64_t> encoded(metaData.numBytes_ / sizeof(uint64_t));
+  AD_CORRECTNESS_CHECK(
+      file_.read(encoded.data(), metaData.numBytes_, metaData.offset_) ==
+      static_cast<ssize_t>(metaData.numBytes_));
+  // The Simple8b decoding requires some additional space at the end.
+  std::vector<uint64_t> postingList(metaData.numElements_ + 250);
+  ad_utility::Simple8bCode::decode(encoded.data(), metaData.numElements_,
+                                   postingList.data());
+  postingList.resize(metaData.numElements_);
+  for (size_t i = 1; i < postingList.size(); ++i) {
+    postingList[i] += postingList[i - 1];
+  }
+  return postingList;
+}
+
+// _____________________________________________________________________________
+std::vector<const VocabularyNgramIndex::PostingListMetaData*>
+VocabularyNgramIndex::getPostingLists(
+    const std::vector<Trigram>& trigrams) const {
+  AD_CONTRACT_CHECK(!trigrams.empty());
+  std::vector<const PostingListMetaData*> metaData;
+  for (Trigram trigram : trigrams) {
+    auto it = ql::ranges::lower_bound(postingLists_, trigram, std::less{},
+                                      &PostingListMetaData::trigram_);
+    if (it == postingLists_.end() || it->trigram_ != trigram) {
+      return {};
+    }
+    metaData.push_back(&*it);
+  }
+  ql::ranges::sort(metaData, std::less{}, &PostingListMetaData::numElements_);
+  return metaData;
+}
+
+// _____________________________________________________________________________
+size_t VocabularyNgramIndex::maxSizeOfIntersection(
+    const std::vector<const PostingListMetaData*>& postingLists) {
+  return postingLists.empty() ? 0 : postingLists.front()->numElements_;
+}
+
+// _____________________________________________________________________________
+std::vector<uint64_t> VocabularyNgramIndex::intersectPostingLists(
+    const std::vector<const PostingListMetaData*>& postingLists) const {
+  if (postingLists.empty()) {
+    return {};
+  }
+  // Start with the shortest posting lists to keep the intermediate results
+  // small.
+  auto result = readPostingList(*postingLists.front());
+  std::vector<uint64_t> intersection;
+  for (size_t i = 1; i < postingLists.size() && !result.empty(); ++i) {
+    // The posting lists are sorted by their size, so all the remaining lists
+    // are also too long.
+    if (postingLists[i]->numElements_ >
+        maxPostingListSizePerCandidate * result.size()) {
+      break;
+    }
+    auto postingList = readPostingList(*postingLists[i]);
+    intersection.clear();
+    std::set_intersection(result.begin(), result.end(), postingList.begin(),
+                          postingList.end(), std::back_inserter(intersection));
+    std::swap(result, intersection);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<std::vector<VocabIndex>>
+VocabularyNgramIndex::getCandidatesForSubstring(
+    std::string_view substring, size_t maxNumCandidates) const {
+  auto trigrams = getTrigrams(substring);
+  if (trigrams.empty()) {
+    return std::nullopt;
+  }
+  auto postingLists = getPostingLists(trigrams);
+  if (maxSizeOfIntersection(postingLists) > maxNumCandidates) {
+    return std::nullopt;
+  }
+  auto indices = intersectPostingLists(postingLists);
+  std::vector<VocabIndex> result;
+  result.reserve(indices.size());
+  for (uint64_t index : indices) {
+    result.push_back(VocabIndex::make(index));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<std::vector<VocabIndex>>
+VocabularyNgramIndex::getCandidatesForRegex(const std::string& regex,
+                                            size_t maxNumCandidates) const {
+  // The `FilteredRE2` computes the "atoms" of the regex (lowercased literal
+  // strings with at least `NGRAM_LENGTH` characters), such that each match of
+  // the regex contains at least one of the atoms (unless the regex is
+  // "unfiltered", in which case it can match without any of its atoms).
+  re2::FilteredRE2 filter{static_cast<int>(NGRAM_LENGTH)};
+  int id;
+  if (filter.Add(regex, RE2::Options{RE2::Quiet}, &id) != RE2::NoError) {
+    return std::nullopt;
+  }
+  std::vector<std::string> atoms;
+  filter.Compile(&atoms);
+  std::vector<int> unfiltered;
+  filter.AllPotentials({}, &unfiltered);
+  if (!unfiltered.empty() || atoms.empty()) {
+    return std::nullopt;
+  }
+
+  // The atoms are lowercased by RE2 according to Unicode, but the words of
+  // the index are only lowercased for ASCII letters, so we only use the
+  // trigrams that consist of ASCII characters. In case-insensitive regexes,
+  // `k` also matches the Kelvin sign and `s` also matches the long s, which
+  // are both non-ASCII, so the trigrams with these letters are also skipped.
+  bool mightBeCaseInsensitive = regex.find("(?") != std::string::npos;
+  auto isUsable = [mightBeCaseInsensitive](Trigram trigram) {
+    for (size_t shift : {0u, 8u, 16u}) {
+      auto byte = static_cast<uint8_t>(trigram >> shift);
+      if (byte >= 0x80 ||
+          (mightBeCaseInsensitive && (byte == 'k' || byte == 's'))) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // The candidates are the union of the candidates of the atoms, so their
+  // number is bounded by the sum of the bounds for the atoms. This bound is
+  // checked before any posting list is read.
+  std::vector<std::vector<const PostingListMetaData*>> postingListsOfAtoms;
+  size_t maxSizeOfUnion = 0;
+  for (const auto& atom : atoms) {
+    auto trigrams = getTrigrams(atom);
+    std::erase_if(trigrams, [&](Trigram t) { return !isUsable(t); });
+    if (trigrams.empty()) {
+      // This atom can't be looked up, so all words are candidates.
+      return std::nullopt;
+    }
+    postingListsOfAtoms.push_back(getPostingLists(trigrams));
+    maxSizeOfUnion += maxSizeOfIntersection(postingListsOfAtoms.back());
+    if (maxSizeOfUnion > maxNumCandidates) {
+      return std::nullopt;
+    }
+  }
+  std::vector<uint64_t> indices;
+  for (const auto& postingLists : postingListsOfAtoms) {
+    auto atomIndices = intersectPostingLists(postingLists);
+    indices.insert(indices.end(), atomIndices.begin(), atomIndices.end());
+  }
+  ql::ranges::sort(indices);
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  std::vector<VocabIndex> result;
+  result.reserve(indices.size());
+  for (uint64_t index : indices) {
+    result.push_back(VocabIndex::make(index));
+  }
+  return result;
+}
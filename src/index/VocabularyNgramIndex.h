@@ -0,0 +1,143 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_VOCABULARYNGRAMINDEX_H
+#define QLEVER_SRC_INDEX_VOCABULARYNGRAMINDEX_H
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "engine/idTable/CompressedExternalIdTable.h"
+#include "global/VocabIndex.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/File.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Serializer/Serializer.h"
+
+// An inverted index from the trigrams (sequences of three consecutive bytes)
+// of the words of the vocabulary to the indices of the words in which they
+// occur. It is used to evaluate string filters like `CONTAINS`, `STRSTARTS`
+// and `REGEX` against the vocabulary: all words that match a filter must
+// contain all the trigrams of the (literal parts of the) pattern, so only the
+// (typically few) candidates obtained by intersecting the posting lists of
+// these trigrams have to be checked.
+//
+// The trigrams are case-insensitive for ASCII letters (all ASCII letters are
+// lowercased, the other bytes are kept as is), because `REGEX` patterns might
+// be case-insensitive. The posting lists are gap-encoded and compressed using
+// the Simple8b code (like the posting lists of the text index).
+class VocabularyNgramIndex {
+ public:
+  using Trigram = uint32_t;
+  static constexpr size_t NGRAM_LENGTH = 3;
+
+  // The location of the posting list of a single trigram in the file.
+  struct PostingListMetaData {
+    Trigram trigram_ = 0;
+    size_t numElements_ = 0;
+    off_t offset_ = 0;
+    size_t numBytes_ = 0;
+
+    AD_SERIALIZE_FRIEND_FUNCTION(PostingListMetaData) {
+      serializer | arg.trigram_;
+      serializer | arg.numElements_;
+      serializer | arg.offset_;
+      serializer | arg.numBytes_;
+    }
+  };
+
+  // Build the index for the words of a vocabulary, which are added one by one
+  // (in any order) via `addWord`. The index is written to `filename` when
+  // `finish` is called.
+  class Builder {
+   private:
+    struct CompareByBits {
+      bool operator()(const auto& a, const auto& b) const {
+        return std::pair{a[0].getBits(), a[1].getBits()} <
+               std::pair{b[0].getBits(), b[1].getBits()};
+      }
+    };
+    using Sorter =
+        ad_utility::CompressedExternalIdTableSorter<CompareByBits, 2>;
+
+    std::string filename_;
+    std::unique_ptr<Sorter> sorter_;
+    std::vector<Trigram> trigramBuffer_;
+
+   public:
+    Builder(std::string filename, ad_utility::MemorySize memory,
+            ad_utility::AllocatorWithLimit<Id> allocator);
+
+    // Add the word with the given `index` to the index.
+    void addWord(std::string_view word, uint64_t index);
+
+    // Sort the trigrams and write the posting lists and the metadata to the
+    // file.
+    void finish();
+  };
+
+ private:
+  ad_utility::File file_;
+  // The metadata of the posting lists, sorted by the trigram.
+  std::vector<PostingListMetaData> postingLists_;
+
+ public:
+  // Open the index that was written by a `Builder` to `filename`.
+  void readFromFile(const std::string& filename);
+
+  bool isLoaded() const { return file_.isOpen(); }
+  size_t numTrigrams() const { return postingLists_.size(); }
+
+  // Return the sorted indices of all the words that contain the `substring`
+  // (and possibly some more words, which have to be checked by the caller).
+  // Return `std::nullopt` if the `substring` is too short to be looked up, or
+  // if there might be more than `maxNumCandidates` candidates. The latter is
+  // decided from the sizes of the posting lists before any of them is read.
+  std::optional<std::vector<VocabIndex>> getCandidatesForSubstring(
+      std::string_view substring,
+      size_t maxNumCandidates = std::numeric_limits<size_t>::max()) const;
+
+  // Same as `getCandidatesForSubstring`, but for all the words that contain a
+  // (partial) match of the RE2 `regex`. Return `std::nullopt` if the regex can
+  // match words that don't contain any sufficiently long literal part, for
+  // example `a|b` or `.*`.
+  std::optional<std::vector<VocabIndex>> getCandidatesForRegex(
+      const std::string& regex,
+      size_t maxNumCandidates = std::numeric_limits<size_t>::max()) const;
+
+  // Return the sorted and distinct trigrams of the `word`, with all ASCII
+  // letters lowercased.
+  static std::vector<Trigram> getTrigrams(std::string_view word);
+
+ private:
+  // Return the metadata of the posting lists of the `trigrams` (which must not
+  // be empty), sorted by their number of elements. If one of the `trigrams`
+  // doesn't occur in any word, the result is empty.
+  std::vector<const PostingListMetaData*> getPostingLists(
+      const std::vector<Trigram>& trigrams) const;
+
+  // Return an upper bound for the size of the intersection of the
+  // `postingLists` (as returned by `getPostingLists`).
+  static size_t maxSizeOfIntersection(
+      const std::vector<const PostingListMetaData*>& postingLists);
+
+  // Return the sorted indices of the words that contain all the trigrams of
+  // the `postingLists` (as returned by `getPostingLists`). Posting lists that
+  // are much longer than the intersection of the shorter ones are not read,
+  // so the result might also contain some words without these trigrams.
+  std::vector<uint64_t> intersectPostingLists(
+      const std::vector<const PostingListMetaData*>& postingLists) const;
+
+  // Read the posting list of a single trigram.
+  std::vector<uint64_t> readPostingList(
+      const PostingListMetaData& metaData) const;
+};
+
+#endif  // QLEVER_SRC_INDEX_VOCABULARYNGRAMINDEX_H
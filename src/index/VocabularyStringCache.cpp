@@ -0,0 +1,90 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/VocabularyStringCache.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "backports/algorithm.h"
+
+// _____________________________________________________________________________
+VocabularyStringCache::VocabularyStringCache(ad_utility::MemorySize maxSize)
+    : cache_{std::numeric_limits<size_t>::max(), maxSize} {}
+
+// _____________________________________________________________________________
+void VocabularyStringCache::setMaxSize(ad_utility::MemorySize maxSize) {
+  cache_.wlock()->setMaxSize(maxSize);
+}
+
+// _____________________________________________________________________________
+void VocabularyStringCache::clear() { cache_.wlock()->clearAll(); }
+
+// _____________________________________________________________________________
+size_t VocabularyStringCache::numEntries() const {
+  return cache_.rlock()->numNonPinnedEntries();
+}
+
+// _____________________________________________________________________________
+void VocabularyStringCache::sortAndDeduplicate(
+    std::vector<VocabIndex>& indices) {
+  ql::ranges::sort(indices);
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
+// _____________________________________________________________________________
+auto VocabularyStringCache::resolveWithoutCache(
+    std::vector<VocabIndex> indices,
+    const std::function<std::string(VocabIndex)>& lookup) -> Batch {
+  sortAndDeduplicate(indices);
+  Batch batch;
+  batch.words_.reserve(indices.size());
+  for (auto index : indices) {
+    batch.words_.emplace(index.get(),
+                         std::make_shared<const std::string>(lookup(index)));
+  }
+  return batch;
+}
+
+// _____________________________________________________________________________
+auto VocabularyStringCache::resolve(
+    std::vector<VocabIndex> indices,
+    const std::function<std::string(VocabIndex)>& lookup) -> Batch {
+  sortAndDeduplicate(indices);
+
+  Batch batch;
+  batch.words_.reserve(indices.size());
+  std::vector<VocabIndex> misses;
+  {
+    auto cache = cache_.wlock();
+    for (auto index : indices) {
+      if (auto word = (*cache)[index.get()]) {
+        batch.words_.emplace(index.get(), std::move(word));
+      } else {
+        misses.push_back(index);
+      }
+    }
+  }
+
+  // The `misses` are sorted, so the words are read in the order in which they
+  // are stored in the vocabulary.
+  std::vector<std::shared_ptr<std::string>> missingWords;
+  missingWords.reserve(misses.size());
+  for (auto index : misses) {
+    missingWords.push_back(std::make_shared<std::string>(lookup(index)));
+  }
+
+  auto cache = cache_.wlock();
+  for (size_t i = 0; i < misses.size(); ++i) {
+    auto key = misses[i].get();
+    // Another thread might have added the same word concurrently. If the word
+    // doesn't fit into the cache, it is still part of the `batch`.
+    if (!cache->contains(key)) {
+      cache->insert(key, missingWords[i]);
+    }
+    batch.words_.emplace(key, std::move(missingWords[i]));
+  }
+  return batch;
+}
@@ -0,0 +1,90 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_VOCABULARYSTRINGCACHE_H
+#define QLEVER_SRC_INDEX_VOCABULARYSTRINGCACHE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "global/VocabIndex.h"
+#include "util/Cache.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+#include "util/ValueSizeGetters.h"
+
+// A size-bounded LRU cache for the words of the vocabulary of an `Index`,
+// which is shared by all the exports of query results. For compressed and
+// on-disk vocabularies, each lookup requires a random read and/or a
+// decompression, and in large results the same (popular) words typically
+// occur many times.
+//
+// The words are resolved in batches (typically all the `VocabIndex`es of a
+// block of a result): the distinct indices are sorted and looked up in the
+// cache, and the remaining words are read from the vocabulary in increasing
+// order of their index, which is also the order in which they are stored on
+// disk (so the read-ahead of the operating system is effective). The batches
+// can also be resolved without a cache, see `resolveWithoutCache`.
+class VocabularyStringCache {
+ public:
+  using Word = std::shared_ptr<const std::string>;
+
+  // The words of a batch of `VocabIndex`es.
+  class Batch {
+   private:
+    ad_utility::HashMap<uint64_t, Word> words_;
+    friend class VocabularyStringCache;
+
+   public:
+    // Return the word for the `index`, or `nullptr` if the `index` is not
+    // part of the batch.
+    const std::string* find(VocabIndex index) const {
+      auto it = words_.find(index.get());
+      return it == words_.end() ? nullptr : it->second.get();
+    }
+    size_t size() const { return words_.size(); }
+  };
+
+ private:
+  using Cache = ad_utility::LRUCache<uint64_t, std::string,
+                                     ad_utility::DefaultValueSizeGetter<
+                                         std::string>>;
+  ad_utility::Synchronized<Cache> cache_;
+
+ public:
+  // Create a cache that holds words with a total size of at most `maxSize`.
+  explicit VocabularyStringCache(ad_utility::MemorySize maxSize);
+
+  // Change the maximal total size of the cached words. Words that don't fit
+  // anymore are evicted.
+  void setMaxSize(ad_utility::MemorySize maxSize);
+
+  // Remove all the cached words.
+  void clear();
+
+  size_t numEntries() const;
+
+  // Return the words for the `indices` (which may contain duplicates). Words
+  // that are not cached are obtained from `lookup` (in increasing order of
+  // their index) and then added to the cache. The `lookup` is not called while
+  // the cache is locked, so concurrent batches don't block each other.
+  Batch resolve(std::vector<VocabIndex> indices,
+                const std::function<std::string(VocabIndex)>& lookup);
+
+  // Like `resolve`, but without a cache: each distinct word of the `indices` is
+  // obtained from `lookup` once, in increasing order of its index.
+  static Batch resolveWithoutCache(
+      std::vector<VocabIndex> indices,
+      const std::function<std::string(VocabIndex)>& lookup);
+
+ private:
+  // Sort the `indices` and remove the duplicates.
+  static void sortAndDeduplicate(std::vector<VocabIndex>& indices);
+};
+
+#endif  // QLEVER_SRC_INDEX_VOCABULARYSTRINGCACHE_H
@@ -6,6 +6,8 @@
 
 #include "libqlever/Qlever.h"
 
+#include <filesystem>
+
 #include "engine/ExportQueryExecutionTrees.h"
 #include "index/IndexImpl.h"
 #include "index/TextIndexBuilder.h"
@@ -73,26 +75,79 @@ void Qlever::buildIndex(IndexBuilderConfig config) {
   index.setSettingsFile(config.settingsFile_);
   index.loadAllPermutations() = !config.onlyPsoAndPos_;
   index.getImpl().setVocabularyTypeForIndexBuilding(config.vocabType_);
+  index.getImpl().setBuildVocabularyNgramIndex(
+      config.buildVocabularyNgramIndex_);
+  index.getImpl().setBuildSpatialIndex(config.buildSpatialIndex_);
+  index.getImpl().setReachabilityIndexPredicates(
+      config.reachabilityIndexPredicates_);
   index.getImpl().setPrefixesForEncodedValues(config.prefixesForIdEncodedIris_);
+  if (config.numThreadsIndexBuilding_.has_value()) {
+    index.getImpl().setNumThreadsIndexBuilding(
+        config.numThreadsIndexBuilding_.value());
+  }
+  index.getImpl().setBuildPermutationPairsInParallel(
+      config.buildPermutationPairsInParallel_);
+  index.getImpl().setExistingIndexForIncrementalBuild(
+      config.existingIndexBaseName_);
+  index.getImpl().setResumeIndexBuild(config.resume_);
+  bool buildTextIndex =
+      config.wordsAndDocsFileSpecified() || config.addWordsFromLiterals_;
+  // With a text index, the checkpoint of the index build is only removed after
+  // the text index is built, s.t. a resumed build doesn't repeat it.
+  index.getImpl().setKeepIndexBuildCheckpoint(buildTextIndex);
 
   // Build text index if requested (various options).
+  IndexBuildCheckpoint* checkpoint = nullptr;
   if (!config.onlyAddTextIndex_) {
     AD_CONTRACT_CHECK(!config.inputFiles_.empty());
     index.createFromFiles(config.inputFiles_);
+    if (buildTextIndex) {
+      checkpoint = &index.getImpl().indexBuildCheckpoint();
+    }
   }
 
-  if (config.wordsAndDocsFileSpecified() || config.addWordsFromLiterals_) {
+  if (buildTextIndex) {
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
-    auto textIndexBuilder = TextIndexBuilder(
-        ad_utility::makeUnlimitedAllocator<Id>(), index.getOnDiskBase());
-    textIndexBuilder.buildTextIndexFile(
-        config.wordsAndDocsFileSpecified()
-            ? std::optional{std::pair{config.wordsfile_, config.docsfile_}}
-            : std::nullopt,
-        config.addWordsFromLiterals_, config.textScoringMetric_,
-        {config.bScoringParam_, config.kScoringParam_});
-    if (!config.docsfile_.empty()) {
-      textIndexBuilder.buildDocsDB(config.docsfile_);
+    using enum IndexBuildStage;
+    // The options of the text index are not part of the settings of the
+    // checkpoint, so they are compared separately.
+    nlohmann::json textIndexOptions{
+        {"wordsfile", config.wordsfile_},
+        {"docsfile", config.docsfile_},
+        {"add-words-from-literals", config.addWordsFromLiterals_},
+        {"text-scoring-metric",
+         getTextScoringMetricAsString(config.textScoringMetric_)},
+        {"b", config.bScoringParam_},
+        {"k", config.kScoringParam_}};
+    if (checkpoint != nullptr && checkpoint->isFinished(TextIndex) &&
+        checkpoint->getData(TextIndex) == textIndexOptions) {
+      AD_LOG_INFO << "The text index was already built by the previous index "
+                     "build"
+                  << std::endl;
+    } else {
+      auto textIndexBuilder = TextIndexBuilder(
+          ad_utility::makeUnlimitedAllocator<Id>(), index.getOnDiskBase());
+      textIndexBuilder.buildTextIndexFile(
+          config.wordsAndDocsFileSpecified()
+              ? std::optional{std::pair{config.wordsfile_, config.docsfile_}}
+              : std::nullopt,
+          config.addWordsFromLiterals_, config.textScoringMetric_,
+          {config.bScoringParam_, config.kScoringParam_});
+      if (!config.docsfile_.empty()) {
+        textIndexBuilder.buildDocsDB(config.docsfile_);
+      }
+      if (checkpoint != nullptr) {
+        const auto& base = index.getOnDiskBase();
+        std::vector<std::string> files{base + ".text.index",
+                                       base + ".text.vocabulary"};
+        if (!config.docsfile_.empty()) {
+          files.push_back(base + ".text.docsDB");
+        }
+        checkpoint->markFinished(TextIndex, files, std::move(textIndexOptions));
+      }
+    }
+    if (checkpoint != nullptr) {
+      checkpoint->remove();
     }
 #else
     throw std::runtime_error(
@@ -187,6 +242,40 @@ void IndexBuilderConfig::validate() const {
         "text index. If none are given the option to add words from literals "
         "has to be true. For details see --help."));
   }
+  if (resume_ && onlyAddTextIndex_) {
+    throw std::invalid_argument(
+        "An index build can only be resumed if the RDF index is built, not "
+        "when only a text index is added");
+  }
+  if (existingIndexBaseName_.has_value() &&
+      existingIndexBaseName_.value() == baseName_) {
+    throw std::invalid_argument(
+        "The existing index for an incremental index build must have a "
+        "different basename than the index that is built");
+  }
+  // The OSP/OPS and PSO/POS permutations store the pattern of each subject,
+  // which changes with the new triples.
+  if (existingIndexBaseName_.has_value() && !noPatterns_) {
+    throw std::invalid_argument(
+        "An incremental index build is only possible without patterns, use "
+        "`--no-patterns`");
+  }
+  if (existingIndexBaseName_.has_value() && onlyAddTextIndex_) {
+    throw std::invalid_argument(
+        "An incremental index build can't be combined with only adding a text "
+        "index");
+  }
+  // The text index of the existing index refers to its vocabulary and text
+  // records and is not carried over, so it has to be built again explicitly.
+  if (existingIndexBaseName_.has_value() &&
+      std::filesystem::exists(existingIndexBaseName_.value() + ".text.index") &&
+      !(wordsAndDocsFileSpecified() || addWordsFromLiterals_)) {
+    throw std::invalid_argument(absl::StrCat(
+        "The existing index \"", existingIndexBaseName_.value(),
+        "\" has a text index, which is not carried over by an incremental "
+        "index build. Build the text index of the new index from its words "
+        "and docs files or from its literals"));
+  }
 }
 
 }  // namespace qlever
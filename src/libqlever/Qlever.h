@@ -94,10 +94,54 @@ struct IndexBuilderConfig : CommonConfig {
   ad_utility::VocabularyType vocabType_{
       ad_utility::VocabularyType::Enum::OnDiskCompressed};
 
+  // If set to true, then a trigram index of the vocabulary is built, which
+  // speeds up `CONTAINS`, `STRSTARTS`, and `REGEX` filters with a constant
+  // pattern (see `src/index/VocabularyNgramIndex.h`).
+  bool buildVocabularyNgramIndex_ = false;
+
+  // If set to true, then a persistent R-tree of the bounding boxes of all
+  // geometries is built, which is used by the spatial join (see
+  // `src/index/SpatialIndex.h`). This requires a `vocabType_` that stores
+  // precomputed geometry information.
+  bool buildSpatialIndex_ = false;
+
+  // The predicates (IRIs in angle brackets) for which a reachability index is
+  // built, which speeds up transitive paths like `?x <subClassOf>* ?y` (see
+  // `src/index/ReachabilityIndex.h`).
+  std::vector<std::string> reachabilityIndexPredicates_;
+
   // If set to true, then certain temporary files which are created while
   // building the index are not deleted. This can be useful for debugging.
   bool keepTemporaryFiles_ = false;
 
+  // The number of threads that compress and write the blocks of each
+  // permutation. If not set, a default is used.
+  std::optional<size_t> numThreadsIndexBuilding_;
+
+  // If set to true, then the OSP/OPS and the PSO/POS permutations are built at
+  // the same time. The memory limit (see `memoryLimit_`) is then split between
+  // the two. This requires that no patterns are built (see `noPatterns_`),
+  // otherwise the index build throws.
+  bool buildPermutationPairsInParallel_ = false;
+
+  // If set, the input is merged into the existing index with this basename,
+  // and the result is a complete new index at `baseName_` (the existing index
+  // is not modified). Only the input has to be parsed and sorted, the
+  // vocabulary and the permutations of the existing index are merged with it.
+  // The existing index must have all six permutations and a vocabulary type
+  // without the split for geometries, and no patterns must be built (see
+  // `noPatterns_`). Updates of the existing index that are not compacted and
+  // its text index are not carried over.
+  std::optional<std::string> existingIndexBaseName_;
+
+  // If set to true, a previous index build with the same `baseName_`, input
+  // files, and settings that was interrupted is resumed. Its finished stages
+  // are recorded in a checkpoint file and are skipped if their output files
+  // are still complete. The stages are parsing, vocabulary merge, ID
+  // conversion, the permutations, and the text index (see `IndexBuildStage`).
+  // The checkpoint file is removed when the index is complete.
+  bool resume_ = false;
+
   // A list of IRI prefixes (without angle brackets). IRIs that start with one
   // of these prefixes, followed by a sequence of a bounded number of digits
   // are encoded directly in the internal ID. This reduces the size of the
@@ -9,6 +9,7 @@
 
 #include "parser/MagicServiceIriConstants.h"
 #include "parser/SparqlTriple.h"
+#include "util/Algorithm.h"
 
 namespace parsedQuery {
 
@@ -34,6 +35,8 @@ void PathQuery::addParameter(const SparqlTriple& triple) {
     setVariable("edgeColumn", object, edgeColumn_);
   } else if (predString == "edgeProperty") {
     edgeProperties_.push_back(getVariable("edgeProperty", object));
+  } else if (predString == "edgeWeight") {
+    setVariable("edgeWeight", object, edgeWeight_);
   } else if (predString == "cartesian") {
     if (!object.isBool()) {
       throw PathSearchException("The parameter <cartesian> expects a boolean");
@@ -44,6 +47,10 @@ void PathQuery::addParameter(const SparqlTriple& triple) {
       throw PathSearchException(
           "The parameter <numPathsPerTarget> expects an integer");
     }
+    if (object.getInt() < 0) {
+      throw PathSearchException(
+          "The parameter <numPathsPerTarget> expects a non-negative integer");
+    }
     numPathsPerTarget_ = object.getInt();
   } else if (predString == "algorithm") {
     if (!object.isIri()) {
@@ -53,16 +60,22 @@ void PathQuery::addParameter(const SparqlTriple& triple) {
 
     if (objString == "allPaths") {
       algorithm_ = PathSearchAlgorithm::ALL_PATHS;
+    } else if (objString == "shortestPath") {
+      algorithm_ = PathSearchAlgorithm::SHORTEST_PATH;
+    } else if (objString == "kShortestPaths") {
+      algorithm_ = PathSearchAlgorithm::K_SHORTEST_PATHS;
     } else {
-      throw PathSearchException(
-          absl::StrCat("Unsupported algorithm in pathSearch: ", objString,
-                       ". Supported Algorithms: <allPaths>."));
+      throw PathSearchException(absl::StrCat(
+          "Unsupported algorithm in pathSearch: ", objString,
+          ". Supported Algorithms: <allPaths>, <shortestPath>, "
+          "<kShortestPaths>."));
     }
   } else {
     throw PathSearchException(absl::StrCat(
         "Unsupported argument <", predString,
         "> in PathSearch. Supported Arguments: <source>, <target>, <start>, "
-        "<end>, <pathColumn>, <edgeColumn>, <edgeProperty>, <algorithm>."));
+        "<end>, <pathColumn>, <edgeColumn>, <edgeProperty>, <edgeWeight>, "
+        "<algorithm>, <cartesian>, <numPathsPerTarget>."));
   }
 }
 
@@ -107,12 +120,32 @@ PathSearchConfiguration PathQuery::toPathSearchConfiguration(
   } else if (!edgeColumn_.has_value()) {
     throw PathSearchException("Missing parameter <edgeColumn> in path search.");
   }
+  // For `<allPaths>`, zero paths per target are allowed (the result is then
+  // empty), but `<kShortestPaths>` needs at least one.
+  if (algorithm_ == PathSearchAlgorithm::K_SHORTEST_PATHS &&
+      numPathsPerTarget_ == 0) {
+    throw PathSearchException(
+        "The parameter <numPathsPerTarget> has to be positive for the "
+        "algorithm <kShortestPaths>.");
+  }
+  if (edgeWeight_.has_value()) {
+    if (algorithm_ == PathSearchAlgorithm::ALL_PATHS) {
+      throw PathSearchException(
+          "The parameter <edgeWeight> is only supported by the algorithms "
+          "<shortestPath> and <kShortestPaths>.");
+    }
+    if (!ad_utility::contains(edgeProperties_, edgeWeight_.value())) {
+      throw PathSearchException(
+          "The variable of the parameter <edgeWeight> has to be one of the "
+          "variables given via <edgeProperty>.");
+    }
+  }
 
   return PathSearchConfiguration{
       algorithm_,          sources,         targets,
       start_.value(),      end_.value(),    pathColumn_.value(),
       edgeColumn_.value(), edgeProperties_, cartesian_,
-      numPathsPerTarget_};
+      numPathsPerTarget_,  edgeWeight_};
 }
 
 }  // namespace parsedQuery
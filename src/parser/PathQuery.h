@@ -38,6 +38,7 @@ struct PathQuery : MagicServiceQuery {
   std::optional<Variable> pathColumn_;
   std::optional<Variable> edgeColumn_;
   std::vector<Variable> edgeProperties_;
+  std::optional<Variable> edgeWeight_;
   PathSearchAlgorithm algorithm_;
 
   bool cartesian_ = true;
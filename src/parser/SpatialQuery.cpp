@@ -104,6 +104,18 @@ void SpatialQuery::addParameter(const SparqlTriple& triple) {
           "supported spatial search algorithm. Please select either "
           "`<baseline>`, `<s2>`, `<libspatialjoin>`, or `<boundingBox>`");
     }
+  } else if (predString == "boundingBox") {
+    std::optional<ad_utility::BoundingBox> boundingBox;
+    if (object.isLiteral()) {
+      boundingBox = ad_utility::GeometryInfo::getBoundingBox(
+          object.getLiteral().toStringRepresentation());
+    }
+    if (!boundingBox.has_value()) {
+      throw SpatialSearchException(
+          "The parameter `<boundingBox>` expects a valid WKT literal (of which "
+          "only the bounding box is used)");
+    }
+    boundingBox_ = boundingBox.value();
   } else if (predString == "payload") {
     if (object.isVariable()) {
       // Single selected variable
@@ -126,8 +138,29 @@ void SpatialQuery::addParameter(const SparqlTriple& triple) {
         "Unsupported argument ", predString,
         " in spatial search; supported arguments are: `<left>`, `<right>`, "
         "`<numNearestNeighbors>`, `<maxDistance>`, `<bindDistance>`, "
-        "`<joinType>`, `<payload>`, and `<algorithm>`"));
+        "`<joinType>`, `<payload>`, `<algorithm>`, and `<boundingBox>`"));
+  }
+}
+
+// ____________________________________________________________________________
+bool SpatialQuery::isSpatialIndexScan() const {
+  if (!boundingBox_.has_value()) {
+    return false;
+  }
+  if (!left_.has_value()) {
+    throw SpatialSearchException(
+        "Missing parameter `<left>` in spatial search.");
+  }
+  if (right_.has_value() || maxDist_.has_value() || maxResults_.has_value() ||
+      distanceVariable_.has_value() || !payloadVariables_.empty() ||
+      algo_.has_value() || joinType_.has_value() ||
+      childGraphPattern_.has_value()) {
+    throw SpatialSearchException(
+        "A spatial search with the parameter `<boundingBox>` binds the "
+        "`<left>` variable to the geometries that intersect the box. It does "
+        "not support any other parameter or a graph pattern.");
   }
+  return true;
 }
 
 // ____________________________________________________________________________
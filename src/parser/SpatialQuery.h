@@ -9,6 +9,7 @@
 #include "engine/SpatialJoin.h"
 #include "parser/MagicServiceQuery.h"
 #include "parser/PayloadVariables.h"
+#include "rdfTypes/GeometryInfo.h"
 
 namespace parsedQuery {
 
@@ -58,6 +59,12 @@ struct SpatialQuery : MagicServiceQuery {
   // declared inside the service (despite confusing semantics).
   bool ignoreMissingRightChild_ = false;
 
+  // Alternative to a spatial join: if a bounding box is given (as a WKT
+  // literal, of which only the bounding box is used), the `left_` variable is
+  // bound to all the geometries from the prebuilt `SpatialIndex` that
+  // intersect it. No other parameter may be given in this case.
+  std::optional<ad_utility::BoundingBox> boundingBox_;
+
   SpatialQuery() = default;
   SpatialQuery(SpatialQuery&& other) noexcept = default;
   SpatialQuery(const SpatialQuery& other) noexcept = default;
@@ -75,6 +82,11 @@ struct SpatialQuery : MagicServiceQuery {
   // Convert this SpatialQuery to a proper SpatialJoinConfiguration. This will
   // check if all required values have been provided and otherwise throw.
   SpatialJoinConfiguration toSpatialJoinConfiguration() const;
+
+  // Return true iff this is a spatial index scan, that is if the
+  // `<boundingBox>` parameter was given. In this case, check that the
+  // remaining parameters are valid and otherwise throw.
+  bool isSpatialIndexScan() const;
 };
 
 }  // namespace parsedQuery
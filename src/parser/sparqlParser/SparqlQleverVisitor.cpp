@@ -1248,7 +1248,9 @@ GraphPatternOperation Visitor::visitSpatialQuery(
     // We convert the spatial query to a spatial join configuration and discard
     // its result here to detect errors early and report them to the user with
     // highlighting. It's only a small struct so not much is wasted.
-    [[maybe_unused]] auto&& _ = spatialQuery.toSpatialJoinConfiguration();
+    if (!spatialQuery.isSpatialIndexScan()) {
+      [[maybe_unused]] auto&& _ = spatialQuery.toSpatialJoinConfiguration();
+    }
   } catch (const std::exception& ex) {
     reportError(ctx, ex.what());
   }
@@ -0,0 +1,508 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "util/ArrowIpc.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+
+#include "util/Exception.h"
+
+namespace ad_utility::arrow {
+
+namespace {
+
+// Constants from the Arrow format specification (`Schema.fbs` and
+// `Message.fbs`).
+constexpr int16_t METADATA_VERSION_V5 = 4;
+constexpr uint8_t HEADER_SCHEMA = 1;
+constexpr uint8_t HEADER_DICTIONARY_BATCH = 2;
+constexpr uint8_t HEADER_RECORD_BATCH = 3;
+constexpr uint8_t TYPE_INT = 2;
+constexpr uint8_t TYPE_FLOATING_POINT = 3;
+constexpr uint8_t TYPE_UTF8 = 5;
+constexpr uint8_t TYPE_BOOL = 6;
+constexpr uint8_t TYPE_TIMESTAMP = 10;
+constexpr int16_t PRECISION_DOUBLE = 2;
+constexpr int16_t TIME_UNIT_MILLISECOND = 1;
+constexpr uint32_t CONTINUATION_MARKER = 0xFFFFFFFF;
+
+// The buffers of a message body are aligned to this number of bytes.
+constexpr size_t ALIGNMENT = 8;
+
+constexpr size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+void appendBytes(std::string& target, T value) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  target.append(bytes, sizeof(T));
+}
+
+// A node of a FlatBuffer (a table, a string, a vector of tables, or a vector
+// of structs), which is serialized by `FlatBufferWriter` below. The slots of
+// the fields of a table are given by the order of the fields in the schema
+// (`.fbs` file).
+struct Node {
+  enum class Kind { Table, String, TableVector, StructVector };
+  Kind kind_ = Kind::Table;
+  // The scalar fields of a table (slot and little-endian bytes).
+  std::vector<std::pair<uint16_t, std::string>> scalars_;
+  // The tables, strings, and vectors that are referenced by a table (with
+  // the corresponding slots) or the elements of a vector of tables.
+  std::vector<uint16_t> childSlots_;
+  std::vector<Node> children_;
+  // The content of a string or the elements of a vector of structs.
+  std::string bytes_;
+  size_t numElements_ = 0;
+
+  template <typename T>
+  Node& add(uint16_t slot, T value) {
+    std::string bytes;
+    appendBytes(bytes, value);
+    scalars_.emplace_back(slot, std::move(bytes));
+    return *this;
+  }
+  Node& add(uint16_t slot, Node child) {
+    childSlots_.push_back(slot);
+    children_.push_back(std::move(child));
+    return *this;
+  }
+
+  size_t numSlots() const {
+    size_t result = 0;
+    for (const auto& [slot, bytes] : scalars_) {
+      result = std::max(result, size_t{slot} + 1);
+    }
+    for (uint16_t slot : childSlots_) {
+      result = std::max(result, size_t{slot} + 1);
+    }
+    return result;
+  }
+};
+
+Node makeString(std::string_view value) {
+  Node node;
+  node.kind_ = Node::Kind::String;
+  node.bytes_ = std::string{value};
+  node.numElements_ = value.size();
+  return node;
+}
+
+Node makeTableVector(std::vector<Node> tables) {
+  Node node;
+  node.kind_ = Node::Kind::TableVector;
+  node.numElements_ = tables.size();
+  node.children_ = std::move(tables);
+  return node;
+}
+
+// The structs `FieldNode` and `Buffer` of the Arrow format both consist of
+// two 64-bit integers.
+Node makeStructVector(const std::vector<std::array<int64_t, 2>>& structs) {
+  Node node;
+  node.kind_ = Node::Kind::StructVector;
+  node.numElements_ = structs.size();
+  for (const auto& [first, second] : structs) {
+    appendBytes(node.bytes_, first);
+    appendBytes(node.bytes_, second);
+  }
+  return node;
+}
+
+// Serialize a tree of `Node`s as a FlatBuffer. In contrast to the builder of
+// the FlatBuffers library, the buffer is written from front to back: each
+// object is followed by the objects it references (offsets in FlatBuffers
+// must point forward), and each table is preceded by its vtable.
+class FlatBufferWriter {
+ private:
+  std::string buffer_;
+
+  void pad(size_t alignment) {
+    buffer_.resize(alignUp(buffer_.size(), alignment), '\0');
+  }
+
+  template <typename T>
+  void patch(size_t position, T value) {
+    std::memcpy(buffer_.data() + position, &value, sizeof(T));
+  }
+
+  // Patch the offset at `position` s.t. it points to `target`.
+  void patchOffset(size_t position, size_t target) {
+    AD_CORRECTNESS_CHECK(target > position);
+    patch(position, static_cast<uint32_t>(target - position));
+  }
+
+  // Write the `node` and all the nodes it references. Return the position
+  // to which an offset referring to the `node` has to point.
+  size_t write(const Node& node) {
+    switch (node.kind_) {
+      case Node::Kind::Table:
+        return writeTable(node);
+      case Node::Kind::String: {
+        pad(sizeof(uint32_t));
+        size_t position = buffer_.size();
+        appendBytes(buffer_, static_cast<uint32_t>(node.numElements_));
+        buffer_.append(node.bytes_);
+        buffer_.push_back('\0');
+        return position;
+      }
+      case Node::Kind::TableVector: {
+        pad(sizeof(uint32_t));
+        size_t position = buffer_.size();
+        appendBytes(buffer_, static_cast<uint32_t>(node.numElements_));
+        buffer_.resize(buffer_.size() + node.numElements_ * sizeof(uint32_t));
+        for (size_t i = 0; i < node.children_.size(); ++i) {
+          size_t offsetPosition = position + (i + 1) * sizeof(uint32_t);
+          patchOffset(offsetPosition, write(node.children_[i]));
+        }
+        return position;
+      }
+      case Node::Kind::StructVector: {
+        // The elements (which directly follow the length) have to be 8-byte
+        // aligned.
+        pad(sizeof(uint32_t));
+        if ((buffer_.size() + sizeof(uint32_t)) % ALIGNMENT != 0) {
+          buffer_.resize(buffer_.size() + sizeof(uint32_t));
+        }
+        size_t position = buffer_.size();
+        appendBytes(buffer_, static_cast<uint32_t>(node.numElements_));
+        buffer_.append(node.bytes_);
+        return position;
+      }
+    }
+    AD_FAIL();
+  }
+
+  size_t writeTable(const Node& node) {
+    size_t numSlots = node.numSlots();
+    pad(sizeof(uint16_t));
+    size_t vtablePosition = buffer_.size();
+    buffer_.resize(vtablePosition + (2 + numSlots) * sizeof(uint16_t));
+    pad(ALIGNMENT);
+    size_t tablePosition = buffer_.size();
+    // The offset to the vtable is filled in below.
+    buffer_.resize(tablePosition + sizeof(int32_t));
+    std::vector<uint16_t> fieldOffsets(numSlots, 0);
+    for (const auto& [slot, bytes] : node.scalars_) {
+      pad(bytes.size());
+      fieldOffsets.at(slot) =
+          static_cast<uint16_t>(buffer_.size() - tablePosition);
+      buffer_.append(bytes);
+    }
+    std::vector<size_t> childOffsetPositions;
+    for (uint16_t slot : node.childSlots_) {
+      pad(sizeof(uint32_t));
+      fieldOffsets.at(slot) =
+          static_cast<uint16_t>(buffer_.size() - tablePosition);
+      childOffsetPositions.push_back(buffer_.size());
+      buffer_.resize(buffer_.size() + sizeof(uint32_t));
+    }
+    auto tableSize = buffer_.size() - tablePosition;
+    AD_CORRECTNESS_CHECK(tableSize <= std::numeric_limits<uint16_t>::max());
+
+    // Write the vtable and the offset from the table to its vtable.
+    patch(vtablePosition,
+          static_cast<uint16_t>((2 + numSlots) * sizeof(uint16_t)));
+    patch(vtablePosition + sizeof(uint16_t), static_cast<uint16_t>(tableSize));
+    for (size_t i = 0; i < numSlots; ++i) {
+      patch(vtablePosition + (2 + i) * sizeof(uint16_t), fieldOffsets[i]);
+    }
+    patch(tablePosition, static_cast<int32_t>(tablePosition - vtablePosition));
+
+    for (size_t i = 0; i < node.children_.size(); ++i) {
+      patchOffset(childOffsetPositions[i], write(node.children_[i]));
+    }
+    return tablePosition;
+  }
+
+ public:
+  // Serialize the tree with the given `root` table.
+  std::string finish(const Node& root) && {
+    // The buffer starts with the offset of the root table.
+    buffer_.resize(sizeof(uint32_t));
+    patchOffset(0, write(root));
+    return std::move(buffer_);
+  }
+};
+
+// The body of a message, which consists of 8-byte aligned buffers.
+class Body {
+ private:
+  std::string bytes_;
+  std::vector<std::array<int64_t, 2>> buffers_;
+
+ public:
+  void addBuffer(std::string_view buffer) {
+    buffers_.push_back({static_cast<int64_t>(bytes_.size()),
+                        static_cast<int64_t>(buffer.size())});
+    bytes_.append(buffer);
+    bytes_.resize(alignUp(bytes_.size(), ALIGNMENT), '\0');
+  }
+  const std::string& bytes() const { return bytes_; }
+  const std::vector<std::array<int64_t, 2>>& buffers() const {
+    return buffers_;
+  }
+};
+
+// Return a `RecordBatch` table with the given number of rows, the
+// `FieldNode`s (length and null count) of the columns, and the buffers of the
+// `body`.
+Node makeRecordBatch(size_t numRows,
+                     const std::vector<std::array<int64_t, 2>>& fieldNodes,
+                     const Body& body) {
+  Node recordBatch;
+  recordBatch.add<int64_t>(0, static_cast<int64_t>(numRows));
+  recordBatch.add(1, makeStructVector(fieldNodes));
+  recordBatch.add(2, makeStructVector(body.buffers()));
+  return recordBatch;
+}
+
+// Return an encapsulated message (continuation marker, size of the metadata,
+// the metadata, and the body) with the given `header`.
+std::string makeMessage(uint8_t headerType, Node header,
+                        const std::string& body) {
+  Node message;
+  message.add<int16_t>(0, METADATA_VERSION_V5);
+  message.add<uint8_t>(1, headerType);
+  message.add(2, std::move(header));
+  message.add<int64_t>(3, static_cast<int64_t>(body.size()));
+  std::string metadata = FlatBufferWriter{}.finish(message);
+  // The size of the prefix is a multiple of 8, so after this padding, the
+  // body starts at an aligned position.
+  metadata.resize(alignUp(metadata.size(), ALIGNMENT), '\0');
+
+  std::string result;
+  appendBytes(result, CONTINUATION_MARKER);
+  appendBytes(result, static_cast<int32_t>(metadata.size()));
+  result.append(metadata);
+  result.append(body);
+  return result;
+}
+
+Node makeIntType(int32_t bitWidth) {
+  Node type;
+  type.add<int32_t>(0, bitWidth);
+  type.add<uint8_t>(1, 1);
+  return type;
+}
+
+// Return the `Field` table for a column with the given `name` and `type`,
+// which is the `index`-th column of the schema.
+Node makeField(std::string_view name, ColumnType type, size_t index) {
+  Node field;
+  field.add(0, makeString(name));
+  field.add<uint8_t>(1, 1);
+  Node typeNode;
+  uint8_t typeType = 0;
+  switch (type) {
+    case ColumnType::Int64:
+      typeType = TYPE_INT;
+      typeNode = makeIntType(64);
+      break;
+    case ColumnType::Float64:
+      typeType = TYPE_FLOATING_POINT;
+      typeNode.add<int16_t>(0, PRECISION_DOUBLE);
+      break;
+    case ColumnType::Bool:
+      typeType = TYPE_BOOL;
+      break;
+    case ColumnType::Timestamp:
+      typeType = TYPE_TIMESTAMP;
+      typeNode.add<int16_t>(0, TIME_UNIT_MILLISECOND);
+      typeNode.add(1, makeString("UTC"));
+      break;
+    case ColumnType::String: {
+      // The values of a dictionary-encoded field have the type of the
+      // dictionary, the type of the indices is stored separately.
+      typeType = TYPE_UTF8;
+      Node dictionary;
+      dictionary.add<int64_t>(0, static_cast<int64_t>(index));
+      dictionary.add(1, makeIntType(32));
+      field.add(4, std::move(dictionary));
+      break;
+    }
+  }
+  field.add<uint8_t>(2, typeType);
+  field.add(3, std::move(typeNode));
+  // Readers require the `children` even if they are empty.
+  field.add(5, makeTableVector({}));
+  return field;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+size_t ColumnBuilder::appendValidity(bool isValid) {
+  size_t row = numRows_++;
+  if (row % 8 == 0) {
+    validity_.push_back('\0');
+  }
+  if (isValid) {
+    validity_.back() = static_cast<char>(validity_.back() | (1 << (row % 8)));
+  } else {
+    ++nullCount_;
+  }
+  return row;
+}
+
+// _____________________________________________________________________________
+template <typename T>
+void ColumnBuilder::appendFixedWidth(T value) {
+  appendBytes(values_, value);
+}
+
+// _____________________________________________________________________________
+void ColumnBuilder::appendNull() {
+  size_t row = appendValidity(false);
+  switch (type_) {
+    case ColumnType::Int64:
+    case ColumnType::Timestamp:
+      appendFixedWidth(int64_t{0});
+      break;
+    case ColumnType::Float64:
+      appendFixedWidth(0.0);
+      break;
+    case ColumnType::Bool:
+      if (row % 8 == 0) {
+        values_.push_back('\0');
+      }
+      break;
+    case ColumnType::String:
+      appendFixedWidth(int32_t{0});
+      break;
+  }
+}
+
+// _____________________________________________________________________________
+void ColumnBuilder::appendInt(int64_t value) {
+  AD_CONTRACT_CHECK(type_ == ColumnType::Int64);
+  appendValidity(true);
+  appendFixedWidth(value);
+}
+
+// _____________________________________________________________________________
+void ColumnBuilder::appendDouble(double value) {
+  AD_CONTRACT_CHECK(type_ == ColumnType::Float64);
+  appendValidity(true);
+  appendFixedWidth(value);
+}
+
+// _____________________________________________________________________________
+void ColumnBuilder::appendBool(bool value) {
+  AD_CONTRACT_CHECK(type_ == ColumnType::Bool);
+  size_t row = appendValidity(true);
+  if (row % 8 == 0) {
+    values_.push_back('\0');
+  }
+  if (value) {
+    values_.back() = static_cast<char>(values_.back() | (1 << (row % 8)));
+  }
+}
+
+// _____________________________________________________________________________
+void ColumnBuilder::appendTimestamp(int64_t millisecondsSinceEpoch) {
+  AD_CONTRACT_CHECK(type_ == ColumnType::Timestamp);
+  appendValidity(true);
+  appendFixedWidth(millisecondsSinceEpoch);
+}
+
+// _____________________________________________________________________________
+void ColumnBuilder::appendString(std::string_view value) {
+  AD_CONTRACT_CHECK(type_ == ColumnType::String);
+  appendValidity(true);
+  auto [it, isNew] = dictionaryIndices_.try_emplace(
+      std::string{value}, static_cast<int32_t>(dictionary_.size()));
+  if (isNew) {
+    dictionary_.emplace_back(value);
+  }
+  appendFixedWidth(it->second);
+}
+
+// _____________________________________________________________________________
+void ColumnBuilder::clear() {
+  numRows_ = 0;
+  nullCount_ = 0;
+  validity_.clear();
+  values_.clear();
+  dictionary_.clear();
+  dictionaryIndices_.clear();
+}
+
+// _____________________________________________________________________________
+std::string schemaMessage(
+    const std::vector<std::pair<std::string, ColumnType>>& columns) {
+  std::vector<Node> fields;
+  for (size_t i = 0; i < columns.size(); ++i) {
+    fields.push_back(makeField(columns[i].first, columns[i].second, i));
+  }
+  Node schema;
+  // Little endian.
+  schema.add<int16_t>(0, 0);
+  schema.add(1, makeTableVector(std::move(fields)));
+  return makeMessage(HEADER_SCHEMA, std::move(schema), "");
+}
+
+// _____________________________________________________________________________
+std::string recordBatchMessages(const std::vector<ColumnBuilder>& columns) {
+  std::string result;
+  size_t numRows = columns.empty() ? 0 : columns.front().numRows();
+  Body body;
+  std::vector<std::array<int64_t, 2>> fieldNodes;
+  for (size_t i = 0; i < columns.size(); ++i) {
+    const auto& column = columns[i];
+    AD_CONTRACT_CHECK(column.numRows() == numRows);
+    fieldNodes.push_back({static_cast<int64_t>(numRows),
+                          static_cast<int64_t>(column.nullCount())});
+    body.addBuffer(column.validity());
+    body.addBuffer(column.values());
+    if (column.type() != ColumnType::String) {
+      continue;
+    }
+    // The dictionary is a column of UTF-8 strings without nulls, with the
+    // buffers for the validity (empty), the offsets, and the characters.
+    Body dictionaryBody;
+    std::string offsets;
+    std::string characters;
+    appendBytes(offsets, int32_t{0});
+    for (const auto& value : column.dictionary()) {
+      characters.append(value);
+      AD_CONTRACT_CHECK(characters.size() <=
+                        std::numeric_limits<int32_t>::max());
+      appendBytes(offsets, static_cast<int32_t>(characters.size()));
+    }
+    dictionaryBody.addBuffer("");
+    dictionaryBody.addBuffer(offsets);
+    dictionaryBody.addBuffer(characters);
+    auto dictionarySize = static_cast<int64_t>(column.dictionary().size());
+    Node dictionaryBatch;
+    dictionaryBatch.add<int64_t>(0, static_cast<int64_t>(i));
+    dictionaryBatch.add(
+        1, makeRecordBatch(column.dictionary().size(), {{dictionarySize, 0}},
+                           dictionaryBody));
+    // A dictionary batch that is not a delta replaces the previous
+    // dictionary with the same id.
+    dictionaryBatch.add<uint8_t>(2, 0);
+    result.append(makeMessage(HEADER_DICTIONARY_BATCH,
+                              std::move(dictionaryBatch),
+                              dictionaryBody.bytes()));
+  }
+  result.append(makeMessage(HEADER_RECORD_BATCH,
+                            makeRecordBatch(numRows, fieldNodes, body),
+                            body.bytes()));
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string endOfStreamMessage() {
+  std::string result;
+  appendBytes(result, CONTINUATION_MARKER);
+  appendBytes(result, int32_t{0});
+  return result;
+}
+
+}  // namespace ad_utility::arrow
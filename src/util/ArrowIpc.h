@@ -0,0 +1,94 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_ARROWIPC_H
+#define QLEVER_SRC_UTIL_ARROWIPC_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "util/HashMap.h"
+
+// A minimal writer for the Apache Arrow IPC streaming format (see
+// https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format),
+// which can be read by `pyarrow`, `polars`, `duckdb` and many other tools
+// without any parsing. A stream consists of a schema message, followed by
+// a sequence of record batches and the end-of-stream marker. The metadata of
+// the messages is encoded as FlatBuffers, which are written by hand, so that
+// no dependency on the Arrow libraries is required.
+//
+// String columns are dictionary-encoded (with 32-bit indices). Each record
+// batch is preceded by a (replacement) dictionary batch for each string
+// column, so the dictionaries only contain the strings of the current batch.
+namespace ad_utility::arrow {
+
+// The supported types of columns. `Timestamp` columns store milliseconds since
+// the UNIX epoch (UTC).
+enum class ColumnType { Int64, Float64, Bool, Timestamp, String };
+
+// The values of a single column of a record batch in the Arrow memory layout.
+// All values may be null.
+class ColumnBuilder {
+ private:
+  ColumnType type_;
+  size_t numRows_ = 0;
+  size_t nullCount_ = 0;
+  // The validity bitmap (bit `i` is set iff row `i` is not null).
+  std::string validity_;
+  // The values of fixed width, the bits of a `Bool` column, or the indices
+  // into the dictionary of a `String` column.
+  std::string values_;
+  // The dictionary of a `String` column.
+  std::vector<std::string> dictionary_;
+  ad_utility::HashMap<std::string, int32_t> dictionaryIndices_;
+
+ public:
+  explicit ColumnBuilder(ColumnType type) : type_{type} {}
+
+  ColumnType type() const { return type_; }
+  size_t numRows() const { return numRows_; }
+  size_t nullCount() const { return nullCount_; }
+  const std::string& validity() const { return validity_; }
+  const std::string& values() const { return values_; }
+  const std::vector<std::string>& dictionary() const { return dictionary_; }
+
+  // Append a value to the column. The type of the value must match the type
+  // of the column (timestamps are given in milliseconds since the epoch).
+  void appendNull();
+  void appendInt(int64_t value);
+  void appendDouble(double value);
+  void appendBool(bool value);
+  void appendTimestamp(int64_t millisecondsSinceEpoch);
+  void appendString(std::string_view value);
+
+  // Remove all values, but keep the type.
+  void clear();
+
+ private:
+  // Append a bit to the validity bitmap and return the index of the new row.
+  size_t appendValidity(bool isValid);
+  template <typename T>
+  void appendFixedWidth(T value);
+};
+
+// Return the schema message for columns with the given names and types. The
+// dictionary of the `i`-th column (if it is a `String` column) has id `i`.
+std::string schemaMessage(
+    const std::vector<std::pair<std::string, ColumnType>>& columns);
+
+// Return the messages for a record batch that consists of the given `columns`
+// (which all must have the same number of rows): one dictionary batch per
+// `String` column, followed by the record batch itself.
+std::string recordBatchMessages(const std::vector<ColumnBuilder>& columns);
+
+// Return the marker for the end of a stream.
+std::string endOfStreamMessage();
+
+}  // namespace ad_utility::arrow
+
+#endif  // QLEVER_SRC_UTIL_ARROWIPC_H
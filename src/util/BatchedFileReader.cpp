@@ -0,0 +1,483 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "util/BatchedFileReader.h"
+
+#include <absl/strings/str_cat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include "util/Exception.h"
+#include "util/Log.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define QLEVER_HAS_IO_URING
+#endif
+
+namespace ad_utility {
+
+using ReadRequest = BatchedFileReader::ReadRequest;
+
+namespace {
+// Throw for a `request` that could not be read completely. The `error` is the
+// `errno` of the failed read, or zero if the end of the file was reached.
+[[noreturn]] void throwReadError(const ReadRequest& request, int error) {
+  throw std::runtime_error(absl::StrCat(
+      "Reading ", request.numBytes_, " bytes at offset ", request.offset_,
+      " failed: ", error == 0 ? "unexpected end of file" : strerror(error)));
+}
+
+// Read as many bytes of the `request` as possible from the `fd` (at most until
+// the end of the file). Return the number of bytes that were read, or the
+// negated `errno` if the first read failed.
+int64_t preadAsMuchAsPossible(int fd, const ReadRequest& request) {
+  size_t bytesRead = 0;
+  while (bytesRead < request.numBytes_) {
+    ssize_t ret = pread(fd, request.buffer_ + bytesRead,
+                        request.numBytes_ - bytesRead,
+                        request.offset_ + static_cast<off_t>(bytesRead));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      return bytesRead > 0 ? static_cast<int64_t>(bytesRead) : -errno;
+    }
+    if (ret == 0) {
+      break;
+    }
+    bytesRead += static_cast<size_t>(ret);
+  }
+  return static_cast<int64_t>(bytesRead);
+}
+
+// Round `value` down (or up) to a multiple of `DIRECT_IO_ALIGNMENT`.
+constexpr off_t alignDown(off_t value) {
+  constexpr auto alignment =
+      static_cast<off_t>(BatchedFileReader::DIRECT_IO_ALIGNMENT);
+  return value / alignment * alignment;
+}
+constexpr off_t alignUp(off_t value) {
+  constexpr auto alignment =
+      static_cast<off_t>(BatchedFileReader::DIRECT_IO_ALIGNMENT);
+  return alignDown(value + alignment - 1);
+}
+}  // namespace
+
+namespace detail {
+#ifdef QLEVER_HAS_IO_URING
+// The submission and completion queues of an `io_uring` instance, which are
+// shared with the kernel via `mmap`. The raw system calls are used (instead of
+// `liburing`), s.t. QLever does not depend on another library. Only reads are
+// supported, and all the submitted reads of a batch are awaited before the
+// next batch is submitted.
+class IoUring {
+ private:
+  int ringFd_ = -1;
+  unsigned numEntries_ = 0;
+  void* sqRing_ = MAP_FAILED;
+  size_t sqRingSize_ = 0;
+  void* cqRing_ = MAP_FAILED;
+  size_t cqRingSize_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqesSize_ = 0;
+
+  // Pointers into the mapped queues.
+  unsigned* sqTail_ = nullptr;
+  unsigned* sqMask_ = nullptr;
+  unsigned* sqArray_ = nullptr;
+  unsigned* cqHead_ = nullptr;
+  unsigned* cqTail_ = nullptr;
+  unsigned* cqMask_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+
+  // Set if a submission failed. The submission queue might then contain stale
+  // entries, so the ring must not be reused.
+  bool isBroken_ = false;
+
+  IoUring() = default;
+
+ public:
+  // Create a ring with (at least) `numEntries` entries. Return `nullptr` if
+  // `io_uring` is not available or doesn't support `IORING_OP_READ`.
+  static std::unique_ptr<IoUring> create(unsigned numEntries) {
+    io_uring_params params{};
+    auto ringFd = static_cast<int>(
+        syscall(__NR_io_uring_setup, numEntries, &params));
+    if (ringFd < 0) {
+      return nullptr;
+    }
+    std::unique_ptr<IoUring> ring{new IoUring};
+    ring->ringFd_ = ringFd;
+    if (!ring->supportsRead()) {
+      return nullptr;
+    }
+    ring->numEntries_ = params.sq_entries;
+    ring->sqRingSize_ =
+        params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqRingSize_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+      ring->sqRingSize_ = std::max(ring->sqRingSize_, ring->cqRingSize_);
+      ring->cqRingSize_ = ring->sqRingSize_;
+    }
+    auto map = [ringFd](size_t size, off_t offset) {
+      return mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE, ringFd, offset);
+    };
+    // On failure, the destructor releases what was already mapped.
+    ring->sqRing_ = map(ring->sqRingSize_, IORING_OFF_SQ_RING);
+    if (ring->sqRing_ == MAP_FAILED) {
+      return nullptr;
+    }
+    ring->cqRing_ = singleMmap ? ring->sqRing_
+                               : map(ring->cqRingSize_, IORING_OFF_CQ_RING);
+    if (ring->cqRing_ == MAP_FAILED) {
+      return nullptr;
+    }
+    ring->sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = map(ring->sqesSize_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      return nullptr;
+    }
+    ring->sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sq = static_cast<char*>(ring->sqRing_);
+    auto* cq = static_cast<char*>(ring->cqRing_);
+    auto at = [](char* base, unsigned offset) {
+      return reinterpret_cast<unsigned*>(base + offset);
+    };
+    ring->sqTail_ = at(sq, params.sq_off.tail);
+    ring->sqMask_ = at(sq, params.sq_off.ring_mask);
+    ring->sqArray_ = at(sq, params.sq_off.array);
+    ring->cqHead_ = at(cq, params.cq_off.head);
+    ring->cqTail_ = at(cq, params.cq_off.tail);
+    ring->cqMask_ = at(cq, params.cq_off.ring_mask);
+    ring->cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return ring;
+  }
+
+  ~IoUring() {
+    if (sqes_ != nullptr) {
+      munmap(sqes_, sqesSize_);
+    }
+    if (cqRing_ != MAP_FAILED && cqRing_ != sqRing_) {
+      munmap(cqRing_, cqRingSize_);
+    }
+    if (sqRing_ != MAP_FAILED) {
+      munmap(sqRing_, sqRingSize_);
+    }
+    if (ringFd_ >= 0) {
+      close(ringFd_);
+    }
+  }
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  unsigned numEntries() const { return numEntries_; }
+  bool isBroken() const { return isBroken_; }
+
+  // Perform the `requests` (at most `numEntries()`) on the `fd` and wait until
+  // all of them are completed. For each request, the number of bytes that
+  // were read or the negated `errno` is stored in `results`.
+  void read(int fd, ql::span<const ReadRequest> requests,
+            ql::span<int64_t> results) {
+    AD_CONTRACT_CHECK(requests.size() <= numEntries_);
+    AD_CONTRACT_CHECK(requests.size() == results.size());
+    unsigned tail = *sqTail_;
+    for (size_t i = 0; i < requests.size(); ++i) {
+      const auto& request = requests[i];
+      unsigned index = tail & *sqMask_;
+      io_uring_sqe& sqe = sqes_[index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_READ;
+      sqe.fd = fd;
+      sqe.addr = reinterpret_cast<uint64_t>(request.buffer_);
+      // The length is a 32-bit value. Larger reads are completed by the caller
+      // like any other short read.
+      sqe.len = static_cast<uint32_t>(
+          std::min(request.numBytes_, size_t{1} << 30));
+      sqe.off = static_cast<uint64_t>(request.offset_);
+      sqe.user_data = i;
+      sqArray_[index] = index;
+      ++tail;
+    }
+    __atomic_store_n(sqTail_, tail, __ATOMIC_RELEASE);
+
+    // Submit the entries. If the kernel refuses some of them, they are
+    // reported as failed (and the ring is not reused), but the submitted ones
+    // still have to be awaited, because they write to the buffers.
+    std::fill(results.begin(), results.end(), -EIO);
+    size_t numSubmitted = 0;
+    while (numSubmitted < requests.size()) {
+      int ret = enter(static_cast<unsigned>(requests.size() - numSubmitted), 0,
+                      0);
+      if (ret > 0) {
+        numSubmitted += static_cast<size_t>(ret);
+      } else if (ret == 0 || errno != EINTR) {
+        isBroken_ = true;
+        break;
+      }
+    }
+
+    // All the submitted reads have to be completed before this function
+    // returns or throws, because the kernel writes to the buffers of the
+    // `requests`. The completions are posted to the queue even if waiting for
+    // them fails, so in that case the queue is polled.
+    std::optional<std::string> error;
+    unsigned head = *cqHead_;
+    size_t numCompleted = 0;
+    while (numCompleted < numSubmitted) {
+      if (head == __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE)) {
+        if (error.has_value()) {
+          std::this_thread::yield();
+        } else if (int ret = enter(0, 1, IORING_ENTER_GETEVENTS);
+                   ret < 0 && errno != EINTR && errno != EAGAIN) {
+          error = absl::StrCat("Waiting for io_uring completions failed: ",
+                               strerror(errno));
+          isBroken_ = true;
+        }
+        continue;
+      }
+      const io_uring_cqe& cqe = cqes_[head & *cqMask_];
+      if (cqe.user_data < results.size()) {
+        results[cqe.user_data] = cqe.res;
+      } else if (!error.has_value()) {
+        error = absl::StrCat("Unexpected io_uring completion for request ",
+                             cqe.user_data);
+        isBroken_ = true;
+      }
+      ++head;
+      ++numCompleted;
+      __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+    }
+    if (error.has_value()) {
+      throw std::runtime_error(std::move(error.value()));
+    }
+  }
+
+ private:
+  // Return true iff the kernel supports `IORING_OP_READ`, which was added
+  // after `io_uring` itself (in Linux 5.6, like the probing).
+  bool supportsRead() const {
+    constexpr unsigned numOps = 256;
+    std::vector<char> buffer(sizeof(io_uring_probe) +
+                             numOps * sizeof(io_uring_probe_op));
+    auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+    if (syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_PROBE, probe,
+                numOps) < 0) {
+      return false;
+    }
+    return IORING_OP_READ <= probe->last_op &&
+           (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED);
+  }
+
+  int enter(unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd_, toSubmit,
+                                    minComplete, flags, nullptr, 0));
+  }
+};
+#else
+// Without `io_uring`, no instance is ever created.
+class IoUring {};
+#endif
+}  // namespace detail
+
+// _____________________________________________________________________________
+BatchedFileReader::BatchedFileReader(int fd, std::string filename)
+    : fd_{fd}, filename_{std::move(filename)} {}
+
+// _____________________________________________________________________________
+BatchedFileReader::~BatchedFileReader() {
+  if (directFd_ >= 0) {
+    close(directFd_);
+  }
+}
+
+// _____________________________________________________________________________
+void BatchedFileReader::read(ql::span<const ReadRequest> requests,
+                             Options options) const {
+  if (requests.empty()) {
+    return;
+  }
+  if (options.useDirectIo_ &&
+      readWithDirectIo(requests, options.useIoUring_)) {
+    return;
+  }
+  std::optional<std::vector<int64_t>> results;
+  if (options.useIoUring_) {
+    results = readWithIoUring(fd_, requests);
+  }
+  if (!results.has_value()) {
+    readWithPread(fd_, requests);
+    return;
+  }
+  // `io_uring` may legally return fewer bytes than requested, and a single
+  // request might have failed. The rest is read with `pread`, which throws if
+  // this is impossible.
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const auto& request = requests[i];
+    auto done = static_cast<size_t>(std::max(results.value()[i], int64_t{0}));
+    if (done >= request.numBytes_) {
+      continue;
+    }
+    ReadRequest rest{request.buffer_ + done, request.numBytes_ - done,
+                     request.offset_ + static_cast<off_t>(done)};
+    readWithPread(fd_, {&rest, 1});
+  }
+}
+
+// _____________________________________________________________________________
+bool BatchedFileReader::isIoUringSupported() {
+#ifdef QLEVER_HAS_IO_URING
+  static const bool isSupported = detail::IoUring::create(1) != nullptr;
+  return isSupported;
+#else
+  return false;
+#endif
+}
+
+// _____________________________________________________________________________
+void BatchedFileReader::readWithPread(int fd,
+                                      ql::span<const ReadRequest> requests) {
+  for (const auto& request : requests) {
+    int64_t bytesRead = preadAsMuchAsPossible(fd, request);
+    if (bytesRead < 0) {
+      throwReadError(request, static_cast<int>(-bytesRead));
+    }
+    if (static_cast<size_t>(bytesRead) < request.numBytes_) {
+      throwReadError(request, 0);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<std::vector<int64_t>> BatchedFileReader::readWithIoUring(
+    [[maybe_unused]] int fd,
+    [[maybe_unused]] ql::span<const ReadRequest> requests) const {
+#ifdef QLEVER_HAS_IO_URING
+  // Reuse an idle ring or create a new one.
+  auto ring = [this]() -> std::unique_ptr<detail::IoUring> {
+    {
+      auto idleRings = idleRings_.wlock();
+      if (!idleRings->empty()) {
+        auto ring = std::move(idleRings->back());
+        idleRings->pop_back();
+        return ring;
+      }
+    }
+    return detail::IoUring::create(IO_URING_QUEUE_DEPTH);
+  }();
+  if (ring == nullptr) {
+    static std::once_flag warningIsLogged;
+    std::call_once(warningIsLogged, [] {
+      AD_LOG_WARN << "io_uring is not available or doesn't support "
+                     "IORING_OP_READ (which requires Linux 5.6), the index is "
+                     "read with one pread per block instead"
+                  << std::endl;
+    });
+    return std::nullopt;
+  }
+
+  // A broken ring must not be used for further chunks. It is dropped, and the
+  // requests that were not submitted keep a result of 0 bytes, so the caller
+  // reads them with `pread` like any other short read.
+  std::vector<int64_t> results(requests.size(), 0);
+  ql::span<int64_t> resultSpan{results};
+  for (size_t begin = 0; begin < requests.size();
+       begin += ring->numEntries()) {
+    size_t size = std::min(size_t{ring->numEntries()}, requests.size() - begin);
+    ring->read(fd, requests.subspan(begin, size),
+               resultSpan.subspan(begin, size));
+    if (ring->isBroken()) {
+      return results;
+    }
+  }
+  idleRings_.wlock()->push_back(std::move(ring));
+  return results;
+#else
+  return std::nullopt;
+#endif
+}
+
+// _____________________________________________________________________________
+bool BatchedFileReader::readWithDirectIo(ql::span<const ReadRequest> requests,
+                                         bool useIoUring) const {
+  std::call_once(directFdIsOpened_, [this] {
+    directFd_ = open(filename_.c_str(), O_RDONLY | O_DIRECT);
+    if (directFd_ < 0) {
+      AD_LOG_WARN << "The file \"" << filename_
+                  << "\" can not be opened with O_DIRECT ("
+                  << strerror(errno) << "), it is read via the page cache"
+                  << std::endl;
+    }
+  });
+  if (directFd_ < 0) {
+    return false;
+  }
+
+  // Read the smallest aligned range that contains each request into an
+  // aligned buffer.
+  using Buffer = std::unique_ptr<char, decltype(&std::free)>;
+  std::vector<Buffer> buffers;
+  std::vector<ReadRequest> alignedRequests;
+  buffers.reserve(requests.size());
+  alignedRequests.reserve(requests.size());
+  for (const auto& request : requests) {
+    off_t begin = alignDown(request.offset_);
+    off_t end =
+        alignUp(request.offset_ + static_cast<off_t>(request.numBytes_));
+    auto size = static_cast<size_t>(end - begin);
+    auto* buffer =
+        static_cast<char*>(std::aligned_alloc(DIRECT_IO_ALIGNMENT, size));
+    if (buffer == nullptr) {
+      throw std::bad_alloc{};
+    }
+    buffers.emplace_back(buffer, &std::free);
+    alignedRequests.push_back(ReadRequest{buffer, size, begin});
+  }
+
+  std::optional<std::vector<int64_t>> results;
+  if (useIoUring) {
+    results = readWithIoUring(directFd_, alignedRequests);
+  }
+  if (!results.has_value()) {
+    results.emplace();
+    results->reserve(requests.size());
+    for (const auto& request : alignedRequests) {
+      results->push_back(preadAsMuchAsPossible(directFd_, request));
+    }
+  }
+
+  // The aligned range usually extends beyond the end of the file, so a short
+  // read is fine as long as the requested part is contained. Otherwise (or if
+  // `O_DIRECT` fails for this read), the request is read via the page cache.
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const auto& request = requests[i];
+    const auto& aligned = alignedRequests[i];
+    auto skip = static_cast<size_t>(request.offset_ - aligned.offset_);
+    int64_t needed = static_cast<int64_t>(skip + request.numBytes_);
+    if (results.value()[i] >= needed) {
+      std::memcpy(request.buffer_, aligned.buffer_ + skip, request.numBytes_);
+    } else {
+      readWithPread(fd_, requests.subspan(i, 1));
+    }
+  }
+  return true;
+}
+
+}  // namespace ad_utility
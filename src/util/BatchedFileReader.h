@@ -0,0 +1,118 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_BATCHEDFILEREADER_H
+#define QLEVER_SRC_UTIL_BATCHEDFILEREADER_H
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "backports/span.h"
+#include "util/Synchronized.h"
+
+namespace ad_utility {
+
+namespace detail {
+// A minimal wrapper around an `io_uring` instance of the Linux kernel, see
+// `BatchedFileReader.cpp`. It is only used by the `BatchedFileReader`.
+class IoUring;
+}  // namespace detail
+
+// Read many (typically small and scattered) ranges of a single file at once.
+// With `io_uring` (Linux 5.6 or newer), all the reads of a batch are submitted
+// to the kernel with a single system call and are processed concurrently by
+// the device, without a thread per outstanding read. If `io_uring` is not
+// available (older kernels, other platforms, or disabled by a seccomp filter
+// as in some container runtimes), one `pread` per range is used instead.
+//
+// Optionally, the file is read with `O_DIRECT`, s.t. the data bypasses (and
+// does not evict anything from) the page cache of the operating system. The
+// ranges are then read into aligned temporary buffers and copied to their
+// targets. If the file system does not support `O_DIRECT`, the normal reads
+// are used.
+//
+// The reader is thread-safe. Each concurrent call to `read` uses its own
+// `io_uring` instance, the instances are reused by later calls.
+class BatchedFileReader {
+ public:
+  // Read `numBytes_` bytes starting at `offset_` in the file to `buffer_`.
+  struct ReadRequest {
+    char* buffer_;
+    size_t numBytes_;
+    off_t offset_;
+  };
+
+  // How the reads are performed, see above.
+  struct Options {
+    bool useIoUring_ = true;
+    bool useDirectIo_ = false;
+  };
+
+  // The alignment of the offsets, sizes, and buffers for `O_DIRECT`.
+  static constexpr size_t DIRECT_IO_ALIGNMENT = 4096;
+
+  // The maximal number of reads that are submitted to a single `io_uring`
+  // instance at once. Larger batches are split.
+  static constexpr unsigned IO_URING_QUEUE_DEPTH = 256;
+
+ private:
+  // The file descriptor of the file, which is not owned by this class.
+  int fd_;
+  std::string filename_;
+  // The file descriptor for reading with `O_DIRECT`, which is opened on the
+  // first use. It is -1 if the file can not be opened with `O_DIRECT`.
+  mutable std::once_flag directFdIsOpened_;
+  mutable int directFd_ = -1;
+  // The `io_uring` instances that are currently not in use.
+  mutable Synchronized<std::vector<std::unique_ptr<detail::IoUring>>>
+      idleRings_;
+
+ public:
+  // Read from the file descriptor `fd` of the file with the given `filename`.
+  // The `fd` has to stay valid for the lifetime of this object. The `filename`
+  // is only needed for `O_DIRECT`.
+  BatchedFileReader(int fd, std::string filename);
+  ~BatchedFileReader();
+
+  BatchedFileReader(const BatchedFileReader&) = delete;
+  BatchedFileReader& operator=(const BatchedFileReader&) = delete;
+
+  // Perform all the `requests` and return when they are completed. Throw if
+  // one of the ranges can not be read completely (for example, because it is
+  // beyond the end of the file).
+  void read(ql::span<const ReadRequest> requests, Options options) const;
+
+  // Return true iff `io_uring` can be used on this system. The result is
+  // computed on the first call.
+  static bool isIoUringSupported();
+
+ private:
+  // Read the `requests` with one `pread` each from the `fd`.
+  static void readWithPread(int fd, ql::span<const ReadRequest> requests);
+
+  // Submit the `requests` for the `fd` to `io_uring` and wait for their
+  // completion. Return the number of bytes that were read for each request
+  // (which might be less than requested) or the negated `errno` of a failed
+  // read. Return `std::nullopt` if `io_uring` can not be used, then nothing
+  // has been read.
+  std::optional<std::vector<int64_t>> readWithIoUring(
+      int fd, ql::span<const ReadRequest> requests) const;
+
+  // Read the `requests` with `O_DIRECT` (via `io_uring` if `useIoUring`).
+  // Return false if the file can not be opened with `O_DIRECT`.
+  bool readWithDirectIo(ql::span<const ReadRequest> requests,
+                        bool useIoUring) const;
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_BATCHEDFILEREADER_H
@@ -0,0 +1,191 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_BITPACKING_H
+#define QLEVER_SRC_UTIL_BITPACKING_H
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "backports/algorithm.h"
+#include "backports/span.h"
+#include "util/BitUtils.h"
+#include "util/Exception.h"
+
+namespace ad_utility {
+
+// A lightweight compression scheme for sequences of 64-bit integers with a
+// small range ("frame of reference", FOR), optionally combined with delta
+// encoding for non-decreasing sequences. All values are stored relative to a
+// common reference value with the same (minimal) number of bits per value,
+// and densely packed into 64-bit words. Compared to general-purpose
+// compressors like zstd, the decoding is very fast (a few shifts and masks per
+// value), and for sorted sequences (like the first columns of a permutation)
+// the compression is often better.
+//
+// The encoded format is a header of `HEADER_SIZE` bytes, followed by the
+// packed words:
+//   - 8 bytes: the first value (only used for delta encoding)
+//   - 8 bytes: the reference value that is added to each unpacked value
+//   - 1 byte: the number of bits per packed value (0 to 64)
+//   - 1 byte: 1 if the values are delta-encoded, else 0
+//   - padding up to `HEADER_SIZE` bytes
+class BitPacking {
+ public:
+  static constexpr size_t HEADER_SIZE = 24;
+
+ private:
+  // Read/write a `uint64_t` from/to a possibly unaligned address.
+  static uint64_t load(const char* ptr) {
+    uint64_t result;
+    std::memcpy(&result, ptr, sizeof(result));
+    return result;
+  }
+  static void store(char* ptr, uint64_t value) {
+    std::memcpy(ptr, &value, sizeof(value));
+  }
+
+  // Pack the `values` (which all must fit into `numBits` bits) densely into
+  // the buffer starting at `target`.
+  static void pack(const std::vector<uint64_t>& values, uint8_t numBits,
+                   char* target) {
+    if (numBits == 0) {
+      return;
+    }
+    size_t numWords = numWordsRequired(values.size(), numBits);
+    std::vector<uint64_t> words(numWords, 0);
+    for (size_t i = 0; i < values.size(); ++i) {
+      size_t bitPos = i * numBits;
+      size_t word = bitPos / 64;
+      size_t offset = bitPos % 64;
+      words[word] |= values[i] << offset;
+      if (offset + numBits > 64) {
+        words[word + 1] |= values[i] >> (64 - offset);
+      }
+    }
+    std::memcpy(target, words.data(), numWords * sizeof(uint64_t));
+  }
+
+  // Unpack the `i`-th value from the packed words that start at `source`.
+  static uint64_t unpack(const char* source, size_t i, uint8_t numBits,
+                         uint64_t mask) {
+    // For a width of zero, there are no packed words at all.
+    if (numBits == 0) {
+      return 0;
+    }
+    size_t bitPos = i * numBits;
+    size_t word = bitPos / 64;
+    size_t offset = bitPos % 64;
+    uint64_t value = load(source + word * sizeof(uint64_t)) >> offset;
+    if (offset + numBits > 64) {
+      value |= load(source + (word + 1) * sizeof(uint64_t)) << (64 - offset);
+    }
+    return value & mask;
+  }
+
+  static size_t numWordsRequired(size_t numValues, uint8_t numBits) {
+    return (numValues * numBits + 63) / 64;
+  }
+
+ public:
+  // Encode the `values`. Delta encoding is used if the `values` are sorted
+  // and it leads to a smaller result.
+  static std::vector<char> encode(ql::span<const uint64_t> values) {
+    uint64_t first = values.empty() ? 0 : values.front();
+    // Compute the width that is required without delta encoding.
+    auto [minIt, maxIt] = ql::ranges::minmax_element(values);
+    uint64_t reference = values.empty() ? 0 : *minIt;
+    uint8_t numBits = static_cast<uint8_t>(
+        values.empty() ? 0 : std::bit_width(*maxIt - reference));
+
+    // Compute the width that is required with delta encoding.
+    bool isDelta = false;
+    if (values.size() > 1 && ql::ranges::is_sorted(values)) {
+      uint64_t minDelta = std::numeric_limits<uint64_t>::max();
+      uint64_t maxDelta = 0;
+      for (size_t i = 1; i < values.size(); ++i) {
+        uint64_t delta = values[i] - values[i - 1];
+        minDelta = std::min(minDelta, delta);
+        maxDelta = std::max(maxDelta, delta);
+      }
+      auto numBitsDelta =
+          static_cast<uint8_t>(std::bit_width(maxDelta - minDelta));
+      if (numWordsRequired(values.size() - 1, numBitsDelta) <
+          numWordsRequired(values.size(), numBits)) {
+        isDelta = true;
+        reference = minDelta;
+        numBits = numBitsDelta;
+      }
+    }
+
+    std::vector<uint64_t> packedValues;
+    if (isDelta) {
+      packedValues.reserve(values.size() - 1);
+      for (size_t i = 1; i < values.size(); ++i) {
+        packedValues.push_back(values[i] - values[i - 1] - reference);
+      }
+    } else {
+      packedValues.reserve(values.size());
+      for (uint64_t value : values) {
+        packedValues.push_back(value - reference);
+      }
+    }
+
+    std::vector<char> result(
+        HEADER_SIZE +
+        numWordsRequired(packedValues.size(), numBits) * sizeof(uint64_t));
+    store(result.data(), first);
+    store(result.data() + 8, reference);
+    result[16] = static_cast<char>(numBits);
+    result[17] = static_cast<char>(isDelta);
+    pack(packedValues, numBits, result.data() + HEADER_SIZE);
+    return result;
+  }
+
+  // Decode the `numValues` values from the `encoded` bytes (which must have
+  // been created by `encode` above) and write them to `target`. Each decoded
+  // value is converted by `makeValue` before it is written, e.g. to directly
+  // decode the bit representations of `Id`s.
+  template <typename T, typename MakeValue = std::identity>
+  static void decode(ql::span<const char> encoded, size_t numValues,
+                     T* target, MakeValue makeValue = {}) {
+    AD_CONTRACT_CHECK(encoded.size() >= HEADER_SIZE);
+    uint64_t first = load(encoded.data());
+    uint64_t reference = load(encoded.data() + 8);
+    auto numBits = static_cast<uint8_t>(encoded[16]);
+    bool isDelta = encoded[17] != 0;
+    AD_CONTRACT_CHECK(numBits <= 64);
+    size_t numPackedValues =
+        isDelta && numValues > 0 ? numValues - 1 : numValues;
+    AD_CONTRACT_CHECK(encoded.size() ==
+                      HEADER_SIZE + numWordsRequired(numPackedValues, numBits) *
+                                        sizeof(uint64_t));
+    const char* packed = encoded.data() + HEADER_SIZE;
+    uint64_t mask = bitMaskForLowerBits(numBits);
+    if (!isDelta) {
+      for (size_t i = 0; i < numValues; ++i) {
+        target[i] = makeValue(reference + unpack(packed, i, numBits, mask));
+      }
+      return;
+    }
+    if (numValues == 0) {
+      return;
+    }
+    uint64_t current = first;
+    target[0] = makeValue(current);
+    for (size_t i = 1; i < numValues; ++i) {
+      current += reference + unpack(packed, i - 1, numBits, mask);
+      target[i] = makeValue(current);
+    }
+  }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_BITPACKING_H
@@ -9,6 +9,7 @@
 
 #include <cassert>
 #include <concepts>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -202,6 +203,18 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     return valPtr;
   }
 
+  // The type of the function that is called for each entry that is evicted.
+  using EvictionCallback =
+      std::function<void(const Key&, const std::shared_ptr<const Value>&)>;
+
+  // Set the function that is called for each (non-pinned) entry that is
+  // removed from the cache to make room for other entries or because the
+  // capacity was reduced. It is not called when entries are explicitly erased,
+  // the cache is cleared, or entries are removed by `makeRoomAsMuchAsPossible`.
+  void setEvictionCallback(EvictionCallback evictionCallback) {
+    _evictionCallback = std::move(evictionCallback);
+  }
+
   //! Set or change the maximum number of entries
   void setMaxNumEntries(const size_t maxNumEntries) {
     _maxNumEntries = maxNumEntries;
@@ -365,7 +378,8 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   // Delete entries of a total size of at least `sizeToMakeRoomFor` from the
   // cache. If this is not possible, the cache is cleared (only unpinned
   // elements), and false is returned. This possibly results in some freed
-  // space, but less than requested.
+  // space, but less than requested. The entries are deleted to free memory, so
+  // the eviction callback is not called (it might keep them alive).
   bool makeRoomAsMuchAsPossible(MemorySize sizeToMakeRoomFor) {
     if (sizeToMakeRoomFor > _totalSizeNonPinned) {
       clearUnpinnedOnly();
@@ -373,7 +387,7 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
     }
     MemorySize targetSize = _totalSizeNonPinned - sizeToMakeRoomFor;
     while (!_entries.empty() && _totalSizeNonPinned > targetSize) {
-      removeOneEntry();
+      removeOneEntry(false);
     }
     return true;
   }
@@ -381,12 +395,15 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
  private:
   // Removes the entry with the smallest score from the cache.
   // Precondition: The cache must not be empty.
-  void removeOneEntry() {
+  void removeOneEntry(bool callEvictionCallback = true) {
     AD_CONTRACT_CHECK(!_entries.empty());
     auto handle = _entries.pop();
     _totalSizeNonPinned =
         _totalSizeNonPinned - _valueSizeGetter(*handle.value().value());
     _accessMap.erase(handle.value().key());
+    if (callEvictionCallback && _evictionCallback) {
+      _evictionCallback(handle.value().key(), handle.value().value());
+    }
   }
   size_t _maxNumEntries;
   MemorySize _maxSize;
@@ -401,6 +418,7 @@ CPP_template(template <typename Sc, typename Val, typename Comp>
   ValueSizeGetterT _valueSizeGetter;
   PinnedMap _pinnedMap;
   AccessMap _accessMap;
+  EvictionCallback _evictionCallback;
 };
 
 // Partial instantiation of FlexibleCache using the heap-based priority queue
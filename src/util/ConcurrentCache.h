@@ -324,6 +324,15 @@ class ConcurrentCache {
     return _cacheAndInProgressMap.wlock()->_cache.getMaxSizeSingleEntry();
   }
 
+  // Set the function that is called for each entry that is evicted from the
+  // cache, see `FlexibleCache::setEvictionCallback`. The function is called
+  // while the cache is locked, so it has to be cheap and must not access this
+  // cache.
+  void setEvictionCallback(typename Cache::EvictionCallback evictionCallback) {
+    _cacheAndInProgressMap.wlock()->_cache.setEvictionCallback(
+        std::move(evictionCallback));
+  }
+
  private:
   using ResultInProgress = ConcurrentCacheDetail::ResultInProgress<Value>;
 
@@ -97,6 +97,15 @@ class File {
   //! checks if the file is open.
   [[nodiscard]] bool isOpen() const { return (file_ != NULL); }
 
+  // The name of the file, as it was passed to the constructor or `open`.
+  [[nodiscard]] const string& name() const { return name_; }
+
+  // The file descriptor of the open file, e.g. for `pread` or `io_uring`.
+  [[nodiscard]] int getFileDescriptor() const {
+    assert(file_);
+    return fileno(file_);
+  }
+
   //! Close file.
   bool close() {
     if (not isOpen()) {
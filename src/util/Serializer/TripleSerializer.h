@@ -24,6 +24,12 @@
 
 namespace ad_utility {
 
+// The mapping from the blank nodes that are stored in a file to the blank
+// nodes that are created when reading the file. All the blank nodes of a
+// single file (or of several files that were written by the same process)
+// have to be mapped consistently.
+using BlankNodeMapping = absl::flat_hash_map<Id, BlankNodeIndex>;
+
 namespace detail {
 
 constexpr std::array magicBytes{'Q', 'L', 'E', 'V', 'E', 'R', '.',
@@ -76,6 +82,21 @@ CPP_template(typename Serializer)(
   });
 }
 
+// Serialize only the given `entries` (a range of `LocalVocabIndex`es) of a
+// local vocabulary to the output stream, in the same format as
+// `serializeLocalVocab` above.
+CPP_template(typename Serializer, typename Range)(
+    requires serialization::WriteSerializer<Serializer> CPP_and
+        ql::ranges::forward_range<
+            Range>) void serializeLocalVocabEntries(Serializer& serializer,
+                                                    const Range& entries) {
+  serializer << uint64_t{static_cast<uint64_t>(ql::ranges::distance(entries))};
+  for (LocalVocabIndex entry : entries) {
+    serializer << Id::makeFromLocalVocabIndex(entry);
+    serializer << entry->toStringRepresentation();
+  }
+}
+
 // Deserialize the local vocabulary from the input stream.
 CPP_template(typename Serializer)(
     requires serialization::ReadSerializer<Serializer>) std::
@@ -112,15 +133,16 @@ CPP_template(typename Range, typename Serializer)(
 }
 
 // Deserialize a range of Ids from the input stream. If an Id is of type
-// LocalVocabIndex, apply the mapping to the Id after reading it.
+// LocalVocabIndex, apply the mapping to the Id after reading it. Blank nodes
+// are mapped via the `blankNodeMapping`, new blank nodes are created using
+// `newBlankNodeIndex`.
 CPP_template(typename Serializer, typename BlankNodeFunc)(
     requires ad_utility::InvocableWithConvertibleReturnType<BlankNodeFunc,
                                                             BlankNodeIndex>)
     std::vector<Id> deserializeIds(
         Serializer& serializer, const absl::flat_hash_map<Id::T, Id>& mapping,
-        BlankNodeFunc newBlankNodeIndex) {
+        BlankNodeMapping& blankNodeMapping, BlankNodeFunc newBlankNodeIndex) {
   std::vector<Id> ids = readValue<std::vector<Id>>(serializer);
-  absl::flat_hash_map<Id, BlankNodeIndex> blankNodeMapping;
   for (Id& id : ids) {
     if (id.getDatatype() == Datatype::LocalVocabIndex) {
       id = mapping.at(id.getBits());
@@ -149,8 +171,16 @@ CPP_template(typename Range)(
   }
 }
 
-inline std::tuple<LocalVocab, std::vector<std::vector<Id>>> deserializeIds(
-    const std::filesystem::path& path, BlankNodeManager* blankNodeManager) {
+// Read the local vocabulary and the ranges of Ids that were written by
+// `serializeIds` above. The blank nodes are consistently mapped via the
+// `blankNodeMapping`, new blank nodes are created via `newBlankNodeIndex`. If
+// the file does not exist, an empty result is returned.
+CPP_template(typename BlankNodeFunc)(
+    requires ad_utility::InvocableWithConvertibleReturnType<BlankNodeFunc,
+                                                            BlankNodeIndex>)
+    std::tuple<LocalVocab, std::vector<std::vector<Id>>> deserializeIds(
+        const std::filesystem::path& path, BlankNodeMapping& blankNodeMapping,
+        BlankNodeFunc newBlankNodeIndex) {
   // This is a minor TOCTOU issue, the file might be gone after this check and
   // before the call to `fopen`, done by `FileReadSerializer`, so ideally we'd
   // handle this as a special exception type of our own `File` class, which
@@ -177,10 +207,25 @@ inline std::tuple<LocalVocab, std::vector<std::vector<Id>>> deserializeIds(
   auto numRanges = detail::readValue<uint64_t>(serializer);
   for ([[maybe_unused]] auto i : ad_utility::integerRange(numRanges)) {
     idVectors.push_back(detail::deserializeIds(
-        serializer, mapping, [blankNodeManager, &vocab]() {
-          return vocab.getBlankNodeIndex(blankNodeManager);
-        }));
+        serializer, mapping, blankNodeMapping, newBlankNodeIndex));
   }
   return {std::move(vocab), std::move(idVectors)};
 }
+
+// Same as above, but the blank nodes are created in the returned `LocalVocab`
+// using the given `blankNodeManager`.
+inline std::tuple<LocalVocab, std::vector<std::vector<Id>>> deserializeIds(
+    const std::filesystem::path& path, BlankNodeManager* blankNodeManager) {
+  BlankNodeMapping blankNodeMapping;
+  // The blank nodes have to be created in the `LocalVocab` that is returned,
+  // but this vocab is only created while reading the file. We therefore first
+  // create them in a separate vocab and then merge it into the result.
+  LocalVocab blankNodeVocab;
+  auto result = deserializeIds(
+      path, blankNodeMapping, [blankNodeManager, &blankNodeVocab]() {
+        return blankNodeVocab.getBlankNodeIndex(blankNodeManager);
+      });
+  std::get<LocalVocab>(result).mergeWith(blankNodeVocab);
+  return result;
+}
 }  // namespace ad_utility
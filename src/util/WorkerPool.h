@@ -0,0 +1,153 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_WORKERPOOL_H
+#define QLEVER_SRC_UTIL_WORKERPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "util/jthread.h"
+
+namespace ad_utility {
+
+// A pool of worker threads that is shared by the operations that split their
+// computation into several tasks that can run concurrently (instead of each
+// computation starting its own threads). The calling thread of
+// `runInParallel` also works on the tasks, so a computation makes progress
+// even when all the workers are busy with other computations, and nested
+// calls of `runInParallel` cannot deadlock.
+class WorkerPool {
+ private:
+  std::mutex mutex_;
+  std::condition_variable jobAvailable_;
+  std::deque<std::function<void()>> jobs_;
+  bool shutdown_ = false;
+  // Declared last, s.t. the workers are joined before the other members are
+  // destroyed.
+  std::vector<JThread> workers_;
+
+ public:
+  explicit WorkerPool(size_t numWorkers) {
+    workers_.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+      workers_.emplace_back([this]() { workerLoop(); });
+    }
+  }
+
+  // Finish all the jobs that were already posted and join the workers.
+  ~WorkerPool() {
+    {
+      std::lock_guard lock{mutex_};
+      shutdown_ = true;
+    }
+    jobAvailable_.notify_all();
+    workers_.clear();
+  }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  size_t numWorkers() const { return workers_.size(); }
+
+  // The pool that is shared by all the queries, with one worker per hardware
+  // thread.
+  static WorkerPool& global() {
+    static WorkerPool pool{
+        std::max(size_t{std::thread::hardware_concurrency()}, size_t{1})};
+    return pool;
+  }
+
+  // Call `task(i)` for all `i` in `[0, numTasks)` and return when all the
+  // calls have finished. The calls are distributed between the calling
+  // thread and (at most `numTasks - 1`) workers of the pool, so the tasks
+  // must not wait for each other. If one of the calls throws, the remaining
+  // tasks are still run and the first exception is rethrown afterwards.
+  template <typename Task>
+  void runInParallel(size_t numTasks, const Task& task) {
+    if (numTasks == 0) {
+      return;
+    }
+    // The state is shared with the helpers that are posted to the pool, some
+    // of which may only start after all the tasks are finished.
+    struct State {
+      std::atomic<size_t> nextTask_ = 0;
+      std::mutex mutex_;
+      std::condition_variable allFinished_;
+      size_t numFinished_ = 0;
+      std::exception_ptr exception_;
+    };
+    auto state = std::make_shared<State>();
+    // Claim and run tasks until there are none left. The `task` is only
+    // accessed for a claimed task, for which the caller is still waiting.
+    auto work = [state, numTasks, &task]() {
+      for (size_t i = state->nextTask_++; i < numTasks;
+           i = state->nextTask_++) {
+        std::exception_ptr exception;
+        try {
+          task(i);
+        } catch (...) {
+          exception = std::current_exception();
+        }
+        std::lock_guard lock{state->mutex_};
+        if (exception && !state->exception_) {
+          state->exception_ = std::move(exception);
+        }
+        if (++state->numFinished_ == numTasks) {
+          state->allFinished_.notify_all();
+        }
+      }
+    };
+    size_t numHelpers = std::min(numTasks - 1, workers_.size());
+    if (numHelpers > 0) {
+      {
+        std::lock_guard lock{mutex_};
+        for (size_t i = 0; i < numHelpers; ++i) {
+          jobs_.emplace_back(work);
+        }
+      }
+      jobAvailable_.notify_all();
+    }
+    work();
+    std::unique_lock lock{state->mutex_};
+    state->allFinished_.wait(
+        lock, [&state, numTasks]() { return state->numFinished_ == numTasks; });
+    if (state->exception_) {
+      std::rethrow_exception(state->exception_);
+    }
+  }
+
+ private:
+  // Run the posted jobs until the pool is destroyed.
+  void workerLoop() {
+    while (true) {
+      std::function<void()> job;
+      {
+        std::unique_lock lock{mutex_};
+        jobAvailable_.wait(lock,
+                           [this]() { return shutdown_ || !jobs_.empty(); });
+        if (jobs_.empty()) {
+          return;
+        }
+        job = std::move(jobs_.front());
+        jobs_.pop_front();
+      }
+      job();
+    }
+  }
+};
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_WORKERPOOL_H
@@ -29,7 +29,8 @@ enum class MediaType {
   csv,
   turtle,
   ntriples,
-  octetStream
+  octetStream,
+  arrowStream
 };
 
 struct MediaTypeWithQuality {
@@ -37,6 +37,10 @@ TEST(AcceptHeaderParser, singleType) {
   auto c = parseAcceptHeader("application/json");
   ASSERT_EQ(c.size(), 1u);
   ASSERT_EQ(c[0], MediaType::json);
+
+  c = parseAcceptHeader("application/vnd.apache.arrow.stream");
+  ASSERT_EQ(c.size(), 1u);
+  ASSERT_EQ(c[0], MediaType::arrowStream);
 }
 
 TEST(AcceptHeaderParser, multipleTypes) {
@@ -0,0 +1,265 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "util/ArrowIpc.h"
+#include "util/ArrowIpcTestHelpers.h"
+
+using namespace ad_utility::arrow;
+using namespace ad_utility::testing::arrow;
+
+// _____________________________________________________________________________
+TEST(ArrowIpc, schema) {
+  auto stream = schemaMessage({{"a", ColumnType::Int64},
+                               {"b", ColumnType::Float64},
+                               {"c", ColumnType::Bool},
+                               {"d", ColumnType::Timestamp},
+                               {"e", ColumnType::String}}) +
+                endOfStreamMessage();
+  auto messages = parseStream(stream);
+  ASSERT_EQ(messages.size(), 1u);
+  EXPECT_EQ(messages[0].headerType(), 1);
+  EXPECT_TRUE(messages[0].body_.empty());
+
+  auto fields = messages[0].header().tables(1);
+  ASSERT_EQ(fields.size(), 5u);
+  std::vector<std::string_view> names;
+  std::vector<uint8_t> typeIds;
+  for (const auto& field : fields) {
+    names.push_back(field.string(0));
+    EXPECT_TRUE(field.scalar<bool>(1));
+    typeIds.push_back(field.scalar<uint8_t>(2));
+    EXPECT_TRUE(field.has(3));
+    EXPECT_TRUE(field.tables(5).empty());
+  }
+  EXPECT_THAT(names, ::testing::ElementsAre("a", "b", "c", "d", "e"));
+  EXPECT_THAT(typeIds, ::testing::ElementsAre(2, 3, 6, 10, 5));
+
+  // Signed 64-bit integers.
+  EXPECT_EQ(fields[0].table(3).scalar<int32_t>(0), 64);
+  EXPECT_TRUE(fields[0].table(3).scalar<bool>(1));
+  // Double precision.
+  EXPECT_EQ(fields[1].table(3).scalar<int16_t>(0), 2);
+  // Milliseconds in UTC.
+  EXPECT_EQ(fields[3].table(3).scalar<int16_t>(0), 1);
+  EXPECT_EQ(fields[3].table(3).string(1), "UTC");
+
+  // Only the string column is dictionary-encoded (with 32-bit indices), the
+  // id of the dictionary is the index of the column.
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_FALSE(fields[i].has(4));
+  }
+  auto dictionary = fields[4].table(4);
+  EXPECT_EQ(dictionary.scalar<int64_t>(0), 4);
+  EXPECT_EQ(dictionary.table(1).scalar<int32_t>(0), 32);
+}
+
+// _____________________________________________________________________________
+TEST(ArrowIpc, recordBatch) {
+  std::vector<ColumnBuilder> columns;
+  for (auto type : {ColumnType::Int64, ColumnType::Float64, ColumnType::Bool,
+                    ColumnType::Timestamp, ColumnType::String}) {
+    columns.emplace_back(type);
+  }
+  columns[0].appendInt(-1);
+  columns[0].appendNull();
+  columns[0].appendInt(3);
+  columns[1].appendDouble(0.5);
+  columns[1].appendDouble(1.5);
+  columns[1].appendNull();
+  columns[2].appendBool(true);
+  columns[2].appendNull();
+  columns[2].appendBool(false);
+  columns[3].appendNull();
+  columns[3].appendTimestamp(1000);
+  columns[3].appendTimestamp(-1000);
+  columns[4].appendString("x");
+  columns[4].appendString("yz");
+  columns[4].appendString("x");
+  EXPECT_ANY_THROW(columns[4].appendInt(42));
+
+  auto messages = parseStream(recordBatchMessages(columns) +
+                              endOfStreamMessage());
+  ASSERT_EQ(messages.size(), 2u);
+
+  // The dictionary of the string column.
+  const auto& dictionaryMessage = messages[0];
+  EXPECT_EQ(dictionaryMessage.headerType(), 2);
+  auto dictionaryBatch = dictionaryMessage.header();
+  EXPECT_EQ(dictionaryBatch.scalar<int64_t>(0), 4);
+  EXPECT_FALSE(dictionaryBatch.scalar<bool>(2));
+  auto dictionaryData = dictionaryBatch.table(1);
+  EXPECT_EQ(dictionaryData.scalar<int64_t>(0), 2);
+  auto offsets = dictionaryMessage.buffer(dictionaryData, 1);
+  ASSERT_EQ(offsets.size(), 3 * sizeof(int32_t));
+  EXPECT_EQ(value<int32_t>(offsets, 0), 0);
+  EXPECT_EQ(value<int32_t>(offsets, 1), 1);
+  EXPECT_EQ(value<int32_t>(offsets, 2), 3);
+  EXPECT_EQ(dictionaryMessage.buffer(dictionaryData, 2), "xyz");
+
+  // The record batch itself.
+  const auto& batchMessage = messages[1];
+  EXPECT_EQ(batchMessage.headerType(), 3);
+  auto batch = batchMessage.header();
+  EXPECT_EQ(batch.scalar<int64_t>(0), 3);
+  using Node = std::array<int64_t, 2>;
+  EXPECT_THAT(batch.structs(1),
+              ::testing::ElementsAre(Node{3, 1}, Node{3, 1}, Node{3, 1},
+                                     Node{3, 1}, Node{3, 0}));
+  // Two buffers (validity and values) per column.
+  ASSERT_EQ(batch.structs(2).size(), 10u);
+  auto validity = [&](size_t column) {
+    auto buffer = batchMessage.buffer(batch, 2 * column);
+    return std::vector<bool>{bit(buffer, 0), bit(buffer, 1), bit(buffer, 2)};
+  };
+  auto values = [&](size_t column) {
+    return batchMessage.buffer(batch, 2 * column + 1);
+  };
+  EXPECT_THAT(validity(0), ::testing::ElementsAre(true, false, true));
+  EXPECT_EQ(value<int64_t>(values(0), 0), -1);
+  EXPECT_EQ(value<int64_t>(values(0), 2), 3);
+  EXPECT_THAT(validity(1), ::testing::ElementsAre(true, true, false));
+  EXPECT_EQ(value<double>(values(1), 0), 0.5);
+  EXPECT_EQ(value<double>(values(1), 1), 1.5);
+  EXPECT_THAT(validity(2), ::testing::ElementsAre(true, false, true));
+  EXPECT_TRUE(bit(values(2), 0));
+  EXPECT_FALSE(bit(values(2), 2));
+  EXPECT_THAT(validity(3), ::testing::ElementsAre(false, true, true));
+  EXPECT_EQ(value<int64_t>(values(3), 1), 1000);
+  EXPECT_EQ(value<int64_t>(values(3), 2), -1000);
+  EXPECT_THAT(validity(4), ::testing::ElementsAre(true, true, true));
+  EXPECT_EQ(value<int32_t>(values(4), 0), 0);
+  EXPECT_EQ(value<int32_t>(values(4), 1), 1);
+  EXPECT_EQ(value<int32_t>(values(4), 2), 0);
+
+  // After clearing, the columns (and dictionaries) are empty.
+  for (auto& column : columns) {
+    column.clear();
+    EXPECT_EQ(column.numRows(), 0u);
+    EXPECT_EQ(column.nullCount(), 0u);
+  }
+  EXPECT_TRUE(columns[4].dictionary().empty());
+  messages = parseStream(recordBatchMessages(columns) + endOfStreamMessage());
+  ASSERT_EQ(messages.size(), 2u);
+  EXPECT_EQ(messages[1].header().scalar<int64_t>(0), 0);
+}
+
+// _____________________________________________________________________________
+TEST(ArrowIpc, sameAsPyarrow) {
+  // A stream written by pyarrow 26.0.0 for the same schema and values as the
+  // stream below, produced with
+  //
+  //   schema = pa.schema([("a", pa.int64()), ("b", pa.float64()),
+  //                       ("c", pa.bool_()),
+  //                       ("d", pa.timestamp("ms", tz="UTC")),
+  //                       ("e", pa.dictionary(pa.int32(), pa.string()))])
+  //   with pa.ipc.new_stream(sink, schema) as writer:
+  //     writer.write_batch(<the first batch>)
+  //     writer.write_batch(<the second batch>)
+  std::string_view pyarrowHex =
+    "ffffffff680100001000000000000a000c000600050008000a00000000010400"
+    "04000000acffffff040000000500000008010000c80000009c0000005c000000"
+    "14000000100018000800060007000c0010001400100000000000010514000000"
+    "340000001c000000040000000000000001000000650000000800080000000400"
+    "080000000400000030ffffff0000000120000000a0ffffff70ffffff0000010a"
+    "100000001c0000000400000000000000010000006400000008000c0006000800"
+    "0800000000000100040000000300000055544300acffffff0000010610000000"
+    "18000000040000000000000001000000630000000400040004000000d4ffffff"
+    "0000010310000000180000000400000000000000010000006200060008000600"
+    "0600000000000200100014000800060007000c00000010001000000000000102"
+    "100000001c0000000400000000000000010000006100000008000c0008000700"
+    "08000000000000014000000000000000ffffffffa80000001400000000000000"
+    "0c0014000600050008000c000c00000000020400140000001800000000000000"
+    "08000a0000000400080000001000000000000a0018000c00040008000a000000"
+    "4c00000010000000020000000000000000000000030000000000000000000000"
+    "000000000000000000000000000000000c000000000000001000000000000000"
+    "0300000000000000000000000100000002000000000000000000000000000000"
+    "0000000001000000030000000000000078797a0000000000ffffffff48010000"
+    "14000000000000000c0016000600050008000c000c0000000003040018000000"
+    "800000000000000000000a0018000c00040008000a000000bc00000010000000"
+    "0300000000000000000000000a00000000000000000000000100000000000000"
+    "0800000000000000180000000000000020000000000000000100000000000000"
+    "2800000000000000180000000000000040000000000000000100000000000000"
+    "4800000000000000010000000000000050000000000000000100000000000000"
+    "5800000000000000180000000000000070000000000000000000000000000000"
+    "70000000000000000c0000000000000000000000050000000300000000000000"
+    "0100000000000000030000000000000001000000000000000300000000000000"
+    "0100000000000000030000000000000001000000000000000300000000000000"
+    "00000000000000000500000000000000ffffffffffffffff0000000000000000"
+    "03000000000000000300000000000000000000000000e03f000000000000f83f"
+    "0000000000000000050000000000000001000000000000000600000000000000"
+    "0000000000000000e80300000000000018fcffffffffffff0000000001000000"
+    "0000000000000000ffffffffa800000014000000000000000c00140006000500"
+    "08000c000c0000000002040014000000100000000000000008000a0000000400"
+    "080000001000000000000a0018000c00040008000a0000004c00000010000000"
+    "0100000000000000000000000300000000000000000000000000000000000000"
+    "0000000000000000080000000000000008000000000000000100000000000000"
+    "0000000001000000010000000000000000000000000000000000000001000000"
+    "7700000000000000ffffffff4801000014000000000000000c00160006000500"
+    "08000c000c0000000003040018000000300000000000000000000a0018000c00"
+    "040008000a000000bc000000100000000100000000000000000000000a000000"
+    "0000000000000000000000000000000000000000000000000800000000000000"
+    "0800000000000000010000000000000010000000000000000800000000000000"
+    "1800000000000000000000000000000018000000000000000100000000000000"
+    "2000000000000000000000000000000020000000000000000800000000000000"
+    "2800000000000000000000000000000028000000000000000400000000000000"
+    "0000000005000000010000000000000000000000000000000100000000000000"
+    "0100000000000000010000000000000000000000000000000100000000000000"
+    "0000000000000000010000000000000000000000000000000700000000000000"
+    "0000000000000000000000000000000001000000000000000000000000000000"
+    "0000000000000000ffffffff00000000";
+  std::string pyarrowStream;
+  for (size_t i = 0; i < pyarrowHex.size(); i += 2) {
+    pyarrowStream.push_back(static_cast<char>(
+        std::stoi(std::string{pyarrowHex.substr(i, 2)}, nullptr, 16)));
+  }
+
+  std::vector<ColumnBuilder> columns;
+  for (auto type : {ColumnType::Int64, ColumnType::Float64, ColumnType::Bool,
+                    ColumnType::Timestamp, ColumnType::String}) {
+    columns.emplace_back(type);
+  }
+  auto stream = schemaMessage({{"a", ColumnType::Int64},
+                               {"b", ColumnType::Float64},
+                               {"c", ColumnType::Bool},
+                               {"d", ColumnType::Timestamp},
+                               {"e", ColumnType::String}});
+  columns[0].appendInt(-1);
+  columns[0].appendNull();
+  columns[0].appendInt(3);
+  columns[1].appendDouble(0.5);
+  columns[1].appendDouble(1.5);
+  columns[1].appendNull();
+  columns[2].appendBool(true);
+  columns[2].appendNull();
+  columns[2].appendBool(false);
+  columns[3].appendNull();
+  columns[3].appendTimestamp(1000);
+  columns[3].appendTimestamp(-1000);
+  columns[4].appendString("x");
+  columns[4].appendString("yz");
+  columns[4].appendString("x");
+  stream += recordBatchMessages(columns);
+  for (auto& column : columns) {
+    column.clear();
+  }
+  columns[0].appendInt(7);
+  columns[1].appendNull();
+  columns[2].appendBool(true);
+  columns[3].appendTimestamp(0);
+  columns[4].appendString("w");
+  stream += recordBatchMessages(columns);
+  stream += endOfStreamMessage();
+
+  using C = std::vector<std::string>;
+  DecodedStream expected{
+      {C{"-1", "null", "3"}, C{"0.500000", "1.500000", "null"},
+       C{"true", "null", "false"}, C{"null", "1000", "-1000"},
+       C{"x", "yz", "x"}},
+      {C{"7"}, C{"null"}, C{"true"}, C{"0"}, C{"w"}}};
+  EXPECT_EQ(decodeStream(pyarrowStream), expected);
+  EXPECT_EQ(decodeStream(stream), expected);
+}
@@ -0,0 +1,80 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <string>
+#include <vector>
+
+#include "./util/GTestHelpers.h"
+#include "util/BatchedFileReader.h"
+#include "util/File.h"
+
+using ad_utility::BatchedFileReader;
+using ReadRequest = BatchedFileReader::ReadRequest;
+
+namespace {
+// Write a file with `size` bytes of (not completely regular) content and return
+// the content.
+std::string writeTestFile(const std::string& filename, size_t size) {
+  std::string content;
+  content.reserve(size);
+  for (size_t i = 0; i < size; ++i) {
+    content.push_back(static_cast<char>(i * 7 + i / 251));
+  }
+  ad_utility::File file{filename, "w"};
+  file.write(content.data(), content.size());
+  return content;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BatchedFileReader, readScatteredRanges) {
+  std::string filename = "BatchedFileReaderTest.tmp";
+  // The size is not a multiple of the alignment for `O_DIRECT`.
+  std::string content = writeTestFile(filename, 300'000 + 123);
+  ad_utility::File file{filename, "r"};
+  BatchedFileReader reader{file.getFileDescriptor(), filename};
+
+  // More ranges than fit into a single `io_uring` batch, some of them
+  // overlapping, some empty, and one that ends exactly at the end of the file.
+  std::vector<std::pair<off_t, size_t>> ranges;
+  for (size_t i = 0; i < BatchedFileReader::IO_URING_QUEUE_DEPTH + 50; ++i) {
+    ranges.emplace_back((i * 104'729) % 290'000, (i * 31) % 9'000);
+  }
+  ranges.emplace_back(content.size() - 200, 200);
+
+  for (bool useIoUring : {false, true}) {
+    for (bool useDirectIo : {false, true}) {
+      std::vector<std::string> buffers;
+      std::vector<ReadRequest> requests;
+      for (const auto& range : ranges) {
+        buffers.emplace_back(range.second, '\0');
+      }
+      for (size_t i = 0; i < ranges.size(); ++i) {
+        requests.push_back(
+            {buffers[i].data(), ranges[i].second, ranges[i].first});
+      }
+      reader.read(requests, {useIoUring, useDirectIo});
+      for (size_t i = 0; i < ranges.size(); ++i) {
+        auto [offset, size] = ranges[i];
+        EXPECT_EQ(buffers[i], content.substr(offset, size))
+            << i << ' ' << useIoUring << ' ' << useDirectIo;
+      }
+
+      // Reading beyond the end of the file throws.
+      std::string buffer(300, '\0');
+      std::vector<ReadRequest> invalid{
+          {buffer.data(), buffer.size(),
+           static_cast<off_t>(content.size() - 200)}};
+      AD_EXPECT_THROW_WITH_MESSAGE(
+          reader.read(invalid, {useIoUring, useDirectIo}),
+          ::testing::HasSubstr("unexpected end of file"));
+    }
+  }
+  // An empty batch is fine.
+  reader.read({}, {});
+  ad_utility::deleteFile(filename);
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "util/BitPacking.h"
+#include "util/Random.h"
+
+using ad_utility::BitPacking;
+
+namespace {
+// Encode and decode the `values` and check that the result is the same. Return
+// the size of the encoded values.
+size_t testRoundTrip(const std::vector<uint64_t>& values) {
+  auto encoded = BitPacking::encode(values);
+  std::vector<uint64_t> decoded(values.size());
+  BitPacking::decode(encoded, values.size(), decoded.data());
+  EXPECT_EQ(decoded, values);
+  return encoded.size();
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(BitPacking, emptyAndConstantInputs) {
+  EXPECT_EQ(testRoundTrip({}), BitPacking::HEADER_SIZE);
+  // A constant sequence requires zero bits per value.
+  EXPECT_EQ(testRoundTrip({42}), BitPacking::HEADER_SIZE);
+  EXPECT_EQ(testRoundTrip(std::vector<uint64_t>(1000, 17)),
+            BitPacking::HEADER_SIZE);
+}
+
+// _____________________________________________________________________________
+TEST(BitPacking, frameOfReference) {
+  // Unsorted values in the range [1000, 1007] need 3 bits per value.
+  std::vector<uint64_t> values;
+  for (size_t i = 0; i < 640; ++i) {
+    values.push_back(1000 + (i * 5) % 8);
+  }
+  EXPECT_EQ(testRoundTrip(values), BitPacking::HEADER_SIZE + 640 * 3 / 8);
+}
+
+// _____________________________________________________________________________
+TEST(BitPacking, deltaEncoding) {
+  // Sorted values with a large range but small (and constant) gaps.
+  std::vector<uint64_t> values;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    values.push_back((1ULL << 60) + 1'000'000 * i);
+  }
+  EXPECT_EQ(testRoundTrip(values), BitPacking::HEADER_SIZE);
+
+  // Sorted values with varying gaps in [3, 6], which require 2 bits each.
+  values.clear();
+  uint64_t current = 12345;
+  for (uint64_t i = 0; i < 257; ++i) {
+    values.push_back(current);
+    current += 3 + i % 4;
+  }
+  EXPECT_EQ(testRoundTrip(values), BitPacking::HEADER_SIZE + 256 * 2 / 8);
+}
+
+// _____________________________________________________________________________
+TEST(BitPacking, valuesCrossingWordBoundaries) {
+  // Values with all possible widths, s.t. many of them are split between two
+  // words.
+  ad_utility::FastRandomIntGenerator<uint64_t> random;
+  for (size_t numBits = 1; numBits <= 64; ++numBits) {
+    std::vector<uint64_t> values;
+    for (size_t i = 0; i < 100; ++i) {
+      values.push_back(random() & ad_utility::bitMaskForLowerBits(numBits));
+    }
+    // Make sure that the full width is used.
+    values.push_back(0);
+    values.push_back(ad_utility::bitMaskForLowerBits(numBits));
+    testRoundTrip(values);
+    ql::ranges::sort(values);
+    testRoundTrip(values);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(BitPacking, decodeWithConversion) {
+  std::vector<uint64_t> values{3, 5, 4};
+  auto encoded = BitPacking::encode(values);
+  std::vector<int> decoded(values.size());
+  BitPacking::decode(encoded, values.size(), decoded.data(),
+                     [](uint64_t value) { return -static_cast<int>(value); });
+  EXPECT_THAT(decoded, ::testing::ElementsAre(-3, -5, -4));
+
+  // The size of the input has to match the number of values.
+  EXPECT_ANY_THROW(BitPacking::decode(encoded, 100, decoded.data()));
+}
@@ -6,6 +6,8 @@
 
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "util/Cache.h"
 #include "util/DefaultValueSizeGetter.h"
@@ -139,4 +141,35 @@ TEST(LRUCacheTest, testDecreasingCapacity) {
   ASSERT_FALSE(cache["3"]);
   ASSERT_FALSE(cache["4"]);
 }
+
+// _____________________________________________________________________________
+TEST(LRUCacheTest, evictionCallback) {
+  LRUCache<string, string, StringSizeGetter<string>> cache(3);
+  std::vector<std::pair<string, string>> evicted;
+  cache.setEvictionCallback([&evicted](const string& key, const auto& value) {
+    evicted.emplace_back(key, *value);
+  });
+  cache.insert("1", "x");
+  cache.insert("2", "xx");
+  cache.insert("3", "xxx");
+  ASSERT_TRUE(evicted.empty());
+  // The least recently used entry is evicted to make room for a new one.
+  ASSERT_EQ(*cache["1"], "x");
+  cache.insert("4", "xxxx");
+  using P = std::pair<string, string>;
+  ASSERT_EQ(evicted, (std::vector{P{"2", "xx"}}));
+  // Also entries that are evicted when the capacity is reduced are reported.
+  cache.setMaxNumEntries(2);
+  ASSERT_EQ(evicted, (std::vector{P{"2", "xx"}, P{"3", "xxx"}}));
+  // Explicitly erased entries and clearing the cache are not reported.
+  cache.erase("1");
+  ASSERT_EQ(evicted.size(), 2);
+  // Neither are the entries that are removed to free memory.
+  cache.insert("5", "xxxxx");
+  ASSERT_EQ(evicted.size(), 2);
+  cache.makeRoomAsMuchAsPossible(MemorySize::bytes(1));
+  ASSERT_FALSE(cache.contains("4"));
+  cache.clearAll();
+  ASSERT_EQ(evicted.size(), 2);
+}
 }  // namespace ad_utility
@@ -10,6 +10,7 @@
 #include "index/IndexImpl.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
+#include "util/RuntimeParametersTestHelpers.h"
 #include "util/Serializer/ByteBufferSerializer.h"
 #include "util/SourceLocation.h"
 
@@ -702,6 +703,28 @@ TEST(CompressedRelationMetadata, GettersAndSetters) {
   ASSERT_EQ(43, m.numRows_);
 }
 
+// _____________________________________________________________________________
+TEST(CompressedRelationWriter, chooseCodecAndCompress) {
+  using Codec = CompressedBlockMetadata::OffsetAndCompressedSize::Codec;
+  auto codecOf = [](const std::vector<Id>& column) {
+    return CompressedRelationWriter::chooseCodecAndCompress(column).first;
+  };
+  // A sorted column with small gaps, like the first columns of a permutation.
+  std::vector<Id> sorted;
+  for (size_t i = 0; i < 1000; ++i) {
+    sorted.push_back(V(1000 + 3 * i + i % 2));
+  }
+  EXPECT_EQ(codecOf(sorted), Codec::BitPacking);
+
+  // Two alternating values with a large distance are compressed much better
+  // by zstd.
+  std::vector<Id> alternating;
+  for (size_t i = 0; i < 1000; ++i) {
+    alternating.push_back(i % 2 == 0 ? Id::makeUndefined() : V(1'000'000));
+  }
+  EXPECT_EQ(codecOf(alternating), Codec::Zstd);
+}
+
 TEST(CompressedRelationReader, getBlocksForJoinWithColumn) {
   using SpecBlocksBounds = CompressedRelationReader::ScanSpecAndBlocksAndBounds;
   CompressedBlockMetadata block1{
@@ -1064,6 +1087,45 @@ TEST(CompressedRelationWriter, graphInfoInBlockMetadata) {
   }
 }
 
+// Test the correct setting of the column summaries in the block metadata.
+TEST(CompressedRelationWriter, columnSummariesInBlockMetadata) {
+  std::vector<RelationInput> inputs;
+  inputs.push_back(RelationInput{3, {{1, 5, 0}, {2, 4, 0}}});
+  inputs.push_back(RelationInput{4, {{0, 7, 1}}});
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, "columnSummaries", 100_MB);
+  ASSERT_EQ(blocks.size(), 1);
+  const auto& block = blocks.at(0);
+  ASSERT_GE(block.columnSummaries_.size(), 4);
+  auto expectSummary = [&block](
+                           size_t column, Id min, Id max,
+                           source_location l = source_location::current()) {
+    auto t = generateLocationTrace(l);
+    const auto* summary = block.getColumnSummary(column);
+    ASSERT_NE(summary, nullptr);
+    EXPECT_EQ(summary->min_, min);
+    EXPECT_EQ(summary->max_, max);
+    EXPECT_TRUE(summary->containsDatatype(Datatype::VocabIndex));
+    EXPECT_FALSE(summary->containsDatatype(Datatype::Int));
+  };
+  expectSummary(0, V(3), V(4));
+  // The second and third column are not sorted within the block.
+  expectSummary(1, V(0), V(2));
+  expectSummary(2, V(4), V(7));
+  expectSummary(3, V(0), V(1));
+  EXPECT_EQ(block.getColumnSummary(block.columnSummaries_.size()), nullptr);
+
+  // A default-constructed summary contains no `Id`s.
+  CompressedBlockMetadata::ColumnSummary summary;
+  EXPECT_FALSE(summary.containsDatatype(Datatype::VocabIndex));
+  summary.add(Id::makeFromInt(42));
+  summary.add(Id::makeFromInt(-3));
+  EXPECT_EQ(summary.min_, Id::makeFromInt(-3));
+  EXPECT_EQ(summary.max_, Id::makeFromInt(42));
+  EXPECT_TRUE(summary.containsDatatype(Datatype::Int));
+  EXPECT_FALSE(summary.containsDatatype(Datatype::Double));
+}
+
 // Test the correct setting of the metadata for the contained graphs.
 TEST(CompressedRelationWriter, scanWithGraphs) {
   using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
@@ -1159,6 +1221,64 @@ TEST(CompressedRelationWriter, scanWithGraphs) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(CompressedRelationReader, decompressedBlockCache) {
+  using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
+  int g2 = 120349;
+  std::vector<RelationInput> inputs;
+  inputs.push_back(RelationInput{1, {{2, 3, g2}, {3, 4, g2}, {4, 5, g2}}});
+  auto filename = "decompressedBlockCache.dat";
+  auto cleanup = makeCleanup(filename);
+  // Each triple is stored in its own block.
+  auto [blocks, metaData, readerPtr] =
+      writeAndOpenRelations(inputs, filename, 0_B);
+
+  // The cache is disabled by default.
+  auto cacheCleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::decompressedBlockCacheMaxSize_>(1_MB);
+  auto& cache = DecompressedBlockCache::global();
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  ScanSpecification spec{V(1), std::nullopt, std::nullopt};
+  auto scan = [&](const LocatedTriplesPerBlock& locatedTriples) {
+    auto blockMetadata =
+        getBlockMetadataRangesfromVec(locatedTriples.getAugmentedMetadata());
+    return readerPtr->scan(ScanSpecAndBlocks{spec, blockMetadata}, {}, handle,
+                           locatedTriples);
+  };
+
+  LocatedTriplesPerBlock locatedTriples;
+  locatedTriples.setOriginalMetadata(blocks);
+  auto statsBefore = cache.getStatistics();
+  EXPECT_THAT(scan(locatedTriples),
+              matchesIdTableFromVector({{2, 3}, {3, 4}, {4, 5}}));
+  auto statsAfterFirstScan = cache.getStatistics();
+  EXPECT_GT(statsAfterFirstScan.numMisses_, statsBefore.numMisses_);
+
+  // The second scan of the same blocks is answered from the cache.
+  EXPECT_THAT(scan(locatedTriples),
+              matchesIdTableFromVector({{2, 3}, {3, 4}, {4, 5}}));
+  auto statsAfterSecondScan = cache.getStatistics();
+  EXPECT_GT(statsAfterSecondScan.numHits_, statsAfterFirstScan.numHits_);
+  EXPECT_EQ(statsAfterSecondScan.numMisses_, statsAfterFirstScan.numMisses_);
+
+  // The cache contains the blocks without the located triples, so an update
+  // of a cached block is correctly reflected by the next scan.
+  std::vector<LocatedTriple> deleteTriples;
+  deleteTriples.emplace_back(
+      LocatedTriple{0, IdTriple{{V(1), V(2), V(3), V(g2)}}, false});
+  locatedTriples.add(deleteTriples);
+  EXPECT_THAT(scan(locatedTriples),
+              matchesIdTableFromVector({{3, 4}, {4, 5}}));
+  EXPECT_EQ(cache.getStatistics().numMisses_,
+            statsAfterFirstScan.numMisses_);
+
+  // A scan with another snapshot without the update still sees all triples.
+  LocatedTriplesPerBlock noLocatedTriples;
+  noLocatedTriples.setOriginalMetadata(blocks);
+  EXPECT_THAT(scan(noLocatedTriples),
+              matchesIdTableFromVector({{2, 3}, {3, 4}, {4, 5}}));
+}
+
 // _____________________________________________________________________________
 TEST(ScanSpecAndBlocks, removePrefix) {
   using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
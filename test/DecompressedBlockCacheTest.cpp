@@ -0,0 +1,132 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "index/DecompressedBlockCache.h"
+#include "util/RuntimeParametersTestHelpers.h"
+
+using namespace ad_utility::memory_literals;
+
+namespace {
+using Column = DecompressedBlockCache::Column;
+
+// Create a column with `size` rows, all of which are `Id`s with the given
+// `value`.
+Column makeColumn(size_t size, int64_t value) {
+  return Column(size, Id::makeFromInt(value));
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(DecompressedBlockCache, getAndInsert) {
+  DecompressedBlockCache cache{1_MB};
+  DecompressedBlockCache::Key key{0, 42};
+  EXPECT_EQ(cache.get(key), nullptr);
+  cache.insert(key, makeColumn(3, 7));
+  auto column = cache.get(key);
+  ASSERT_NE(column, nullptr);
+  EXPECT_EQ(*column, makeColumn(3, 7));
+
+  // A second insert for the same key (e.g. from a concurrent scan) is ignored.
+  cache.insert(key, makeColumn(3, 8));
+  EXPECT_EQ(*cache.get(key), makeColumn(3, 7));
+
+  // Different readers and offsets are different keys.
+  EXPECT_EQ(cache.get({1, 42}), nullptr);
+  EXPECT_EQ(cache.get({0, 43}), nullptr);
+
+  auto stats = cache.getStatistics();
+  EXPECT_EQ(stats.numHits_, 2);
+  EXPECT_EQ(stats.numMisses_, 3);
+  EXPECT_EQ(stats.numEntries_, 1);
+  EXPECT_EQ(stats.size_, ad_utility::MemorySize::bytes(3 * sizeof(Id)));
+
+  cache.clear();
+  stats = cache.getStatistics();
+  EXPECT_EQ(stats.numHits_, 0);
+  EXPECT_EQ(stats.numMisses_, 0);
+  EXPECT_EQ(stats.numEntries_, 0);
+  EXPECT_EQ(cache.get(key), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(DecompressedBlockCache, sizeLimit) {
+  // Each column has a size of 80 bytes, so only two of them fit.
+  DecompressedBlockCache cache{ad_utility::MemorySize::bytes(200)};
+  cache.insert({0, 0}, makeColumn(10, 0));
+  cache.insert({0, 1}, makeColumn(10, 1));
+  // Access the first column, s.t. the second one is the least recently used.
+  EXPECT_NE(cache.get({0, 0}), nullptr);
+  cache.insert({0, 2}, makeColumn(10, 2));
+  EXPECT_NE(cache.get({0, 0}), nullptr);
+  EXPECT_EQ(cache.get({0, 1}), nullptr);
+  EXPECT_NE(cache.get({0, 2}), nullptr);
+
+  // Columns that are larger than the cache are not inserted at all.
+  cache.insert({0, 3}, makeColumn(100, 3));
+  EXPECT_EQ(cache.get({0, 3}), nullptr);
+
+  // Shrinking the cache evicts entries, a size of zero disables the cache.
+  EXPECT_TRUE(cache.isEnabled());
+  EXPECT_TRUE(cache.canStoreColumn(10));
+  EXPECT_FALSE(cache.canStoreColumn(100));
+  cache.setMaxSize(0_B);
+  EXPECT_FALSE(cache.isEnabled());
+  EXPECT_FALSE(cache.canStoreColumn(0));
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+  cache.insert({0, 4}, makeColumn(1, 4));
+  // Lookups in a disabled cache are not counted as misses.
+  auto numMisses = cache.getStatistics().numMisses_;
+  EXPECT_EQ(cache.get({0, 4}), nullptr);
+  EXPECT_EQ(cache.getStatistics().numMisses_, numMisses);
+}
+
+// _____________________________________________________________________________
+TEST(DecompressedBlockCache, sharding) {
+  // Four shards with 400 bytes each.
+  DecompressedBlockCache cache{ad_utility::MemorySize::bytes(1600), 4};
+  for (size_t i = 0; i < 8; ++i) {
+    cache.insert({0, i}, makeColumn(1, static_cast<int64_t>(i)));
+  }
+  for (size_t i = 0; i < 8; ++i) {
+    auto column = cache.get({0, i});
+    ASSERT_NE(column, nullptr);
+    EXPECT_EQ(*column, makeColumn(1, static_cast<int64_t>(i)));
+  }
+  auto stats = cache.getStatistics();
+  EXPECT_EQ(stats.numHits_, 8);
+  EXPECT_EQ(stats.numEntries_, 8);
+  EXPECT_EQ(stats.size_, ad_utility::MemorySize::bytes(8 * sizeof(Id)));
+
+  // A column that is larger than a single shard is not cached.
+  cache.insert({0, 8}, makeColumn(60, 8));
+  EXPECT_EQ(cache.get({0, 8}), nullptr);
+
+  cache.clear();
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+}
+
+// _____________________________________________________________________________
+TEST(DecompressedBlockCache, globalCacheFollowsRuntimeParameter) {
+  auto& cache = DecompressedBlockCache::global();
+  cache.clear();
+  // The cache is disabled by default.
+  cache.insert({0, 0}, makeColumn(1, 0));
+  EXPECT_EQ(cache.get({0, 0}), nullptr);
+  {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::decompressedBlockCacheMaxSize_>(1_MB);
+    cache.insert({0, 0}, makeColumn(1, 0));
+    EXPECT_NE(cache.get({0, 0}), nullptr);
+  }
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+  cache.insert({0, 0}, makeColumn(1, 0));
+  EXPECT_EQ(cache.get({0, 0}), nullptr);
+  cache.clear();
+
+  EXPECT_NE(DecompressedBlockCache::makeUniqueReaderId(),
+            DecompressedBlockCache::makeUniqueReaderId());
+}
@@ -9,12 +9,15 @@
 // You may not use this file except in compliance with the Apache 2.0 License,
 // which can be found in the `LICENSE` file at the root of the QLever project.
 
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
 #include <absl/strings/str_split.h>
 #include <gtest/gtest.h>
 
 #include "./DeltaTriplesTestHelpers.h"
 #include "./util/GTestHelpers.h"
 #include "./util/IndexTestHelpers.h"
+#include "./util/RuntimeParametersTestHelpers.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "index/DeltaTriples.h"
 #include "index/IndexImpl.h"
@@ -447,6 +450,9 @@ TEST_F(DeltaTriplesTest, DeltaTriplesManager) {
   auto deltaImpl = deltaTriplesManager.deltaTriples_.rlock();
   EXPECT_THAT(*deltaImpl, NumTriples(numThreads + 1, 2 * numThreads + 1,
                                      3 * numThreads + 2));
+
+  // The compaction is disabled by default, so its thread was never started.
+  EXPECT_FALSE(deltaTriplesManager.compactionThread_.joinable());
 }
 
 // _____________________________________________________________________________
@@ -614,3 +620,302 @@ TEST_F(DeltaTriplesTest, storeAndRestoreData) {
              Id::makeFromBool(false)}})));
   }
 }
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, compact) {
+  const auto& index = testQec->getIndex().getImpl();
+  auto& vocab = testQec->getIndex().getVocab();
+  LocalVocab localVocab;
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+
+  // Two `DeltaTriples` with the same updates, but only the first one is
+  // compacted.
+  DeltaTriples deltaTriples{index};
+  DeltaTriples reference{index};
+  for (auto permutation : Permutation::ALL) {
+    auto metadata =
+        std::make_shared<const std::vector<CompressedBlockMetadata>>(
+            index.getPermutation(permutation).metaData().blockData());
+    deltaTriples.setOriginalMetadata(permutation, metadata);
+    reference.setOriginalMetadata(permutation, metadata);
+  }
+  auto insert = [&](const std::string& triple) {
+    for (auto* d : {&deltaTriples, &reference}) {
+      d->insertTriples(cancellationHandle,
+                       makeIdTriples(vocab, localVocab, {triple}));
+    }
+  };
+  auto remove = [&](const std::string& triple) {
+    for (auto* d : {&deltaTriples, &reference}) {
+      d->deleteTriples(cancellationHandle,
+                       makeIdTriples(vocab, localVocab, {triple}));
+    }
+  };
+
+  // Return the complete contents of the given `permutation` when respecting
+  // the given `snapshot`.
+  auto scan = [&](Permutation::Enum permutation,
+                  const SharedLocatedTriplesSnapshot& snapshot) {
+    const auto& perm = index.getPermutation(permutation);
+    ScanSpecification spec{std::nullopt, std::nullopt, std::nullopt};
+    return perm.scan(perm.getScanSpecAndBlocks(spec, *snapshot), {},
+                     cancellationHandle, *snapshot);
+  };
+  auto expectSameContents = [&]() {
+    auto snapshot = deltaTriples.getSnapshot();
+    auto referenceSnapshot = reference.getSnapshot();
+    for (auto permutation : Permutation::ALL) {
+      EXPECT_EQ(scan(permutation, snapshot),
+                scan(permutation, referenceSnapshot));
+    }
+  };
+
+  insert("<a> <next> <c>");
+  insert("<c> <upp> <a>");
+  remove("<a> <upp> <A>");
+  remove("<b> <next> <c>");
+  auto snapshotBefore = deltaTriples.getSnapshot();
+  auto contentsBefore = scan(Permutation::SPO, snapshotBefore);
+  expectSameContents();
+
+  // Compact all blocks with at least one located triple.
+  EXPECT_GT(deltaTriples.compact(cancellationHandle, 1), 0);
+  for (auto permutation : Permutation::ALL) {
+    EXPECT_EQ(deltaTriples.getLocatedTriplesForPermutation(permutation)
+                  .numTriples(),
+              0);
+  }
+  EXPECT_THAT(deltaTriples, NumTriples(2, 2, 0));
+  expectSameContents();
+
+  // The previous snapshot is not affected.
+  EXPECT_EQ(snapshotBefore->getLocatedTriplesForPermutation(Permutation::SPO)
+                .numTriples(),
+            4);
+  EXPECT_EQ(scan(Permutation::SPO, snapshotBefore), contentsBefore);
+
+  // Undo some of the compacted updates and add new ones.
+  remove("<a> <next> <c>");
+  insert("<a> <upp> <A>");
+  insert("<b> <prev> <c>");
+  expectSameContents();
+
+  // Compact the already compacted blocks again.
+  EXPECT_GT(deltaTriples.compact(cancellationHandle, 1), 0);
+  expectSameContents();
+  EXPECT_THAT(deltaTriples, NumTriples(2, 2, 0));
+
+  // Compacting the same blocks again and again doesn't let the file for the
+  // compacted blocks grow, and the previous files are removed as soon as no
+  // snapshot uses them anymore.
+  auto compactedBlocksFile = [&deltaTriples]() {
+    return deltaTriples.getLocatedTriplesForPermutation(Permutation::SPO)
+        .getCompactedBlocksFile();
+  };
+  auto firstFile = compactedBlocksFile()->file().name();
+  auto firstSize = compactedBlocksFile()->size();
+  auto snapshotWithFirstFile = deltaTriples.getSnapshot();
+  auto contentsWithFirstFile = scan(Permutation::SPO, snapshotWithFirstFile);
+  for (size_t i = 0; i < 10; ++i) {
+    insert("<a> <next> <c>");
+    EXPECT_GT(deltaTriples.compact(cancellationHandle, 1), 0);
+    remove("<a> <next> <c>");
+    EXPECT_GT(deltaTriples.compact(cancellationHandle, 1), 0);
+    expectSameContents();
+    EXPECT_LE(compactedBlocksFile()->size(), 4 * firstSize);
+  }
+  EXPECT_NE(compactedBlocksFile()->file().name(), firstFile);
+  EXPECT_TRUE(std::filesystem::exists(firstFile));
+  EXPECT_EQ(scan(Permutation::SPO, snapshotWithFirstFile),
+            contentsWithFirstFile);
+  snapshotWithFirstFile.reset();
+  EXPECT_FALSE(std::filesystem::exists(firstFile));
+
+  // Blocks that are modified between the preparation and the application of a
+  // compaction are not compacted.
+  insert("<a> <next> <c>");
+  auto compaction = DeltaTriples::prepareCompaction(
+      index, deltaTriples.getSnapshot(), 1, cancellationHandle);
+  remove("<a> <next> <c>");
+  EXPECT_EQ(deltaTriples.applyCompaction(compaction), 0);
+  expectSameContents();
+
+  // Clearing also undoes the compaction, and the file of the compacted blocks
+  // is removed as soon as it is no longer used.
+  auto lastFile = compactedBlocksFile()->file().name();
+  deltaTriples.clear();
+  reference.clear();
+  expectSameContents();
+  EXPECT_EQ(compactedBlocksFile(), nullptr);
+  compaction = DeltaTriples::Compaction{};
+  EXPECT_FALSE(std::filesystem::exists(lastFile));
+
+  // Stale files of a previous process are removed when the index is loaded.
+  auto prefix = absl::StrCat(lastFile, "Stale");
+  auto staleFile = absl::StrCat(prefix, ".17");
+  ad_utility::File{staleFile, "w"};
+  EXPECT_TRUE(std::filesystem::exists(staleFile));
+  CompactedBlocksFile::removeAll(prefix);
+  EXPECT_FALSE(std::filesystem::exists(staleFile));
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, compactionInTheBackground) {
+  const auto& index = testQec->getIndex().getImpl();
+  auto& vocab = testQec->getIndex().getVocab();
+  LocalVocab localVocab;
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::deltaTriplesCompactionMinTriplesPerBlock_>(1);
+  DeltaTriplesManager deltaTriplesManager(index);
+  deltaTriplesManager.modify<void>([&](DeltaTriples& deltaTriples) {
+    for (auto permutation : Permutation::ALL) {
+      deltaTriples.setOriginalMetadata(
+          permutation,
+          std::make_shared<const std::vector<CompressedBlockMetadata>>(
+              index.getPermutation(permutation).metaData().blockData()));
+    }
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        makeIdTriples(vocab, localVocab, {"<a> <next> <c>"}));
+  });
+  // The update returns before the blocks are compacted, the compaction then
+  // installs a new snapshot without located triples.
+  deltaTriplesManager.waitUntilCompacted();
+  auto snapshot = deltaTriplesManager.getCurrentSnapshot();
+  for (auto permutation : Permutation::ALL) {
+    const auto& located =
+        snapshot->getLocatedTriplesForPermutation(permutation);
+    EXPECT_EQ(located.numTriples(), 0);
+    EXPECT_TRUE(located.hasCompactedBlocks());
+  }
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, storeAndRestoreViaWriteAheadLog) {
+  using ad_utility::triple_component::LiteralOrIri;
+  auto tmpFile =
+      std::filesystem::temp_directory_path() / "testDeltaTriplesWithLog";
+  auto logFile = absl::StrCat(tmpFile.string(), ".wal");
+  std::filesystem::remove(tmpFile);
+  std::filesystem::remove(logFile);
+  absl::Cleanup cleanup{[&tmpFile, &logFile]() {
+    std::filesystem::remove(tmpFile);
+    std::filesystem::remove(logFile);
+  }};
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto I = [](int64_t i) { return Id::makeFromInt(i); };
+  auto restore = [this, &tmpFile]() {
+    auto deltaTriples = std::make_unique<DeltaTriples>(testQec->getIndex());
+    deltaTriples->setPersists(tmpFile);
+    deltaTriples->readFromDisk();
+    return deltaTriples;
+  };
+  auto getBlankNodes = [](const DeltaTriples& deltaTriples) {
+    std::vector<Id> blankNodes;
+    for (const auto& map :
+         {&deltaTriples.triplesInserted_, &deltaTriples.triplesDeleted_}) {
+      for (const auto& triple : *map | ql::views::keys) {
+        if (triple.ids().at(0).getDatatype() == Datatype::BlankNodeIndex) {
+          blankNodes.push_back(triple.ids().at(0));
+        }
+      }
+    }
+    return blankNodes;
+  };
+
+  {
+    auto deltaTriples = restore();
+    LocalVocabEntry entry{LiteralOrIri::fromStringRepresentation("<test>")};
+    deltaTriples->insertTriples(
+        cancellationHandle,
+        {IdTriple<>{{I(1), Id::makeFromLocalVocabIndex(&entry), I(1)}}});
+    deltaTriples->commitToDisk();
+    // Insert a triple with a new blank node, and delete a triple with the
+    // same blank node (which is now managed by the `DeltaTriples`).
+    deltaTriples->insertTriples(
+        cancellationHandle,
+        {IdTriple<>{{Id::makeFromBlankNodeIndex(BlankNodeIndex::make(
+                         999'888'777)),
+                     I(2), I(2)}}});
+    auto blankNode = getBlankNodes(*deltaTriples).at(0);
+    deltaTriples->deleteTriples(cancellationHandle,
+                                {IdTriple<>{{blankNode, I(3), I(3)}}});
+    deltaTriples->commitToDisk();
+
+    // Only the log has been written.
+    EXPECT_FALSE(std::filesystem::exists(tmpFile));
+    EXPECT_TRUE(std::filesystem::exists(logFile));
+  }
+  {
+    auto deltaTriples = restore();
+    EXPECT_THAT(*deltaTriples, NumTriples(2, 1, 3));
+    EXPECT_THAT(deltaTriples->localVocab().getAllWordsForTesting(),
+                ::testing::ElementsAre(AD_PROPERTY(
+                    LocalVocabEntry, toStringRepresentation,
+                    ::testing::Eq("<test>"))));
+    auto blankNodes = getBlankNodes(*deltaTriples);
+    ASSERT_EQ(blankNodes.size(), 2);
+    EXPECT_EQ(blankNodes.at(0), blankNodes.at(1));
+
+    // After the restore, the log has been merged into the checkpoint.
+    EXPECT_TRUE(std::filesystem::exists(tmpFile));
+    EXPECT_FALSE(std::filesystem::exists(logFile));
+
+    // Clearing is also logged.
+    deltaTriples->clear();
+    deltaTriples->insertTriples(cancellationHandle,
+                                {IdTriple<>{{I(4), I(4), I(4)}}});
+    deltaTriples->commitToDisk();
+  }
+  // Simulate a crash while writing a record, the incomplete record is
+  // ignored.
+  {
+    std::ofstream log{logFile, std::ios::binary | std::ios::app};
+    log << "incomplete";
+  }
+  {
+    auto deltaTriples = restore();
+    EXPECT_THAT(*deltaTriples, NumTriples(1, 0, 1));
+    EXPECT_TRUE(deltaTriples->triplesInserted_.contains(
+        IdTriple<>{{I(4), I(4), I(4)}}));
+  }
+
+  // A small checkpoint threshold leads to a checkpoint on each commit.
+  {
+    auto threshold = setRuntimeParameterForTest<
+        &RuntimeParameters::persistUpdatesCheckpointThreshold_>(
+        ad_utility::MemorySize::bytes(1));
+    auto deltaTriples = restore();
+    deltaTriples->insertTriples(cancellationHandle,
+                                {IdTriple<>{{I(5), I(5), I(5)}}});
+    deltaTriples->commitToDisk();
+    EXPECT_FALSE(std::filesystem::exists(logFile));
+  }
+  EXPECT_THAT(*restore(), NumTriples(2, 0, 2));
+
+  // Simulate a crash while writing the header of a new log. The incomplete
+  // header is removed, s.t. the log can be written and read again.
+  std::filesystem::remove(tmpFile);
+  {
+    std::ofstream log{logFile, std::ios::binary | std::ios::trunc};
+    log << "QLEVER";
+  }
+  {
+    auto deltaTriples = restore();
+    EXPECT_THAT(*deltaTriples, NumTriples(0, 0, 0));
+    EXPECT_EQ(std::filesystem::file_size(logFile), 0);
+    deltaTriples->insertTriples(cancellationHandle,
+                                {IdTriple<>{{I(6), I(6), I(6)}}});
+    deltaTriples->commitToDisk();
+  }
+  {
+    auto deltaTriples = restore();
+    EXPECT_THAT(*deltaTriples, NumTriples(1, 0, 1));
+    EXPECT_TRUE(deltaTriples->triplesInserted_.contains(
+        IdTriple<>{{I(6), I(6), I(6)}}));
+  }
+}
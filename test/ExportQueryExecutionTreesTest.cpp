@@ -6,6 +6,7 @@
 
 #include <gmock/gmock.h>
 
+#include "engine/ExistsJoin.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/IndexScan.h"
 #include "engine/QueryPlanner.h"
@@ -13,11 +14,13 @@
 #include "parser/NormalizedString.h"
 #include "parser/SparqlParser.h"
 #include "rdfTypes/Literal.h"
+#include "util/ArrowIpcTestHelpers.h"
 #include "util/GTestHelpers.h"
 #include "util/IdTableHelpers.h"
 #include "util/IdTestHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/ParseableDuration.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
@@ -1392,6 +1395,67 @@ TEST(ExportQueryExecutionTrees, LimitOffset) {
   runSelectQueryTestCase(testCaseLimitOffset);
 }
 
+// ____________________________________________________________________________
+TEST(ExportQueryExecutionTrees, VocabularyStringCache) {
+  // Words that occur multiple times in the result, in different columns, and
+  // in an order that differs from the order of the vocabulary.
+  std::string kg =
+      "<a> <p> \"x\" . <b> <p> \"y\"@en . <c> <p> <a> . <c> <q> <b> . "
+      "<d> <p> \"x\"";
+  std::string query = "SELECT ?o ?s WHERE { ?s ?p ?o } ORDER BY DESC(?s)";
+  auto runAll = [&]() {
+    std::vector<std::string> results;
+    for (auto mediaType : {ad_utility::MediaType::tsv,
+                           ad_utility::MediaType::csv,
+                           ad_utility::MediaType::sparqlXml}) {
+      results.push_back(runQueryStreamableResult(kg, query, mediaType));
+    }
+    for (auto mediaType : {ad_utility::MediaType::sparqlJson,
+                           ad_utility::MediaType::qleverJson}) {
+      auto json = runJSONQuery(kg, query, mediaType);
+      // The QLever JSON contains the (varying) runtime information.
+      results.push_back(json.contains("res") ? json["res"].dump()
+                                             : json.dump());
+    }
+    return results;
+  };
+  auto& cache = ad_utility::testing::getQec(kg)
+                    ->getIndex()
+                    .getVocabularyStringCache();
+  cache.clear();
+  std::vector<std::string> resultsWithCache;
+  {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::exportVocabularyCacheMaxSize_>(
+        ad_utility::MemorySize::megabytes(1));
+    resultsWithCache = runAll();
+    EXPECT_GT(cache.numEntries(), 0u);
+  }
+
+  // The cache is disabled by default, which doesn't change the results.
+  cache.clear();
+  EXPECT_EQ(runAll(), resultsWithCache);
+  EXPECT_EQ(cache.numEntries(), 0u);
+  EXPECT_THAT(resultsWithCache[0], HasSubstr("\"y\"@en\t<b>"));
+
+  // Large blocks are resolved in batches of a bounded number of rows.
+  constexpr uint64_t n = ExportQueryExecutionTrees::VOCAB_BATCH_NUM_ROWS;
+  auto split = [](uint64_t begin, uint64_t end) {
+    std::vector<std::pair<uint64_t, uint64_t>> result;
+    for (auto rows : ExportQueryExecutionTrees::splitIntoVocabBatches(
+             ql::ranges::iota_view<uint64_t, uint64_t>{begin, end})) {
+      result.emplace_back(*rows.begin(), *rows.end());
+    }
+    return result;
+  };
+  using P = std::pair<uint64_t, uint64_t>;
+  EXPECT_THAT(split(3, 3), ::testing::IsEmpty());
+  EXPECT_THAT(split(3, 7), ::testing::ElementsAre(P{3, 7}));
+  EXPECT_THAT(split(5, 2 * n + 6),
+              ::testing::ElementsAre(P{5, n + 5}, P{n + 5, 2 * n + 5},
+                                     P{2 * n + 5, 2 * n + 6}));
+}
+
 // ____________________________________________________________________________
 TEST(ExportQueryExecutionTrees, BinaryExport) {
   std::string kg = "<s> <p> 31 . <s> <o> 42";
@@ -1417,6 +1481,185 @@ TEST(ExportQueryExecutionTrees, BinaryExport) {
   ASSERT_EQ(ad_utility::testing::IntId(31), id3);
 }
 
+// ____________________________________________________________________________
+TEST(ExportQueryExecutionTrees, ArrowExport) {
+  using namespace ad_utility::testing::arrow;
+  std::string kg = "<s> <p> <o>";
+  std::string query =
+      "PREFIX xsd: <http://www.w3.org/2001/XMLSchema#> "
+      "SELECT ?i ?d ?b ?t ?s ?u WHERE { VALUES (?i ?d ?b ?t ?s) { "
+      "(1 1.5 true \"2000-01-02T03:04:05Z\"^^xsd:dateTime \"abc\") "
+      "(2 3 false \"2000-01-02T03:04:05+02:00\"^^xsd:dateTime <x>) } }";
+  auto stream =
+      runQueryStreamableResult(kg, query, ad_utility::MediaType::arrowStream);
+  auto messages = parseStream(stream);
+  // The schema, the dictionaries of the two string columns, and a single
+  // record batch.
+  ASSERT_EQ(messages.size(), 4u);
+  std::vector<std::string_view> names;
+  std::vector<uint8_t> typeIds;
+  for (const auto& field : messages[0].header().tables(1)) {
+    names.push_back(field.string(0));
+    typeIds.push_back(field.scalar<uint8_t>(2));
+  }
+  EXPECT_THAT(names, ElementsAre("i", "d", "b", "t", "s", "u"));
+  // Int, FloatingPoint, Bool, Timestamp, and two dictionary-encoded strings.
+  EXPECT_THAT(typeIds, ElementsAre(2, 3, 6, 10, 5, 5));
+
+  const auto& stringDictionary = messages[1];
+  EXPECT_EQ(stringDictionary.header().scalar<int64_t>(0), 4);
+  EXPECT_EQ(stringDictionary.buffer(stringDictionary.header().table(1), 2),
+            "abcx");
+  EXPECT_EQ(messages[2].header().table(1).scalar<int64_t>(0), 0);
+
+  const auto& batchMessage = messages[3];
+  auto batch = batchMessage.header();
+  EXPECT_EQ(batch.scalar<int64_t>(0), 2);
+  auto values = [&](size_t column) {
+    return batchMessage.buffer(batch, 2 * column + 1);
+  };
+  EXPECT_EQ(value<int64_t>(values(0), 0), 1);
+  EXPECT_EQ(value<int64_t>(values(0), 1), 2);
+  EXPECT_EQ(value<double>(values(1), 0), 1.5);
+  EXPECT_EQ(value<double>(values(1), 1), 3.0);
+  EXPECT_TRUE(bit(values(2), 0));
+  EXPECT_FALSE(bit(values(2), 1));
+  EXPECT_EQ(value<int64_t>(values(3), 0), 946'782'245'000);
+  EXPECT_EQ(value<int64_t>(values(3), 1), 946'775'045'000);
+  EXPECT_EQ(value<int32_t>(values(4), 0), 0);
+  EXPECT_EQ(value<int32_t>(values(4), 1), 1);
+  // The column of the unbound variable only contains nulls.
+  EXPECT_EQ(batch.structs(1).at(5)[1], 2);
+
+  // For an empty result, only the schema is exported (with all columns as
+  // strings).
+  messages = parseStream(runQueryStreamableResult(
+      kg, "SELECT ?x WHERE { VALUES ?x { 1 } } LIMIT 0",
+      ad_utility::MediaType::arrowStream));
+  ASSERT_EQ(messages.size(), 1u);
+  auto fields = messages[0].header().tables(1);
+  ASSERT_EQ(fields.size(), 1u);
+  EXPECT_EQ(fields[0].scalar<uint8_t>(2), 5);
+}
+
+// ____________________________________________________________________________
+TEST(ExportQueryExecutionTrees, ArrowExportOfLazyResultWithMixedTypes) {
+  using namespace ad_utility::testing::arrow;
+  using ad_utility::testing::DoubleId;
+  using ad_utility::testing::IntId;
+  auto* qec = ad_utility::testing::getQec("<s> <p> <x>");
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  // A lazy result with two blocks, the first block only contains integers.
+  std::vector<IdTable> tables;
+  tables.push_back(makeIdTableFromVector({{IntId(1)}, {IntId(2)}}));
+  tables.push_back(makeIdTableFromVector(
+      {{DoubleId(2.5)}, {getId("<x>")}, {Id::makeUndefined()}}));
+  auto qet = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(tables),
+      std::vector<std::optional<Variable>>{Variable{"?x"}});
+  auto pq = parseQuery("SELECT ?x WHERE { }");
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  std::string stream;
+  for (const auto& chunk : ExportQueryExecutionTrees::computeResult(
+           pq, *qet, ad_utility::MediaType::arrowStream, timer,
+           std::make_shared<ad_utility::CancellationHandle<>>())) {
+    stream += chunk;
+  }
+  auto messages = parseStream(stream);
+  // The schema, and a dictionary and a record batch per block.
+  ASSERT_EQ(messages.size(), 5u);
+  auto fields = messages[0].header().tables(1);
+  ASSERT_EQ(fields.size(), 1u);
+  // The column is exported as strings, so the values of the second block are
+  // not lost.
+  EXPECT_EQ(fields[0].scalar<uint8_t>(2), 5);
+  auto dictionary = [&](size_t i) {
+    return messages[i].buffer(messages[i].header().table(1), 2);
+  };
+  EXPECT_EQ(dictionary(1), "12");
+  EXPECT_EQ(dictionary(3), "2.5x");
+  // Only the undefined value is null.
+  EXPECT_EQ(messages[2].header().structs(1).at(0)[1], 0);
+  EXPECT_EQ(messages[4].header().scalar<int64_t>(0), 3);
+  EXPECT_EQ(messages[4].header().structs(1).at(0)[1], 1);
+}
+
+// ____________________________________________________________________________
+TEST(ExportQueryExecutionTrees, ArrowExportOfLazyResultWithStaticTypes) {
+  using namespace ad_utility::testing::arrow;
+  using ad_utility::testing::IntId;
+  auto* qec = ad_utility::testing::getQec("<s> <p> <x>");
+  // The `?e` column of the lazy result of the `ExistsJoin` is guaranteed to
+  // contain booleans, but nothing is known about the values of `?x`.
+  std::vector<IdTable> tables;
+  tables.push_back(makeIdTableFromVector({{IntId(1)}, {IntId(2)}}));
+  tables.push_back(makeIdTableFromVector({{IntId(3)}}));
+  auto left = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(tables),
+      std::vector<std::optional<Variable>>{Variable{"?x"}});
+  auto right = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{IntId(4)}}),
+      std::vector<std::optional<Variable>>{Variable{"?y"}});
+  auto qet = ad_utility::makeExecutionTree<ExistsJoin>(qec, left, right,
+                                                       Variable{"?e"});
+  auto pq = parseQuery("SELECT ?x ?e WHERE { }");
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  std::string stream;
+  for (const auto& chunk : ExportQueryExecutionTrees::computeResult(
+           pq, *qet, ad_utility::MediaType::arrowStream, timer,
+           std::make_shared<ad_utility::CancellationHandle<>>())) {
+    stream += chunk;
+  }
+  auto messages = parseStream(stream);
+  auto fields = messages.at(0).header().tables(1);
+  ASSERT_EQ(fields.size(), 2u);
+  // A dictionary-encoded string and a boolean.
+  EXPECT_EQ(fields[0].scalar<uint8_t>(2), 5);
+  EXPECT_EQ(fields[1].scalar<uint8_t>(2), 6);
+  auto decoded = decodeStream(stream);
+  ASSERT_EQ(decoded.size(), 2u);
+  EXPECT_THAT(decoded[0][0], ElementsAre("1", "2"));
+  EXPECT_THAT(decoded[0][1], ElementsAre("true", "true"));
+  EXPECT_THAT(decoded[1][0], ElementsAre("3"));
+  EXPECT_THAT(decoded[1][1], ElementsAre("true"));
+}
+
+// ____________________________________________________________________________
+TEST(ExportQueryExecutionTrees, ArrowExportOfLargeBlockInSeveralBatches) {
+  using namespace ad_utility::testing::arrow;
+  using ad_utility::testing::IntId;
+  auto* qec = ad_utility::testing::getQec("<s> <p> <x>");
+  // A single block with one row more than fits into a record batch.
+  constexpr uint64_t numRows =
+      ExportQueryExecutionTrees::VOCAB_BATCH_NUM_ROWS + 1;
+  IdTable table{1, ad_utility::testing::makeAllocator()};
+  for (uint64_t i = 0; i < numRows; ++i) {
+    table.push_back({IntId(static_cast<int64_t>(i))});
+  }
+  auto qet = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(table),
+      std::vector<std::optional<Variable>>{Variable{"?x"}}, false,
+      std::vector<ColumnIndex>{}, LocalVocab{}, std::nullopt, true);
+  auto pq = parseQuery("SELECT ?x WHERE { }");
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  std::string stream;
+  for (const auto& chunk : ExportQueryExecutionTrees::computeResult(
+           pq, *qet, ad_utility::MediaType::arrowStream, timer,
+           std::make_shared<ad_utility::CancellationHandle<>>())) {
+    stream += chunk;
+  }
+  auto messages = parseStream(stream);
+  // The schema and two record batches.
+  ASSERT_EQ(messages.size(), 3u);
+  EXPECT_EQ(messages[1].header().scalar<int64_t>(0),
+            static_cast<int64_t>(numRows - 1));
+  EXPECT_EQ(messages[2].header().scalar<int64_t>(0), 1);
+  auto decoded = decodeStream(stream);
+  ASSERT_EQ(decoded.size(), 2u);
+  EXPECT_EQ(decoded[0][0].front(), "0");
+  EXPECT_THAT(decoded[1][0], ElementsAre(std::to_string(numRows - 1)));
+}
+
 // ____________________________________________________________________________
 TEST(ExportQueryExecutionTrees, CornerCases) {
   std::string kg = "<s> <p> <o>";
@@ -1443,6 +1686,9 @@ TEST(ExportQueryExecutionTrees, CornerCases) {
   ASSERT_THROW(runQueryStreamableResult(kg, constructQuery,
                                         ad_utility::MediaType::octetStream),
                ad_utility::Exception);
+  ASSERT_THROW(runQueryStreamableResult(kg, constructQuery,
+                                        ad_utility::MediaType::arrowStream),
+               ad_utility::Exception);
 
   // If none of the selected variables is defined in the query body, we have an
   // empty solution mapping per row, but there is no need to materialize any
@@ -1542,7 +1788,7 @@ TEST_P(StreamableMediaTypesFixture, CancellationCancelsStream) {
 INSTANTIATE_TEST_SUITE_P(StreamableMediaTypes, StreamableMediaTypesFixture,
                          ::testing::Values(turtle, sparqlXml, tsv, csv,
                                            octetStream, sparqlJson,
-                                           qleverJson));
+                                           qleverJson, arrowStream));
 
 // TODO<joka921> Unit tests for the more complex CONSTRUCT export (combination
 // between constants and stuff from the knowledge graph).
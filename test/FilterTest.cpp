@@ -7,6 +7,7 @@
 #include "./PrefilterExpressionTestHelpers.h"
 #include "engine/Filter.h"
 #include "engine/IndexScan.h"
+#include "engine/MorselParallelism.h"
 #include "engine/ValuesForTesting.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
@@ -266,3 +267,67 @@ TEST(Filter, clone) {
   EXPECT_THAT(filter, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), filter.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(Filter, parallelEvaluationPreservesOrder) {
+  using namespace makeSparqlExpression;
+  QueryExecutionContext* qec = ad_utility::testing::getQec();
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::expressionEvaluationNumThreads_>(4);
+  auto I = ad_utility::testing::IntId;
+  // An input that consists of several morsels, and the expected result of the
+  // filter `?x >= 10` on it.
+  size_t numRows = 3 * qlever::morsels::MORSEL_SIZE + 17;
+  IdTable input{1, qec->getAllocator()};
+  IdTable expected{1, qec->getAllocator()};
+  for (size_t i = 0; i < numRows; ++i) {
+    int64_t value = static_cast<int64_t>(i % 20);
+    input.push_back({I(value)});
+    if (value >= 10) {
+      expected.push_back({I(value)});
+    }
+  }
+
+  std::vector<std::optional<Variable>> vars{Variable{"?x"}};
+  auto makeFilter = [&](auto subtree) {
+    return Filter{qec, std::move(subtree),
+                  {geSprql(Variable{"?x"}, I(10)), "?x >= 10"}};
+  };
+
+  // Fully materialized input.
+  {
+    qec->getQueryTreeCache().clearAll();
+    auto filter = makeFilter(ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, input.clone(), vars, false, std::vector<ColumnIndex>{},
+        LocalVocab{}, std::nullopt, true));
+    auto result = filter.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+    ASSERT_TRUE(result->isFullyMaterialized());
+    EXPECT_EQ(result->idTable(), expected);
+  }
+
+  // Lazy input that is split into blocks of different sizes, and lazy output.
+  {
+    qec->getQueryTreeCache().clearAll();
+    std::vector<IdTable> blocks;
+    size_t blockBegin = 0;
+    for (size_t blockSize : {size_t{5}, 2 * qlever::morsels::MORSEL_SIZE,
+                             size_t{0}, numRows}) {
+      size_t blockEnd = std::min(blockBegin + blockSize, numRows);
+      IdTable block{1, qec->getAllocator()};
+      block.insertAtEnd(input, blockBegin, blockEnd);
+      blocks.push_back(std::move(block));
+      blockBegin = blockEnd;
+    }
+    auto filter = makeFilter(ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(blocks), vars));
+    auto result = filter.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+    ASSERT_FALSE(result->isFullyMaterialized());
+    IdTable aggregated{1, qec->getAllocator()};
+    for (const IdTable& block : toVector(result->idTables())) {
+      EXPECT_FALSE(block.empty());
+      EXPECT_LE(block.size(), qlever::morsels::MORSEL_SIZE);
+      aggregated.insertAtEnd(block);
+    }
+    EXPECT_EQ(aggregated, expected);
+  }
+}
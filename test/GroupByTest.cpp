@@ -16,6 +16,7 @@
 #include "engine/GroupByImpl.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
+#include "engine/MorselParallelism.h"
 #include "engine/QueryPlanner.h"
 #include "engine/Sort.h"
 #include "engine/SpatialJoinAlgorithms.h"
@@ -832,6 +833,12 @@ TEST_F(GroupByOptimizations, checkIfHashMapOptimizationPossible) {
   // Optimization has to be enabled
   setRuntimeParameter<&RuntimeParameters::groupByHashMapEnabled_>(false);
   testFailure(variablesOnlyX, aliasesAvgX, subtreeWithSort, avgAggregate);
+  // Using more than one thread implicitly enables the optimization.
+  {
+    auto cleanupThreads = setRuntimeParameterForTest<
+        &RuntimeParameters::groupByHashMapNumThreads_>(4);
+    testSuccess(variablesOnlyX, aliasesAvgX, subtreeWithSort, avgAggregate);
+  }
 
   // Support for MIN & MAX & SUM
   setRuntimeParameter<&RuntimeParameters::groupByHashMapEnabled_>(true);
@@ -936,6 +943,58 @@ TEST_F(GroupByOptimizations, hashMapOptimizationLazyAndMaterializedInputs) {
   runTest(false);
 }
 
+// _____________________________________________________________________________
+TEST_F(GroupByOptimizations, hashMapOptimizationInParallel) {
+  /* Setup query:
+  SELECT ?x (COUNT(*) as ?count) (MIN(?y) as ?min) (MAX(?y) as ?max)
+         (SUM(?y) as ?sum) (AVG(?y) as ?avg) WHERE {
+    # explicitly defined subresult that consists of several morsels.
+  } GROUP BY ?x
+ */
+  auto computeResult = [this](size_t numThreads, bool inputIsLazy) {
+    auto cleanupEnabled =
+        setRuntimeParameterForTest<&RuntimeParameters::groupByHashMapEnabled_>(
+            true);
+    auto cleanupThreads = setRuntimeParameterForTest<
+        &RuntimeParameters::groupByHashMapNumThreads_>(numThreads);
+    std::vector<IdTable> tables;
+    for (size_t block = 0; block < 3; ++block) {
+      IdTable table{2, qec->getAllocator()};
+      for (size_t i = 0; i < qlever::morsels::MORSEL_SIZE + 7; ++i) {
+        auto row = static_cast<int64_t>(block * 100'000 + i);
+        table.push_back({I((row * 7) % 101), I(row % 1000)});
+      }
+      tables.push_back(std::move(table));
+    }
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(tables),
+        std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?y"}});
+    auto& values =
+        dynamic_cast<ValuesForTesting&>(*subtree->getRootOperation());
+    values.forceFullyMaterialized() = !inputIsLazy;
+
+    std::vector<Alias> aliases{
+        Alias{SparqlExpressionPimpl{makeCountStarExpression(false), "COUNT(*)"},
+              Variable{"?count"}},
+        Alias{makeMinPimpl(varY), Variable{"?min"}},
+        Alias{makeMaxPimpl(varY), Variable{"?max"}},
+        Alias{makeSumPimpl(varY), Variable{"?sum"}},
+        Alias{makeAvgPimpl(varY), Variable{"?avg"}}};
+    qec->getQueryTreeCache().clearAll();
+    GroupBy groupBy{qec, variablesOnlyX, aliases, std::move(subtree)};
+    auto result = groupBy.computeResultOnlyForTesting();
+    EXPECT_TRUE(result.isFullyMaterialized());
+    return result.idTable().clone();
+  };
+
+  // The single-threaded hash map optimization is the reference.
+  auto expected = computeResult(1, false);
+  EXPECT_EQ(expected.size(), 101);
+  EXPECT_EQ(computeResult(4, false), expected);
+  EXPECT_EQ(computeResult(4, true), expected);
+  EXPECT_EQ(computeResult(3, true), expected);
+}
+
 // _____________________________________________________________________________
 TEST_F(GroupByOptimizations, correctResultForHashMapOptimizationForCountStar) {
   /* Setup query:
@@ -2700,3 +2759,44 @@ TEST_P(GroupByLazyFixture, countStarWorks) {
 
   expectReturningIdTables<1>(groupBy, {makeIntTable({{4, 4}})});
 }
+
+// _____________________________________________________________________________
+TEST(GroupBy, mergeGroupConcatAggregationData) {
+  using ad_utility::triple_component::Literal;
+  auto lit = [](std::string representation) {
+    return std::optional{
+        Literal::fromStringRepresentation(std::move(representation))};
+  };
+  GroupConcatAggregationData a{";"};
+  GroupConcatAggregationData b{";"};
+  GroupConcatAggregationData empty{";"};
+  a.addValueImpl(lit("\"x\"@en"));
+  b.addValueImpl(lit("\"y\"@en"));
+  b.addValueImpl(lit("\"z\"@en"));
+
+  // Merging an empty aggregate doesn't change anything.
+  a.merge(empty, nullptr);
+  EXPECT_EQ(a.currentValue_, "x");
+  a.merge(b, nullptr);
+  EXPECT_EQ(a.currentValue_, "x;y;z");
+  ASSERT_TRUE(a.langTag_.has_value());
+  EXPECT_EQ(a.langTag_, b.langTag_);
+
+  // Merging into an empty aggregate copies the values.
+  empty.merge(b, nullptr);
+  EXPECT_EQ(empty.currentValue_, "y;z");
+  EXPECT_EQ(empty.langTag_, b.langTag_);
+
+  // Different language tags lead to a result without a language tag.
+  GroupConcatAggregationData c{";"};
+  c.addValueImpl(lit("\"w\""));
+  a.merge(c, nullptr);
+  EXPECT_EQ(a.currentValue_, "x;y;z;w");
+  EXPECT_FALSE(a.langTag_.has_value());
+
+  // Undefined values make the complete result undefined.
+  GroupConcatAggregationData undefined{";"};
+  undefined.addValueImpl(std::nullopt);
+  a.merge(undefined, nullptr);
+  EXPECT_TRUE(a.undefined_);
+}
@@ -530,6 +530,244 @@ TEST(IndexTest, NumDistinctEntitiesCornerCases) {
       ::testing::ContainsRegex("requires a loaded patterns file"));
 }
 
+// _____________________________________________________________________________
+TEST(IndexTest, buildPermutationPairsInParallel) {
+  std::string turtleInput =
+      "<x> <label> \"alpha\" . <x> <label> \"A\"@en . <x> <is-a> <y> . "
+      "<y> <is-a> <x> . <z> <label> \"zz\"@en . <z> <p> 42 . <y> <p> <z> .";
+  auto makeQecForParallel = [&turtleInput](bool parallel) {
+    TestIndexConfig config{turtleInput};
+    config.usePatterns = false;
+    config.buildPermutationPairsInParallel = parallel;
+    return getQec(std::move(config));
+  };
+  auto* sequentialQec = makeQecForParallel(false);
+  auto* parallelQec = makeQecForParallel(true);
+  const IndexImpl& sequential = sequentialQec->getIndex().getImpl();
+  const IndexImpl& parallel = parallelQec->getIndex().getImpl();
+
+  EXPECT_EQ(sequential.numTriples(), parallel.numTriples());
+  EXPECT_EQ(sequential.numDistinctSubjects(), parallel.numDistinctSubjects());
+  EXPECT_EQ(sequential.numDistinctPredicates(),
+            parallel.numDistinctPredicates());
+  EXPECT_EQ(sequential.numDistinctObjects(), parallel.numDistinctObjects());
+
+  // All six permutations have the same relations with the same sizes.
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  for (auto permutation : Permutation::ALL) {
+    EXPECT_EQ(sequential.getPermutation(permutation)
+                  .getDistinctCol0IdsAndCounts(
+                      handle, sequentialQec->locatedTriplesSnapshot()),
+              parallel.getPermutation(permutation)
+                  .getDistinctCol0IdsAndCounts(
+                      handle, parallelQec->locatedTriplesSnapshot()))
+        << Permutation::toString(permutation);
+  }
+
+  // With patterns, the pairs can't be built in parallel.
+  TestIndexConfig config{turtleInput};
+  config.buildPermutationPairsInParallel = true;
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      getQec(std::move(config)),
+      ::testing::HasSubstr("can only be built in parallel without patterns"));
+}
+
+// _____________________________________________________________________________
+TEST(IndexTest, incrementalIndexBuild) {
+  std::string existingInput =
+      "<x> <label> \"alpha\" . <x> <is-a> <y> . _:b <p> <x> . "
+      "<z> <label> \"zz\"@en . <y> <p> 42 .";
+  // Some of the triples and words are also contained in the existing index.
+  std::string newInput =
+      "<x> <is-a> <y> . <w> <label> \"beta\"@en . _:c <p> <w> . "
+      "<y> <p> <a> . <a> <is-a> <x> . <z> <label> \"zz\"@en .";
+
+  // Return the triples (including the graph) of the `permutation` of the
+  // index of the `qec` with their IDs converted to strings, in sorted order.
+  // The IDs of the blank nodes depend on the order in which the input was
+  // processed, so all blank nodes are converted to the same string.
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  auto getTriples = [&handle](QueryExecutionContext* qec,
+                              Permutation::Enum permutation) {
+    const IndexImpl& index = qec->getIndex().getImpl();
+    const auto& p = index.getPermutation(permutation);
+    const auto& snapshot = qec->locatedTriplesSnapshot();
+    std::array<ColumnIndex, 1> additionalColumns{ADDITIONAL_COLUMN_GRAPH_ID};
+    auto idTable = p.scan(
+        p.getScanSpecAndBlocks(
+            ScanSpecification{std::nullopt, std::nullopt, std::nullopt},
+            snapshot),
+        additionalColumns, handle, snapshot);
+    auto toString = [&index](Id id) -> std::string {
+      if (id.getDatatype() == Datatype::VocabIndex) {
+        return std::string{index.getVocab()[id.getVocabIndex()]};
+      } else if (id.getDatatype() == Datatype::BlankNodeIndex) {
+        return "_:";
+      }
+      return absl::StrCat(id.getBits());
+    };
+    std::vector<std::vector<std::string>> triples;
+    for (size_t i = 0; i < idTable.numRows(); ++i) {
+      auto& triple = triples.emplace_back();
+      for (size_t j = 0; j < idTable.numColumns(); ++j) {
+        triple.push_back(toString(idTable(i, j)));
+      }
+    }
+    ql::ranges::sort(triples);
+    return triples;
+  };
+
+  TestIndexConfig config{existingInput};
+  config.usePatterns = false;
+  config.vocabularyType = ad_utility::VocabularyType{
+      ad_utility::VocabularyType::Enum::OnDiskCompressed};
+  auto* existingQec = getQec(config);
+  config.turtleInput = newInput;
+  config.existingIndexBasename = existingQec->getIndex().getOnDiskBase();
+  auto* incrementalQec = getQec(config);
+  config.turtleInput = absl::StrCat(existingInput, " ", newInput);
+  config.existingIndexBasename = std::nullopt;
+  auto* fullQec = getQec(config);
+  const IndexImpl& incremental = incrementalQec->getIndex().getImpl();
+  const IndexImpl& full = fullQec->getIndex().getImpl();
+
+  // The incremental build yields the same index as building the index from
+  // the complete input.
+  EXPECT_EQ(incremental.getVocab().size(), full.getVocab().size());
+  EXPECT_EQ(incremental.numTriples(), full.numTriples());
+  EXPECT_EQ(incremental.numDistinctSubjects(), full.numDistinctSubjects());
+  EXPECT_EQ(incremental.numDistinctPredicates(), full.numDistinctPredicates());
+  EXPECT_EQ(incremental.numDistinctObjects(), full.numDistinctObjects());
+  EXPECT_EQ(incremental.getBlankNodeManager()->minIndex_, 2);
+  for (auto permutation : Permutation::ALL) {
+    EXPECT_EQ(getTriples(incrementalQec, permutation),
+              getTriples(fullQec, permutation))
+        << Permutation::toString(permutation);
+  }
+
+  // An incremental index build is not possible with patterns.
+  config.turtleInput = newInput;
+  config.existingIndexBasename = existingQec->getIndex().getOnDiskBase();
+  config.usePatterns = true;
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      getQec(std::move(config)),
+      ::testing::HasSubstr("only possible without patterns"));
+}
+
+// _____________________________________________________________________________
+TEST(IndexTest, resumeIndexBuild) {
+  std::string basename = "resumeIndexBuildTest";
+  std::string inputFilename = basename + ".ttl";
+  {
+    auto f = ad_utility::makeOfstream(inputFilename);
+    f << "<x> <label> \"alpha\" . <x> <is-a> <y> . <y> <is-a> <x> . "
+         "_:b <p> <x> . <z> <label> \"zz\"@en . <y> <p> 42 . <z> <p> <x> .";
+  }
+  // Build the index. If `interruptAfter` is set, the build throws after that
+  // stage, like a build that ran out of memory or was killed.
+  auto build = [&](bool usePatterns, bool resume,
+                   std::optional<IndexBuildStage> interruptAfter =
+                       std::nullopt) {
+    Index index = makeIndexWithTestSettings();
+    index.blocksizePermutationsPerColumn() = 16_B;
+    index.setOnDiskBase(basename);
+    index.usePatterns() = usePatterns;
+    index.getImpl().setVocabularyTypeForIndexBuilding(
+        ad_utility::VocabularyType{
+            ad_utility::VocabularyType::Enum::OnDiskCompressed});
+    index.getImpl().setResumeIndexBuild(resume);
+    index.getImpl().interruptIndexBuildAfterStageOnlyForTesting(
+        interruptAfter);
+    index.createFromFiles(
+        {{inputFilename, qlever::Filetype::Turtle, std::nullopt}});
+  };
+
+  // Return the configuration and the triples (including the graph) of all the
+  // permutations of the index.
+  auto getIndexContent = [&basename](bool usePatterns) {
+    Index index = makeIndexWithTestSettings();
+    index.usePatterns() = usePatterns;
+    index.createFromOnDiskIndex(basename, false);
+    const IndexImpl& impl = index.getImpl();
+    auto snapshot = impl.deltaTriplesManager().getCurrentSnapshot();
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    std::vector<std::vector<Id::T>> triples;
+    for (auto permutation : Permutation::ALL) {
+      const auto& p = impl.getPermutation(permutation);
+      std::array<ColumnIndex, 1> additionalColumns{ADDITIONAL_COLUMN_GRAPH_ID};
+      auto idTable = p.scan(
+          p.getScanSpecAndBlocks(
+              ScanSpecification{std::nullopt, std::nullopt, std::nullopt},
+              *snapshot),
+          additionalColumns, handle, *snapshot);
+      for (size_t i = 0; i < idTable.numRows(); ++i) {
+        auto& triple = triples.emplace_back();
+        for (size_t j = 0; j < idTable.numColumns(); ++j) {
+          triple.push_back(idTable(i, j).getBits());
+        }
+      }
+    }
+    auto configuration = ad_utility::fileToJson<nlohmann::json>(
+        basename + std::string{CONFIGURATION_FILE});
+    return std::pair{std::move(configuration), std::move(triples)};
+  };
+  auto checkpointExists = [&basename]() {
+    return std::filesystem::exists(
+        basename + std::string{IndexBuildCheckpoint::FILE_SUFFIX});
+  };
+
+  using enum IndexBuildStage;
+  for (bool usePatterns : {false, true}) {
+    // A complete index build removes the checkpoint.
+    build(usePatterns, false);
+    EXPECT_FALSE(checkpointExists());
+    auto expected = getIndexContent(usePatterns);
+
+    // Interrupt the index build after each of its stages, and resume it. With
+    // patterns, the internal permutations are built after the first pair, so
+    // the index build is then resumed from the ID conversion.
+    for (auto stage : {ParsingAndPartialVocabularies, VocabularyMerge,
+                       IdConversion, InternalPermutations, FirstPermutationPair,
+                       SecondPermutationPair, ThirdPermutationPair}) {
+      EXPECT_ANY_THROW(build(usePatterns, false, stage));
+      EXPECT_TRUE(checkpointExists());
+      build(usePatterns, true);
+      EXPECT_FALSE(checkpointExists());
+      EXPECT_EQ(getIndexContent(usePatterns), expected)
+          << "usePatterns = " << usePatterns << ", interrupted after "
+          << IndexBuildCheckpoint::toString(stage);
+    }
+
+    // The output of a stage that has changed since the interrupted build is
+    // built again. The files of the vocabulary belong to the first pair.
+    for (std::string deletedPrefix :
+         {".index.spo", ".internal.index.pso", ".vocabulary"}) {
+      EXPECT_ANY_THROW(build(usePatterns, false, SecondPermutationPair));
+      for (const auto& entry : std::filesystem::directory_iterator(".")) {
+        if (entry.path().filename().string().starts_with(basename +
+                                                         deletedPrefix)) {
+          ad_utility::deleteFile(entry.path().string());
+        }
+      }
+      build(usePatterns, true);
+      EXPECT_EQ(getIndexContent(usePatterns), expected)
+          << "usePatterns = " << usePatterns << ", deleted files "
+          << deletedPrefix;
+    }
+
+    // A checkpoint with different settings is not used, the index is then
+    // built from the beginning.
+    EXPECT_ANY_THROW(build(usePatterns, false, SecondPermutationPair));
+    build(!usePatterns, true);
+    build(usePatterns, true);
+    EXPECT_EQ(getIndexContent(usePatterns), expected);
+  }
+
+  for (const auto& filename : getAllIndexFilenames(basename)) {
+    ad_utility::deleteFile(filename, false);
+  }
+}
+
 TEST(IndexTest, getPermutation) {
   using enum Permutation::Enum;
   const IndexImpl& index = getQec()->getIndex().getImpl();
@@ -101,7 +101,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
     return testing::ResultOf(
         absl::StrCat(".map_.at(", std::to_string(blockIndex), ")"),
         [blockIndex](const LocatedTriplesPerBlock& ltpb) {
-          return ltpb.map_.at(blockIndex);
+          return *ltpb.map_.at(blockIndex);
         },
         testing::Eq(expectedLTs));
   };
@@ -118,7 +118,8 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               return locatedTriplesInBlock(blockIndex, expectedLTs);
             });
         // The macro does not work with templated types.
-        using HashMapType = ad_utility::HashMap<size_t, LocatedTriples>;
+        using HashMapType =
+            ad_utility::HashMap<size_t, std::shared_ptr<LocatedTriples>>;
         return testing::AllOf(
             AD_FIELD(LocatedTriplesPerBlock, map_,
                      AD_PROPERTY(HashMapType, size,
@@ -152,7 +153,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               locatedTriplesAre(
                   {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7}}}));
 
-  auto handles = locatedTriplesPerBlock.add(std::vector{LT8, LT9});
+  locatedTriplesPerBlock.add(std::vector{LT8, LT9});
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(4));
   EXPECT_THAT(locatedTriplesPerBlock, numTriplesTotal(9));
@@ -165,7 +166,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
                                  {2, {LT8}},
                                  {3, {LT6, LT7, LT9}}}));
 
-  locatedTriplesPerBlock.erase(2, handles[0]);
+  locatedTriplesPerBlock.erase(2, LT8);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(3));
@@ -179,7 +180,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
           {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7, LT9}}}));
 
   // Erasing in a block that does not exist, raises an exception.
-  EXPECT_THROW(locatedTriplesPerBlock.erase(100, handles[1]),
+  EXPECT_THROW(locatedTriplesPerBlock.erase(100, LT9),
                ad_utility::Exception);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
@@ -194,7 +195,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
       locatedTriplesAre(
           {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7, LT9}}}));
 
-  locatedTriplesPerBlock.erase(3, handles[1]);
+  locatedTriplesPerBlock.erase(3, LT9);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(3));
@@ -216,6 +217,92 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
   EXPECT_THAT(locatedTriplesPerBlock, locatedTriplesAre({}));
 }
 
+// Test that copies of a `LocatedTriplesPerBlock` (as they are used for the
+// snapshots of the `DeltaTriples`) share the located triples of the unmodified
+// blocks, and are not affected by subsequent modifications of the original.
+TEST_F(LocatedTriplesTest, copyOnWrite) {
+  using LT = LocatedTriple;
+  auto LT1 = LT{0, IT(10, 1, 0), false};
+  auto LT2 = LT{0, IT(11, 3, 0), true};
+  auto LT3 = LT{1, IT(20, 4, 0), true};
+  auto LT4 = LT{1, IT(21, 5, 0), true};
+  auto original = makeLocatedTriplesPerBlock({LT1, LT2, LT3});
+  original.setOriginalMetadata(std::vector{CBM(PT(5, 1, 1), PT(15, 1, 1)),
+                                           CBM(PT(15, 1, 2), PT(25, 1, 1))});
+  original.updateAugmentedMetadata();
+
+  // Copying only copies the pointers.
+  auto copy = original;
+  EXPECT_EQ(copy.map_.at(0), original.map_.at(0));
+  EXPECT_EQ(copy.map_.at(1), original.map_.at(1));
+  EXPECT_EQ(&copy.getAugmentedMetadata(), &original.getAugmentedMetadata());
+  auto metadataOfCopy = copy.getAugmentedMetadata();
+
+  // Modify block 1 of the original, block 0 remains shared.
+  original.add(std::vector{LT4});
+  original.erase(1, LT3);
+  EXPECT_EQ(copy.map_.at(0), original.map_.at(0));
+  EXPECT_NE(copy.map_.at(1), original.map_.at(1));
+  EXPECT_THAT(*original.map_.at(1), ::testing::ElementsAre(LT4));
+  EXPECT_THAT(*copy.map_.at(1), ::testing::ElementsAre(LT3));
+  EXPECT_EQ(original.numTriples(), 3);
+  EXPECT_EQ(copy.numTriples(), 3);
+
+  // Erasing the last triple of a shared block only affects the original.
+  original.erase(0, LT1);
+  original.erase(0, LT2);
+  original.updateAugmentedMetadata();
+  EXPECT_FALSE(original.hasUpdates(0));
+  EXPECT_TRUE(copy.hasUpdates(0));
+  EXPECT_THAT(*copy.map_.at(0), ::testing::ElementsAre(LT1, LT2));
+  EXPECT_EQ(copy.getAugmentedMetadata(), metadataOfCopy);
+  EXPECT_NE(original.getAugmentedMetadata(), metadataOfCopy);
+
+  // Once the copy is gone, the original modifies its blocks in place.
+  copy.clear();
+  const auto* block = original.map_.at(1).get();
+  original.add(std::vector{LT3});
+  EXPECT_EQ(original.map_.at(1).get(), block);
+  EXPECT_THAT(*block, ::testing::ElementsAre(LT3, LT4));
+}
+
+// _____________________________________________________________________________
+TEST_F(LocatedTriplesTest, hasUpdatesForCol0) {
+  using LT = LocatedTriple;
+  std::vector<CompressedBlockMetadata> metadata{
+      CBM(PT(1, 1, 1), PT(2, 1, 1)), CBM(PT(2, 2, 1), PT(4, 1, 1)),
+      CBM(PT(6, 1, 1), PT(8, 1, 1))};
+  for (size_t i = 0; i < metadata.size(); ++i) {
+    metadata[i].blockIndex_ = i;
+  }
+  LocatedTriplesPerBlock ltpb;
+  ltpb.setOriginalMetadata(metadata);
+  EXPECT_FALSE(ltpb.hasUpdatesForCol0(V(3)));
+
+  // Triples in the middle of a block, before the first triple of a block, and
+  // after the last block.
+  ltpb.add(std::vector{LT{1, IT(3, 1, 1), true}, LT{2, IT(5, 1, 1), false},
+                       LT{3, IT(9, 1, 1), true}});
+  EXPECT_FALSE(ltpb.hasUpdatesForCol0(V(1)));
+  EXPECT_FALSE(ltpb.hasUpdatesForCol0(V(2)));
+  EXPECT_TRUE(ltpb.hasUpdatesForCol0(V(3)));
+  EXPECT_FALSE(ltpb.hasUpdatesForCol0(V(4)));
+  EXPECT_TRUE(ltpb.hasUpdatesForCol0(V(5)));
+  EXPECT_FALSE(ltpb.hasUpdatesForCol0(V(6)));
+  EXPECT_TRUE(ltpb.hasUpdatesForCol0(V(9)));
+  EXPECT_FALSE(ltpb.hasUpdatesForCol0(V(10)));
+
+  // A compacted block counts as updated for all the `Id`s that it contains.
+  auto compacted = CBM(PT(5, 1, 1), PT(8, 1, 1));
+  compacted.blockIndex_ = 2;
+  ltpb.replaceCompactedBlocks({compacted}, {}, nullptr);
+  EXPECT_TRUE(ltpb.hasUpdatesForCol0(V(3)));
+  EXPECT_TRUE(ltpb.hasUpdatesForCol0(V(5)));
+  EXPECT_TRUE(ltpb.hasUpdatesForCol0(V(7)));
+  EXPECT_FALSE(ltpb.hasUpdatesForCol0(V(1)));
+  EXPECT_FALSE(ltpb.hasUpdatesForCol0(V(4)));
+}
+
 // Test the method that merges the matching `LocatedTriple`s from a block into
 // an `IdTable`.
 TEST_F(LocatedTriplesTest, mergeTriples) {
@@ -782,9 +869,9 @@ TEST_F(LocatedTriplesTest, augmentedMetadata) {
                 testing::ElementsAreArray(expectedAugmentedMetadata));
 
     // T4 is before block 4. The beginning of block 4 changes.
-    auto handles =
-        locatedTriplesPerBlock.add(LocatedTriple::locateTriplesInPermutation(
-            Span{T4}, metadata, keyOrder, true, handle));
+    auto locatedT4 = LocatedTriple::locateTriplesInPermutation(
+        Span{T4}, metadata, keyOrder, true, handle);
+    locatedTriplesPerBlock.add(locatedT4);
 
     expectedAugmentedMetadata[4] = CBM(T4.toPermutedTriple(), PT8);
     expectedAugmentedMetadata[4].containsDuplicatesWithDifferentGraphs_ = true;
@@ -792,7 +879,7 @@ TEST_F(LocatedTriplesTest, augmentedMetadata) {
                 testing::ElementsAreArray(expectedAugmentedMetadata));
 
     // Erasing the update of T4 restores the beginning of block 4.
-    locatedTriplesPerBlock.erase(4, handles[0]);
+    locatedTriplesPerBlock.erase(4, locatedT4.at(0));
     locatedTriplesPerBlock.updateAugmentedMetadata();
 
     expectedAugmentedMetadata[4] = CBM(PT8, PT8);
@@ -12,6 +12,7 @@
 #include "global/ValueIdComparators.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
@@ -272,3 +273,143 @@ TEST(OrderBy, clone) {
   EXPECT_THAT(orderBy, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), orderBy.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(OrderBy, topKWithLimitAndOffset) {
+  auto* qec = ad_utility::testing::getQec();
+  // A shuffled input with duplicates and a second column to make the rows
+  // distinguishable.
+  VectorTable input;
+  for (int64_t i = 0; i < 200; ++i) {
+    input.push_back({(i * 37) % 50, i});
+  }
+  auto inputTable = makeIdTableFromVector(input, &Id::makeFromInt);
+  std::vector<std::optional<Variable>> vars{Variable{"?0"}, Variable{"?1"}};
+  OrderBy::SortIndices sortIndices{{0, true}, {1, false}};
+
+  // The expected result is the fully sorted input, from which the
+  // `LIMIT`/`OFFSET` is applied afterward.
+  auto fullySorted = [&]() {
+    OrderBy orderBy{qec,
+                    ad_utility::makeExecutionTree<ValuesForTesting>(
+                        qec, inputTable.clone(), vars),
+                    sortIndices};
+    return orderBy.computeResultOnlyForTesting(false).idTable().clone();
+  }();
+  ASSERT_EQ(fullySorted.numRows(), 200);
+
+  auto expectedSlice = [&fullySorted](size_t limit, size_t offset) {
+    IdTable expected = fullySorted.clone();
+    expected.erase(expected.begin() + std::min(limit + offset, expected.size()),
+                   expected.end());
+    expected.erase(expected.begin(),
+                   expected.begin() + std::min(offset, expected.size()));
+    return expected;
+  };
+
+  // Split the input into blocks of (at most) `blockSize` rows which are
+  // yielded lazily.
+  auto makeLazyInput = [&](size_t blockSize) {
+    std::vector<IdTable> blocks;
+    for (size_t i = 0; i < inputTable.numRows(); i += blockSize) {
+      IdTable block{2, qec->getAllocator()};
+      for (size_t j = i; j < std::min(i + blockSize, inputTable.numRows());
+           ++j) {
+        block.push_back(inputTable[j]);
+      }
+      blocks.push_back(std::move(block));
+    }
+    return ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(blocks), vars);
+  };
+
+  for (auto [limit, offset] : std::vector<std::pair<size_t, size_t>>{
+           {0, 0}, {1, 0}, {5, 0}, {7, 3}, {30, 100}, {100, 150}, {500, 0}}) {
+    auto expected = expectedSlice(limit, offset);
+    for (size_t blockSize : {1, 3, 64, 1000}) {
+      OrderBy orderBy{qec, makeLazyInput(blockSize), sortIndices};
+      ASSERT_TRUE(orderBy.supportsLimitOffset());
+      orderBy.applyLimitOffset({limit, offset});
+      auto result = orderBy.computeResultOnlyForTesting(false);
+      EXPECT_EQ(result.idTable(), expected)
+          << "limit " << limit << " offset " << offset << " block size "
+          << blockSize;
+    }
+    // Also test the fully materialized input.
+    OrderBy orderBy{qec,
+                    ad_utility::makeExecutionTree<ValuesForTesting>(
+                        qec, inputTable.clone(), vars),
+                    sortIndices};
+    orderBy.applyLimitOffset({limit, offset});
+    EXPECT_EQ(orderBy.computeResultOnlyForTesting(false).idTable(), expected);
+  }
+
+  // Only an `OFFSET` without a `LIMIT`.
+  OrderBy orderBy{qec,
+                  ad_utility::makeExecutionTree<ValuesForTesting>(
+                      qec, inputTable.clone(), vars),
+                  sortIndices};
+  orderBy.applyLimitOffset({std::nullopt, 190});
+  EXPECT_EQ(orderBy.computeResultOnlyForTesting(false).idTable(),
+            expectedSlice(200, 190));
+}
+
+// _____________________________________________________________________________
+TEST(OrderBy, costEstimateWithLimit) {
+  VectorTable input;
+  for (int64_t i = 0; i < 1024; ++i) {
+    input.push_back({i});
+  }
+  OrderBy withoutLimit =
+      makeOrderBy(makeIdTableFromVector(input), {{0, false}});
+  OrderBy withLimit = makeOrderBy(makeIdTableFromVector(input), {{0, false}});
+  withLimit.applyLimitOffset({2, 0});
+  // 1024 * log2(1024) + 1024 vs. 1024 * log2(2) + 1024.
+  EXPECT_EQ(withoutLimit.getCostEstimate(), 11 * 1024);
+  EXPECT_EQ(withLimit.getCostEstimate(), 2 * 1024);
+}
+
+// _____________________________________________________________________________
+TEST(OrderBy, externalSort) {
+  VectorTable input;
+  for (int64_t i = 0; i < 2'500; ++i) {
+    input.push_back({(i * 7919) % 100 - 50, i});
+  }
+  auto inputTable = makeIdTableFromVector(input, &Id::makeFromInt);
+  OrderBy::SortIndices sortIndices{{0, true}, {1, false}};
+  auto expected = [&]() {
+    OrderBy orderBy = makeOrderBy(inputTable.clone(), sortIndices);
+    return orderBy.computeResultOnlyForTesting(false).idTable().clone();
+  }();
+  ASSERT_EQ(expected.numRows(), 2'500);
+
+  // With a fraction of zero, every sort is performed externally.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::externalSortMemoryFraction_>(0.0);
+  {
+    OrderBy orderBy = makeOrderBy(inputTable.clone(), sortIndices);
+    auto result = orderBy.computeResultOnlyForTesting(false);
+    // A fully materialized result would need as much memory as the
+    // in-memory sort, so the external sort is only used for lazy results.
+    ASSERT_TRUE(result.isFullyMaterialized());
+    EXPECT_FALSE(
+        orderBy.runtimeInfo().details_.contains("external-sort-memory"));
+    EXPECT_EQ(result.idTable(), expected);
+  }
+  {
+    OrderBy orderBy = makeOrderBy(inputTable.clone(), sortIndices);
+    orderBy.applyLimitOffset({std::nullopt, 2'490});
+    auto result = orderBy.computeResultOnlyForTesting(true);
+    ASSERT_FALSE(result.isFullyMaterialized());
+    EXPECT_TRUE(
+        orderBy.runtimeInfo().details_.contains("external-sort-memory"));
+    IdTable aggregate{2, ad_utility::testing::makeAllocator()};
+    for (auto& [block, localVocab] : result.idTables()) {
+      aggregate.insertAtEnd(block);
+    }
+    IdTable expectedWithOffset = expected.clone();
+    expectedWithOffset.erase(expectedWithOffset.begin(),
+                             expectedWithOffset.begin() + 2'490);
+    EXPECT_EQ(aggregate, expectedWithOffset);
+  }
+}
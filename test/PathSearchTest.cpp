@@ -9,6 +9,7 @@
 #include "engine/Result.h"
 #include "engine/ValuesForTesting.h"
 #include "gmock/gmock.h"
+#include "util/GTestHelpers.h"
 #include "util/IdTableHelpers.h"
 #include "util/IdTestHelpers.h"
 #include "util/IndexTestHelpers.h"
@@ -572,9 +573,14 @@ TEST(PathSearchTest, numPathsPerTarget) {
                                  true,
                                  1};
 
-  auto resultTable = performPathSearch(config, std::move(sub), vars);
+  auto resultTable = performPathSearch(config, sub.clone(), vars);
   ASSERT_THAT(resultTable.idTable(),
               ::testing::UnorderedElementsAreArray(expected));
+
+  // Zero paths per target yield no paths at all.
+  config.numPathsPerTarget_ = 0;
+  EXPECT_TRUE(
+      performPathSearch(config, std::move(sub), vars).idTable().empty());
 }
 
 /**
@@ -788,3 +794,215 @@ TEST(PathSearchTest, clone) {
   EXPECT_THAT(pathSearch, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), pathSearch.getDescriptor());
 }
+
+/**
+ * Graph:
+ *     1 --> 2
+ *    /       \
+ *   0         3
+ *    \       /
+ *     ---4---
+ */
+TEST(PathSearchTest, shortestPath) {
+  auto sub = makeIdTableFromVector({{0, 1}, {1, 2}, {2, 3}, {0, 4}, {4, 3}});
+  auto expected = makeIdTableFromVector({
+      {V(0), V(4), I(0), I(0)},
+      {V(4), V(3), I(0), I(1)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(3)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {}};
+
+  auto resultTable = performPathSearch(config, std::move(sub), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+}
+
+TEST(PathSearchTest, shortestPathAllTargets) {
+  auto sub = makeIdTableFromVector({{0, 1}, {1, 2}, {2, 3}, {0, 4}, {4, 3}});
+  auto expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0), V(1)},
+      {V(0), V(4), I(1), I(0), V(4)},
+      {V(0), V(1), I(2), I(0), V(2)},
+      {V(1), V(2), I(2), I(1), V(2)},
+      {V(0), V(4), I(3), I(0), V(3)},
+      {V(4), V(3), I(3), I(1), V(3)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 sources,
+                                 Var{"?targets"},
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {}};
+
+  auto resultTable = performPathSearch(config, std::move(sub), vars);
+  ASSERT_THAT(resultTable.idTable(), ::testing::ElementsAreArray(expected));
+}
+
+TEST(PathSearchTest, shortestPathWithEdgeWeights) {
+  auto sub = makeIdTableFromVector({{V(0), V(1), I(1)},
+                                    {V(1), V(2), I(1)},
+                                    {V(2), V(3), I(1)},
+                                    {V(0), V(4), I(5)},
+                                    {V(4), V(3), I(5)}});
+  auto expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0), I(1)},
+      {V(1), V(2), I(0), I(1), I(1)},
+      {V(2), V(3), I(0), I(2), I(1)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(3)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}, Variable{"?weight"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {Var{"?weight"}},
+                                 true,
+                                 std::nullopt,
+                                 Var{"?weight"}};
+
+  auto resultTable = performPathSearch(config, std::move(sub), vars);
+  ASSERT_THAT(resultTable.idTable(),
+              ::testing::UnorderedElementsAreArray(expected));
+}
+
+TEST(PathSearchTest, shortestPathNegativeEdgeWeight) {
+  auto sub = makeIdTableFromVector({{V(0), V(1), I(-1)}});
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(1)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}, Variable{"?weight"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {Var{"?weight"}},
+                                 true,
+                                 std::nullopt,
+                                 Var{"?weight"}};
+
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      performPathSearch(config, std::move(sub), vars),
+      ::testing::HasSubstr("must not be negative"));
+}
+
+/**
+ * Graph (with edge weights):
+ *      -----4-----
+ *     /           \
+ *    1 --1--> 2 -1-> 3
+ *   1                /
+ *  0 ------5--> 4 -5-
+ */
+TEST(PathSearchTest, kShortestPaths) {
+  auto sub = makeIdTableFromVector({{V(0), V(1), I(1)},
+                                    {V(1), V(2), I(1)},
+                                    {V(2), V(3), I(1)},
+                                    {V(1), V(3), I(4)},
+                                    {V(0), V(4), I(5)},
+                                    {V(4), V(3), I(5)}});
+  auto expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0), I(1)},
+      {V(1), V(2), I(0), I(1), I(1)},
+      {V(2), V(3), I(0), I(2), I(1)},
+      {V(0), V(1), I(1), I(0), I(1)},
+      {V(1), V(3), I(1), I(1), I(4)},
+      {V(0), V(4), I(2), I(0), I(5)},
+      {V(4), V(3), I(2), I(1), I(5)},
+  });
+
+  std::vector<Id> sources{V(0)};
+  std::vector<Id> targets{V(3)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}, Variable{"?weight"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::K_SHORTEST_PATHS,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {Var{"?weight"}},
+                                 true,
+                                 5,
+                                 Var{"?weight"}};
+
+  auto resultTable = performPathSearch(config, sub.clone(), vars);
+  ASSERT_THAT(resultTable.idTable(), ::testing::ElementsAreArray(expected));
+
+  // Only the two shortest paths.
+  config.numPathsPerTarget_ = 2;
+  expected.resize(5);
+  resultTable = performPathSearch(config, sub.clone(), vars);
+  ASSERT_THAT(resultTable.idTable(), ::testing::ElementsAreArray(expected));
+
+  // Without the edge weights, the paths with fewer edges come first.
+  config.edgeWeight_ = std::nullopt;
+  config.numPathsPerTarget_ = 3;
+  expected = makeIdTableFromVector({
+      {V(0), V(1), I(0), I(0), I(1)},
+      {V(1), V(3), I(0), I(1), I(4)},
+      {V(0), V(4), I(1), I(0), I(5)},
+      {V(4), V(3), I(1), I(1), I(5)},
+      {V(0), V(1), I(2), I(0), I(1)},
+      {V(1), V(2), I(2), I(1), I(1)},
+      {V(2), V(3), I(2), I(2), I(1)},
+  });
+  resultTable = performPathSearch(config, std::move(sub), vars);
+  ASSERT_THAT(resultTable.idTable(), ::testing::ElementsAreArray(expected));
+}
+
+// _____________________________________________________________________________
+TEST(PathSearchTest, lazyResultYieldsPathsPerSource) {
+  auto sub = makeIdTableFromVector({{0, 1}, {1, 2}, {2, 3}, {0, 4}, {4, 3}});
+
+  std::vector<Id> sources{V(0), V(1)};
+  std::vector<Id> targets{V(3)};
+  Vars vars = {Variable{"?start"}, Variable{"?end"}};
+  PathSearchConfiguration config{PathSearchAlgorithm::SHORTEST_PATH,
+                                 sources,
+                                 targets,
+                                 Var{"?start"},
+                                 Var{"?end"},
+                                 Var{"?edgeIndex"},
+                                 Var{"?pathIndex"},
+                                 {}};
+
+  auto qec = getQec();
+  auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(sub), vars);
+  PathSearch p = PathSearch(qec, std::move(subtree), std::move(config));
+  auto result = p.computeResult(true);
+  ASSERT_FALSE(result.isFullyMaterialized());
+
+  std::vector<IdTable> tables;
+  for (auto& [idTable, localVocab] : result.idTables()) {
+    tables.push_back(std::move(idTable));
+  }
+  ASSERT_EQ(tables.size(), 2);
+  EXPECT_EQ(tables[0], makeIdTableFromVector({{V(0), V(4), I(0), I(0)},
+                                              {V(4), V(3), I(0), I(1)}}));
+  EXPECT_EQ(tables[1], makeIdTableFromVector({{V(1), V(2), I(1), I(0)},
+                                              {V(2), V(3), I(1), I(1)}}));
+}
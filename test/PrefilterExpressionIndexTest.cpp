@@ -1230,6 +1230,59 @@ TEST_F(PrefilterExpressionOnMetadataTest, testWithFewBlockMetadataValues) {
             std::vector<CompressedBlockMetadata>{});
 }
 
+//______________________________________________________________________________
+// Test the prefiltering on the `ColumnSummary`s of (possibly unsorted) columns.
+TEST_F(PrefilterExpressionOnMetadataTest, testColumnSummaries) {
+  using Summary = CompressedBlockMetadata::ColumnSummary;
+  auto makeSummary = [](std::vector<Id> ids) {
+    Summary summary;
+    ql::ranges::for_each(ids, [&summary](Id id) { summary.add(id); });
+    return summary;
+  };
+  auto ints = makeSummary({IntId(10), IntId(1), IntId(5)});
+  EXPECT_TRUE(gt(IntId(5))->mayBeTrueForColumnSummary(indexVocab, ints));
+  EXPECT_TRUE(gt(DoubleId(9.5))->mayBeTrueForColumnSummary(indexVocab, ints));
+  EXPECT_FALSE(gt(IntId(10))->mayBeTrueForColumnSummary(indexVocab, ints));
+  EXPECT_FALSE(lt(IntId(1))->mayBeTrueForColumnSummary(indexVocab, ints));
+  EXPECT_FALSE(
+      andExpr(gt(IntId(5)), lt(IntId(1)))->mayBeTrueForColumnSummary(indexVocab,
+                                                                     ints));
+
+  // For a column with several datatypes, the range of each datatype is
+  // checked separately.
+  auto mixed = makeSummary({IntId(1), IntId(2), VocabId(10), VocabId(12)});
+  EXPECT_TRUE(lt(VocabId(5))->mayBeTrueForColumnSummary(indexVocab, mixed));
+  EXPECT_TRUE(gt(IntId(0))->mayBeTrueForColumnSummary(indexVocab, mixed));
+  EXPECT_FALSE(gt(VocabId(20))->mayBeTrueForColumnSummary(indexVocab, mixed));
+
+  // Only the blocks whose summary might match are kept, and blocks without a
+  // summary for the column are always kept.
+  auto makeBlockWithSummary = [this](std::optional<Summary> summary) {
+    auto block = makeBlock(IntId(0), IntId(0));
+    if (summary.has_value()) {
+      block.columnSummaries_.assign(3, summary.value());
+    }
+    return block;
+  };
+  std::vector<CompressedBlockMetadata> blocks{
+      makeBlockWithSummary(makeSummary({IntId(1), IntId(3)})),
+      makeBlockWithSummary(makeSummary({IntId(4), IntId(7)})),
+      makeBlockWithSummary(std::nullopt),
+      makeBlockWithSummary(makeSummary({IntId(9), IntId(2)})),
+      makeBlockWithSummary(makeSummary({IntId(-5), IntId(0)}))};
+  BlockMetadataSpan blockSpan{blocks};
+  auto evaluate = [this, &blockSpan](const PrefilterExpression& expr) {
+    return toVec(expr.evaluateOnColumnSummaries(
+        indexVocab, {BlockMetadataRange{blockSpan.begin(), blockSpan.end()}},
+        2));
+  };
+  using V = std::vector<CompressedBlockMetadata>;
+  EXPECT_EQ(evaluate(*gt(IntId(3))), (V{blocks[1], blocks[2], blocks[3]}));
+  EXPECT_EQ(evaluate(*lt(IntId(1))), (V{blocks[2], blocks[4]}));
+  EXPECT_EQ(evaluate(*eq(IntId(3))), (V{blocks[0], blocks[2], blocks[3]}));
+  EXPECT_EQ(evaluate(*gt(IntId(10))), (V{blocks[2]}));
+}
+
 //______________________________________________________________________________
 // Test method clone. clone() creates a copy of the complete PrefilterExpression
 // tree.
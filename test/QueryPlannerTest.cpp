@@ -1118,6 +1118,83 @@ TEST(QueryPlanner, PathSearchWithMultipleEdgePropertiesAndTargets) {
       qec);
 }
 
+TEST(QueryPlanner, PathSearchShortestPathWithEdgeWeight) {
+  auto scan = h::IndexScanFromStrings;
+  auto join = h::Join;
+  auto qec = ad_utility::testing::getQec(
+      "<x> <p> <y>. <x> <w> 1. <y> <p> <z>. <y> <w> 2");
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+
+  std::vector<Id> sources{getId("<x>")};
+  std::vector<Id> targets{getId("<z>")};
+  PathSearchConfiguration config{PathSearchAlgorithm::K_SHORTEST_PATHS,
+                                 sources,
+                                 targets,
+                                 Variable("?start"),
+                                 Variable("?end"),
+                                 Variable("?path"),
+                                 Variable("?edge"),
+                                 {Variable("?weight")},
+                                 true,
+                                 2,
+                                 Variable("?weight")};
+  h::expect(
+      "PREFIX pathSearch: <https://qlever.cs.uni-freiburg.de/pathSearch/>"
+      "SELECT ?start ?end ?path ?edge WHERE {"
+      "SERVICE pathSearch: {"
+      "_:path pathSearch:algorithm pathSearch:kShortestPaths ;"
+      "pathSearch:source <x> ;"
+      "pathSearch:target <z> ;"
+      "pathSearch:pathColumn ?path ;"
+      "pathSearch:edgeColumn ?edge ;"
+      "pathSearch:start ?start;"
+      "pathSearch:end ?end;"
+      "pathSearch:edgeProperty ?weight;"
+      "pathSearch:edgeWeight ?weight;"
+      "pathSearch:numPathsPerTarget 2;"
+      "{SELECT * WHERE {"
+      "?start <p> ?end."
+      "?start <w> ?weight."
+      "}}}}",
+      h::pathSearch(config, true, true,
+                    h::Sort(join(scan("?start", "<p>", "?end"),
+                                 scan("?start", "<w>", "?weight")))),
+      qec);
+}
+
+// __________________________________________________________________________
+TEST(QueryPlanner, PathSearchEdgeWeightNotAnEdgeProperty) {
+  auto qec = ad_utility::testing::getQec("<x> <p> <y>. <y> <p> <z>");
+
+  auto query = [](std::string_view algorithm) {
+    return absl::StrCat(
+        "PREFIX pathSearch: <https://qlever.cs.uni-freiburg.de/pathSearch/>"
+        "SELECT ?start ?end ?path ?edge WHERE {"
+        "SERVICE pathSearch: {"
+        "_:path pathSearch:algorithm pathSearch:",
+        algorithm,
+        " ;"
+        "pathSearch:source <x> ;"
+        "pathSearch:target <z> ;"
+        "pathSearch:pathColumn ?path ;"
+        "pathSearch:edgeColumn ?edge ;"
+        "pathSearch:start ?start;"
+        "pathSearch:end ?end;"
+        "pathSearch:edgeWeight ?end;"
+        "{SELECT * WHERE {"
+        "?start <p> ?end."
+        "}}}}");
+  };
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      h::parseAndPlan(query("shortestPath"), qec),
+      HasSubstr("has to be one of the variables given via <edgeProperty>"),
+      parsedQuery::PathSearchException);
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      h::parseAndPlan(query("allPaths"), qec),
+      HasSubstr("<edgeWeight> is only supported by the algorithms"),
+      parsedQuery::PathSearchException);
+}
+
 TEST(QueryPlanner, PathSearchJoinOnEdgeProperty) {
   auto scan = h::IndexScanFromStrings;
   auto join = h::Join;
@@ -1540,7 +1617,7 @@ TEST(QueryPlanner, PathSearchUnsupportedAlgorithm) {
       "PREFIX pathSearch: <https://qlever.cs.uni-freiburg.de/pathSearch/>"
       "SELECT ?start ?end ?path ?edge WHERE {"
       "SERVICE pathSearch: {"
-      "_:path pathSearch:algorithm pathSearch:shortestPath ;"
+      "_:path pathSearch:algorithm pathSearch:longestPath ;"
       "pathSearch:source ?source1 ;"
       "pathSearch:source ?source2 ;"
       "pathSearch:target <z> ;"
@@ -1609,6 +1686,43 @@ TEST(QueryPlanner, PathSearchWrongArgumentNumPathsPerTarget) {
       h::parseAndPlan(std::move(query), qec),
       HasSubstr("The parameter <numPathsPerTarget> expects an integer"),
       InvalidSparqlQueryException);
+
+  // A negative number of paths per target is not allowed, zero is only
+  // allowed for `<allPaths>`.
+  auto makeQuery = [](std::string_view algorithm, std::string_view numPaths) {
+    return absl::StrCat(
+        "PREFIX pathSearch: <https://qlever.cs.uni-freiburg.de/pathSearch/>"
+        "SELECT ?start ?end ?path ?edge WHERE {"
+        "SERVICE pathSearch: {"
+        "_:path pathSearch:algorithm pathSearch:",
+        algorithm,
+        " ;"
+        "pathSearch:source <x> ;"
+        "pathSearch:target <z> ;"
+        "pathSearch:pathColumn ?path ;"
+        "pathSearch:edgeColumn ?edge ;"
+        "pathSearch:start ?start;"
+        "pathSearch:end ?end;"
+        "pathSearch:numPathsPerTarget ",
+        numPaths,
+        ";"
+        "{SELECT * WHERE {"
+        "?start <p> ?end."
+        "}}}}");
+  };
+  for (std::string_view algorithm : {"allPaths", "kShortestPaths"}) {
+    AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+        h::parseAndPlan(makeQuery(algorithm, "-1"), qec),
+        HasSubstr("The parameter <numPathsPerTarget> expects a non-negative "
+                  "integer"),
+        InvalidSparqlQueryException);
+  }
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      h::parseAndPlan(makeQuery("kShortestPaths", "0"), qec),
+      HasSubstr("The parameter <numPathsPerTarget> has to be positive for "
+                "the algorithm <kShortestPaths>"),
+      parsedQuery::PathSearchException);
+  EXPECT_NO_THROW(h::parseAndPlan(makeQuery("allPaths", "0"), qec));
 }
 
 // __________________________________________________________________________
@@ -2288,6 +2402,56 @@ TEST(QueryPlanner, SpatialJoinServiceMultipleGraphPatterns) {
 }
 
 // _____________________________________________________________________________
+TEST(QueryPlanner, SpatialIndexScanService) {
+  using V = Variable;
+  std::string prefix =
+      "PREFIX spatialSearch: <https://qlever.cs.uni-freiburg.de/spatialSearch/>"
+      "PREFIX geo: <http://www.opengis.net/ont/geosparql#>"
+      "SELECT * WHERE {";
+  std::string box =
+      "\"POLYGON((7.7 47.9, 8 47.9, 8 48.1, 7.7 48.1, 7.7 47.9))\""
+      "^^geo:wktLiteral";
+  h::expect(absl::StrCat(prefix,
+                         "SERVICE spatialSearch: {"
+                         "_:config spatialSearch:left ?geometry ;"
+                         "spatialSearch:boundingBox ",
+                         box, " . }}"),
+            h::spatialIndexScan(V{"?geometry"}, {7.7, 47.9, 8, 48.1}));
+  h::expect(
+      absl::StrCat(prefix, "?x <p> ?geometry ."
+                           "SERVICE spatialSearch: {"
+                           "_:config spatialSearch:left ?geometry ;"
+                           "spatialSearch:boundingBox ",
+                   box, " . }}"),
+      h::Join(h::IndexScanFromStrings("?x", "<p>", "?geometry"),
+              h::spatialIndexScan(V{"?geometry"}, {7.7, 47.9, 8, 48.1})));
+
+  // Invalid configurations.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      h::expect(absl::StrCat(prefix,
+                             "SERVICE spatialSearch: {"
+                             "_:config spatialSearch:left ?geometry ;"
+                             "spatialSearch:boundingBox \"no WKT\" . }}"),
+                ::testing::_),
+      ::testing::HasSubstr("`<boundingBox>` expects a valid WKT literal"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      h::expect(absl::StrCat(prefix,
+                             "SERVICE spatialSearch: {"
+                             "_:config spatialSearch:boundingBox ",
+                             box, " . }}"),
+                ::testing::_),
+      ::testing::HasSubstr("Missing parameter `<left>`"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      h::expect(absl::StrCat(prefix,
+                             "SERVICE spatialSearch: {"
+                             "_:config spatialSearch:left ?geometry ;"
+                             "spatialSearch:maxDistance 5 ;"
+                             "spatialSearch:boundingBox ",
+                             box, " . }}"),
+                ::testing::_),
+      ::testing::HasSubstr("does not support any other parameter"));
+}
+
 TEST(QueryPlanner, SpatialJoinIncorrectConfigValues) {
   // Tests with mistakes in the config
   AD_EXPECT_THROW_WITH_MESSAGE(
@@ -5480,3 +5644,32 @@ TEST(QueryPlanner, NamedCachedResult) {
   // contents etc. of cached queries.
   h::expect(query, h::ExplicitIdTableOperation(3), qec);
 }
+
+// _____________________________________________________________________________
+TEST(QueryPlanner, hashJoinForLargeUnsortedInputs) {
+  // Two VALUES clauses are not sorted, so a `Join` would have to sort both of
+  // them. For large inputs, a `HashJoin` is cheaper.
+  auto makeValues = [](std::string_view var, size_t numRows) {
+    std::string values = absl::StrCat("VALUES ", var, " {");
+    for (size_t i = 0; i < numRows; ++i) {
+      absl::StrAppend(&values, " ", numRows - i);
+    }
+    return absl::StrCat(values, " }");
+  };
+  auto makeQuery = [&makeValues](size_t numRows) {
+    return absl::StrCat("SELECT * { { ", makeValues("?x", numRows),
+                        " } { ", makeValues("?x", numRows), " } }");
+  };
+  auto values = h::RootOperation<::Values>(::testing::_);
+
+  // The hash join is disabled by default.
+  h::expect(makeQuery(10'000), h::Join(h::Sort(values), h::Sort(values)));
+
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::hashJoinEnabled_>(true);
+  h::expect(makeQuery(10'000), h::HashJoin(values, values));
+
+  // For small inputs, sorting is cheap.
+  h::expect(makeQuery(5), h::Join(h::Sort(values), h::Sort(values)));
+  h::expect(makeQuery(1'000), h::Join(h::Sort(values), h::Sort(values)));
+}
@@ -21,6 +21,7 @@
 #include "engine/ExplicitIdTableOperation.h"
 #include "engine/Filter.h"
 #include "engine/GroupBy.h"
+#include "engine/HashJoin.h"
 #include "engine/IndexScan.h"
 #include "engine/Join.h"
 #include "engine/Minus.h"
@@ -33,6 +34,7 @@
 #include "engine/QueryExecutionTree.h"
 #include "engine/QueryPlanner.h"
 #include "engine/Sort.h"
+#include "engine/SpatialIndexScan.h"
 #include "engine/SpatialJoin.h"
 #include "engine/TextIndexScanForEntity.h"
 #include "engine/TextIndexScanForWord.h"
@@ -297,6 +299,7 @@ inline auto IndexScanFromStrings =
 // important.
 inline auto MultiColumnJoin = MatchTypeAndUnorderedChildren<::MultiColumnJoin>;
 inline auto Join = MatchTypeAndUnorderedChildren<::Join>;
+inline auto HashJoin = MatchTypeAndUnorderedChildren<::HashJoin>;
 
 constexpr auto OptionalJoin = MatchTypeAndOrderedChildren<::OptionalJoin>;
 
@@ -377,7 +380,8 @@ inline auto PathSearchConfigMatcher = [](PathSearchConfiguration config) {
       AD_FIELD(PathSearchConfiguration, pathColumn_, Eq(config.pathColumn_)),
       AD_FIELD(PathSearchConfiguration, edgeColumn_, Eq(config.edgeColumn_)),
       AD_FIELD(PathSearchConfiguration, edgeProperties_,
-               UnorderedElementsAreArray(config.edgeProperties_)));
+               UnorderedElementsAreArray(config.edgeProperties_)),
+      AD_FIELD(PathSearchConfiguration, edgeWeight_, Eq(config.edgeWeight_)));
 };
 
 // Match a PathSearch operation
@@ -427,6 +431,14 @@ struct SpatialJoinMatcher {
 constexpr inline SpatialJoinMatcher spatialJoin;
 constexpr inline SpatialJoinMatcher<true> spatialJoinFilterSubstitute;
 
+// Match a SpatialIndexScan operation.
+inline auto spatialIndexScan = [](Variable variable,
+                                  SpatialIndex::Box box) -> QetMatcher {
+  return RootOperation<::SpatialIndexScan>(
+      AllOf(AD_PROPERTY(::SpatialIndexScan, variable, Eq(variable)),
+            AD_PROPERTY(::SpatialIndexScan, box, Eq(box))));
+};
+
 // Match a GroupBy operation
 static constexpr auto GroupBy =
     [](const std::vector<Variable>& groupByVariables,
@@ -0,0 +1,279 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <absl/strings/str_cat.h>
+
+#include <random>
+
+#include "engine/ExportQueryExecutionTrees.h"
+#include "engine/QueryPlanner.h"
+#include "index/ReachabilityIndex.h"
+#include "parser/SparqlParser.h"
+#include "util/HashSet.h"
+#include "util/IndexTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
+
+using Graph = ReachabilityIndex::Graph;
+
+namespace {
+Id node(uint64_t i) { return Id::makeFromVocabIndex(VocabIndex::make(i)); }
+
+// Return the sorted nodes that can be reached from `start` via a path with at
+// least `minDist` edges, computed by a breadth-first search.
+std::vector<Id> bfs(const std::vector<std::array<Id, 2>>& edges, Id start,
+                    size_t minDist) {
+  std::vector<Id> frontier{start};
+  ad_utility::HashSet<Id> reached;
+  if (minDist == 0) {
+    reached.insert(start);
+  }
+  while (!frontier.empty()) {
+    std::vector<Id> next;
+    for (Id source : frontier) {
+      for (const auto& [from, to] : edges) {
+        if (from == source && reached.insert(to).second) {
+          next.push_back(to);
+        }
+      }
+    }
+    frontier = std::move(next);
+  }
+  std::vector<Id> result(reached.begin(), reached.end());
+  ql::ranges::sort(result);
+  return result;
+}
+
+// Return all nodes that can be reached according to the `graph`, sorted.
+std::vector<Id> reachable(const Graph& graph, Id start, size_t minDist,
+                          bool forward) {
+  std::vector<Id> result;
+  graph.forEachReachableNode(start, minDist, forward,
+                             [&result](Id id) { result.push_back(id); });
+  ql::ranges::sort(result);
+  return result;
+}
+
+// Run the `query` on the index with the given `config` and return the result
+// as TSV.
+std::string runQuery(ad_utility::testing::TestIndexConfig config,
+                     const std::string& query) {
+  auto qec = ad_utility::testing::getQec(std::move(config));
+  qec->clearCacheUnpinnedOnly();
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  QueryPlanner qp{qec, cancellationHandle};
+  static EncodedIriManager encodedIriManager;
+  auto pq = SparqlParser::parseQuery(&encodedIriManager, query);
+  auto qet = qp.createExecutionTree(pq);
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  std::string result;
+  for (const auto& block : ExportQueryExecutionTrees::computeResult(
+           pq, qet, ad_utility::MediaType::tsv, timer,
+           std::move(cancellationHandle))) {
+    result += block;
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, smallGraph) {
+  // 0 -> 1 -> 2 <-> 3 -> 4, 5 -> 5, and 6 -> 4.
+  std::vector<Id> sources{node(0), node(1), node(2), node(3), node(5), node(6)};
+  std::vector<Id> targets{node(1), node(2), node(3), node(2), node(5), node(4)};
+  sources.push_back(node(3));
+  targets.push_back(node(4));
+  auto graph = Graph::build(sources, targets);
+  EXPECT_EQ(graph.numNodes(), 7);
+  EXPECT_EQ(graph.numEdges(), 7);
+  // The components are {2, 3} and the single nodes.
+  EXPECT_EQ(graph.numComponents(), 6);
+
+  EXPECT_TRUE(graph.isReachable(node(0), node(4), 1, true));
+  EXPECT_FALSE(graph.isReachable(node(4), node(0), 1, true));
+  EXPECT_TRUE(graph.isReachable(node(4), node(0), 1, false));
+  EXPECT_FALSE(graph.isReachable(node(0), node(0), 1, true));
+  EXPECT_TRUE(graph.isReachable(node(0), node(0), 0, true));
+  EXPECT_TRUE(graph.isReachable(node(2), node(2), 1, true));
+  EXPECT_TRUE(graph.isReachable(node(5), node(5), 1, true));
+  EXPECT_FALSE(graph.isReachable(node(6), node(2), 0, true));
+  // Nodes that are not part of the graph.
+  EXPECT_TRUE(graph.isReachable(node(42), node(42), 0, true));
+  EXPECT_FALSE(graph.isReachable(node(42), node(42), 1, true));
+
+  using ::testing::ElementsAre;
+  EXPECT_THAT(reachable(graph, node(1), 1, true),
+              ElementsAre(node(2), node(3), node(4)));
+  EXPECT_THAT(reachable(graph, node(1), 0, true),
+              ElementsAre(node(1), node(2), node(3), node(4)));
+  EXPECT_THAT(reachable(graph, node(4), 1, false),
+              ElementsAre(node(0), node(1), node(2), node(3), node(6)));
+  EXPECT_THAT(reachable(graph, node(42), 0, true), ElementsAre(node(42)));
+  EXPECT_TRUE(reachable(graph, node(42), 1, true).empty());
+
+  EXPECT_THAT(graph.nodesWithSuccessors(true),
+              ElementsAre(node(0), node(1), node(2), node(3), node(5),
+                          node(6)));
+  EXPECT_THAT(graph.nodesWithSuccessors(false),
+              ElementsAre(node(1), node(2), node(3), node(4), node(5)));
+  EXPECT_FALSE(graph.hasSuccessor(node(4), true));
+  EXPECT_TRUE(graph.hasSuccessor(node(4), false));
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, randomGraphsMatchBreadthFirstSearch) {
+  std::mt19937_64 randomEngine{42};
+  for (size_t numNodes : {1, 5, 30, 80}) {
+    for (size_t numEdges : {numNodes / 2, numNodes, 2 * numNodes}) {
+      std::uniform_int_distribution<uint64_t> randomNode{0, numNodes - 1};
+      std::vector<std::array<Id, 2>> edges;
+      std::vector<Id> sources;
+      std::vector<Id> targets;
+      for (size_t i = 0; i < numEdges; ++i) {
+        Id from = node(randomNode(randomEngine));
+        Id to = node(randomNode(randomEngine));
+        edges.push_back({from, to});
+        sources.push_back(from);
+        targets.push_back(to);
+      }
+      auto reversedEdges = edges;
+      for (auto& edge : reversedEdges) {
+        std::swap(edge[0], edge[1]);
+      }
+      auto graph = Graph::build(sources, targets);
+      // Also check one node that is not part of the graph.
+      for (uint64_t i = 0; i <= numNodes; ++i) {
+        for (size_t minDist : {0, 1}) {
+          for (bool forward : {true, false}) {
+            const auto& directedEdges = forward ? edges : reversedEdges;
+            auto expected = bfs(directedEdges, node(i), minDist);
+            EXPECT_EQ(reachable(graph, node(i), minDist, forward), expected)
+                << numNodes << ' ' << numEdges << ' ' << i << ' ' << minDist
+                << ' ' << forward;
+            for (uint64_t j = 0; j <= numNodes; ++j) {
+              EXPECT_EQ(graph.isReachable(node(i), node(j), minDist, forward),
+                        ql::ranges::binary_search(expected, node(j)));
+            }
+            if (minDist == 1) {
+              EXPECT_EQ(graph.hasSuccessor(node(i), forward),
+                        !bfs(directedEdges, node(i), 1).empty());
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, builderAndGraphsOnDemand) {
+  std::string filename = "ReachabilityIndexTest.builder.reachability-index";
+  Id p1 = node(100);
+  Id p2 = node(101);
+  Id other = node(102);
+  ReachabilityIndex::Builder builder{filename, {p1, p2}};
+  builder.addTriple(node(0), p1, node(1));
+  builder.addTriple(node(1), p1, node(2));
+  builder.addTriple(node(1), p1, node(2));
+  builder.addTriple(node(0), other, node(3));
+  builder.addTriple(node(3), p2, node(4));
+  builder.finish();
+
+  ReachabilityIndex index;
+  index.readFromFile(filename);
+  EXPECT_EQ(index.numPredicates(), 2);
+  auto graph1 = index.getGraph(p1);
+  ASSERT_NE(graph1, nullptr);
+  EXPECT_EQ(graph1->numEdges(), 2);
+  EXPECT_TRUE(graph1->isReachable(node(0), node(2), 1, true));
+  auto graph2 = index.getGraph(p2);
+  ASSERT_NE(graph2, nullptr);
+  EXPECT_EQ(graph2->numNodes(), 2);
+  EXPECT_EQ(index.getGraph(other), nullptr);
+
+  // Graphs that are added on demand.
+  std::vector<Id> sources{node(0)};
+  std::vector<Id> targets{node(3)};
+  auto graph = std::make_shared<Graph>(Graph::build(sources, targets));
+  auto size = graph->sizeInMemory();
+  EXPECT_GT(size, ad_utility::MemorySize::bytes(0));
+  auto maxSize = size * 3 / 2;
+  EXPECT_EQ(index.addGraph(other, graph, maxSize), graph);
+  EXPECT_EQ(index.getGraph(other), graph);
+  auto otherGraph = std::make_shared<Graph>(Graph::build(sources, targets));
+  EXPECT_EQ(index.addGraph(other, otherGraph, maxSize), graph);
+  // The graphs of the index are not replaced.
+  EXPECT_EQ(index.addGraph(p1, otherGraph, maxSize), graph1);
+  EXPECT_EQ(index.numPredicates(), 2);
+
+  // The graphs that are built on demand are evicted when they don't fit.
+  EXPECT_EQ(index.addGraph(node(5), otherGraph, maxSize), otherGraph);
+  EXPECT_EQ(index.getGraph(other), nullptr);
+  EXPECT_EQ(index.getGraph(node(5)), otherGraph);
+  // A graph that is too large is used, but not stored.
+  auto tooLarge = std::make_shared<Graph>(Graph::build(sources, targets));
+  EXPECT_EQ(index.addGraph(node(6), tooLarge, size / 2), tooLarge);
+  EXPECT_EQ(index.getGraph(node(6)), nullptr);
+  EXPECT_EQ(index.getGraph(p1), graph1);
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(ReachabilityIndex, transitivePathsGiveSameResults) {
+  std::string kg =
+      "<a> <sub> <b> . <b> <sub> <c> . <c> <sub> <d> . <d> <sub> <b> . "
+      "<e> <sub> <c> . <f> <sub> <f> . <g> <sub> <a> . <h> <sub> <i> . "
+      "<x> <type> <a> . <y> <type> <e> . <z> <type> <i> . <a> <other> <h> .";
+  ad_utility::testing::TestIndexConfig withoutIndex{kg};
+  auto withIndex = withoutIndex;
+  withIndex.reachabilityIndexPredicates = {"<sub>"};
+  EXPECT_EQ(ad_utility::testing::getQec(withIndex)
+                ->getIndex()
+                .getReachabilityIndex()
+                .numPredicates(),
+            1);
+
+  std::vector<std::string> queries{
+      "SELECT ?x ?y WHERE { ?x <sub>+ ?y }",
+      "SELECT ?x ?y WHERE { ?x <sub>* ?y }",
+      "SELECT ?x WHERE { ?x <sub>* <c> }",
+      "SELECT ?x WHERE { ?x <sub>+ <a> }",
+      "SELECT ?x WHERE { ?x <sub>+ ?x }",
+      "SELECT ?y WHERE { <a> <sub>+ ?y }",
+      "SELECT ?y WHERE { <b> <sub>* ?y }",
+      "SELECT ?y WHERE { <notInGraph> <sub>* ?y }",
+      "SELECT * WHERE { <a> <sub>+ <d> }",
+      "SELECT * WHERE { <d> <sub>+ <a> }",
+      "SELECT ?x ?y WHERE { ?x <sub>/<sub> ?y }",
+      "SELECT ?s ?y WHERE { ?s <type> ?x . ?x <sub>+ ?y }",
+      "SELECT ?s ?x WHERE { ?s <type> ?y . ?x <sub>* ?y }",
+      "SELECT ?y WHERE { <a> <other>/<sub>* ?y }"};
+  auto withOrderBy = [](const std::string& query) {
+    auto variables = query.substr(7, query.find(" WHERE") - 7);
+    return absl::StrCat(query,
+                        variables == "*" ? "" : " ORDER BY " + variables);
+  };
+  for (const auto& query : queries | ql::views::transform(withOrderBy)) {
+    auto expected = runQuery(withoutIndex, query);
+    EXPECT_EQ(runQuery(withIndex, query), expected) << query;
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::transitivePathReachabilityIndexOnDemand_>(true);
+    EXPECT_EQ(runQuery(withoutIndex, query), expected) << query;
+  }
+  EXPECT_EQ(
+      runQuery(withIndex, "SELECT ?x WHERE { ?x <sub>+ <c> } ORDER BY ?x"),
+      "?x\n<a>\n<b>\n<c>\n<d>\n<e>\n<g>\n");
+
+  // The graph of `<sub>` was built on demand for the index without the
+  // precomputed reachability index.
+  auto qec = ad_utility::testing::getQec(withoutIndex);
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  const auto& reachabilityIndex = qec->getIndex().getReachabilityIndex();
+  EXPECT_EQ(reachabilityIndex.numPredicates(), 0);
+  EXPECT_NE(reachabilityIndex.getGraph(getId("<sub>")), nullptr);
+  EXPECT_EQ(reachabilityIndex.getGraph(getId("<type>")), nullptr);
+}
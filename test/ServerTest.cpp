@@ -115,11 +115,14 @@ TEST(ServerTest, chooseBestFittingMediaType) {
   EXPECT_EQ(choose({qleverJson}, askQuery), qleverJson);
   EXPECT_EQ(choose({qleverJson}, selectQuery), qleverJson);
   EXPECT_EQ(choose({qleverJson}, constructQuery), qleverJson);
+  EXPECT_EQ(choose({arrowStream}, selectQuery), arrowStream);
 
   // Single non-matching element
   EXPECT_EQ(choose({tsv}, askQuery), sparqlJson);
   EXPECT_EQ(choose({turtle}, selectQuery), sparqlJson);
   EXPECT_EQ(choose({octetStream}, constructQuery), turtle);
+  EXPECT_EQ(choose({arrowStream}, askQuery), sparqlJson);
+  EXPECT_EQ(choose({arrowStream}, constructQuery), turtle);
 
   // Multiple matching elements
   EXPECT_EQ(choose({sparqlJson, qleverJson}, askQuery), sparqlJson);
@@ -11,6 +11,7 @@
 #include "global/ValueIdComparators.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using namespace std::string_literals;
 using namespace std::chrono_literals;
@@ -233,3 +234,42 @@ TEST(Sort, clone) {
   EXPECT_THAT(sort, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), sort.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(Sort, externalSort) {
+  VectorTable input;
+  for (int64_t i = 0; i < 2'500; ++i) {
+    input.push_back({(i * 7919) % 100, i});
+  }
+  auto inputTable = makeIdTableFromVector(input);
+  auto expected = [&]() {
+    Sort sort = makeSort(inputTable.clone(), {0, 1});
+    return sort.computeResultOnlyForTesting(false).idTable().clone();
+  }();
+  ASSERT_EQ(expected.numRows(), 2'500);
+  ASSERT_TRUE(ql::ranges::is_sorted(expected.getColumn(0)));
+
+  // With a fraction of zero, every sort is performed externally.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::externalSortMemoryFraction_>(0.0);
+  {
+    Sort sort = makeSort(inputTable.clone(), {0, 1});
+    auto result = sort.computeResultOnlyForTesting(false);
+    // A fully materialized result would need as much memory as the
+    // in-memory sort, so the external sort is only used for lazy results.
+    ASSERT_TRUE(result.isFullyMaterialized());
+    EXPECT_FALSE(sort.runtimeInfo().details_.contains("external-sort-memory"));
+    EXPECT_EQ(result.idTable(), expected);
+  }
+  {
+    Sort sort = makeSort(inputTable.clone(), {0, 1});
+    auto result = sort.computeResultOnlyForTesting(true);
+    ASSERT_FALSE(result.isFullyMaterialized());
+    EXPECT_TRUE(sort.runtimeInfo().details_.contains("external-sort-memory"));
+    IdTable aggregate{2, ad_utility::testing::makeAllocator()};
+    for (auto& [block, localVocab] : result.idTables()) {
+      aggregate.insertAtEnd(block);
+    }
+    EXPECT_EQ(aggregate, expected);
+  }
+}
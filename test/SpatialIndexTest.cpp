@@ -0,0 +1,102 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "index/SpatialIndex.h"
+#include "util/AllocatorTestHelpers.h"
+#include "util/Random.h"
+
+using Box = SpatialIndex::Box;
+
+namespace {
+// Build a `SpatialIndex` for the `boxes` (the index of each box is its
+// position) and return the loaded index.
+SpatialIndex makeIndex(const std::vector<Box>& boxes,
+                       const std::string& filename) {
+  SpatialIndex::Builder builder{filename, ad_utility::MemorySize::megabytes(10),
+                                ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    const auto& box = boxes[i];
+    builder.addGeometry(
+        VocabIndex::make(i),
+        ad_utility::BoundingBox{{box.minLat_, box.minLng_},
+                                {box.maxLat_, box.maxLng_}});
+  }
+  builder.finish();
+  SpatialIndex index;
+  index.readFromFile(filename);
+  return index;
+}
+
+// Return the indices of the `boxes` that intersect the `query`.
+std::vector<VocabIndex> intersectingBruteForce(const std::vector<Box>& boxes,
+                                               const Box& query) {
+  std::vector<VocabIndex> result;
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    if (boxes[i].intersects(query)) {
+      result.push_back(VocabIndex::make(i));
+    }
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SpatialIndex, hilbertValue) {
+  EXPECT_EQ(SpatialIndex::hilbertValue({-180, -90, -180, -90}), 0);
+  EXPECT_EQ(SpatialIndex::hilbertValue({180, -90, 180, -90}),
+            (uint64_t{1} << 32) - 1);
+  // Coordinates outside of the valid range are clamped.
+  EXPECT_EQ(SpatialIndex::hilbertValue({-200, -100, -200, -100}), 0);
+  // Close boxes have closer Hilbert values than distant ones.
+  auto freiburg = SpatialIndex::hilbertValue({7.83, 48.01, 7.84, 48.02});
+  auto minster = SpatialIndex::hilbertValue({7.85, 47.99, 7.86, 48.0});
+  auto newYork = SpatialIndex::hilbertValue({-74.05, 40.68, -74.04, 40.69});
+  auto distance = [](uint64_t a, uint64_t b) { return a > b ? a - b : b - a; };
+  EXPECT_LT(distance(freiburg, minster), distance(freiburg, newYork));
+}
+
+// _____________________________________________________________________________
+TEST(SpatialIndex, emptyIndex) {
+  std::string filename = "SpatialIndexTest.emptyIndex.spatial-index";
+  auto index = makeIndex({}, filename);
+  EXPECT_TRUE(index.isLoaded());
+  EXPECT_EQ(index.numGeometries(), 0);
+  EXPECT_TRUE(index.getIntersecting({-180, -90, 180, 90}).empty());
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(SpatialIndex, getIntersecting) {
+  std::string filename = "SpatialIndexTest.getIntersecting.spatial-index";
+  // Enough boxes for a tree with several inner levels.
+  using ad_utility::RandomSeed;
+  ad_utility::RandomDoubleGenerator lng{-180, 175, RandomSeed::make(42)};
+  ad_utility::RandomDoubleGenerator lat{-90, 85, RandomSeed::make(43)};
+  ad_utility::RandomDoubleGenerator size{0, 5, RandomSeed::make(44)};
+  std::vector<Box> boxes;
+  for (size_t i = 0; i < 5000; ++i) {
+    double minLng = lng();
+    double minLat = lat();
+    boxes.push_back({minLng, minLat, minLng + size(), minLat + size()});
+  }
+  auto index = makeIndex(boxes, filename);
+  EXPECT_EQ(index.numGeometries(), boxes.size());
+
+  for (const Box& query :
+       std::vector<Box>{{-180, -90, 180, 90},
+                        {7.7, 47.9, 8.0, 48.1},
+                        {-10, -10, 10, 10},
+                        {100, 20, 140, 30},
+                        {179.5, 89.5, 180, 90},
+                        {0, 0, 0, 0},
+                        boxes.at(17)}) {
+    EXPECT_EQ(index.getIntersecting(query),
+              intersectingBruteForce(boxes, query));
+  }
+  EXPECT_EQ(index.getIntersecting({-180, -90, 180, 90}).size(), boxes.size());
+  ad_utility::deleteFile(filename);
+}
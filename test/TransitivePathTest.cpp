@@ -19,6 +19,7 @@
 #include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
 
 using ad_utility::testing::getQec;
 namespace {
@@ -129,6 +130,24 @@ class TransitivePathTest
     }
   }
 
+  // Fully materialize the `result` and return its rows, sorted.
+  static std::vector<std::vector<Id>> sortedRows(const Result& result,
+                                                 size_t numColumns = 2) {
+    IdTable idTable =
+        result.isFullyMaterialized()
+            ? result.idTable().clone()
+            : aggregateTables(result.idTables(), numColumns).first;
+    std::vector<std::vector<Id>> rows;
+    for (const auto& row : idTable) {
+      auto& ids = rows.emplace_back();
+      for (Id id : row) {
+        ids.push_back(id);
+      }
+    }
+    ql::ranges::sort(rows);
+    return rows;
+  }
+
   // Call testCase three times with differing arguments. This is used to test
   // scenarios where the same input table is delivered in different splits
   // either wrapped within a generator or as a single table.
@@ -1175,6 +1194,7 @@ TEST_P(TransitivePathTest, sameVariableOnBothSidesUnbound) {
 
   auto resultTable = T->computeResultOnlyForTesting(requestLaziness());
   assertResultMatchesIdTable(resultTable, expected);
+  EXPECT_TRUE(T->runtimeInfo().details_.contains("Bidirectional search"));
 }
 
 // _____________________________________________________________________________
@@ -1852,6 +1872,80 @@ TEST_P(TransitivePathTest, sortOrderGuaranteesWithBoundOperation) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, bidirectionalSearch) {
+  // Two cycles, which are connected in one direction, and a self loop.
+  auto sub = makeIdTableFromVector(
+      {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 3}, {5, 5}, {4, 6}});
+  Vars vars{Variable{"?start"}, Variable{"?target"}};
+  // Compute the paths from `start` to `target` with the given length bounds,
+  // with or without the bidirectional search.
+  auto computePath = [&](size_t start, size_t target, size_t minDist,
+                         size_t maxDist, bool bidirectional) {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::transitivePathBidirectionalSearch_>(bidirectional);
+    TransitivePathSide left(std::nullopt, 0, V(start), 0);
+    TransitivePathSide right(std::nullopt, 1, V(target), 1);
+    auto T = makePathUnbound(sub.clone(), vars, left, right, minDist, maxDist);
+    auto rows = sortedRows(T->computeResultOnlyForTesting(requestLaziness()));
+    // The target is fixed, so a single search from the target is used.
+    EXPECT_EQ(T->runtimeInfo().details_.contains("Backward search"),
+              bidirectional && maxDist == std::numeric_limits<size_t>::max());
+    return rows;
+  };
+  constexpr size_t inf = std::numeric_limits<size_t>::max();
+  for (size_t start : {0, 3, 5, 6, 7}) {
+    for (size_t target : {0, 2, 3, 5, 6, 7}) {
+      for (size_t minDist : {0, 1}) {
+        EXPECT_EQ(computePath(start, target, minDist, inf, true),
+                  computePath(start, target, minDist, inf, false))
+            << start << ' ' << target << ' ' << minDist;
+      }
+    }
+  }
+  EXPECT_THAT(computePath(0, 6, 1, inf, true),
+              ElementsAre(ElementsAre(V(0), V(6))));
+  EXPECT_THAT(computePath(6, 0, 0, inf, true), IsEmpty());
+  EXPECT_THAT(computePath(3, 0, 0, inf, true), IsEmpty());
+  // The bidirectional search is not used with an upper bound for the length.
+  EXPECT_THAT(computePath(0, 6, 1, 4, true), IsEmpty());
+  EXPECT_THAT(computePath(0, 6, 1, 5, true),
+              ElementsAre(ElementsAre(V(0), V(6))));
+}
+
+// _____________________________________________________________________________
+TEST_P(TransitivePathTest, parallelHullComputation) {
+  // A graph with long paths and enough start nodes to split them into several
+  // batches.
+  VectorTable edges;
+  for (int64_t i = 0; i < 300; ++i) {
+    edges.push_back({i, (i * 7 + 3) % 300});
+    edges.push_back({i, (i + 1) % 297});
+  }
+  auto sub = makeIdTableFromVector(edges);
+  Vars vars{Variable{"?start"}, Variable{"?target"}};
+  auto sideTable = makeIdTableFromVector({{5}, {17}, {299}, {5}, {1000}});
+  auto computePath = [&](size_t numThreads, bool bound, size_t maxDist) {
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::transitivePathNumThreads_>(numThreads);
+    TransitivePathSide left(std::nullopt, 0, Variable{"?start"}, 0);
+    TransitivePathSide right(std::nullopt, 1, Variable{"?target"}, 1);
+    auto T = bound ? makePathBound(true, sub.clone(), vars, sideTable.clone(),
+                                   0, {Variable{"?start"}}, left, right, 1,
+                                   maxDist)
+                   : makePathUnbound(sub.clone(), vars, left, right, 1,
+                                     maxDist);
+    return sortedRows(T->computeResultOnlyForTesting(requestLaziness()));
+  };
+  for (bool bound : {false, true}) {
+    for (size_t maxDist : {size_t{3}, std::numeric_limits<size_t>::max()}) {
+      auto expected = computePath(1, bound, maxDist);
+      EXPECT_FALSE(expected.empty());
+      EXPECT_EQ(computePath(4, bound, maxDist), expected);
+    }
+  }
+}
+
 // _____________________________________________________________________________
 INSTANTIATE_TEST_SUITE_P(
     TransitivePathTestSuite, TransitivePathTest,
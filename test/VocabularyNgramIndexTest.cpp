@@ -0,0 +1,187 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "engine/ExportQueryExecutionTrees.h"
+#include "engine/QueryPlanner.h"
+#include "index/VocabularyNgramIndex.h"
+#include "parser/SparqlParser.h"
+#include "util/AllocatorTestHelpers.h"
+#include "util/IndexTestHelpers.h"
+
+using ::testing::ElementsAre;
+using ::testing::Optional;
+
+namespace {
+// Build a `VocabularyNgramIndex` for the `words` (the index of each word is
+// its position) and return the loaded index.
+VocabularyNgramIndex makeIndex(const std::vector<std::string>& words,
+                               const std::string& filename) {
+  VocabularyNgramIndex::Builder builder{
+      filename, ad_utility::MemorySize::megabytes(10),
+      ad_utility::testing::makeAllocator()};
+  for (size_t i = 0; i < words.size(); ++i) {
+    builder.addWord(words[i], i);
+  }
+  builder.finish();
+  VocabularyNgramIndex index;
+  index.readFromFile(filename);
+  return index;
+}
+
+// Return the `VocabIndex`es with the given values.
+std::vector<VocabIndex> indices(std::vector<uint64_t> values) {
+  std::vector<VocabIndex> result;
+  for (auto value : values) {
+    result.push_back(VocabIndex::make(value));
+  }
+  return result;
+}
+
+// Run the `query` on the index with the given `config` and return the result
+// as TSV.
+std::string runQuery(ad_utility::testing::TestIndexConfig config,
+                     const std::string& query) {
+  auto qec = ad_utility::testing::getQec(std::move(config));
+  qec->clearCacheUnpinnedOnly();
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  QueryPlanner qp{qec, cancellationHandle};
+  static EncodedIriManager encodedIriManager;
+  auto pq = SparqlParser::parseQuery(&encodedIriManager, query);
+  auto qet = qp.createExecutionTree(pq);
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  std::string result;
+  for (const auto& block : ExportQueryExecutionTrees::computeResult(
+           pq, qet, ad_utility::MediaType::tsv, timer,
+           std::move(cancellationHandle))) {
+    result += block;
+  }
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(VocabularyNgramIndex, getTrigrams) {
+  using T = VocabularyNgramIndex::Trigram;
+  auto trigram = [](std::string_view s) {
+    return static_cast<T>(static_cast<uint8_t>(s[0])) << 16 |
+           static_cast<T>(static_cast<uint8_t>(s[1])) << 8 |
+           static_cast<T>(static_cast<uint8_t>(s[2]));
+  };
+  EXPECT_TRUE(VocabularyNgramIndex::getTrigrams("ab").empty());
+  // ASCII letters are lowercased, duplicates are removed.
+  EXPECT_THAT(VocabularyNgramIndex::getTrigrams("AbAbA"),
+              ElementsAre(trigram("aba"), trigram("bab")));
+  // Other bytes are kept as they are.
+  EXPECT_THAT(VocabularyNgramIndex::getTrigrams("Ä1"),
+              ElementsAre(trigram("Ä1")));
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyNgramIndex, candidates) {
+  std::string filename = "VocabularyNgramIndexTest.candidates.trigrams";
+  auto index = makeIndex({"\"Berlin\"", "\"Bern\"@de", "<http://berlin.de>",
+                          "\"Hamburg\"", "\"Köln\""},
+                         filename);
+  EXPECT_TRUE(index.isLoaded());
+
+  // Substrings (case-insensitive), the words that only contain the trigrams
+  // but not the substring are also candidates.
+  EXPECT_THAT(index.getCandidatesForSubstring("Berl"),
+              Optional(indices({0, 2})));
+  EXPECT_THAT(index.getCandidatesForSubstring("ber"),
+              Optional(indices({0, 1, 2})));
+  EXPECT_THAT(index.getCandidatesForSubstring("burgx"), Optional(indices({})));
+  EXPECT_THAT(index.getCandidatesForSubstring("öln"), Optional(indices({4})));
+  EXPECT_EQ(index.getCandidatesForSubstring("be"), std::nullopt);
+
+  // Regexes.
+  EXPECT_THAT(index.getCandidatesForRegex("^Ber(lin|n)$"),
+              Optional(indices({0, 1, 2})));
+  EXPECT_THAT(index.getCandidatesForRegex("(?i)HAMB.*g"),
+              Optional(indices({3})));
+  EXPECT_THAT(index.getCandidatesForRegex("berlin|hamburg"),
+              Optional(indices({0, 2, 3})));
+  // Regexes that can match without a literal part of length 3.
+  EXPECT_EQ(index.getCandidatesForRegex("b|c"), std::nullopt);
+  EXPECT_EQ(index.getCandidatesForRegex(".*"), std::nullopt);
+  EXPECT_EQ(index.getCandidatesForRegex("berlin|h"), std::nullopt);
+  // In case-insensitive regexes, `s` and `k` may match non-ASCII characters.
+  EXPECT_EQ(index.getCandidatesForRegex("(?i)kks"), std::nullopt);
+  // Invalid regexes.
+  EXPECT_EQ(index.getCandidatesForRegex("(abc"), std::nullopt);
+
+  // Patterns that might have more than the given number of candidates are
+  // rejected (based on the shortest posting list of the trigrams).
+  EXPECT_EQ(index.getCandidatesForSubstring("ber", 2), std::nullopt);
+  EXPECT_THAT(index.getCandidatesForSubstring("ber", 3),
+              Optional(indices({0, 1, 2})));
+  EXPECT_EQ(index.getCandidatesForSubstring("Berl", 1), std::nullopt);
+  EXPECT_THAT(index.getCandidatesForSubstring("Berl", 2),
+              Optional(indices({0, 2})));
+  EXPECT_THAT(index.getCandidatesForSubstring("burgx", 0),
+              Optional(indices({})));
+  // For a regex, the bounds of the alternatives are added.
+  EXPECT_EQ(index.getCandidatesForRegex("berlin|hamburg", 2), std::nullopt);
+  EXPECT_THAT(index.getCandidatesForRegex("berlin|hamburg", 3),
+              Optional(indices({0, 2, 3})));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyNgramIndex, longPostingListsAreNotIntersected) {
+  std::string filename = "VocabularyNgramIndexTest.longLists.trigrams";
+  // The posting list of `xyz` is much longer than the lists of the other
+  // trigrams of `abcxyz`.
+  std::vector<std::string> words{"abcxy", "abcxyz"};
+  for (size_t i = 0; i < 100; ++i) {
+    words.push_back(absl::StrCat("xyz", i));
+  }
+  auto index = makeIndex(words, filename);
+  // The word `abcxy` is a candidate, as the posting list of `xyz` is not read.
+  EXPECT_THAT(index.getCandidatesForSubstring("abcxyz"),
+              Optional(indices({0, 1})));
+  EXPECT_THAT(index.getCandidatesForSubstring("xyz5"),
+              Optional(indices({7, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61})));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyNgramIndex, stringFiltersGiveSameResults) {
+  std::string kg =
+      "<a> <p> \"Berlin\" . <b> <p> \"Bern\"@de . <c> <p> <http://berlin.de> ."
+      "<d> <p> \"Hamburg\" . <e> <p> \"BERLINER\" . <f> <p> 42 . "
+      "<g> <p> \"Köln\" . <h> <p> _:blank";
+  ad_utility::testing::TestIndexConfig withoutIndex{kg};
+  auto withIndex = withoutIndex;
+  withIndex.buildVocabularyNgramIndex = true;
+  auto getNgramIndex = [](const auto& config) {
+    return ad_utility::testing::getQec(config)
+        ->getIndex()
+        .getVocabularyNgramIndex();
+  };
+  EXPECT_EQ(getNgramIndex(withoutIndex), nullptr);
+  EXPECT_NE(getNgramIndex(withIndex), nullptr);
+
+  for (std::string filter :
+       {"CONTAINS(?o, \"erl\")", "CONTAINS(STR(?o), \"erl\")",
+        "!CONTAINS(?o, \"erl\")", "CONTAINS(?o, \"Ber\")",
+        "STRSTARTS(?o, \"Ber\")", "STRSTARTS(?o, \"http\")",
+        "REGEX(?o, \"erl\")", "REGEX(?o, \"ERL\", \"i\")",
+        "REGEX(STR(?o), \"berlin\\\\.de\")", "!REGEX(?o, \"ern|urg\")",
+        "REGEX(?o, \"ö\")", "CONTAINS(?o, \"öln\")",
+        "CONTAINS(?o, \"42\")"}) {
+    std::string query =
+        absl::StrCat("SELECT ?s WHERE { ?s <p> ?o FILTER (", filter,
+                     ") } ORDER BY ?s");
+    EXPECT_EQ(runQuery(withIndex, query), runQuery(withoutIndex, query))
+        << query;
+  }
+  EXPECT_EQ(runQuery(withIndex, "SELECT ?s WHERE { ?s <p> ?o FILTER "
+                                "REGEX(?o, \"erl\", \"i\") } ORDER BY ?s"),
+            "?s\n<a>\n<e>\n");
+}
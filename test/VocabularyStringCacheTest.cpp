@@ -0,0 +1,102 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+
+#include "index/VocabularyStringCache.h"
+
+using namespace ad_utility::memory_literals;
+
+namespace {
+auto V = [](uint64_t index) { return VocabIndex::make(index); };
+
+// A lookup function that records the indices for which it was called.
+struct RecordingLookup {
+  std::vector<uint64_t> calls_;
+  std::function<std::string(VocabIndex)> function() {
+    return [this](VocabIndex index) {
+      calls_.push_back(index.get());
+      return absl::StrCat("word", index.get());
+    };
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(VocabularyStringCache, resolveSortsAndDeduplicates) {
+  VocabularyStringCache cache{1_MB};
+  RecordingLookup lookup;
+  auto batch = cache.resolve({V(7), V(3), V(7), V(5), V(3)}, lookup.function());
+  // Each distinct word is read once, in the order of the vocabulary.
+  EXPECT_THAT(lookup.calls_, ::testing::ElementsAre(3, 5, 7));
+  EXPECT_EQ(batch.size(), 3u);
+  ASSERT_NE(batch.find(V(5)), nullptr);
+  EXPECT_EQ(*batch.find(V(5)), "word5");
+  EXPECT_EQ(*batch.find(V(7)), "word7");
+  EXPECT_EQ(batch.find(V(4)), nullptr);
+  EXPECT_EQ(cache.numEntries(), 3u);
+
+  // Cached words are not read again.
+  lookup.calls_.clear();
+  batch = cache.resolve({V(9), V(5), V(1)}, lookup.function());
+  EXPECT_THAT(lookup.calls_, ::testing::ElementsAre(1, 9));
+  EXPECT_EQ(*batch.find(V(5)), "word5");
+  EXPECT_EQ(*batch.find(V(9)), "word9");
+  EXPECT_EQ(cache.numEntries(), 5u);
+
+  // An empty batch.
+  lookup.calls_.clear();
+  EXPECT_EQ(cache.resolve({}, lookup.function()).size(), 0u);
+  EXPECT_TRUE(lookup.calls_.empty());
+
+  cache.clear();
+  EXPECT_EQ(cache.numEntries(), 0u);
+  cache.resolve({V(5)}, lookup.function());
+  EXPECT_THAT(lookup.calls_, ::testing::ElementsAre(5));
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyStringCache, resolveWithoutCache) {
+  RecordingLookup lookup;
+  auto batch = VocabularyStringCache::resolveWithoutCache(
+      {V(7), V(3), V(7), V(5)}, lookup.function());
+  EXPECT_THAT(lookup.calls_, ::testing::ElementsAre(3, 5, 7));
+  EXPECT_EQ(batch.size(), 3u);
+  EXPECT_EQ(*batch.find(V(7)), "word7");
+  EXPECT_EQ(batch.find(V(4)), nullptr);
+}
+
+// _____________________________________________________________________________
+TEST(VocabularyStringCache, sizeLimit) {
+  // A cache that is too small for any word still resolves all the words of a
+  // batch, but doesn't store them.
+  VocabularyStringCache cache{0_B};
+  RecordingLookup lookup;
+  auto batch = cache.resolve({V(2), V(1)}, lookup.function());
+  EXPECT_EQ(*batch.find(V(1)), "word1");
+  EXPECT_EQ(*batch.find(V(2)), "word2");
+  EXPECT_EQ(cache.numEntries(), 0u);
+  cache.resolve({V(2)}, lookup.function());
+  EXPECT_THAT(lookup.calls_, ::testing::ElementsAre(1, 2, 2));
+
+  // A cache that can hold exactly three of the words evicts the least
+  // recently used words.
+  lookup.calls_.clear();
+  cache.setMaxSize(ad_utility::MemorySize::bytes(3 * (sizeof(std::string) +
+                                                      std::string{"word1"}
+                                                          .size())));
+  cache.resolve({V(1), V(2), V(3)}, lookup.function());
+  EXPECT_EQ(cache.numEntries(), 3u);
+  cache.resolve({V(1)}, lookup.function());
+  cache.resolve({V(4)}, lookup.function());
+  EXPECT_EQ(cache.numEntries(), 3u);
+  cache.resolve({V(1), V(2), V(3), V(4)}, lookup.function());
+  EXPECT_THAT(lookup.calls_, ::testing::ElementsAre(1, 2, 3, 4, 2));
+
+  // Shrinking the cache evicts words immediately.
+  cache.setMaxSize(1_B);
+  EXPECT_EQ(cache.numEntries(), 0u);
+}
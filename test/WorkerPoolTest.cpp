@@ -0,0 +1,67 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "util/WorkerPool.h"
+
+using ad_utility::WorkerPool;
+
+// _____________________________________________________________________________
+TEST(WorkerPool, allTasksAreRun) {
+  for (size_t numWorkers : {0, 1, 4}) {
+    WorkerPool pool{numWorkers};
+    EXPECT_EQ(pool.numWorkers(), numWorkers);
+    for (size_t numTasks : {0, 1, 3, 100}) {
+      std::vector<std::atomic<size_t>> numCalls(numTasks);
+      pool.runInParallel(numTasks, [&numCalls](size_t i) { ++numCalls.at(i); });
+      for (const auto& n : numCalls) {
+        EXPECT_EQ(n, 1);
+      }
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(WorkerPool, exceptionIsPropagated) {
+  WorkerPool pool{3};
+  std::atomic<size_t> numCalls = 0;
+  EXPECT_THROW(pool.runInParallel(10,
+                                  [&numCalls](size_t i) {
+                                    ++numCalls;
+                                    if (i == 5) {
+                                      throw std::runtime_error{"task 5"};
+                                    }
+                                  }),
+               std::runtime_error);
+  // The other tasks are still run.
+  EXPECT_EQ(numCalls, 10);
+}
+
+// _____________________________________________________________________________
+TEST(WorkerPool, nestedCallsDontDeadlock) {
+  // All the workers are busy with the outer tasks, which wait for their inner
+  // tasks.
+  WorkerPool pool{2};
+  std::atomic<size_t> numCalls = 0;
+  pool.runInParallel(8, [&pool, &numCalls](size_t) {
+    pool.runInParallel(8, [&numCalls](size_t) { ++numCalls; });
+  });
+  EXPECT_EQ(numCalls, 64);
+}
+
+// _____________________________________________________________________________
+TEST(WorkerPool, globalPool) {
+  auto& pool = WorkerPool::global();
+  EXPECT_EQ(&pool, &WorkerPool::global());
+  EXPECT_GE(pool.numWorkers(), 1);
+  std::atomic<size_t> sum = 0;
+  pool.runInParallel(10, [&sum](size_t i) { sum += i; });
+  EXPECT_EQ(sum, 45);
+}
@@ -7,8 +7,10 @@
 #include "../util/IdTableHelpers.h"
 #include "../util/IndexTestHelpers.h"
 #include "../util/OperationTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
 #include "./ValuesForTesting.h"
 #include "engine/Bind.h"
+#include "engine/MorselParallelism.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 
 using namespace sparqlExpression;
@@ -173,3 +175,48 @@ TEST(Bind, limitIsPropagated) {
 
   EXPECT_EQ(idTable, makeIdTableFromVector({{1, 42}}, &Id::makeFromInt));
 }
+
+// _____________________________________________________________________________
+TEST(Bind, parallelEvaluationPreservesOrder) {
+  auto* qec = ad_utility::testing::getQec();
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::expressionEvaluationNumThreads_>(3);
+  size_t numRows = 2 * qlever::morsels::MORSEL_SIZE + 1;
+  IdTable input{1, qec->getAllocator()};
+  IdTable expected{2, qec->getAllocator()};
+  for (size_t i = 0; i < numRows; ++i) {
+    auto id = Id::makeFromInt(static_cast<int64_t>(i));
+    input.push_back({id});
+    expected.push_back({id, id});
+  }
+  auto valuesTree = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(input), Vars{Variable{"?a"}}, false,
+      std::vector<ColumnIndex>{}, LocalVocab{}, std::nullopt, true);
+  Bind bind{qec,
+            std::move(valuesTree),
+            {SparqlExpressionPimpl{
+                 std::make_unique<VariableExpression>(Variable{"?a"}),
+                 "?a as ?b"},
+             Variable{"?b"}}};
+
+  {
+    qec->getQueryTreeCache().clearAll();
+    auto result = bind.getResult(false, ComputationMode::FULLY_MATERIALIZED);
+    ASSERT_TRUE(result->isFullyMaterialized());
+    EXPECT_EQ(result->idTable(), expected);
+  }
+
+  {
+    qec->getQueryTreeCache().clearAll();
+    auto result = bind.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+    ASSERT_FALSE(result->isFullyMaterialized());
+    IdTable aggregated{2, qec->getAllocator()};
+    size_t numBlocks = 0;
+    for (const auto& [idTable, localVocab] : result->idTables()) {
+      aggregated.insertAtEnd(idTable);
+      ++numBlocks;
+    }
+    EXPECT_EQ(numBlocks, 3);
+    EXPECT_EQ(aggregated, expected);
+  }
+}
@@ -0,0 +1,179 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/cleanup/cleanup.h>
+#include <gmock/gmock.h>
+
+#include <filesystem>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IdTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "engine/DiskResultCache.h"
+#include "index/DeltaTriples.h"
+
+namespace {
+using ad_utility::testing::IntId;
+using ad_utility::testing::VocabId;
+using namespace ad_utility::memory_literals;
+
+// Return a `CacheValue` with the `idTable` (sorted by the first column) and the
+// `localVocab`.
+std::shared_ptr<const CacheValue> makeValue(IdTable idTable,
+                                            LocalVocab localVocab) {
+  RuntimeInformation runtimeInfo;
+  runtimeInfo.descriptor_ = "some operation";
+  runtimeInfo.addDetail("some-detail", 42);
+  return std::make_shared<const CacheValue>(
+      Result{std::move(idTable), {0}, std::move(localVocab)},
+      std::move(runtimeInfo));
+}
+
+// Return the number of files of a cache in the `directory`.
+size_t numFiles(const std::filesystem::path& directory) {
+  return ql::ranges::count_if(
+      std::filesystem::directory_iterator(directory), [](const auto& entry) {
+        return entry.path().extension() == DiskResultCache::FILE_EXTENSION;
+      });
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, storeAndLoad) {
+  Index index = ad_utility::testing::makeTestIndex(
+      "DiskResultCache", "<a> <p> <b> . <b> <p> <c> .");
+  std::filesystem::path directory = "DiskResultCacheTest.dir";
+  std::filesystem::remove_all(directory);
+  absl::Cleanup cleanup{
+      [&directory]() { std::filesystem::remove_all(directory); }};
+  auto allocator = ad_utility::testing::makeAllocator();
+  auto snapshot = index.deltaTriplesManager().getCurrentSnapshot();
+  QueryCacheKey key{"key", snapshot->index_};
+
+  LocalVocab localVocab;
+  Id localId =
+      Id::makeFromLocalVocabIndex(localVocab.getIndexAndAddIfNotContained(
+          ad_utility::triple_component::LiteralOrIri::iriref("<local>")));
+  auto value = makeValue(
+      makeIdTableFromVector({{VocabId(1), IntId(3)}, {VocabId(2), localId}}),
+      std::move(localVocab));
+
+  // Check that the `cache` returns the `value` for the `key`.
+  auto expectLoaded = [&](DiskResultCache& cache) {
+    auto loaded = cache.load(key, *snapshot, allocator);
+    ASSERT_TRUE(loaded.has_value());
+    const auto& result = loaded->resultTable();
+    const auto& idTable = result.idTable();
+    ASSERT_EQ(idTable.numRows(), 2);
+    ASSERT_EQ(idTable.numColumns(), 2);
+    EXPECT_EQ(idTable(0, 0), VocabId(1));
+    EXPECT_EQ(idTable(0, 1), IntId(3));
+    EXPECT_EQ(idTable(1, 0), VocabId(2));
+    // The entry of the local vocab has a new ID, but the same content.
+    Id loadedLocalId = idTable(1, 1);
+    ASSERT_EQ(loadedLocalId.getDatatype(), Datatype::LocalVocabIndex);
+    EXPECT_EQ(loadedLocalId.getLocalVocabIndex()->toStringRepresentation(),
+              "<local>");
+    EXPECT_EQ(result.localVocab().size(), 1);
+    EXPECT_THAT(result.sortedBy(), ::testing::ElementsAre(0));
+    EXPECT_EQ(loaded->runtimeInfo().descriptor_, "some operation");
+    EXPECT_EQ(loaded->runtimeInfo().details_["some-detail"], 42);
+    EXPECT_EQ(loaded->runtimeInfo().numRows_, 2);
+  };
+
+  {
+    DiskResultCache cache{index, directory, 1_MB};
+    EXPECT_FALSE(cache.load(key, *snapshot, allocator).has_value());
+    cache.store(key, value);
+    cache.waitUntilWritten();
+    auto statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.numWrites_, 1);
+    EXPECT_EQ(statistics.numEntries_, 1);
+    EXPECT_GT(statistics.size_, 0_B);
+    expectLoaded(cache);
+    statistics = cache.getStatistics();
+    EXPECT_EQ(statistics.numHits_, 1);
+    EXPECT_EQ(statistics.numMisses_, 1);
+
+    // A result that is already on disk is not written again.
+    cache.store(key, value);
+    cache.waitUntilWritten();
+    EXPECT_EQ(cache.getStatistics().numWrites_, 1);
+  }
+
+  // The result is still there after a "restart".
+  {
+    DiskResultCache cache{index, directory, 1_MB};
+    EXPECT_EQ(cache.getStatistics().numEntries_, 1);
+    expectLoaded(cache);
+    EXPECT_FALSE(cache.load(QueryCacheKey{"otherKey", snapshot->index_},
+                            *snapshot, allocator)
+                     .has_value());
+
+    // Results for a snapshot that is not the current one are not written.
+    cache.store(QueryCacheKey{"otherKey", snapshot->index_ + 1}, value);
+    // Results with blank nodes that were created by a query are not written.
+    auto minIndex = index.getBlankNodeManager()->minIndex_;
+    auto blankNode =
+        Id::makeFromBlankNodeIndex(BlankNodeIndex::make(minIndex + 3));
+    cache.store(QueryCacheKey{"blankNode", snapshot->index_},
+                makeValue(makeIdTableFromVector({{blankNode}}), LocalVocab{}));
+    cache.waitUntilWritten();
+    EXPECT_EQ(cache.getStatistics().numWrites_, 0);
+    EXPECT_EQ(numFiles(directory), 1);
+
+    // The files are deleted when the size limit is exceeded.
+    cache.setMaxSize(1_B);
+    EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+    EXPECT_EQ(numFiles(directory), 0);
+    EXPECT_FALSE(cache.load(key, *snapshot, allocator).has_value());
+  }
+}
+
+// _____________________________________________________________________________
+TEST(DiskResultCache, deltaTriplesAndClear) {
+  Index index = ad_utility::testing::makeTestIndex(
+      "DiskResultCacheDeltaTriples", "<a> <p> <b> . <b> <p> <c> .");
+  std::filesystem::path directory = "DiskResultCacheDeltaTriplesTest.dir";
+  std::filesystem::remove_all(directory);
+  absl::Cleanup cleanup{
+      [&directory]() { std::filesystem::remove_all(directory); }};
+  auto allocator = ad_utility::testing::makeAllocator();
+  auto value = makeValue(makeIdTableFromVector({{3}, {4}}), LocalVocab{});
+
+  DiskResultCache cache{index, directory, 1_MB};
+  auto cleanSnapshot = index.deltaTriplesManager().getCurrentSnapshot();
+  EXPECT_FALSE(cleanSnapshot->hasDeltaTriples());
+  QueryCacheKey cleanKey{"key", cleanSnapshot->index_};
+  cache.store(cleanKey, value);
+  cache.waitUntilWritten();
+  EXPECT_EQ(cache.getStatistics().numWrites_, 1);
+
+  // Insert a triple, the new snapshot has delta triples.
+  index.deltaTriplesManager().modify<void>([](DeltaTriples& deltaTriples) {
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    deltaTriples.insertTriples(
+        std::move(handle),
+        {IdTriple<0>{{VocabId(0), VocabId(1), VocabId(2), VocabId(0)}}});
+  });
+  auto snapshot = index.deltaTriplesManager().getCurrentSnapshot();
+  EXPECT_TRUE(snapshot->hasDeltaTriples());
+  // Results are neither returned for nor written from such a snapshot.
+  EXPECT_FALSE(cache.load(cleanKey, *snapshot, allocator).has_value());
+  cache.store(QueryCacheKey{"otherKey", snapshot->index_}, value);
+  cache.waitUntilWritten();
+  EXPECT_EQ(cache.getStatistics().numWrites_, 1);
+
+  // After the delta triples are cleared, the result can be used again.
+  index.deltaTriplesManager().clear();
+  snapshot = index.deltaTriplesManager().getCurrentSnapshot();
+  EXPECT_FALSE(snapshot->hasDeltaTriples());
+  EXPECT_TRUE(cache.load(cleanKey, *snapshot, allocator).has_value());
+
+  cache.clear();
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+  EXPECT_EQ(numFiles(directory), 0);
+  EXPECT_FALSE(cache.load(cleanKey, *snapshot, allocator).has_value());
+}
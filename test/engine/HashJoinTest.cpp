@@ -0,0 +1,239 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "./ValuesForTesting.h"
+#include "engine/HashJoin.h"
+#include "engine/Join.h"
+#include "engine/NamedResultCache.h"
+#include "engine/QueryExecutionTree.h"
+
+using namespace ad_utility::testing;
+
+namespace {
+// Create a `ValuesForTesting` with the variables `?x` (the join column) and
+// `?<name>` from the given rows.
+std::shared_ptr<QueryExecutionTree> makeInput(QueryExecutionContext* qec,
+                                              const VectorTable& rows,
+                                              std::string name) {
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector(rows),
+      std::vector<std::optional<Variable>>{Variable{"?x"},
+                                           Variable{"?" + name}});
+}
+
+// Same as above, but the result is yielded lazily in the given blocks.
+std::shared_ptr<QueryExecutionTree> makeLazyInput(
+    QueryExecutionContext* qec, const std::vector<VectorTable>& blocks,
+    std::string name) {
+  std::vector<IdTable> tables;
+  for (const auto& block : blocks) {
+    tables.push_back(makeIdTableFromVector(block));
+  }
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(tables),
+      std::vector<std::optional<Variable>>{Variable{"?x"},
+                                           Variable{"?" + name}},
+      true);
+}
+
+// Collect all blocks of a lazy result into a single `IdTable`.
+IdTable aggregateLazyResult(Result& result, size_t numColumns) {
+  IdTable aggregate{numColumns, makeAllocator()};
+  for (auto& [idTable, localVocab] : result.idTables()) {
+    EXPECT_FALSE(idTable.empty());
+    aggregate.insertAtEnd(idTable);
+  }
+  return aggregate;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(HashJoin, materializedInputs) {
+  auto* qec = getQec();
+  VectorTable left{{3, 30}, {1, 10}, {2, 20}, {3, 31}, {5, 50}};
+  VectorTable right{{3, 300}, {4, 400}, {1, 100}, {3, 301}};
+  // The rows of the probe side keep their order, and for each of them, the
+  // matching rows of the build side appear in their original order.
+  {
+    HashJoin join{qec, makeInput(qec, left, "l"), makeInput(qec, right, "r"),
+                  0, 0, true};
+    EXPECT_TRUE(join.leftIsBuildSide());
+    auto result = join.computeResultOnlyForTesting(false);
+    EXPECT_THAT(result.idTable(),
+                matchesIdTableFromVector({{3, 30, 300},
+                                          {3, 31, 300},
+                                          {1, 10, 100},
+                                          {3, 30, 301},
+                                          {3, 31, 301}}));
+  }
+  {
+    HashJoin join{qec, makeInput(qec, left, "l"), makeInput(qec, right, "r"),
+                  0, 0, false};
+    EXPECT_FALSE(join.leftIsBuildSide());
+    auto result = join.computeResultOnlyForTesting(false);
+    EXPECT_THAT(result.idTable(),
+                matchesIdTableFromVector({{3, 30, 300},
+                                          {3, 30, 301},
+                                          {1, 10, 100},
+                                          {3, 31, 300},
+                                          {3, 31, 301}}));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, joinColumnNotFirst) {
+  auto* qec = getQec();
+  auto left = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{10, 1}, {20, 2}}),
+      std::vector<std::optional<Variable>>{Variable{"?a"}, Variable{"?x"}});
+  auto right = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector({{7, 2, 70}, {8, 1, 80}, {9, 3, 90}}),
+      std::vector<std::optional<Variable>>{Variable{"?b"}, Variable{"?x"},
+                                           Variable{"?c"}});
+  HashJoin join{qec, left, right, 1, 1, true};
+  auto result = join.computeResultOnlyForTesting(false);
+  EXPECT_THAT(result.idTable(),
+              matchesIdTableFromVector({{20, 2, 7, 70}, {10, 1, 8, 80}}));
+  const auto& varToCol = join.getExternallyVisibleVariableColumns();
+  EXPECT_EQ(varToCol.at(Variable{"?a"}).columnIndex_, 0);
+  EXPECT_EQ(varToCol.at(Variable{"?x"}).columnIndex_, 1);
+  EXPECT_EQ(varToCol.at(Variable{"?b"}).columnIndex_, 2);
+  EXPECT_EQ(varToCol.at(Variable{"?c"}).columnIndex_, 3);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, lazyProbeSide) {
+  auto* qec = getQec();
+  auto build = makeInput(qec, {{1, 10}, {2, 20}, {2, 21}}, "l");
+  std::vector<VectorTable> blocks{
+      {{2, 200}, {3, 300}}, {{4, 400}}, {{1, 100}, {2, 201}}};
+  VectorTable expected{
+      {2, 20, 200}, {2, 21, 200}, {1, 10, 100}, {2, 20, 201}, {2, 21, 201}};
+  {
+    HashJoin join{qec, build, makeLazyInput(qec, blocks, "r"), 0, 0, true};
+    auto result = join.computeResultOnlyForTesting(true);
+    ASSERT_FALSE(result.isFullyMaterialized());
+    EXPECT_THAT(aggregateLazyResult(result, 3),
+                matchesIdTableFromVector(expected));
+  }
+  {
+    HashJoin join{qec, build, makeLazyInput(qec, blocks, "r"), 0, 0, true};
+    auto result = join.computeResultOnlyForTesting(false);
+    ASSERT_TRUE(result.isFullyMaterialized());
+    EXPECT_THAT(result.idTable(), matchesIdTableFromVector(expected));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, emptyBuildSide) {
+  auto* qec = getQec();
+  auto build = ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, IdTable{2, makeAllocator()},
+      std::vector<std::optional<Variable>>{Variable{"?x"}, Variable{"?l"}});
+  HashJoin join{qec, build, makeLazyInput(qec, {{{1, 100}}}, "r"), 0, 0, true};
+  auto result = join.computeResultOnlyForTesting(true);
+  ASSERT_TRUE(result.isFullyMaterialized());
+  EXPECT_TRUE(result.idTable().empty());
+  EXPECT_EQ(result.idTable().numColumns(), 3);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, hashTableRespectsMemoryLimit) {
+  auto* qec = getQec();
+  NamedResultCache namedResultCache;
+  QueryExecutionContext limitedQec{
+      qec->getIndex(), &qec->getQueryTreeCache(),
+      makeAllocator(ad_utility::MemorySize::kilobytes(10)),
+      SortPerformanceEstimator{}, &namedResultCache};
+  // The build side has 1000 distinct values, none of which occurs on the
+  // probe side, so only the hash table exceeds the memory limit.
+  VectorTable build;
+  for (int64_t i = 0; i < 1000; ++i) {
+    build.push_back({i, i});
+  }
+  HashJoin join{&limitedQec, makeInput(&limitedQec, build, "l"),
+                makeInput(&limitedQec, {{2000, 100}}, "r"), 0, 0, true};
+  EXPECT_THROW(join.computeResultOnlyForTesting(false),
+               ad_utility::detail::AllocationExceedsLimitException);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, buildSideIsSmallerInput) {
+  auto* qec = getQec();
+  auto small = makeInput(qec, {{1, 10}}, "l");
+  auto large = makeInput(qec, {{1, 100}, {2, 200}, {3, 300}}, "r");
+  EXPECT_TRUE((HashJoin{qec, small, large, 0, 0}.leftIsBuildSide()));
+  EXPECT_FALSE((HashJoin{qec, large, small, 0, 0}.leftIsBuildSide()));
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, undefinedJoinColumnIsNotSupported) {
+  auto* qec = getQec();
+  auto withUndef = makeInput(qec, {{Id::makeUndefined(), 10}}, "l");
+  auto defined = makeInput(qec, {{1, 100}}, "r");
+  AD_EXPECT_THROW_WITH_MESSAGE(HashJoin(qec, withUndef, defined, 0, 0),
+                               ::testing::_);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, cacheKeyAndDescriptor) {
+  auto* qec = getQec();
+  auto left = makeInput(qec, {{1, 10}}, "l");
+  auto right = makeInput(qec, {{1, 100}}, "r");
+  HashJoin leftBuild{qec, left, right, 0, 0, true};
+  HashJoin rightBuild{qec, left, right, 0, 0, false};
+  EXPECT_NE(leftBuild.getCacheKey(), rightBuild.getCacheKey());
+  EXPECT_EQ(leftBuild.getDescriptor(), "HashJoin on ?x");
+  EXPECT_TRUE(leftBuild.resultSortedOn().empty());
+  EXPECT_EQ(leftBuild.getResultWidth(), 3);
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, clone) {
+  auto* qec = getQec();
+  HashJoin join{qec, makeInput(qec, {{1, 10}}, "l"),
+                makeInput(qec, {{1, 100}}, "r"), 0, 0, false};
+  auto clone = join.clone();
+  ASSERT_TRUE(clone);
+  EXPECT_THAT(join, IsDeepCopy(*clone));
+  EXPECT_EQ(clone->getDescriptor(), join.getDescriptor());
+}
+
+// _____________________________________________________________________________
+TEST(HashJoin, costEstimateComparedToSortAndMergeJoin) {
+  auto* qec = getQec();
+  auto makeTrees = [qec](size_t leftSize, size_t rightSize) {
+    auto left = makeInput(qec, {{1, 10}}, "l");
+    auto right = makeInput(qec, {{1, 100}}, "r");
+    for (auto [tree, size] : {std::pair{left, leftSize}, {right, rightSize}}) {
+      auto& values =
+          dynamic_cast<ValuesForTesting&>(*tree->getRootOperation());
+      values.sizeEstimate() = size;
+      values.costEstimate() = size;
+    }
+    return std::pair{left, right};
+  };
+  auto hashJoinIsCheaper = [&](size_t leftSize, size_t rightSize) {
+    // The `Join` adds the required `Sort` operations itself.
+    auto [left, right] = makeTrees(leftSize, rightSize);
+    return HashJoin{qec, left, right, 0, 0}.getCostEstimate() <
+           Join{qec, left, right, 0, 0}.getCostEstimate();
+  };
+  // For small inputs the sorting is cheap.
+  EXPECT_FALSE(hashJoinIsCheaper(5, 5));
+  EXPECT_FALSE(hashJoinIsCheaper(10, 1'000));
+  // For medium-sized inputs the hash join wins.
+  EXPECT_TRUE(hashJoinIsCheaper(100'000, 100'000));
+  // For two very large inputs the hash map doesn't fit into the cache.
+  EXPECT_FALSE(hashJoinIsCheaper(10'000'000, 10'000'000));
+  // If one input is much smaller, sorting the larger one dominates.
+  EXPECT_TRUE(hashJoinIsCheaper(1'000, 10'000'000));
+  EXPECT_TRUE(hashJoinIsCheaper(10'000'000, 100'000));
+}
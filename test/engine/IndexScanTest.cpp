@@ -736,12 +736,22 @@ TEST(IndexScan, verifyThatPrefilteredIndexScanResultIsNotCacheable) {
   EXPECT_TRUE(updatedQet.has_value());
   EXPECT_FALSE(updatedQet.value()->getRootOperation()->canResultBeCached());
 
-  // Assert that we don't set a <PrefilterExpression, ColumnIndex> pair for the
-  // second Variable.
+  // The variable ?z is not the first sorted variable column, but the
+  // `PrefilterExpression` (> 22, ?z) can still be applied on the column
+  // summaries of the blocks.
   prefilterPairs = makePrefilterVec(pr(lt(IntId(10)), V{"?a"}),
                                     pr(gt(DoubleId(22)), V{"?z"}),
                                     pr(gt(IntId(10)), V{"?b"}));
   EXPECT_TRUE(qet->getRootOperation()->canResultBeCached());
+  updatedQet =
+      qet->setPrefilterGetUpdatedQueryExecutionTree(std::move(prefilterPairs));
+  EXPECT_TRUE(updatedQet.has_value());
+  EXPECT_FALSE(updatedQet.value()->getRootOperation()->canResultBeCached());
+
+  // Assert that we don't set a <PrefilterExpression, ColumnIndex> pair for
+  // variables that don't appear in the scan.
+  prefilterPairs = makePrefilterVec(pr(lt(IntId(10)), V{"?a"}),
+                                    pr(gt(IntId(10)), V{"?b"}));
   updatedQet =
       qet->setPrefilterGetUpdatedQueryExecutionTree(std::move(prefilterPairs));
   // No `PrefilterExpression` should be applied for this `IndexScan`, we don't
@@ -814,17 +824,9 @@ TEST(IndexScan, checkEvaluationWithPrefiltering) {
       pr(andExpr(gt(DoubleId(12.00)), le(IntId(174))), Variable{"?y"}), {},
       false);
 
-  // For the following tests, the first sorted column given the permutation
-  // doesn't match with the corresponding column for the Variable of the
-  // <PrefilterExpression, Variable> pair. We expect that the provided prefilter
-  // is not applicable (and can't be set).
-  testSetAndMakeScanWithPrefilterExpr(
-      kg, triple, Permutation::PSO,
-      pr(andExpr(gt(DoubleId(12.00)), le(IntId(174))), Variable{"?price"}), {},
-      false);
-  testSetAndMakeScanWithPrefilterExpr(
-      kg, triple, Permutation::POS,
-      pr(andExpr(gt(VocabId(0)), lt(VocabId(100))), Variable{"?x"}), {}, false);
+  // Prefilters on variables that are not the first sorted column are only
+  // applied on the column summaries of the blocks, see the test
+  // `prefilterOnColumnSummaries` below.
 
   // This knowledge graph yields an incomplete first and last block.
   std::string kgFirstAndLastIncomplete =
@@ -845,6 +847,66 @@ TEST(IndexScan, checkEvaluationWithPrefiltering) {
       {I(10), I(12), I(18), I(22), I(25), I(147), I(189), I(194)}, true);
 }
 
+// _____________________________________________________________________________
+TEST(IndexScan, prefilterOnColumnSummaries) {
+  using namespace makeFilterExpression;
+  using namespace filterHelper;
+  auto I = ad_utility::testing::IntId;
+  std::string kg =
+      "<P1> <price_tag> 10 . <P2> <price_tag> 12 . <P3> <price_tag> "
+      "18 . <P4> <price_tag> 22 . <P5> <price_tag> 25 . <P6> "
+      "<price_tag> 147 . <P7> <price_tag> 174 . <P8> <price_tag> 174 "
+      ". <P9> <price_tag> 189 . <P10> <price_tag> 194 .";
+  SparqlTripleSimple triple{Tc{Variable{"?x"}}, iri("<price_tag>"),
+                            Tc{Variable{"?price"}}};
+  Variable price{"?price"};
+
+  // Return the sorted values of the `?price` column of the `qet`.
+  auto getPrices = [&price](const QueryExecutionTree& qet) {
+    const auto& idTable =
+        qet.getRootOperation()->computeResultOnlyForTesting().idTable();
+    auto column = idTable.getColumn(qet.getVariableColumn(price));
+    std::vector<Id> result{column.begin(), column.end()};
+    ql::ranges::sort(result);
+    return result;
+  };
+
+  // For the `PSO` permutation, the `?price` column is not sorted, so the
+  // prefilter can only be applied on the column summaries of the blocks. The
+  // blocks of the result have to contain all the matching values, but may
+  // contain other values as well. With the small blocks of the test index,
+  // some of the blocks are skipped.
+  auto qet = ad_utility::makeExecutionTree<IndexScan>(
+      getQec(kg), Permutation::PSO, triple);
+  auto allPrices = getPrices(*qet);
+  ASSERT_EQ(allPrices.size(), 10);
+  auto updatedQet = qet->setPrefilterGetUpdatedQueryExecutionTree(
+      makePrefilterVec(pr(gt(IntId(180)), price)));
+  ASSERT_TRUE(updatedQet.has_value());
+  auto prices = getPrices(*updatedQet.value());
+  EXPECT_LT(prices.size(), allPrices.size());
+  EXPECT_TRUE(ql::ranges::includes(allPrices, prices));
+  EXPECT_TRUE(ql::ranges::includes(prices, std::vector{I(189), I(194)}));
+
+  // A prefilter that doesn't match any value removes all the blocks.
+  updatedQet = qet->setPrefilterGetUpdatedQueryExecutionTree(
+      makePrefilterVec(pr(lt(IntId(5)), price)));
+  ASSERT_TRUE(updatedQet.has_value());
+  EXPECT_TRUE(getPrices(*updatedQet.value()).empty());
+
+  // A prefilter that matches all the values keeps all the blocks.
+  updatedQet = qet->setPrefilterGetUpdatedQueryExecutionTree(
+      makePrefilterVec(pr(andExpr(ge(IntId(10)), le(IntId(194))), price)));
+  ASSERT_TRUE(updatedQet.has_value());
+  EXPECT_EQ(getPrices(*updatedQet.value()), allPrices);
+
+  // Values of a different datatype never match the numeric values.
+  updatedQet = qet->setPrefilterGetUpdatedQueryExecutionTree(
+      makePrefilterVec(pr(gt(VocabId(0)), price)));
+  ASSERT_TRUE(updatedQet.has_value());
+  EXPECT_TRUE(getPrices(*updatedQet.value()).empty());
+}
+
 class IndexScanWithLazyJoin : public ::testing::TestWithParam<bool> {
  protected:
   QueryExecutionContext* qec_ = nullptr;
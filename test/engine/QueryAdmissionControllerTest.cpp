@@ -0,0 +1,124 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "engine/QueryAdmissionController.h"
+#include "global/Id.h"
+#include "util/GTestHelpers.h"
+
+using namespace ad_utility::memory_literals;
+using Lane = QueryAdmissionController::Lane;
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, admitWithinBudget) {
+  QueryAdmissionController controller{100_B};
+  auto e1 = controller.enqueue(Lane::Interactive, 60_B, 10);
+  auto t1 = controller.tryAdmit(e1);
+  ASSERT_TRUE(t1.has_value());
+  EXPECT_EQ(t1->reservedMemory(), 60_B);
+
+  // The second query has to wait until the first one is done.
+  auto e2 = controller.enqueue(Lane::Interactive, 60_B, 10);
+  EXPECT_FALSE(controller.tryAdmit(e2).has_value());
+  auto stats = controller.getStatistics();
+  EXPECT_EQ(stats.reservedMemory_, 60_B);
+  EXPECT_EQ(stats.numRunning_, 1);
+  EXPECT_EQ(stats.numInteractiveWaiting_, 1);
+  EXPECT_EQ(stats.numBatchWaiting_, 0);
+
+  t1.reset();
+  auto t2 = controller.tryAdmit(e2);
+  ASSERT_TRUE(t2.has_value());
+  EXPECT_EQ(controller.getStatistics().numInteractiveWaiting_, 0);
+
+  // An estimate that is larger than the budget is capped, s.t. the query can
+  // run as soon as no other query is running.
+  auto e3 = controller.enqueue(Lane::Batch, 1_GB, 10);
+  EXPECT_FALSE(controller.tryAdmit(e3).has_value());
+  t2.reset();
+  auto t3 = controller.tryAdmit(e3);
+  ASSERT_TRUE(t3.has_value());
+  EXPECT_EQ(t3->reservedMemory(), 100_B);
+
+  // Moving a ticket transfers the reservation.
+  QueryAdmissionController::Ticket moved = std::move(t3.value());
+  t3.reset();
+  EXPECT_EQ(controller.getStatistics().numRunning_, 1);
+  moved = QueryAdmissionController::Ticket{};
+  stats = controller.getStatistics();
+  EXPECT_EQ(stats.numRunning_, 0);
+  EXPECT_EQ(stats.reservedMemory_, 0_B);
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, priorityAndOrder) {
+  QueryAdmissionController controller{100_B};
+  auto e0 = controller.enqueue(Lane::Batch, 100_B, 10);
+  auto t0 = controller.tryAdmit(e0);
+  ASSERT_TRUE(t0.has_value());
+
+  auto batch = controller.enqueue(Lane::Batch, 10_B, 10);
+  auto interactive1 = controller.enqueue(Lane::Interactive, 10_B, 10);
+  auto interactive2 = controller.enqueue(Lane::Interactive, 10_B, 10);
+  t0.reset();
+
+  // Interactive queries are admitted first, in the order of their arrival.
+  EXPECT_FALSE(controller.tryAdmit(batch).has_value());
+  EXPECT_FALSE(controller.tryAdmit(interactive2).has_value());
+  auto t1 = controller.tryAdmit(interactive1);
+  EXPECT_TRUE(t1.has_value());
+  EXPECT_FALSE(controller.tryAdmit(batch).has_value());
+  auto t2 = controller.tryAdmit(interactive2);
+  EXPECT_TRUE(t2.has_value());
+  auto t3 = controller.tryAdmit(batch);
+  EXPECT_TRUE(t3.has_value());
+  EXPECT_EQ(controller.getStatistics().reservedMemory_, 30_B);
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, queueLimitAndAbandonedEntries) {
+  QueryAdmissionController controller{100_B};
+  auto e0 = controller.enqueue(Lane::Interactive, 100_B, 2);
+  auto t0 = controller.tryAdmit(e0);
+  auto e1 = controller.enqueue(Lane::Interactive, 10_B, 2);
+  {
+    auto e2 = controller.enqueue(Lane::Batch, 10_B, 2);
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        controller.enqueue(Lane::Interactive, 10_B, 2),
+        ::testing::HasSubstr("2 queries are already waiting"));
+    EXPECT_EQ(controller.getStatistics().numBatchWaiting_, 1);
+  }
+  // The destroyed entry (e.g. after a timeout) has left the queue.
+  auto stats = controller.getStatistics();
+  EXPECT_EQ(stats.numInteractiveWaiting_, 1);
+  EXPECT_EQ(stats.numBatchWaiting_, 0);
+
+  // The same holds for the first entry in the queue, s.t. the following
+  // entries can be admitted.
+  auto e3 = controller.enqueue(Lane::Interactive, 10_B, 2);
+  t0.reset();
+  { [[maybe_unused]] auto abandoned = std::move(e1); }
+  EXPECT_TRUE(controller.tryAdmit(e3).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, laneFromStringAndEstimate) {
+  EXPECT_EQ(QueryAdmissionController::laneFromString("interactive"),
+            Lane::Interactive);
+  EXPECT_EQ(QueryAdmissionController::laneFromString("batch"), Lane::Batch);
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      QueryAdmissionController::laneFromString("urgent"),
+      ::testing::HasSubstr("\"urgent\""));
+
+  EXPECT_EQ(QueryAdmissionController::estimateMemory(10, 3),
+            ad_utility::MemorySize::bytes(10 * 3 * sizeof(Id)));
+  // A result without columns still needs some memory per row.
+  EXPECT_EQ(QueryAdmissionController::estimateMemory(10, 0),
+            ad_utility::MemorySize::bytes(10 * sizeof(Id)));
+  EXPECT_EQ(QueryAdmissionController::estimateMemory(
+                std::numeric_limits<size_t>::max(), 2),
+            ad_utility::MemorySize::max());
+}
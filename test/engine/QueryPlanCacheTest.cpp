@@ -0,0 +1,223 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/NamedResultCache.h"
+#include "engine/QueryPlanCache.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+// Parse the `query` with the optional `datasets`.
+ParsedQuery parse(std::string query,
+                  const std::vector<DatasetClause>& datasets = {}) {
+  static EncodedIriManager encodedIriManager;
+  return SparqlParser::parseQuery(&encodedIriManager, std::move(query),
+                                  datasets);
+}
+
+// Plan the `query` with the `qec`.
+QueryExecutionTree plan(ParsedQuery& query, QueryExecutionContext& qec) {
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  return QueryPlanner{&qec, std::move(handle)}.createExecutionTree(query);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, normalizeQueryString) {
+  auto normalize = &QueryPlanCache::normalizeQueryString;
+  EXPECT_EQ(normalize("  SELECT *\n\t{ ?s  ?p ?o }  "),
+            "SELECT * { ?s ?p ?o }");
+  // Comments are removed, but not inside of IRIs and literals.
+  EXPECT_EQ(normalize("SELECT * # comment\n{ ?s <a#b> \"x  # y\" }"),
+            "SELECT * { ?s <a#b> \"x  # y\" }");
+  // Whitespace inside of literals is kept, also for long literals and with
+  // escaped quotes.
+  EXPECT_EQ(normalize("{ ?s ?p '''a  ''  b'''  . ?s ?p \"a\\\"  b\" }"),
+            "{ ?s ?p '''a  ''  b''' . ?s ?p \"a\\\"  b\" }");
+  // A `<` that does not start an IRI is the less-than operator.
+  EXPECT_EQ(normalize("FILTER(?x  <  3 && ?y >  2)"),
+            "FILTER(?x < 3 && ?y > 2)");
+  EXPECT_EQ(normalize("FILTER(?x <3 && <a  b>)"), "FILTER(?x <3 && <a b>)");
+  EXPECT_EQ(normalize(""), "");
+  EXPECT_EQ(normalize(" # only a comment"), "");
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, makeKey) {
+  auto key = [](std::string query,
+                const std::vector<DatasetClause>& datasets = {}) {
+    return QueryPlanCache::makeKey(parse(std::move(query), datasets));
+  };
+  EXPECT_EQ(key("SELECT * { ?s ?p ?o }"), key("SELECT *\n{ ?s ?p ?o }  "));
+  EXPECT_NE(key("SELECT * { ?s ?p ?o }"), key("SELECT * { ?s ?p ?x }"));
+  // The datasets of the request are part of the key.
+  std::vector<DatasetClause> datasets{
+      {TripleComponent::Iri::fromIriref("<g>"), false}};
+  EXPECT_NE(key("SELECT * { ?s ?p ?o }"),
+            key("SELECT * { ?s ?p ?o }", datasets));
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, getAndInsert) {
+  Index index = ad_utility::testing::makeTestIndex(
+      "QueryPlanCache", "<a> <p> <b> . <b> <p> <c> . <a> <q> <c> .");
+  QueryResultCache resultCache;
+  NamedResultCache namedResultCache;
+  auto makeQec = [&]() {
+    return std::make_unique<QueryExecutionContext>(
+        index, &resultCache,
+        ad_utility::testing::makeAllocator(
+            ad_utility::MemorySize::megabytes(100)),
+        SortPerformanceEstimator{}, &namedResultCache);
+  };
+  auto qec = makeQec();
+
+  QueryPlanCache cache{10};
+  std::string queryString = "SELECT ?x ?y { ?x <p> ?y . ?y <p> ?z }";
+  auto query = parse(queryString);
+  auto key = QueryPlanCache::makeKey(query);
+  EXPECT_FALSE(cache.get(key, *qec).has_value());
+  auto tree = plan(query, *qec);
+  cache.insert(key, query, tree, *qec);
+  EXPECT_EQ(cache.getStatistics().numEntries_, 1);
+
+  // The cached plan is returned for the same query with a different context,
+  // and it uses that context.
+  auto qec2 = makeQec();
+  auto cached = cache.get(QueryPlanCache::makeKey(parse(queryString)), *qec2);
+  ASSERT_TRUE(cached.has_value());
+  auto& cachedTree = cached->queryExecutionTree_;
+  EXPECT_EQ(cachedTree.getCacheKey(), tree.getCacheKey());
+  EXPECT_EQ(cachedTree.getRootOperation()->getExecutionContext(), qec2.get());
+  cachedTree.forAllDescendants([&qec2](const QueryExecutionTree* child) {
+    EXPECT_EQ(child->getQec(), qec2.get());
+    EXPECT_EQ(child->getRootOperation()->getExecutionContext(), qec2.get());
+  });
+  EXPECT_NE(cachedTree.getRootOperation()->getRuntimeInfoPointer(),
+            tree.getRootOperation()->getRuntimeInfoPointer());
+  EXPECT_EQ(cached->parsedQuery_._originalString, queryString);
+  EXPECT_EQ(cachedTree.getResult()->idTable().size(), 1);
+
+  auto statistics = cache.getStatistics();
+  EXPECT_EQ(statistics.numHits_, 1);
+  EXPECT_EQ(statistics.numMisses_, 1);
+
+  // After an update, the plan belongs to an outdated snapshot and is not
+  // returned anymore, until it is replaced by a plan for the new snapshot.
+  index.deltaTriplesManager().clear();
+  auto qec3 = makeQec();
+  EXPECT_FALSE(cache.get(key, *qec3).has_value());
+  auto query3 = parse(queryString);
+  cache.insert(key, query3, plan(query3, *qec3), *qec3);
+  EXPECT_EQ(cache.getStatistics().numEntries_, 1);
+  EXPECT_TRUE(cache.get(key, *qec3).has_value());
+  EXPECT_FALSE(cache.get(key, *qec2).has_value());
+
+  // Updates are never cached.
+  cache.clear();
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+  ad_utility::BlankNodeManager blankNodeManager;
+  static EncodedIriManager encodedIriManager;
+  auto update = SparqlParser::parseUpdate(&blankNodeManager, &encodedIriManager,
+                                          "INSERT DATA { <a> <p> <c> }")
+                    .at(0);
+  cache.insert("update", update, plan(update, *qec3), *qec3);
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+
+  // A cache without entries stores nothing.
+  cache.setMaxNumEntries(0);
+  auto query4 = parse(queryString);
+  cache.insert(key, query4, plan(query4, *qec3), *qec3);
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+  EXPECT_FALSE(cache.get(key, *qec3).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, storedPlansOutliveTheirContext) {
+  Index index = ad_utility::testing::makeTestIndex(
+      "QueryPlanCacheContext", "<a> <p> <b> . <b> <p> <c> . <a> <q> <c> .");
+  QueryResultCache resultCache;
+  NamedResultCache namedResultCache;
+  auto makeQec = [&]() {
+    return std::make_unique<QueryExecutionContext>(
+        index, &resultCache,
+        ad_utility::testing::makeAllocator(
+            ad_utility::MemorySize::megabytes(100)),
+        SortPerformanceEstimator{}, &namedResultCache);
+  };
+  QueryPlanCache cache{10};
+  std::string queryString = "SELECT ?x ?y { ?x <p> ?y . ?y <p> ?z }";
+  auto key = QueryPlanCache::makeKey(parse(queryString));
+  {
+    // The context of the request that planned the query (and the plan of that
+    // request) are destroyed before the plan is used by the next requests.
+    auto qec = makeQec();
+    auto query = parse(queryString);
+    cache.insert(key, query, plan(query, *qec), *qec);
+  }
+  for (size_t i = 0; i < 2; ++i) {
+    auto qec = makeQec();
+    auto cached = cache.get(key, *qec);
+    ASSERT_TRUE(cached.has_value());
+    auto& cachedTree = cached->queryExecutionTree_;
+    EXPECT_EQ(cachedTree.getRootOperation()->getExecutionContext(), qec.get());
+    EXPECT_EQ(cachedTree.getResult()->idTable().size(), 1);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, storedPlansDontKeepResultsAlive) {
+  Index index = ad_utility::testing::makeTestIndex(
+      "QueryPlanCacheResults", "<a> <p> <b> . <b> <p> <c> . <a> <q> <c> .");
+  QueryResultCache resultCache;
+  NamedResultCache namedResultCache;
+  QueryExecutionContext qec{index, &resultCache,
+                            ad_utility::testing::makeAllocator(
+                                ad_utility::MemorySize::megabytes(100)),
+                            SortPerformanceEstimator{}, &namedResultCache};
+  // Return the result of the `tree` from the `resultCache`.
+  auto getCachedResult = [&](const QueryExecutionTree& tree) {
+    auto result = resultCache.getIfContained(
+        {tree.getCacheKey(), qec.locatedTriplesSnapshot().index_});
+    EXPECT_TRUE(result.has_value());
+    return std::weak_ptr{result.value()._resultPointer->resultTablePtr()};
+  };
+
+  QueryPlanCache cache{10};
+  std::string queryString = "SELECT ?x ?y { ?x <p> ?y . ?y <p> ?z }";
+  auto query = parse(queryString);
+  auto key = QueryPlanCache::makeKey(query);
+  auto tree = plan(query, qec);
+  tree.getResult();
+  cache.insert(key, query, tree, qec);
+  auto result = getCachedResult(tree);
+  resultCache.clearAll();
+  EXPECT_TRUE(result.expired());
+
+  // A plan that is returned for a request pins the results that are cached at
+  // that time, just like a plan from the `QueryPlanner`.
+  tree.getResult();
+  {
+    auto cached = cache.get(key, qec);
+    ASSERT_TRUE(cached.has_value());
+    result = getCachedResult(tree);
+    resultCache.clearAll();
+    EXPECT_FALSE(result.expired());
+  }
+  EXPECT_TRUE(result.expired());
+
+  // With `zero-cost-estimate-for-cached-subtree`, the plan depends on the
+  // cached results, so it is not cached.
+  cache.clear();
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::zeroCostEstimateForCachedSubtree_>(true);
+  EXPECT_FALSE(QueryPlanCache::isCacheable(query, tree));
+  cache.insert(key, query, tree, qec);
+  EXPECT_EQ(cache.getStatistics().numEntries_, 0);
+}
@@ -865,6 +865,18 @@ TEST(SpatialJoin, getCacheKeyImpl) {
               std::string::npos);
   ASSERT_TRUE(cacheKeyString.find(leftCacheKeyString) != std::string::npos);
   ASSERT_TRUE(cacheKeyString.find(rightCacheKeyString) != std::string::npos);
+
+  // Distances that only differ after the sixth significant digit must have
+  // different cache keys.
+  auto makeCacheKey = [&](double maxDist) {
+    return ad_utility::makeExecutionTree<SpatialJoin>(
+               qec,
+               SpatialJoinConfiguration{MaxDistanceConfig{maxDist}, subj, obj},
+               leftChild, rightChild)
+        ->getCacheKey();
+  };
+  EXPECT_EQ(makeCacheKey(1000), makeCacheKey(1000));
+  EXPECT_NE(makeCacheKey(1000), makeCacheKey(1000.0000001));
 }
 
 // _____________________________________________________________________________
@@ -0,0 +1,216 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "./SpatialJoinTestHelpers.h"
+#include "engine/SpatialIndexScan.h"
+#include "engine/SpatialJoinAlgorithms.h"
+#include "index/SpatialIndex.h"
+
+namespace {
+
+using namespace SpatialJoinTestHelpers;
+
+// Like `SpatialJoinTestHelpers::buildQec` with the `GeoVocabulary`, but
+// optionally with a prebuilt `SpatialIndex`.
+QueryExecutionContext* buildQecWithSpatialIndex(std::string turtleKg,
+                                                bool buildSpatialIndex) {
+  using enum ad_utility::VocabularyType::Enum;
+  ad_utility::testing::TestIndexConfig config{std::move(turtleKg)};
+  config.vocabularyType = ad_utility::VocabularyType{OnDiskCompressedGeoSplit};
+  config.blocksizePermutations = 16_MB;
+  config.parserBufferSize = 10_kB;
+  config.buildSpatialIndex = buildSpatialIndex;
+  return ad_utility::testing::getQec(std::move(config));
+}
+
+// Compute the S2 spatial join of all geometries with each other for the given
+// maximum distance and return the pairs of the subjects of the joined
+// geometries, sorted.
+std::vector<std::pair<std::string, std::string>> s2Join(
+    QueryExecutionContext* qec, double maxDist) {
+  auto leftChild = buildIndexScan(qec, {"?geo1", "<asWKT>", "?obj1"});
+  auto rightChild = buildIndexScan(qec, {"?geo2", "<asWKT>", "?obj2"});
+  auto spatialJoinOperation = ad_utility::makeExecutionTree<SpatialJoin>(
+      qec,
+      SpatialJoinConfiguration{MaxDistanceConfig(maxDist), Variable{"?obj1"},
+                               Variable{"?obj2"}},
+      leftChild, rightChild);
+  auto op = spatialJoinOperation->getRootOperation();
+  auto* spatialJoin = static_cast<SpatialJoin*>(op.get());
+  spatialJoin->selectAlgorithm(SpatialJoinAlgorithm::S2_GEOMETRY);
+  auto result = spatialJoin->computeResultOnlyForTesting();
+  auto columns = spatialJoin->computeVariableToColumnMap();
+  auto toString = [&](Id id) {
+    return ExportQueryExecutionTrees::idToStringAndType(
+               qec->getIndex(), id, result.localVocab())
+        .value()
+        .first;
+  };
+  std::vector<std::pair<std::string, std::string>> pairs;
+  for (const auto& row : result.idTable()) {
+    pairs.emplace_back(
+        toString(row[columns.at(Variable{"?geo1"}).columnIndex_]),
+        toString(row[columns.at(Variable{"?geo2"}).columnIndex_]));
+  }
+  ql::ranges::sort(pairs);
+  return pairs;
+}
+
+// Compute the bounding box spatial join of all geometries with each other for
+// the given maximum distance and return the rows of the result, sorted.
+std::vector<std::vector<uint64_t>> boundingBoxJoin(QueryExecutionContext* qec,
+                                                   double maxDist) {
+  auto leftChild = buildIndexScan(qec, {"?geo1", "<asWKT>", "?obj1"});
+  auto rightChild = buildIndexScan(qec, {"?geo2", "<asWKT>", "?obj2"});
+  auto spatialJoinOperation = ad_utility::makeExecutionTree<SpatialJoin>(
+      qec,
+      SpatialJoinConfiguration{MaxDistanceConfig(maxDist), Variable{"?obj1"},
+                               Variable{"?obj2"}},
+      leftChild, rightChild);
+  auto op = spatialJoinOperation->getRootOperation();
+  auto* spatialJoin = static_cast<SpatialJoin*>(op.get());
+  spatialJoin->selectAlgorithm(SpatialJoinAlgorithm::BOUNDING_BOX);
+  auto result = spatialJoin->computeResultOnlyForTesting();
+  // The tables contain all the geometries, so the prebuilt index is used.
+  const auto& details = spatialJoin->runtimeInfo().details_;
+  if (qec->getIndex().getSpatialIndex() != nullptr) {
+    EXPECT_EQ(details.at("spatial-index"), "prebuilt");
+  } else {
+    EXPECT_FALSE(details.contains("spatial-index"));
+  }
+  std::vector<std::vector<uint64_t>> rows;
+  for (const auto& row : result.idTable()) {
+    auto& bits = rows.emplace_back();
+    for (Id id : row) {
+      bits.push_back(id.getBits());
+    }
+  }
+  ql::ranges::sort(rows);
+  return rows;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SpatialJoinWithSpatialIndex, spatialIndexIsBuilt) {
+  auto kg = createSmallDataset(true);
+  EXPECT_EQ(buildQecWithSpatialIndex(kg, false)->getIndex().getSpatialIndex(),
+            nullptr);
+  const auto* spatialIndex =
+      buildQecWithSpatialIndex(kg, true)->getIndex().getSpatialIndex();
+  ASSERT_NE(spatialIndex, nullptr);
+  EXPECT_EQ(spatialIndex->numGeometries(), 5);
+}
+
+// _____________________________________________________________________________
+TEST(SpatialJoinWithSpatialIndex, boundingBoxJoinGivesSameResults) {
+  for (const auto& kg : {createSmallDataset(true), createMixedDataset(),
+                         createTrueDistanceDataset()}) {
+    auto withIndex = buildQecWithSpatialIndex(kg, true);
+    auto withoutIndex = buildQecWithSpatialIndex(kg, false);
+    ASSERT_NE(withIndex->getIndex().getSpatialIndex(), nullptr);
+    for (double maxDist : {0.0, 1.0, 5000.0, 500000.0, 1e7}) {
+      auto expected = boundingBoxJoin(withoutIndex, maxDist);
+      EXPECT_EQ(boundingBoxJoin(withIndex, maxDist), expected) << maxDist;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(SpatialJoinWithSpatialIndex, s2JoinGivesSameResults) {
+  for (const auto& kg : {createSmallDataset(true), createMixedDataset(),
+                         createTrueDistanceDataset()}) {
+    auto withIndex = buildQecWithSpatialIndex(kg, true);
+    auto withoutIndex = buildQecWithSpatialIndex(kg, false);
+    for (double maxDist : {0.0, 1.0, 5000.0, 500000.0, 1e7}) {
+      auto expected = s2Join(withoutIndex, maxDist);
+      EXPECT_EQ(s2Join(withIndex, maxDist), expected) << maxDist;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+TEST(SpatialJoinWithSpatialIndex, s2JoinUsesExactDistanceOfAreas) {
+  // A long and thin area and a point inside of it, which is more than 50 km
+  // away from the centroid of the area.
+  std::string kg = absl::StrCat(
+      "<area> <asWKT> ", makeAreaLiteral("0 0,1 0,1 0.01,0 0.01,0 0"),
+      " .\n<point> <asWKT>", makePointLiteral("0.001", "0.005"), " .\n");
+  using P = std::pair<std::string, std::string>;
+  for (bool buildSpatialIndex : {false, true}) {
+    auto qec = buildQecWithSpatialIndex(kg, buildSpatialIndex);
+    EXPECT_THAT(s2Join(qec, 1000),
+                ::testing::ElementsAre(P{"<area>", "<area>"},
+                                       P{"<area>", "<point>"},
+                                       P{"<point>", "<area>"},
+                                       P{"<point>", "<point>"}));
+  }
+  // Without areas, only the points are joined.
+  std::string pointsOnly = absl::StrCat(
+      "<point> <asWKT>", makePointLiteral("0.001", "0.005"), " .\n",
+      "<far> <asWKT>", makePointLiteral("0.5", "0.005"), " .\n");
+  EXPECT_THAT(s2Join(buildQecWithSpatialIndex(pointsOnly, false), 1000),
+              ::testing::ElementsAre(P{"<far>", "<far>"},
+                                     P{"<point>", "<point>"}));
+}
+
+// _____________________________________________________________________________
+TEST(SpatialJoinWithSpatialIndex, usePrebuiltSpatialIndex) {
+  using SJA = SpatialJoinAlgorithms;
+  // The table contains all the geometries of the index.
+  EXPECT_TRUE(SJA::usePrebuiltSpatialIndex(1'000, 1'000, 1'000, 100.0));
+  EXPECT_TRUE(SJA::usePrebuiltSpatialIndex(1'000'000, 1'000'000, 10, 100.0));
+  // A small part of a large index, but with only few query boxes.
+  EXPECT_TRUE(SJA::usePrebuiltSpatialIndex(10'000'000, 1'000, 1, 100.0));
+  // A small part of a large index with many query boxes.
+  EXPECT_FALSE(SJA::usePrebuiltSpatialIndex(10'000'000, 1'000, 1'000, 100.0));
+  EXPECT_FALSE(SJA::usePrebuiltSpatialIndex(5, 0, 0, 100.0));
+}
+
+// _____________________________________________________________________________
+TEST(SpatialIndexScan, computeResult) {
+  auto qec = buildQecWithSpatialIndex(createSmallDataset(true), true);
+  SpatialIndexScan scan{qec, Variable{"?geometry"}, {7.7, 47.9, 8.0, 48.1}};
+  EXPECT_EQ(scan.getDescriptor(), "SpatialIndexScan on ?geometry");
+  EXPECT_THAT(scan.resultSortedOn(), ::testing::ElementsAre(0));
+  EXPECT_EQ(scan.getSizeEstimateBeforeLimit(), 1);
+  EXPECT_FALSE(scan.knownEmptyResult());
+
+  // The areas of the university and the minster in Freiburg.
+  auto result = scan.computeResultOnlyForTesting();
+  const auto& idTable = result.idTable();
+  ASSERT_EQ(idTable.numRows(), 2);
+  EXPECT_LT(idTable(0, 0), idTable(1, 0));
+  const auto& index = qec->getIndex();
+  EXPECT_EQ(index.indexToString(idTable(0, 0).getVocabIndex()),
+            areaUniFreiburg);
+  EXPECT_EQ(index.indexToString(idTable(1, 0).getVocabIndex()), areaMuenster);
+
+  SpatialIndexScan emptyScan{qec, Variable{"?geometry"}, {100, 0, 101, 1}};
+  EXPECT_EQ(emptyScan.computeResultOnlyForTesting().idTable().numRows(), 0);
+
+  // Without a spatial index, the operation can't be computed.
+  SpatialIndexScan scanWithoutIndex{
+      buildQecWithSpatialIndex(createSmallDataset(true), false),
+      Variable{"?geometry"},
+      {7.7, 47.9, 8.0, 48.1}};
+  EXPECT_FALSE(scanWithoutIndex.knownEmptyResult());
+  EXPECT_ANY_THROW(scanWithoutIndex.computeResultOnlyForTesting());
+}
+
+// _____________________________________________________________________________
+TEST(SpatialIndexScan, cacheKeyIsExact) {
+  auto qec = buildQecWithSpatialIndex(createSmallDataset(true), true);
+  SpatialIndexScan scan{qec, Variable{"?geometry"}, {7.7, 47.9, 8.0, 48.1}};
+  EXPECT_EQ(scan.getCacheKey(),
+            SpatialIndexScan(qec, Variable{"?geometry"}, {7.7, 47.9, 8.0, 48.1})
+                .getCacheKey());
+  // Boxes around two points that only differ after the sixth significant
+  // digit of a coordinate must have different cache keys.
+  SpatialIndexScan nearbyScan{
+      qec, Variable{"?geometry"}, {7.7, 47.9000001, 8.0, 48.1}};
+  EXPECT_NE(scan.getCacheKey(), nearbyScan.getCacheKey());
+}
@@ -5,6 +5,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+
 #include "../../util/AllocatorTestHelpers.h"
 #include "../../util/GTestHelpers.h"
 #include "../../util/IdTableHelpers.h"
@@ -305,3 +307,60 @@ TEST(CompressedExternalIdTable, WrongNumberOfColsWhenPushing) {
   EXPECT_NO_THROW(t1.setNumColumns(4));
   EXPECT_ANY_THROW(erased.pushBlock(t1));
 }
+
+// _____________________________________________________________________________
+TEST(CompressedExternalIdTable, persistAndReopen) {
+  std::string filename = "idTableCompressedSorter.persistAndReopen.dat";
+  std::string metadataFilename =
+      absl::StrCat(filename, ad_utility::CompressedExternalIdTableWriter::
+                                 METADATA_SUFFIX);
+  auto alloc = ad_utility::testing::makeAllocator();
+  ad_utility::EXTERNAL_ID_TABLE_SORTER_IGNORE_MEMORY_LIMIT_FOR_TESTING = true;
+  using Sorter = ad_utility::CompressedExternalIdTableSorter<SortByOSP, 3>;
+
+  // Test several blocks, a single block that would otherwise stay in memory,
+  // and an empty input.
+  for (size_t numRows : {10'000, 20, 0}) {
+    CopyableIdTable<3> randomTable =
+        createRandomlyFilledIdTable(numRows, 3).toStatic<3>();
+    {
+      Sorter sorter{filename, 10_kB, alloc, 1_kB};
+      for (const auto& row : randomTable) {
+        sorter.push(row);
+      }
+      sorter.persist();
+    }
+    // The files are kept after the destruction of the sorter.
+    ASSERT_TRUE(std::filesystem::exists(filename));
+    ASSERT_TRUE(std::filesystem::exists(metadataFilename));
+
+    ql::ranges::sort(randomTable, SortByOSP{});
+    Sorter sorter{ad_utility::ReopenPersistedTag{}, filename, 10_kB, alloc,
+                  1_kB};
+    EXPECT_EQ(sorter.size(), numRows);
+    auto result = idTableFromRowGenerator<3>(sorter.sortedView(), 3);
+    EXPECT_THAT(result, ::testing::ElementsAreArray(randomTable));
+
+    // `clear` deletes the persisted files.
+    sorter.clear();
+    EXPECT_FALSE(std::filesystem::exists(metadataFilename));
+  }
+  EXPECT_FALSE(std::filesystem::exists(filename));
+
+  // The same for a `CompressedExternalIdTable`, which keeps the order.
+  CopyableIdTable<3> randomTable =
+      createRandomlyFilledIdTable(1000, 3).toStatic<3>();
+  {
+    ad_utility::CompressedExternalIdTable<3> table{filename, 1_kB, alloc,
+                                                   100_B};
+    for (const auto& row : randomTable) {
+      table.push(row);
+    }
+    table.persist();
+  }
+  ad_utility::CompressedExternalIdTable<3> table{
+      ad_utility::ReopenPersistedTag{}, filename, 1_kB, alloc, 100_B};
+  auto result = idTableFromRowGenerator<3>(table.getRows(), 3);
+  EXPECT_THAT(result, ::testing::ElementsAreArray(randomTable));
+  table.clear();
+}
@@ -0,0 +1,188 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "../util/GTestHelpers.h"
+#include "index/IndexBuildCheckpoint.h"
+#include "util/File.h"
+
+using Stage = IndexBuildCheckpoint::Stage;
+
+namespace {
+const std::string basename = "IndexBuildCheckpointTest";
+
+// Write a file with the given `content`.
+void writeFile(const std::string& filename, std::string_view content) {
+  auto f = ad_utility::makeOfstream(filename);
+  f << content;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(IndexBuildCheckpoint, markAndResume) {
+  std::string file1 = basename + ".file1";
+  std::string file2 = basename + ".file2";
+  writeFile(file1, "abc");
+  writeFile(file2, "defgh");
+  nlohmann::json settings{{"input", "input.ttl"}};
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, false};
+    EXPECT_TRUE(checkpoint.isEmpty());
+    EXPECT_TRUE(std::filesystem::exists(checkpoint.filename()));
+    checkpoint.markFinished(Stage::InternalPermutations, {file1}, {{"id", 42}});
+    checkpoint.markFinished(Stage::FirstPermutationPair, {file1, file2});
+    checkpoint.markFinished(Stage::Patterns, {});
+    EXPECT_TRUE(checkpoint.isFinished(Stage::InternalPermutations));
+    EXPECT_FALSE(checkpoint.isFinished(Stage::SecondPermutationPair));
+    EXPECT_EQ(checkpoint.getData(Stage::InternalPermutations),
+              (nlohmann::json{{"id", 42}}));
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        checkpoint.getData(Stage::ThirdPermutationPair),
+        ::testing::HasSubstr("third-permutation-pair"));
+  }
+
+  // Resume with the same settings, the stages are still finished.
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, true};
+    EXPECT_TRUE(checkpoint.isFinished(Stage::InternalPermutations));
+    EXPECT_TRUE(checkpoint.isFinished(Stage::FirstPermutationPair));
+    EXPECT_TRUE(checkpoint.isFinished(Stage::Patterns));
+    EXPECT_EQ(checkpoint.getData(Stage::InternalPermutations),
+              (nlohmann::json{{"id", 42}}));
+  }
+
+  // A stage whose output file has changed is not finished anymore.
+  writeFile(file2, "de");
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, true};
+    EXPECT_TRUE(checkpoint.isFinished(Stage::InternalPermutations));
+    EXPECT_FALSE(checkpoint.isFinished(Stage::FirstPermutationPair));
+  }
+  // The invalid stage was also removed from the file.
+  ad_utility::deleteFile(file1);
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, true};
+    EXPECT_FALSE(checkpoint.isFinished(Stage::InternalPermutations));
+    EXPECT_FALSE(checkpoint.isFinished(Stage::FirstPermutationPair));
+    EXPECT_TRUE(checkpoint.isFinished(Stage::Patterns));
+  }
+
+  ad_utility::deleteFile(file2);
+  IndexBuildCheckpoint{basename, settings, false}.remove();
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildCheckpoint, differentSettingsAndNoResume) {
+  nlohmann::json settings{{"input", "input.ttl"}};
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, false};
+    checkpoint.markFinished(Stage::SecondPermutationPair, {});
+  }
+  // Without `resume`, the previous checkpoint is ignored and overwritten.
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, false};
+    EXPECT_TRUE(checkpoint.isEmpty());
+    checkpoint.markFinished(Stage::SecondPermutationPair, {});
+  }
+  // A checkpoint with different settings is ignored.
+  {
+    IndexBuildCheckpoint checkpoint{
+        basename, nlohmann::json{{"input", "other.ttl"}}, true};
+    EXPECT_TRUE(checkpoint.isEmpty());
+  }
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, true};
+    EXPECT_TRUE(checkpoint.isEmpty());
+    checkpoint.markFinished(Stage::SecondPermutationPair, {});
+    checkpoint.clear();
+    EXPECT_TRUE(checkpoint.isEmpty());
+  }
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, true};
+    EXPECT_TRUE(checkpoint.isEmpty());
+    checkpoint.remove();
+    EXPECT_FALSE(std::filesystem::exists(checkpoint.filename()));
+  }
+  // Resuming without a checkpoint starts from the beginning.
+  IndexBuildCheckpoint checkpoint{basename, settings, true};
+  EXPECT_TRUE(checkpoint.isEmpty());
+  checkpoint.remove();
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildCheckpoint, version) {
+  nlohmann::json settings{{"input", "input.ttl"}};
+  std::string filename;
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, false};
+    checkpoint.markFinished(Stage::SecondPermutationPair, {});
+    filename = checkpoint.filename();
+  }
+  auto json = ad_utility::fileToJson<nlohmann::json>(filename);
+  EXPECT_EQ(json.at("version"), IndexBuildCheckpoint::VERSION);
+
+  // Write the checkpoint with the given `json` and check whether the finished
+  // stage is used when resuming.
+  auto isUsedWhenResuming = [&](const nlohmann::json& json) {
+    writeFile(filename, json.dump());
+    IndexBuildCheckpoint checkpoint{basename, settings, true};
+    return checkpoint.isFinished(Stage::SecondPermutationPair);
+  };
+  EXPECT_TRUE(isUsedWhenResuming(json));
+
+  // Checkpoints with an older (or any other) version or without a version are
+  // ignored.
+  json["version"] = IndexBuildCheckpoint::VERSION - 1;
+  EXPECT_FALSE(isUsedWhenResuming(json));
+  json["version"] = IndexBuildCheckpoint::VERSION + 1;
+  EXPECT_FALSE(isUsedWhenResuming(json));
+  json.erase("version");
+  EXPECT_FALSE(isUsedWhenResuming(json));
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildCheckpoint, forget) {
+  nlohmann::json settings{{"input", "input.ttl"}};
+  {
+    IndexBuildCheckpoint checkpoint{basename, settings, false};
+    checkpoint.markFinished(Stage::VocabularyMerge, {}, {{"numFiles", 3}});
+    checkpoint.markFinished(Stage::IdConversion, {});
+    checkpoint.forget(Stage::VocabularyMerge);
+    EXPECT_FALSE(checkpoint.isFinished(Stage::VocabularyMerge));
+    EXPECT_TRUE(checkpoint.isFinished(Stage::IdConversion));
+    // Forgetting a stage that is not finished has no effect.
+    checkpoint.forget(Stage::TextIndex);
+    EXPECT_TRUE(checkpoint.isFinished(Stage::IdConversion));
+  }
+  // The forgotten stage was also removed from the file.
+  IndexBuildCheckpoint checkpoint{basename, settings, true};
+  EXPECT_FALSE(checkpoint.isFinished(Stage::VocabularyMerge));
+  EXPECT_TRUE(checkpoint.isFinished(Stage::IdConversion));
+  checkpoint.remove();
+}
+
+// _____________________________________________________________________________
+TEST(IndexBuildCheckpoint, toString) {
+  EXPECT_EQ(IndexBuildCheckpoint::toString(Stage::InternalPermutations),
+            "internal-permutations");
+  EXPECT_EQ(IndexBuildCheckpoint::toString(Stage::ThirdPermutationPair),
+            "third-permutation-pair");
+  EXPECT_EQ(IndexBuildCheckpoint::toString(Stage::FirstPermutationPair),
+            "first-permutation-pair");
+  EXPECT_EQ(
+      IndexBuildCheckpoint::toString(Stage::ParsingAndPartialVocabularies),
+      "parsing-and-partial-vocabularies");
+  EXPECT_EQ(IndexBuildCheckpoint::toString(Stage::VocabularyMerge),
+            "vocabulary-merge");
+  EXPECT_EQ(IndexBuildCheckpoint::toString(Stage::IdConversion),
+            "id-conversion");
+  EXPECT_EQ(IndexBuildCheckpoint::toString(Stage::TextIndex), "text-index");
+}
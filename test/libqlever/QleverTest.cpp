@@ -6,7 +6,11 @@
 
 #include <gmock/gmock.h>
 
+#include <filesystem>
+#include <fstream>
+
 #include "../util/GTestHelpers.h"
+#include "index/IndexBuildCheckpoint.h"
 #include "libqlever/Qlever.h"
 
 using namespace qlever;
@@ -37,6 +41,9 @@ TEST(LibQlever, buildIndexAndRunQuery) {
 
   c.parserBufferSize_ = std::nullopt;
   EXPECT_NO_THROW(Qlever::buildIndex(c));
+  // The checkpoint is removed after a complete index build.
+  EXPECT_FALSE(std::filesystem::exists(
+      "testIndexForLibQlever.index-build-checkpoint.json"));
   {
     EngineConfig ec{c};
     Qlever engine{ec};
@@ -118,6 +125,16 @@ TEST(LibQlever, fulltextIndex) {
   c.docsfile_ = docsFileName;
   c.baseName_ = "testIndexForLibQlever";
   EXPECT_NO_THROW(Qlever::buildIndex(c));
+  // The checkpoint of the index build is removed after the text index is
+  // built.
+  auto checkpointFilename =
+      absl::StrCat(c.baseName_, IndexBuildCheckpoint::FILE_SUFFIX);
+  EXPECT_FALSE(std::filesystem::exists(checkpointFilename));
+  // A resumed build without a checkpoint builds everything again.
+  c.resume_ = true;
+  EXPECT_NO_THROW(Qlever::buildIndex(c));
+  EXPECT_FALSE(std::filesystem::exists(checkpointFilename));
+  c.resume_ = false;
   {
     EngineConfig ec{c};
     ec.loadTextIndex_ = true;
@@ -181,4 +198,40 @@ TEST(IndexBuilderConfig, validate) {
   c.wordsfile_ = "";
   AD_EXPECT_THROW_WITH_MESSAGE(c.validate(),
                                HasSubstr("Only specified docsfile"));
+
+  c = IndexBuilderConfig{};
+  c.baseName_ = "newIndex";
+  c.existingIndexBaseName_ = "existingIndex";
+  AD_EXPECT_THROW_WITH_MESSAGE(c.validate(),
+                               HasSubstr("only possible without patterns"));
+  c.noPatterns_ = true;
+  EXPECT_NO_THROW(c.validate());
+  c.existingIndexBaseName_ = "newIndex";
+  AD_EXPECT_THROW_WITH_MESSAGE(c.validate(),
+                               HasSubstr("must have a different basename"));
+  c.existingIndexBaseName_ = "existingIndex";
+  c.onlyAddTextIndex_ = true;
+  AD_EXPECT_THROW_WITH_MESSAGE(c.validate(),
+                               HasSubstr("only adding a text index"));
+
+  // The text index of the existing index has to be built again.
+  c = IndexBuilderConfig{};
+  c.baseName_ = "newIndex";
+  c.noPatterns_ = true;
+  c.existingIndexBaseName_ = "existingIndexWithText";
+  std::filesystem::remove("existingIndexWithText.text.index");
+  EXPECT_NO_THROW(c.validate());
+  { std::ofstream{"existingIndexWithText.text.index"}; }
+  AD_EXPECT_THROW_WITH_MESSAGE(c.validate(),
+                               HasSubstr("is not carried over"));
+  c.addWordsFromLiterals_ = true;
+  EXPECT_NO_THROW(c.validate());
+  std::filesystem::remove("existingIndexWithText.text.index");
+
+  c = IndexBuilderConfig{};
+  c.resume_ = true;
+  EXPECT_NO_THROW(c.validate());
+  c.onlyAddTextIndex_ = true;
+  AD_EXPECT_THROW_WITH_MESSAGE(c.validate(),
+                               HasSubstr("can only be resumed"));
 }
@@ -0,0 +1,218 @@
+// Copyright 2026 The QLever Authors.
+//
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_TEST_UTIL_ARROWIPCTESTHELPERS_H
+#define QLEVER_TEST_UTIL_ARROWIPCTESTHELPERS_H
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/Exception.h"
+
+// A minimal reader for the Arrow IPC streaming format (as written by
+// `util/ArrowIpc.h`) to inspect the written messages in unit tests.
+namespace ad_utility::testing::arrow {
+
+// Read a value of type `T` at the given `position` of the `buffer`.
+template <typename T>
+T load(std::string_view buffer, size_t position) {
+  AD_CONTRACT_CHECK(position + sizeof(T) <= buffer.size());
+  T result;
+  std::memcpy(&result, buffer.data() + position, sizeof(T));
+  return result;
+}
+
+// A table inside a FlatBuffer. The fields are addressed by their slot (the
+// index of the field in the `.fbs` schema).
+struct FlatTable {
+  std::string_view buffer_;
+  size_t position_;
+
+  // Return the position of the field with the given `slot`, or `nullopt` if
+  // the field is absent.
+  std::optional<size_t> field(size_t slot) const {
+    size_t vtable = position_ - load<int32_t>(buffer_, position_);
+    auto vtableSize = load<uint16_t>(buffer_, vtable);
+    if ((slot + 2) * sizeof(uint16_t) >= vtableSize) {
+      return std::nullopt;
+    }
+    auto offset = load<uint16_t>(buffer_, vtable + (slot + 2) * 2);
+    if (offset == 0) {
+      return std::nullopt;
+    }
+    return position_ + offset;
+  }
+  bool has(size_t slot) const { return field(slot).has_value(); }
+
+  // Return the scalar with the given `slot` (or `T{}` if it is absent).
+  template <typename T>
+  T scalar(size_t slot) const {
+    auto position = field(slot);
+    return position.has_value() ? load<T>(buffer_, position.value()) : T{};
+  }
+
+  // Follow the offset in the field with the given `slot`.
+  size_t dereference(size_t slot) const {
+    size_t position = field(slot).value();
+    return position + load<uint32_t>(buffer_, position);
+  }
+  FlatTable table(size_t slot) const { return {buffer_, dereference(slot)}; }
+  std::string_view string(size_t slot) const {
+    size_t position = dereference(slot);
+    return buffer_.substr(position + 4, load<uint32_t>(buffer_, position));
+  }
+  std::vector<FlatTable> tables(size_t slot) const {
+    size_t position = dereference(slot);
+    std::vector<FlatTable> result;
+    for (size_t i = 0; i < load<uint32_t>(buffer_, position); ++i) {
+      size_t element = position + 4 * (i + 1);
+      result.push_back({buffer_, element + load<uint32_t>(buffer_, element)});
+    }
+    return result;
+  }
+  // Read a vector of structs that consist of two 64-bit integers (like the
+  // `FieldNode` and `Buffer` structs of the Arrow format).
+  std::vector<std::array<int64_t, 2>> structs(size_t slot) const {
+    size_t position = dereference(slot);
+    // The structs have to be 8-byte aligned.
+    EXPECT_EQ((position + 4) % 8, 0u);
+    std::vector<std::array<int64_t, 2>> result;
+    for (size_t i = 0; i < load<uint32_t>(buffer_, position); ++i) {
+      size_t element = position + 4 + 16 * i;
+      result.push_back({load<int64_t>(buffer_, element),
+                        load<int64_t>(buffer_, element + 8)});
+    }
+    return result;
+  }
+};
+
+// A single message of a stream: the `Message` table and the body.
+struct Message {
+  FlatTable message_;
+  std::string_view body_;
+
+  uint8_t headerType() const { return message_.scalar<uint8_t>(1); }
+  FlatTable header() const { return message_.table(2); }
+  // Return the bytes of the `i`-th buffer of a record batch.
+  std::string_view buffer(const FlatTable& recordBatch, size_t i) const {
+    auto [offset, length] = recordBatch.structs(2).at(i);
+    EXPECT_EQ(offset % 8, 0);
+    return body_.substr(offset, length);
+  }
+};
+
+// Split the `stream` into its messages and check the framing (including the
+// end-of-stream marker).
+inline std::vector<Message> parseStream(std::string_view stream) {
+  std::vector<Message> result;
+  size_t position = 0;
+  while (position + 8 <= stream.size()) {
+    EXPECT_EQ(load<uint32_t>(stream, position), 0xFFFFFFFF);
+    auto metadataSize =
+        static_cast<size_t>(load<int32_t>(stream, position + 4));
+    if (metadataSize == 0) {
+      EXPECT_EQ(position + 8, stream.size());
+      return result;
+    }
+    EXPECT_EQ(metadataSize % 8, 0u);
+    auto metadata = stream.substr(position + 8, metadataSize);
+    FlatTable message{metadata, load<uint32_t>(metadata, 0)};
+    // Metadata version V5.
+    EXPECT_EQ(message.scalar<int16_t>(0), 4);
+    auto bodyLength = static_cast<size_t>(message.scalar<int64_t>(3));
+    EXPECT_EQ(bodyLength % 8, 0u);
+    result.push_back(
+        {message, stream.substr(position + 8 + metadataSize, bodyLength)});
+    position += 8 + metadataSize + bodyLength;
+  }
+  ADD_FAILURE() << "The stream has no end-of-stream marker";
+  return result;
+}
+
+// Return the `i`-th value of type `T` from the given `buffer`.
+template <typename T>
+T value(std::string_view buffer, size_t i) {
+  return load<T>(buffer, i * sizeof(T));
+}
+
+// Return the `i`-th bit of the given (validity or boolean) `buffer`.
+inline bool bit(std::string_view buffer, size_t i) {
+  return (static_cast<uint8_t>(buffer.at(i / 8)) >> (i % 8)) & 1;
+}
+
+// The values of a stream, decoded with the help of its schema: for each record
+// batch the values of each column as strings (dictionary-encoded strings are
+// looked up, nulls are "null"). This allows comparing the streams of different
+// writers, which may differ in the layout of their bytes.
+using DecodedStream = std::vector<std::vector<std::vector<std::string>>>;
+inline DecodedStream decodeStream(std::string_view stream) {
+  auto messages = parseStream(stream);
+  AD_CONTRACT_CHECK(!messages.empty() && messages[0].headerType() == 1);
+  auto fields = messages[0].header().tables(1);
+  std::map<int64_t, std::vector<std::string>> dictionaries;
+  DecodedStream result;
+  for (size_t m = 1; m < messages.size(); ++m) {
+    const auto& message = messages[m];
+    auto batch = message.header();
+    if (message.headerType() == 2) {
+      auto data = batch.table(1);
+      auto offsets = message.buffer(data, 1);
+      auto bytes = message.buffer(data, 2);
+      auto& dictionary = dictionaries[batch.scalar<int64_t>(0)];
+      // A dictionary batch that is not a delta replaces the dictionary.
+      if (!batch.scalar<bool>(2)) {
+        dictionary.clear();
+      }
+      for (size_t i = 0; i < static_cast<size_t>(data.scalar<int64_t>(0));
+           ++i) {
+        auto begin = value<int32_t>(offsets, i);
+        auto end = value<int32_t>(offsets, i + 1);
+        dictionary.emplace_back(bytes.substr(begin, end - begin));
+      }
+      continue;
+    }
+    EXPECT_EQ(message.headerType(), 3);
+    auto nodes = batch.structs(1);
+    auto numRows = static_cast<size_t>(batch.scalar<int64_t>(0));
+    auto& columns = result.emplace_back();
+    for (size_t j = 0; j < fields.size(); ++j) {
+      const auto& field = fields[j];
+      auto validity = message.buffer(batch, 2 * j);
+      auto values = message.buffer(batch, 2 * j + 1);
+      auto& column = columns.emplace_back();
+      for (size_t i = 0; i < numRows; ++i) {
+        // Without nulls, the validity bitmap may be omitted.
+        if (nodes.at(j)[1] > 0 && !bit(validity, i)) {
+          column.emplace_back("null");
+        } else if (field.has(4)) {
+          const auto& dictionary =
+              dictionaries.at(field.table(4).scalar<int64_t>(0));
+          column.push_back(dictionary.at(value<int32_t>(values, i)));
+        } else if (auto type = field.scalar<uint8_t>(2);
+                   type == 2 || type == 10) {
+          column.push_back(std::to_string(value<int64_t>(values, i)));
+        } else if (type == 3) {
+          column.push_back(std::to_string(value<double>(values, i)));
+        } else if (type == 6) {
+          column.emplace_back(bit(values, i) ? "true" : "false");
+        } else {
+          ADD_FAILURE() << "Unsupported type " << static_cast<int>(type);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace ad_utility::testing::arrow
+
+#endif  // QLEVER_TEST_UTIL_ARROWIPCTESTHELPERS_H
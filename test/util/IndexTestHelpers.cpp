@@ -51,6 +51,7 @@ std::vector<std::string> getAllIndexFilenames(
           indexBasename + ".index.osp.meta",
           indexBasename + ".index.patterns",
           indexBasename + ".meta-data.json",
+          indexBasename + ".index-build-checkpoint.json",
           indexBasename + ".prefixes",
           indexBasename + ".vocabulary.internal",
           indexBasename + ".vocabulary.external",
@@ -187,6 +188,14 @@ Index makeTestIndex(const std::string& indexBasename, TestIndexConfig c) {
     index.getImpl().setVocabularyTypeForIndexBuilding(
         c.vocabularyType.has_value() ? c.vocabularyType.value()
                                      : VocabularyType::random());
+    index.getImpl().setBuildVocabularyNgramIndex(c.buildVocabularyNgramIndex);
+    index.getImpl().setBuildSpatialIndex(c.buildSpatialIndex);
+    index.getImpl().setReachabilityIndexPredicates(
+        c.reachabilityIndexPredicates);
+    index.getImpl().setBuildPermutationPairsInParallel(
+        c.buildPermutationPairsInParallel);
+    index.getImpl().setExistingIndexForIncrementalBuild(
+        c.existingIndexBasename);
     if (c.encodedIriManager.has_value()) {
       // Extract prefixes without angle brackets from the EncodedIriManager
       std::vector<std::string> prefixes;
@@ -66,6 +66,13 @@ struct TestIndexConfig {
   qlever::Filetype indexType = qlever::Filetype::Turtle;
   std::optional<VocabularyType> vocabularyType = std::nullopt;
   std::optional<EncodedIriManager> encodedIriManager = std::nullopt;
+  bool buildVocabularyNgramIndex = false;
+  bool buildSpatialIndex = false;
+  std::vector<std::string> reachabilityIndexPredicates;
+  bool buildPermutationPairsInParallel = false;
+  // If set, the `turtleInput` is merged into the existing index with this
+  // basename (an incremental index build).
+  std::optional<std::string> existingIndexBasename = std::nullopt;
 
   // A very typical use case is to only specify the turtle input, and leave all
   // the other members as the default. We therefore have a dedicated constructor
@@ -82,7 +89,11 @@ struct TestIndexConfig {
                       c.blocksizePermutations, c.createTextIndex,
                       c.addWordsFromLiterals, c.contentsOfWordsFileAndDocsfile,
                       c.parserBufferSize, c.scoringMetric, c.bAndKParam,
-                      c.indexType, c.encodedIriManager);
+                      c.indexType, c.encodedIriManager,
+                      c.buildVocabularyNgramIndex, c.buildSpatialIndex,
+                      c.reachabilityIndexPredicates,
+                      c.buildPermutationPairsInParallel,
+                      c.existingIndexBasename);
   }
   bool operator==(const TestIndexConfig&) const = default;
 };